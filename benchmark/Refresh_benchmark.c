@@ -0,0 +1,622 @@
+/* Refresh - a cross-platform hardware-accelerated graphics library with modern capabilities
+ *
+ * Copyright (c) 2020-2024 Evan Hemsley
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software in a
+ * product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * Evan "cosmonaut" Hemsley <evan@moonside.games>
+ *
+ */
+
+/* Measures the CPU cost of recording common workloads, independent of the GPU.
+ *
+ * Every case records into an offscreen target, so no window is required.
+ * Only the recording is timed; each frame is submitted and waited on outside
+ * the timer so GPU time and queue depth don't leak into the results.
+ *
+ * Build Refresh with REFRESH_INSTRUMENTATION to also get a per entry point
+ * breakdown and, with --trace, a Chrome trace of every call.
+ */
+
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+
+#include "Refresh.h"
+
+#define TARGET_SIZE 64
+#define PIPELINES_PER_FRAME 8
+#define MAX_INSTRUMENTATION_ENTRIES 256
+#define MAX_TRACE_EVENTS (1024 * 1024)
+
+typedef struct Vertex
+{
+    float x, y;
+} Vertex;
+
+typedef struct Benchmark
+{
+    Refresh_Device *device;
+    Uint32 frameCount;
+    Uint32 drawCount;
+
+    Refresh_Shader *vertexShader;
+    Refresh_Shader *fragmentShader;
+    Refresh_GraphicsPipelineCreateInfo pipelineCreateInfo;
+    Refresh_ColorAttachmentDescription colorAttachmentDescription;
+    Refresh_VertexBinding vertexBinding;
+    Refresh_VertexAttribute vertexAttribute;
+    Refresh_GraphicsPipeline *pipeline;
+
+    Refresh_Texture *renderTarget;
+    Refresh_Texture *texture;
+    Refresh_Sampler *sampler;
+    Refresh_Buffer *vertexBuffer;
+    Refresh_TransferBuffer *transferBuffer;
+} Benchmark;
+
+typedef Uint64 (*BenchmarkFunc)(Benchmark *benchmark, Refresh_CommandBuffer *commandBuffer);
+
+typedef struct BenchmarkCase
+{
+    const char *name;
+    BenchmarkFunc func;
+    SDL_bool perDraw; /* SDL_FALSE if the case runs PIPELINES_PER_FRAME operations */
+} BenchmarkCase;
+
+static const Vertex triangle[3] = {
+    { -0.5f, -0.5f },
+    { 0.5f, -0.5f },
+    { 0.0f, 0.5f }
+};
+
+/* Setup */
+
+static Refresh_Shader *LoadShader(
+    Refresh_Device *device,
+    const char *filename,
+    Refresh_ShaderStage stage,
+    Uint32 samplerCount,
+    Uint32 uniformBufferCount)
+{
+    Refresh_ShaderCreateInfo shaderCreateInfo;
+    Refresh_Shader *shader;
+    char *basePath;
+    char path[1024];
+    void *code;
+    size_t codeSize;
+
+    basePath = SDL_GetBasePath();
+    SDL_snprintf(path, sizeof(path), "%s%s", basePath != NULL ? basePath : "", filename);
+    SDL_free(basePath);
+
+    code = SDL_LoadFile(path, &codeSize);
+    if (code == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load shader %s: %s", path, SDL_GetError());
+        return NULL;
+    }
+
+    SDL_zero(shaderCreateInfo);
+    shaderCreateInfo.codeSize = codeSize;
+    shaderCreateInfo.code = code;
+    shaderCreateInfo.entryPointName = "main";
+    shaderCreateInfo.format = REFRESH_SHADERFORMAT_SPIRV;
+    shaderCreateInfo.stage = stage;
+    shaderCreateInfo.samplerCount = samplerCount;
+    shaderCreateInfo.uniformBufferCount = uniformBufferCount;
+
+    shader = Refresh_CreateShader(device, &shaderCreateInfo);
+    SDL_free(code);
+
+    if (shader == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create shader %s", path);
+    }
+
+    return shader;
+}
+
+static Refresh_Texture *CreateTexture(
+    Refresh_Device *device,
+    Refresh_TextureUsageFlags usageFlags)
+{
+    Refresh_TextureCreateInfo textureCreateInfo;
+
+    SDL_zero(textureCreateInfo);
+    textureCreateInfo.width = TARGET_SIZE;
+    textureCreateInfo.height = TARGET_SIZE;
+    textureCreateInfo.depth = 1;
+    textureCreateInfo.layerCount = 1;
+    textureCreateInfo.levelCount = 1;
+    textureCreateInfo.sampleCount = REFRESH_SAMPLECOUNT_1;
+    textureCreateInfo.format = REFRESH_TEXTUREFORMAT_R8G8B8A8;
+    textureCreateInfo.usageFlags = usageFlags;
+
+    return Refresh_CreateTexture(device, &textureCreateInfo);
+}
+
+static void UploadResources(Benchmark *benchmark, Refresh_CommandBuffer *commandBuffer)
+{
+    Refresh_CopyPass *copyPass;
+    Refresh_TransferBufferLocation bufferSource;
+    Refresh_BufferRegion bufferDestination;
+    Refresh_TextureTransferInfo textureSource;
+    Refresh_TextureRegion textureDestination;
+
+    bufferSource.transferBuffer = benchmark->transferBuffer;
+    bufferSource.offset = 0;
+    bufferDestination.buffer = benchmark->vertexBuffer;
+    bufferDestination.offset = 0;
+    bufferDestination.size = sizeof(triangle);
+
+    textureSource.transferBuffer = benchmark->transferBuffer;
+    textureSource.offset = sizeof(triangle);
+    textureSource.imagePitch = TARGET_SIZE;
+    textureSource.imageHeight = TARGET_SIZE;
+
+    SDL_zero(textureDestination);
+    textureDestination.textureSlice.texture = benchmark->texture;
+    textureDestination.w = TARGET_SIZE;
+    textureDestination.h = TARGET_SIZE;
+    textureDestination.d = 1;
+
+    copyPass = Refresh_BeginCopyPass(commandBuffer);
+    Refresh_UploadToBuffer(copyPass, &bufferSource, &bufferDestination, SDL_FALSE);
+    Refresh_UploadToTexture(copyPass, &textureSource, &textureDestination, SDL_FALSE);
+    Refresh_EndCopyPass(copyPass);
+}
+
+static void SubmitAndWait(Refresh_Device *device, Refresh_CommandBuffer *commandBuffer)
+{
+    Refresh_Fence *fence;
+
+    fence = Refresh_SubmitAndAcquireFence(commandBuffer);
+    if (fence != NULL) {
+        Refresh_WaitForFences(device, SDL_TRUE, &fence, 1);
+        Refresh_ReleaseFence(device, fence);
+    }
+}
+
+static SDL_bool InitBenchmark(Benchmark *benchmark)
+{
+    Refresh_Device *device = benchmark->device;
+    Refresh_GraphicsPipelineCreateInfo *pipelineCreateInfo = &benchmark->pipelineCreateInfo;
+    Refresh_SamplerCreateInfo samplerCreateInfo;
+    Refresh_TransferBufferRegion transferRegion;
+    Refresh_CommandBuffer *commandBuffer;
+    Uint32 transferSize = sizeof(triangle) + TARGET_SIZE * TARGET_SIZE * 4;
+    Uint8 *transferData;
+
+    benchmark->vertexShader = LoadShader(device, "Benchmark.vert.spv", REFRESH_SHADERSTAGE_VERTEX, 0, 1);
+    benchmark->fragmentShader = LoadShader(device, "Benchmark.frag.spv", REFRESH_SHADERSTAGE_FRAGMENT, 1, 0);
+    if (benchmark->vertexShader == NULL || benchmark->fragmentShader == NULL) {
+        return SDL_FALSE;
+    }
+
+    benchmark->vertexBinding.binding = 0;
+    benchmark->vertexBinding.stride = sizeof(Vertex);
+    benchmark->vertexBinding.inputRate = REFRESH_VERTEXINPUTRATE_VERTEX;
+    benchmark->vertexBinding.stepRate = 0;
+
+    benchmark->vertexAttribute.location = 0;
+    benchmark->vertexAttribute.binding = 0;
+    benchmark->vertexAttribute.format = REFRESH_VERTEXELEMENTFORMAT_VECTOR2;
+    benchmark->vertexAttribute.offset = 0;
+
+    SDL_zero(benchmark->colorAttachmentDescription);
+    benchmark->colorAttachmentDescription.format = REFRESH_TEXTUREFORMAT_R8G8B8A8;
+    benchmark->colorAttachmentDescription.blendState.colorWriteMask =
+        REFRESH_COLORCOMPONENT_R_BIT |
+        REFRESH_COLORCOMPONENT_G_BIT |
+        REFRESH_COLORCOMPONENT_B_BIT |
+        REFRESH_COLORCOMPONENT_A_BIT;
+
+    SDL_zerop(pipelineCreateInfo);
+    pipelineCreateInfo->vertexShader = benchmark->vertexShader;
+    pipelineCreateInfo->fragmentShader = benchmark->fragmentShader;
+    pipelineCreateInfo->vertexInputState.vertexBindings = &benchmark->vertexBinding;
+    pipelineCreateInfo->vertexInputState.vertexBindingCount = 1;
+    pipelineCreateInfo->vertexInputState.vertexAttributes = &benchmark->vertexAttribute;
+    pipelineCreateInfo->vertexInputState.vertexAttributeCount = 1;
+    pipelineCreateInfo->primitiveType = REFRESH_PRIMITIVETYPE_TRIANGLELIST;
+    pipelineCreateInfo->rasterizerState.fillMode = REFRESH_FILLMODE_FILL;
+    pipelineCreateInfo->rasterizerState.cullMode = REFRESH_CULLMODE_NONE;
+    pipelineCreateInfo->rasterizerState.frontFace = REFRESH_FRONTFACE_COUNTER_CLOCKWISE;
+    pipelineCreateInfo->multisampleState.multisampleCount = REFRESH_SAMPLECOUNT_1;
+    pipelineCreateInfo->multisampleState.sampleMask = 0xFFFFFFFF;
+    pipelineCreateInfo->depthStencilState.compareOp = REFRESH_COMPAREOP_ALWAYS;
+    pipelineCreateInfo->attachmentInfo.colorAttachmentDescriptions = &benchmark->colorAttachmentDescription;
+    pipelineCreateInfo->attachmentInfo.colorAttachmentCount = 1;
+
+    benchmark->pipeline = Refresh_CreateGraphicsPipeline(device, pipelineCreateInfo);
+    if (benchmark->pipeline == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create graphics pipeline!");
+        return SDL_FALSE;
+    }
+
+    benchmark->renderTarget = CreateTexture(device, REFRESH_TEXTUREUSAGE_COLOR_TARGET_BIT);
+    benchmark->texture = CreateTexture(device, REFRESH_TEXTUREUSAGE_SAMPLER_BIT);
+
+    SDL_zero(samplerCreateInfo);
+    samplerCreateInfo.minFilter = REFRESH_FILTER_LINEAR;
+    samplerCreateInfo.magFilter = REFRESH_FILTER_LINEAR;
+    samplerCreateInfo.mipmapMode = REFRESH_SAMPLERMIPMAPMODE_NEAREST;
+    samplerCreateInfo.addressModeU = REFRESH_SAMPLERADDRESSMODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeV = REFRESH_SAMPLERADDRESSMODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeW = REFRESH_SAMPLERADDRESSMODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.compareOp = REFRESH_COMPAREOP_ALWAYS;
+    benchmark->sampler = Refresh_CreateSampler(device, &samplerCreateInfo);
+
+    benchmark->vertexBuffer = Refresh_CreateBuffer(device, REFRESH_BUFFERUSAGE_VERTEX_BIT, sizeof(triangle));
+    benchmark->transferBuffer = Refresh_CreateTransferBuffer(device, REFRESH_TRANSFERBUFFERUSAGE_UPLOAD, transferSize);
+
+    if (
+        benchmark->renderTarget == NULL ||
+        benchmark->texture == NULL ||
+        benchmark->sampler == NULL ||
+        benchmark->vertexBuffer == NULL ||
+        benchmark->transferBuffer == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create benchmark resources!");
+        return SDL_FALSE;
+    }
+
+    transferData = SDL_malloc(transferSize);
+    SDL_memcpy(transferData, triangle, sizeof(triangle));
+    SDL_memset(transferData + sizeof(triangle), 0xFF, transferSize - sizeof(triangle));
+
+    transferRegion.transferBuffer = benchmark->transferBuffer;
+    transferRegion.offset = 0;
+    transferRegion.size = transferSize;
+    Refresh_SetTransferData(device, transferData, &transferRegion, SDL_FALSE);
+    SDL_free(transferData);
+
+    commandBuffer = Refresh_AcquireCommandBuffer(device);
+    UploadResources(benchmark, commandBuffer);
+    SubmitAndWait(device, commandBuffer);
+
+    return SDL_TRUE;
+}
+
+static void QuitBenchmark(Benchmark *benchmark)
+{
+    Refresh_Device *device = benchmark->device;
+
+    Refresh_Wait(device);
+
+    Refresh_ReleaseTransferBuffer(device, benchmark->transferBuffer);
+    Refresh_ReleaseBuffer(device, benchmark->vertexBuffer);
+    Refresh_ReleaseSampler(device, benchmark->sampler);
+    Refresh_ReleaseTexture(device, benchmark->texture);
+    Refresh_ReleaseTexture(device, benchmark->renderTarget);
+    Refresh_ReleaseGraphicsPipeline(device, benchmark->pipeline);
+    Refresh_ReleaseShader(device, benchmark->fragmentShader);
+    Refresh_ReleaseShader(device, benchmark->vertexShader);
+}
+
+/* Cases */
+
+static Refresh_RenderPass *BeginRenderPass(Benchmark *benchmark, Refresh_CommandBuffer *commandBuffer)
+{
+    Refresh_ColorAttachmentInfo colorAttachmentInfo;
+    Refresh_RenderPass *renderPass;
+    Refresh_Viewport viewport = { 0, 0, TARGET_SIZE, TARGET_SIZE, 0, 1 };
+
+    SDL_zero(colorAttachmentInfo);
+    colorAttachmentInfo.textureSlice.texture = benchmark->renderTarget;
+    colorAttachmentInfo.loadOp = REFRESH_LOADOP_CLEAR;
+    colorAttachmentInfo.storeOp = REFRESH_STOREOP_STORE;
+    colorAttachmentInfo.cycle = SDL_TRUE;
+
+    renderPass = Refresh_BeginRenderPass(commandBuffer, &colorAttachmentInfo, 1, NULL);
+    Refresh_BindGraphicsPipeline(renderPass, benchmark->pipeline);
+    Refresh_SetViewport(renderPass, &viewport);
+
+    return renderPass;
+}
+
+static void BindDefaults(Benchmark *benchmark, Refresh_CommandBuffer *commandBuffer, Refresh_RenderPass *renderPass)
+{
+    Refresh_BufferBinding vertexBinding = { benchmark->vertexBuffer, 0 };
+    Refresh_TextureSamplerBinding samplerBinding = { benchmark->texture, benchmark->sampler };
+    float offset[4] = { 0, 0, 0, 0 };
+
+    Refresh_BindVertexBuffers(renderPass, 0, &vertexBinding, 1);
+    Refresh_BindFragmentSamplers(renderPass, 0, &samplerBinding, 1);
+    Refresh_PushVertexUniformData(commandBuffer, 0, offset, sizeof(offset));
+}
+
+/* Draw submission: state is bound once and only the draws vary */
+static Uint64 Case_Draws(Benchmark *benchmark, Refresh_CommandBuffer *commandBuffer)
+{
+    Refresh_RenderPass *renderPass;
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint32 i;
+
+    renderPass = BeginRenderPass(benchmark, commandBuffer);
+    BindDefaults(benchmark, commandBuffer, renderPass);
+
+    for (i = 0; i < benchmark->drawCount; i += 1) {
+        Refresh_DrawPrimitives(renderPass, 0, 1);
+    }
+
+    Refresh_EndRenderPass(renderPass);
+
+    return SDL_GetPerformanceCounter() - start;
+}
+
+/* Uniform push: new uniform data before every draw, as with per-object transforms */
+static Uint64 Case_Uniforms(Benchmark *benchmark, Refresh_CommandBuffer *commandBuffer)
+{
+    Refresh_RenderPass *renderPass;
+    Uint64 start = SDL_GetPerformanceCounter();
+    float offset[4] = { 0, 0, 0, 0 };
+    Uint32 i;
+
+    renderPass = BeginRenderPass(benchmark, commandBuffer);
+    BindDefaults(benchmark, commandBuffer, renderPass);
+
+    for (i = 0; i < benchmark->drawCount; i += 1) {
+        offset[0] = (float)(i % TARGET_SIZE) / TARGET_SIZE;
+        Refresh_PushVertexUniformData(commandBuffer, 0, offset, sizeof(offset));
+        Refresh_DrawPrimitives(renderPass, 0, 1);
+    }
+
+    Refresh_EndRenderPass(renderPass);
+
+    return SDL_GetPerformanceCounter() - start;
+}
+
+/* Descriptor binding: rebinds the vertex buffer and sampler before every draw */
+static Uint64 Case_Bindings(Benchmark *benchmark, Refresh_CommandBuffer *commandBuffer)
+{
+    Refresh_RenderPass *renderPass;
+    Refresh_BufferBinding vertexBinding = { benchmark->vertexBuffer, 0 };
+    Refresh_TextureSamplerBinding samplerBinding = { benchmark->texture, benchmark->sampler };
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint32 i;
+
+    renderPass = BeginRenderPass(benchmark, commandBuffer);
+    BindDefaults(benchmark, commandBuffer, renderPass);
+
+    for (i = 0; i < benchmark->drawCount; i += 1) {
+        Refresh_BindVertexBuffers(renderPass, 0, &vertexBinding, 1);
+        Refresh_BindFragmentSamplers(renderPass, 0, &samplerBinding, 1);
+        Refresh_DrawPrimitives(renderPass, 0, 1);
+    }
+
+    Refresh_EndRenderPass(renderPass);
+
+    return SDL_GetPerformanceCounter() - start;
+}
+
+/* Copy pass uploads: one buffer and one texture upload per operation */
+static Uint64 Case_Uploads(Benchmark *benchmark, Refresh_CommandBuffer *commandBuffer)
+{
+    Refresh_CopyPass *copyPass;
+    Refresh_TransferBufferLocation bufferSource;
+    Refresh_BufferRegion bufferDestination;
+    Refresh_TextureTransferInfo textureSource;
+    Refresh_TextureRegion textureDestination;
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint32 i;
+
+    bufferSource.transferBuffer = benchmark->transferBuffer;
+    bufferSource.offset = 0;
+    bufferDestination.buffer = benchmark->vertexBuffer;
+    bufferDestination.offset = 0;
+    bufferDestination.size = sizeof(triangle);
+
+    textureSource.transferBuffer = benchmark->transferBuffer;
+    textureSource.offset = sizeof(triangle);
+    textureSource.imagePitch = TARGET_SIZE;
+    textureSource.imageHeight = TARGET_SIZE;
+
+    SDL_zero(textureDestination);
+    textureDestination.textureSlice.texture = benchmark->texture;
+    textureDestination.w = TARGET_SIZE;
+    textureDestination.h = TARGET_SIZE;
+    textureDestination.d = 1;
+
+    copyPass = Refresh_BeginCopyPass(commandBuffer);
+
+    for (i = 0; i < benchmark->drawCount; i += 1) {
+        Refresh_UploadToBuffer(copyPass, &bufferSource, &bufferDestination, SDL_FALSE);
+        Refresh_UploadToTexture(copyPass, &textureSource, &textureDestination, SDL_FALSE);
+    }
+
+    Refresh_EndCopyPass(copyPass);
+
+    return SDL_GetPerformanceCounter() - start;
+}
+
+/* Pipeline creation: includes the driver's compile, so expect this to be dominated by it */
+static Uint64 Case_Pipelines(Benchmark *benchmark, Refresh_CommandBuffer *commandBuffer)
+{
+    Refresh_GraphicsPipeline *pipeline;
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint32 i;
+
+    (void)commandBuffer;
+
+    for (i = 0; i < PIPELINES_PER_FRAME; i += 1) {
+        pipeline = Refresh_CreateGraphicsPipeline(benchmark->device, &benchmark->pipelineCreateInfo);
+        Refresh_ReleaseGraphicsPipeline(benchmark->device, pipeline);
+    }
+
+    return SDL_GetPerformanceCounter() - start;
+}
+
+static const BenchmarkCase cases[] = {
+    { "draw", Case_Draws, SDL_TRUE },
+    { "uniform push + draw", Case_Uniforms, SDL_TRUE },
+    { "vertex/sampler bind + draw", Case_Bindings, SDL_TRUE },
+    { "buffer + texture upload", Case_Uploads, SDL_TRUE },
+    { "pipeline create + release", Case_Pipelines, SDL_FALSE }
+};
+
+static void RunCase(Benchmark *benchmark, const BenchmarkCase *benchmarkCase)
+{
+    Refresh_CommandBuffer *commandBuffer;
+    Uint64 ticks = 0;
+    Uint64 operationCount;
+    Uint64 nanoseconds;
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint32 i;
+
+    for (i = 0; i < benchmark->frameCount; i += 1) {
+        commandBuffer = Refresh_AcquireCommandBuffer(benchmark->device);
+        ticks += benchmarkCase->func(benchmark, commandBuffer);
+        SubmitAndWait(benchmark->device, commandBuffer);
+    }
+
+    operationCount = (Uint64)benchmark->frameCount * (benchmarkCase->perDraw ? benchmark->drawCount : PIPELINES_PER_FRAME);
+    nanoseconds = (ticks / frequency) * 1000000000 + ((ticks % frequency) * 1000000000) / frequency;
+
+    SDL_Log(
+        "%-28s %10" SDL_PRIu64 " ops %12" SDL_PRIu64 " ns/op",
+        benchmarkCase->name,
+        operationCount,
+        operationCount > 0 ? nanoseconds / operationCount : 0);
+}
+
+static void PrintInstrumentation(void)
+{
+    Refresh_InstrumentationEntry entries[MAX_INSTRUMENTATION_ENTRIES];
+    Uint32 entryCount;
+    Uint32 i;
+
+    entryCount = Refresh_GetInstrumentationEntries(entries, MAX_INSTRUMENTATION_ENTRIES);
+    if (entryCount == 0) {
+        return;
+    }
+
+    SDL_Log("%-40s %12s %12s %12s", "entry point", "calls", "ns/call", "max ns");
+
+    for (i = 0; i < SDL_min(entryCount, MAX_INSTRUMENTATION_ENTRIES); i += 1) {
+        SDL_Log(
+            "%-40s %12" SDL_PRIu64 " %12" SDL_PRIu64 " %12" SDL_PRIu64,
+            entries[i].name,
+            entries[i].callCount,
+            entries[i].callCount > 0 ? entries[i].totalNanoseconds / entries[i].callCount : 0,
+            entries[i].maxNanoseconds);
+    }
+}
+
+static void PrintUsage(const char *program)
+{
+    SDL_Log("Usage: %s [--backend vulkan|d3d11|metal] [--frames N] [--draws N] [--trace file.json]", program);
+    SDL_Log("D3D11 and Metal translate the SPIR-V shaders with SPIRV-Cross, which must be available at runtime.");
+}
+
+int main(int argc, char **argv)
+{
+    Benchmark benchmark;
+    Refresh_Backend backends = REFRESH_BACKEND_ALL;
+    const char *traceFilename = NULL;
+    const char *backendName;
+    int result = 0;
+    int i;
+    Uint32 j;
+
+    SDL_zero(benchmark);
+    benchmark.frameCount = 100;
+    benchmark.drawCount = 1000;
+
+    for (i = 1; i < argc; i += 1) {
+        if (SDL_strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
+            i += 1;
+            if (SDL_strcasecmp(argv[i], "vulkan") == 0) {
+                backends = REFRESH_BACKEND_VULKAN;
+            } else if (SDL_strcasecmp(argv[i], "d3d11") == 0) {
+                backends = REFRESH_BACKEND_D3D11;
+            } else if (SDL_strcasecmp(argv[i], "metal") == 0) {
+                backends = REFRESH_BACKEND_METAL;
+            } else {
+                PrintUsage(argv[0]);
+                return 1;
+            }
+        } else if (SDL_strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            i += 1;
+            benchmark.frameCount = SDL_max(1, SDL_atoi(argv[i]));
+        } else if (SDL_strcmp(argv[i], "--draws") == 0 && i + 1 < argc) {
+            i += 1;
+            benchmark.drawCount = SDL_max(1, SDL_atoi(argv[i]));
+        } else if (SDL_strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            i += 1;
+            traceFilename = argv[i];
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    SDL_SetMainReady();
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    benchmark.device = Refresh_CreateDevice(backends, SDL_FALSE, SDL_FALSE);
+    if (benchmark.device == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create device!");
+        SDL_Quit();
+        return 1;
+    }
+
+    switch (Refresh_GetBackend(benchmark.device)) {
+    case REFRESH_BACKEND_VULKAN:
+        backendName = "Vulkan";
+        break;
+    case REFRESH_BACKEND_D3D11:
+        backendName = "D3D11";
+        break;
+    case REFRESH_BACKEND_METAL:
+        backendName = "Metal";
+        break;
+    default:
+        backendName = "Unknown";
+        break;
+    }
+
+    if (!InitBenchmark(&benchmark)) {
+        result = 1;
+    } else {
+        SDL_Log("Refresh benchmark: %s, %u frames, %u draws per frame", backendName, benchmark.frameCount, benchmark.drawCount);
+
+        /* Only count the cases, not setup */
+        Refresh_ResetInstrumentation();
+        if (traceFilename != NULL && !Refresh_BeginInstrumentationTrace(MAX_TRACE_EVENTS)) {
+            traceFilename = NULL;
+        }
+
+        for (j = 0; j < SDL_arraysize(cases); j += 1) {
+            RunCase(&benchmark, &cases[j]);
+        }
+
+        if (traceFilename != NULL && Refresh_EndInstrumentationTrace(traceFilename)) {
+            SDL_Log("Wrote trace to %s", traceFilename);
+        }
+
+        PrintInstrumentation();
+    }
+
+    QuitBenchmark(&benchmark);
+    Refresh_DestroyDevice(benchmark.device);
+    SDL_Quit();
+
+    return result;
+}
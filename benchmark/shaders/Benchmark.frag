@@ -0,0 +1,12 @@
+#version 450
+
+layout(location = 0) in vec2 inTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+layout(set = 2, binding = 0) uniform sampler2D inTexture;
+
+void main()
+{
+    outColor = texture(inTexture, inTexCoord);
+}
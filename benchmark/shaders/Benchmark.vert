@@ -0,0 +1,16 @@
+#version 450
+
+layout(location = 0) in vec2 inPosition;
+
+layout(location = 0) out vec2 outTexCoord;
+
+layout(set = 1, binding = 0) uniform UniformBlock
+{
+    vec4 offset;
+};
+
+void main()
+{
+    outTexCoord = inPosition * 0.5 + 0.5;
+    gl_Position = vec4(inPosition + offset.xy, 0.0, 1.0);
+}
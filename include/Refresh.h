@@ -67,6 +67,9 @@ typedef struct Refresh_RenderPass Refresh_RenderPass;
 typedef struct Refresh_ComputePass Refresh_ComputePass;
 typedef struct Refresh_CopyPass Refresh_CopyPass;
 typedef struct Refresh_Fence Refresh_Fence;
+typedef struct Refresh_QueryPool Refresh_QueryPool;
+typedef struct Refresh_CommandBundle Refresh_CommandBundle;
+typedef struct Refresh_CompileTask Refresh_CompileTask;
 
 typedef enum Refresh_PrimitiveType
 {
@@ -382,6 +385,45 @@ typedef enum Refresh_SwapchainComposition
     REFRESH_SWAPCHAINCOMPOSITION_HDR10_ST2048
 } Refresh_SwapchainComposition;
 
+/*
+ * GRAPHICS:
+ *   Supports every command. Swapchain textures, render passes and blits require this queue.
+ * COMPUTE:
+ *   Supports compute passes and copy passes. May run concurrently with the graphics queue.
+ * TRANSFER:
+ *   Supports copy passes, except for GenerateMipmaps. May run concurrently with the other queues.
+ *
+ * Backends without dedicated hardware queues execute every queue type on the graphics queue.
+ * Vulkan only uses dedicated queue families when the REFRESH_HINT_VULKAN_ASYNC_QUEUES hint is
+ * enabled at device creation, since every resource then has to be shared between the families,
+ * which can disable compression on some drivers.
+ */
+typedef enum Refresh_QueueType
+{
+    REFRESH_QUEUETYPE_GRAPHICS,
+    REFRESH_QUEUETYPE_COMPUTE,
+    REFRESH_QUEUETYPE_TRANSFER
+} Refresh_QueueType;
+
+/*
+ * Resource types that can be registered in the device-wide bindless tables.
+ *
+ * For SPIR-V shaders, the bindless tables are bound to the set immediately after
+ * the regular resource sets (set 4 for graphics, set 3 for compute):
+ *  0: texture2D[] (sampled images)
+ *  1: sampler[]
+ *  2: readonly buffer[] (storage buffers)
+ *
+ * Shaders index these arrays with the index returned at registration,
+ * typically passed in through a uniform buffer.
+ */
+typedef enum Refresh_BindlessResourceType
+{
+    REFRESH_BINDLESSRESOURCETYPE_TEXTURE,
+    REFRESH_BINDLESSRESOURCETYPE_SAMPLER,
+    REFRESH_BINDLESSRESOURCETYPE_STORAGEBUFFER
+} Refresh_BindlessResourceType;
+
 typedef enum Refresh_BackendBits
 {
     REFRESH_BACKEND_INVALID = 0,
@@ -797,6 +839,76 @@ typedef struct Refresh_StorageTextureReadWriteBinding
     SDL_bool cycle;
 } Refresh_StorageTextureReadWriteBinding;
 
+/* Statistics */
+
+typedef struct Refresh_DeviceStatistics
+{
+    /* Descriptor sets fetched from a pool and written by the driver. */
+    Uint64 descriptorSetsWritten;
+    /* Redundant binding states that rebound an already written descriptor set. */
+    Uint64 descriptorSetsReused;
+    /* Resource barriers recorded after batching and redundant-transition elimination. */
+    Uint64 barriersRecorded;
+    /* Pipeline barrier commands the recorded barriers were batched into. */
+    Uint64 barrierBatchesRecorded;
+    /* Transitions folded into an already queued barrier or dropped as no-ops. */
+    Uint64 barriersEliminated;
+    /* Free bytes inside memory allocations when they were queued for defragmentation. */
+    Uint64 defragBytesFragmented;
+    /* Bytes of resource data copied out of fragmented allocations. */
+    Uint64 defragBytesMoved;
+    /* Bytes of device memory released once defragmentation emptied an allocation. */
+    Uint64 defragBytesReclaimed;
+    /* Backing resources created because every existing one was still in use when a resource was cycled. */
+    Uint64 cycleHandlesCreated;
+    /* Idle backing resources released by cycle trimming. */
+    Uint64 cycleHandlesTrimmed;
+    /* Cycle requests ignored because the resource had reached its cycle limit. */
+    Uint64 cycleLimitHits;
+} Refresh_DeviceStatistics;
+
+typedef struct Refresh_MemoryStatistics
+{
+    /* Device memory allocated by the driver, including free space inside allocations. */
+    Uint64 allocatedBytes;
+    /* Bytes of allocated memory occupied by resources. */
+    Uint64 usedBytes;
+    /* Number of device memory allocations. */
+    Uint32 allocationCount;
+    /* Number of free regions inside allocations, a rough measure of fragmentation. */
+    Uint32 freeRegionCount;
+    /* Size of the largest free region inside an allocation. */
+    Uint64 largestFreeRegionBytes;
+    /* Device-local memory this process can use before risking eviction or failed allocations. */
+    Uint64 budgetBytes;
+    /* Device-local memory currently used by this process. */
+    Uint64 usageBytes;
+} Refresh_MemoryStatistics;
+
+typedef struct Refresh_InstrumentationEntry
+{
+    /* Name of the instrumented entry point, e.g. "Refresh_DrawPrimitives". */
+    const char *name;
+    /* Number of calls that reached the driver. */
+    Uint64 callCount;
+    /* Total CPU time spent in the driver across all calls. */
+    Uint64 totalNanoseconds;
+    /* Longest single call. */
+    Uint64 maxNanoseconds;
+} Refresh_InstrumentationEntry;
+
+/* Defragmentation */
+
+typedef struct Refresh_DefragmentationSettings
+{
+    /* If SDL_TRUE, fragmented memory is queued for defragmentation whenever a new allocation is needed. Defaults to SDL_TRUE. */
+    SDL_bool automatic;
+    /* Upper bound on resource bytes moved per presented frame. 0 means no limit. */
+    Uint64 maxBytesPerFrame;
+    /* Upper bound on CPU time spent recording moves per presented frame. 0 means no limit. */
+    Uint32 maxMicrosecondsPerFrame;
+} Refresh_DefragmentationSettings;
+
 /* Functions */
 
 /* Device */
@@ -1240,6 +1352,28 @@ REFRESHAPI void Refresh_ReleaseGraphicsPipeline(
 REFRESHAPI Refresh_CommandBuffer *Refresh_AcquireCommandBuffer(
     Refresh_Device *device);
 
+/**
+ * Acquire a command buffer that executes on a specific queue.
+ * Otherwise identical to Refresh_AcquireCommandBuffer, which uses REFRESH_QUEUETYPE_GRAPHICS.
+ *
+ * Submissions are ordered across queues: each one waits on work previously submitted to the
+ * other queues that used any of the same buffers or textures, so unrelated work can overlap.
+ * Command buffers that access registered bindless resources wait on all earlier work, and
+ * Vulkan drivers without timeline semaphores order every submission against the other queues.
+ *
+ * \param device a GPU context
+ * \param queueType the queue the command buffer will be submitted to
+ * \returns a command buffer, or NULL if queueType is invalid
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_AcquireCommandBuffer
+ * \sa Refresh_Submit
+ */
+REFRESHAPI Refresh_CommandBuffer *Refresh_AcquireCommandBufferForQueue(
+    Refresh_Device *device,
+    Refresh_QueueType queueType);
+
 /*
  * UNIFORM DATA
  *
@@ -1622,6 +1756,85 @@ REFRESHAPI void Refresh_DrawIndexedPrimitivesIndirect(
     Uint32 drawCount,
     Uint32 stride);
 
+/**
+ * Determines whether the device can read indirect draw counts from a buffer.
+ *
+ * When this returns SDL_FALSE, Refresh_DrawPrimitivesIndirectCount and
+ * Refresh_DrawIndexedPrimitivesIndirectCount still work, but always issue
+ * maxDrawCount draws and ignore the count buffer. Applications that rely on the
+ * fallback must write an instanceCount of zero to every draw past the real count.
+ * Currently only the Vulkan backend with VK_KHR_draw_indirect_count supports this.
+ *
+ * \param device a GPU context
+ * \returns SDL_TRUE if GPU-side draw counts are supported, SDL_FALSE otherwise
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_DrawPrimitivesIndirectCount
+ * \sa Refresh_DrawIndexedPrimitivesIndirectCount
+ */
+REFRESHAPI SDL_bool Refresh_SupportsIndirectCount(
+    Refresh_Device *device);
+
+/**
+ * Draws data using bound graphics state and with draw parameters set from a buffer,
+ * reading the number of draws from a second buffer.
+ * The buffer layout should match the layout of Refresh_IndirectDrawCommand.
+ * The count buffer must contain a Uint32 at countOffsetInBytes.
+ * Both buffers must have been created with REFRESH_BUFFERUSAGE_INDIRECT_BIT.
+ * You must not call this function before binding a graphics pipeline.
+ *
+ * \param renderPass a render pass handle
+ * \param buffer a buffer containing draw parameters
+ * \param offsetInBytes the offset to start reading from the draw buffer
+ * \param countBuffer a buffer containing the draw count
+ * \param countOffsetInBytes the offset of the draw count in the count buffer
+ * \param maxDrawCount the maximum number of draw parameter sets that will be read from the draw buffer
+ * \param stride the byte stride between sets of draw parameters
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_SupportsIndirectCount
+ */
+REFRESHAPI void Refresh_DrawPrimitivesIndirectCount(
+    Refresh_RenderPass *renderPass,
+    Refresh_Buffer *buffer,
+    Uint32 offsetInBytes,
+    Refresh_Buffer *countBuffer,
+    Uint32 countOffsetInBytes,
+    Uint32 maxDrawCount,
+    Uint32 stride);
+
+/**
+ * Draws data using bound graphics state with an index buffer enabled
+ * and with draw parameters set from a buffer,
+ * reading the number of draws from a second buffer.
+ * The buffer layout should match the layout of Refresh_IndexedIndirectDrawCommand.
+ * The count buffer must contain a Uint32 at countOffsetInBytes.
+ * Both buffers must have been created with REFRESH_BUFFERUSAGE_INDIRECT_BIT.
+ * You must not call this function before binding a graphics pipeline.
+ *
+ * \param renderPass a render pass handle
+ * \param buffer a buffer containing draw parameters
+ * \param offsetInBytes the offset to start reading from the draw buffer
+ * \param countBuffer a buffer containing the draw count
+ * \param countOffsetInBytes the offset of the draw count in the count buffer
+ * \param maxDrawCount the maximum number of draw parameter sets that will be read from the draw buffer
+ * \param stride the byte stride between sets of draw parameters
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_SupportsIndirectCount
+ */
+REFRESHAPI void Refresh_DrawIndexedPrimitivesIndirectCount(
+    Refresh_RenderPass *renderPass,
+    Refresh_Buffer *buffer,
+    Uint32 offsetInBytes,
+    Refresh_Buffer *countBuffer,
+    Uint32 countOffsetInBytes,
+    Uint32 maxDrawCount,
+    Uint32 stride);
+
 /**
  * Ends the given render pass.
  * All bound graphics state on the render pass command buffer is unset.
@@ -1634,6 +1847,225 @@ REFRESHAPI void Refresh_DrawIndexedPrimitivesIndirect(
 REFRESHAPI void Refresh_EndRenderPass(
     Refresh_RenderPass *renderPass);
 
+/* Parallel Render Pass */
+
+/**
+ * Begins a render pass whose draws are recorded on several threads.
+ * Behaves like Refresh_BeginRenderPass, but no commands may be recorded
+ * directly into the returned render pass. Instead, acquire chunks with
+ * Refresh_AcquireRenderPassChunk and record into those.
+ * When the render pass is ended, the chunks are executed in the order
+ * they were acquired.
+ *
+ * \param commandBuffer a command buffer
+ * \param colorAttachmentInfos an array of Refresh_ColorAttachmentInfo structs
+ * \param colorAttachmentCount the number of color attachments in the colorAttachmentInfos array
+ * \param depthStencilAttachmentInfo the depth-stencil target and clear value, may be NULL
+ * \returns a parallel render pass handle
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_AcquireRenderPassChunk
+ * \sa Refresh_EndRenderPass
+ */
+REFRESHAPI Refresh_RenderPass *Refresh_BeginParallelRenderPass(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_ColorAttachmentInfo *colorAttachmentInfos,
+    Uint32 colorAttachmentCount,
+    Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo);
+
+/**
+ * Acquires a chunk of a parallel render pass.
+ * The chunk is a render pass handle that accepts every render pass command.
+ * It starts with the default viewport and scissor state and nothing bound.
+ * It is safe to call this from multiple threads at once, but each chunk
+ * must only be recorded on the thread that acquired it.
+ *
+ * \param renderPass a render pass handle returned by Refresh_BeginParallelRenderPass
+ * \returns a render pass chunk handle
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_EndRenderPassChunk
+ */
+REFRESHAPI Refresh_RenderPass *Refresh_AcquireRenderPassChunk(
+    Refresh_RenderPass *renderPass);
+
+/**
+ * Ends recording of a render pass chunk.
+ * Every acquired chunk must be ended before its parallel render pass is ended.
+ * The chunk handle is now invalid.
+ *
+ * \param chunk a render pass chunk handle
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_AcquireRenderPassChunk
+ */
+REFRESHAPI void Refresh_EndRenderPassChunk(
+    Refresh_RenderPass *chunk);
+
+/* Command Bundles */
+
+/**
+ * Creates an empty command bundle.
+ * A command bundle records a sequence of render pass commands once
+ * so it can be executed in any number of later render passes.
+ * Commands are validated when they are recorded, not when the bundle is executed.
+ *
+ * The bundle refers to pipelines, buffers, textures and samplers by handle.
+ * Buffers and textures resolve to their current cycled resource each time
+ * the bundle is executed. You must not release a resource while a bundle
+ * that refers to it may still be executed.
+ *
+ * \param device a GPU context
+ * \returns a command bundle handle
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_ExecuteCommandBundle
+ * \sa Refresh_ReleaseCommandBundle
+ */
+REFRESHAPI Refresh_CommandBundle *Refresh_CreateCommandBundle(
+    Refresh_Device *device);
+
+/**
+ * Records a graphics pipeline bind into a command bundle.
+ *
+ * \param commandBundle a command bundle
+ * \param graphicsPipeline the graphics pipeline to bind
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_BindGraphicsPipeline
+ */
+REFRESHAPI void Refresh_BundleBindGraphicsPipeline(
+    Refresh_CommandBundle *commandBundle,
+    Refresh_GraphicsPipeline *graphicsPipeline);
+
+/**
+ * Records a vertex buffer bind into a command bundle.
+ * You must not call this function before recording a graphics pipeline bind.
+ *
+ * \param commandBundle a command bundle
+ * \param firstBinding the starting bind point for the vertex buffers
+ * \param pBindings an array of Refresh_BufferBinding structs containing vertex buffers and offset values
+ * \param bindingCount the number of bindings in the pBindings array
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_BindVertexBuffers
+ */
+REFRESHAPI void Refresh_BundleBindVertexBuffers(
+    Refresh_CommandBundle *commandBundle,
+    Uint32 firstBinding,
+    Refresh_BufferBinding *pBindings,
+    Uint32 bindingCount);
+
+/**
+ * Records an index buffer bind into a command bundle.
+ * You must not call this function before recording a graphics pipeline bind.
+ *
+ * \param commandBundle a command bundle
+ * \param pBinding a pointer to a struct containing an index buffer and offset
+ * \param indexElementSize whether the index values in the buffer are 16- or 32-bit
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_BindIndexBuffer
+ */
+REFRESHAPI void Refresh_BundleBindIndexBuffer(
+    Refresh_CommandBundle *commandBundle,
+    Refresh_BufferBinding *pBinding,
+    Refresh_IndexElementSize indexElementSize);
+
+/**
+ * Records a fragment sampler bind into a command bundle.
+ * You must not call this function before recording a graphics pipeline bind.
+ *
+ * \param commandBundle a command bundle
+ * \param firstSlot the fragment sampler slot to begin binding from
+ * \param textureSamplerBindings an array of texture-sampler binding structs
+ * \param bindingCount the number of texture-sampler bindings in the array
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_BindFragmentSamplers
+ */
+REFRESHAPI void Refresh_BundleBindFragmentSamplers(
+    Refresh_CommandBundle *commandBundle,
+    Uint32 firstSlot,
+    Refresh_TextureSamplerBinding *textureSamplerBindings,
+    Uint32 bindingCount);
+
+/**
+ * Records an indexed draw into a command bundle.
+ * You must not call this function before recording a graphics pipeline bind.
+ *
+ * \param commandBundle a command bundle
+ * \param baseVertex the starting offset to read from the vertex buffer
+ * \param startIndex the starting offset to read from the index buffer
+ * \param primitiveCount the number of primitives to draw
+ * \param instanceCount the number of instances that will be drawn
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_DrawIndexedPrimitives
+ */
+REFRESHAPI void Refresh_BundleDrawIndexedPrimitives(
+    Refresh_CommandBundle *commandBundle,
+    Uint32 baseVertex,
+    Uint32 startIndex,
+    Uint32 primitiveCount,
+    Uint32 instanceCount);
+
+/**
+ * Records a draw into a command bundle.
+ * You must not call this function before recording a graphics pipeline bind.
+ *
+ * \param commandBundle a command bundle
+ * \param vertexStart the starting offset to read from the vertex buffer
+ * \param primitiveCount the number of primitives to draw
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_DrawPrimitives
+ */
+REFRESHAPI void Refresh_BundleDrawPrimitives(
+    Refresh_CommandBundle *commandBundle,
+    Uint32 vertexStart,
+    Uint32 primitiveCount);
+
+/**
+ * Executes the commands recorded in a command bundle.
+ * Uniform data pushed before this call is used by the bundle's draws.
+ * Graphics state bound by the bundle stays bound afterwards.
+ * The bundle can be executed again or recorded into further at any time.
+ *
+ * \param renderPass a render pass handle
+ * \param commandBundle a command bundle
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_CreateCommandBundle
+ */
+REFRESHAPI void Refresh_ExecuteCommandBundle(
+    Refresh_RenderPass *renderPass,
+    Refresh_CommandBundle *commandBundle);
+
+/**
+ * Frees the given command bundle.
+ * Render passes that already executed the bundle are not affected.
+ *
+ * \param device a GPU context
+ * \param commandBundle a command bundle to be destroyed
+ *
+ * \since This function is available since Refresh 2.0.0
+ */
+REFRESHAPI void Refresh_ReleaseCommandBundle(
+    Refresh_Device *device,
+    Refresh_CommandBundle *commandBundle);
+
 /* Compute Pass */
 
 /**
@@ -1864,6 +2296,35 @@ REFRESHAPI void Refresh_UploadToBuffer(
     Refresh_BufferRegion *destination,
     SDL_bool cycle);
 
+/**
+ * Sub-allocates upload memory from a staging ring owned by the device.
+ *
+ * The staging ring is persistently mapped, so no transfer buffer has to be
+ * created, mapped or cycled by the application. Write the data to the returned
+ * pointer, then pass location to Refresh_UploadToBuffer or Refresh_UploadToTexture
+ * on the same copy pass. The range is recycled once the command buffer completes,
+ * so the pointer and location must not be used after the command buffer is submitted.
+ * The location's transfer buffer belongs to the device and must not be mapped,
+ * downloaded into or released.
+ *
+ * Ranges are aligned to 16 bytes, which satisfies the texel block size of every
+ * texture format. Requests larger than 4 MiB are served from a dedicated block.
+ *
+ * \param copyPass a copy pass handle
+ * \param sizeInBytes the number of bytes to reserve
+ * \param location receives the transfer buffer and offset of the reserved range
+ * \returns a pointer to the reserved range, or NULL on failure
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_UploadToBuffer
+ * \sa Refresh_UploadToTexture
+ */
+REFRESHAPI void *Refresh_AcquireStagingMemory(
+    Refresh_CopyPass *copyPass,
+    Uint32 sizeInBytes,
+    Refresh_TransferBufferLocation *location);
+
 /**
  * Performs a texture-to-texture copy.
  * This copy occurs on the GPU timeline.
@@ -1910,61 +2371,160 @@ REFRESHAPI void Refresh_CopyBufferToBuffer(
     Uint32 size,
     SDL_bool cycle);
 
+/* Batched copies */
+
 /**
- * Generates mipmaps for the given texture.
+ * Uploads many regions from transfer buffers to textures.
+ *
+ * Equivalent to calling Refresh_UploadToTexture once per region, but each
+ * destination texture slice is transitioned once for the whole batch and
+ * consecutive regions that share a transfer buffer and texture are recorded
+ * as a single copy command. Sort regions by destination to get the most out of this.
+ *
+ * Cycling is only considered at the first region that writes each texture,
+ * so later regions in the batch do not discard the earlier ones.
  *
  * \param copyPass a copy pass handle
- * \param texture a texture with more than 1 mip level
+ * \param sources an array of regionCount source transfer buffers with image layout information
+ * \param destinations an array of regionCount destination texture regions
+ * \param regionCount the number of regions to upload
+ * \param cycle if SDL_TRUE, cycles each texture if the texture slice is bound, otherwise overwrites the data.
  *
  * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_UploadToTexture
  */
-REFRESHAPI void Refresh_GenerateMipmaps(
+REFRESHAPI void Refresh_UploadToTextureRegions(
     Refresh_CopyPass *copyPass,
-    Refresh_Texture *texture);
+    Refresh_TextureTransferInfo *sources,
+    Refresh_TextureRegion *destinations,
+    Uint32 regionCount,
+    SDL_bool cycle);
 
 /**
- * Copies data from a texture to a transfer buffer on the GPU timeline.
- * This data is not guaranteed to be copied until the command buffer fence is signaled.
+ * Uploads many regions from transfer buffers to buffers.
+ *
+ * Equivalent to calling Refresh_UploadToBuffer once per region, with the
+ * same batching and cycling rules as Refresh_UploadToTextureRegions.
  *
  * \param copyPass a copy pass handle
- * \param source the source texture region
- * \param destination the destination transfer buffer with image layout information
+ * \param sources an array of regionCount source transfer buffers with offsets
+ * \param destinations an array of regionCount destination buffers with offset and size
+ * \param regionCount the number of regions to upload
+ * \param cycle if SDL_TRUE, cycles each buffer if it is bound, otherwise overwrites the data.
  *
  * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_UploadToBuffer
  */
-REFRESHAPI void Refresh_DownloadFromTexture(
+REFRESHAPI void Refresh_UploadToBufferRegions(
     Refresh_CopyPass *copyPass,
-    Refresh_TextureRegion *source,
-    Refresh_TextureTransferInfo *destination);
+    Refresh_TransferBufferLocation *sources,
+    Refresh_BufferRegion *destinations,
+    Uint32 regionCount,
+    SDL_bool cycle);
 
 /**
- * Copies data from a buffer to a transfer buffer on the GPU timeline.
- * This data is not guaranteed to be copied until the command buffer fence is signaled.
+ * Performs many buffer-to-buffer copies.
+ *
+ * Equivalent to calling Refresh_CopyBufferToBuffer once per region, with the
+ * same batching and cycling rules as Refresh_UploadToTextureRegions.
+ * A buffer must not be both a source and a destination within one batch.
  *
  * \param copyPass a copy pass handle
- * \param source the source buffer with offset and size
- * \param destination the destination transfer buffer with offset
+ * \param sources an array of regionCount buffers and offsets to copy from
+ * \param destinations an array of regionCount buffers, offsets and sizes to copy to
+ * \param regionCount the number of regions to copy
+ * \param cycle if SDL_TRUE, cycles each destination buffer if it is bound, otherwise overwrites the data.
  *
  * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_CopyBufferToBuffer
  */
-REFRESHAPI void Refresh_DownloadFromBuffer(
+REFRESHAPI void Refresh_CopyBufferToBufferRegions(
     Refresh_CopyPass *copyPass,
-    Refresh_BufferRegion *source,
-    Refresh_TransferBufferLocation *destination);
+    Refresh_BufferLocation *sources,
+    Refresh_BufferRegion *destinations,
+    Uint32 regionCount,
+    SDL_bool cycle);
 
 /**
- * Ends the current copy pass.
+ * Generates mipmaps for the given texture with a linear filter.
  *
  * \param copyPass a copy pass handle
+ * \param texture a texture with more than 1 mip level
  *
  * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_GenerateMipmapsWithFilter
  */
-REFRESHAPI void Refresh_EndCopyPass(
-    Refresh_CopyPass *copyPass);
+REFRESHAPI void Refresh_GenerateMipmaps(
+    Refresh_CopyPass *copyPass,
+    Refresh_Texture *texture);
 
 /**
- * Blits from a source texture region to a destination texture region.
- * This function must not be called inside of any render, compute, or copy pass.
+ * Generates mipmaps for the given texture with the given filter.
+ *
+ * On Vulkan, each level is downsampled from the previous one with a blit,
+ * and formats that can't be filtered linearly always use the nearest filter.
+ * D3D11 and Metal use the driver's own mipmap generation and ignore the filter.
+ *
+ * \param copyPass a copy pass handle
+ * \param texture a texture with more than 1 mip level
+ * \param filterMode the filter used to reduce each level
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_GenerateMipmaps
+ */
+REFRESHAPI void Refresh_GenerateMipmapsWithFilter(
+    Refresh_CopyPass *copyPass,
+    Refresh_Texture *texture,
+    Refresh_Filter filterMode);
+
+/**
+ * Copies data from a texture to a transfer buffer on the GPU timeline.
+ * This data is not guaranteed to be copied until the command buffer fence is signaled.
+ *
+ * \param copyPass a copy pass handle
+ * \param source the source texture region
+ * \param destination the destination transfer buffer with image layout information
+ *
+ * \since This function is available since Refresh 2.0.0
+ */
+REFRESHAPI void Refresh_DownloadFromTexture(
+    Refresh_CopyPass *copyPass,
+    Refresh_TextureRegion *source,
+    Refresh_TextureTransferInfo *destination);
+
+/**
+ * Copies data from a buffer to a transfer buffer on the GPU timeline.
+ * This data is not guaranteed to be copied until the command buffer fence is signaled.
+ *
+ * \param copyPass a copy pass handle
+ * \param source the source buffer with offset and size
+ * \param destination the destination transfer buffer with offset
+ *
+ * \since This function is available since Refresh 2.0.0
+ */
+REFRESHAPI void Refresh_DownloadFromBuffer(
+    Refresh_CopyPass *copyPass,
+    Refresh_BufferRegion *source,
+    Refresh_TransferBufferLocation *destination);
+
+/**
+ * Ends the current copy pass.
+ *
+ * \param copyPass a copy pass handle
+ *
+ * \since This function is available since Refresh 2.0.0
+ */
+REFRESHAPI void Refresh_EndCopyPass(
+    Refresh_CopyPass *copyPass);
+
+/**
+ * Blits from a source texture region to a destination texture region.
+ * This function must not be called inside of any render, compute, or copy pass.
  *
  * \param commandBuffer a command buffer
  * \param source the texture region to copy from
@@ -2090,6 +2650,53 @@ REFRESHAPI SDL_bool Refresh_SetSwapchainParameters(
     Refresh_SwapchainComposition swapchainComposition,
     Refresh_PresentMode presentMode);
 
+/**
+ * Sets how many presented frames of a claimed window may be in flight on the GPU.
+ *
+ * Once the limit is reached, Refresh_AcquireSwapchainTexture blocks until
+ * the least recent frame has completed. Outside of REFRESH_PRESENTMODE_VSYNC
+ * the Vulkan and D3D11 backends return NULL instead of blocking. Lower values reduce
+ * input-to-photon latency at the cost of CPU/GPU parallelism.
+ * The default is 3.
+ *
+ * Changing the value waits for the GPU to go idle.
+ *
+ * \param device a GPU context
+ * \param window an SDL_Window that has been claimed
+ * \param allowedFramesInFlight the frame limit, from 1 to 3
+ * \returns SDL_TRUE if successful, SDL_FALSE on error
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_WaitForSwapchain
+ * \sa Refresh_AcquireSwapchainTexture
+ */
+REFRESHAPI SDL_bool Refresh_SetAllowedFramesInFlight(
+    Refresh_Device *device,
+    SDL_Window *window,
+    Uint32 allowedFramesInFlight);
+
+/**
+ * Blocks until a claimed window can accept another frame.
+ *
+ * Calling this before polling input and recording the frame lets CPU work
+ * start as late as possible. The next Refresh_AcquireSwapchainTexture for
+ * the window will not block on the frames in flight limit.
+ * On D3D11 this also waits on the swapchain's frame latency waitable object.
+ *
+ * \param device a GPU context
+ * \param window an SDL_Window that has been claimed
+ * \returns SDL_TRUE if successful, SDL_FALSE on error
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_SetAllowedFramesInFlight
+ * \sa Refresh_AcquireSwapchainTexture
+ */
+REFRESHAPI SDL_bool Refresh_WaitForSwapchain(
+    Refresh_Device *device,
+    SDL_Window *window);
+
 /**
  * Obtains the texture format of the swapchain for the given window.
  *
@@ -2225,6 +2832,59 @@ REFRESHAPI void Refresh_ReleaseFence(
     Refresh_Device *device,
     Refresh_Fence *fence);
 
+/**
+ * Gets the submission value of a fence.
+ * Every submission on a device gets a larger value than the ones before it,
+ * so the value can be used to order fences or as a key for the work they guard.
+ * On Vulkan, the fence is signaled when its queue's timeline semaphore reaches this value
+ * if the device supports timeline semaphores.
+ *
+ * \param device a GPU context
+ * \param fence a fence
+ * \returns the submission value of the fence
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_SubmitAndAcquireFence
+ * \sa Refresh_AddFenceCallback
+ */
+REFRESHAPI Uint64 Refresh_GetFenceSubmissionValue(
+    Refresh_Device *device,
+    Refresh_Fence *fence);
+
+/**
+ * Called on the device's fence waiter thread once a fence has been signaled.
+ * The fence may be released from inside the callback.
+ */
+typedef void (SDLCALL *Refresh_FenceCallback)(
+    void *userdata,
+    Refresh_Fence *fence);
+
+/**
+ * Registers a callback that runs once the given fence is signaled.
+ *
+ * All pending callbacks of a device share a single wait on one worker thread,
+ * so no thread has to poll fences. Callbacks that become ready together run
+ * in submission order. The fence must not be released until its callback has run.
+ * Refresh_DestroyDevice waits for every pending callback to run.
+ *
+ * \param device a GPU context
+ * \param fence a fence
+ * \param callback a function called when the fence is signaled
+ * \param userdata a pointer passed to the callback
+ * \returns SDL_TRUE on success, SDL_FALSE if the callback could not be queued
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_SubmitAndAcquireFence
+ * \sa Refresh_WaitForFences
+ */
+REFRESHAPI SDL_bool Refresh_AddFenceCallback(
+    Refresh_Device *device,
+    Refresh_Fence *fence,
+    Refresh_FenceCallback callback,
+    void *userdata);
+
 /* Format Info */
 
 /**
@@ -2274,6 +2934,763 @@ REFRESHAPI Refresh_SampleCount Refresh_GetBestSampleCount(
     Refresh_TextureFormat format,
     Refresh_SampleCount desiredSampleCount);
 
+/* Pipeline Cache */
+
+/**
+ * Seeds the device pipeline cache with data previously obtained from
+ * Refresh_GetPipelineCacheData, typically loaded from disk at startup.
+ *
+ * Call this before creating any pipelines so that pipeline creation can
+ * skip shader compilation for cached entries. This must not be called
+ * concurrently with pipeline creation, including pending async compile tasks.
+ *
+ * Data produced by a different driver or device is rejected, in which case
+ * the cache is left untouched and pipelines are compiled from scratch.
+ * Backends without an application-visible pipeline cache (D3D11) always
+ * return SDL_FALSE; their drivers cache pipelines internally.
+ *
+ * \param device a GPU context
+ * \param data a pointer to the cache blob
+ * \param dataSize the size of the cache blob in bytes
+ * \returns SDL_TRUE if the data was accepted, SDL_FALSE otherwise
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_GetPipelineCacheData
+ */
+REFRESHAPI SDL_bool Refresh_LoadPipelineCacheData(
+    Refresh_Device *device,
+    const void *data,
+    size_t dataSize);
+
+/**
+ * Serializes the device pipeline cache so that it can be written to disk
+ * and restored on the next run with Refresh_LoadPipelineCacheData.
+ *
+ * Call this once with data set to NULL to query the required size,
+ * then again with a buffer of at least that size. On return pDataSize
+ * holds the number of bytes written.
+ *
+ * \param device a GPU context
+ * \param data a buffer to receive the cache blob, or NULL to query the size
+ * \param pDataSize the size of data in bytes, receives the size of the blob
+ * \returns SDL_TRUE on success, SDL_FALSE on failure or if the backend has no pipeline cache
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_LoadPipelineCacheData
+ */
+REFRESHAPI SDL_bool Refresh_GetPipelineCacheData(
+    Refresh_Device *device,
+    void *data,
+    size_t *pDataSize);
+
+/* Shader Cache */
+
+/**
+ * Seeds the SPIR-V translation cache with data previously obtained from
+ * Refresh_GetShaderCacheData, typically loaded from disk at startup.
+ *
+ * On backends that do not consume SPIR-V directly, every SPIR-V shader is
+ * cached by its contents after translation. Where the backend can produce
+ * native bytecode (DXBC on D3D11) that is what gets cached, so creating the
+ * same shader again skips both SPIRV-Cross and the native compiler.
+ * Otherwise (Metal) the translated source is cached.
+ *
+ * Data produced by a different backend or Refresh version is rejected.
+ * Backends that consume SPIR-V directly (Vulkan) always return SDL_FALSE.
+ *
+ * \param device a GPU context
+ * \param data a pointer to the cache blob
+ * \param dataSize the size of the cache blob in bytes
+ * \returns SDL_TRUE if all of the data was accepted, SDL_FALSE otherwise
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_GetShaderCacheData
+ */
+REFRESHAPI SDL_bool Refresh_LoadShaderCacheData(
+    Refresh_Device *device,
+    const void *data,
+    size_t dataSize);
+
+/**
+ * Serializes the SPIR-V translation cache so that it can be written to disk
+ * and restored on the next run with Refresh_LoadShaderCacheData.
+ *
+ * Call this once with data set to NULL to query the required size,
+ * then again with a buffer of at least that size. On return pDataSize
+ * holds the number of bytes written.
+ *
+ * \param device a GPU context
+ * \param data a buffer to receive the cache blob, or NULL to query the size
+ * \param pDataSize the size of data in bytes, receives the size of the blob
+ * \returns SDL_TRUE on success, SDL_FALSE on failure or if the backend has no shader cache
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_LoadShaderCacheData
+ */
+REFRESHAPI SDL_bool Refresh_GetShaderCacheData(
+    Refresh_Device *device,
+    void *data,
+    size_t *pDataSize);
+
+/* Async Compilation */
+
+/**
+ * Called on a compile worker thread once a compile task has finished.
+ * If no worker thread could be started, the task is compiled and the callback runs
+ * on the calling thread before the async create function returns.
+ * The task already counts as finished when the callback runs,
+ * so the result can be fetched without blocking and the task may be released from inside the callback.
+ */
+typedef void (SDLCALL *Refresh_CompileCallback)(
+    void *userdata,
+    Refresh_CompileTask *task);
+
+/**
+ * Starts creating a shader on a worker thread and returns immediately.
+ * SPIR-V translation and backend compilation both happen on the worker.
+ *
+ * The create info, including the code and entry point name, is copied,
+ * so it does not have to outlive this call.
+ *
+ * \param device a GPU Context
+ * \param shaderCreateInfo a struct describing the state of the desired shader
+ * \param callback a function called when the task completes, can be NULL
+ * \param userdata a pointer passed to the callback
+ * \returns a compile task handle
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_CreateShader
+ * \sa Refresh_GetCompiledShader
+ * \sa Refresh_ReleaseCompileTask
+ */
+REFRESHAPI Refresh_CompileTask *Refresh_CreateShaderAsync(
+    Refresh_Device *device,
+    Refresh_ShaderCreateInfo *shaderCreateInfo,
+    Refresh_CompileCallback callback,
+    void *userdata);
+
+/**
+ * Starts creating a graphics pipeline on a worker thread and returns immediately.
+ * The shaders referenced by the create info must already have been created.
+ *
+ * The create info, including its vertex input and attachment arrays, is copied,
+ * so it does not have to outlive this call.
+ *
+ * \param device a GPU Context
+ * \param pipelineCreateInfo a struct describing the state of the desired graphics pipeline
+ * \param callback a function called when the task completes, can be NULL
+ * \param userdata a pointer passed to the callback
+ * \returns a compile task handle
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_CreateGraphicsPipeline
+ * \sa Refresh_GetCompiledGraphicsPipeline
+ * \sa Refresh_ReleaseCompileTask
+ */
+REFRESHAPI Refresh_CompileTask *Refresh_CreateGraphicsPipelineAsync(
+    Refresh_Device *device,
+    Refresh_GraphicsPipelineCreateInfo *pipelineCreateInfo,
+    Refresh_CompileCallback callback,
+    void *userdata);
+
+/**
+ * Starts creating a compute pipeline on a worker thread and returns immediately.
+ *
+ * The create info, including the code and entry point name, is copied,
+ * so it does not have to outlive this call.
+ *
+ * \param device a GPU Context
+ * \param computePipelineCreateInfo a struct describing the state of the requested compute pipeline
+ * \param callback a function called when the task completes, can be NULL
+ * \param userdata a pointer passed to the callback
+ * \returns a compile task handle
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_CreateComputePipeline
+ * \sa Refresh_GetCompiledComputePipeline
+ * \sa Refresh_ReleaseCompileTask
+ */
+REFRESHAPI Refresh_CompileTask *Refresh_CreateComputePipelineAsync(
+    Refresh_Device *device,
+    Refresh_ComputePipelineCreateInfo *computePipelineCreateInfo,
+    Refresh_CompileCallback callback,
+    void *userdata);
+
+/**
+ * Checks whether a compile task has finished.
+ * A finished task's callback may still be running.
+ * This function does not block.
+ *
+ * \param task a compile task handle
+ * \returns SDL_TRUE if the task has finished, SDL_FALSE otherwise
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_WaitCompileTask
+ */
+REFRESHAPI SDL_bool Refresh_QueryCompileTask(
+    Refresh_CompileTask *task);
+
+/**
+ * Blocks the calling thread until a compile task has finished.
+ * This does not wait for the task's callback to return.
+ *
+ * \param task a compile task handle
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_QueryCompileTask
+ */
+REFRESHAPI void Refresh_WaitCompileTask(
+    Refresh_CompileTask *task);
+
+/**
+ * Fetches the shader created by a task from Refresh_CreateShaderAsync,
+ * blocking until it is available.
+ * Ownership of the shader passes to the caller.
+ *
+ * \param task a compile task handle
+ * \returns a shader object on success, or NULL on failure
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_CreateShaderAsync
+ * \sa Refresh_ReleaseShader
+ */
+REFRESHAPI Refresh_Shader *Refresh_GetCompiledShader(
+    Refresh_CompileTask *task);
+
+/**
+ * Fetches the graphics pipeline created by a task from Refresh_CreateGraphicsPipelineAsync,
+ * blocking until it is available.
+ * Ownership of the pipeline passes to the caller.
+ *
+ * \param task a compile task handle
+ * \returns a graphics pipeline object on success, or NULL on failure
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_CreateGraphicsPipelineAsync
+ * \sa Refresh_ReleaseGraphicsPipeline
+ */
+REFRESHAPI Refresh_GraphicsPipeline *Refresh_GetCompiledGraphicsPipeline(
+    Refresh_CompileTask *task);
+
+/**
+ * Fetches the compute pipeline created by a task from Refresh_CreateComputePipelineAsync,
+ * blocking until it is available.
+ * Ownership of the pipeline passes to the caller.
+ *
+ * \param task a compile task handle
+ * \returns a compute pipeline object on success, or NULL on failure
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_CreateComputePipelineAsync
+ * \sa Refresh_ReleaseComputePipeline
+ */
+REFRESHAPI Refresh_ComputePipeline *Refresh_GetCompiledComputePipeline(
+    Refresh_CompileTask *task);
+
+/**
+ * Frees a compile task, blocking until it has finished.
+ * If the task's callback is still running, the task is freed once it returns.
+ * The shader or pipeline the task created is not released.
+ *
+ * Every compile task must be released before the device is destroyed.
+ *
+ * \param task a compile task handle
+ *
+ * \since This function is available since Refresh 2.0.0
+ */
+REFRESHAPI void Refresh_ReleaseCompileTask(
+    Refresh_CompileTask *task);
+
+/* Timestamp Queries */
+
+/**
+ * Creates a pool of GPU timestamp queries.
+ *
+ * Timestamps are written into the pool by command buffers and read back on
+ * the CPU once those command buffers have finished executing. A typical use
+ * is to bracket each pass with two timestamps to measure its GPU time.
+ *
+ * All timestamps in a pool must be written by a single command buffer per
+ * submission. Use one pool per frame in flight to avoid stalling.
+ *
+ * \param device a GPU context
+ * \param queryCount the number of timestamps the pool can hold
+ * \returns a query pool object, or NULL if timestamps are unsupported
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_ResetQueryPool
+ * \sa Refresh_WriteTimestamp
+ * \sa Refresh_GetTimestampResults
+ * \sa Refresh_ReleaseQueryPool
+ */
+REFRESHAPI Refresh_QueryPool *Refresh_CreateTimestampQueryPool(
+    Refresh_Device *device,
+    Uint32 queryCount);
+
+/**
+ * Frees the given query pool as soon as it is safe to do so.
+ * You must not reference the query pool after calling this function.
+ *
+ * \param device a GPU context
+ * \param queryPool a query pool to be destroyed
+ *
+ * \since This function is available since Refresh 2.0.0
+ */
+REFRESHAPI void Refresh_ReleaseQueryPool(
+    Refresh_Device *device,
+    Refresh_QueryPool *queryPool);
+
+/**
+ * Resets every timestamp in the query pool.
+ *
+ * This must be recorded before any timestamps are written to the pool
+ * in the command buffer, and cannot be called during any kind of pass.
+ *
+ * \param commandBuffer a command buffer
+ * \param queryPool a query pool
+ *
+ * \since This function is available since Refresh 2.0.0
+ */
+REFRESHAPI void Refresh_ResetQueryPool(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_QueryPool *queryPool);
+
+/**
+ * Writes a GPU timestamp into the query pool once all previously recorded
+ * commands in the command buffer have completed.
+ *
+ * This may be called inside or outside of render, compute and copy passes.
+ * On Metal, timestamps can only be taken where the device supports counter
+ * sampling at the relevant boundary; unsupported samples resolve as unavailable.
+ *
+ * \param commandBuffer a command buffer
+ * \param queryPool a query pool that was reset in this command buffer
+ * \param queryIndex the index of the timestamp to write
+ *
+ * \since This function is available since Refresh 2.0.0
+ */
+REFRESHAPI void Refresh_WriteTimestamp(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_QueryPool *queryPool,
+    Uint32 queryIndex);
+
+/**
+ * Reads back timestamps written to a query pool, converted to nanoseconds.
+ *
+ * Only differences between timestamps are meaningful. Call this once the
+ * writing command buffer's fence has signaled, see Refresh_QueryFence.
+ * This function does not block.
+ *
+ * \param device a GPU context
+ * \param queryPool a query pool
+ * \param firstQuery the index of the first timestamp to read
+ * \param queryCount the number of timestamps to read
+ * \param results an array of queryCount values, filled with timestamps in nanoseconds
+ * \returns SDL_TRUE if every requested timestamp was available, SDL_FALSE otherwise
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_QueryFence
+ */
+REFRESHAPI SDL_bool Refresh_GetTimestampResults(
+    Refresh_Device *device,
+    Refresh_QueryPool *queryPool,
+    Uint32 firstQuery,
+    Uint32 queryCount,
+    Uint64 *results);
+
+/* Bindless Resources */
+
+/**
+ * Checks whether the device supports the bindless resource tables.
+ *
+ * When supported, textures, samplers and storage buffers can be registered
+ * once and indexed from shaders, so that draws and dispatches that only use
+ * bindless resources do not need to rebind or rewrite any descriptors.
+ * Currently only the Vulkan backend with VK_EXT_descriptor_indexing supports this.
+ *
+ * \param device a GPU context
+ * \returns SDL_TRUE if bindless resources are supported, SDL_FALSE otherwise
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_RegisterBindlessTexture
+ * \sa Refresh_RegisterBindlessSampler
+ * \sa Refresh_RegisterBindlessStorageBuffer
+ */
+REFRESHAPI SDL_bool Refresh_SupportsBindless(
+    Refresh_Device *device);
+
+/**
+ * Registers a texture in the bindless texture table.
+ *
+ * The texture must have been created with REFRESH_TEXTUREUSAGE_SAMPLER_BIT.
+ * Registered resources are not tracked by command buffers: the application
+ * must not release or unregister them while submitted work may still read them.
+ * A registered texture is never cycled, cycle parameters are ignored for it.
+ *
+ * \param device a GPU context
+ * \param texture the texture to register
+ * \param pIndex receives the index of the texture in the bindless texture table
+ * \returns SDL_TRUE on success, SDL_FALSE if unsupported or the table is full
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_UnregisterBindlessResource
+ */
+REFRESHAPI SDL_bool Refresh_RegisterBindlessTexture(
+    Refresh_Device *device,
+    Refresh_Texture *texture,
+    Uint32 *pIndex);
+
+/**
+ * Registers a sampler in the bindless sampler table.
+ *
+ * Registered resources are not tracked by command buffers: the application
+ * must not release or unregister them while submitted work may still read them.
+ *
+ * \param device a GPU context
+ * \param sampler the sampler to register
+ * \param pIndex receives the index of the sampler in the bindless sampler table
+ * \returns SDL_TRUE on success, SDL_FALSE if unsupported or the table is full
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_UnregisterBindlessResource
+ */
+REFRESHAPI SDL_bool Refresh_RegisterBindlessSampler(
+    Refresh_Device *device,
+    Refresh_Sampler *sampler,
+    Uint32 *pIndex);
+
+/**
+ * Registers a buffer in the bindless storage buffer table.
+ *
+ * The buffer must have been created with a storage usage bit.
+ * Registered resources are not tracked by command buffers: the application
+ * must not release or unregister them while submitted work may still read them.
+ * A registered buffer is never cycled, cycle parameters are ignored for it.
+ *
+ * \param device a GPU context
+ * \param buffer the buffer to register
+ * \param pIndex receives the index of the buffer in the bindless storage buffer table
+ * \returns SDL_TRUE on success, SDL_FALSE if unsupported or the table is full
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_UnregisterBindlessResource
+ */
+REFRESHAPI SDL_bool Refresh_RegisterBindlessStorageBuffer(
+    Refresh_Device *device,
+    Refresh_Buffer *buffer,
+    Uint32 *pIndex);
+
+/**
+ * Frees a slot in one of the bindless tables so that it can be reused.
+ *
+ * Releasing a registered resource frees its slot automatically.
+ *
+ * \param device a GPU context
+ * \param resourceType the table the resource was registered in
+ * \param index the index returned at registration
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_RegisterBindlessTexture
+ * \sa Refresh_RegisterBindlessSampler
+ * \sa Refresh_RegisterBindlessStorageBuffer
+ */
+REFRESHAPI void Refresh_UnregisterBindlessResource(
+    Refresh_Device *device,
+    Refresh_BindlessResourceType resourceType,
+    Uint32 index);
+
+/* Resource Cycling */
+
+/**
+ * Limits how many backing resources a buffer may hold for cycling.
+ *
+ * When a buffer is written with cycling enabled while its current backing
+ * resource is still in use, the driver switches to an idle one or creates a
+ * new one. Once the limit is reached, the cycle request is ignored and the
+ * write is performed as if cycling were disabled. A limit of 0 means no limit,
+ * which is the default. Backing resources that already exist are not
+ * released by lowering the limit, see Refresh_SetCycleTrimFrames.
+ *
+ * \param device a GPU context
+ * \param buffer the buffer to limit
+ * \param maxCycleCount the maximum number of backing resources, or 0 for no limit
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_GetBufferCycleCount
+ * \sa Refresh_SetCycleTrimFrames
+ */
+REFRESHAPI void Refresh_SetBufferCycleLimit(
+    Refresh_Device *device,
+    Refresh_Buffer *buffer,
+    Uint32 maxCycleCount);
+
+/**
+ * Limits how many backing resources a transfer buffer may hold for cycling.
+ *
+ * Once the limit is reached, mapping or setting data with cycling enabled
+ * writes to the current backing resource, which may overwrite data that
+ * submitted work has not read yet. Use fences to avoid this.
+ * A limit of 0 means no limit, which is the default.
+ *
+ * \param device a GPU context
+ * \param transferBuffer the transfer buffer to limit
+ * \param maxCycleCount the maximum number of backing resources, or 0 for no limit
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_GetTransferBufferCycleCount
+ * \sa Refresh_SetCycleTrimFrames
+ */
+REFRESHAPI void Refresh_SetTransferBufferCycleLimit(
+    Refresh_Device *device,
+    Refresh_TransferBuffer *transferBuffer,
+    Uint32 maxCycleCount);
+
+/**
+ * Limits how many backing resources a texture may hold for cycling.
+ *
+ * Once the limit is reached, the cycle request is ignored and the write is
+ * performed as if cycling were disabled. A limit of 0 means no limit,
+ * which is the default.
+ *
+ * \param device a GPU context
+ * \param texture the texture to limit
+ * \param maxCycleCount the maximum number of backing resources, or 0 for no limit
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_GetTextureCycleCount
+ * \sa Refresh_SetCycleTrimFrames
+ */
+REFRESHAPI void Refresh_SetTextureCycleLimit(
+    Refresh_Device *device,
+    Refresh_Texture *texture,
+    Uint32 maxCycleCount);
+
+/**
+ * Queries how many backing resources a buffer currently holds for cycling.
+ *
+ * \param device a GPU context
+ * \param buffer the buffer to query
+ * \returns the number of backing resources, at least 1
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_SetBufferCycleLimit
+ */
+REFRESHAPI Uint32 Refresh_GetBufferCycleCount(
+    Refresh_Device *device,
+    Refresh_Buffer *buffer);
+
+/**
+ * Queries how many backing resources a transfer buffer currently holds for cycling.
+ *
+ * \param device a GPU context
+ * \param transferBuffer the transfer buffer to query
+ * \returns the number of backing resources, at least 1
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_SetTransferBufferCycleLimit
+ */
+REFRESHAPI Uint32 Refresh_GetTransferBufferCycleCount(
+    Refresh_Device *device,
+    Refresh_TransferBuffer *transferBuffer);
+
+/**
+ * Queries how many backing resources a texture currently holds for cycling.
+ *
+ * \param device a GPU context
+ * \param texture the texture to query
+ * \returns the number of backing resources, at least 1
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_SetTextureCycleLimit
+ */
+REFRESHAPI Uint32 Refresh_GetTextureCycleCount(
+    Refresh_Device *device,
+    Refresh_Texture *texture);
+
+/**
+ * Releases idle cycled backing resources of resources that have not cycled for a number of frames.
+ *
+ * Trimming runs on presenting submissions. A resource that has not been
+ * cycled for frameCount presented frames releases every backing resource
+ * that is idle, other than the current one. A frameCount of 0 disables
+ * trimming, which is the default.
+ *
+ * \param device a GPU context
+ * \param frameCount the number of presented frames without cycling before trimming, or 0 to disable
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_SetBufferCycleLimit
+ * \sa Refresh_SetTextureCycleLimit
+ * \sa Refresh_GetDeviceStatistics
+ */
+REFRESHAPI void Refresh_SetCycleTrimFrames(
+    Refresh_Device *device,
+    Uint32 frameCount);
+
+/* Defragmentation */
+
+/**
+ * Configures when memory defragmentation runs and how much work it may do per frame.
+ *
+ * Defragmentation moves resources out of fragmented allocations so that the
+ * emptied allocations can be released. It runs on presenting submissions and
+ * moves at least one resource each time, so the budgets are soft limits.
+ * The default settings are automatic with no limits, which empties one
+ * fragmented allocation per presented frame.
+ * Currently only the Vulkan backend defragments memory.
+ *
+ * \param device a GPU context
+ * \param settings the new defragmentation settings
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_RequestDefragmentation
+ * \sa Refresh_GetDeviceStatistics
+ */
+REFRESHAPI void Refresh_SetDefragmentationSettings(
+    Refresh_Device *device,
+    Refresh_DefragmentationSettings *settings);
+
+/**
+ * Queues all currently fragmented memory for defragmentation on the next presenting submissions.
+ *
+ * This is useful when automatic defragmentation is disabled, for example to compact
+ * memory during a loading screen. Has no effect while a previous pass is still queued.
+ *
+ * \param device a GPU context
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_SetDefragmentationSettings
+ */
+REFRESHAPI void Refresh_RequestDefragmentation(
+    Refresh_Device *device);
+
+/* Statistics */
+
+/**
+ * Queries driver counters, intended for profiling and telemetry.
+ *
+ * Counters are cumulative since device creation and are updated as submitted
+ * command buffers are cleaned up, so recent work may not be included yet.
+ * Counters that do not apply to the backend are zero.
+ *
+ * \param device a GPU context
+ * \param statistics filled with the current counter values
+ *
+ * \since This function is available since Refresh 2.0.0
+ */
+REFRESHAPI void Refresh_GetDeviceStatistics(
+    Refresh_Device *device,
+    Refresh_DeviceStatistics *statistics);
+
+/**
+ * Queries device memory usage and the budget reported by the OS.
+ *
+ * Unlike Refresh_GetDeviceStatistics, values are current at the time of the call.
+ * On Vulkan the budget comes from VK_EXT_memory_budget when available and
+ * falls back to the device-local heap sizes, which does not account for other processes.
+ * On D3D11 and Metal the driver owns resource placement, so allocatedBytes and
+ * usedBytes report the driver's usage and the allocation and free region fields are zero.
+ *
+ * \param device a GPU context
+ * \param statistics filled with the current memory statistics
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_GetDeviceStatistics
+ */
+REFRESHAPI void Refresh_GetMemoryStatistics(
+    Refresh_Device *device,
+    Refresh_MemoryStatistics *statistics);
+
+/* Instrumentation */
+
+/**
+ * Queries the CPU time spent in driver code by each entry point.
+ *
+ * Timings are only recorded when Refresh is built with REFRESH_INSTRUMENTATION.
+ * The timer covers the backend call made by the entry point, so frontend
+ * validation is excluded. Timings are global and shared by all devices.
+ * Entry points appear once they have been called at least once.
+ *
+ * \param pEntries filled with up to entryCount entries, may be NULL
+ * \param entryCount the number of elements in pEntries
+ * \returns the number of instrumented entry points called so far, 0 if instrumentation is unavailable
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_ResetInstrumentation
+ */
+REFRESHAPI Uint32 Refresh_GetInstrumentationEntries(
+    Refresh_InstrumentationEntry *pEntries,
+    Uint32 entryCount);
+
+/**
+ * Resets all instrumentation counters to zero.
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_GetInstrumentationEntries
+ */
+REFRESHAPI void Refresh_ResetInstrumentation(void);
+
+/**
+ * Begins recording a trace of every instrumented call.
+ *
+ * Events are kept in memory until Refresh_EndInstrumentationTrace is called.
+ * Calls past maxEventCount are counted but not recorded.
+ *
+ * \param maxEventCount the maximum number of calls to record
+ * \returns SDL_TRUE on success, SDL_FALSE if instrumentation is unavailable or a trace is already in progress
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_EndInstrumentationTrace
+ */
+REFRESHAPI SDL_bool Refresh_BeginInstrumentationTrace(
+    Uint32 maxEventCount);
+
+/**
+ * Ends the current trace and writes it to disk in the Chrome trace event format,
+ * which can be opened with chrome://tracing or Perfetto.
+ *
+ * \param filename the path of the trace file, or NULL to discard the trace
+ * \returns SDL_TRUE on success, SDL_FALSE if no trace is in progress or the file could not be written
+ *
+ * \since This function is available since Refresh 2.0.0
+ *
+ * \sa Refresh_BeginInstrumentationTrace
+ */
+REFRESHAPI SDL_bool Refresh_EndInstrumentationTrace(
+    const char *filename);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
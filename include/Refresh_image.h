@@ -29,6 +29,8 @@
 
 #include <SDL_stdinc.h>
 
+#include "Refresh.h"
+
 #ifdef _WIN32
 #define REFRESHAPI  __declspec(dllexport)
 #define REFRESHCALL __cdecl
@@ -74,12 +76,141 @@ REFRESHAPI SDL_bool Refresh_Image_Info(
     int32_t *h,
     int32_t *len);
 
+/* Decodes image data into raw RGBA8 texture data, writing the rows straight
+ * into caller-provided memory such as a mapped transfer buffer region.
+ * Use Refresh_Image_Info first to find out how much room the image needs.
+ *
+ * dst:			Filled with the pixel rows.
+ * dstRowPitch:	The distance in bytes between the start of two rows in dst.
+ *				Must be at least the image width times 4.
+ * dstLength:	The size of dst in bytes.
+ * w:		    Filled with the width of the image.
+ * h:		    Filled with the height of the image.
+ *
+ * Returns SDL_FALSE if decoding failed or the image does not fit in dst.
+ */
+REFRESHAPI SDL_bool Refresh_Image_LoadInto(
+    uint8_t *bufferPtr,
+    int32_t bufferLength,
+    uint8_t *dst,
+    int32_t dstRowPitch,
+    int32_t dstLength,
+    int32_t *w,
+    int32_t *h);
+
+/* One image for Refresh_Image_LoadBatch, see Refresh_Image_LoadInto. */
+typedef struct Refresh_Image_DecodeRequest
+{
+    uint8_t *bufferPtr;
+    int32_t bufferLength;
+    uint8_t *dst;
+    int32_t dstRowPitch;
+    int32_t dstLength;
+    int32_t w;          /* Filled with the width of the image. */
+    int32_t h;          /* Filled with the height of the image. */
+    SDL_bool succeeded; /* Filled with the result of Refresh_Image_LoadInto. */
+} Refresh_Image_DecodeRequest;
+
+/* Decodes a batch of images with Refresh_Image_LoadInto on worker threads,
+ * blocking until every image is done. The destinations must not overlap.
+ * On MinGW, decode failures are logged without stb_image's failure reason,
+ * since it has no thread-safe storage for it there.
+ *
+ * requests:		The images to decode.
+ * requestCount:	The number of requests.
+ * threadCount:		The maximum number of worker threads, or 0 to pick one
+ *					based on the CPU count.
+ *
+ * Returns the number of images that were decoded successfully.
+ */
+REFRESHAPI int32_t Refresh_Image_LoadBatch(
+    Refresh_Image_DecodeRequest *requests,
+    int32_t requestCount,
+    int32_t threadCount);
+
 /* Frees memory returned by Refresh_Image_Load. Do NOT free the memory yourself!
  *
  * mem: A pointer previously returned by Refresh_Image_LoadPNG.
  */
 REFRESHAPI void Refresh_Image_Free(uint8_t *mem);
 
+/* Compressed Texture Container API */
+
+/* One mip level of one array layer (or cube face) inside a container file. */
+typedef struct Refresh_Image_Subresource
+{
+    uint32_t offset;	/* Offset of the texel data from the start of the file. */
+    uint32_t length;	/* Length of the texel data in bytes. */
+    uint32_t mipLevel;
+    uint32_t layer;		/* Array layer, or cube face for cube textures. */
+    uint32_t w;
+    uint32_t h;
+    uint32_t d;
+} Refresh_Image_Subresource;
+
+typedef struct Refresh_Image_TextureInfo
+{
+    /* Ready for Refresh_CreateTexture, with the SAMPLER usage bit set. */
+    Refresh_TextureCreateInfo createInfo;
+
+    /* The span of the file holding all of the texel data. */
+    uint32_t dataOffset;
+    uint32_t dataLength;
+
+    uint32_t subresourceCount;
+    Refresh_Image_Subresource *subresources;
+} Refresh_Image_TextureInfo;
+
+/* Parses a DDS file without decoding its texel data.
+ * BC1, BC2, BC3 and BC7 (including the sRGB variants Refresh supports) as well
+ * as RGBA8 and BGRA8 are accepted, both with and without the DX10 header.
+ * 2D textures, texture arrays, cube maps and volume textures are supported.
+ *
+ * info:	Filled with the texture description and subresource layout.
+ *
+ * Returns SDL_TRUE on success.
+ * Be sure to free the info with Refresh_Image_FreeTextureInfo after use!
+ */
+REFRESHAPI SDL_bool Refresh_Image_LoadDDS(
+    uint8_t *bufferPtr,
+    int32_t bufferLength,
+    Refresh_Image_TextureInfo *info);
+
+/* Parses a KTX2 file without decoding its texel data.
+ * Accepts the same formats as Refresh_Image_LoadDDS.
+ * Supercompressed (Basis Universal, Zstandard) files are rejected.
+ *
+ * info:	Filled with the texture description and subresource layout.
+ *
+ * Returns SDL_TRUE on success.
+ * Be sure to free the info with Refresh_Image_FreeTextureInfo after use!
+ */
+REFRESHAPI SDL_bool Refresh_Image_LoadKTX2(
+    uint8_t *bufferPtr,
+    int32_t bufferLength,
+    Refresh_Image_TextureInfo *info);
+
+/* Fills in the arrays for Refresh_UploadToTextureRegions, assuming the file's
+ * texel data span (dataOffset, dataLength) has been copied in one piece into
+ * the transfer buffer at transferBufferOffset. Keep that offset aligned to 16
+ * bytes so every region stays aligned to its texel block size.
+ *
+ * info:					A texture info filled by one of the loaders above.
+ * texture:					The texture created from info->createInfo.
+ * sources:					Filled with info->subresourceCount transfer infos.
+ * destinations:			Filled with info->subresourceCount texture regions.
+ */
+REFRESHAPI void Refresh_Image_GetUploadRegions(
+    Refresh_Image_TextureInfo *info,
+    Refresh_Texture *texture,
+    Refresh_TransferBuffer *transferBuffer,
+    uint32_t transferBufferOffset,
+    Refresh_TextureTransferInfo *sources,
+    Refresh_TextureRegion *destinations);
+
+/* Frees the subresource layout filled by Refresh_Image_LoadDDS or Refresh_Image_LoadKTX2. */
+REFRESHAPI void Refresh_Image_FreeTextureInfo(Refresh_Image_TextureInfo *info);
+
 /* Image Write API */
 
 /* Returns a buffer of PNG encoded from RGBA8 color data.
@@ -95,6 +226,42 @@ REFRESHAPI void Refresh_Image_SavePNG(
     int32_t w,
     int32_t h);
 
+/* Texture Capture API */
+
+typedef struct Refresh_Image_CaptureQueue Refresh_Image_CaptureQueue;
+
+/* Creates a queue that saves textures to PNG files without stalling the caller.
+ * A background thread polls the download fences and encodes the images.
+ * Returns NULL if the background thread could not be started.
+ *
+ * device:	The device that owns the textures to be captured.
+ */
+REFRESHAPI Refresh_Image_CaptureQueue *Refresh_Image_CreateCaptureQueue(
+    Refresh_Device *device);
+
+/* Downloads a region of a texture and saves it as a PNG in the background.
+ * The download is submitted on its own command buffer, so call this after
+ * submitting the commands that render to the texture.
+ *
+ * queue:		A queue created with Refresh_Image_CreateCaptureQueue.
+ * region:		The texture region to capture. Must be a single 2D slice.
+ * format:		The format of the texture. Must be RGBA8 or BGRA8, either sRGB or not.
+ * filename:	The path of the PNG to write. The string is copied.
+ *
+ * Returns SDL_FALSE if the capture could not be queued.
+ */
+REFRESHAPI SDL_bool Refresh_Image_CaptureTexturePNG(
+    Refresh_Image_CaptureQueue *queue,
+    Refresh_TextureRegion *region,
+    Refresh_TextureFormat format,
+    const char *filename);
+
+/* Blocks until every queued capture has been written, then frees the queue.
+ * This must be called before the device is destroyed.
+ */
+REFRESHAPI void Refresh_Image_DestroyCaptureQueue(
+    Refresh_Image_CaptureQueue *queue);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
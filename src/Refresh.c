@@ -57,18 +57,48 @@
         return NULL;                                                             \
     }
 
+#define CHECK_GRAPHICS_QUEUE                                                                     \
+    if (((CommandBufferCommonHeader *)commandBuffer)->queueType != REFRESH_QUEUETYPE_GRAPHICS) { \
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Command requires a graphics queue!");        \
+        return;                                                                                  \
+    }
+
+#define CHECK_GRAPHICS_QUEUE_RETURN_NULL                                                         \
+    if (((CommandBufferCommonHeader *)commandBuffer)->queueType != REFRESH_QUEUETYPE_GRAPHICS) { \
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Command requires a graphics queue!");        \
+        return NULL;                                                                             \
+    }
+
+#define CHECK_COMPUTE_QUEUE_RETURN_NULL                                                          \
+    if (((CommandBufferCommonHeader *)commandBuffer)->queueType == REFRESH_QUEUETYPE_TRANSFER) { \
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Command requires a compute queue!");         \
+        return NULL;                                                                             \
+    }
+
 #define CHECK_RENDERPASS                                                            \
     if (!((Pass *)renderPass)->inProgress) {                                        \
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Render pass not in progress!"); \
         return;                                                                     \
     }
 
+#define CHECK_NOT_PARALLEL_RENDERPASS                                                        \
+    if (((CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER)->parallelRenderPass) {      \
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Parallel render pass requires chunks!"); \
+        return;                                                                              \
+    }
+
 #define CHECK_GRAPHICS_PIPELINE_BOUND                                                       \
     if (!((CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER)->graphicsPipelineBound) { \
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Graphics pipeline not bound!");         \
         return;                                                                             \
     }
 
+#define CHECK_BUNDLE_GRAPHICS_PIPELINE_BOUND                                        \
+    if (!bundle->graphicsPipelineBound) {                                           \
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Graphics pipeline not bound!"); \
+        return;                                                                     \
+    }
+
 #define CHECK_COMPUTEPASS                                                            \
     if (!((Pass *)computePass)->inProgress) {                                        \
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Compute pass not in progress!"); \
@@ -87,6 +117,12 @@
         return;                                                                   \
     }
 
+#define CHECK_COPYPASS_RETURN_NULL                                                \
+    if (!((Pass *)copyPass)->inProgress) {                                        \
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Copy pass not in progress!"); \
+        return NULL;                                                              \
+    }
+
 #define COMMAND_BUFFER_DEVICE \
     ((CommandBufferCommonHeader *)commandBuffer)->device
 
@@ -108,6 +144,114 @@
 #define COPYPASS_DEVICE \
     ((CommandBufferCommonHeader *)COPYPASS_COMMAND_BUFFER)->device
 
+/* Instrumentation, only compiled in with REFRESH_INSTRUMENTATION */
+
+#ifdef REFRESH_INSTRUMENTATION
+
+typedef struct InstrumentationCounter
+{
+    const char *name;
+    SDL_atomic_t registered;
+    SDL_SpinLock lock;
+    Uint64 callCount;
+    Uint64 totalTicks;
+    Uint64 maxTicks;
+    struct InstrumentationCounter *next;
+} InstrumentationCounter;
+
+typedef struct InstrumentationEvent
+{
+    InstrumentationCounter *counter;
+    SDL_threadID threadID;
+    Uint64 startTicks;
+    Uint64 durationTicks;
+} InstrumentationEvent;
+
+typedef struct InstrumentationState
+{
+    SDL_SpinLock lock;
+
+    /* Counters register themselves on their first call */
+    InstrumentationCounter *counters;
+    Uint32 counterCount;
+
+    /* Chrome trace capture, events past the capacity are dropped */
+    SDL_atomic_t tracing;
+    InstrumentationEvent *events;
+    Uint32 eventCount;
+    Uint32 eventCapacity;
+    Uint32 droppedEventCount;
+    Uint64 traceStartTicks;
+} InstrumentationState;
+
+static InstrumentationState instrumentation;
+
+static Uint64 Instrumentation_Begin(InstrumentationCounter *counter)
+{
+    if (!SDL_AtomicGet(&counter->registered)) {
+        SDL_AtomicLock(&instrumentation.lock);
+        if (!SDL_AtomicGet(&counter->registered)) {
+            counter->next = instrumentation.counters;
+            instrumentation.counters = counter;
+            instrumentation.counterCount += 1;
+            SDL_AtomicSet(&counter->registered, 1);
+        }
+        SDL_AtomicUnlock(&instrumentation.lock);
+    }
+
+    return SDL_GetPerformanceCounter();
+}
+
+static void Instrumentation_End(InstrumentationCounter *counter, Uint64 startTicks)
+{
+    Uint64 durationTicks = SDL_GetPerformanceCounter() - startTicks;
+    InstrumentationEvent *event;
+
+    SDL_AtomicLock(&counter->lock);
+    counter->callCount += 1;
+    counter->totalTicks += durationTicks;
+    counter->maxTicks = SDL_max(counter->maxTicks, durationTicks);
+    SDL_AtomicUnlock(&counter->lock);
+
+    if (SDL_AtomicGet(&instrumentation.tracing)) {
+        SDL_AtomicLock(&instrumentation.lock);
+        if (instrumentation.eventCount < instrumentation.eventCapacity) {
+            event = &instrumentation.events[instrumentation.eventCount];
+            event->counter = counter;
+            event->threadID = SDL_ThreadID();
+            event->startTicks = startTicks;
+            event->durationTicks = durationTicks;
+            instrumentation.eventCount += 1;
+        } else {
+            instrumentation.droppedEventCount += 1;
+        }
+        SDL_AtomicUnlock(&instrumentation.lock);
+    }
+}
+
+static Uint64 Instrumentation_TicksToNanoseconds(Uint64 ticks)
+{
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+
+    /* Split to avoid overflowing on long captures */
+    return (ticks / frequency) * 1000000000 + ((ticks % frequency) * 1000000000) / frequency;
+}
+
+/* Placed around the driver call of an entry point, so validation isn't counted */
+#define INSTRUMENT_BEGIN(name)                                             \
+    static InstrumentationCounter instrumentation_##name = { #name };      \
+    Uint64 instrumentationStart_##name = Instrumentation_Begin(&instrumentation_##name)
+
+#define INSTRUMENT_END(name) \
+    Instrumentation_End(&instrumentation_##name, instrumentationStart_##name)
+
+#else
+
+#define INSTRUMENT_BEGIN(name)
+#define INSTRUMENT_END(name)
+
+#endif /* REFRESH_INSTRUMENTATION */
+
 /* Drivers */
 
 static const Refresh_Driver *backends[] = {
@@ -123,6 +267,16 @@ static const Refresh_Driver *backends[] = {
     NULL
 };
 
+/* Async Compilation, see below */
+
+struct CompileWorkerPool;
+static void CompileWorkerPool_Destroy(struct CompileWorkerPool *pool);
+
+/* Fence Callbacks, see below */
+
+struct FenceCallbackWaiter;
+static void FenceCallbackWaiter_Destroy(struct FenceCallbackWaiter *waiter);
+
 /* Driver Functions */
 
 static Refresh_Backend Refresh_SelectBackend(Refresh_Backend preferredBackends)
@@ -179,6 +333,14 @@ Refresh_Device *Refresh_CreateDevice(
                 result = backends[i]->CreateDevice(debugMode, preferLowPower);
                 if (result != NULL) {
                     result->backend = backends[i]->backendflag;
+                    result->shaderCache = NULL;
+                    if (result->backend != REFRESH_BACKEND_VULKAN) {
+                        result->shaderCache = SDL_CreateShaderCache();
+                    }
+                    result->compileWorkerPool = NULL;
+                    result->compileWorkerPoolLock = 0;
+                    result->fenceCallbackWaiter = NULL;
+                    result->fenceCallbackWaiterLock = 0;
                     break;
                 }
             }
@@ -191,6 +353,22 @@ void Refresh_DestroyDevice(Refresh_Device *device)
 {
     CHECK_DEVICE_MAGIC(device, );
 
+    /* Runs every outstanding fence callback, so this has to happen while the driver is alive */
+    if (device->fenceCallbackWaiter != NULL) {
+        FenceCallbackWaiter_Destroy(device->fenceCallbackWaiter);
+        device->fenceCallbackWaiter = NULL;
+    }
+
+    if (device->compileWorkerPool != NULL) {
+        CompileWorkerPool_Destroy(device->compileWorkerPool);
+        device->compileWorkerPool = NULL;
+    }
+
+    if (device->shaderCache != NULL) {
+        SDL_DestroyShaderCache(device->shaderCache);
+        device->shaderCache = NULL;
+    }
+
     device->DestroyDevice(device);
 }
 
@@ -280,412 +458,1446 @@ Refresh_SampleCount Refresh_GetBestSampleCount(
         desiredSampleCount);
 }
 
-/* State Creation */
+/* Pipeline Cache */
 
-Refresh_ComputePipeline *Refresh_CreateComputePipeline(
+SDL_bool Refresh_LoadPipelineCacheData(
     Refresh_Device *device,
-    Refresh_ComputePipelineCreateInfo *computePipelineCreateInfo)
+    const void *data,
+    size_t dataSize)
 {
-    CHECK_DEVICE_MAGIC(device, NULL);
-    if (computePipelineCreateInfo == NULL) {
-        SDL_InvalidParamError("computePipelineCreateInfo");
-        return NULL;
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
+    if (data == NULL) {
+        SDL_InvalidParamError("data");
+        return SDL_FALSE;
     }
-
-    /* FIXME DEBUGMODE */
-    if (computePipelineCreateInfo->threadCountX == 0 ||
-        computePipelineCreateInfo->threadCountY == 0 ||
-        computePipelineCreateInfo->threadCountZ == 0) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "All ComputePipeline threadCount dimensions must be at least 1!");
-        return NULL;
+    if (dataSize == 0) {
+        return SDL_FALSE;
     }
 
-    if (computePipelineCreateInfo->format == REFRESH_SHADERFORMAT_SPIRV &&
-        device->backend != REFRESH_BACKEND_VULKAN) {
-        return SDL_CompileFromSPIRV(device, computePipelineCreateInfo, SDL_TRUE);
+    SDL_bool result;
+    INSTRUMENT_BEGIN(Refresh_LoadPipelineCacheData);
+    result = device->LoadPipelineCacheData(
+        device->driverData,
+        data,
+        dataSize);
+    INSTRUMENT_END(Refresh_LoadPipelineCacheData);
+    return result;
+}
+
+SDL_bool Refresh_GetPipelineCacheData(
+    Refresh_Device *device,
+    void *data,
+    size_t *pDataSize)
+{
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
+    if (pDataSize == NULL) {
+        SDL_InvalidParamError("pDataSize");
+        return SDL_FALSE;
     }
-    return device->CreateComputePipeline(
+
+    SDL_bool result;
+    INSTRUMENT_BEGIN(Refresh_GetPipelineCacheData);
+    result = device->GetPipelineCacheData(
         device->driverData,
-        computePipelineCreateInfo);
+        data,
+        pDataSize);
+    INSTRUMENT_END(Refresh_GetPipelineCacheData);
+    return result;
 }
 
-Refresh_GraphicsPipeline *Refresh_CreateGraphicsPipeline(
+/* Shader Cache */
+
+SDL_bool Refresh_LoadShaderCacheData(
     Refresh_Device *device,
-    Refresh_GraphicsPipelineCreateInfo *graphicsPipelineCreateInfo)
+    const void *data,
+    size_t dataSize)
 {
-    Refresh_TextureFormat newFormat;
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
+    if (data == NULL) {
+        SDL_InvalidParamError("data");
+        return SDL_FALSE;
+    }
+    if (dataSize == 0) {
+        return SDL_FALSE;
+    }
 
-    CHECK_DEVICE_MAGIC(device, NULL);
-    if (graphicsPipelineCreateInfo == NULL) {
-        SDL_InvalidParamError("graphicsPipelineCreateInfo");
-        return NULL;
+    return SDL_LoadShaderCacheData(
+        device,
+        data,
+        dataSize);
+}
+
+SDL_bool Refresh_GetShaderCacheData(
+    Refresh_Device *device,
+    void *data,
+    size_t *pDataSize)
+{
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
+    if (pDataSize == NULL) {
+        SDL_InvalidParamError("pDataSize");
+        return SDL_FALSE;
     }
 
-    /* Automatically swap out the depth format if it's unsupported.
-     * See Refresh_CreateTexture.
-     */
-    if (
-        graphicsPipelineCreateInfo->attachmentInfo.hasDepthStencilAttachment &&
-        !device->IsTextureFormatSupported(
-            device->driverData,
-            graphicsPipelineCreateInfo->attachmentInfo.depthStencilFormat,
-            REFRESH_TEXTURETYPE_2D,
-            REFRESH_TEXTUREUSAGE_DEPTH_STENCIL_TARGET_BIT)) {
-        switch (graphicsPipelineCreateInfo->attachmentInfo.depthStencilFormat) {
-        case REFRESH_TEXTUREFORMAT_D24_UNORM:
-            newFormat = REFRESH_TEXTUREFORMAT_D32_SFLOAT;
-            break;
-        case REFRESH_TEXTUREFORMAT_D32_SFLOAT:
-            newFormat = REFRESH_TEXTUREFORMAT_D24_UNORM;
-            break;
-        case REFRESH_TEXTUREFORMAT_D24_UNORM_S8_UINT:
-            newFormat = REFRESH_TEXTUREFORMAT_D32_SFLOAT_S8_UINT;
-            break;
-        case REFRESH_TEXTUREFORMAT_D32_SFLOAT_S8_UINT:
-            newFormat = REFRESH_TEXTUREFORMAT_D24_UNORM_S8_UINT;
-            break;
-        default:
-            /* This should never happen, but just in case... */
-            newFormat = REFRESH_TEXTUREFORMAT_D16_UNORM;
+    return SDL_GetShaderCacheData(
+        device,
+        data,
+        pDataSize);
+}
+
+/* Async Compilation */
+
+#define MAX_COMPILE_WORKER_THREADS 4
+
+typedef enum CompileTaskType
+{
+    COMPILE_TASK_SHADER,
+    COMPILE_TASK_GRAPHICS_PIPELINE,
+    COMPILE_TASK_COMPUTE_PIPELINE
+} CompileTaskType;
+
+typedef struct CompileTask
+{
+    Refresh_Device *device;
+    CompileTaskType type;
+
+    union
+    {
+        Refresh_ShaderCreateInfo shader;
+        Refresh_GraphicsPipelineCreateInfo graphicsPipeline;
+        Refresh_ComputePipelineCreateInfo computePipeline;
+    } createInfo;
+    void *createInfoData; /* Owned copies of everything the create info points to */
+
+    Refresh_CompileCallback callback;
+    void *userdata;
+
+    void *result;
+    SDL_atomic_t complete;       /* Set before the callback runs */
+    SDL_atomic_t referenceCount; /* One for the caller's handle, one for the worker */
+
+    struct CompileTask *next;
+} CompileTask;
+
+typedef struct CompileWorkerPool
+{
+    SDL_mutex *lock;
+    SDL_cond *workAvailable;
+    SDL_cond *taskComplete;
+
+    CompileTask *queueHead;
+    CompileTask *queueTail;
+
+    SDL_Thread *threads[MAX_COMPILE_WORKER_THREADS];
+    Uint32 threadCount;
+    SDL_bool quit;
+} CompileWorkerPool;
+
+static void CompileTask_Run(CompileTask *task)
+{
+    switch (task->type) {
+    case COMPILE_TASK_SHADER:
+        task->result = Refresh_CreateShader(
+            task->device,
+            &task->createInfo.shader);
+        break;
+
+    case COMPILE_TASK_GRAPHICS_PIPELINE:
+        task->result = Refresh_CreateGraphicsPipeline(
+            task->device,
+            &task->createInfo.graphicsPipeline);
+        break;
+
+    case COMPILE_TASK_COMPUTE_PIPELINE:
+        task->result = Refresh_CreateComputePipeline(
+            task->device,
+            &task->createInfo.computePipeline);
+        break;
+    }
+
+    SDL_free(task->createInfoData);
+    task->createInfoData = NULL;
+}
+
+static int SDLCALL CompileWorkerPool_Thread(void *data)
+{
+    CompileWorkerPool *pool = (CompileWorkerPool *)data;
+    CompileTask *task;
+
+    SDL_LockMutex(pool->lock);
+    while (1) {
+        while (pool->queueHead == NULL && !pool->quit) {
+            SDL_CondWait(pool->workAvailable, pool->lock);
+        }
+        if (pool->queueHead == NULL) {
             break;
         }
 
-        SDL_LogWarn(
-            SDL_LOG_CATEGORY_APPLICATION,
-            "Requested unsupported depth format %d, falling back to format %d!",
-            graphicsPipelineCreateInfo->attachmentInfo.depthStencilFormat,
-            newFormat);
-        graphicsPipelineCreateInfo->attachmentInfo.depthStencilFormat = newFormat;
+        task = pool->queueHead;
+        pool->queueHead = task->next;
+        if (pool->queueHead == NULL) {
+            pool->queueTail = NULL;
+        }
+        SDL_UnlockMutex(pool->lock);
+
+        CompileTask_Run(task);
+
+        /* Publish completion first so the callback can wait on or release the task */
+        SDL_LockMutex(pool->lock);
+        SDL_AtomicSet(&task->complete, 1);
+        SDL_CondBroadcast(pool->taskComplete);
+        SDL_UnlockMutex(pool->lock);
+
+        if (task->callback != NULL) {
+            task->callback(task->userdata, (Refresh_CompileTask *)task);
+        }
+
+        /* Whichever of the worker and Refresh_ReleaseCompileTask finishes last frees the task */
+        if (SDL_AtomicDecRef(&task->referenceCount)) {
+            SDL_free(task);
+        }
+
+        SDL_LockMutex(pool->lock);
     }
+    SDL_UnlockMutex(pool->lock);
 
-    return device->CreateGraphicsPipeline(
-        device->driverData,
-        graphicsPipelineCreateInfo);
+    return 0;
 }
 
-Refresh_Sampler *Refresh_CreateSampler(
+static CompileWorkerPool *CompileWorkerPool_Fetch(Refresh_Device *device)
+{
+    CompileWorkerPool *pool;
+    SDL_Thread *thread;
+    int cpuCount;
+    Uint32 i;
+
+    SDL_AtomicLock(&device->compileWorkerPoolLock);
+
+    pool = device->compileWorkerPool;
+    if (pool == NULL) {
+        pool = SDL_calloc(1, sizeof(CompileWorkerPool));
+        if (pool == NULL) {
+            SDL_AtomicUnlock(&device->compileWorkerPoolLock);
+            SDL_OutOfMemory();
+            return NULL;
+        }
+
+        pool->lock = SDL_CreateMutex();
+        pool->workAvailable = SDL_CreateCond();
+        pool->taskComplete = SDL_CreateCond();
+        pool->queueHead = NULL;
+        pool->queueTail = NULL;
+        pool->quit = SDL_FALSE;
+        pool->threadCount = 0;
+
+        /* Leave a core for the thread that is requesting the work */
+        cpuCount = SDL_GetCPUCount() - 1;
+        cpuCount = SDL_clamp(cpuCount, 1, MAX_COMPILE_WORKER_THREADS);
+
+        if (pool->lock != NULL && pool->workAvailable != NULL && pool->taskComplete != NULL) {
+            /* Only threads that actually started are kept, and waited on at destroy time */
+            for (i = 0; i < (Uint32)cpuCount; i += 1) {
+                thread = SDL_CreateThread(
+                    CompileWorkerPool_Thread,
+                    "RefreshCompileWorker",
+                    pool);
+
+                if (thread != NULL) {
+                    pool->threads[pool->threadCount] = thread;
+                    pool->threadCount += 1;
+                }
+            }
+        }
+
+        /* Try again on the next call, tasks compile on the calling thread until then */
+        if (pool->threadCount == 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create compile worker pool: %s", SDL_GetError());
+            if (pool->taskComplete != NULL) {
+                SDL_DestroyCond(pool->taskComplete);
+            }
+            if (pool->workAvailable != NULL) {
+                SDL_DestroyCond(pool->workAvailable);
+            }
+            if (pool->lock != NULL) {
+                SDL_DestroyMutex(pool->lock);
+            }
+            SDL_free(pool);
+            SDL_AtomicUnlock(&device->compileWorkerPoolLock);
+            return NULL;
+        }
+
+        device->compileWorkerPool = pool;
+    }
+
+    SDL_AtomicUnlock(&device->compileWorkerPoolLock);
+
+    return pool;
+}
+
+static void CompileWorkerPool_Destroy(CompileWorkerPool *pool)
+{
+    Uint32 i;
+
+    SDL_LockMutex(pool->lock);
+    pool->quit = SDL_TRUE;
+    SDL_CondBroadcast(pool->workAvailable);
+    SDL_UnlockMutex(pool->lock);
+
+    /* Workers drain the queue before they exit */
+    for (i = 0; i < pool->threadCount; i += 1) {
+        SDL_WaitThread(pool->threads[i], NULL);
+    }
+
+    SDL_DestroyCond(pool->taskComplete);
+    SDL_DestroyCond(pool->workAvailable);
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool);
+}
+
+static Refresh_CompileTask *CompileTask_Submit(
     Refresh_Device *device,
-    Refresh_SamplerCreateInfo *samplerCreateInfo)
+    CompileTask *task,
+    Refresh_CompileCallback callback,
+    void *userdata)
 {
-    CHECK_DEVICE_MAGIC(device, NULL);
-    if (samplerCreateInfo == NULL) {
-        SDL_InvalidParamError("samplerCreateInfo");
-        return NULL;
+    CompileWorkerPool *pool = CompileWorkerPool_Fetch(device);
+
+    task->device = device;
+    task->callback = callback;
+    task->userdata = userdata;
+    task->result = NULL;
+    SDL_AtomicSet(&task->complete, 0);
+    SDL_AtomicSet(&task->referenceCount, 2);
+    task->next = NULL;
+
+    if (pool == NULL) {
+        /* No worker could be started, so the task is complete before it is returned.
+         * Only the caller's handle holds a reference.
+         */
+        CompileTask_Run(task);
+        SDL_AtomicSet(&task->complete, 1);
+        SDL_AtomicSet(&task->referenceCount, 1);
+
+        if (callback != NULL) {
+            callback(userdata, (Refresh_CompileTask *)task);
+        }
+
+        return (Refresh_CompileTask *)task;
     }
 
-    return device->CreateSampler(
-        device->driverData,
-        samplerCreateInfo);
+    SDL_LockMutex(pool->lock);
+    if (pool->queueTail == NULL) {
+        pool->queueHead = task;
+    } else {
+        pool->queueTail->next = task;
+    }
+    pool->queueTail = task;
+    SDL_CondSignal(pool->workAvailable);
+    SDL_UnlockMutex(pool->lock);
+
+    return (Refresh_CompileTask *)task;
 }
 
-Refresh_Shader *Refresh_CreateShader(
+/* Shader and compute pipeline create infos share their leading code members */
+static void *CompileTask_CopyCode(
+    size_t codeSize,
+    const Uint8 **pCode,
+    const char **pEntryPointName)
+{
+    size_t entryPointNameSize = SDL_strlen(*pEntryPointName) + 1;
+    Uint8 *data = SDL_malloc(codeSize + entryPointNameSize);
+
+    SDL_memcpy(data, *pCode, codeSize);
+    SDL_memcpy(data + codeSize, *pEntryPointName, entryPointNameSize);
+
+    *pCode = data;
+    *pEntryPointName = (const char *)(data + codeSize);
+    return data;
+}
+
+Refresh_CompileTask *Refresh_CreateShaderAsync(
     Refresh_Device *device,
-    Refresh_ShaderCreateInfo *shaderCreateInfo)
+    Refresh_ShaderCreateInfo *shaderCreateInfo,
+    Refresh_CompileCallback callback,
+    void *userdata)
 {
+    CompileTask *task;
+
     CHECK_DEVICE_MAGIC(device, NULL);
     if (shaderCreateInfo == NULL) {
         SDL_InvalidParamError("shaderCreateInfo");
         return NULL;
     }
 
-    if (shaderCreateInfo->format == REFRESH_SHADERFORMAT_SPIRV &&
-        device->backend != REFRESH_BACKEND_VULKAN) {
-        return SDL_CompileFromSPIRV(device, shaderCreateInfo, SDL_FALSE);
+    task = SDL_malloc(sizeof(CompileTask));
+    task->type = COMPILE_TASK_SHADER;
+    task->createInfo.shader = *shaderCreateInfo;
+    task->createInfoData = CompileTask_CopyCode(
+        shaderCreateInfo->codeSize,
+        &task->createInfo.shader.code,
+        &task->createInfo.shader.entryPointName);
+
+    return CompileTask_Submit(device, task, callback, userdata);
+}
+
+Refresh_CompileTask *Refresh_CreateGraphicsPipelineAsync(
+    Refresh_Device *device,
+    Refresh_GraphicsPipelineCreateInfo *pipelineCreateInfo,
+    Refresh_CompileCallback callback,
+    void *userdata)
+{
+    CompileTask *task;
+    Refresh_GraphicsPipelineCreateInfo *createInfo;
+    size_t bindingsSize, attributesSize, colorAttachmentsSize;
+    Uint8 *data;
+
+    CHECK_DEVICE_MAGIC(device, NULL);
+    if (pipelineCreateInfo == NULL) {
+        SDL_InvalidParamError("pipelineCreateInfo");
+        return NULL;
     }
-    return device->CreateShader(
-        device->driverData,
-        shaderCreateInfo);
+
+    task = SDL_malloc(sizeof(CompileTask));
+    task->type = COMPILE_TASK_GRAPHICS_PIPELINE;
+    task->createInfo.graphicsPipeline = *pipelineCreateInfo;
+    createInfo = &task->createInfo.graphicsPipeline;
+
+    bindingsSize = createInfo->vertexInputState.vertexBindingCount * sizeof(Refresh_VertexBinding);
+    attributesSize = createInfo->vertexInputState.vertexAttributeCount * sizeof(Refresh_VertexAttribute);
+    colorAttachmentsSize = createInfo->attachmentInfo.colorAttachmentCount * sizeof(Refresh_ColorAttachmentDescription);
+
+    data = SDL_malloc(bindingsSize + attributesSize + colorAttachmentsSize + 1);
+    task->createInfoData = data;
+
+    if (bindingsSize > 0) {
+        SDL_memcpy(data, pipelineCreateInfo->vertexInputState.vertexBindings, bindingsSize);
+        createInfo->vertexInputState.vertexBindings = (const Refresh_VertexBinding *)data;
+        data += bindingsSize;
+    }
+    if (attributesSize > 0) {
+        SDL_memcpy(data, pipelineCreateInfo->vertexInputState.vertexAttributes, attributesSize);
+        createInfo->vertexInputState.vertexAttributes = (const Refresh_VertexAttribute *)data;
+        data += attributesSize;
+    }
+    if (colorAttachmentsSize > 0) {
+        SDL_memcpy(data, pipelineCreateInfo->attachmentInfo.colorAttachmentDescriptions, colorAttachmentsSize);
+        createInfo->attachmentInfo.colorAttachmentDescriptions = (Refresh_ColorAttachmentDescription *)data;
+    }
+
+    return CompileTask_Submit(device, task, callback, userdata);
 }
 
-Refresh_Texture *Refresh_CreateTexture(
+Refresh_CompileTask *Refresh_CreateComputePipelineAsync(
     Refresh_Device *device,
-    Refresh_TextureCreateInfo *textureCreateInfo)
+    Refresh_ComputePipelineCreateInfo *computePipelineCreateInfo,
+    Refresh_CompileCallback callback,
+    void *userdata)
 {
-    Refresh_TextureFormat newFormat;
+    CompileTask *task;
 
     CHECK_DEVICE_MAGIC(device, NULL);
-    if (textureCreateInfo == NULL) {
-        SDL_InvalidParamError("textureCreateInfo");
+    if (computePipelineCreateInfo == NULL) {
+        SDL_InvalidParamError("computePipelineCreateInfo");
         return NULL;
     }
 
-    /* Automatically swap out the depth format if it's unsupported.
-     * All backends have universal support for D16.
-     * Vulkan always supports at least one of { D24, D32 } and one of { D24_S8, D32_S8 }.
-     * D3D11 always supports all depth formats.
-     * Metal always supports D32 and D32_S8.
-     * So if D32/_S8 is not supported, we can safely fall back to D24/_S8, and vice versa.
-     */
-    if (IsDepthFormat(textureCreateInfo->format)) {
-        if (!device->IsTextureFormatSupported(
-                device->driverData,
-                textureCreateInfo->format,
-                REFRESH_TEXTURETYPE_2D, /* assuming that driver support for 2D implies support for Cube */
-                textureCreateInfo->usageFlags)) {
-            switch (textureCreateInfo->format) {
-            case REFRESH_TEXTUREFORMAT_D24_UNORM:
-                newFormat = REFRESH_TEXTUREFORMAT_D32_SFLOAT;
-                break;
-            case REFRESH_TEXTUREFORMAT_D32_SFLOAT:
-                newFormat = REFRESH_TEXTUREFORMAT_D24_UNORM;
-                break;
-            case REFRESH_TEXTUREFORMAT_D24_UNORM_S8_UINT:
-                newFormat = REFRESH_TEXTUREFORMAT_D32_SFLOAT_S8_UINT;
-                break;
-            case REFRESH_TEXTUREFORMAT_D32_SFLOAT_S8_UINT:
-                newFormat = REFRESH_TEXTUREFORMAT_D24_UNORM_S8_UINT;
-                break;
-            default:
-                /* This should never happen, but just in case... */
-                newFormat = REFRESH_TEXTUREFORMAT_D16_UNORM;
-                break;
-            }
+    task = SDL_malloc(sizeof(CompileTask));
+    task->type = COMPILE_TASK_COMPUTE_PIPELINE;
+    task->createInfo.computePipeline = *computePipelineCreateInfo;
+    task->createInfoData = CompileTask_CopyCode(
+        computePipelineCreateInfo->codeSize,
+        &task->createInfo.computePipeline.code,
+        &task->createInfo.computePipeline.entryPointName);
 
-            SDL_LogWarn(
-                SDL_LOG_CATEGORY_APPLICATION,
-                "Requested unsupported depth format %d, falling back to format %d!",
-                textureCreateInfo->format,
-                newFormat);
-            textureCreateInfo->format = newFormat;
-        }
+    return CompileTask_Submit(device, task, callback, userdata);
+}
+
+SDL_bool Refresh_QueryCompileTask(
+    Refresh_CompileTask *task)
+{
+    if (task == NULL) {
+        SDL_InvalidParamError("task");
+        return SDL_FALSE;
     }
 
-    return device->CreateTexture(
-        device->driverData,
-        textureCreateInfo);
+    return SDL_AtomicGet(&((CompileTask *)task)->complete) ? SDL_TRUE : SDL_FALSE;
 }
 
-Refresh_Buffer *Refresh_CreateBuffer(
-    Refresh_Device *device,
-    Refresh_BufferUsageFlags usageFlags,
-    Uint32 sizeInBytes)
+void Refresh_WaitCompileTask(
+    Refresh_CompileTask *task)
 {
-    CHECK_DEVICE_MAGIC(device, NULL);
+    CompileTask *compileTask = (CompileTask *)task;
+    CompileWorkerPool *pool;
 
-    return device->CreateBuffer(
-        device->driverData,
-        usageFlags,
-        sizeInBytes);
+    if (task == NULL) {
+        SDL_InvalidParamError("task");
+        return;
+    }
+
+    if (SDL_AtomicGet(&compileTask->complete)) {
+        return;
+    }
+
+    pool = compileTask->device->compileWorkerPool;
+    SDL_LockMutex(pool->lock);
+    while (!SDL_AtomicGet(&compileTask->complete)) {
+        SDL_CondWait(pool->taskComplete, pool->lock);
+    }
+    SDL_UnlockMutex(pool->lock);
 }
 
-Refresh_TransferBuffer *Refresh_CreateTransferBuffer(
-    Refresh_Device *device,
-    Refresh_TransferBufferUsage usage,
-    Uint32 sizeInBytes)
+static void *CompileTask_GetResult(
+    Refresh_CompileTask *task,
+    CompileTaskType type)
 {
-    CHECK_DEVICE_MAGIC(device, NULL);
+    CompileTask *compileTask = (CompileTask *)task;
 
-    return device->CreateTransferBuffer(
-        device->driverData,
-        usage,
-        sizeInBytes);
+    if (task == NULL) {
+        SDL_InvalidParamError("task");
+        return NULL;
+    }
+    if (compileTask->type != type) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Compile task created a different object type!");
+        return NULL;
+    }
+
+    Refresh_WaitCompileTask(task);
+
+    return compileTask->result;
 }
 
-/* Debug Naming */
+Refresh_Shader *Refresh_GetCompiledShader(
+    Refresh_CompileTask *task)
+{
+    return (Refresh_Shader *)CompileTask_GetResult(task, COMPILE_TASK_SHADER);
+}
 
-void Refresh_SetBufferName(
-    Refresh_Device *device,
-    Refresh_Buffer *buffer,
-    const char *text)
+Refresh_GraphicsPipeline *Refresh_GetCompiledGraphicsPipeline(
+    Refresh_CompileTask *task)
 {
-    CHECK_DEVICE_MAGIC(device, );
-    if (buffer == NULL) {
-        SDL_InvalidParamError("buffer");
+    return (Refresh_GraphicsPipeline *)CompileTask_GetResult(task, COMPILE_TASK_GRAPHICS_PIPELINE);
+}
+
+Refresh_ComputePipeline *Refresh_GetCompiledComputePipeline(
+    Refresh_CompileTask *task)
+{
+    return (Refresh_ComputePipeline *)CompileTask_GetResult(task, COMPILE_TASK_COMPUTE_PIPELINE);
+}
+
+void Refresh_ReleaseCompileTask(
+    Refresh_CompileTask *task)
+{
+    if (task == NULL) {
         return;
     }
-    if (text == NULL) {
-        SDL_InvalidParamError("text");
+
+    Refresh_WaitCompileTask(task);
+
+    /* The worker may still be running the callback */
+    if (SDL_AtomicDecRef(&((CompileTask *)task)->referenceCount)) {
+        SDL_free(task);
     }
+}
 
-    device->SetBufferName(
+/* Timestamp Queries */
+
+Refresh_QueryPool *Refresh_CreateTimestampQueryPool(
+    Refresh_Device *device,
+    Uint32 queryCount)
+{
+    CHECK_DEVICE_MAGIC(device, NULL);
+    if (queryCount == 0) {
+        SDL_InvalidParamError("queryCount");
+        return NULL;
+    }
+
+    return device->CreateTimestampQueryPool(
         device->driverData,
-        buffer,
-        text);
+        queryCount);
 }
 
-void Refresh_SetTextureName(
+void Refresh_ReleaseQueryPool(
     Refresh_Device *device,
-    Refresh_Texture *texture,
-    const char *text)
+    Refresh_QueryPool *queryPool)
 {
     CHECK_DEVICE_MAGIC(device, );
-    if (texture == NULL) {
-        SDL_InvalidParamError("texture");
+    if (queryPool == NULL) {
         return;
     }
-    if (text == NULL) {
-        SDL_InvalidParamError("text");
-    }
 
-    device->SetTextureName(
+    INSTRUMENT_BEGIN(Refresh_ReleaseQueryPool);
+    device->ReleaseQueryPool(
         device->driverData,
-        texture,
-        text);
+        queryPool);
+    INSTRUMENT_END(Refresh_ReleaseQueryPool);
 }
 
-void Refresh_InsertDebugLabel(
+void Refresh_ResetQueryPool(
     Refresh_CommandBuffer *commandBuffer,
-    const char *text)
+    Refresh_QueryPool *queryPool)
 {
+    CommandBufferCommonHeader *commandBufferHeader;
+
     if (commandBuffer == NULL) {
         SDL_InvalidParamError("commandBuffer");
         return;
     }
-    if (text == NULL) {
-        SDL_InvalidParamError("text");
+    if (queryPool == NULL) {
+        SDL_InvalidParamError("queryPool");
         return;
     }
 
     CHECK_COMMAND_BUFFER
-    COMMAND_BUFFER_DEVICE->InsertDebugLabel(
+    commandBufferHeader = (CommandBufferCommonHeader *)commandBuffer;
+    if (
+        commandBufferHeader->renderPass.inProgress ||
+        commandBufferHeader->computePass.inProgress ||
+        commandBufferHeader->copyPass.inProgress) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot reset a query pool during a pass!");
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_ResetQueryPool);
+    COMMAND_BUFFER_DEVICE->ResetQueryPool(
         commandBuffer,
-        text);
+        queryPool);
+    INSTRUMENT_END(Refresh_ResetQueryPool);
 }
 
-void Refresh_PushDebugGroup(
+void Refresh_WriteTimestamp(
     Refresh_CommandBuffer *commandBuffer,
-    const char *name)
+    Refresh_QueryPool *queryPool,
+    Uint32 queryIndex)
 {
     if (commandBuffer == NULL) {
         SDL_InvalidParamError("commandBuffer");
         return;
     }
-    if (name == NULL) {
-        SDL_InvalidParamError("name");
+    if (queryPool == NULL) {
+        SDL_InvalidParamError("queryPool");
         return;
     }
 
     CHECK_COMMAND_BUFFER
-    COMMAND_BUFFER_DEVICE->PushDebugGroup(
+    INSTRUMENT_BEGIN(Refresh_WriteTimestamp);
+    COMMAND_BUFFER_DEVICE->WriteTimestamp(
         commandBuffer,
-        name);
+        queryPool,
+        queryIndex);
+    INSTRUMENT_END(Refresh_WriteTimestamp);
 }
 
-void Refresh_PopDebugGroup(
-    Refresh_CommandBuffer *commandBuffer)
+SDL_bool Refresh_GetTimestampResults(
+    Refresh_Device *device,
+    Refresh_QueryPool *queryPool,
+    Uint32 firstQuery,
+    Uint32 queryCount,
+    Uint64 *results)
 {
-    if (commandBuffer == NULL) {
-        SDL_InvalidParamError("commandBuffer");
-        return;
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
+    if (queryPool == NULL) {
+        SDL_InvalidParamError("queryPool");
+        return SDL_FALSE;
+    }
+    if (results == NULL && queryCount > 0) {
+        SDL_InvalidParamError("results");
+        return SDL_FALSE;
     }
 
-    CHECK_COMMAND_BUFFER
-    COMMAND_BUFFER_DEVICE->PopDebugGroup(
-        commandBuffer);
+    SDL_bool result;
+    INSTRUMENT_BEGIN(Refresh_GetTimestampResults);
+    result = device->GetTimestampResults(
+        device->driverData,
+        queryPool,
+        firstQuery,
+        queryCount,
+        results);
+    INSTRUMENT_END(Refresh_GetTimestampResults);
+    return result;
 }
 
-/* Disposal */
+/* Bindless Resources */
 
-void Refresh_ReleaseTexture(
+SDL_bool Refresh_SupportsBindless(
+    Refresh_Device *device)
+{
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
+
+    SDL_bool result;
+    INSTRUMENT_BEGIN(Refresh_SupportsBindless);
+    result = device->SupportsBindless(
+        device->driverData);
+    INSTRUMENT_END(Refresh_SupportsBindless);
+    return result;
+}
+
+SDL_bool Refresh_RegisterBindlessTexture(
     Refresh_Device *device,
-    Refresh_Texture *texture)
+    Refresh_Texture *texture,
+    Uint32 *pIndex)
 {
-    CHECK_DEVICE_MAGIC(device, );
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
     if (texture == NULL) {
-        return;
+        SDL_InvalidParamError("texture");
+        return SDL_FALSE;
+    }
+    if (pIndex == NULL) {
+        SDL_InvalidParamError("pIndex");
+        return SDL_FALSE;
     }
 
-    device->ReleaseTexture(
+    SDL_bool result;
+    INSTRUMENT_BEGIN(Refresh_RegisterBindlessTexture);
+    result = device->RegisterBindlessTexture(
         device->driverData,
-        texture);
+        texture,
+        pIndex);
+    INSTRUMENT_END(Refresh_RegisterBindlessTexture);
+    return result;
 }
 
-void Refresh_ReleaseSampler(
+SDL_bool Refresh_RegisterBindlessSampler(
     Refresh_Device *device,
-    Refresh_Sampler *sampler)
+    Refresh_Sampler *sampler,
+    Uint32 *pIndex)
 {
-    CHECK_DEVICE_MAGIC(device, );
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
     if (sampler == NULL) {
-        return;
+        SDL_InvalidParamError("sampler");
+        return SDL_FALSE;
+    }
+    if (pIndex == NULL) {
+        SDL_InvalidParamError("pIndex");
+        return SDL_FALSE;
     }
 
-    device->ReleaseSampler(
+    SDL_bool result;
+    INSTRUMENT_BEGIN(Refresh_RegisterBindlessSampler);
+    result = device->RegisterBindlessSampler(
         device->driverData,
-        sampler);
+        sampler,
+        pIndex);
+    INSTRUMENT_END(Refresh_RegisterBindlessSampler);
+    return result;
 }
 
-void Refresh_ReleaseBuffer(
+SDL_bool Refresh_RegisterBindlessStorageBuffer(
     Refresh_Device *device,
-    Refresh_Buffer *buffer)
+    Refresh_Buffer *buffer,
+    Uint32 *pIndex)
 {
-    CHECK_DEVICE_MAGIC(device, );
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
     if (buffer == NULL) {
-        return;
+        SDL_InvalidParamError("buffer");
+        return SDL_FALSE;
+    }
+    if (pIndex == NULL) {
+        SDL_InvalidParamError("pIndex");
+        return SDL_FALSE;
     }
 
-    device->ReleaseBuffer(
+    SDL_bool result;
+    INSTRUMENT_BEGIN(Refresh_RegisterBindlessStorageBuffer);
+    result = device->RegisterBindlessStorageBuffer(
         device->driverData,
-        buffer);
+        buffer,
+        pIndex);
+    INSTRUMENT_END(Refresh_RegisterBindlessStorageBuffer);
+    return result;
 }
 
-void Refresh_ReleaseTransferBuffer(
+void Refresh_UnregisterBindlessResource(
     Refresh_Device *device,
-    Refresh_TransferBuffer *transferBuffer)
+    Refresh_BindlessResourceType resourceType,
+    Uint32 index)
 {
     CHECK_DEVICE_MAGIC(device, );
-    if (transferBuffer == NULL) {
+    if (resourceType > REFRESH_BINDLESSRESOURCETYPE_STORAGEBUFFER) {
+        SDL_InvalidParamError("resourceType");
         return;
     }
 
-    device->ReleaseTransferBuffer(
+    INSTRUMENT_BEGIN(Refresh_UnregisterBindlessResource);
+    device->UnregisterBindlessResource(
         device->driverData,
-        transferBuffer);
+        resourceType,
+        index);
+    INSTRUMENT_END(Refresh_UnregisterBindlessResource);
 }
 
-void Refresh_ReleaseShader(
+/* Resource Cycling */
+
+void Refresh_SetBufferCycleLimit(
     Refresh_Device *device,
-    Refresh_Shader *shader)
+    Refresh_Buffer *buffer,
+    Uint32 maxCycleCount)
 {
     CHECK_DEVICE_MAGIC(device, );
-    if (shader == NULL) {
+    if (buffer == NULL) {
+        SDL_InvalidParamError("buffer");
         return;
     }
 
-    device->ReleaseShader(
+    INSTRUMENT_BEGIN(Refresh_SetBufferCycleLimit);
+    device->SetBufferCycleLimit(
         device->driverData,
-        shader);
+        buffer,
+        maxCycleCount);
+    INSTRUMENT_END(Refresh_SetBufferCycleLimit);
 }
 
-void Refresh_ReleaseComputePipeline(
+void Refresh_SetTransferBufferCycleLimit(
     Refresh_Device *device,
-    Refresh_ComputePipeline *computePipeline)
+    Refresh_TransferBuffer *transferBuffer,
+    Uint32 maxCycleCount)
 {
     CHECK_DEVICE_MAGIC(device, );
-    if (computePipeline == NULL) {
+    if (transferBuffer == NULL) {
+        SDL_InvalidParamError("transferBuffer");
         return;
     }
 
-    device->ReleaseComputePipeline(
+    INSTRUMENT_BEGIN(Refresh_SetTransferBufferCycleLimit);
+    device->SetTransferBufferCycleLimit(
         device->driverData,
-        computePipeline);
+        transferBuffer,
+        maxCycleCount);
+    INSTRUMENT_END(Refresh_SetTransferBufferCycleLimit);
 }
 
-void Refresh_ReleaseGraphicsPipeline(
+void Refresh_SetTextureCycleLimit(
     Refresh_Device *device,
-    Refresh_GraphicsPipeline *graphicsPipeline)
+    Refresh_Texture *texture,
+    Uint32 maxCycleCount)
 {
     CHECK_DEVICE_MAGIC(device, );
-    if (graphicsPipeline == NULL) {
+    if (texture == NULL) {
+        SDL_InvalidParamError("texture");
         return;
     }
 
-    device->ReleaseGraphicsPipeline(
+    INSTRUMENT_BEGIN(Refresh_SetTextureCycleLimit);
+    device->SetTextureCycleLimit(
         device->driverData,
-        graphicsPipeline);
+        texture,
+        maxCycleCount);
+    INSTRUMENT_END(Refresh_SetTextureCycleLimit);
 }
 
-/* Command Buffer */
-
-Refresh_CommandBuffer *Refresh_AcquireCommandBuffer(
-    Refresh_Device *device)
+Uint32 Refresh_GetBufferCycleCount(
+    Refresh_Device *device,
+    Refresh_Buffer *buffer)
 {
-    Refresh_CommandBuffer *commandBuffer;
-    CommandBufferCommonHeader *commandBufferHeader;
+    CHECK_DEVICE_MAGIC(device, 0);
+    if (buffer == NULL) {
+        SDL_InvalidParamError("buffer");
+        return 0;
+    }
 
-    CHECK_DEVICE_MAGIC(device, NULL);
+    Uint32 result;
+    INSTRUMENT_BEGIN(Refresh_GetBufferCycleCount);
+    result = device->GetBufferCycleCount(
+        device->driverData,
+        buffer);
+    INSTRUMENT_END(Refresh_GetBufferCycleCount);
+    return result;
+}
 
-    commandBuffer = device->AcquireCommandBuffer(
-        device->driverData);
+Uint32 Refresh_GetTransferBufferCycleCount(
+    Refresh_Device *device,
+    Refresh_TransferBuffer *transferBuffer)
+{
+    CHECK_DEVICE_MAGIC(device, 0);
+    if (transferBuffer == NULL) {
+        SDL_InvalidParamError("transferBuffer");
+        return 0;
+    }
+
+    Uint32 result;
+    INSTRUMENT_BEGIN(Refresh_GetTransferBufferCycleCount);
+    result = device->GetTransferBufferCycleCount(
+        device->driverData,
+        transferBuffer);
+    INSTRUMENT_END(Refresh_GetTransferBufferCycleCount);
+    return result;
+}
+
+Uint32 Refresh_GetTextureCycleCount(
+    Refresh_Device *device,
+    Refresh_Texture *texture)
+{
+    CHECK_DEVICE_MAGIC(device, 0);
+    if (texture == NULL) {
+        SDL_InvalidParamError("texture");
+        return 0;
+    }
+
+    Uint32 result;
+    INSTRUMENT_BEGIN(Refresh_GetTextureCycleCount);
+    result = device->GetTextureCycleCount(
+        device->driverData,
+        texture);
+    INSTRUMENT_END(Refresh_GetTextureCycleCount);
+    return result;
+}
+
+void Refresh_SetCycleTrimFrames(
+    Refresh_Device *device,
+    Uint32 frameCount)
+{
+    CHECK_DEVICE_MAGIC(device, );
+
+    INSTRUMENT_BEGIN(Refresh_SetCycleTrimFrames);
+    device->SetCycleTrimFrames(
+        device->driverData,
+        frameCount);
+    INSTRUMENT_END(Refresh_SetCycleTrimFrames);
+}
+
+/* Defragmentation */
+
+void Refresh_SetDefragmentationSettings(
+    Refresh_Device *device,
+    Refresh_DefragmentationSettings *settings)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (settings == NULL) {
+        SDL_InvalidParamError("settings");
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_SetDefragmentationSettings);
+    device->SetDefragmentationSettings(
+        device->driverData,
+        settings);
+    INSTRUMENT_END(Refresh_SetDefragmentationSettings);
+}
+
+void Refresh_RequestDefragmentation(
+    Refresh_Device *device)
+{
+    CHECK_DEVICE_MAGIC(device, );
+
+    INSTRUMENT_BEGIN(Refresh_RequestDefragmentation);
+    device->RequestDefragmentation(
+        device->driverData);
+    INSTRUMENT_END(Refresh_RequestDefragmentation);
+}
+
+/* Statistics */
+
+void Refresh_GetDeviceStatistics(
+    Refresh_Device *device,
+    Refresh_DeviceStatistics *statistics)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (statistics == NULL) {
+        SDL_InvalidParamError("statistics");
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_GetDeviceStatistics);
+    device->GetDeviceStatistics(
+        device->driverData,
+        statistics);
+    INSTRUMENT_END(Refresh_GetDeviceStatistics);
+}
+
+void Refresh_GetMemoryStatistics(
+    Refresh_Device *device,
+    Refresh_MemoryStatistics *statistics)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (statistics == NULL) {
+        SDL_InvalidParamError("statistics");
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_GetMemoryStatistics);
+    device->GetMemoryStatistics(
+        device->driverData,
+        statistics);
+    INSTRUMENT_END(Refresh_GetMemoryStatistics);
+}
+
+/* State Creation */
+
+Refresh_ComputePipeline *Refresh_CreateComputePipeline(
+    Refresh_Device *device,
+    Refresh_ComputePipelineCreateInfo *computePipelineCreateInfo)
+{
+    CHECK_DEVICE_MAGIC(device, NULL);
+    if (computePipelineCreateInfo == NULL) {
+        SDL_InvalidParamError("computePipelineCreateInfo");
+        return NULL;
+    }
+
+    /* FIXME DEBUGMODE */
+    if (computePipelineCreateInfo->threadCountX == 0 ||
+        computePipelineCreateInfo->threadCountY == 0 ||
+        computePipelineCreateInfo->threadCountZ == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "All ComputePipeline threadCount dimensions must be at least 1!");
+        return NULL;
+    }
+
+    Refresh_ComputePipeline *result;
+    INSTRUMENT_BEGIN(Refresh_CreateComputePipeline);
+    if (computePipelineCreateInfo->format == REFRESH_SHADERFORMAT_SPIRV &&
+        device->backend != REFRESH_BACKEND_VULKAN) {
+        /* Timed as well, the native create it ends in counts as a nested call */
+        result = SDL_CompileFromSPIRV(device, computePipelineCreateInfo, SDL_TRUE);
+    } else {
+        result = device->CreateComputePipeline(
+            device->driverData,
+            computePipelineCreateInfo);
+    }
+    INSTRUMENT_END(Refresh_CreateComputePipeline);
+    return result;
+}
+
+Refresh_GraphicsPipeline *Refresh_CreateGraphicsPipeline(
+    Refresh_Device *device,
+    Refresh_GraphicsPipelineCreateInfo *graphicsPipelineCreateInfo)
+{
+    Refresh_TextureFormat newFormat;
+
+    CHECK_DEVICE_MAGIC(device, NULL);
+    if (graphicsPipelineCreateInfo == NULL) {
+        SDL_InvalidParamError("graphicsPipelineCreateInfo");
+        return NULL;
+    }
+
+    /* Automatically swap out the depth format if it's unsupported.
+     * See Refresh_CreateTexture.
+     */
+    if (
+        graphicsPipelineCreateInfo->attachmentInfo.hasDepthStencilAttachment &&
+        !device->IsTextureFormatSupported(
+            device->driverData,
+            graphicsPipelineCreateInfo->attachmentInfo.depthStencilFormat,
+            REFRESH_TEXTURETYPE_2D,
+            REFRESH_TEXTUREUSAGE_DEPTH_STENCIL_TARGET_BIT)) {
+        switch (graphicsPipelineCreateInfo->attachmentInfo.depthStencilFormat) {
+        case REFRESH_TEXTUREFORMAT_D24_UNORM:
+            newFormat = REFRESH_TEXTUREFORMAT_D32_SFLOAT;
+            break;
+        case REFRESH_TEXTUREFORMAT_D32_SFLOAT:
+            newFormat = REFRESH_TEXTUREFORMAT_D24_UNORM;
+            break;
+        case REFRESH_TEXTUREFORMAT_D24_UNORM_S8_UINT:
+            newFormat = REFRESH_TEXTUREFORMAT_D32_SFLOAT_S8_UINT;
+            break;
+        case REFRESH_TEXTUREFORMAT_D32_SFLOAT_S8_UINT:
+            newFormat = REFRESH_TEXTUREFORMAT_D24_UNORM_S8_UINT;
+            break;
+        default:
+            /* This should never happen, but just in case... */
+            newFormat = REFRESH_TEXTUREFORMAT_D16_UNORM;
+            break;
+        }
+
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "Requested unsupported depth format %d, falling back to format %d!",
+            graphicsPipelineCreateInfo->attachmentInfo.depthStencilFormat,
+            newFormat);
+        graphicsPipelineCreateInfo->attachmentInfo.depthStencilFormat = newFormat;
+    }
+
+    Refresh_GraphicsPipeline *result;
+    INSTRUMENT_BEGIN(Refresh_CreateGraphicsPipeline);
+    result = device->CreateGraphicsPipeline(
+        device->driverData,
+        graphicsPipelineCreateInfo);
+    INSTRUMENT_END(Refresh_CreateGraphicsPipeline);
+    return result;
+}
+
+Refresh_Sampler *Refresh_CreateSampler(
+    Refresh_Device *device,
+    Refresh_SamplerCreateInfo *samplerCreateInfo)
+{
+    CHECK_DEVICE_MAGIC(device, NULL);
+    if (samplerCreateInfo == NULL) {
+        SDL_InvalidParamError("samplerCreateInfo");
+        return NULL;
+    }
+
+    Refresh_Sampler *result;
+    INSTRUMENT_BEGIN(Refresh_CreateSampler);
+    result = device->CreateSampler(
+        device->driverData,
+        samplerCreateInfo);
+    INSTRUMENT_END(Refresh_CreateSampler);
+    return result;
+}
+
+Refresh_Shader *Refresh_CreateShader(
+    Refresh_Device *device,
+    Refresh_ShaderCreateInfo *shaderCreateInfo)
+{
+    CHECK_DEVICE_MAGIC(device, NULL);
+    if (shaderCreateInfo == NULL) {
+        SDL_InvalidParamError("shaderCreateInfo");
+        return NULL;
+    }
+
+    Refresh_Shader *result;
+    INSTRUMENT_BEGIN(Refresh_CreateShader);
+    if (shaderCreateInfo->format == REFRESH_SHADERFORMAT_SPIRV &&
+        device->backend != REFRESH_BACKEND_VULKAN) {
+        /* Timed as well, the native create it ends in counts as a nested call */
+        result = SDL_CompileFromSPIRV(device, shaderCreateInfo, SDL_FALSE);
+    } else {
+        result = device->CreateShader(
+            device->driverData,
+            shaderCreateInfo);
+    }
+    INSTRUMENT_END(Refresh_CreateShader);
+    return result;
+}
+
+Refresh_Texture *Refresh_CreateTexture(
+    Refresh_Device *device,
+    Refresh_TextureCreateInfo *textureCreateInfo)
+{
+    Refresh_TextureFormat newFormat;
+
+    CHECK_DEVICE_MAGIC(device, NULL);
+    if (textureCreateInfo == NULL) {
+        SDL_InvalidParamError("textureCreateInfo");
+        return NULL;
+    }
+
+    /* Automatically swap out the depth format if it's unsupported.
+     * All backends have universal support for D16.
+     * Vulkan always supports at least one of { D24, D32 } and one of { D24_S8, D32_S8 }.
+     * D3D11 always supports all depth formats.
+     * Metal always supports D32 and D32_S8.
+     * So if D32/_S8 is not supported, we can safely fall back to D24/_S8, and vice versa.
+     */
+    if (IsDepthFormat(textureCreateInfo->format)) {
+        if (!device->IsTextureFormatSupported(
+                device->driverData,
+                textureCreateInfo->format,
+                REFRESH_TEXTURETYPE_2D, /* assuming that driver support for 2D implies support for Cube */
+                textureCreateInfo->usageFlags)) {
+            switch (textureCreateInfo->format) {
+            case REFRESH_TEXTUREFORMAT_D24_UNORM:
+                newFormat = REFRESH_TEXTUREFORMAT_D32_SFLOAT;
+                break;
+            case REFRESH_TEXTUREFORMAT_D32_SFLOAT:
+                newFormat = REFRESH_TEXTUREFORMAT_D24_UNORM;
+                break;
+            case REFRESH_TEXTUREFORMAT_D24_UNORM_S8_UINT:
+                newFormat = REFRESH_TEXTUREFORMAT_D32_SFLOAT_S8_UINT;
+                break;
+            case REFRESH_TEXTUREFORMAT_D32_SFLOAT_S8_UINT:
+                newFormat = REFRESH_TEXTUREFORMAT_D24_UNORM_S8_UINT;
+                break;
+            default:
+                /* This should never happen, but just in case... */
+                newFormat = REFRESH_TEXTUREFORMAT_D16_UNORM;
+                break;
+            }
+
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_APPLICATION,
+                "Requested unsupported depth format %d, falling back to format %d!",
+                textureCreateInfo->format,
+                newFormat);
+            textureCreateInfo->format = newFormat;
+        }
+    }
+
+    Refresh_Texture *result;
+    INSTRUMENT_BEGIN(Refresh_CreateTexture);
+    result = device->CreateTexture(
+        device->driverData,
+        textureCreateInfo);
+    INSTRUMENT_END(Refresh_CreateTexture);
+    return result;
+}
+
+Refresh_Buffer *Refresh_CreateBuffer(
+    Refresh_Device *device,
+    Refresh_BufferUsageFlags usageFlags,
+    Uint32 sizeInBytes)
+{
+    CHECK_DEVICE_MAGIC(device, NULL);
+
+    Refresh_Buffer *result;
+    INSTRUMENT_BEGIN(Refresh_CreateBuffer);
+    result = device->CreateBuffer(
+        device->driverData,
+        usageFlags,
+        sizeInBytes);
+    INSTRUMENT_END(Refresh_CreateBuffer);
+    return result;
+}
+
+Refresh_TransferBuffer *Refresh_CreateTransferBuffer(
+    Refresh_Device *device,
+    Refresh_TransferBufferUsage usage,
+    Uint32 sizeInBytes)
+{
+    CHECK_DEVICE_MAGIC(device, NULL);
+
+    Refresh_TransferBuffer *result;
+    INSTRUMENT_BEGIN(Refresh_CreateTransferBuffer);
+    result = device->CreateTransferBuffer(
+        device->driverData,
+        usage,
+        sizeInBytes);
+    INSTRUMENT_END(Refresh_CreateTransferBuffer);
+    return result;
+}
+
+/* Debug Naming */
+
+void Refresh_SetBufferName(
+    Refresh_Device *device,
+    Refresh_Buffer *buffer,
+    const char *text)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (buffer == NULL) {
+        SDL_InvalidParamError("buffer");
+        return;
+    }
+    if (text == NULL) {
+        SDL_InvalidParamError("text");
+    }
+
+    INSTRUMENT_BEGIN(Refresh_SetBufferName);
+    device->SetBufferName(
+        device->driverData,
+        buffer,
+        text);
+    INSTRUMENT_END(Refresh_SetBufferName);
+}
+
+void Refresh_SetTextureName(
+    Refresh_Device *device,
+    Refresh_Texture *texture,
+    const char *text)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (texture == NULL) {
+        SDL_InvalidParamError("texture");
+        return;
+    }
+    if (text == NULL) {
+        SDL_InvalidParamError("text");
+    }
+
+    INSTRUMENT_BEGIN(Refresh_SetTextureName);
+    device->SetTextureName(
+        device->driverData,
+        texture,
+        text);
+    INSTRUMENT_END(Refresh_SetTextureName);
+}
+
+void Refresh_InsertDebugLabel(
+    Refresh_CommandBuffer *commandBuffer,
+    const char *text)
+{
+    if (commandBuffer == NULL) {
+        SDL_InvalidParamError("commandBuffer");
+        return;
+    }
+    if (text == NULL) {
+        SDL_InvalidParamError("text");
+        return;
+    }
+
+    CHECK_COMMAND_BUFFER
+    INSTRUMENT_BEGIN(Refresh_InsertDebugLabel);
+    COMMAND_BUFFER_DEVICE->InsertDebugLabel(
+        commandBuffer,
+        text);
+    INSTRUMENT_END(Refresh_InsertDebugLabel);
+}
+
+void Refresh_PushDebugGroup(
+    Refresh_CommandBuffer *commandBuffer,
+    const char *name)
+{
+    if (commandBuffer == NULL) {
+        SDL_InvalidParamError("commandBuffer");
+        return;
+    }
+    if (name == NULL) {
+        SDL_InvalidParamError("name");
+        return;
+    }
+
+    CHECK_COMMAND_BUFFER
+    INSTRUMENT_BEGIN(Refresh_PushDebugGroup);
+    COMMAND_BUFFER_DEVICE->PushDebugGroup(
+        commandBuffer,
+        name);
+    INSTRUMENT_END(Refresh_PushDebugGroup);
+}
+
+void Refresh_PopDebugGroup(
+    Refresh_CommandBuffer *commandBuffer)
+{
+    if (commandBuffer == NULL) {
+        SDL_InvalidParamError("commandBuffer");
+        return;
+    }
+
+    CHECK_COMMAND_BUFFER
+    INSTRUMENT_BEGIN(Refresh_PopDebugGroup);
+    COMMAND_BUFFER_DEVICE->PopDebugGroup(
+        commandBuffer);
+    INSTRUMENT_END(Refresh_PopDebugGroup);
+}
+
+/* Disposal */
+
+void Refresh_ReleaseTexture(
+    Refresh_Device *device,
+    Refresh_Texture *texture)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (texture == NULL) {
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_ReleaseTexture);
+    device->ReleaseTexture(
+        device->driverData,
+        texture);
+    INSTRUMENT_END(Refresh_ReleaseTexture);
+}
+
+void Refresh_ReleaseSampler(
+    Refresh_Device *device,
+    Refresh_Sampler *sampler)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (sampler == NULL) {
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_ReleaseSampler);
+    device->ReleaseSampler(
+        device->driverData,
+        sampler);
+    INSTRUMENT_END(Refresh_ReleaseSampler);
+}
+
+void Refresh_ReleaseBuffer(
+    Refresh_Device *device,
+    Refresh_Buffer *buffer)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (buffer == NULL) {
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_ReleaseBuffer);
+    device->ReleaseBuffer(
+        device->driverData,
+        buffer);
+    INSTRUMENT_END(Refresh_ReleaseBuffer);
+}
+
+void Refresh_ReleaseTransferBuffer(
+    Refresh_Device *device,
+    Refresh_TransferBuffer *transferBuffer)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (transferBuffer == NULL) {
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_ReleaseTransferBuffer);
+    device->ReleaseTransferBuffer(
+        device->driverData,
+        transferBuffer);
+    INSTRUMENT_END(Refresh_ReleaseTransferBuffer);
+}
+
+void Refresh_ReleaseShader(
+    Refresh_Device *device,
+    Refresh_Shader *shader)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (shader == NULL) {
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_ReleaseShader);
+    device->ReleaseShader(
+        device->driverData,
+        shader);
+    INSTRUMENT_END(Refresh_ReleaseShader);
+}
+
+void Refresh_ReleaseComputePipeline(
+    Refresh_Device *device,
+    Refresh_ComputePipeline *computePipeline)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (computePipeline == NULL) {
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_ReleaseComputePipeline);
+    device->ReleaseComputePipeline(
+        device->driverData,
+        computePipeline);
+    INSTRUMENT_END(Refresh_ReleaseComputePipeline);
+}
+
+void Refresh_ReleaseGraphicsPipeline(
+    Refresh_Device *device,
+    Refresh_GraphicsPipeline *graphicsPipeline)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (graphicsPipeline == NULL) {
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_ReleaseGraphicsPipeline);
+    device->ReleaseGraphicsPipeline(
+        device->driverData,
+        graphicsPipeline);
+    INSTRUMENT_END(Refresh_ReleaseGraphicsPipeline);
+}
+
+/* Command Buffer */
+
+Refresh_CommandBuffer *Refresh_AcquireCommandBuffer(
+    Refresh_Device *device)
+{
+    return Refresh_AcquireCommandBufferForQueue(
+        device,
+        REFRESH_QUEUETYPE_GRAPHICS);
+}
+
+Refresh_CommandBuffer *Refresh_AcquireCommandBufferForQueue(
+    Refresh_Device *device,
+    Refresh_QueueType queueType)
+{
+    Refresh_CommandBuffer *commandBuffer;
+    CommandBufferCommonHeader *commandBufferHeader;
+
+    CHECK_DEVICE_MAGIC(device, NULL);
+
+    if (queueType > REFRESH_QUEUETYPE_TRANSFER) {
+        SDL_InvalidParamError("queueType");
+        return NULL;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_AcquireCommandBufferForQueue);
+    commandBuffer = device->AcquireCommandBuffer(
+        device->driverData,
+        queueType);
+    INSTRUMENT_END(Refresh_AcquireCommandBufferForQueue);
 
     if (commandBuffer == NULL) {
         return NULL;
@@ -702,6 +1914,10 @@ Refresh_CommandBuffer *Refresh_AcquireCommandBuffer(
     commandBufferHeader->copyPass.commandBuffer = commandBuffer;
     commandBufferHeader->copyPass.inProgress = SDL_FALSE;
     commandBufferHeader->submitted = SDL_FALSE;
+    commandBufferHeader->queueType = queueType;
+    commandBufferHeader->parallelRenderPass = SDL_FALSE;
+    SDL_AtomicSet(&commandBufferHeader->renderPassChunksInProgress, 0);
+    commandBufferHeader->parentCommandBuffer = NULL;
 
     return commandBuffer;
 }
@@ -724,11 +1940,13 @@ void Refresh_PushVertexUniformData(
     }
 
     CHECK_COMMAND_BUFFER
+    INSTRUMENT_BEGIN(Refresh_PushVertexUniformData);
     COMMAND_BUFFER_DEVICE->PushVertexUniformData(
         commandBuffer,
         slotIndex,
         data,
         dataLengthInBytes);
+    INSTRUMENT_END(Refresh_PushVertexUniformData);
 }
 
 void Refresh_PushFragmentUniformData(
@@ -747,11 +1965,13 @@ void Refresh_PushFragmentUniformData(
     }
 
     CHECK_COMMAND_BUFFER
+    INSTRUMENT_BEGIN(Refresh_PushFragmentUniformData);
     COMMAND_BUFFER_DEVICE->PushFragmentUniformData(
         commandBuffer,
         slotIndex,
         data,
         dataLengthInBytes);
+    INSTRUMENT_END(Refresh_PushFragmentUniformData);
 }
 
 void Refresh_PushComputeUniformData(
@@ -770,11 +1990,13 @@ void Refresh_PushComputeUniformData(
     }
 
     CHECK_COMMAND_BUFFER
+    INSTRUMENT_BEGIN(Refresh_PushComputeUniformData);
     COMMAND_BUFFER_DEVICE->PushComputeUniformData(
         commandBuffer,
         slotIndex,
         data,
         dataLengthInBytes);
+    INSTRUMENT_END(Refresh_PushComputeUniformData);
 }
 
 /* Render Pass */
@@ -797,379 +2019,912 @@ Refresh_RenderPass *Refresh_BeginRenderPass(
     }
 
     CHECK_COMMAND_BUFFER_RETURN_NULL
+    CHECK_GRAPHICS_QUEUE_RETURN_NULL
     CHECK_ANY_PASS_IN_PROGRESS
 
+    INSTRUMENT_BEGIN(Refresh_BeginRenderPass);
     COMMAND_BUFFER_DEVICE->BeginRenderPass(
         commandBuffer,
         colorAttachmentInfos,
         colorAttachmentCount,
         depthStencilAttachmentInfo);
+    INSTRUMENT_END(Refresh_BeginRenderPass);
 
     commandBufferHeader = (CommandBufferCommonHeader *)commandBuffer;
     commandBufferHeader->renderPass.inProgress = SDL_TRUE;
     return (Refresh_RenderPass *)&(commandBufferHeader->renderPass);
 }
 
-void Refresh_BindGraphicsPipeline(
+void Refresh_BindGraphicsPipeline(
+    Refresh_RenderPass *renderPass,
+    Refresh_GraphicsPipeline *graphicsPipeline)
+{
+    CommandBufferCommonHeader *commandBufferHeader;
+
+    if (renderPass == NULL) {
+        SDL_InvalidParamError("renderPass");
+        return;
+    }
+    if (graphicsPipeline == NULL) {
+        SDL_InvalidParamError("graphicsPipeline");
+        return;
+    }
+
+    CHECK_NOT_PARALLEL_RENDERPASS
+    INSTRUMENT_BEGIN(Refresh_BindGraphicsPipeline);
+    RENDERPASS_DEVICE->BindGraphicsPipeline(
+        RENDERPASS_COMMAND_BUFFER,
+        graphicsPipeline);
+    INSTRUMENT_END(Refresh_BindGraphicsPipeline);
+
+    commandBufferHeader = (CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER;
+    commandBufferHeader->graphicsPipelineBound = SDL_TRUE;
+}
+
+void Refresh_SetViewport(
+    Refresh_RenderPass *renderPass,
+    Refresh_Viewport *viewport)
+{
+    if (renderPass == NULL) {
+        SDL_InvalidParamError("renderPass");
+        return;
+    }
+    if (viewport == NULL) {
+        SDL_InvalidParamError("viewport");
+        return;
+    }
+
+    CHECK_RENDERPASS
+    CHECK_NOT_PARALLEL_RENDERPASS
+    INSTRUMENT_BEGIN(Refresh_SetViewport);
+    RENDERPASS_DEVICE->SetViewport(
+        RENDERPASS_COMMAND_BUFFER,
+        viewport);
+    INSTRUMENT_END(Refresh_SetViewport);
+}
+
+void Refresh_SetScissor(
+    Refresh_RenderPass *renderPass,
+    Refresh_Rect *scissor)
+{
+    if (renderPass == NULL) {
+        SDL_InvalidParamError("renderPass");
+        return;
+    }
+    if (scissor == NULL) {
+        SDL_InvalidParamError("scissor");
+        return;
+    }
+
+    CHECK_RENDERPASS
+    CHECK_NOT_PARALLEL_RENDERPASS
+    INSTRUMENT_BEGIN(Refresh_SetScissor);
+    RENDERPASS_DEVICE->SetScissor(
+        RENDERPASS_COMMAND_BUFFER,
+        scissor);
+    INSTRUMENT_END(Refresh_SetScissor);
+}
+
+void Refresh_BindVertexBuffers(
+    Refresh_RenderPass *renderPass,
+    Uint32 firstBinding,
+    Refresh_BufferBinding *pBindings,
+    Uint32 bindingCount)
+{
+    if (renderPass == NULL) {
+        SDL_InvalidParamError("renderPass");
+        return;
+    }
+    if (pBindings == NULL && bindingCount > 0) {
+        SDL_InvalidParamError("pBindings");
+        return;
+    }
+
+    CHECK_RENDERPASS
+    CHECK_GRAPHICS_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_BindVertexBuffers);
+    RENDERPASS_DEVICE->BindVertexBuffers(
+        RENDERPASS_COMMAND_BUFFER,
+        firstBinding,
+        pBindings,
+        bindingCount);
+    INSTRUMENT_END(Refresh_BindVertexBuffers);
+}
+
+void Refresh_BindIndexBuffer(
+    Refresh_RenderPass *renderPass,
+    Refresh_BufferBinding *pBinding,
+    Refresh_IndexElementSize indexElementSize)
+{
+    if (renderPass == NULL) {
+        SDL_InvalidParamError("renderPass");
+        return;
+    }
+    if (pBinding == NULL) {
+        SDL_InvalidParamError("pBinding");
+        return;
+    }
+
+    CHECK_RENDERPASS
+    CHECK_GRAPHICS_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_BindIndexBuffer);
+    RENDERPASS_DEVICE->BindIndexBuffer(
+        RENDERPASS_COMMAND_BUFFER,
+        pBinding,
+        indexElementSize);
+    INSTRUMENT_END(Refresh_BindIndexBuffer);
+}
+
+void Refresh_BindVertexSamplers(
+    Refresh_RenderPass *renderPass,
+    Uint32 firstSlot,
+    Refresh_TextureSamplerBinding *textureSamplerBindings,
+    Uint32 bindingCount)
+{
+    if (renderPass == NULL) {
+        SDL_InvalidParamError("renderPass");
+        return;
+    }
+    if (textureSamplerBindings == NULL && bindingCount > 0) {
+        SDL_InvalidParamError("textureSamplerBindings");
+        return;
+    }
+
+    CHECK_RENDERPASS
+    CHECK_GRAPHICS_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_BindVertexSamplers);
+    RENDERPASS_DEVICE->BindVertexSamplers(
+        RENDERPASS_COMMAND_BUFFER,
+        firstSlot,
+        textureSamplerBindings,
+        bindingCount);
+    INSTRUMENT_END(Refresh_BindVertexSamplers);
+}
+
+void Refresh_BindVertexStorageTextures(
+    Refresh_RenderPass *renderPass,
+    Uint32 firstSlot,
+    Refresh_TextureSlice *storageTextureSlices,
+    Uint32 bindingCount)
+{
+    if (renderPass == NULL) {
+        SDL_InvalidParamError("renderPass");
+        return;
+    }
+    if (storageTextureSlices == NULL && bindingCount > 0) {
+        SDL_InvalidParamError("storageTextureSlices");
+        return;
+    }
+
+    CHECK_RENDERPASS
+    CHECK_GRAPHICS_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_BindVertexStorageTextures);
+    RENDERPASS_DEVICE->BindVertexStorageTextures(
+        RENDERPASS_COMMAND_BUFFER,
+        firstSlot,
+        storageTextureSlices,
+        bindingCount);
+    INSTRUMENT_END(Refresh_BindVertexStorageTextures);
+}
+
+void Refresh_BindVertexStorageBuffers(
+    Refresh_RenderPass *renderPass,
+    Uint32 firstSlot,
+    Refresh_Buffer **storageBuffers,
+    Uint32 bindingCount)
+{
+    if (renderPass == NULL) {
+        SDL_InvalidParamError("renderPass");
+        return;
+    }
+    if (storageBuffers == NULL && bindingCount > 0) {
+        SDL_InvalidParamError("storageBuffers");
+        return;
+    }
+
+    CHECK_RENDERPASS
+    CHECK_GRAPHICS_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_BindVertexStorageBuffers);
+    RENDERPASS_DEVICE->BindVertexStorageBuffers(
+        RENDERPASS_COMMAND_BUFFER,
+        firstSlot,
+        storageBuffers,
+        bindingCount);
+    INSTRUMENT_END(Refresh_BindVertexStorageBuffers);
+}
+
+void Refresh_BindFragmentSamplers(
+    Refresh_RenderPass *renderPass,
+    Uint32 firstSlot,
+    Refresh_TextureSamplerBinding *textureSamplerBindings,
+    Uint32 bindingCount)
+{
+    if (renderPass == NULL) {
+        SDL_InvalidParamError("renderPass");
+        return;
+    }
+    if (textureSamplerBindings == NULL && bindingCount > 0) {
+        SDL_InvalidParamError("textureSamplerBindings");
+        return;
+    }
+
+    CHECK_RENDERPASS
+    CHECK_GRAPHICS_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_BindFragmentSamplers);
+    RENDERPASS_DEVICE->BindFragmentSamplers(
+        RENDERPASS_COMMAND_BUFFER,
+        firstSlot,
+        textureSamplerBindings,
+        bindingCount);
+    INSTRUMENT_END(Refresh_BindFragmentSamplers);
+}
+
+void Refresh_BindFragmentStorageTextures(
+    Refresh_RenderPass *renderPass,
+    Uint32 firstSlot,
+    Refresh_TextureSlice *storageTextureSlices,
+    Uint32 bindingCount)
+{
+    if (renderPass == NULL) {
+        SDL_InvalidParamError("renderPass");
+        return;
+    }
+    if (storageTextureSlices == NULL && bindingCount > 0) {
+        SDL_InvalidParamError("storageTextureSlices");
+        return;
+    }
+
+    CHECK_RENDERPASS
+    CHECK_GRAPHICS_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_BindFragmentStorageTextures);
+    RENDERPASS_DEVICE->BindFragmentStorageTextures(
+        RENDERPASS_COMMAND_BUFFER,
+        firstSlot,
+        storageTextureSlices,
+        bindingCount);
+    INSTRUMENT_END(Refresh_BindFragmentStorageTextures);
+}
+
+void Refresh_BindFragmentStorageBuffers(
+    Refresh_RenderPass *renderPass,
+    Uint32 firstSlot,
+    Refresh_Buffer **storageBuffers,
+    Uint32 bindingCount)
+{
+    if (renderPass == NULL) {
+        SDL_InvalidParamError("renderPass");
+        return;
+    }
+    if (storageBuffers == NULL && bindingCount > 0) {
+        SDL_InvalidParamError("storageBuffers");
+        return;
+    }
+
+    CHECK_RENDERPASS
+    CHECK_GRAPHICS_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_BindFragmentStorageBuffers);
+    RENDERPASS_DEVICE->BindFragmentStorageBuffers(
+        RENDERPASS_COMMAND_BUFFER,
+        firstSlot,
+        storageBuffers,
+        bindingCount);
+    INSTRUMENT_END(Refresh_BindFragmentStorageBuffers);
+}
+
+void Refresh_DrawIndexedPrimitives(
     Refresh_RenderPass *renderPass,
-    Refresh_GraphicsPipeline *graphicsPipeline)
+    Uint32 baseVertex,
+    Uint32 startIndex,
+    Uint32 primitiveCount,
+    Uint32 instanceCount)
 {
-    CommandBufferCommonHeader *commandBufferHeader;
-
     if (renderPass == NULL) {
         SDL_InvalidParamError("renderPass");
         return;
     }
-    if (graphicsPipeline == NULL) {
-        SDL_InvalidParamError("graphicsPipeline");
-        return;
-    }
 
-    RENDERPASS_DEVICE->BindGraphicsPipeline(
+    CHECK_RENDERPASS
+    CHECK_GRAPHICS_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_DrawIndexedPrimitives);
+    RENDERPASS_DEVICE->DrawIndexedPrimitives(
         RENDERPASS_COMMAND_BUFFER,
-        graphicsPipeline);
-
-    commandBufferHeader = (CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER;
-    commandBufferHeader->graphicsPipelineBound = SDL_TRUE;
+        baseVertex,
+        startIndex,
+        primitiveCount,
+        instanceCount);
+    INSTRUMENT_END(Refresh_DrawIndexedPrimitives);
 }
 
-void Refresh_SetViewport(
+void Refresh_DrawPrimitives(
     Refresh_RenderPass *renderPass,
-    Refresh_Viewport *viewport)
+    Uint32 vertexStart,
+    Uint32 primitiveCount)
 {
     if (renderPass == NULL) {
         SDL_InvalidParamError("renderPass");
         return;
     }
-    if (viewport == NULL) {
-        SDL_InvalidParamError("viewport");
-        return;
-    }
 
     CHECK_RENDERPASS
-    RENDERPASS_DEVICE->SetViewport(
+    CHECK_GRAPHICS_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_DrawPrimitives);
+    RENDERPASS_DEVICE->DrawPrimitives(
         RENDERPASS_COMMAND_BUFFER,
-        viewport);
+        vertexStart,
+        primitiveCount);
+    INSTRUMENT_END(Refresh_DrawPrimitives);
 }
 
-void Refresh_SetScissor(
+void Refresh_DrawPrimitivesIndirect(
     Refresh_RenderPass *renderPass,
-    Refresh_Rect *scissor)
+    Refresh_Buffer *buffer,
+    Uint32 offsetInBytes,
+    Uint32 drawCount,
+    Uint32 stride)
 {
     if (renderPass == NULL) {
         SDL_InvalidParamError("renderPass");
         return;
     }
-    if (scissor == NULL) {
-        SDL_InvalidParamError("scissor");
+    if (buffer == NULL) {
+        SDL_InvalidParamError("buffer");
         return;
     }
 
     CHECK_RENDERPASS
-    RENDERPASS_DEVICE->SetScissor(
+    CHECK_GRAPHICS_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_DrawPrimitivesIndirect);
+    RENDERPASS_DEVICE->DrawPrimitivesIndirect(
         RENDERPASS_COMMAND_BUFFER,
-        scissor);
+        buffer,
+        offsetInBytes,
+        drawCount,
+        stride);
+    INSTRUMENT_END(Refresh_DrawPrimitivesIndirect);
 }
 
-void Refresh_BindVertexBuffers(
+void Refresh_DrawIndexedPrimitivesIndirect(
     Refresh_RenderPass *renderPass,
-    Uint32 firstBinding,
-    Refresh_BufferBinding *pBindings,
-    Uint32 bindingCount)
+    Refresh_Buffer *buffer,
+    Uint32 offsetInBytes,
+    Uint32 drawCount,
+    Uint32 stride)
 {
     if (renderPass == NULL) {
         SDL_InvalidParamError("renderPass");
         return;
     }
-    if (pBindings == NULL && bindingCount > 0) {
-        SDL_InvalidParamError("pBindings");
+    if (buffer == NULL) {
+        SDL_InvalidParamError("buffer");
         return;
     }
 
     CHECK_RENDERPASS
     CHECK_GRAPHICS_PIPELINE_BOUND
-    RENDERPASS_DEVICE->BindVertexBuffers(
+    INSTRUMENT_BEGIN(Refresh_DrawIndexedPrimitivesIndirect);
+    RENDERPASS_DEVICE->DrawIndexedPrimitivesIndirect(
         RENDERPASS_COMMAND_BUFFER,
-        firstBinding,
-        pBindings,
-        bindingCount);
+        buffer,
+        offsetInBytes,
+        drawCount,
+        stride);
+    INSTRUMENT_END(Refresh_DrawIndexedPrimitivesIndirect);
 }
 
-void Refresh_BindIndexBuffer(
+SDL_bool Refresh_SupportsIndirectCount(
+    Refresh_Device *device)
+{
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
+
+    SDL_bool result;
+    INSTRUMENT_BEGIN(Refresh_SupportsIndirectCount);
+    result = device->SupportsIndirectCount(
+        device->driverData);
+    INSTRUMENT_END(Refresh_SupportsIndirectCount);
+    return result;
+}
+
+void Refresh_DrawPrimitivesIndirectCount(
     Refresh_RenderPass *renderPass,
-    Refresh_BufferBinding *pBinding,
-    Refresh_IndexElementSize indexElementSize)
+    Refresh_Buffer *buffer,
+    Uint32 offsetInBytes,
+    Refresh_Buffer *countBuffer,
+    Uint32 countOffsetInBytes,
+    Uint32 maxDrawCount,
+    Uint32 stride)
 {
     if (renderPass == NULL) {
         SDL_InvalidParamError("renderPass");
         return;
     }
-    if (pBinding == NULL) {
-        SDL_InvalidParamError("pBinding");
+    if (buffer == NULL) {
+        SDL_InvalidParamError("buffer");
+        return;
+    }
+    if (countBuffer == NULL) {
+        SDL_InvalidParamError("countBuffer");
         return;
     }
 
     CHECK_RENDERPASS
     CHECK_GRAPHICS_PIPELINE_BOUND
-    RENDERPASS_DEVICE->BindIndexBuffer(
+    INSTRUMENT_BEGIN(Refresh_DrawPrimitivesIndirectCount);
+    RENDERPASS_DEVICE->DrawPrimitivesIndirectCount(
         RENDERPASS_COMMAND_BUFFER,
-        pBinding,
-        indexElementSize);
+        buffer,
+        offsetInBytes,
+        countBuffer,
+        countOffsetInBytes,
+        maxDrawCount,
+        stride);
+    INSTRUMENT_END(Refresh_DrawPrimitivesIndirectCount);
 }
 
-void Refresh_BindVertexSamplers(
+void Refresh_DrawIndexedPrimitivesIndirectCount(
     Refresh_RenderPass *renderPass,
-    Uint32 firstSlot,
-    Refresh_TextureSamplerBinding *textureSamplerBindings,
-    Uint32 bindingCount)
+    Refresh_Buffer *buffer,
+    Uint32 offsetInBytes,
+    Refresh_Buffer *countBuffer,
+    Uint32 countOffsetInBytes,
+    Uint32 maxDrawCount,
+    Uint32 stride)
 {
     if (renderPass == NULL) {
         SDL_InvalidParamError("renderPass");
         return;
     }
-    if (textureSamplerBindings == NULL && bindingCount > 0) {
-        SDL_InvalidParamError("textureSamplerBindings");
+    if (buffer == NULL) {
+        SDL_InvalidParamError("buffer");
+        return;
+    }
+    if (countBuffer == NULL) {
+        SDL_InvalidParamError("countBuffer");
         return;
     }
 
     CHECK_RENDERPASS
     CHECK_GRAPHICS_PIPELINE_BOUND
-    RENDERPASS_DEVICE->BindVertexSamplers(
+    INSTRUMENT_BEGIN(Refresh_DrawIndexedPrimitivesIndirectCount);
+    RENDERPASS_DEVICE->DrawIndexedPrimitivesIndirectCount(
         RENDERPASS_COMMAND_BUFFER,
-        firstSlot,
-        textureSamplerBindings,
-        bindingCount);
+        buffer,
+        offsetInBytes,
+        countBuffer,
+        countOffsetInBytes,
+        maxDrawCount,
+        stride);
+    INSTRUMENT_END(Refresh_DrawIndexedPrimitivesIndirectCount);
 }
 
-void Refresh_BindVertexStorageTextures(
-    Refresh_RenderPass *renderPass,
-    Uint32 firstSlot,
-    Refresh_TextureSlice *storageTextureSlices,
-    Uint32 bindingCount)
+void Refresh_EndRenderPass(
+    Refresh_RenderPass *renderPass)
 {
+    CommandBufferCommonHeader *commandBufferCommonHeader;
+
     if (renderPass == NULL) {
         SDL_InvalidParamError("renderPass");
         return;
     }
-    if (storageTextureSlices == NULL && bindingCount > 0) {
-        SDL_InvalidParamError("storageTextureSlices");
+
+    CHECK_RENDERPASS
+
+    commandBufferCommonHeader = (CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER;
+
+    /* FIXME DEBUGMODE */
+    if (commandBufferCommonHeader->parentCommandBuffer != NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Render pass chunks must be ended with Refresh_EndRenderPassChunk!");
+        return;
+    }
+    if (SDL_AtomicGet(&commandBufferCommonHeader->renderPassChunksInProgress) > 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot end render pass while chunks are still recording!");
         return;
     }
 
-    CHECK_RENDERPASS
-    CHECK_GRAPHICS_PIPELINE_BOUND
-    RENDERPASS_DEVICE->BindVertexStorageTextures(
-        RENDERPASS_COMMAND_BUFFER,
-        firstSlot,
-        storageTextureSlices,
-        bindingCount);
+    INSTRUMENT_BEGIN(Refresh_EndRenderPass);
+    RENDERPASS_DEVICE->EndRenderPass(
+        RENDERPASS_COMMAND_BUFFER);
+    INSTRUMENT_END(Refresh_EndRenderPass);
+
+    commandBufferCommonHeader->renderPass.inProgress = SDL_FALSE;
+    commandBufferCommonHeader->graphicsPipelineBound = SDL_FALSE;
+    commandBufferCommonHeader->parallelRenderPass = SDL_FALSE;
 }
 
-void Refresh_BindVertexStorageBuffers(
-    Refresh_RenderPass *renderPass,
-    Uint32 firstSlot,
-    Refresh_Buffer **storageBuffers,
-    Uint32 bindingCount)
+/* Parallel Render Pass */
+
+Refresh_RenderPass *Refresh_BeginParallelRenderPass(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_ColorAttachmentInfo *colorAttachmentInfos,
+    Uint32 colorAttachmentCount,
+    Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo)
+{
+    CommandBufferCommonHeader *commandBufferHeader;
+
+    if (commandBuffer == NULL) {
+        SDL_InvalidParamError("commandBuffer");
+        return NULL;
+    }
+    if (colorAttachmentInfos == NULL && colorAttachmentCount > 0) {
+        SDL_InvalidParamError("colorAttachmentInfos");
+        return NULL;
+    }
+
+    CHECK_COMMAND_BUFFER_RETURN_NULL
+    CHECK_GRAPHICS_QUEUE_RETURN_NULL
+    CHECK_ANY_PASS_IN_PROGRESS
+
+    INSTRUMENT_BEGIN(Refresh_BeginParallelRenderPass);
+    COMMAND_BUFFER_DEVICE->BeginParallelRenderPass(
+        commandBuffer,
+        colorAttachmentInfos,
+        colorAttachmentCount,
+        depthStencilAttachmentInfo);
+    INSTRUMENT_END(Refresh_BeginParallelRenderPass);
+
+    commandBufferHeader = (CommandBufferCommonHeader *)commandBuffer;
+    commandBufferHeader->renderPass.inProgress = SDL_TRUE;
+    commandBufferHeader->parallelRenderPass = SDL_TRUE;
+    SDL_AtomicSet(&commandBufferHeader->renderPassChunksInProgress, 0);
+    return (Refresh_RenderPass *)&(commandBufferHeader->renderPass);
+}
+
+Refresh_RenderPass *Refresh_AcquireRenderPassChunk(
+    Refresh_RenderPass *renderPass)
 {
+    Refresh_CommandBuffer *chunk;
+    CommandBufferCommonHeader *parentHeader;
+    CommandBufferCommonHeader *chunkHeader;
+
     if (renderPass == NULL) {
         SDL_InvalidParamError("renderPass");
+        return NULL;
+    }
+
+    parentHeader = (CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER;
+
+    /* FIXME DEBUGMODE */
+    if (!((Pass *)renderPass)->inProgress || !parentHeader->parallelRenderPass) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Parallel render pass not in progress!");
+        return NULL;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_AcquireRenderPassChunk);
+    chunk = RENDERPASS_DEVICE->AcquireRenderPassChunk(
+        RENDERPASS_COMMAND_BUFFER);
+    INSTRUMENT_END(Refresh_AcquireRenderPassChunk);
+
+    if (chunk == NULL) {
+        return NULL;
+    }
+
+    chunkHeader = (CommandBufferCommonHeader *)chunk;
+    chunkHeader->device = parentHeader->device;
+    chunkHeader->renderPass.commandBuffer = chunk;
+    chunkHeader->renderPass.inProgress = SDL_TRUE;
+    chunkHeader->graphicsPipelineBound = SDL_FALSE;
+    chunkHeader->computePass.commandBuffer = chunk;
+    chunkHeader->computePass.inProgress = SDL_FALSE;
+    chunkHeader->computePipelineBound = SDL_FALSE;
+    chunkHeader->copyPass.commandBuffer = chunk;
+    chunkHeader->copyPass.inProgress = SDL_FALSE;
+    chunkHeader->submitted = SDL_FALSE;
+    chunkHeader->queueType = parentHeader->queueType;
+    chunkHeader->parallelRenderPass = SDL_FALSE;
+    SDL_AtomicSet(&chunkHeader->renderPassChunksInProgress, 0);
+    chunkHeader->parentCommandBuffer = RENDERPASS_COMMAND_BUFFER;
+
+    (void)SDL_AtomicIncRef(&parentHeader->renderPassChunksInProgress);
+
+    return (Refresh_RenderPass *)&(chunkHeader->renderPass);
+}
+
+void Refresh_EndRenderPassChunk(
+    Refresh_RenderPass *chunk)
+{
+    CommandBufferCommonHeader *chunkHeader;
+    CommandBufferCommonHeader *parentHeader;
+
+    if (chunk == NULL) {
+        SDL_InvalidParamError("chunk");
         return;
     }
-    if (storageBuffers == NULL && bindingCount > 0) {
-        SDL_InvalidParamError("storageBuffers");
+
+    chunkHeader = (CommandBufferCommonHeader *)((Pass *)chunk)->commandBuffer;
+
+    /* FIXME DEBUGMODE */
+    if (!((Pass *)chunk)->inProgress || chunkHeader->parentCommandBuffer == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Render pass chunk not in progress!");
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_EndRenderPassChunk);
+    chunkHeader->device->EndRenderPassChunk(
+        ((Pass *)chunk)->commandBuffer);
+    INSTRUMENT_END(Refresh_EndRenderPassChunk);
+
+    chunkHeader->renderPass.inProgress = SDL_FALSE;
+    chunkHeader->graphicsPipelineBound = SDL_FALSE;
+    chunkHeader->submitted = SDL_TRUE;
+
+    parentHeader = (CommandBufferCommonHeader *)chunkHeader->parentCommandBuffer;
+    (void)SDL_AtomicDecRef(&parentHeader->renderPassChunksInProgress);
+}
+
+/* Command Bundles */
+
+static CommandBundleCommand *CommandBundle_AddCommand(
+    CommandBundle *bundle,
+    CommandBundleCommandType type)
+{
+    CommandBundleCommand *command;
+
+    if (bundle->commandCount == bundle->commandCapacity) {
+        bundle->commandCapacity *= 2;
+        bundle->commands = SDL_realloc(
+            bundle->commands,
+            bundle->commandCapacity * sizeof(CommandBundleCommand));
+    }
+
+    command = &bundle->commands[bundle->commandCount];
+    bundle->commandCount += 1;
+
+    command->type = type;
+    return command;
+}
+
+Refresh_CommandBundle *Refresh_CreateCommandBundle(
+    Refresh_Device *device)
+{
+    CommandBundle *bundle;
+
+    CHECK_DEVICE_MAGIC(device, NULL);
+
+    bundle = SDL_malloc(sizeof(CommandBundle));
+    bundle->device = device;
+
+    bundle->commandCapacity = 16;
+    bundle->commandCount = 0;
+    bundle->commands = SDL_malloc(
+        bundle->commandCapacity * sizeof(CommandBundleCommand));
+
+    bundle->bufferBindingCapacity = 4;
+    bundle->bufferBindingCount = 0;
+    bundle->bufferBindings = SDL_malloc(
+        bundle->bufferBindingCapacity * sizeof(Refresh_BufferBinding));
+
+    bundle->samplerBindingCapacity = 4;
+    bundle->samplerBindingCount = 0;
+    bundle->samplerBindings = SDL_malloc(
+        bundle->samplerBindingCapacity * sizeof(Refresh_TextureSamplerBinding));
+
+    bundle->graphicsPipelineBound = SDL_FALSE;
+
+    return (Refresh_CommandBundle *)bundle;
+}
+
+void Refresh_BundleBindGraphicsPipeline(
+    Refresh_CommandBundle *commandBundle,
+    Refresh_GraphicsPipeline *graphicsPipeline)
+{
+    CommandBundle *bundle = (CommandBundle *)commandBundle;
+    CommandBundleCommand *command;
+
+    if (commandBundle == NULL) {
+        SDL_InvalidParamError("commandBundle");
+        return;
+    }
+    if (graphicsPipeline == NULL) {
+        SDL_InvalidParamError("graphicsPipeline");
         return;
     }
 
-    CHECK_RENDERPASS
-    CHECK_GRAPHICS_PIPELINE_BOUND
-    RENDERPASS_DEVICE->BindVertexStorageBuffers(
-        RENDERPASS_COMMAND_BUFFER,
-        firstSlot,
-        storageBuffers,
-        bindingCount);
+    command = CommandBundle_AddCommand(bundle, COMMAND_BUNDLE_BIND_GRAPHICS_PIPELINE);
+    command->data.graphicsPipeline = graphicsPipeline;
+
+    bundle->graphicsPipelineBound = SDL_TRUE;
 }
 
-void Refresh_BindFragmentSamplers(
-    Refresh_RenderPass *renderPass,
-    Uint32 firstSlot,
-    Refresh_TextureSamplerBinding *textureSamplerBindings,
+void Refresh_BundleBindVertexBuffers(
+    Refresh_CommandBundle *commandBundle,
+    Uint32 firstBinding,
+    Refresh_BufferBinding *pBindings,
     Uint32 bindingCount)
 {
-    if (renderPass == NULL) {
-        SDL_InvalidParamError("renderPass");
+    CommandBundle *bundle = (CommandBundle *)commandBundle;
+    CommandBundleCommand *command;
+
+    if (commandBundle == NULL) {
+        SDL_InvalidParamError("commandBundle");
         return;
     }
-    if (textureSamplerBindings == NULL && bindingCount > 0) {
-        SDL_InvalidParamError("textureSamplerBindings");
+    if (pBindings == NULL && bindingCount > 0) {
+        SDL_InvalidParamError("pBindings");
         return;
     }
 
-    CHECK_RENDERPASS
-    CHECK_GRAPHICS_PIPELINE_BOUND
-    RENDERPASS_DEVICE->BindFragmentSamplers(
-        RENDERPASS_COMMAND_BUFFER,
-        firstSlot,
-        textureSamplerBindings,
-        bindingCount);
+    CHECK_BUNDLE_GRAPHICS_PIPELINE_BOUND
+
+    if (bundle->bufferBindingCount + bindingCount > bundle->bufferBindingCapacity) {
+        bundle->bufferBindingCapacity = SDL_max(
+            bundle->bufferBindingCapacity * 2,
+            bundle->bufferBindingCount + bindingCount);
+        bundle->bufferBindings = SDL_realloc(
+            bundle->bufferBindings,
+            bundle->bufferBindingCapacity * sizeof(Refresh_BufferBinding));
+    }
+
+    command = CommandBundle_AddCommand(bundle, COMMAND_BUNDLE_BIND_VERTEX_BUFFERS);
+    command->data.bindings.firstSlot = firstBinding;
+    command->data.bindings.bindingOffset = bundle->bufferBindingCount;
+    command->data.bindings.bindingCount = bindingCount;
+
+    SDL_memcpy(
+        &bundle->bufferBindings[bundle->bufferBindingCount],
+        pBindings,
+        bindingCount * sizeof(Refresh_BufferBinding));
+    bundle->bufferBindingCount += bindingCount;
 }
 
-void Refresh_BindFragmentStorageTextures(
-    Refresh_RenderPass *renderPass,
-    Uint32 firstSlot,
-    Refresh_TextureSlice *storageTextureSlices,
-    Uint32 bindingCount)
+void Refresh_BundleBindIndexBuffer(
+    Refresh_CommandBundle *commandBundle,
+    Refresh_BufferBinding *pBinding,
+    Refresh_IndexElementSize indexElementSize)
 {
-    if (renderPass == NULL) {
-        SDL_InvalidParamError("renderPass");
+    CommandBundle *bundle = (CommandBundle *)commandBundle;
+    CommandBundleCommand *command;
+
+    if (commandBundle == NULL) {
+        SDL_InvalidParamError("commandBundle");
         return;
     }
-    if (storageTextureSlices == NULL && bindingCount > 0) {
-        SDL_InvalidParamError("storageTextureSlices");
+    if (pBinding == NULL) {
+        SDL_InvalidParamError("pBinding");
         return;
     }
 
-    CHECK_RENDERPASS
-    CHECK_GRAPHICS_PIPELINE_BOUND
-    RENDERPASS_DEVICE->BindFragmentStorageTextures(
-        RENDERPASS_COMMAND_BUFFER,
-        firstSlot,
-        storageTextureSlices,
-        bindingCount);
+    CHECK_BUNDLE_GRAPHICS_PIPELINE_BOUND
+
+    command = CommandBundle_AddCommand(bundle, COMMAND_BUNDLE_BIND_INDEX_BUFFER);
+    command->data.indexBuffer.binding = *pBinding;
+    command->data.indexBuffer.indexElementSize = indexElementSize;
 }
 
-void Refresh_BindFragmentStorageBuffers(
-    Refresh_RenderPass *renderPass,
+void Refresh_BundleBindFragmentSamplers(
+    Refresh_CommandBundle *commandBundle,
     Uint32 firstSlot,
-    Refresh_Buffer **storageBuffers,
+    Refresh_TextureSamplerBinding *textureSamplerBindings,
     Uint32 bindingCount)
 {
-    if (renderPass == NULL) {
-        SDL_InvalidParamError("renderPass");
+    CommandBundle *bundle = (CommandBundle *)commandBundle;
+    CommandBundleCommand *command;
+
+    if (commandBundle == NULL) {
+        SDL_InvalidParamError("commandBundle");
         return;
     }
-    if (storageBuffers == NULL && bindingCount > 0) {
-        SDL_InvalidParamError("storageBuffers");
+    if (textureSamplerBindings == NULL && bindingCount > 0) {
+        SDL_InvalidParamError("textureSamplerBindings");
         return;
     }
 
-    CHECK_RENDERPASS
-    CHECK_GRAPHICS_PIPELINE_BOUND
-    RENDERPASS_DEVICE->BindFragmentStorageBuffers(
-        RENDERPASS_COMMAND_BUFFER,
-        firstSlot,
-        storageBuffers,
-        bindingCount);
+    CHECK_BUNDLE_GRAPHICS_PIPELINE_BOUND
+
+    if (bundle->samplerBindingCount + bindingCount > bundle->samplerBindingCapacity) {
+        bundle->samplerBindingCapacity = SDL_max(
+            bundle->samplerBindingCapacity * 2,
+            bundle->samplerBindingCount + bindingCount);
+        bundle->samplerBindings = SDL_realloc(
+            bundle->samplerBindings,
+            bundle->samplerBindingCapacity * sizeof(Refresh_TextureSamplerBinding));
+    }
+
+    command = CommandBundle_AddCommand(bundle, COMMAND_BUNDLE_BIND_FRAGMENT_SAMPLERS);
+    command->data.bindings.firstSlot = firstSlot;
+    command->data.bindings.bindingOffset = bundle->samplerBindingCount;
+    command->data.bindings.bindingCount = bindingCount;
+
+    SDL_memcpy(
+        &bundle->samplerBindings[bundle->samplerBindingCount],
+        textureSamplerBindings,
+        bindingCount * sizeof(Refresh_TextureSamplerBinding));
+    bundle->samplerBindingCount += bindingCount;
 }
 
-void Refresh_DrawIndexedPrimitives(
-    Refresh_RenderPass *renderPass,
+void Refresh_BundleDrawIndexedPrimitives(
+    Refresh_CommandBundle *commandBundle,
     Uint32 baseVertex,
     Uint32 startIndex,
     Uint32 primitiveCount,
     Uint32 instanceCount)
 {
-    if (renderPass == NULL) {
-        SDL_InvalidParamError("renderPass");
+    CommandBundle *bundle = (CommandBundle *)commandBundle;
+    CommandBundleCommand *command;
+
+    if (commandBundle == NULL) {
+        SDL_InvalidParamError("commandBundle");
         return;
     }
 
-    CHECK_RENDERPASS
-    CHECK_GRAPHICS_PIPELINE_BOUND
-    RENDERPASS_DEVICE->DrawIndexedPrimitives(
-        RENDERPASS_COMMAND_BUFFER,
-        baseVertex,
-        startIndex,
-        primitiveCount,
-        instanceCount);
+    CHECK_BUNDLE_GRAPHICS_PIPELINE_BOUND
+
+    command = CommandBundle_AddCommand(bundle, COMMAND_BUNDLE_DRAW_INDEXED_PRIMITIVES);
+    command->data.drawIndexed.baseVertex = baseVertex;
+    command->data.drawIndexed.startIndex = startIndex;
+    command->data.drawIndexed.primitiveCount = primitiveCount;
+    command->data.drawIndexed.instanceCount = instanceCount;
 }
 
-void Refresh_DrawPrimitives(
-    Refresh_RenderPass *renderPass,
+void Refresh_BundleDrawPrimitives(
+    Refresh_CommandBundle *commandBundle,
     Uint32 vertexStart,
     Uint32 primitiveCount)
 {
-    if (renderPass == NULL) {
-        SDL_InvalidParamError("renderPass");
+    CommandBundle *bundle = (CommandBundle *)commandBundle;
+    CommandBundleCommand *command;
+
+    if (commandBundle == NULL) {
+        SDL_InvalidParamError("commandBundle");
         return;
     }
 
-    CHECK_RENDERPASS
-    CHECK_GRAPHICS_PIPELINE_BOUND
-    RENDERPASS_DEVICE->DrawPrimitives(
-        RENDERPASS_COMMAND_BUFFER,
-        vertexStart,
-        primitiveCount);
+    CHECK_BUNDLE_GRAPHICS_PIPELINE_BOUND
+
+    command = CommandBundle_AddCommand(bundle, COMMAND_BUNDLE_DRAW_PRIMITIVES);
+    command->data.draw.vertexStart = vertexStart;
+    command->data.draw.primitiveCount = primitiveCount;
 }
 
-void Refresh_DrawPrimitivesIndirect(
+void Refresh_ExecuteCommandBundle(
     Refresh_RenderPass *renderPass,
-    Refresh_Buffer *buffer,
-    Uint32 offsetInBytes,
-    Uint32 drawCount,
-    Uint32 stride)
+    Refresh_CommandBundle *commandBundle)
 {
+    CommandBundle *bundle = (CommandBundle *)commandBundle;
+    CommandBufferCommonHeader *commandBufferHeader;
+
     if (renderPass == NULL) {
         SDL_InvalidParamError("renderPass");
         return;
     }
-    if (buffer == NULL) {
-        SDL_InvalidParamError("buffer");
+    if (commandBundle == NULL) {
+        SDL_InvalidParamError("commandBundle");
         return;
     }
 
     CHECK_RENDERPASS
-    CHECK_GRAPHICS_PIPELINE_BOUND
-    RENDERPASS_DEVICE->DrawPrimitivesIndirect(
-        RENDERPASS_COMMAND_BUFFER,
-        buffer,
-        offsetInBytes,
-        drawCount,
-        stride);
-}
+    CHECK_NOT_PARALLEL_RENDERPASS
 
-void Refresh_DrawIndexedPrimitivesIndirect(
-    Refresh_RenderPass *renderPass,
-    Refresh_Buffer *buffer,
-    Uint32 offsetInBytes,
-    Uint32 drawCount,
-    Uint32 stride)
-{
-    if (renderPass == NULL) {
-        SDL_InvalidParamError("renderPass");
-        return;
-    }
-    if (buffer == NULL) {
-        SDL_InvalidParamError("buffer");
+    if (bundle->commandCount == 0) {
         return;
     }
 
-    CHECK_RENDERPASS
-    CHECK_GRAPHICS_PIPELINE_BOUND
-    RENDERPASS_DEVICE->DrawIndexedPrimitivesIndirect(
+    INSTRUMENT_BEGIN(Refresh_ExecuteCommandBundle);
+    RENDERPASS_DEVICE->ExecuteCommandBundle(
         RENDERPASS_COMMAND_BUFFER,
-        buffer,
-        offsetInBytes,
-        drawCount,
-        stride);
+        commandBundle);
+    INSTRUMENT_END(Refresh_ExecuteCommandBundle);
+
+    if (bundle->graphicsPipelineBound) {
+        commandBufferHeader = (CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER;
+        commandBufferHeader->graphicsPipelineBound = SDL_TRUE;
+    }
 }
 
-void Refresh_EndRenderPass(
-    Refresh_RenderPass *renderPass)
+void Refresh_ReleaseCommandBundle(
+    Refresh_Device *device,
+    Refresh_CommandBundle *commandBundle)
 {
-    CommandBufferCommonHeader *commandBufferCommonHeader;
+    CommandBundle *bundle = (CommandBundle *)commandBundle;
 
-    if (renderPass == NULL) {
-        SDL_InvalidParamError("renderPass");
+    CHECK_DEVICE_MAGIC(device, );
+    if (commandBundle == NULL) {
         return;
     }
 
-    CHECK_RENDERPASS
-    RENDERPASS_DEVICE->EndRenderPass(
-        RENDERPASS_COMMAND_BUFFER);
-
-    commandBufferCommonHeader = (CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER;
-    commandBufferCommonHeader->renderPass.inProgress = SDL_FALSE;
-    commandBufferCommonHeader->graphicsPipelineBound = SDL_FALSE;
+    /* Executing a bundle records its commands, so nothing on the GPU refers to it */
+    SDL_free(bundle->commands);
+    SDL_free(bundle->bufferBindings);
+    SDL_free(bundle->samplerBindings);
+    SDL_free(bundle);
 }
 
 /* Compute Pass */
@@ -1197,13 +2952,16 @@ Refresh_ComputePass *Refresh_BeginComputePass(
     }
 
     CHECK_COMMAND_BUFFER_RETURN_NULL
+    CHECK_COMPUTE_QUEUE_RETURN_NULL
     CHECK_ANY_PASS_IN_PROGRESS
+    INSTRUMENT_BEGIN(Refresh_BeginComputePass);
     COMMAND_BUFFER_DEVICE->BeginComputePass(
         commandBuffer,
         storageTextureBindings,
         storageTextureBindingCount,
         storageBufferBindings,
         storageBufferBindingCount);
+    INSTRUMENT_END(Refresh_BeginComputePass);
 
     commandBufferHeader = (CommandBufferCommonHeader *)commandBuffer;
     commandBufferHeader->computePass.inProgress = SDL_TRUE;
@@ -1226,9 +2984,11 @@ void Refresh_BindComputePipeline(
     }
 
     CHECK_COMPUTEPASS
+    INSTRUMENT_BEGIN(Refresh_BindComputePipeline);
     COMPUTEPASS_DEVICE->BindComputePipeline(
         COMPUTEPASS_COMMAND_BUFFER,
         computePipeline);
+    INSTRUMENT_END(Refresh_BindComputePipeline);
 
     commandBufferHeader = (CommandBufferCommonHeader *)COMPUTEPASS_COMMAND_BUFFER;
     commandBufferHeader->computePipelineBound = SDL_TRUE;
@@ -1251,11 +3011,13 @@ void Refresh_BindComputeStorageTextures(
 
     CHECK_COMPUTEPASS
     CHECK_COMPUTE_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_BindComputeStorageTextures);
     COMPUTEPASS_DEVICE->BindComputeStorageTextures(
         COMPUTEPASS_COMMAND_BUFFER,
         firstSlot,
         storageTextureSlices,
         bindingCount);
+    INSTRUMENT_END(Refresh_BindComputeStorageTextures);
 }
 
 void Refresh_BindComputeStorageBuffers(
@@ -1275,11 +3037,13 @@ void Refresh_BindComputeStorageBuffers(
 
     CHECK_COMPUTEPASS
     CHECK_COMPUTE_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_BindComputeStorageBuffers);
     COMPUTEPASS_DEVICE->BindComputeStorageBuffers(
         COMPUTEPASS_COMMAND_BUFFER,
         firstSlot,
         storageBuffers,
         bindingCount);
+    INSTRUMENT_END(Refresh_BindComputeStorageBuffers);
 }
 
 void Refresh_DispatchCompute(
@@ -1295,11 +3059,13 @@ void Refresh_DispatchCompute(
 
     CHECK_COMPUTEPASS
     CHECK_COMPUTE_PIPELINE_BOUND
+    INSTRUMENT_BEGIN(Refresh_DispatchCompute);
     COMPUTEPASS_DEVICE->DispatchCompute(
         COMPUTEPASS_COMMAND_BUFFER,
         groupCountX,
         groupCountY,
         groupCountZ);
+    INSTRUMENT_END(Refresh_DispatchCompute);
 }
 
 void Refresh_EndComputePass(
@@ -1313,8 +3079,10 @@ void Refresh_EndComputePass(
     }
 
     CHECK_COMPUTEPASS
+    INSTRUMENT_BEGIN(Refresh_EndComputePass);
     COMPUTEPASS_DEVICE->EndComputePass(
         COMPUTEPASS_COMMAND_BUFFER);
+    INSTRUMENT_END(Refresh_EndComputePass);
 
     commandBufferCommonHeader = (CommandBufferCommonHeader *)COMPUTEPASS_COMMAND_BUFFER;
     commandBufferCommonHeader->computePass.inProgress = SDL_FALSE;
@@ -1339,11 +3107,13 @@ void Refresh_MapTransferBuffer(
         return;
     }
 
+    INSTRUMENT_BEGIN(Refresh_MapTransferBuffer);
     device->MapTransferBuffer(
         device->driverData,
         transferBuffer,
         cycle,
         ppData);
+    INSTRUMENT_END(Refresh_MapTransferBuffer);
 }
 
 void Refresh_UnmapTransferBuffer(
@@ -1356,9 +3126,11 @@ void Refresh_UnmapTransferBuffer(
         return;
     }
 
+    INSTRUMENT_BEGIN(Refresh_UnmapTransferBuffer);
     device->UnmapTransferBuffer(
         device->driverData,
         transferBuffer);
+    INSTRUMENT_END(Refresh_UnmapTransferBuffer);
 }
 
 void Refresh_SetTransferData(
@@ -1377,11 +3149,13 @@ void Refresh_SetTransferData(
         return;
     }
 
+    INSTRUMENT_BEGIN(Refresh_SetTransferData);
     device->SetTransferData(
         device->driverData,
         source,
         destination,
         cycle);
+    INSTRUMENT_END(Refresh_SetTransferData);
 }
 
 void Refresh_GetTransferData(
@@ -1399,10 +3173,12 @@ void Refresh_GetTransferData(
         return;
     }
 
+    INSTRUMENT_BEGIN(Refresh_GetTransferData);
     device->GetTransferData(
         device->driverData,
         source,
         destination);
+    INSTRUMENT_END(Refresh_GetTransferData);
 }
 
 /* Copy Pass */
@@ -1419,8 +3195,10 @@ Refresh_CopyPass *Refresh_BeginCopyPass(
 
     CHECK_COMMAND_BUFFER_RETURN_NULL
     CHECK_ANY_PASS_IN_PROGRESS
+    INSTRUMENT_BEGIN(Refresh_BeginCopyPass);
     COMMAND_BUFFER_DEVICE->BeginCopyPass(
         commandBuffer);
+    INSTRUMENT_END(Refresh_BeginCopyPass);
 
     commandBufferHeader = (CommandBufferCommonHeader *)commandBuffer;
     commandBufferHeader->copyPass.inProgress = SDL_TRUE;
@@ -1447,102 +3225,252 @@ void Refresh_UploadToTexture(
     }
 
     CHECK_COPYPASS
+    INSTRUMENT_BEGIN(Refresh_UploadToTexture);
     COPYPASS_DEVICE->UploadToTexture(
         COPYPASS_COMMAND_BUFFER,
         source,
         destination,
         cycle);
+    INSTRUMENT_END(Refresh_UploadToTexture);
+}
+
+void Refresh_UploadToBuffer(
+    Refresh_CopyPass *copyPass,
+    Refresh_TransferBufferLocation *source,
+    Refresh_BufferRegion *destination,
+    SDL_bool cycle)
+{
+    if (copyPass == NULL) {
+        SDL_InvalidParamError("copyPass");
+        return;
+    }
+    if (source == NULL) {
+        SDL_InvalidParamError("source");
+        return;
+    }
+    if (destination == NULL) {
+        SDL_InvalidParamError("destination");
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_UploadToBuffer);
+    COPYPASS_DEVICE->UploadToBuffer(
+        COPYPASS_COMMAND_BUFFER,
+        source,
+        destination,
+        cycle);
+    INSTRUMENT_END(Refresh_UploadToBuffer);
+}
+
+void *Refresh_AcquireStagingMemory(
+    Refresh_CopyPass *copyPass,
+    Uint32 sizeInBytes,
+    Refresh_TransferBufferLocation *location)
+{
+    if (copyPass == NULL) {
+        SDL_InvalidParamError("copyPass");
+        return NULL;
+    }
+    if (sizeInBytes == 0) {
+        SDL_InvalidParamError("sizeInBytes");
+        return NULL;
+    }
+    if (location == NULL) {
+        SDL_InvalidParamError("location");
+        return NULL;
+    }
+
+    CHECK_COPYPASS_RETURN_NULL
+    void *result;
+    INSTRUMENT_BEGIN(Refresh_AcquireStagingMemory);
+    result = COPYPASS_DEVICE->AcquireStagingMemory(
+        COPYPASS_COMMAND_BUFFER,
+        sizeInBytes,
+        location);
+    INSTRUMENT_END(Refresh_AcquireStagingMemory);
+    return result;
+}
+
+void Refresh_CopyTextureToTexture(
+    Refresh_CopyPass *copyPass,
+    Refresh_TextureLocation *source,
+    Refresh_TextureLocation *destination,
+    Uint32 w,
+    Uint32 h,
+    Uint32 d,
+    SDL_bool cycle)
+{
+    if (copyPass == NULL) {
+        SDL_InvalidParamError("copyPass");
+        return;
+    }
+    if (source == NULL) {
+        SDL_InvalidParamError("source");
+        return;
+    }
+    if (destination == NULL) {
+        SDL_InvalidParamError("destination");
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_CopyTextureToTexture);
+    COPYPASS_DEVICE->CopyTextureToTexture(
+        COPYPASS_COMMAND_BUFFER,
+        source,
+        destination,
+        w,
+        h,
+        d,
+        cycle);
+    INSTRUMENT_END(Refresh_CopyTextureToTexture);
+}
+
+void Refresh_CopyBufferToBuffer(
+    Refresh_CopyPass *copyPass,
+    Refresh_BufferLocation *source,
+    Refresh_BufferLocation *destination,
+    Uint32 size,
+    SDL_bool cycle)
+{
+    if (copyPass == NULL) {
+        SDL_InvalidParamError("copyPass");
+        return;
+    }
+    if (source == NULL) {
+        SDL_InvalidParamError("source");
+        return;
+    }
+    if (destination == NULL) {
+        SDL_InvalidParamError("destination");
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_CopyBufferToBuffer);
+    COPYPASS_DEVICE->CopyBufferToBuffer(
+        COPYPASS_COMMAND_BUFFER,
+        source,
+        destination,
+        size,
+        cycle);
+    INSTRUMENT_END(Refresh_CopyBufferToBuffer);
 }
 
-void Refresh_UploadToBuffer(
+void Refresh_UploadToTextureRegions(
     Refresh_CopyPass *copyPass,
-    Refresh_TransferBufferLocation *source,
-    Refresh_BufferRegion *destination,
+    Refresh_TextureTransferInfo *sources,
+    Refresh_TextureRegion *destinations,
+    Uint32 regionCount,
     SDL_bool cycle)
 {
     if (copyPass == NULL) {
         SDL_InvalidParamError("copyPass");
         return;
     }
-    if (source == NULL) {
-        SDL_InvalidParamError("source");
+    if (sources == NULL) {
+        SDL_InvalidParamError("sources");
         return;
     }
-    if (destination == NULL) {
-        SDL_InvalidParamError("destination");
+    if (destinations == NULL) {
+        SDL_InvalidParamError("destinations");
+        return;
+    }
+    if (regionCount == 0) {
         return;
     }
 
-    COPYPASS_DEVICE->UploadToBuffer(
+    CHECK_COPYPASS
+    INSTRUMENT_BEGIN(Refresh_UploadToTextureRegions);
+    COPYPASS_DEVICE->UploadToTextureRegions(
         COPYPASS_COMMAND_BUFFER,
-        source,
-        destination,
+        sources,
+        destinations,
+        regionCount,
         cycle);
+    INSTRUMENT_END(Refresh_UploadToTextureRegions);
 }
 
-void Refresh_CopyTextureToTexture(
+void Refresh_UploadToBufferRegions(
     Refresh_CopyPass *copyPass,
-    Refresh_TextureLocation *source,
-    Refresh_TextureLocation *destination,
-    Uint32 w,
-    Uint32 h,
-    Uint32 d,
+    Refresh_TransferBufferLocation *sources,
+    Refresh_BufferRegion *destinations,
+    Uint32 regionCount,
     SDL_bool cycle)
 {
     if (copyPass == NULL) {
         SDL_InvalidParamError("copyPass");
         return;
     }
-    if (source == NULL) {
-        SDL_InvalidParamError("source");
+    if (sources == NULL) {
+        SDL_InvalidParamError("sources");
         return;
     }
-    if (destination == NULL) {
-        SDL_InvalidParamError("destination");
+    if (destinations == NULL) {
+        SDL_InvalidParamError("destinations");
+        return;
+    }
+    if (regionCount == 0) {
         return;
     }
 
-    COPYPASS_DEVICE->CopyTextureToTexture(
+    CHECK_COPYPASS
+    INSTRUMENT_BEGIN(Refresh_UploadToBufferRegions);
+    COPYPASS_DEVICE->UploadToBufferRegions(
         COPYPASS_COMMAND_BUFFER,
-        source,
-        destination,
-        w,
-        h,
-        d,
+        sources,
+        destinations,
+        regionCount,
         cycle);
+    INSTRUMENT_END(Refresh_UploadToBufferRegions);
 }
 
-void Refresh_CopyBufferToBuffer(
+void Refresh_CopyBufferToBufferRegions(
     Refresh_CopyPass *copyPass,
-    Refresh_BufferLocation *source,
-    Refresh_BufferLocation *destination,
-    Uint32 size,
+    Refresh_BufferLocation *sources,
+    Refresh_BufferRegion *destinations,
+    Uint32 regionCount,
     SDL_bool cycle)
 {
     if (copyPass == NULL) {
         SDL_InvalidParamError("copyPass");
         return;
     }
-    if (source == NULL) {
-        SDL_InvalidParamError("source");
+    if (sources == NULL) {
+        SDL_InvalidParamError("sources");
         return;
     }
-    if (destination == NULL) {
-        SDL_InvalidParamError("destination");
+    if (destinations == NULL) {
+        SDL_InvalidParamError("destinations");
+        return;
+    }
+    if (regionCount == 0) {
         return;
     }
 
-    COPYPASS_DEVICE->CopyBufferToBuffer(
+    CHECK_COPYPASS
+    INSTRUMENT_BEGIN(Refresh_CopyBufferToBufferRegions);
+    COPYPASS_DEVICE->CopyBufferToBufferRegions(
         COPYPASS_COMMAND_BUFFER,
-        source,
-        destination,
-        size,
+        sources,
+        destinations,
+        regionCount,
         cycle);
+    INSTRUMENT_END(Refresh_CopyBufferToBufferRegions);
 }
 
 void Refresh_GenerateMipmaps(
     Refresh_CopyPass *copyPass,
     Refresh_Texture *texture)
+{
+    Refresh_GenerateMipmapsWithFilter(
+        copyPass,
+        texture,
+        REFRESH_FILTER_LINEAR);
+}
+
+void Refresh_GenerateMipmapsWithFilter(
+    Refresh_CopyPass *copyPass,
+    Refresh_Texture *texture,
+    Refresh_Filter filterMode)
 {
     if (copyPass == NULL) {
         SDL_InvalidParamError("copyPass");
@@ -1553,9 +3481,18 @@ void Refresh_GenerateMipmaps(
         return;
     }
 
+    /* FIXME DEBUGMODE */
+    if (((CommandBufferCommonHeader *)COPYPASS_COMMAND_BUFFER)->queueType != REFRESH_QUEUETYPE_GRAPHICS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "GenerateMipmaps requires a graphics queue!");
+        return;
+    }
+
+    INSTRUMENT_BEGIN(Refresh_GenerateMipmapsWithFilter);
     COPYPASS_DEVICE->GenerateMipmaps(
         COPYPASS_COMMAND_BUFFER,
-        texture);
+        texture,
+        filterMode);
+    INSTRUMENT_END(Refresh_GenerateMipmapsWithFilter);
 }
 
 void Refresh_DownloadFromTexture(
@@ -1576,10 +3513,12 @@ void Refresh_DownloadFromTexture(
         return;
     }
 
+    INSTRUMENT_BEGIN(Refresh_DownloadFromTexture);
     COPYPASS_DEVICE->DownloadFromTexture(
         COPYPASS_COMMAND_BUFFER,
         source,
         destination);
+    INSTRUMENT_END(Refresh_DownloadFromTexture);
 }
 
 void Refresh_DownloadFromBuffer(
@@ -1600,10 +3539,12 @@ void Refresh_DownloadFromBuffer(
         return;
     }
 
+    INSTRUMENT_BEGIN(Refresh_DownloadFromBuffer);
     COPYPASS_DEVICE->DownloadFromBuffer(
         COPYPASS_COMMAND_BUFFER,
         source,
         destination);
+    INSTRUMENT_END(Refresh_DownloadFromBuffer);
 }
 
 void Refresh_EndCopyPass(
@@ -1615,8 +3556,10 @@ void Refresh_EndCopyPass(
     }
 
     CHECK_COPYPASS
+    INSTRUMENT_BEGIN(Refresh_EndCopyPass);
     COPYPASS_DEVICE->EndCopyPass(
         COPYPASS_COMMAND_BUFFER);
+    INSTRUMENT_END(Refresh_EndCopyPass);
 
     ((CommandBufferCommonHeader *)COPYPASS_COMMAND_BUFFER)->copyPass.inProgress = SDL_FALSE;
 }
@@ -1642,12 +3585,15 @@ void Refresh_Blit(
     }
 
     CHECK_COMMAND_BUFFER
+    CHECK_GRAPHICS_QUEUE
+    INSTRUMENT_BEGIN(Refresh_Blit);
     COMMAND_BUFFER_DEVICE->Blit(
         commandBuffer,
         source,
         destination,
         filterMode,
         cycle);
+    INSTRUMENT_END(Refresh_Blit);
 }
 
 /* Submission/Presentation */
@@ -1715,9 +3661,11 @@ void Refresh_UnclaimWindow(
         return;
     }
 
+    INSTRUMENT_BEGIN(Refresh_UnclaimWindow);
     device->UnclaimWindow(
         device->driverData,
         window);
+    INSTRUMENT_END(Refresh_UnclaimWindow);
 }
 
 SDL_bool Refresh_SetSwapchainParameters(
@@ -1732,11 +3680,59 @@ SDL_bool Refresh_SetSwapchainParameters(
         return SDL_FALSE;
     }
 
-    return device->SetSwapchainParameters(
+    SDL_bool result;
+    INSTRUMENT_BEGIN(Refresh_SetSwapchainParameters);
+    result = device->SetSwapchainParameters(
         device->driverData,
         window,
         swapchainFormat,
         presentMode);
+    INSTRUMENT_END(Refresh_SetSwapchainParameters);
+    return result;
+}
+
+SDL_bool Refresh_SetAllowedFramesInFlight(
+    Refresh_Device *device,
+    SDL_Window *window,
+    Uint32 allowedFramesInFlight)
+{
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
+    if (window == NULL) {
+        SDL_InvalidParamError("window");
+        return SDL_FALSE;
+    }
+    if (allowedFramesInFlight < 1 || allowedFramesInFlight > MAX_FRAMES_IN_FLIGHT) {
+        SDL_InvalidParamError("allowedFramesInFlight");
+        return SDL_FALSE;
+    }
+
+    SDL_bool result;
+    INSTRUMENT_BEGIN(Refresh_SetAllowedFramesInFlight);
+    result = device->SetAllowedFramesInFlight(
+        device->driverData,
+        window,
+        allowedFramesInFlight);
+    INSTRUMENT_END(Refresh_SetAllowedFramesInFlight);
+    return result;
+}
+
+SDL_bool Refresh_WaitForSwapchain(
+    Refresh_Device *device,
+    SDL_Window *window)
+{
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
+    if (window == NULL) {
+        SDL_InvalidParamError("window");
+        return SDL_FALSE;
+    }
+
+    SDL_bool result;
+    INSTRUMENT_BEGIN(Refresh_WaitForSwapchain);
+    result = device->WaitForSwapchain(
+        device->driverData,
+        window);
+    INSTRUMENT_END(Refresh_WaitForSwapchain);
+    return result;
 }
 
 Refresh_TextureFormat Refresh_GetSwapchainTextureFormat(
@@ -1770,11 +3766,16 @@ Refresh_Texture *Refresh_AcquireSwapchainTexture(
     }
 
     CHECK_COMMAND_BUFFER_RETURN_NULL
-    return COMMAND_BUFFER_DEVICE->AcquireSwapchainTexture(
+    CHECK_GRAPHICS_QUEUE_RETURN_NULL
+    Refresh_Texture *result;
+    INSTRUMENT_BEGIN(Refresh_AcquireSwapchainTexture);
+    result = COMMAND_BUFFER_DEVICE->AcquireSwapchainTexture(
         commandBuffer,
         window,
         pWidth,
         pHeight);
+    INSTRUMENT_END(Refresh_AcquireSwapchainTexture);
+    return result;
 }
 
 void Refresh_Submit(
@@ -1799,8 +3800,10 @@ void Refresh_Submit(
 
     commandBufferHeader->submitted = SDL_TRUE;
 
+    INSTRUMENT_BEGIN(Refresh_Submit);
     COMMAND_BUFFER_DEVICE->Submit(
         commandBuffer);
+    INSTRUMENT_END(Refresh_Submit);
 }
 
 Refresh_Fence *Refresh_SubmitAndAcquireFence(
@@ -1825,8 +3828,12 @@ Refresh_Fence *Refresh_SubmitAndAcquireFence(
 
     commandBufferHeader->submitted = SDL_TRUE;
 
-    return COMMAND_BUFFER_DEVICE->SubmitAndAcquireFence(
+    Refresh_Fence *result;
+    INSTRUMENT_BEGIN(Refresh_SubmitAndAcquireFence);
+    result = COMMAND_BUFFER_DEVICE->SubmitAndAcquireFence(
         commandBuffer);
+    INSTRUMENT_END(Refresh_SubmitAndAcquireFence);
+    return result;
 }
 
 void Refresh_Wait(
@@ -1834,8 +3841,10 @@ void Refresh_Wait(
 {
     CHECK_DEVICE_MAGIC(device, );
 
+    INSTRUMENT_BEGIN(Refresh_Wait);
     device->Wait(
         device->driverData);
+    INSTRUMENT_END(Refresh_Wait);
 }
 
 void Refresh_WaitForFences(
@@ -1850,11 +3859,13 @@ void Refresh_WaitForFences(
         return;
     }
 
+    INSTRUMENT_BEGIN(Refresh_WaitForFences);
     device->WaitForFences(
         device->driverData,
         waitAll,
         pFences,
         fenceCount);
+    INSTRUMENT_END(Refresh_WaitForFences);
 }
 
 SDL_bool Refresh_QueryFence(
@@ -1881,7 +3892,497 @@ void Refresh_ReleaseFence(
         return;
     }
 
+    INSTRUMENT_BEGIN(Refresh_ReleaseFence);
     device->ReleaseFence(
         device->driverData,
         fence);
+    INSTRUMENT_END(Refresh_ReleaseFence);
+}
+
+Uint64 Refresh_GetFenceSubmissionValue(
+    Refresh_Device *device,
+    Refresh_Fence *fence)
+{
+    CHECK_DEVICE_MAGIC(device, 0);
+    if (fence == NULL) {
+        SDL_InvalidParamError("fence");
+        return 0;
+    }
+
+    return device->GetFenceSubmissionValue(
+        device->driverData,
+        fence);
+}
+
+/* Fence Callbacks */
+
+typedef struct FenceCallback
+{
+    Refresh_Fence *fence;
+    Uint64 submissionValue;
+    Refresh_FenceCallback callback;
+    void *userdata;
+} FenceCallback;
+
+typedef struct FenceCallbackWaiter
+{
+    Refresh_Device *device;
+
+    SDL_mutex *lock;
+    SDL_cond *callbackAdded;
+
+    /* Sorted by submission value */
+    FenceCallback *callbacks;
+    Uint32 callbackCount;
+    Uint32 callbackCapacity;
+
+    SDL_Thread *thread;
+    SDL_bool quit;
+} FenceCallbackWaiter;
+
+static int SDLCALL FenceCallbackWaiter_Thread(void *data)
+{
+    FenceCallbackWaiter *waiter = (FenceCallbackWaiter *)data;
+    Refresh_Device *device = waiter->device;
+    Refresh_Fence **fences = NULL;
+    Refresh_Fence **newFences;
+    FenceCallback *signaled = NULL;
+    FenceCallback *newSignaled;
+    Uint32 capacity = 0;
+    Uint32 fenceCount, signaledCount;
+    Uint32 i;
+
+    SDL_LockMutex(waiter->lock);
+    while (1) {
+        while (waiter->callbackCount == 0 && !waiter->quit) {
+            SDL_CondWait(waiter->callbackAdded, waiter->lock);
+        }
+        if (waiter->callbackCount == 0) {
+            break;
+        }
+
+        if (capacity < waiter->callbackCount) {
+            newFences = SDL_realloc(fences, waiter->callbackCapacity * sizeof(Refresh_Fence *));
+            if (newFences != NULL) {
+                fences = newFences;
+            }
+            newSignaled = SDL_realloc(signaled, waiter->callbackCapacity * sizeof(FenceCallback));
+            if (newSignaled != NULL) {
+                signaled = newSignaled;
+            }
+
+            if (newFences != NULL && newSignaled != NULL) {
+                capacity = waiter->callbackCapacity;
+            } else if (capacity == 0) {
+                /* Nothing to wait with yet, try again shortly */
+                SDL_CondWaitTimeout(waiter->callbackAdded, waiter->lock, 1);
+                continue;
+            }
+        }
+
+        /* If the arrays couldn't grow, only the earliest callbacks are waited on this time around */
+        fenceCount = SDL_min(waiter->callbackCount, capacity);
+        for (i = 0; i < fenceCount; i += 1) {
+            fences[i] = waiter->callbacks[i].fence;
+        }
+        SDL_UnlockMutex(waiter->lock);
+
+        /* One wait for every pending callback.
+         * Adding a callback wakes this, so a new fence never waits behind the snapshot.
+         */
+        device->WaitForAnyFenceOrWake(
+            device->driverData,
+            fences,
+            fenceCount);
+
+        SDL_LockMutex(waiter->lock);
+
+        signaledCount = 0;
+        i = 0;
+        while (i < waiter->callbackCount) {
+            if (device->QueryFence(device->driverData, waiter->callbacks[i].fence)) {
+                signaled[signaledCount] = waiter->callbacks[i];
+                signaledCount += 1;
+
+                SDL_memmove(
+                    &waiter->callbacks[i],
+                    &waiter->callbacks[i + 1],
+                    (waiter->callbackCount - i - 1) * sizeof(FenceCallback));
+                waiter->callbackCount -= 1;
+            } else {
+                i += 1;
+            }
+
+            /* Callbacks added after the snapshot may not fit in the signaled array yet */
+            if (signaledCount == capacity) {
+                break;
+            }
+        }
+
+        /* Callbacks may add callbacks or release their fence */
+        SDL_UnlockMutex(waiter->lock);
+        for (i = 0; i < signaledCount; i += 1) {
+            signaled[i].callback(signaled[i].userdata, signaled[i].fence);
+        }
+        SDL_LockMutex(waiter->lock);
+    }
+    SDL_UnlockMutex(waiter->lock);
+
+    SDL_free(fences);
+    SDL_free(signaled);
+
+    return 0;
+}
+
+static FenceCallbackWaiter *FenceCallbackWaiter_Fetch(Refresh_Device *device)
+{
+    FenceCallbackWaiter *waiter;
+
+    SDL_AtomicLock(&device->fenceCallbackWaiterLock);
+
+    waiter = device->fenceCallbackWaiter;
+    if (waiter == NULL) {
+        waiter = SDL_calloc(1, sizeof(FenceCallbackWaiter));
+        if (waiter == NULL) {
+            SDL_AtomicUnlock(&device->fenceCallbackWaiterLock);
+            SDL_OutOfMemory();
+            return NULL;
+        }
+
+        waiter->device = device;
+        waiter->lock = SDL_CreateMutex();
+        waiter->callbackAdded = SDL_CreateCond();
+        waiter->callbackCapacity = 16;
+        waiter->callbackCount = 0;
+        waiter->callbacks = SDL_malloc(waiter->callbackCapacity * sizeof(FenceCallback));
+        waiter->quit = SDL_FALSE;
+
+        if (waiter->lock != NULL && waiter->callbackAdded != NULL && waiter->callbacks != NULL) {
+            waiter->thread = SDL_CreateThread(
+                FenceCallbackWaiter_Thread,
+                "RefreshFenceWaiter",
+                waiter);
+        }
+
+        /* Try again on the next call rather than keeping a half-built waiter */
+        if (waiter->thread == NULL) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create fence callback waiter: %s", SDL_GetError());
+            SDL_free(waiter->callbacks);
+            if (waiter->callbackAdded != NULL) {
+                SDL_DestroyCond(waiter->callbackAdded);
+            }
+            if (waiter->lock != NULL) {
+                SDL_DestroyMutex(waiter->lock);
+            }
+            SDL_free(waiter);
+            SDL_AtomicUnlock(&device->fenceCallbackWaiterLock);
+            return NULL;
+        }
+
+        device->fenceCallbackWaiter = waiter;
+    }
+
+    SDL_AtomicUnlock(&device->fenceCallbackWaiterLock);
+
+    return waiter;
+}
+
+static void FenceCallbackWaiter_Destroy(FenceCallbackWaiter *waiter)
+{
+    SDL_LockMutex(waiter->lock);
+    waiter->quit = SDL_TRUE;
+    SDL_CondSignal(waiter->callbackAdded);
+    SDL_UnlockMutex(waiter->lock);
+
+    /* The waiter drains the pending callbacks before it exits */
+    SDL_WaitThread(waiter->thread, NULL);
+
+    SDL_free(waiter->callbacks);
+    SDL_DestroyCond(waiter->callbackAdded);
+    SDL_DestroyMutex(waiter->lock);
+    SDL_free(waiter);
+}
+
+SDL_bool Refresh_AddFenceCallback(
+    Refresh_Device *device,
+    Refresh_Fence *fence,
+    Refresh_FenceCallback callback,
+    void *userdata)
+{
+    FenceCallbackWaiter *waiter;
+    FenceCallback *callbacks;
+    Uint64 submissionValue;
+    Uint32 index;
+
+    CHECK_DEVICE_MAGIC(device, SDL_FALSE);
+    if (fence == NULL) {
+        SDL_InvalidParamError("fence");
+        return SDL_FALSE;
+    }
+    if (callback == NULL) {
+        SDL_InvalidParamError("callback");
+        return SDL_FALSE;
+    }
+
+    waiter = FenceCallbackWaiter_Fetch(device);
+    if (waiter == NULL) {
+        return SDL_FALSE;
+    }
+
+    submissionValue = device->GetFenceSubmissionValue(
+        device->driverData,
+        fence);
+
+    SDL_LockMutex(waiter->lock);
+
+    if (waiter->callbackCount == waiter->callbackCapacity) {
+        callbacks = SDL_realloc(
+            waiter->callbacks,
+            waiter->callbackCapacity * 2 * sizeof(FenceCallback));
+        if (callbacks == NULL) {
+            SDL_UnlockMutex(waiter->lock);
+            SDL_OutOfMemory();
+            return SDL_FALSE;
+        }
+        waiter->callbacks = callbacks;
+        waiter->callbackCapacity *= 2;
+    }
+
+    /* Fences almost always arrive in submission order, so search from the back */
+    index = waiter->callbackCount;
+    while (index > 0 && waiter->callbacks[index - 1].submissionValue > submissionValue) {
+        index -= 1;
+    }
+
+    SDL_memmove(
+        &waiter->callbacks[index + 1],
+        &waiter->callbacks[index],
+        (waiter->callbackCount - index) * sizeof(FenceCallback));
+
+    waiter->callbacks[index].fence = fence;
+    waiter->callbacks[index].submissionValue = submissionValue;
+    waiter->callbacks[index].callback = callback;
+    waiter->callbacks[index].userdata = userdata;
+    waiter->callbackCount += 1;
+
+    SDL_CondSignal(waiter->callbackAdded);
+    SDL_UnlockMutex(waiter->lock);
+
+    /* The waiter may be blocked on fences that signal after this one */
+    device->WakeFenceWait(device->driverData);
+
+    return SDL_TRUE;
+}
+
+/* Instrumentation */
+
+#ifdef REFRESH_INSTRUMENTATION
+
+static SDL_bool Instrumentation_WriteTrace(
+    const char *filename,
+    InstrumentationEvent *events,
+    Uint32 eventCount,
+    Uint64 traceStartTicks)
+{
+    SDL_RWops *file;
+    InstrumentationEvent *event;
+    char line[256];
+    Uint64 startNanoseconds;
+    Uint64 durationNanoseconds;
+    size_t length;
+    SDL_bool success = SDL_TRUE;
+    Uint32 i;
+
+    file = SDL_RWFromFile(filename, "wb");
+    if (file == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open trace file %s: %s", filename, SDL_GetError());
+        return SDL_FALSE;
+    }
+
+    length = SDL_strlen("{\"traceEvents\":[\n");
+    success = SDL_RWwrite(file, "{\"traceEvents\":[\n", 1, length) == length;
+
+    for (i = 0; success && i < eventCount; i += 1) {
+        event = &events[i];
+
+        /* Events can start before the trace did if their call straddled Begin */
+        startNanoseconds = event->startTicks > traceStartTicks ? Instrumentation_TicksToNanoseconds(event->startTicks - traceStartTicks) : 0;
+        durationNanoseconds = Instrumentation_TicksToNanoseconds(event->durationTicks);
+
+        /* Chrome traces are in microseconds, print the fraction without going through floats */
+        SDL_snprintf(
+            line,
+            sizeof(line),
+            "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%lu,\"ts\":%" SDL_PRIu64 ".%03u,\"dur\":%" SDL_PRIu64 ".%03u}\n",
+            i == 0 ? "" : ",",
+            event->counter->name,
+            event->threadID,
+            startNanoseconds / 1000,
+            (Uint32)(startNanoseconds % 1000),
+            durationNanoseconds / 1000,
+            (Uint32)(durationNanoseconds % 1000));
+
+        length = SDL_strlen(line);
+        success = SDL_RWwrite(file, line, 1, length) == length;
+    }
+
+    if (success) {
+        length = SDL_strlen("]}\n");
+        success = SDL_RWwrite(file, "]}\n", 1, length) == length;
+    }
+
+    if (!success) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to write trace file %s: %s", filename, SDL_GetError());
+    }
+
+    SDL_RWclose(file);
+    return success;
+}
+
+#endif /* REFRESH_INSTRUMENTATION */
+
+Uint32 Refresh_GetInstrumentationEntries(
+    Refresh_InstrumentationEntry *pEntries,
+    Uint32 entryCount)
+{
+#ifdef REFRESH_INSTRUMENTATION
+    InstrumentationCounter *counter;
+    Uint32 counterCount;
+    Uint32 i = 0;
+
+    SDL_AtomicLock(&instrumentation.lock);
+
+    counterCount = instrumentation.counterCount;
+
+    if (pEntries != NULL) {
+        for (counter = instrumentation.counters; counter != NULL && i < entryCount; counter = counter->next) {
+            SDL_AtomicLock(&counter->lock);
+            pEntries[i].name = counter->name;
+            pEntries[i].callCount = counter->callCount;
+            pEntries[i].totalNanoseconds = Instrumentation_TicksToNanoseconds(counter->totalTicks);
+            pEntries[i].maxNanoseconds = Instrumentation_TicksToNanoseconds(counter->maxTicks);
+            SDL_AtomicUnlock(&counter->lock);
+            i += 1;
+        }
+    }
+
+    SDL_AtomicUnlock(&instrumentation.lock);
+
+    return counterCount;
+#else
+    (void)pEntries;
+    (void)entryCount;
+    return 0;
+#endif /* REFRESH_INSTRUMENTATION */
+}
+
+void Refresh_ResetInstrumentation(void)
+{
+#ifdef REFRESH_INSTRUMENTATION
+    InstrumentationCounter *counter;
+
+    SDL_AtomicLock(&instrumentation.lock);
+
+    for (counter = instrumentation.counters; counter != NULL; counter = counter->next) {
+        SDL_AtomicLock(&counter->lock);
+        counter->callCount = 0;
+        counter->totalTicks = 0;
+        counter->maxTicks = 0;
+        SDL_AtomicUnlock(&counter->lock);
+    }
+
+    SDL_AtomicUnlock(&instrumentation.lock);
+#endif /* REFRESH_INSTRUMENTATION */
+}
+
+SDL_bool Refresh_BeginInstrumentationTrace(
+    Uint32 maxEventCount)
+{
+#ifdef REFRESH_INSTRUMENTATION
+    InstrumentationEvent *events;
+
+    if (maxEventCount == 0) {
+        SDL_InvalidParamError("maxEventCount");
+        return SDL_FALSE;
+    }
+
+    events = SDL_malloc(maxEventCount * sizeof(InstrumentationEvent));
+    if (events == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate instrumentation trace!");
+        return SDL_FALSE;
+    }
+
+    SDL_AtomicLock(&instrumentation.lock);
+
+    if (SDL_AtomicGet(&instrumentation.tracing)) {
+        SDL_AtomicUnlock(&instrumentation.lock);
+        SDL_free(events);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Instrumentation trace already in progress!");
+        return SDL_FALSE;
+    }
+
+    instrumentation.events = events;
+    instrumentation.eventCount = 0;
+    instrumentation.eventCapacity = maxEventCount;
+    instrumentation.droppedEventCount = 0;
+    instrumentation.traceStartTicks = SDL_GetPerformanceCounter();
+    SDL_AtomicSet(&instrumentation.tracing, 1);
+
+    SDL_AtomicUnlock(&instrumentation.lock);
+
+    return SDL_TRUE;
+#else
+    (void)maxEventCount;
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Refresh was built without REFRESH_INSTRUMENTATION!");
+    return SDL_FALSE;
+#endif /* REFRESH_INSTRUMENTATION */
+}
+
+SDL_bool Refresh_EndInstrumentationTrace(
+    const char *filename)
+{
+#ifdef REFRESH_INSTRUMENTATION
+    InstrumentationEvent *events;
+    Uint32 eventCount;
+    Uint32 droppedEventCount;
+    Uint64 traceStartTicks;
+    SDL_bool success = SDL_TRUE;
+
+    SDL_AtomicLock(&instrumentation.lock);
+
+    if (!SDL_AtomicGet(&instrumentation.tracing)) {
+        SDL_AtomicUnlock(&instrumentation.lock);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No instrumentation trace in progress!");
+        return SDL_FALSE;
+    }
+
+    /* Take the events so the file is written without blocking instrumented calls */
+    events = instrumentation.events;
+    eventCount = instrumentation.eventCount;
+    droppedEventCount = instrumentation.droppedEventCount;
+    traceStartTicks = instrumentation.traceStartTicks;
+
+    instrumentation.events = NULL;
+    instrumentation.eventCount = 0;
+    instrumentation.eventCapacity = 0;
+    instrumentation.droppedEventCount = 0;
+    SDL_AtomicSet(&instrumentation.tracing, 0);
+
+    SDL_AtomicUnlock(&instrumentation.lock);
+
+    if (droppedEventCount > 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Instrumentation trace dropped %u events, increase maxEventCount!", droppedEventCount);
+    }
+
+    if (filename != NULL) {
+        success = Instrumentation_WriteTrace(filename, events, eventCount, traceStartTicks);
+    }
+
+    SDL_free(events);
+    return success;
+#else
+    (void)filename;
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Refresh was built without REFRESH_INSTRUMENTATION!");
+    return SDL_FALSE;
+#endif /* REFRESH_INSTRUMENTATION */
 }
@@ -46,8 +46,81 @@ typedef struct CommandBufferCommonHeader
     SDL_bool computePipelineBound;
     Pass copyPass;
     SDL_bool submitted;
+    Refresh_QueueType queueType;
+
+    /* Parallel render pass state */
+    SDL_bool parallelRenderPass;
+    SDL_atomic_t renderPassChunksInProgress;
+    Refresh_CommandBuffer *parentCommandBuffer; /* Only set on render pass chunks */
 } CommandBufferCommonHeader;
 
+/* Command Bundles, recorded and validated in Refresh.c and replayed by the backends */
+
+typedef enum CommandBundleCommandType
+{
+    COMMAND_BUNDLE_BIND_GRAPHICS_PIPELINE,
+    COMMAND_BUNDLE_BIND_VERTEX_BUFFERS,
+    COMMAND_BUNDLE_BIND_INDEX_BUFFER,
+    COMMAND_BUNDLE_BIND_FRAGMENT_SAMPLERS,
+    COMMAND_BUNDLE_DRAW_INDEXED_PRIMITIVES,
+    COMMAND_BUNDLE_DRAW_PRIMITIVES
+} CommandBundleCommandType;
+
+typedef struct CommandBundleCommand
+{
+    CommandBundleCommandType type;
+    union
+    {
+        Refresh_GraphicsPipeline *graphicsPipeline;
+
+        struct
+        {
+            Uint32 firstSlot;
+            Uint32 bindingOffset; /* Into the bundle's binding array */
+            Uint32 bindingCount;
+        } bindings;
+
+        struct
+        {
+            Refresh_BufferBinding binding;
+            Refresh_IndexElementSize indexElementSize;
+        } indexBuffer;
+
+        struct
+        {
+            Uint32 baseVertex;
+            Uint32 startIndex;
+            Uint32 primitiveCount;
+            Uint32 instanceCount;
+        } drawIndexed;
+
+        struct
+        {
+            Uint32 vertexStart;
+            Uint32 primitiveCount;
+        } draw;
+    } data;
+} CommandBundleCommand;
+
+typedef struct CommandBundle
+{
+    Refresh_Device *device;
+
+    CommandBundleCommand *commands;
+    Uint32 commandCount;
+    Uint32 commandCapacity;
+
+    Refresh_BufferBinding *bufferBindings;
+    Uint32 bufferBindingCount;
+    Uint32 bufferBindingCapacity;
+
+    Refresh_TextureSamplerBinding *samplerBindings;
+    Uint32 samplerBindingCount;
+    Uint32 samplerBindingCapacity;
+
+    SDL_bool graphicsPipelineBound;
+} CommandBundle;
+
 /* Internal Helper Utilities */
 
 static inline Sint32 Texture_GetBlockSize(
@@ -194,7 +267,9 @@ static inline Sint32 BytesPerImage(
 #define MAX_STORAGE_TEXTURES_PER_STAGE 8
 #define MAX_STORAGE_BUFFERS_PER_STAGE  8
 #define MAX_UNIFORM_BUFFERS_PER_STAGE  4
-#define UNIFORM_BUFFER_SIZE            32768
+#define UNIFORM_BUFFER_SIZE            131072 /* shared by every stage and slot of a command buffer */
+#define STAGING_BLOCK_SIZE             4194304 /* sub-allocated by Refresh_AcquireStagingMemory */
+#define STAGING_BLOCK_ALIGNMENT        16
 #define MAX_BUFFER_BINDINGS            16
 #define MAX_COLOR_TARGET_BINDINGS      4
 #define MAX_PRESENT_COUNT              16
@@ -400,9 +475,50 @@ struct Refresh_Device
         Uint32 drawCount,
         Uint32 stride);
 
+    SDL_bool (*SupportsIndirectCount)(
+        Refresh_Renderer *driverData);
+
+    void (*DrawPrimitivesIndirectCount)(
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_Buffer *buffer,
+        Uint32 offsetInBytes,
+        Refresh_Buffer *countBuffer,
+        Uint32 countOffsetInBytes,
+        Uint32 maxDrawCount,
+        Uint32 stride);
+
+    void (*DrawIndexedPrimitivesIndirectCount)(
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_Buffer *buffer,
+        Uint32 offsetInBytes,
+        Refresh_Buffer *countBuffer,
+        Uint32 countOffsetInBytes,
+        Uint32 maxDrawCount,
+        Uint32 stride);
+
     void (*EndRenderPass)(
         Refresh_CommandBuffer *commandBuffer);
 
+    /* Parallel Render Pass */
+
+    void (*BeginParallelRenderPass)(
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_ColorAttachmentInfo *colorAttachmentInfos,
+        Uint32 colorAttachmentCount,
+        Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo);
+
+    Refresh_CommandBuffer *(*AcquireRenderPassChunk)(
+        Refresh_CommandBuffer *commandBuffer);
+
+    void (*EndRenderPassChunk)(
+        Refresh_CommandBuffer *chunk);
+
+    /* Command Bundles */
+
+    void (*ExecuteCommandBundle)(
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_CommandBundle *commandBundle);
+
     /* Compute Pass */
 
     void (*BeginComputePass)(
@@ -483,6 +599,11 @@ struct Refresh_Device
         Refresh_BufferRegion *destination,
         SDL_bool cycle);
 
+    void *(*AcquireStagingMemory)(
+        Refresh_CommandBuffer *commandBuffer,
+        Uint32 sizeInBytes,
+        Refresh_TransferBufferLocation *location);
+
     void (*CopyTextureToTexture)(
         Refresh_CommandBuffer *commandBuffer,
         Refresh_TextureLocation *source,
@@ -499,9 +620,31 @@ struct Refresh_Device
         Uint32 size,
         SDL_bool cycle);
 
+    void (*UploadToTextureRegions)(
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_TextureTransferInfo *sources,
+        Refresh_TextureRegion *destinations,
+        Uint32 regionCount,
+        SDL_bool cycle);
+
+    void (*UploadToBufferRegions)(
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_TransferBufferLocation *sources,
+        Refresh_BufferRegion *destinations,
+        Uint32 regionCount,
+        SDL_bool cycle);
+
+    void (*CopyBufferToBufferRegions)(
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_BufferLocation *sources,
+        Refresh_BufferRegion *destinations,
+        Uint32 regionCount,
+        SDL_bool cycle);
+
     void (*GenerateMipmaps)(
         Refresh_CommandBuffer *commandBuffer,
-        Refresh_Texture *texture);
+        Refresh_Texture *texture,
+        Refresh_Filter filterMode);
 
     void (*DownloadFromTexture)(
         Refresh_CommandBuffer *commandBuffer,
@@ -551,12 +694,22 @@ struct Refresh_Device
         Refresh_SwapchainComposition swapchainComposition,
         Refresh_PresentMode presentMode);
 
+    SDL_bool (*SetAllowedFramesInFlight)(
+        Refresh_Renderer *driverData,
+        SDL_Window *window,
+        Uint32 allowedFramesInFlight);
+
+    SDL_bool (*WaitForSwapchain)(
+        Refresh_Renderer *driverData,
+        SDL_Window *window);
+
     Refresh_TextureFormat (*GetSwapchainTextureFormat)(
         Refresh_Renderer *driverData,
         SDL_Window *window);
 
     Refresh_CommandBuffer *(*AcquireCommandBuffer)(
-        Refresh_Renderer *driverData);
+        Refresh_Renderer *driverData,
+        Refresh_QueueType queueType);
 
     Refresh_Texture *(*AcquireSwapchainTexture)(
         Refresh_CommandBuffer *commandBuffer,
@@ -587,6 +740,21 @@ struct Refresh_Device
         Refresh_Renderer *driverData,
         Refresh_Fence *fence);
 
+    Uint64 (*GetFenceSubmissionValue)(
+        Refresh_Renderer *driverData,
+        Refresh_Fence *fence);
+
+    /* Blocks until any fence signals or WakeFenceWait has been called since the last return.
+     * Only the fence callback waiter calls this, so a device never has more than one waiter.
+     */
+    void (*WaitForAnyFenceOrWake)(
+        Refresh_Renderer *driverData,
+        Refresh_Fence **pFences,
+        Uint32 fenceCount);
+
+    void (*WakeFenceWait)(
+        Refresh_Renderer *driverData);
+
     /* Feature Queries */
 
     SDL_bool (*IsTextureFormatSupported)(
@@ -600,92 +768,272 @@ struct Refresh_Device
         Refresh_TextureFormat format,
         Refresh_SampleCount desiredSampleCount);
 
+    /* Pipeline Cache */
+
+    SDL_bool (*LoadPipelineCacheData)(
+        Refresh_Renderer *driverData,
+        const void *data,
+        size_t dataSize);
+
+    SDL_bool (*GetPipelineCacheData)(
+        Refresh_Renderer *driverData,
+        void *data,
+        size_t *pDataSize);
+
+    /* Shader Cache */
+
+    SDL_bool (*CompileShaderBinary)(
+        Refresh_Renderer *driverData,
+        Refresh_ShaderStage stage,
+        SDL_bool isCompute,
+        Refresh_ShaderFormat format,
+        const Uint8 *code,
+        size_t codeSize,
+        const char *entryPointName,
+        Refresh_ShaderFormat *pBinaryFormat,
+        void **pBinary,
+        size_t *pBinarySize);
+
+    /* Timestamp Queries */
+
+    Refresh_QueryPool *(*CreateTimestampQueryPool)(
+        Refresh_Renderer *driverData,
+        Uint32 queryCount);
+
+    void (*ReleaseQueryPool)(
+        Refresh_Renderer *driverData,
+        Refresh_QueryPool *queryPool);
+
+    void (*ResetQueryPool)(
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_QueryPool *queryPool);
+
+    void (*WriteTimestamp)(
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_QueryPool *queryPool,
+        Uint32 queryIndex);
+
+    SDL_bool (*GetTimestampResults)(
+        Refresh_Renderer *driverData,
+        Refresh_QueryPool *queryPool,
+        Uint32 firstQuery,
+        Uint32 queryCount,
+        Uint64 *results);
+
+    /* Bindless Resources */
+
+    SDL_bool (*SupportsBindless)(
+        Refresh_Renderer *driverData);
+
+    SDL_bool (*RegisterBindlessTexture)(
+        Refresh_Renderer *driverData,
+        Refresh_Texture *texture,
+        Uint32 *pIndex);
+
+    SDL_bool (*RegisterBindlessSampler)(
+        Refresh_Renderer *driverData,
+        Refresh_Sampler *sampler,
+        Uint32 *pIndex);
+
+    SDL_bool (*RegisterBindlessStorageBuffer)(
+        Refresh_Renderer *driverData,
+        Refresh_Buffer *buffer,
+        Uint32 *pIndex);
+
+    void (*UnregisterBindlessResource)(
+        Refresh_Renderer *driverData,
+        Refresh_BindlessResourceType resourceType,
+        Uint32 index);
+
+    /* Resource Cycling */
+
+    void (*SetBufferCycleLimit)(
+        Refresh_Renderer *driverData,
+        Refresh_Buffer *buffer,
+        Uint32 maxCycleCount);
+
+    void (*SetTransferBufferCycleLimit)(
+        Refresh_Renderer *driverData,
+        Refresh_TransferBuffer *transferBuffer,
+        Uint32 maxCycleCount);
+
+    void (*SetTextureCycleLimit)(
+        Refresh_Renderer *driverData,
+        Refresh_Texture *texture,
+        Uint32 maxCycleCount);
+
+    Uint32 (*GetBufferCycleCount)(
+        Refresh_Renderer *driverData,
+        Refresh_Buffer *buffer);
+
+    Uint32 (*GetTransferBufferCycleCount)(
+        Refresh_Renderer *driverData,
+        Refresh_TransferBuffer *transferBuffer);
+
+    Uint32 (*GetTextureCycleCount)(
+        Refresh_Renderer *driverData,
+        Refresh_Texture *texture);
+
+    void (*SetCycleTrimFrames)(
+        Refresh_Renderer *driverData,
+        Uint32 frameCount);
+
+    /* Defragmentation */
+
+    void (*SetDefragmentationSettings)(
+        Refresh_Renderer *driverData,
+        Refresh_DefragmentationSettings *settings);
+
+    void (*RequestDefragmentation)(
+        Refresh_Renderer *driverData);
+
+    /* Statistics */
+
+    void (*GetDeviceStatistics)(
+        Refresh_Renderer *driverData,
+        Refresh_DeviceStatistics *statistics);
+
+    void (*GetMemoryStatistics)(
+        Refresh_Renderer *driverData,
+        Refresh_MemoryStatistics *statistics);
+
     /* Opaque pointer for the Driver */
     Refresh_Renderer *driverData;
 
     /* Store this for Refresh_GetBackend() */
     Refresh_Backend backend;
+
+    /* SPIR-V translation cache, NULL on backends that consume SPIR-V directly */
+    struct ShaderCache *shaderCache;
+
+    /* Worker threads for async compilation, created on first use by Refresh.c */
+    struct CompileWorkerPool *compileWorkerPool;
+    SDL_SpinLock compileWorkerPoolLock;
+
+    /* Fence callback thread, created on first use by Refresh.c */
+    struct FenceCallbackWaiter *fenceCallbackWaiter;
+    SDL_SpinLock fenceCallbackWaiterLock;
 };
 
 #define ASSIGN_DRIVER_FUNC(func, name) \
     result->func = name##_##func;
-#define ASSIGN_DRIVER(name)                                 \
-    ASSIGN_DRIVER_FUNC(DestroyDevice, name)                 \
-    ASSIGN_DRIVER_FUNC(CreateComputePipeline, name)         \
-    ASSIGN_DRIVER_FUNC(CreateGraphicsPipeline, name)        \
-    ASSIGN_DRIVER_FUNC(CreateSampler, name)                 \
-    ASSIGN_DRIVER_FUNC(CreateShader, name)                  \
-    ASSIGN_DRIVER_FUNC(CreateTexture, name)                 \
-    ASSIGN_DRIVER_FUNC(CreateBuffer, name)                  \
-    ASSIGN_DRIVER_FUNC(CreateTransferBuffer, name)          \
-    ASSIGN_DRIVER_FUNC(SetBufferName, name)                 \
-    ASSIGN_DRIVER_FUNC(SetTextureName, name)                \
-    ASSIGN_DRIVER_FUNC(InsertDebugLabel, name)              \
-    ASSIGN_DRIVER_FUNC(PushDebugGroup, name)                \
-    ASSIGN_DRIVER_FUNC(PopDebugGroup, name)                 \
-    ASSIGN_DRIVER_FUNC(ReleaseTexture, name)                \
-    ASSIGN_DRIVER_FUNC(ReleaseSampler, name)                \
-    ASSIGN_DRIVER_FUNC(ReleaseBuffer, name)                 \
-    ASSIGN_DRIVER_FUNC(ReleaseTransferBuffer, name)         \
-    ASSIGN_DRIVER_FUNC(ReleaseShader, name)                 \
-    ASSIGN_DRIVER_FUNC(ReleaseComputePipeline, name)        \
-    ASSIGN_DRIVER_FUNC(ReleaseGraphicsPipeline, name)       \
-    ASSIGN_DRIVER_FUNC(BeginRenderPass, name)               \
-    ASSIGN_DRIVER_FUNC(BindGraphicsPipeline, name)          \
-    ASSIGN_DRIVER_FUNC(SetViewport, name)                   \
-    ASSIGN_DRIVER_FUNC(SetScissor, name)                    \
-    ASSIGN_DRIVER_FUNC(BindVertexBuffers, name)             \
-    ASSIGN_DRIVER_FUNC(BindIndexBuffer, name)               \
-    ASSIGN_DRIVER_FUNC(BindVertexSamplers, name)            \
-    ASSIGN_DRIVER_FUNC(BindVertexStorageTextures, name)     \
-    ASSIGN_DRIVER_FUNC(BindVertexStorageBuffers, name)      \
-    ASSIGN_DRIVER_FUNC(BindFragmentSamplers, name)          \
-    ASSIGN_DRIVER_FUNC(BindFragmentStorageTextures, name)   \
-    ASSIGN_DRIVER_FUNC(BindFragmentStorageBuffers, name)    \
-    ASSIGN_DRIVER_FUNC(PushVertexUniformData, name)         \
-    ASSIGN_DRIVER_FUNC(PushFragmentUniformData, name)       \
-    ASSIGN_DRIVER_FUNC(DrawIndexedPrimitives, name)         \
-    ASSIGN_DRIVER_FUNC(DrawPrimitives, name)                \
-    ASSIGN_DRIVER_FUNC(DrawPrimitivesIndirect, name)        \
-    ASSIGN_DRIVER_FUNC(DrawIndexedPrimitivesIndirect, name) \
-    ASSIGN_DRIVER_FUNC(EndRenderPass, name)                 \
-    ASSIGN_DRIVER_FUNC(BeginComputePass, name)              \
-    ASSIGN_DRIVER_FUNC(BindComputePipeline, name)           \
-    ASSIGN_DRIVER_FUNC(BindComputeStorageTextures, name)    \
-    ASSIGN_DRIVER_FUNC(BindComputeStorageBuffers, name)     \
-    ASSIGN_DRIVER_FUNC(PushComputeUniformData, name)        \
-    ASSIGN_DRIVER_FUNC(DispatchCompute, name)               \
-    ASSIGN_DRIVER_FUNC(EndComputePass, name)                \
-    ASSIGN_DRIVER_FUNC(MapTransferBuffer, name)             \
-    ASSIGN_DRIVER_FUNC(UnmapTransferBuffer, name)           \
-    ASSIGN_DRIVER_FUNC(SetTransferData, name)               \
-    ASSIGN_DRIVER_FUNC(GetTransferData, name)               \
-    ASSIGN_DRIVER_FUNC(BeginCopyPass, name)                 \
-    ASSIGN_DRIVER_FUNC(UploadToTexture, name)               \
-    ASSIGN_DRIVER_FUNC(UploadToBuffer, name)                \
-    ASSIGN_DRIVER_FUNC(DownloadFromTexture, name)           \
-    ASSIGN_DRIVER_FUNC(DownloadFromBuffer, name)            \
-    ASSIGN_DRIVER_FUNC(CopyTextureToTexture, name)          \
-    ASSIGN_DRIVER_FUNC(CopyBufferToBuffer, name)            \
-    ASSIGN_DRIVER_FUNC(GenerateMipmaps, name)               \
-    ASSIGN_DRIVER_FUNC(EndCopyPass, name)                   \
-    ASSIGN_DRIVER_FUNC(Blit, name)                          \
-    ASSIGN_DRIVER_FUNC(SupportsSwapchainComposition, name)  \
-    ASSIGN_DRIVER_FUNC(SupportsPresentMode, name)           \
-    ASSIGN_DRIVER_FUNC(ClaimWindow, name)                   \
-    ASSIGN_DRIVER_FUNC(UnclaimWindow, name)                 \
-    ASSIGN_DRIVER_FUNC(SetSwapchainParameters, name)        \
-    ASSIGN_DRIVER_FUNC(GetSwapchainTextureFormat, name)     \
-    ASSIGN_DRIVER_FUNC(AcquireCommandBuffer, name)          \
-    ASSIGN_DRIVER_FUNC(AcquireSwapchainTexture, name)       \
-    ASSIGN_DRIVER_FUNC(Submit, name)                        \
-    ASSIGN_DRIVER_FUNC(SubmitAndAcquireFence, name)         \
-    ASSIGN_DRIVER_FUNC(Wait, name)                          \
-    ASSIGN_DRIVER_FUNC(WaitForFences, name)                 \
-    ASSIGN_DRIVER_FUNC(QueryFence, name)                    \
-    ASSIGN_DRIVER_FUNC(ReleaseFence, name)                  \
-    ASSIGN_DRIVER_FUNC(IsTextureFormatSupported, name)      \
-    ASSIGN_DRIVER_FUNC(GetBestSampleCount, name)
+#define ASSIGN_DRIVER(name)                                      \
+    ASSIGN_DRIVER_FUNC(DestroyDevice, name)                      \
+    ASSIGN_DRIVER_FUNC(CreateComputePipeline, name)              \
+    ASSIGN_DRIVER_FUNC(CreateGraphicsPipeline, name)             \
+    ASSIGN_DRIVER_FUNC(CreateSampler, name)                      \
+    ASSIGN_DRIVER_FUNC(CreateShader, name)                       \
+    ASSIGN_DRIVER_FUNC(CreateTexture, name)                      \
+    ASSIGN_DRIVER_FUNC(CreateBuffer, name)                       \
+    ASSIGN_DRIVER_FUNC(CreateTransferBuffer, name)               \
+    ASSIGN_DRIVER_FUNC(SetBufferName, name)                      \
+    ASSIGN_DRIVER_FUNC(SetTextureName, name)                     \
+    ASSIGN_DRIVER_FUNC(InsertDebugLabel, name)                   \
+    ASSIGN_DRIVER_FUNC(PushDebugGroup, name)                     \
+    ASSIGN_DRIVER_FUNC(PopDebugGroup, name)                      \
+    ASSIGN_DRIVER_FUNC(ReleaseTexture, name)                     \
+    ASSIGN_DRIVER_FUNC(ReleaseSampler, name)                     \
+    ASSIGN_DRIVER_FUNC(ReleaseBuffer, name)                      \
+    ASSIGN_DRIVER_FUNC(ReleaseTransferBuffer, name)              \
+    ASSIGN_DRIVER_FUNC(ReleaseShader, name)                      \
+    ASSIGN_DRIVER_FUNC(ReleaseComputePipeline, name)             \
+    ASSIGN_DRIVER_FUNC(ReleaseGraphicsPipeline, name)            \
+    ASSIGN_DRIVER_FUNC(BeginRenderPass, name)                    \
+    ASSIGN_DRIVER_FUNC(BindGraphicsPipeline, name)               \
+    ASSIGN_DRIVER_FUNC(SetViewport, name)                        \
+    ASSIGN_DRIVER_FUNC(SetScissor, name)                         \
+    ASSIGN_DRIVER_FUNC(BindVertexBuffers, name)                  \
+    ASSIGN_DRIVER_FUNC(BindIndexBuffer, name)                    \
+    ASSIGN_DRIVER_FUNC(BindVertexSamplers, name)                 \
+    ASSIGN_DRIVER_FUNC(BindVertexStorageTextures, name)          \
+    ASSIGN_DRIVER_FUNC(BindVertexStorageBuffers, name)           \
+    ASSIGN_DRIVER_FUNC(BindFragmentSamplers, name)               \
+    ASSIGN_DRIVER_FUNC(BindFragmentStorageTextures, name)        \
+    ASSIGN_DRIVER_FUNC(BindFragmentStorageBuffers, name)         \
+    ASSIGN_DRIVER_FUNC(PushVertexUniformData, name)              \
+    ASSIGN_DRIVER_FUNC(PushFragmentUniformData, name)            \
+    ASSIGN_DRIVER_FUNC(DrawIndexedPrimitives, name)              \
+    ASSIGN_DRIVER_FUNC(DrawPrimitives, name)                     \
+    ASSIGN_DRIVER_FUNC(DrawPrimitivesIndirect, name)             \
+    ASSIGN_DRIVER_FUNC(DrawIndexedPrimitivesIndirect, name)      \
+    ASSIGN_DRIVER_FUNC(SupportsIndirectCount, name)              \
+    ASSIGN_DRIVER_FUNC(DrawPrimitivesIndirectCount, name)        \
+    ASSIGN_DRIVER_FUNC(DrawIndexedPrimitivesIndirectCount, name) \
+    ASSIGN_DRIVER_FUNC(EndRenderPass, name)                      \
+    ASSIGN_DRIVER_FUNC(BeginParallelRenderPass, name)            \
+    ASSIGN_DRIVER_FUNC(AcquireRenderPassChunk, name)             \
+    ASSIGN_DRIVER_FUNC(EndRenderPassChunk, name)                 \
+    ASSIGN_DRIVER_FUNC(ExecuteCommandBundle, name)               \
+    ASSIGN_DRIVER_FUNC(BeginComputePass, name)                   \
+    ASSIGN_DRIVER_FUNC(BindComputePipeline, name)                \
+    ASSIGN_DRIVER_FUNC(BindComputeStorageTextures, name)         \
+    ASSIGN_DRIVER_FUNC(BindComputeStorageBuffers, name)          \
+    ASSIGN_DRIVER_FUNC(PushComputeUniformData, name)             \
+    ASSIGN_DRIVER_FUNC(DispatchCompute, name)                    \
+    ASSIGN_DRIVER_FUNC(EndComputePass, name)                     \
+    ASSIGN_DRIVER_FUNC(MapTransferBuffer, name)                  \
+    ASSIGN_DRIVER_FUNC(UnmapTransferBuffer, name)                \
+    ASSIGN_DRIVER_FUNC(SetTransferData, name)                    \
+    ASSIGN_DRIVER_FUNC(GetTransferData, name)                    \
+    ASSIGN_DRIVER_FUNC(BeginCopyPass, name)                      \
+    ASSIGN_DRIVER_FUNC(UploadToTexture, name)                    \
+    ASSIGN_DRIVER_FUNC(UploadToBuffer, name)                     \
+    ASSIGN_DRIVER_FUNC(AcquireStagingMemory, name)               \
+    ASSIGN_DRIVER_FUNC(DownloadFromTexture, name)                \
+    ASSIGN_DRIVER_FUNC(DownloadFromBuffer, name)                 \
+    ASSIGN_DRIVER_FUNC(CopyTextureToTexture, name)               \
+    ASSIGN_DRIVER_FUNC(CopyBufferToBuffer, name)                 \
+    ASSIGN_DRIVER_FUNC(UploadToTextureRegions, name)             \
+    ASSIGN_DRIVER_FUNC(UploadToBufferRegions, name)              \
+    ASSIGN_DRIVER_FUNC(CopyBufferToBufferRegions, name)          \
+    ASSIGN_DRIVER_FUNC(GenerateMipmaps, name)                    \
+    ASSIGN_DRIVER_FUNC(EndCopyPass, name)                        \
+    ASSIGN_DRIVER_FUNC(Blit, name)                               \
+    ASSIGN_DRIVER_FUNC(SupportsSwapchainComposition, name)       \
+    ASSIGN_DRIVER_FUNC(SupportsPresentMode, name)                \
+    ASSIGN_DRIVER_FUNC(ClaimWindow, name)                        \
+    ASSIGN_DRIVER_FUNC(UnclaimWindow, name)                      \
+    ASSIGN_DRIVER_FUNC(SetSwapchainParameters, name)             \
+    ASSIGN_DRIVER_FUNC(SetAllowedFramesInFlight, name)           \
+    ASSIGN_DRIVER_FUNC(WaitForSwapchain, name)                   \
+    ASSIGN_DRIVER_FUNC(GetSwapchainTextureFormat, name)          \
+    ASSIGN_DRIVER_FUNC(AcquireCommandBuffer, name)               \
+    ASSIGN_DRIVER_FUNC(AcquireSwapchainTexture, name)            \
+    ASSIGN_DRIVER_FUNC(Submit, name)                             \
+    ASSIGN_DRIVER_FUNC(SubmitAndAcquireFence, name)              \
+    ASSIGN_DRIVER_FUNC(Wait, name)                               \
+    ASSIGN_DRIVER_FUNC(WaitForFences, name)                      \
+    ASSIGN_DRIVER_FUNC(QueryFence, name)                         \
+    ASSIGN_DRIVER_FUNC(ReleaseFence, name)                       \
+    ASSIGN_DRIVER_FUNC(GetFenceSubmissionValue, name)            \
+    ASSIGN_DRIVER_FUNC(WaitForAnyFenceOrWake, name)              \
+    ASSIGN_DRIVER_FUNC(WakeFenceWait, name)                      \
+    ASSIGN_DRIVER_FUNC(IsTextureFormatSupported, name)           \
+    ASSIGN_DRIVER_FUNC(GetBestSampleCount, name)                 \
+    ASSIGN_DRIVER_FUNC(LoadPipelineCacheData, name)              \
+    ASSIGN_DRIVER_FUNC(GetPipelineCacheData, name)               \
+    ASSIGN_DRIVER_FUNC(CompileShaderBinary, name)                \
+    ASSIGN_DRIVER_FUNC(CreateTimestampQueryPool, name)           \
+    ASSIGN_DRIVER_FUNC(ReleaseQueryPool, name)                   \
+    ASSIGN_DRIVER_FUNC(ResetQueryPool, name)                     \
+    ASSIGN_DRIVER_FUNC(WriteTimestamp, name)                     \
+    ASSIGN_DRIVER_FUNC(GetTimestampResults, name)                \
+    ASSIGN_DRIVER_FUNC(SupportsBindless, name)                   \
+    ASSIGN_DRIVER_FUNC(RegisterBindlessTexture, name)            \
+    ASSIGN_DRIVER_FUNC(RegisterBindlessSampler, name)            \
+    ASSIGN_DRIVER_FUNC(RegisterBindlessStorageBuffer, name)      \
+    ASSIGN_DRIVER_FUNC(UnregisterBindlessResource, name)         \
+    ASSIGN_DRIVER_FUNC(SetBufferCycleLimit, name)                \
+    ASSIGN_DRIVER_FUNC(SetTransferBufferCycleLimit, name)        \
+    ASSIGN_DRIVER_FUNC(SetTextureCycleLimit, name)               \
+    ASSIGN_DRIVER_FUNC(GetBufferCycleCount, name)                \
+    ASSIGN_DRIVER_FUNC(GetTransferBufferCycleCount, name)        \
+    ASSIGN_DRIVER_FUNC(GetTextureCycleCount, name)               \
+    ASSIGN_DRIVER_FUNC(SetCycleTrimFrames, name)                 \
+    ASSIGN_DRIVER_FUNC(SetDefragmentationSettings, name)         \
+    ASSIGN_DRIVER_FUNC(RequestDefragmentation, name)             \
+    ASSIGN_DRIVER_FUNC(GetDeviceStatistics, name)                \
+    ASSIGN_DRIVER_FUNC(GetMemoryStatistics, name)
 
 typedef struct Refresh_Driver
 {
@@ -142,9 +142,17 @@ SDL_SIMDRealloc(void *mem, const size_t len)
 #define STB_IMAGE_IMPLEMENTATION
 #ifdef __MINGW32__
 #define STBI_NO_THREAD_LOCALS /* FIXME: Port to SDL_TLS -flibit */
+/* Without thread locals the failure reason is one global that concurrent decodes would race on */
+#define STBI_NO_FAILURE_STRINGS
 #endif
 #include "stb_image.h"
 
+#ifdef STBI_NO_FAILURE_STRINGS
+#define IMAGE_FAILURE_REASON() "No failure reason on this platform"
+#else
+#define IMAGE_FAILURE_REASON() stbi_failure_reason()
+#endif
+
 #define MINIZ_NO_STDIO
 #define MINIZ_NO_TIME
 #define MINIZ_SDL_MALLOC
@@ -204,7 +212,7 @@ uint8_t *Refresh_Image_Load(
         STBI_rgb_alpha);
 
     if (result == NULL) {
-        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "Image loading failed: %s", stbi_failure_reason());
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "Image loading failed: %s", IMAGE_FAILURE_REASON());
     }
 
     /* Ensure that the alpha pixels are... well, actual alpha.
@@ -243,7 +251,7 @@ SDL_bool Refresh_Image_Info(
         &format);
 
     if (result == 0) {
-        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "Image info failed: %s", stbi_failure_reason());
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "Image info failed: %s", IMAGE_FAILURE_REASON());
     }
 
     *len = (*w) * (*h) * 4;
@@ -251,11 +259,628 @@ SDL_bool Refresh_Image_Info(
     return result;
 }
 
+SDL_bool Refresh_Image_LoadInto(
+    uint8_t *bufferPtr,
+    int32_t bufferLength,
+    uint8_t *dst,
+    int32_t dstRowPitch,
+    int32_t dstLength,
+    int32_t *w,
+    int32_t *h)
+{
+    uint8_t *decoded;
+    uint8_t *src;
+    uint8_t *row;
+    int32_t format;
+    int32_t x, y;
+
+    decoded = stbi_load_from_memory(
+        bufferPtr,
+        bufferLength,
+        w,
+        h,
+        &format,
+        STBI_rgb_alpha);
+
+    if (decoded == NULL) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "Image loading failed: %s", IMAGE_FAILURE_REASON());
+        return SDL_FALSE;
+    }
+
+    if (dstRowPitch < (*w) * 4 ||
+        (int64_t)dstRowPitch * (*h - 1) + (*w) * 4 > dstLength) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "Image does not fit in the destination!");
+        SDL_SIMDFree(decoded);
+        return SDL_FALSE;
+    }
+
+    /* Copy out row by row, cleaning up the alpha in the same pass.
+     * See Refresh_Image_Load for why the alpha needs cleaning up.
+     */
+    src = decoded;
+    for (y = 0; y < *h; y += 1) {
+        row = dst + (size_t)y * dstRowPitch;
+        for (x = 0; x < *w; x += 1, src += 4, row += 4) {
+            if (src[3] == 0) {
+                row[0] = 0;
+                row[1] = 0;
+                row[2] = 0;
+                row[3] = 0;
+            } else {
+                SDL_memcpy(row, src, 4);
+            }
+        }
+    }
+
+    SDL_SIMDFree(decoded);
+    return SDL_TRUE;
+}
+
+typedef struct Refresh_Image_INTERNAL_Batch
+{
+    Refresh_Image_DecodeRequest *requests;
+    int32_t requestCount;
+    SDL_atomic_t nextRequest;
+    SDL_atomic_t succeededCount;
+} Refresh_Image_INTERNAL_Batch;
+
+static int SDLCALL Refresh_Image_INTERNAL_BatchWorker(void *data)
+{
+    Refresh_Image_INTERNAL_Batch *batch = (Refresh_Image_INTERNAL_Batch *)data;
+    Refresh_Image_DecodeRequest *request;
+    int32_t i;
+
+    while ((i = SDL_AtomicAdd(&batch->nextRequest, 1)) < batch->requestCount) {
+        request = &batch->requests[i];
+        request->succeeded = Refresh_Image_LoadInto(
+            request->bufferPtr,
+            request->bufferLength,
+            request->dst,
+            request->dstRowPitch,
+            request->dstLength,
+            &request->w,
+            &request->h);
+        if (request->succeeded) {
+            SDL_AtomicIncRef(&batch->succeededCount);
+        }
+    }
+
+    return 0;
+}
+
+#define MAX_IMAGE_DECODE_THREADS 8
+
+int32_t Refresh_Image_LoadBatch(
+    Refresh_Image_DecodeRequest *requests,
+    int32_t requestCount,
+    int32_t threadCount)
+{
+    Refresh_Image_INTERNAL_Batch batch;
+    SDL_Thread *threads[MAX_IMAGE_DECODE_THREADS];
+    int32_t i;
+
+    if (requests == NULL || requestCount <= 0) {
+        return 0;
+    }
+
+    if (threadCount <= 0) {
+        threadCount = SDL_GetCPUCount();
+    }
+    threadCount = SDL_min(threadCount, MAX_IMAGE_DECODE_THREADS);
+    threadCount = SDL_min(threadCount, requestCount);
+
+    batch.requests = requests;
+    batch.requestCount = requestCount;
+    SDL_AtomicSet(&batch.nextRequest, 0);
+    SDL_AtomicSet(&batch.succeededCount, 0);
+
+    /* The calling thread decodes too, so it needs one fewer worker */
+    for (i = 0; i < threadCount - 1; i += 1) {
+        threads[i] = SDL_CreateThread(
+            Refresh_Image_INTERNAL_BatchWorker,
+            "RefreshImageDecode",
+            &batch);
+    }
+
+    Refresh_Image_INTERNAL_BatchWorker(&batch);
+
+    for (i = 0; i < threadCount - 1; i += 1) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+
+    return SDL_AtomicGet(&batch.succeededCount);
+}
+
 void Refresh_Image_Free(uint8_t *mem)
 {
     SDL_SIMDFree(mem);
 }
 
+/* Compressed Texture Container API */
+
+#define DDS_MAGIC            0x20534444 /* "DDS " */
+#define DDS_HEADER_SIZE      124
+#define DDS_DX10_HEADER_SIZE 20
+#define DDSD_DEPTH           0x00800000
+#define DDPF_FOURCC          0x00000004
+#define DDPF_RGB             0x00000040
+#define DDSCAPS2_CUBEMAP     0x00000200
+#define DDSCAPS2_ALLFACES    0x0000FC00
+#define DDSCAPS2_VOLUME      0x00200000
+#define DDS_DIMENSION_3D     4
+#define DDS_MISC_CUBE        0x00000004
+
+#define DDS_FOURCC(a, b, c, d) \
+    ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+#define KTX2_HEADER_SIZE      80
+#define KTX2_LEVEL_INDEX_SIZE 24
+
+/* Container headers are untrusted, anything past what a GPU can create is rejected.
+ * These match the D3D11 limits, which are the lowest across the backends.
+ */
+#define MAX_IMAGE_DIMENSION    16384
+#define MAX_IMAGE_VOLUME_DEPTH 2048
+#define MAX_IMAGE_LAYERS       2048
+
+static const uint8_t KTX2_IDENTIFIER[12] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+};
+
+static uint32_t Refresh_Image_INTERNAL_Read32(const uint8_t *ptr)
+{
+    uint32_t value;
+    SDL_memcpy(&value, ptr, sizeof(value));
+    return SDL_SwapLE32(value);
+}
+
+static uint64_t Refresh_Image_INTERNAL_Read64(const uint8_t *ptr)
+{
+    uint64_t value;
+    SDL_memcpy(&value, ptr, sizeof(value));
+    return SDL_SwapLE64(value);
+}
+
+static Refresh_TextureFormat Refresh_Image_INTERNAL_FormatFromDXGI(uint32_t dxgiFormat)
+{
+    switch (dxgiFormat) {
+    case 70: /* DXGI_FORMAT_BC1_TYPELESS */
+    case 71: /* DXGI_FORMAT_BC1_UNORM */
+        return REFRESH_TEXTUREFORMAT_BC1;
+    case 73: /* DXGI_FORMAT_BC2_TYPELESS */
+    case 74: /* DXGI_FORMAT_BC2_UNORM */
+        return REFRESH_TEXTUREFORMAT_BC2;
+    case 76: /* DXGI_FORMAT_BC3_TYPELESS */
+    case 77: /* DXGI_FORMAT_BC3_UNORM */
+        return REFRESH_TEXTUREFORMAT_BC3;
+    case 78: /* DXGI_FORMAT_BC3_UNORM_SRGB */
+        return REFRESH_TEXTUREFORMAT_BC3_SRGB;
+    case 97: /* DXGI_FORMAT_BC7_TYPELESS */
+    case 98: /* DXGI_FORMAT_BC7_UNORM */
+        return REFRESH_TEXTUREFORMAT_BC7;
+    case 99: /* DXGI_FORMAT_BC7_UNORM_SRGB */
+        return REFRESH_TEXTUREFORMAT_BC7_SRGB;
+    case 27: /* DXGI_FORMAT_R8G8B8A8_TYPELESS */
+    case 28: /* DXGI_FORMAT_R8G8B8A8_UNORM */
+        return REFRESH_TEXTUREFORMAT_R8G8B8A8;
+    case 29: /* DXGI_FORMAT_R8G8B8A8_UNORM_SRGB */
+        return REFRESH_TEXTUREFORMAT_R8G8B8A8_SRGB;
+    case 87: /* DXGI_FORMAT_B8G8R8A8_UNORM */
+    case 90: /* DXGI_FORMAT_B8G8R8A8_TYPELESS */
+        return REFRESH_TEXTUREFORMAT_B8G8R8A8;
+    case 91: /* DXGI_FORMAT_B8G8R8A8_UNORM_SRGB */
+        return REFRESH_TEXTUREFORMAT_B8G8R8A8_SRGB;
+    default:
+        return REFRESH_TEXTUREFORMAT_INVALID;
+    }
+}
+
+static Refresh_TextureFormat Refresh_Image_INTERNAL_FormatFromVk(uint32_t vkFormat)
+{
+    switch (vkFormat) {
+    case 131: /* VK_FORMAT_BC1_RGB_UNORM_BLOCK */
+    case 133: /* VK_FORMAT_BC1_RGBA_UNORM_BLOCK */
+        return REFRESH_TEXTUREFORMAT_BC1;
+    case 135: /* VK_FORMAT_BC2_UNORM_BLOCK */
+        return REFRESH_TEXTUREFORMAT_BC2;
+    case 137: /* VK_FORMAT_BC3_UNORM_BLOCK */
+        return REFRESH_TEXTUREFORMAT_BC3;
+    case 138: /* VK_FORMAT_BC3_SRGB_BLOCK */
+        return REFRESH_TEXTUREFORMAT_BC3_SRGB;
+    case 145: /* VK_FORMAT_BC7_UNORM_BLOCK */
+        return REFRESH_TEXTUREFORMAT_BC7;
+    case 146: /* VK_FORMAT_BC7_SRGB_BLOCK */
+        return REFRESH_TEXTUREFORMAT_BC7_SRGB;
+    case 37: /* VK_FORMAT_R8G8B8A8_UNORM */
+        return REFRESH_TEXTUREFORMAT_R8G8B8A8;
+    case 43: /* VK_FORMAT_R8G8B8A8_SRGB */
+        return REFRESH_TEXTUREFORMAT_R8G8B8A8_SRGB;
+    case 44: /* VK_FORMAT_B8G8R8A8_UNORM */
+        return REFRESH_TEXTUREFORMAT_B8G8R8A8;
+    case 50: /* VK_FORMAT_B8G8R8A8_SRGB */
+        return REFRESH_TEXTUREFORMAT_B8G8R8A8_SRGB;
+    default:
+        return REFRESH_TEXTUREFORMAT_INVALID;
+    }
+}
+
+static uint64_t Refresh_Image_INTERNAL_ImageSize(
+    Refresh_TextureFormat format,
+    uint32_t w,
+    uint32_t h,
+    uint32_t d)
+{
+    uint32_t blockWidth;
+
+    switch (format) {
+    case REFRESH_TEXTUREFORMAT_BC1:
+    case REFRESH_TEXTUREFORMAT_BC2:
+    case REFRESH_TEXTUREFORMAT_BC3:
+    case REFRESH_TEXTUREFORMAT_BC7:
+    case REFRESH_TEXTUREFORMAT_BC3_SRGB:
+    case REFRESH_TEXTUREFORMAT_BC7_SRGB:
+        blockWidth = 4;
+        break;
+    default:
+        blockWidth = 1;
+        break;
+    }
+
+    return (((uint64_t)w + blockWidth - 1) / blockWidth) *
+           (((uint64_t)h + blockWidth - 1) / blockWidth) *
+           (uint64_t)d *
+           Refresh_TextureFormatTexelBlockSize(format);
+}
+
+static SDL_bool Refresh_Image_INTERNAL_ValidateDimensions(
+    uint32_t w,
+    uint32_t h,
+    uint32_t d,
+    uint32_t layerCount,
+    uint32_t levelCount)
+{
+    uint32_t maxDimension = SDL_max(SDL_max(w, h), d);
+    uint32_t maxLevelCount = 1;
+
+    if (w == 0 || h == 0 || d == 0 || layerCount == 0 || levelCount == 0 ||
+        w > MAX_IMAGE_DIMENSION ||
+        h > MAX_IMAGE_DIMENSION ||
+        d > MAX_IMAGE_VOLUME_DEPTH ||
+        layerCount > MAX_IMAGE_LAYERS) {
+        return SDL_FALSE;
+    }
+
+    while (maxDimension >> maxLevelCount) {
+        maxLevelCount += 1;
+    }
+
+    return levelCount <= maxLevelCount;
+}
+
+static SDL_bool Refresh_Image_INTERNAL_InitTextureInfo(
+    Refresh_Image_TextureInfo *info,
+    Refresh_TextureFormat format,
+    uint32_t w,
+    uint32_t h,
+    uint32_t d,
+    SDL_bool isCube,
+    uint32_t layerCount,
+    uint32_t levelCount)
+{
+    uint64_t subresourceCount = (uint64_t)(isCube ? 6 : layerCount) * levelCount;
+
+    if (subresourceCount > SDL_MAX_UINT32 / sizeof(Refresh_Image_Subresource)) {
+        return SDL_FALSE;
+    }
+
+    info->createInfo.width = w;
+    info->createInfo.height = h;
+    info->createInfo.depth = d;
+    info->createInfo.isCube = isCube;
+    info->createInfo.layerCount = isCube ? 1 : layerCount;
+    info->createInfo.levelCount = levelCount;
+    info->createInfo.sampleCount = REFRESH_SAMPLECOUNT_1;
+    info->createInfo.format = format;
+    info->createInfo.usageFlags = REFRESH_TEXTUREUSAGE_SAMPLER_BIT;
+
+    info->dataOffset = 0;
+    info->dataLength = 0;
+    info->subresourceCount = (uint32_t)subresourceCount;
+    info->subresources = SDL_malloc(info->subresourceCount * sizeof(Refresh_Image_Subresource));
+
+    if (info->subresources == NULL) {
+        info->subresourceCount = 0;
+        return SDL_FALSE;
+    }
+
+    return SDL_TRUE;
+}
+
+/* Records a subresource and grows the data span to cover it */
+static void Refresh_Image_INTERNAL_SetSubresource(
+    Refresh_Image_TextureInfo *info,
+    uint32_t index,
+    uint32_t offset,
+    uint32_t length,
+    uint32_t mipLevel,
+    uint32_t layer)
+{
+    Refresh_Image_Subresource *subresource = &info->subresources[index];
+    uint32_t dataEnd;
+
+    subresource->offset = offset;
+    subresource->length = length;
+    subresource->mipLevel = mipLevel;
+    subresource->layer = layer;
+    subresource->w = SDL_max(info->createInfo.width >> mipLevel, 1);
+    subresource->h = SDL_max(info->createInfo.height >> mipLevel, 1);
+    subresource->d = SDL_max(info->createInfo.depth >> mipLevel, 1);
+
+    if (index == 0) {
+        info->dataOffset = offset;
+        info->dataLength = length;
+    } else {
+        dataEnd = SDL_max(info->dataOffset + info->dataLength, offset + length);
+        info->dataOffset = SDL_min(info->dataOffset, offset);
+        info->dataLength = dataEnd - info->dataOffset;
+    }
+}
+
+SDL_bool Refresh_Image_LoadDDS(
+    uint8_t *bufferPtr,
+    int32_t bufferLength,
+    Refresh_Image_TextureInfo *info)
+{
+    const uint8_t *header = bufferPtr + 4;
+    Refresh_TextureFormat format = REFRESH_TEXTUREFORMAT_INVALID;
+    uint32_t flags, w, h, d, levelCount, layerCount, caps2;
+    uint32_t pixelFlags, fourCC, bitCount, redMask;
+    uint32_t faceCount, offset, layer, level, index;
+    uint64_t imageSize;
+    SDL_bool isCube = SDL_FALSE;
+
+    SDL_zerop(info);
+
+    if (bufferLength < 4 + DDS_HEADER_SIZE ||
+        Refresh_Image_INTERNAL_Read32(bufferPtr) != DDS_MAGIC ||
+        Refresh_Image_INTERNAL_Read32(header) != DDS_HEADER_SIZE) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "DDS loading failed: Not a DDS file");
+        return SDL_FALSE;
+    }
+
+    flags = Refresh_Image_INTERNAL_Read32(header + 4);
+    h = Refresh_Image_INTERNAL_Read32(header + 8);
+    w = Refresh_Image_INTERNAL_Read32(header + 12);
+    d = Refresh_Image_INTERNAL_Read32(header + 20);
+    levelCount = SDL_max(Refresh_Image_INTERNAL_Read32(header + 24), 1);
+    pixelFlags = Refresh_Image_INTERNAL_Read32(header + 76);
+    fourCC = Refresh_Image_INTERNAL_Read32(header + 80);
+    bitCount = Refresh_Image_INTERNAL_Read32(header + 84);
+    redMask = Refresh_Image_INTERNAL_Read32(header + 88);
+    caps2 = Refresh_Image_INTERNAL_Read32(header + 108);
+    offset = 4 + DDS_HEADER_SIZE;
+    layerCount = 1;
+
+    if (!(flags & DDSD_DEPTH) || !(caps2 & DDSCAPS2_VOLUME)) {
+        d = 1;
+    }
+
+    if ((pixelFlags & DDPF_FOURCC) && fourCC == DDS_FOURCC('D', 'X', '1', '0')) {
+        if (bufferLength < 4 + DDS_HEADER_SIZE + DDS_DX10_HEADER_SIZE) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "DDS loading failed: Truncated DX10 header");
+            return SDL_FALSE;
+        }
+        format = Refresh_Image_INTERNAL_FormatFromDXGI(Refresh_Image_INTERNAL_Read32(bufferPtr + offset));
+        if (Refresh_Image_INTERNAL_Read32(bufferPtr + offset + 4) != DDS_DIMENSION_3D) {
+            d = 1;
+        }
+        isCube = (Refresh_Image_INTERNAL_Read32(bufferPtr + offset + 8) & DDS_MISC_CUBE) != 0;
+        layerCount = SDL_max(Refresh_Image_INTERNAL_Read32(bufferPtr + offset + 12), 1);
+        offset += DDS_DX10_HEADER_SIZE;
+    } else {
+        if (pixelFlags & DDPF_FOURCC) {
+            if (fourCC == DDS_FOURCC('D', 'X', 'T', '1')) {
+                format = REFRESH_TEXTUREFORMAT_BC1;
+            } else if (fourCC == DDS_FOURCC('D', 'X', 'T', '2') || fourCC == DDS_FOURCC('D', 'X', 'T', '3')) {
+                format = REFRESH_TEXTUREFORMAT_BC2;
+            } else if (fourCC == DDS_FOURCC('D', 'X', 'T', '4') || fourCC == DDS_FOURCC('D', 'X', 'T', '5')) {
+                format = REFRESH_TEXTUREFORMAT_BC3;
+            }
+        } else if ((pixelFlags & DDPF_RGB) && bitCount == 32) {
+            if (redMask == 0x000000FF) {
+                format = REFRESH_TEXTUREFORMAT_R8G8B8A8;
+            } else if (redMask == 0x00FF0000) {
+                format = REFRESH_TEXTUREFORMAT_B8G8R8A8;
+            }
+        }
+
+        if (caps2 & DDSCAPS2_CUBEMAP) {
+            if ((caps2 & DDSCAPS2_ALLFACES) != DDSCAPS2_ALLFACES) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "DDS loading failed: Partial cube maps are not supported");
+                return SDL_FALSE;
+            }
+            isCube = SDL_TRUE;
+        }
+    }
+
+    if (format == REFRESH_TEXTUREFORMAT_INVALID) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "DDS loading failed: Unsupported pixel format");
+        return SDL_FALSE;
+    }
+    if (isCube && layerCount > 1) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "DDS loading failed: Cube map arrays are not supported");
+        return SDL_FALSE;
+    }
+    if (!Refresh_Image_INTERNAL_ValidateDimensions(w, h, d, layerCount, levelCount)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "DDS loading failed: Invalid dimensions");
+        return SDL_FALSE;
+    }
+
+    if (!Refresh_Image_INTERNAL_InitTextureInfo(info, format, w, h, d, isCube, layerCount, levelCount)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "DDS loading failed: Out of memory");
+        return SDL_FALSE;
+    }
+
+    /* DDS stores every mip chain of a layer (or face) before the next one */
+    faceCount = isCube ? 6 : layerCount;
+    index = 0;
+    for (layer = 0; layer < faceCount; layer += 1) {
+        for (level = 0; level < levelCount; level += 1) {
+            imageSize = Refresh_Image_INTERNAL_ImageSize(
+                format,
+                SDL_max(w >> level, 1),
+                SDL_max(h >> level, 1),
+                SDL_max(d >> level, 1));
+
+            if (imageSize > (uint64_t)bufferLength - offset) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "DDS loading failed: Truncated texel data");
+                Refresh_Image_FreeTextureInfo(info);
+                return SDL_FALSE;
+            }
+
+            Refresh_Image_INTERNAL_SetSubresource(info, index, offset, (uint32_t)imageSize, level, layer);
+            offset += (uint32_t)imageSize;
+            index += 1;
+        }
+    }
+
+    return SDL_TRUE;
+}
+
+SDL_bool Refresh_Image_LoadKTX2(
+    uint8_t *bufferPtr,
+    int32_t bufferLength,
+    Refresh_Image_TextureInfo *info)
+{
+    const uint8_t *levelIndex;
+    Refresh_TextureFormat format;
+    uint32_t w, h, d, layerCount, faceCount, levelCount;
+    uint32_t layer, level, imageCount;
+    uint64_t levelOffset, levelLength, imageSize, subresourceIndex;
+    SDL_bool isCube;
+
+    SDL_zerop(info);
+
+    if (bufferLength < KTX2_HEADER_SIZE ||
+        SDL_memcmp(bufferPtr, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "KTX2 loading failed: Not a KTX2 file");
+        return SDL_FALSE;
+    }
+
+    format = Refresh_Image_INTERNAL_FormatFromVk(Refresh_Image_INTERNAL_Read32(bufferPtr + 12));
+    w = Refresh_Image_INTERNAL_Read32(bufferPtr + 20);
+    h = SDL_max(Refresh_Image_INTERNAL_Read32(bufferPtr + 24), 1);
+    d = SDL_max(Refresh_Image_INTERNAL_Read32(bufferPtr + 28), 1);
+    layerCount = SDL_max(Refresh_Image_INTERNAL_Read32(bufferPtr + 32), 1);
+    faceCount = Refresh_Image_INTERNAL_Read32(bufferPtr + 36);
+    levelCount = SDL_max(Refresh_Image_INTERNAL_Read32(bufferPtr + 40), 1);
+    isCube = faceCount == 6;
+
+    if (format == REFRESH_TEXTUREFORMAT_INVALID) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "KTX2 loading failed: Unsupported pixel format");
+        return SDL_FALSE;
+    }
+    if (Refresh_Image_INTERNAL_Read32(bufferPtr + 44) != 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "KTX2 loading failed: Supercompressed files are not supported");
+        return SDL_FALSE;
+    }
+    if (isCube && layerCount > 1) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "KTX2 loading failed: Cube map arrays are not supported");
+        return SDL_FALSE;
+    }
+    if ((faceCount != 1 && faceCount != 6) ||
+        !Refresh_Image_INTERNAL_ValidateDimensions(w, h, d, layerCount, levelCount) ||
+        (uint64_t)bufferLength < KTX2_HEADER_SIZE + (uint64_t)levelCount * KTX2_LEVEL_INDEX_SIZE) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "KTX2 loading failed: Invalid header");
+        return SDL_FALSE;
+    }
+
+    if (!Refresh_Image_INTERNAL_InitTextureInfo(info, format, w, h, d, isCube, layerCount, levelCount)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "KTX2 loading failed: Out of memory");
+        return SDL_FALSE;
+    }
+
+    /* Each KTX2 level holds every layer, then every face, of that mip */
+    imageCount = layerCount * faceCount;
+    for (level = 0; level < levelCount; level += 1) {
+        levelIndex = bufferPtr + KTX2_HEADER_SIZE + level * KTX2_LEVEL_INDEX_SIZE;
+        levelOffset = Refresh_Image_INTERNAL_Read64(levelIndex);
+        levelLength = Refresh_Image_INTERNAL_Read64(levelIndex + 8);
+
+        imageSize = Refresh_Image_INTERNAL_ImageSize(
+            format,
+            SDL_max(w >> level, 1),
+            SDL_max(h >> level, 1),
+            SDL_max(d >> level, 1));
+
+        /* The dimension limits keep imageSize * imageCount well within 64 bits */
+        if (levelOffset > (uint64_t)bufferLength ||
+            levelLength > (uint64_t)bufferLength - levelOffset ||
+            levelLength < imageSize * imageCount) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "KTX2 loading failed: Truncated texel data");
+            Refresh_Image_FreeTextureInfo(info);
+            return SDL_FALSE;
+        }
+
+        for (layer = 0; layer < imageCount; layer += 1) {
+            subresourceIndex = (uint64_t)layer * levelCount + level;
+            if (subresourceIndex >= info->subresourceCount) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "KTX2 loading failed: Invalid header");
+                Refresh_Image_FreeTextureInfo(info);
+                return SDL_FALSE;
+            }
+
+            Refresh_Image_INTERNAL_SetSubresource(
+                info,
+                (uint32_t)subresourceIndex,
+                (uint32_t)(levelOffset + layer * imageSize),
+                (uint32_t)imageSize,
+                level,
+                layer);
+        }
+    }
+
+    return SDL_TRUE;
+}
+
+void Refresh_Image_GetUploadRegions(
+    Refresh_Image_TextureInfo *info,
+    Refresh_Texture *texture,
+    Refresh_TransferBuffer *transferBuffer,
+    uint32_t transferBufferOffset,
+    Refresh_TextureTransferInfo *sources,
+    Refresh_TextureRegion *destinations)
+{
+    Refresh_Image_Subresource *subresource;
+    uint32_t i;
+
+    for (i = 0; i < info->subresourceCount; i += 1) {
+        subresource = &info->subresources[i];
+
+        sources[i].transferBuffer = transferBuffer;
+        sources[i].offset = transferBufferOffset + (subresource->offset - info->dataOffset);
+        sources[i].imagePitch = 0; /* Tightly packed */
+        sources[i].imageHeight = 0;
+
+        destinations[i].textureSlice.texture = texture;
+        destinations[i].textureSlice.mipLevel = subresource->mipLevel;
+        destinations[i].textureSlice.layer = subresource->layer;
+        destinations[i].x = 0;
+        destinations[i].y = 0;
+        destinations[i].z = 0;
+        destinations[i].w = subresource->w;
+        destinations[i].h = subresource->h;
+        destinations[i].d = subresource->d;
+    }
+}
+
+void Refresh_Image_FreeTextureInfo(Refresh_Image_TextureInfo *info)
+{
+    SDL_free(info->subresources);
+    info->subresources = NULL;
+    info->subresourceCount = 0;
+}
+
 /* Image Write API */
 
 void Refresh_Image_SavePNG(
@@ -273,4 +898,260 @@ void Refresh_Image_SavePNG(
         w * 4);
 }
 
+/* Texture Capture API */
+
+typedef struct Refresh_Image_INTERNAL_Capture
+{
+    Refresh_Fence *fence;
+    Refresh_TransferBuffer *transferBuffer;
+    int32_t w;
+    int32_t h;
+    SDL_bool swizzle; /* BGRA to RGBA */
+    char *filename;
+    struct Refresh_Image_INTERNAL_Capture *next;
+} Refresh_Image_INTERNAL_Capture;
+
+struct Refresh_Image_CaptureQueue
+{
+    Refresh_Device *device;
+    SDL_Thread *thread;
+    SDL_mutex *lock;
+    SDL_cond *captureAvailable;
+    Refresh_Image_INTERNAL_Capture *head;
+    Refresh_Image_INTERNAL_Capture *tail;
+    SDL_bool quit;
+};
+
+static void Refresh_Image_INTERNAL_WriteCapture(
+    Refresh_Device *device,
+    Refresh_Image_INTERNAL_Capture *capture)
+{
+    uint8_t *pixels = NULL;
+    uint8_t temp;
+    int32_t i;
+
+    /* Poll rather than block, so the capture thread never holds up submission */
+    while (!Refresh_QueryFence(device, capture->fence)) {
+        SDL_Delay(1);
+    }
+
+    /* Already signaled, but some backends only resolve downloads here */
+    Refresh_WaitForFences(device, SDL_TRUE, &capture->fence, 1);
+    Refresh_ReleaseFence(device, capture->fence);
+
+    Refresh_MapTransferBuffer(device, capture->transferBuffer, SDL_FALSE, (void **)&pixels);
+    if (pixels == NULL) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "Texture capture failed: Could not map %s", capture->filename);
+        Refresh_ReleaseTransferBuffer(device, capture->transferBuffer);
+        return;
+    }
+
+    if (capture->swizzle) {
+        for (i = 0; i < capture->w * capture->h * 4; i += 4) {
+            temp = pixels[i];
+            pixels[i] = pixels[i + 2];
+            pixels[i + 2] = temp;
+        }
+    }
+
+    stbi_write_png(
+        capture->filename,
+        capture->w,
+        capture->h,
+        4,
+        pixels,
+        capture->w * 4);
+
+    Refresh_UnmapTransferBuffer(device, capture->transferBuffer);
+    Refresh_ReleaseTransferBuffer(device, capture->transferBuffer);
+}
+
+static int SDLCALL Refresh_Image_INTERNAL_CaptureThread(void *data)
+{
+    Refresh_Image_CaptureQueue *queue = (Refresh_Image_CaptureQueue *)data;
+    Refresh_Image_INTERNAL_Capture *capture;
+
+    SDL_LockMutex(queue->lock);
+    while (1) {
+        while (queue->head == NULL && !queue->quit) {
+            SDL_CondWait(queue->captureAvailable, queue->lock);
+        }
+        if (queue->head == NULL) {
+            break;
+        }
+
+        /* Captures were submitted in order, so they also complete in order */
+        capture = queue->head;
+        queue->head = capture->next;
+        if (queue->head == NULL) {
+            queue->tail = NULL;
+        }
+        SDL_UnlockMutex(queue->lock);
+
+        Refresh_Image_INTERNAL_WriteCapture(queue->device, capture);
+        SDL_free(capture->filename);
+        SDL_free(capture);
+
+        SDL_LockMutex(queue->lock);
+    }
+    SDL_UnlockMutex(queue->lock);
+
+    return 0;
+}
+
+Refresh_Image_CaptureQueue *Refresh_Image_CreateCaptureQueue(
+    Refresh_Device *device)
+{
+    Refresh_Image_CaptureQueue *queue;
+
+    if (device == NULL) {
+        SDL_InvalidParamError("device");
+        return NULL;
+    }
+
+    queue = SDL_malloc(sizeof(Refresh_Image_CaptureQueue));
+    if (queue == NULL) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    queue->device = device;
+    queue->lock = SDL_CreateMutex();
+    queue->captureAvailable = SDL_CreateCond();
+    queue->head = NULL;
+    queue->tail = NULL;
+    queue->quit = SDL_FALSE;
+    queue->thread = NULL;
+
+    if (queue->lock != NULL && queue->captureAvailable != NULL) {
+        queue->thread = SDL_CreateThread(
+            Refresh_Image_INTERNAL_CaptureThread,
+            "RefreshImageCapture",
+            queue);
+    }
+
+    if (queue->thread == NULL) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "Capture queue creation failed: %s", SDL_GetError());
+        if (queue->captureAvailable != NULL) {
+            SDL_DestroyCond(queue->captureAvailable);
+        }
+        if (queue->lock != NULL) {
+            SDL_DestroyMutex(queue->lock);
+        }
+        SDL_free(queue);
+        return NULL;
+    }
+
+    return queue;
+}
+
+SDL_bool Refresh_Image_CaptureTexturePNG(
+    Refresh_Image_CaptureQueue *queue,
+    Refresh_TextureRegion *region,
+    Refresh_TextureFormat format,
+    const char *filename)
+{
+    Refresh_Image_INTERNAL_Capture *capture;
+    Refresh_TransferBuffer *transferBuffer;
+    Refresh_CommandBuffer *commandBuffer;
+    Refresh_CopyPass *copyPass;
+    Refresh_TextureTransferInfo destination;
+    Refresh_Fence *fence;
+    SDL_bool swizzle;
+
+    if (queue == NULL || region == NULL || filename == NULL) {
+        SDL_InvalidParamError("queue, region and filename");
+        return SDL_FALSE;
+    }
+
+    switch (format) {
+    case REFRESH_TEXTUREFORMAT_R8G8B8A8:
+    case REFRESH_TEXTUREFORMAT_R8G8B8A8_SRGB:
+        swizzle = SDL_FALSE;
+        break;
+    case REFRESH_TEXTUREFORMAT_B8G8R8A8:
+    case REFRESH_TEXTUREFORMAT_B8G8R8A8_SRGB:
+        swizzle = SDL_TRUE;
+        break;
+    default:
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "Texture capture failed: Unsupported texture format");
+        return SDL_FALSE;
+    }
+
+    if (region->d != 1 || region->w == 0 || region->h == 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_ERROR, "Texture capture failed: Region must be a single 2D slice");
+        return SDL_FALSE;
+    }
+
+    transferBuffer = Refresh_CreateTransferBuffer(
+        queue->device,
+        REFRESH_TRANSFERBUFFERUSAGE_DOWNLOAD,
+        region->w * region->h * 4);
+    if (transferBuffer == NULL) {
+        return SDL_FALSE;
+    }
+
+    commandBuffer = Refresh_AcquireCommandBuffer(queue->device);
+    if (commandBuffer == NULL) {
+        Refresh_ReleaseTransferBuffer(queue->device, transferBuffer);
+        return SDL_FALSE;
+    }
+
+    destination.transferBuffer = transferBuffer;
+    destination.offset = 0;
+    destination.imagePitch = 0;
+    destination.imageHeight = 0;
+
+    copyPass = Refresh_BeginCopyPass(commandBuffer);
+    Refresh_DownloadFromTexture(copyPass, region, &destination);
+    Refresh_EndCopyPass(copyPass);
+
+    fence = Refresh_SubmitAndAcquireFence(commandBuffer);
+    if (fence == NULL) {
+        Refresh_ReleaseTransferBuffer(queue->device, transferBuffer);
+        return SDL_FALSE;
+    }
+
+    capture = SDL_malloc(sizeof(Refresh_Image_INTERNAL_Capture));
+    capture->fence = fence;
+    capture->transferBuffer = transferBuffer;
+    capture->w = (int32_t)region->w;
+    capture->h = (int32_t)region->h;
+    capture->swizzle = swizzle;
+    capture->filename = SDL_strdup(filename);
+    capture->next = NULL;
+
+    SDL_LockMutex(queue->lock);
+    if (queue->tail == NULL) {
+        queue->head = capture;
+    } else {
+        queue->tail->next = capture;
+    }
+    queue->tail = capture;
+    SDL_CondSignal(queue->captureAvailable);
+    SDL_UnlockMutex(queue->lock);
+
+    return SDL_TRUE;
+}
+
+void Refresh_Image_DestroyCaptureQueue(
+    Refresh_Image_CaptureQueue *queue)
+{
+    if (queue == NULL) {
+        return;
+    }
+
+    SDL_LockMutex(queue->lock);
+    queue->quit = SDL_TRUE;
+    SDL_CondSignal(queue->captureAvailable);
+    SDL_UnlockMutex(queue->lock);
+
+    /* The thread drains the queue before it exits */
+    SDL_WaitThread(queue->thread, NULL);
+
+    SDL_DestroyCond(queue->captureAvailable);
+    SDL_DestroyMutex(queue->lock);
+    SDL_free(queue);
+}
+
 /* vim: set noexpandtab shiftwidth=8 tabstop=8: */
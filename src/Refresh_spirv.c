@@ -40,6 +40,7 @@
     SDL_SetError(#func " failed: %s", SDL_spvc_context_get_last_error_string(context))
 
 static void *spirvcross_dll = NULL;
+static SDL_SpinLock spirvcross_lock = 0; /* Async compile tasks can translate from several threads */
 
 typedef spvc_result (*pfn_spvc_context_create)(spvc_context *context);
 typedef void (*pfn_spvc_context_destroy)(spvc_context);
@@ -65,6 +66,405 @@ static pfn_spvc_context_get_last_error_string SDL_spvc_context_get_last_error_st
 static pfn_spvc_compiler_get_execution_model SDL_spvc_compiler_get_execution_model = NULL;
 static pfn_spvc_compiler_get_cleansed_entry_point_name SDL_spvc_compiler_get_cleansed_entry_point_name = NULL;
 
+/* Translation Cache
+ *
+ * Maps a SPIR-V module to the code the backend was finally created from,
+ * either native bytecode or, if the backend cannot produce it, the
+ * translated source. Entries are never removed until the device is destroyed,
+ * so a looked-up entry can be used without holding the lock.
+ *
+ * The hash only picks the bucket. A hit also compares the SPIR-V bytes,
+ * the entry point name, the stage and the target options.
+ */
+
+#define SHADER_CACHE_BUCKET_COUNT  256
+#define SHADER_CACHE_STAGE_COMPUTE (REFRESH_SHADERSTAGE_FRAGMENT + 1)
+#define SHADER_CACHE_MAGIC         0x43485352 /* "RSHC" */
+#define SHADER_CACHE_VERSION       2 /* Bump this when the cache layout changes! */
+
+#define SHADER_CACHE_HLSL_SHADER_MODEL           50
+#define SHADER_CACHE_HLSL_NONWRITABLE_UAV_AS_SRV 1
+
+typedef struct ShaderCacheEntry
+{
+    Uint64 hash;
+    Uint8 *spirv;
+    size_t spirvSize;
+    char *sourceEntryPointName;
+    Uint32 stage;
+    Uint32 targetOptions;
+    Refresh_ShaderFormat format;
+    char *entryPointName;
+    Uint8 *code;
+    size_t codeSize;
+    struct ShaderCacheEntry *next;
+} ShaderCacheEntry;
+
+typedef struct ShaderCache
+{
+    SDL_mutex *lock;
+    ShaderCacheEntry *buckets[SHADER_CACHE_BUCKET_COUNT];
+    Uint32 entryCount;
+} ShaderCache;
+
+typedef struct ShaderCacheHeader
+{
+    Uint32 magic;
+    Uint32 version;
+    Uint32 backend;
+    Uint32 entryCount;
+} ShaderCacheHeader;
+
+typedef struct ShaderCacheEntryHeader
+{
+    Uint64 spirvSize;
+    Uint64 codeSize;
+    Uint32 stage;
+    Uint32 targetOptions;
+    Uint32 format;
+    Uint32 sourceEntryPointNameSize; /* Including the null terminator */
+    Uint32 entryPointNameSize;       /* Including the null terminator */
+    Uint32 padding;
+} ShaderCacheEntryHeader;
+
+static Uint64 SDL_INTERNAL_HashBytes(Uint64 hash, const void *data, size_t size)
+{
+    const Uint8 *bytes = (const Uint8 *)data;
+    size_t i;
+
+    /* FNV-1a */
+    for (i = 0; i < size; i += 1) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static Uint64 SDL_INTERNAL_HashShaderKey(
+    const Uint8 *spirv,
+    size_t spirvSize,
+    const char *entryPointName,
+    Uint32 stage,
+    Uint32 targetOptions)
+{
+    Uint64 hash = 0xCBF29CE484222325ULL;
+    hash = SDL_INTERNAL_HashBytes(hash, spirv, spirvSize);
+    hash = SDL_INTERNAL_HashBytes(hash, entryPointName, SDL_strlen(entryPointName) + 1);
+    hash = SDL_INTERNAL_HashBytes(hash, &stage, sizeof(stage));
+    hash = SDL_INTERNAL_HashBytes(hash, &targetOptions, sizeof(targetOptions));
+    return hash;
+}
+
+/* Packs every SPIRV-Cross option that changes the translated code */
+static Uint32 SDL_INTERNAL_GetTargetOptions(spvc_backend backend)
+{
+    if (backend == SPVC_BACKEND_HLSL) {
+        return (SHADER_CACHE_HLSL_NONWRITABLE_UAV_AS_SRV << 16) |
+               (SHADER_CACHE_HLSL_SHADER_MODEL << 8) |
+               (Uint32)backend;
+    }
+    return (Uint32)backend;
+}
+
+static void SDL_INTERNAL_FreeShaderCacheEntry(ShaderCacheEntry *entry)
+{
+    SDL_free(entry->spirv);
+    SDL_free(entry->sourceEntryPointName);
+    SDL_free(entry->entryPointName);
+    SDL_free(entry->code);
+    SDL_free(entry);
+}
+
+ShaderCache *SDL_CreateShaderCache(void)
+{
+    ShaderCache *cache = SDL_malloc(sizeof(ShaderCache));
+    cache->lock = SDL_CreateMutex();
+    SDL_memset(cache->buckets, 0, sizeof(cache->buckets));
+    cache->entryCount = 0;
+    return cache;
+}
+
+void SDL_DestroyShaderCache(ShaderCache *cache)
+{
+    ShaderCacheEntry *entry, *next;
+    Uint32 i;
+
+    for (i = 0; i < SHADER_CACHE_BUCKET_COUNT; i += 1) {
+        for (entry = cache->buckets[i]; entry != NULL; entry = next) {
+            next = entry->next;
+            SDL_INTERNAL_FreeShaderCacheEntry(entry);
+        }
+    }
+
+    SDL_DestroyMutex(cache->lock);
+    SDL_free(cache);
+}
+
+static ShaderCacheEntry *SDL_INTERNAL_FindShaderCacheEntry(
+    ShaderCache *cache,
+    Uint64 hash,
+    const Uint8 *spirv,
+    size_t spirvSize,
+    const char *sourceEntryPointName,
+    Uint32 stage,
+    Uint32 targetOptions)
+{
+    ShaderCacheEntry *entry;
+
+    for (entry = cache->buckets[hash % SHADER_CACHE_BUCKET_COUNT]; entry != NULL; entry = entry->next) {
+        if (entry->hash == hash &&
+            entry->stage == stage &&
+            entry->targetOptions == targetOptions &&
+            entry->spirvSize == spirvSize &&
+            SDL_strcmp(entry->sourceEntryPointName, sourceEntryPointName) == 0 &&
+            SDL_memcmp(entry->spirv, spirv, spirvSize) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* Takes ownership of the new entry. Returns the entry that ends up in the cache. */
+static ShaderCacheEntry *SDL_INTERNAL_InsertShaderCacheEntry(
+    ShaderCache *cache,
+    ShaderCacheEntry *newEntry)
+{
+    ShaderCacheEntry *entry;
+    Uint32 bucket = newEntry->hash % SHADER_CACHE_BUCKET_COUNT;
+
+    SDL_LockMutex(cache->lock);
+
+    /* Another thread may have translated the same shader in the meantime */
+    entry = SDL_INTERNAL_FindShaderCacheEntry(
+        cache,
+        newEntry->hash,
+        newEntry->spirv,
+        newEntry->spirvSize,
+        newEntry->sourceEntryPointName,
+        newEntry->stage,
+        newEntry->targetOptions);
+    if (entry != NULL) {
+        SDL_UnlockMutex(cache->lock);
+        SDL_INTERNAL_FreeShaderCacheEntry(newEntry);
+        return entry;
+    }
+
+    newEntry->next = cache->buckets[bucket];
+    cache->buckets[bucket] = newEntry;
+    cache->entryCount += 1;
+
+    SDL_UnlockMutex(cache->lock);
+    return newEntry;
+}
+
+SDL_bool SDL_LoadShaderCacheData(
+    Refresh_Device *device,
+    const void *data,
+    size_t dataSize)
+{
+    ShaderCache *cache = device->shaderCache;
+    const Uint8 *cursor = (const Uint8 *)data;
+    const Uint8 *end = cursor + dataSize;
+    ShaderCacheHeader header;
+    ShaderCacheEntryHeader entryHeader;
+    ShaderCacheEntry *entry;
+    Uint64 remaining;
+    Uint32 i;
+
+    if (cache == NULL) {
+        return SDL_FALSE;
+    }
+
+    if (dataSize < sizeof(header)) {
+        return SDL_FALSE;
+    }
+    SDL_memcpy(&header, cursor, sizeof(header));
+    cursor += sizeof(header);
+
+    if (header.magic != SHADER_CACHE_MAGIC ||
+        header.version != SHADER_CACHE_VERSION ||
+        header.backend != (Uint32)device->backend) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < header.entryCount; i += 1) {
+        if ((size_t)(end - cursor) < sizeof(entryHeader)) {
+            break;
+        }
+        SDL_memcpy(&entryHeader, cursor, sizeof(entryHeader));
+        cursor += sizeof(entryHeader);
+
+        /* Check each size on its own so a corrupt header can't overflow the sum */
+        remaining = (Uint64)(end - cursor);
+        if (entryHeader.sourceEntryPointNameSize == 0 ||
+            entryHeader.entryPointNameSize == 0 ||
+            entryHeader.sourceEntryPointNameSize > remaining) {
+            break;
+        }
+        remaining -= entryHeader.sourceEntryPointNameSize;
+        if (entryHeader.entryPointNameSize > remaining) {
+            break;
+        }
+        remaining -= entryHeader.entryPointNameSize;
+        if (entryHeader.spirvSize > remaining) {
+            break;
+        }
+        remaining -= entryHeader.spirvSize;
+        if (entryHeader.codeSize > remaining) {
+            break;
+        }
+
+        entry = SDL_malloc(sizeof(ShaderCacheEntry));
+        entry->stage = entryHeader.stage;
+        entry->targetOptions = entryHeader.targetOptions;
+        entry->format = (Refresh_ShaderFormat)entryHeader.format;
+
+        entry->sourceEntryPointName = SDL_malloc(entryHeader.sourceEntryPointNameSize);
+        SDL_memcpy(entry->sourceEntryPointName, cursor, entryHeader.sourceEntryPointNameSize);
+        entry->sourceEntryPointName[entryHeader.sourceEntryPointNameSize - 1] = '\0';
+        cursor += entryHeader.sourceEntryPointNameSize;
+
+        entry->entryPointName = SDL_malloc(entryHeader.entryPointNameSize);
+        SDL_memcpy(entry->entryPointName, cursor, entryHeader.entryPointNameSize);
+        entry->entryPointName[entryHeader.entryPointNameSize - 1] = '\0';
+        cursor += entryHeader.entryPointNameSize;
+
+        entry->spirvSize = (size_t)entryHeader.spirvSize;
+        entry->spirv = SDL_malloc(entry->spirvSize);
+        SDL_memcpy(entry->spirv, cursor, entry->spirvSize);
+        cursor += entry->spirvSize;
+
+        entry->codeSize = (size_t)entryHeader.codeSize;
+        entry->code = SDL_malloc(entry->codeSize);
+        SDL_memcpy(entry->code, cursor, entry->codeSize);
+        cursor += entry->codeSize;
+
+        /* Don't trust a stored hash to pick the bucket */
+        entry->hash = SDL_INTERNAL_HashShaderKey(
+            entry->spirv,
+            entry->spirvSize,
+            entry->sourceEntryPointName,
+            entry->stage,
+            entry->targetOptions);
+
+        SDL_INTERNAL_InsertShaderCacheEntry(cache, entry);
+    }
+
+    return i == header.entryCount;
+}
+
+SDL_bool SDL_GetShaderCacheData(
+    Refresh_Device *device,
+    void *data,
+    size_t *pDataSize)
+{
+    ShaderCache *cache = device->shaderCache;
+    ShaderCacheHeader header;
+    ShaderCacheEntryHeader entryHeader;
+    ShaderCacheEntry *entry;
+    Uint8 *cursor;
+    size_t requiredSize;
+    Uint32 i;
+
+    if (cache == NULL) {
+        *pDataSize = 0;
+        return SDL_FALSE;
+    }
+
+    SDL_LockMutex(cache->lock);
+
+    requiredSize = sizeof(header);
+    for (i = 0; i < SHADER_CACHE_BUCKET_COUNT; i += 1) {
+        for (entry = cache->buckets[i]; entry != NULL; entry = entry->next) {
+            requiredSize += sizeof(entryHeader) +
+                            SDL_strlen(entry->sourceEntryPointName) + 1 +
+                            SDL_strlen(entry->entryPointName) + 1 +
+                            entry->spirvSize +
+                            entry->codeSize;
+        }
+    }
+
+    if (data == NULL) {
+        SDL_UnlockMutex(cache->lock);
+        *pDataSize = requiredSize;
+        return SDL_TRUE;
+    }
+
+    if (*pDataSize < requiredSize) {
+        SDL_UnlockMutex(cache->lock);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Shader cache data buffer is too small!");
+        return SDL_FALSE;
+    }
+
+    header.magic = SHADER_CACHE_MAGIC;
+    header.version = SHADER_CACHE_VERSION;
+    header.backend = (Uint32)device->backend;
+    header.entryCount = cache->entryCount;
+
+    cursor = (Uint8 *)data;
+    SDL_memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+
+    for (i = 0; i < SHADER_CACHE_BUCKET_COUNT; i += 1) {
+        for (entry = cache->buckets[i]; entry != NULL; entry = entry->next) {
+            entryHeader.spirvSize = entry->spirvSize;
+            entryHeader.codeSize = entry->codeSize;
+            entryHeader.stage = entry->stage;
+            entryHeader.targetOptions = entry->targetOptions;
+            entryHeader.format = (Uint32)entry->format;
+            entryHeader.sourceEntryPointNameSize = (Uint32)SDL_strlen(entry->sourceEntryPointName) + 1;
+            entryHeader.entryPointNameSize = (Uint32)SDL_strlen(entry->entryPointName) + 1;
+            entryHeader.padding = 0;
+
+            SDL_memcpy(cursor, &entryHeader, sizeof(entryHeader));
+            cursor += sizeof(entryHeader);
+            SDL_memcpy(cursor, entry->sourceEntryPointName, entryHeader.sourceEntryPointNameSize);
+            cursor += entryHeader.sourceEntryPointNameSize;
+            SDL_memcpy(cursor, entry->entryPointName, entryHeader.entryPointNameSize);
+            cursor += entryHeader.entryPointNameSize;
+            SDL_memcpy(cursor, entry->spirv, entry->spirvSize);
+            cursor += entry->spirvSize;
+            SDL_memcpy(cursor, entry->code, entry->codeSize);
+            cursor += entry->codeSize;
+        }
+    }
+
+    SDL_UnlockMutex(cache->lock);
+
+    *pDataSize = requiredSize;
+    return SDL_TRUE;
+}
+
+static void *SDL_INTERNAL_CreateFromShaderCacheEntry(
+    Refresh_Device *device,
+    Refresh_ShaderCreateInfo *createInfo,
+    SDL_bool isCompute,
+    ShaderCacheEntry *entry)
+{
+    /* Copy the original create info, but with the cached code */
+    if (isCompute) {
+        Refresh_ComputePipelineCreateInfo newCreateInfo;
+        newCreateInfo = *(Refresh_ComputePipelineCreateInfo *)createInfo;
+        newCreateInfo.format = entry->format;
+        newCreateInfo.code = entry->code;
+        newCreateInfo.codeSize = entry->codeSize;
+        newCreateInfo.entryPointName = entry->entryPointName;
+
+        /* Create the pipeline! */
+        return Refresh_CreateComputePipeline(device, &newCreateInfo);
+    } else {
+        Refresh_ShaderCreateInfo newCreateInfo;
+        newCreateInfo = *createInfo;
+        newCreateInfo.format = entry->format;
+        newCreateInfo.code = entry->code;
+        newCreateInfo.codeSize = entry->codeSize;
+        newCreateInfo.entryPointName = entry->entryPointName;
+
+        /* Create the shader! */
+        return Refresh_CreateShader(device, &newCreateInfo);
+    }
+}
+
 void *SDL_CompileFromSPIRV(
     Refresh_Device *device,
     void *originalCreateInfo,
@@ -80,7 +480,13 @@ void *SDL_CompileFromSPIRV(
     spvc_compiler_options options = NULL;
     const char *translated_source;
     const char *cleansed_entrypoint;
-    void *compiledResult;
+    ShaderCache *cache;
+    ShaderCacheEntry *entry;
+    Uint64 hash;
+    Uint32 stage;
+    Uint32 targetOptions;
+    void *binary;
+    size_t binarySize;
 
     /* Refresh_ShaderCreateInfo and Refresh_ComputePipelineCreateInfo
      * share the same struct layout for their first 3 members, which
@@ -102,10 +508,33 @@ void *SDL_CompileFromSPIRV(
         return NULL;
     }
 
+    /* Skip translation entirely if we've seen this shader before */
+    cache = device->shaderCache;
+    stage = isCompute ? SHADER_CACHE_STAGE_COMPUTE : (Uint32)createInfo->stage;
+    targetOptions = SDL_INTERNAL_GetTargetOptions(backend);
+    hash = SDL_INTERNAL_HashShaderKey(createInfo->code, createInfo->codeSize, createInfo->entryPointName, stage, targetOptions);
+
+    SDL_LockMutex(cache->lock);
+    entry = SDL_INTERNAL_FindShaderCacheEntry(
+        cache,
+        hash,
+        createInfo->code,
+        createInfo->codeSize,
+        createInfo->entryPointName,
+        stage,
+        targetOptions);
+    SDL_UnlockMutex(cache->lock);
+
+    if (entry != NULL) {
+        return SDL_INTERNAL_CreateFromShaderCacheEntry(device, createInfo, isCompute, entry);
+    }
+
     /* FIXME: spirv-cross could probably be loaded in a better spot */
+    SDL_AtomicLock(&spirvcross_lock);
     if (spirvcross_dll == NULL) {
         spirvcross_dll = SDL_LoadObject(SPIRV_CROSS_DLL);
         if (spirvcross_dll == NULL) {
+            SDL_AtomicUnlock(&spirvcross_lock);
             return NULL;
         }
     }
@@ -114,6 +543,7 @@ void *SDL_CompileFromSPIRV(
     if (SDL_##func == NULL) {                                             \
         SDL_##func = (pfn_##func)SDL_LoadFunction(spirvcross_dll, #func); \
         if (SDL_##func == NULL) {                                         \
+            SDL_AtomicUnlock(&spirvcross_lock);                           \
             return NULL;                                                  \
         }                                                                 \
     }
@@ -129,6 +559,7 @@ void *SDL_CompileFromSPIRV(
     CHECK_FUNC(spvc_compiler_get_execution_model)
     CHECK_FUNC(spvc_compiler_get_cleansed_entry_point_name)
 #undef CHECK_FUNC
+    SDL_AtomicUnlock(&spirvcross_lock);
 
     /* Create the SPIRV-Cross context */
     result = SDL_spvc_context_create(&context);
@@ -162,8 +593,8 @@ void *SDL_CompileFromSPIRV(
     }
 
     if (backend == SPVC_BACKEND_HLSL) {
-        SDL_spvc_compiler_options_set_uint(options, SPVC_COMPILER_OPTION_HLSL_SHADER_MODEL, 50);
-        SDL_spvc_compiler_options_set_uint(options, SPVC_COMPILER_OPTION_HLSL_NONWRITABLE_UAV_TEXTURE_AS_SRV, 1);
+        SDL_spvc_compiler_options_set_uint(options, SPVC_COMPILER_OPTION_HLSL_SHADER_MODEL, SHADER_CACHE_HLSL_SHADER_MODEL);
+        SDL_spvc_compiler_options_set_uint(options, SPVC_COMPILER_OPTION_HLSL_NONWRITABLE_UAV_TEXTURE_AS_SRV, SHADER_CACHE_HLSL_NONWRITABLE_UAV_AS_SRV);
     }
 
     result = SDL_spvc_compiler_install_compiler_options(compiler, options);
@@ -187,32 +618,40 @@ void *SDL_CompileFromSPIRV(
         createInfo->entryPointName,
         SDL_spvc_compiler_get_execution_model(compiler));
 
-    /* Copy the original create info, but with the new source code */
-    if (isCompute) {
-        Refresh_ComputePipelineCreateInfo newCreateInfo;
-        newCreateInfo = *(Refresh_ComputePipelineCreateInfo *)createInfo;
-        newCreateInfo.format = format;
-        newCreateInfo.code = (const Uint8 *)translated_source;
-        newCreateInfo.codeSize = SDL_strlen(translated_source) + 1;
-        newCreateInfo.entryPointName = cleansed_entrypoint;
+    entry = SDL_malloc(sizeof(ShaderCacheEntry));
+    entry->hash = hash;
+    entry->spirvSize = createInfo->codeSize;
+    entry->spirv = SDL_malloc(entry->spirvSize);
+    SDL_memcpy(entry->spirv, createInfo->code, entry->spirvSize);
+    entry->sourceEntryPointName = SDL_strdup(createInfo->entryPointName);
+    entry->stage = stage;
+    entry->targetOptions = targetOptions;
+    entry->entryPointName = SDL_strdup(cleansed_entrypoint);
 
-        /* Create the pipeline! */
-        compiledResult = Refresh_CreateComputePipeline(device, &newCreateInfo);
+    /* Prefer caching native bytecode so the backend compiler is skipped too */
+    if (device->CompileShaderBinary(
+            device->driverData,
+            isCompute ? REFRESH_SHADERSTAGE_VERTEX : createInfo->stage,
+            isCompute,
+            format,
+            (const Uint8 *)translated_source,
+            SDL_strlen(translated_source) + 1,
+            cleansed_entrypoint,
+            &entry->format,
+            &binary,
+            &binarySize)) {
+        entry->code = binary;
+        entry->codeSize = binarySize;
     } else {
-
-        Refresh_ShaderCreateInfo newCreateInfo;
-        newCreateInfo = *createInfo;
-        newCreateInfo.format = format;
-        newCreateInfo.code = (const Uint8 *)translated_source;
-        newCreateInfo.codeSize = SDL_strlen(translated_source) + 1;
-        newCreateInfo.entryPointName = cleansed_entrypoint;
-
-        /* Create the shader! */
-        compiledResult = Refresh_CreateShader(device, &newCreateInfo);
+        entry->format = format;
+        entry->codeSize = SDL_strlen(translated_source) + 1;
+        entry->code = SDL_malloc(entry->codeSize);
+        SDL_memcpy(entry->code, translated_source, entry->codeSize);
     }
 
     /* Clean up */
     SDL_spvc_context_destroy(context);
 
-    return compiledResult;
+    entry = SDL_INTERNAL_InsertShaderCacheEntry(cache, entry);
+    return SDL_INTERNAL_CreateFromShaderCacheEntry(device, createInfo, isCompute, entry);
 }
@@ -28,3 +28,15 @@
 extern void *SDL_CompileFromSPIRV(Refresh_Device *device,
                                   void *createInfo,
                                   SDL_bool isCompute);
+
+extern struct ShaderCache *SDL_CreateShaderCache(void);
+
+extern void SDL_DestroyShaderCache(struct ShaderCache *cache);
+
+extern SDL_bool SDL_LoadShaderCacheData(Refresh_Device *device,
+                                        const void *data,
+                                        size_t dataSize);
+
+extern SDL_bool SDL_GetShaderCacheData(Refresh_Device *device,
+                                       void *data,
+                                       size_t *pDataSize);
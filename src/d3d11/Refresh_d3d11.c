@@ -107,6 +107,8 @@ static const IID D3D_IID_IDXGIFactory4 = { 0x1bc6ea02, 0xef36, 0x464f, { 0xbf, 0
 static const IID D3D_IID_IDXGIFactory5 = { 0x7632e1f5, 0xee65, 0x4dca, { 0x87, 0xfd, 0x84, 0xcd, 0x75, 0xf8, 0x83, 0x8d } };
 static const IID D3D_IID_IDXGIFactory6 = { 0xc1b6694f, 0xff09, 0x44a9, { 0xb0, 0x3c, 0x77, 0x90, 0x0a, 0x0a, 0x1d, 0x17 } };
 static const IID D3D_IID_IDXGIAdapter1 = { 0x29038f61, 0x3839, 0x4626, { 0x91, 0xfd, 0x08, 0x68, 0x79, 0x01, 0x1a, 0x05 } };
+static const IID D3D_IID_IDXGIAdapter3 = { 0x645967a4, 0x1392, 0x4310, { 0xa7, 0x98, 0x80, 0x53, 0xce, 0x3e, 0x93, 0xfd } };
+static const IID D3D_IID_IDXGISwapChain2 = { 0xa8be2ac4, 0x199f, 0x4946, { 0xb3, 0x31, 0x79, 0x59, 0x9f, 0xb9, 0x8d, 0xe7 } };
 static const IID D3D_IID_IDXGISwapChain3 = { 0x94d99bdb, 0xf1f8, 0x4ab0, { 0xb2, 0x36, 0x7d, 0xa0, 0x17, 0x0e, 0xda, 0xb1 } };
 static const IID D3D_IID_ID3D11Texture2D = { 0x6f15aaf2, 0xd208, 0x4e89, { 0x9a, 0xb4, 0x48, 0x95, 0x35, 0xd3, 0x4f, 0x9c } };
 static const IID D3D_IID_ID3DUserDefinedAnnotation = { 0xb2daad8b, 0x03d4, 0x4dbf, { 0x95, 0xeb, 0x32, 0xab, 0x4b, 0x63, 0xd0, 0xab } };
@@ -144,6 +146,7 @@ static const GUID D3D_IID_DXGI_DEBUG_ALL = { 0xe48ae283, 0xda80, 0x490b, { 0x87,
 #define WINDOW_PROPERTY_DATA          "Refresh_D3D11WindowPropertyData"
 
 #define REFRESH_SHADERSTAGE_COMPUTE 2
+#define FENCE_POLL_YIELD_COUNT      64 /* Polls that only yield before fence waits start sleeping */
 
 #ifdef _WIN32
 #define HRESULT_FMT "(0x%08lX)"
@@ -468,15 +471,28 @@ typedef struct D3D11TextureContainer
     Uint32 textureCount;
     D3D11Texture **textures;
 
+    /* 0 means no limit. Cycling state is protected by the renderer's cycleLock. */
+    Uint32 maxCycleCount;
+    Uint64 lastCycleFrame;
+
     char *debugName;
 } D3D11TextureContainer;
 
 typedef struct D3D11Fence
 {
     ID3D11Query *handle;
+    Uint64 submissionSerial;
     SDL_atomic_t referenceCount;
 } D3D11Fence;
 
+typedef struct D3D11QueryPool
+{
+    ID3D11Query *disjointQuery; /* Brackets the timestamps so ticks can be converted */
+    ID3D11Query **timestampQueries;
+    Uint32 queryCount;
+    SDL_atomic_t referenceCount;
+} D3D11QueryPool;
+
 typedef struct D3D11WindowData
 {
     SDL_Window *window;
@@ -487,8 +503,11 @@ typedef struct D3D11WindowData
     Refresh_SwapchainComposition swapchainComposition;
     DXGI_FORMAT swapchainFormat;
     DXGI_COLOR_SPACE_TYPE swapchainColorSpace;
+    UINT swapchainFlags;
+    HANDLE frameLatencyWaitableObject; /* NULL without a flip model swapchain */
     D3D11Fence *inFlightFences[MAX_FRAMES_IN_FLIGHT];
     Uint32 frameCounter;
+    Uint32 allowedFramesInFlight; /* Survives swapchain recreation */
 } D3D11WindowData;
 
 typedef struct D3D11Shader
@@ -567,6 +586,10 @@ typedef struct D3D11BufferContainer
 
     D3D11_BUFFER_DESC bufferDesc;
 
+    /* 0 means no limit. Cycling state is protected by the renderer's cycleLock. */
+    Uint32 maxCycleCount;
+    Uint64 lastCycleFrame;
+
     char *debugName;
 } D3D11BufferContainer;
 
@@ -615,6 +638,10 @@ typedef struct D3D11TransferBufferContainer
     Uint32 bufferCapacity;
     Uint32 bufferCount;
     D3D11TransferBuffer **buffers;
+
+    /* 0 means no limit. Cycling state is protected by the renderer's cycleLock. */
+    Uint32 maxCycleCount;
+    Uint64 lastCycleFrame;
 } D3D11TransferBufferContainer;
 
 typedef struct D3D11UniformBuffer
@@ -622,9 +649,7 @@ typedef struct D3D11UniformBuffer
     ID3D11Buffer *buffer;
     void *mappedData;
 
-    Uint32 drawOffset;
     Uint32 writeOffset;
-    Uint32 currentBlockSize;
 } D3D11UniformBuffer;
 
 typedef struct D3D11Renderer D3D11Renderer;
@@ -650,6 +675,21 @@ typedef struct D3D11CommandBuffer
     Uint32 colorTargetResolveSubresourceIndex[MAX_COLOR_TARGET_BINDINGS];
     ID3D11Resource *colorTargetMsaaHandle[MAX_COLOR_TARGET_BINDINGS];
 
+    /* Parallel Render Pass, chunks are recorded on their own deferred contexts */
+    SDL_bool parallelRenderPass;
+    ID3D11RenderTargetView *renderPassColorTargetViews[MAX_COLOR_TARGET_BINDINGS];
+    Uint32 renderPassColorTargetCount;
+    ID3D11DepthStencilView *renderPassDepthStencilView;
+    D3D11_VIEWPORT renderPassViewport;
+    D3D11_RECT renderPassScissorRect;
+
+    struct D3D11CommandBuffer **renderPassChunks; /* Cleaned along with this command buffer */
+    Uint32 renderPassChunkCount;
+    Uint32 renderPassChunkCapacity;
+    Uint32 firstRenderPassChunk; /* The first chunk of the current render pass */
+
+    ID3D11CommandList *chunkCommandList; /* Only set on ended render pass chunks */
+
     /* Compute Pass */
     D3D11ComputePipeline *computePipeline;
 
@@ -685,11 +725,21 @@ typedef struct D3D11CommandBuffer
     ID3D11UnorderedAccessView *computeUnorderedAccessViews[MAX_STORAGE_TEXTURES_PER_STAGE +
                                                            MAX_STORAGE_BUFFERS_PER_STAGE];
 
-    /* Uniform buffers */
+    /* Uniform buffers, every stage and slot sub-allocates from the current one */
+    D3D11UniformBuffer *currentUniformBuffer;
+
     D3D11UniformBuffer *vertexUniformBuffers[MAX_UNIFORM_BUFFERS_PER_STAGE];
     D3D11UniformBuffer *fragmentUniformBuffers[MAX_UNIFORM_BUFFERS_PER_STAGE];
     D3D11UniformBuffer *computeUniformBuffers[MAX_UNIFORM_BUFFERS_PER_STAGE];
 
+    /* Constant buffer windows, in bytes */
+    Uint32 vertexUniformDrawOffsets[MAX_UNIFORM_BUFFERS_PER_STAGE];
+    Uint32 vertexUniformBlockSizes[MAX_UNIFORM_BUFFERS_PER_STAGE];
+    Uint32 fragmentUniformDrawOffsets[MAX_UNIFORM_BUFFERS_PER_STAGE];
+    Uint32 fragmentUniformBlockSizes[MAX_UNIFORM_BUFFERS_PER_STAGE];
+    Uint32 computeUniformDrawOffsets[MAX_UNIFORM_BUFFERS_PER_STAGE];
+    Uint32 computeUniformBlockSizes[MAX_UNIFORM_BUFFERS_PER_STAGE];
+
     /* Fences */
     D3D11Fence *fence;
     Uint8 autoReleaseFence;
@@ -707,9 +757,26 @@ typedef struct D3D11CommandBuffer
     Uint32 usedTextureSubresourceCount;
     Uint32 usedTextureSubresourceCapacity;
 
+    D3D11QueryPool **usedQueryPools;
+    Uint32 usedQueryPoolCount;
+    Uint32 usedQueryPoolCapacity;
+
     D3D11UniformBuffer **usedUniformBuffers;
     Uint32 usedUniformBufferCount;
     Uint32 usedUniformBufferCapacity;
+
+    /* Staging memory is linearly allocated from the current block */
+    D3D11TransferBufferContainer *currentStagingBlock;
+    Uint32 stagingBlockOffset;
+
+    D3D11TransferBufferContainer **usedStagingBlocks;
+    Uint32 usedStagingBlockCount;
+    Uint32 usedStagingBlockCapacity;
+
+    /* Query pools with an open disjoint query */
+    D3D11QueryPool **activeQueryPools;
+    Uint32 activeQueryPoolCount;
+    Uint32 activeQueryPoolCapacity;
 } D3D11CommandBuffer;
 
 typedef struct D3D11Sampler
@@ -768,6 +835,11 @@ struct D3D11Renderer
     Uint32 uniformBufferPoolCount;
     Uint32 uniformBufferPoolCapacity;
 
+    /* STAGING_BLOCK_SIZE transfer buffers */
+    D3D11TransferBufferContainer **stagingBlockPool;
+    Uint32 stagingBlockPoolCount;
+    Uint32 stagingBlockPoolCapacity;
+
     D3D11TransferBufferContainer **transferBufferContainersToDestroy;
     Uint32 transferBufferContainersToDestroyCount;
     Uint32 transferBufferContainersToDestroyCapacity;
@@ -780,11 +852,42 @@ struct D3D11Renderer
     Uint32 textureContainersToDestroyCount;
     Uint32 textureContainersToDestroyCapacity;
 
+    D3D11QueryPool **queryPoolsToDestroy;
+    Uint32 queryPoolsToDestroyCount;
+    Uint32 queryPoolsToDestroyCapacity;
+
+    /* Containers holding more than one resource, trimmed under cycleLock */
+    D3D11TransferBufferContainer **cycledTransferBufferContainers;
+    Uint32 cycledTransferBufferContainerCount;
+    Uint32 cycledTransferBufferContainerCapacity;
+
+    D3D11BufferContainer **cycledBufferContainers;
+    Uint32 cycledBufferContainerCount;
+    Uint32 cycledBufferContainerCapacity;
+
+    D3D11TextureContainer **cycledTextureContainers;
+    Uint32 cycledTextureContainerCount;
+    Uint32 cycledTextureContainerCapacity;
+
+    Uint64 presentedFrameCount;
+    Uint32 cycleTrimFrames;
+
+    Uint64 submissionSerial; /* Incremented under contextLock on submit */
+
+    Uint64 cycleHandlesCreated;
+    Uint64 cycleHandlesTrimmed;
+    Uint64 cycleLimitHits;
+
+    SDL_atomic_t fenceWakeCount; /* Bumped to wake the fence callback waiter */
+    int fenceWakeConsumed;       /* Only touched by the waiter */
+
     SDL_mutex *contextLock;
     SDL_mutex *acquireCommandBufferLock;
     SDL_mutex *acquireUniformBufferLock;
+    SDL_mutex *acquireStagingBlockLock;
     SDL_mutex *fenceLock;
     SDL_mutex *windowLock;
+    SDL_mutex *cycleLock;
 };
 
 /* Null arrays for resetting shader resource slots */
@@ -909,29 +1012,39 @@ static DXGI_FORMAT D3D11_INTERNAL_GetSampleableFormat(
 
 /* Quit */
 
-static void D3D11_INTERNAL_DestroyBufferContainer(
-    D3D11BufferContainer *container)
+static void D3D11_INTERNAL_DestroyBuffer(
+    D3D11Buffer *d3d11Buffer)
 {
-    for (Uint32 i = 0; i < container->bufferCount; i += 1) {
-        D3D11Buffer *d3d11Buffer = container->buffers[i];
+    if (d3d11Buffer->uav != NULL) {
+        ID3D11UnorderedAccessView_Release(d3d11Buffer->uav);
+    }
 
-        if (d3d11Buffer->uav != NULL) {
-            ID3D11UnorderedAccessView_Release(d3d11Buffer->uav);
-        }
+    if (d3d11Buffer->srv != NULL) {
+        ID3D11ShaderResourceView_Release(d3d11Buffer->srv);
+    }
 
-        if (d3d11Buffer->srv != NULL) {
-            ID3D11ShaderResourceView_Release(d3d11Buffer->srv);
-        }
+    ID3D11Buffer_Release(d3d11Buffer->handle);
 
-        ID3D11Buffer_Release(d3d11Buffer->handle);
+    SDL_free(d3d11Buffer);
+}
 
-        SDL_free(d3d11Buffer);
+static void D3D11_INTERNAL_DestroyBufferContainer(
+    D3D11BufferContainer *container)
+{
+    for (Uint32 i = 0; i < container->bufferCount; i += 1) {
+        D3D11_INTERNAL_DestroyBuffer(container->buffers[i]);
     }
 
     SDL_free(container->buffers);
     SDL_free(container);
 }
 
+static void D3D11_INTERNAL_DestroyTransferBufferContainer(
+    D3D11TransferBufferContainer *transferBufferContainer);
+
+static void D3D11_INTERNAL_DestroyQueryPool(
+    D3D11QueryPool *queryPool);
+
 static void D3D11_DestroyDevice(
     Refresh_Device *device)
 {
@@ -956,6 +1069,13 @@ static void D3D11_DestroyDevice(
     }
     SDL_free(renderer->uniformBufferPool);
 
+    /* Release staging blocks */
+    for (Uint32 i = 0; i < renderer->stagingBlockPoolCount; i += 1) {
+        D3D11_INTERNAL_DestroyTransferBufferContainer(renderer->stagingBlockPool[i]);
+        SDL_free(renderer->stagingBlockPool[i]);
+    }
+    SDL_free(renderer->stagingBlockPool);
+
     /* Release command buffer infrastructure */
     for (Uint32 i = 0; i < renderer->availableCommandBufferCount; i += 1) {
         D3D11CommandBuffer *commandBuffer = renderer->availableCommandBuffers[i];
@@ -965,6 +1085,10 @@ static void D3D11_DestroyDevice(
         ID3D11DeviceContext_Release(commandBuffer->context);
         SDL_free(commandBuffer->usedBuffers);
         SDL_free(commandBuffer->usedTransferBuffers);
+        SDL_free(commandBuffer->usedQueryPools);
+        SDL_free(commandBuffer->usedStagingBlocks);
+        SDL_free(commandBuffer->activeQueryPools);
+        SDL_free(commandBuffer->renderPassChunks);
         SDL_free(commandBuffer);
     }
     SDL_free(renderer->availableCommandBuffers);
@@ -978,6 +1102,14 @@ static void D3D11_DestroyDevice(
     }
     SDL_free(renderer->availableFences);
 
+    /* D3D11_Wait already destroyed every released query pool */
+    SDL_free(renderer->queryPoolsToDestroy);
+
+    /* Release the cycled container lists, the containers are owned by the client */
+    SDL_free(renderer->cycledTransferBufferContainers);
+    SDL_free(renderer->cycledBufferContainers);
+    SDL_free(renderer->cycledTextureContainers);
+
     /* Release the iconv, if applicable */
     if (renderer->iconv != NULL) {
         SDL_iconv_close(renderer->iconv);
@@ -986,9 +1118,11 @@ static void D3D11_DestroyDevice(
     /* Release the mutexes */
     SDL_DestroyMutex(renderer->acquireCommandBufferLock);
     SDL_DestroyMutex(renderer->acquireUniformBufferLock);
+    SDL_DestroyMutex(renderer->acquireStagingBlockLock);
     SDL_DestroyMutex(renderer->contextLock);
     SDL_DestroyMutex(renderer->fenceLock);
     SDL_DestroyMutex(renderer->windowLock);
+    SDL_DestroyMutex(renderer->cycleLock);
 
     /* Release the device and associated objects */
     ID3D11DeviceContext_Release(renderer->immediateContext);
@@ -1050,6 +1184,18 @@ static void D3D11_INTERNAL_TrackTransferBuffer(
         usedTransferBufferCapacity);
 }
 
+static void D3D11_INTERNAL_TrackQueryPool(
+    D3D11CommandBuffer *commandBuffer,
+    D3D11QueryPool *queryPool)
+{
+    TRACK_RESOURCE(
+        queryPool,
+        D3D11QueryPool *,
+        usedQueryPools,
+        usedQueryPoolCount,
+        usedQueryPoolCapacity);
+}
+
 static void D3D11_INTERNAL_TrackTextureSubresource(
     D3D11CommandBuffer *commandBuffer,
     D3D11TextureSubresource *textureSubresource)
@@ -1142,6 +1288,16 @@ static void D3D11_ReleaseTexture(
 
     SDL_LockMutex(renderer->contextLock);
 
+    SDL_LockMutex(renderer->cycleLock);
+    for (Uint32 i = 0; i < renderer->cycledTextureContainerCount; i += 1) {
+        if (renderer->cycledTextureContainers[i] == container) {
+            renderer->cycledTextureContainers[i] = renderer->cycledTextureContainers[renderer->cycledTextureContainerCount - 1];
+            renderer->cycledTextureContainerCount -= 1;
+            break;
+        }
+    }
+    SDL_UnlockMutex(renderer->cycleLock);
+
     EXPAND_ARRAY_IF_NEEDED(
         renderer->textureContainersToDestroy,
         D3D11TextureContainer *,
@@ -1174,6 +1330,16 @@ static void D3D11_ReleaseBuffer(
 
     SDL_LockMutex(renderer->contextLock);
 
+    SDL_LockMutex(renderer->cycleLock);
+    for (Uint32 i = 0; i < renderer->cycledBufferContainerCount; i += 1) {
+        if (renderer->cycledBufferContainers[i] == container) {
+            renderer->cycledBufferContainers[i] = renderer->cycledBufferContainers[renderer->cycledBufferContainerCount - 1];
+            renderer->cycledBufferContainerCount -= 1;
+            break;
+        }
+    }
+    SDL_UnlockMutex(renderer->cycleLock);
+
     EXPAND_ARRAY_IF_NEEDED(
         renderer->bufferContainersToDestroy,
         D3D11BufferContainer *,
@@ -1192,9 +1358,20 @@ static void D3D11_ReleaseTransferBuffer(
     Refresh_TransferBuffer *transferBuffer)
 {
     D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+    D3D11TransferBufferContainer *container = (D3D11TransferBufferContainer *)transferBuffer;
 
     SDL_LockMutex(renderer->contextLock);
 
+    SDL_LockMutex(renderer->cycleLock);
+    for (Uint32 i = 0; i < renderer->cycledTransferBufferContainerCount; i += 1) {
+        if (renderer->cycledTransferBufferContainers[i] == container) {
+            renderer->cycledTransferBufferContainers[i] = renderer->cycledTransferBufferContainers[renderer->cycledTransferBufferContainerCount - 1];
+            renderer->cycledTransferBufferContainerCount -= 1;
+            break;
+        }
+    }
+    SDL_UnlockMutex(renderer->cycleLock);
+
     EXPAND_ARRAY_IF_NEEDED(
         renderer->transferBufferContainersToDestroy,
         D3D11TransferBufferContainer *,
@@ -1202,24 +1379,30 @@ static void D3D11_ReleaseTransferBuffer(
         renderer->transferBufferContainersToDestroyCapacity,
         renderer->transferBufferContainersToDestroyCapacity + 1);
 
-    renderer->transferBufferContainersToDestroy[renderer->transferBufferContainersToDestroyCount] = (D3D11TransferBufferContainer *)transferBuffer;
+    renderer->transferBufferContainersToDestroy[renderer->transferBufferContainersToDestroyCount] = container;
     renderer->transferBufferContainersToDestroyCount += 1;
 
     SDL_UnlockMutex(renderer->contextLock);
 }
 
+static void D3D11_INTERNAL_DestroyTransferBuffer(
+    D3D11TransferBuffer *transferBuffer)
+{
+    if (transferBuffer->bufferDownloadCount > 0) {
+        SDL_free(transferBuffer->bufferDownloads);
+    }
+    if (transferBuffer->textureDownloadCount > 0) {
+        SDL_free(transferBuffer->textureDownloads);
+    }
+    SDL_free(transferBuffer->data);
+    SDL_free(transferBuffer);
+}
+
 static void D3D11_INTERNAL_DestroyTransferBufferContainer(
     D3D11TransferBufferContainer *transferBufferContainer)
 {
     for (Uint32 i = 0; i < transferBufferContainer->bufferCount; i += 1) {
-        if (transferBufferContainer->buffers[i]->bufferDownloadCount > 0) {
-            SDL_free(transferBufferContainer->buffers[i]->bufferDownloads);
-        }
-        if (transferBufferContainer->buffers[i]->textureDownloadCount > 0) {
-            SDL_free(transferBufferContainer->buffers[i]->textureDownloads);
-        }
-        SDL_free(transferBufferContainer->buffers[i]->data);
-        SDL_free(transferBufferContainer->buffers[i]);
+        D3D11_INTERNAL_DestroyTransferBuffer(transferBufferContainer->buffers[i]);
     }
     SDL_free(transferBufferContainer->buffers);
 }
@@ -1458,6 +1641,38 @@ static ID3D11InputLayout *D3D11_INTERNAL_FetchInputLayout(
 
 /* Pipeline Creation */
 
+static ID3DBlob *D3D11_INTERNAL_CompileHLSL(
+    D3D11Renderer *renderer,
+    Uint32 stage,
+    const Uint8 *code,
+    size_t codeSize)
+{
+    const char *profiles[3] = { "vs_5_0", "ps_5_0", "cs_5_0" };
+    ID3DBlob *blob = NULL;
+    ID3DBlob *errorBlob;
+    HRESULT res;
+
+    res = renderer->D3DCompile_func(
+        code,
+        codeSize,
+        NULL,
+        NULL,
+        NULL,
+        "main", /* entry point name ignored */
+        profiles[stage],
+        0,
+        0,
+        &blob,
+        &errorBlob);
+    if (res < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", (const char *)ID3D10Blob_GetBufferPointer(errorBlob));
+        ID3D10Blob_Release(errorBlob);
+        return NULL;
+    }
+
+    return blob;
+}
+
 static ID3D11DeviceChild *D3D11_INTERNAL_CreateID3D11Shader(
     D3D11Renderer *renderer,
     Uint32 stage,
@@ -1468,30 +1683,15 @@ static ID3D11DeviceChild *D3D11_INTERNAL_CreateID3D11Shader(
     void **pBytecode,
     size_t *pBytecodeSize)
 {
-    const char *profiles[3] = { "vs_5_0", "ps_5_0", "cs_5_0" };
     ID3DBlob *blob = NULL;
-    ID3DBlob *errorBlob;
     const Uint8 *bytecode;
     size_t bytecodeSize;
     ID3D11DeviceChild *handle = NULL;
     HRESULT res;
 
     if (format == REFRESH_SHADERFORMAT_HLSL) {
-        res = renderer->D3DCompile_func(
-            code,
-            codeSize,
-            NULL,
-            NULL,
-            NULL,
-            "main", /* entry point name ignored */
-            profiles[stage],
-            0,
-            0,
-            &blob,
-            &errorBlob);
-        if (res < 0) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", (const char *)ID3D10Blob_GetBufferPointer(errorBlob));
-            ID3D10Blob_Release(errorBlob);
+        blob = D3D11_INTERNAL_CompileHLSL(renderer, stage, code, codeSize);
+        if (blob == NULL) {
             return NULL;
         }
         bytecode = ID3D10Blob_GetBufferPointer(blob);
@@ -2316,6 +2516,8 @@ static Refresh_Texture *D3D11_CreateTexture(
     container->textures = SDL_malloc(
         container->textureCapacity * sizeof(D3D11Texture *));
     container->textures[0] = texture;
+    container->maxCycleCount = 0;
+    container->lastCycleFrame = 0;
     container->debugName = NULL;
 
     return (Refresh_Texture *)container;
@@ -2325,6 +2527,10 @@ static void D3D11_INTERNAL_CycleActiveTexture(
     D3D11Renderer *renderer,
     D3D11TextureContainer *container)
 {
+    SDL_LockMutex(renderer->cycleLock);
+
+    container->lastCycleFrame = renderer->presentedFrameCount;
+
     for (Uint32 i = 0; i < container->textureCount; i += 1) {
         Uint32 refCountTotal = 0;
         for (Uint32 j = 0; j < container->textures[i]->subresourceCount; j += 1) {
@@ -2333,10 +2539,18 @@ static void D3D11_INTERNAL_CycleActiveTexture(
 
         if (refCountTotal == 0) {
             container->activeTexture = container->textures[i];
+            SDL_UnlockMutex(renderer->cycleLock);
             return;
         }
     }
 
+    /* At the limit the active texture is kept, as if cycle were false. */
+    if (container->maxCycleCount > 0 && container->textureCount >= container->maxCycleCount) {
+        renderer->cycleLimitHits += 1;
+        SDL_UnlockMutex(renderer->cycleLock);
+        return;
+    }
+
     EXPAND_ARRAY_IF_NEEDED(
         container->textures,
         D3D11Texture *,
@@ -2352,6 +2566,22 @@ static void D3D11_INTERNAL_CycleActiveTexture(
 
     container->activeTexture = container->textures[container->textureCount - 1];
 
+    renderer->cycleHandlesCreated += 1;
+
+    if (container->textureCount == 2) {
+        EXPAND_ARRAY_IF_NEEDED(
+            renderer->cycledTextureContainers,
+            D3D11TextureContainer *,
+            renderer->cycledTextureContainerCount + 1,
+            renderer->cycledTextureContainerCapacity,
+            renderer->cycledTextureContainerCapacity + 1);
+
+        renderer->cycledTextureContainers[renderer->cycledTextureContainerCount] = container;
+        renderer->cycledTextureContainerCount += 1;
+    }
+
+    SDL_UnlockMutex(renderer->cycleLock);
+
     if (renderer->debugMode && container->debugName != NULL) {
         D3D11_INTERNAL_SetTextureName(
             renderer,
@@ -2530,6 +2760,8 @@ static Refresh_Buffer *D3D11_CreateBuffer(
         container->bufferCapacity * sizeof(D3D11Buffer *));
     container->buffers[0] = container->activeBuffer;
     container->bufferDesc = bufferDesc;
+    container->maxCycleCount = 0;
+    container->lastCycleFrame = 0;
     container->debugName = NULL;
 
     return (Refresh_Buffer *)container;
@@ -2560,9 +2792,8 @@ static D3D11UniformBuffer *D3D11_INTERNAL_CreateUniformBuffer(
 
     uniformBuffer = SDL_malloc(sizeof(D3D11UniformBuffer));
     uniformBuffer->buffer = buffer;
+    uniformBuffer->mappedData = NULL;
     uniformBuffer->writeOffset = 0;
-    uniformBuffer->drawOffset = 0;
-    uniformBuffer->currentBlockSize = 0;
 
     return uniformBuffer;
 }
@@ -2573,13 +2804,25 @@ static void D3D11_INTERNAL_CycleActiveBuffer(
 {
     Uint32 size = container->activeBuffer->size;
 
+    SDL_LockMutex(renderer->cycleLock);
+
+    container->lastCycleFrame = renderer->presentedFrameCount;
+
     for (Uint32 i = 0; i < container->bufferCount; i += 1) {
         if (SDL_AtomicGet(&container->buffers[i]->referenceCount) == 0) {
             container->activeBuffer = container->buffers[i];
+            SDL_UnlockMutex(renderer->cycleLock);
             return;
         }
     }
 
+    /* At the limit the active buffer is kept, as if cycle were false. */
+    if (container->maxCycleCount > 0 && container->bufferCount >= container->maxCycleCount) {
+        renderer->cycleLimitHits += 1;
+        SDL_UnlockMutex(renderer->cycleLock);
+        return;
+    }
+
     EXPAND_ARRAY_IF_NEEDED(
         container->buffers,
         D3D11Buffer *,
@@ -2595,6 +2838,22 @@ static void D3D11_INTERNAL_CycleActiveBuffer(
 
     container->activeBuffer = container->buffers[container->bufferCount - 1];
 
+    renderer->cycleHandlesCreated += 1;
+
+    if (container->bufferCount == 2) {
+        EXPAND_ARRAY_IF_NEEDED(
+            renderer->cycledBufferContainers,
+            D3D11BufferContainer *,
+            renderer->cycledBufferContainerCount + 1,
+            renderer->cycledBufferContainerCapacity,
+            renderer->cycledBufferContainerCapacity + 1);
+
+        renderer->cycledBufferContainers[renderer->cycledBufferContainerCount] = container;
+        renderer->cycledBufferContainerCount += 1;
+    }
+
+    SDL_UnlockMutex(renderer->cycleLock);
+
     if (renderer->debugMode && container->debugName != NULL) {
         D3D11_INTERNAL_SetBufferName(
             renderer,
@@ -2659,6 +2918,8 @@ static Refresh_TransferBuffer *D3D11_CreateTransferBuffer(
         sizeInBytes);
 
     container->activeBuffer = container->buffers[0];
+    container->maxCycleCount = 0;
+    container->lastCycleFrame = 0;
 
     return (Refresh_TransferBuffer *)container;
 }
@@ -2671,13 +2932,25 @@ static void D3D11_INTERNAL_CycleActiveTransferBuffer(
 {
     Uint32 size = container->activeBuffer->size;
 
+    SDL_LockMutex(renderer->cycleLock);
+
+    container->lastCycleFrame = renderer->presentedFrameCount;
+
     for (Uint32 i = 0; i < container->bufferCount; i += 1) {
         if (SDL_AtomicGet(&container->buffers[i]->referenceCount) == 0) {
             container->activeBuffer = container->buffers[i];
+            SDL_UnlockMutex(renderer->cycleLock);
             return;
         }
     }
 
+    /* At the limit the active buffer is kept and may be overwritten while in flight. */
+    if (container->maxCycleCount > 0 && container->bufferCount >= container->maxCycleCount) {
+        renderer->cycleLimitHits += 1;
+        SDL_UnlockMutex(renderer->cycleLock);
+        return;
+    }
+
     EXPAND_ARRAY_IF_NEEDED(
         container->buffers,
         D3D11TransferBuffer *,
@@ -2691,6 +2964,22 @@ static void D3D11_INTERNAL_CycleActiveTransferBuffer(
     container->bufferCount += 1;
 
     container->activeBuffer = container->buffers[container->bufferCount - 1];
+
+    renderer->cycleHandlesCreated += 1;
+
+    if (container->bufferCount == 2) {
+        EXPAND_ARRAY_IF_NEEDED(
+            renderer->cycledTransferBufferContainers,
+            D3D11TransferBufferContainer *,
+            renderer->cycledTransferBufferContainerCount + 1,
+            renderer->cycledTransferBufferContainerCapacity,
+            renderer->cycledTransferBufferContainerCapacity + 1);
+
+        renderer->cycledTransferBufferContainers[renderer->cycledTransferBufferContainerCount] = container;
+        renderer->cycledTransferBufferContainerCount += 1;
+    }
+
+    SDL_UnlockMutex(renderer->cycleLock);
 }
 
 static void D3D11_MapTransferBuffer(
@@ -2907,6 +3196,112 @@ static void D3D11_UploadToBuffer(
     D3D11_INTERNAL_TrackTransferBuffer(d3d11CommandBuffer, d3d11TransferBuffer);
 }
 
+static D3D11TransferBufferContainer *D3D11_INTERNAL_AcquireStagingBlock(
+    D3D11CommandBuffer *commandBuffer,
+    Uint32 sizeInBytes)
+{
+    D3D11Renderer *renderer = commandBuffer->renderer;
+    D3D11TransferBufferContainer *stagingBlock = NULL;
+
+    if (sizeInBytes <= STAGING_BLOCK_SIZE) {
+        SDL_LockMutex(renderer->acquireStagingBlockLock);
+
+        if (renderer->stagingBlockPoolCount > 0) {
+            stagingBlock = renderer->stagingBlockPool[renderer->stagingBlockPoolCount - 1];
+            renderer->stagingBlockPoolCount -= 1;
+        }
+
+        SDL_UnlockMutex(renderer->acquireStagingBlockLock);
+
+        sizeInBytes = STAGING_BLOCK_SIZE;
+    }
+
+    if (stagingBlock == NULL) {
+        stagingBlock = (D3D11TransferBufferContainer *)D3D11_CreateTransferBuffer(
+            (Refresh_Renderer *)renderer,
+            REFRESH_TRANSFERBUFFERUSAGE_UPLOAD,
+            sizeInBytes);
+    }
+
+    EXPAND_ARRAY_IF_NEEDED(
+        commandBuffer->usedStagingBlocks,
+        D3D11TransferBufferContainer *,
+        commandBuffer->usedStagingBlockCount + 1,
+        commandBuffer->usedStagingBlockCapacity,
+        commandBuffer->usedStagingBlockCapacity * 2);
+
+    commandBuffer->usedStagingBlocks[commandBuffer->usedStagingBlockCount] = stagingBlock;
+    commandBuffer->usedStagingBlockCount += 1;
+
+    D3D11_INTERNAL_TrackTransferBuffer(commandBuffer, stagingBlock->activeBuffer);
+
+    return stagingBlock;
+}
+
+/* Dedicated blocks for oversized requests are released instead of pooled */
+static void D3D11_INTERNAL_ReturnStagingBlockToPool(
+    D3D11Renderer *renderer,
+    D3D11TransferBufferContainer *stagingBlock)
+{
+    if (stagingBlock->activeBuffer->size != STAGING_BLOCK_SIZE) {
+        D3D11_ReleaseTransferBuffer(
+            (Refresh_Renderer *)renderer,
+            (Refresh_TransferBuffer *)stagingBlock);
+        return;
+    }
+
+    EXPAND_ARRAY_IF_NEEDED(
+        renderer->stagingBlockPool,
+        D3D11TransferBufferContainer *,
+        renderer->stagingBlockPoolCount + 1,
+        renderer->stagingBlockPoolCapacity,
+        renderer->stagingBlockPoolCapacity * 2);
+
+    renderer->stagingBlockPool[renderer->stagingBlockPoolCount] = stagingBlock;
+    renderer->stagingBlockPoolCount += 1;
+}
+
+/* D3D11 uploads consume the source data at record time, but the ranges are still
+ * held until the command buffer completes so all backends share one lifetime.
+ */
+static void *D3D11_AcquireStagingMemory(
+    Refresh_CommandBuffer *commandBuffer,
+    Uint32 sizeInBytes,
+    Refresh_TransferBufferLocation *location)
+{
+    D3D11CommandBuffer *d3d11CommandBuffer = (D3D11CommandBuffer *)commandBuffer;
+    D3D11TransferBufferContainer *stagingBlock;
+    Uint32 offset = 0;
+
+    if (sizeInBytes > STAGING_BLOCK_SIZE) {
+        /* The current block keeps serving smaller requests */
+        stagingBlock = D3D11_INTERNAL_AcquireStagingBlock(
+            d3d11CommandBuffer,
+            sizeInBytes);
+    } else {
+        offset = D3D11_INTERNAL_NextHighestAlignment(
+            d3d11CommandBuffer->stagingBlockOffset,
+            STAGING_BLOCK_ALIGNMENT);
+
+        if (
+            d3d11CommandBuffer->currentStagingBlock == NULL ||
+            offset + sizeInBytes > STAGING_BLOCK_SIZE) {
+            d3d11CommandBuffer->currentStagingBlock = D3D11_INTERNAL_AcquireStagingBlock(
+                d3d11CommandBuffer,
+                sizeInBytes);
+            offset = 0;
+        }
+
+        stagingBlock = d3d11CommandBuffer->currentStagingBlock;
+        d3d11CommandBuffer->stagingBlockOffset = offset + sizeInBytes;
+    }
+
+    location->transferBuffer = (Refresh_TransferBuffer *)stagingBlock;
+    location->offset = offset;
+
+    return stagingBlock->activeBuffer->data + offset;
+}
+
 static void D3D11_DownloadFromTexture(
     Refresh_CommandBuffer *commandBuffer,
     Refresh_TextureRegion *source,
@@ -3143,13 +3538,194 @@ static void D3D11_CopyBufferToBuffer(
     D3D11_INTERNAL_TrackBuffer(d3d11CommandBuffer, dstBuffer);
 }
 
+/* Cycling is only considered the first time a container appears in a batch,
+ * so later regions cannot discard the writes of earlier ones.
+ */
+static SDL_bool D3D11_INTERNAL_ShouldCycleInBatch(
+    void **preparedContainers,
+    Uint32 *preparedContainerCount,
+    void *container,
+    SDL_bool cycle)
+{
+    for (Uint32 i = 0; i < *preparedContainerCount; i += 1) {
+        if (preparedContainers[i] == container) {
+            return SDL_FALSE;
+        }
+    }
+
+    preparedContainers[*preparedContainerCount] = container;
+    *preparedContainerCount += 1;
+
+    return cycle;
+}
+
+static void D3D11_UploadToTextureRegions(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_TextureTransferInfo *sources,
+    Refresh_TextureRegion *destinations,
+    Uint32 regionCount,
+    SDL_bool cycle)
+{
+    void **preparedContainers = SDL_malloc(regionCount * sizeof(void *));
+    Uint32 preparedContainerCount = 0;
+
+    /* Each texture region still needs its own staging texture, see D3D11_UploadToTexture */
+    for (Uint32 i = 0; i < regionCount; i += 1) {
+        D3D11_UploadToTexture(
+            commandBuffer,
+            &sources[i],
+            &destinations[i],
+            D3D11_INTERNAL_ShouldCycleInBatch(
+                preparedContainers,
+                &preparedContainerCount,
+                destinations[i].textureSlice.texture,
+                cycle));
+    }
+
+    SDL_free(preparedContainers);
+}
+
+static void D3D11_UploadToBufferRegions(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_TransferBufferLocation *sources,
+    Refresh_BufferRegion *destinations,
+    Uint32 regionCount,
+    SDL_bool cycle)
+{
+    D3D11CommandBuffer *d3d11CommandBuffer = (D3D11CommandBuffer *)commandBuffer;
+    D3D11Renderer *renderer = (D3D11Renderer *)d3d11CommandBuffer->renderer;
+    void **preparedContainers = SDL_malloc(regionCount * sizeof(void *));
+    Uint32 preparedContainerCount = 0;
+    D3D11TransferBuffer *d3d11TransferBuffer;
+    D3D11Buffer *d3d11Buffer;
+    ID3D11Buffer *stagingBuffer;
+    D3D11_BUFFER_DESC stagingBufferDesc;
+    D3D11_SUBRESOURCE_DATA stagingBufferData;
+    D3D11_BOX srcBox;
+    Uint32 runStart = 0;
+    Uint32 runEnd;
+    Uint32 stagingStart;
+    Uint32 stagingEnd;
+    HRESULT res;
+
+    while (runStart < regionCount) {
+        /* Consecutive regions from one transfer buffer share a single staging buffer */
+        stagingStart = sources[runStart].offset;
+        stagingEnd = sources[runStart].offset + destinations[runStart].size;
+
+        for (runEnd = runStart + 1; runEnd < regionCount; runEnd += 1) {
+            if (sources[runEnd].transferBuffer != sources[runStart].transferBuffer) {
+                break;
+            }
+            stagingStart = SDL_min(stagingStart, sources[runEnd].offset);
+            stagingEnd = SDL_max(stagingEnd, sources[runEnd].offset + destinations[runEnd].size);
+        }
+
+        d3d11TransferBuffer = ((D3D11TransferBufferContainer *)sources[runStart].transferBuffer)->activeBuffer;
+
+        stagingBufferDesc.ByteWidth = stagingEnd - stagingStart;
+        stagingBufferDesc.Usage = D3D11_USAGE_STAGING;
+        stagingBufferDesc.BindFlags = 0;
+        stagingBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        stagingBufferDesc.MiscFlags = 0;
+        stagingBufferDesc.StructureByteStride = 0;
+
+        stagingBufferData.pSysMem = d3d11TransferBuffer->data + stagingStart;
+        stagingBufferData.SysMemPitch = 0;
+        stagingBufferData.SysMemSlicePitch = 0;
+
+        res = ID3D11Device_CreateBuffer(
+            renderer->device,
+            &stagingBufferDesc,
+            &stagingBufferData,
+            &stagingBuffer);
+        if (FAILED(res)) {
+            D3D11_INTERNAL_LogError(renderer->device, "Could not create staging buffer", res);
+            break;
+        }
+
+        for (Uint32 i = runStart; i < runEnd; i += 1) {
+            d3d11Buffer = D3D11_INTERNAL_PrepareBufferForWrite(
+                renderer,
+                (D3D11BufferContainer *)destinations[i].buffer,
+                D3D11_INTERNAL_ShouldCycleInBatch(
+                    preparedContainers,
+                    &preparedContainerCount,
+                    destinations[i].buffer,
+                    cycle));
+
+            srcBox.left = sources[i].offset - stagingStart;
+            srcBox.top = 0;
+            srcBox.front = 0;
+            srcBox.right = sources[i].offset - stagingStart + destinations[i].size;
+            srcBox.bottom = 1;
+            srcBox.back = 1;
+
+            ID3D11DeviceContext1_CopySubresourceRegion(
+                d3d11CommandBuffer->context,
+                (ID3D11Resource *)d3d11Buffer->handle,
+                0,
+                destinations[i].offset,
+                0,
+                0,
+                (ID3D11Resource *)stagingBuffer,
+                0,
+                &srcBox);
+
+            D3D11_INTERNAL_TrackBuffer(d3d11CommandBuffer, d3d11Buffer);
+        }
+
+        ID3D11Buffer_Release(stagingBuffer);
+
+        D3D11_INTERNAL_TrackTransferBuffer(d3d11CommandBuffer, d3d11TransferBuffer);
+
+        runStart = runEnd;
+    }
+
+    SDL_free(preparedContainers);
+}
+
+static void D3D11_CopyBufferToBufferRegions(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_BufferLocation *sources,
+    Refresh_BufferRegion *destinations,
+    Uint32 regionCount,
+    SDL_bool cycle)
+{
+    void **preparedContainers = SDL_malloc(regionCount * sizeof(void *));
+    Uint32 preparedContainerCount = 0;
+    Refresh_BufferLocation destination;
+
+    for (Uint32 i = 0; i < regionCount; i += 1) {
+        destination.buffer = destinations[i].buffer;
+        destination.offset = destinations[i].offset;
+
+        D3D11_CopyBufferToBuffer(
+            commandBuffer,
+            &sources[i],
+            &destination,
+            destinations[i].size,
+            D3D11_INTERNAL_ShouldCycleInBatch(
+                preparedContainers,
+                &preparedContainerCount,
+                destinations[i].buffer,
+                cycle));
+    }
+
+    SDL_free(preparedContainers);
+}
+
 static void D3D11_GenerateMipmaps(
     Refresh_CommandBuffer *commandBuffer,
-    Refresh_Texture *texture)
+    Refresh_Texture *texture,
+    Refresh_Filter filterMode)
 {
     D3D11CommandBuffer *d3d11CommandBuffer = (D3D11CommandBuffer *)commandBuffer;
     D3D11TextureContainer *d3d11TextureContainer = (D3D11TextureContainer *)texture;
 
+    /* GenerateMips always uses the driver's own filter */
+    (void)filterMode;
+
     ID3D11DeviceContext1_GenerateMips(
         d3d11CommandBuffer->context,
         d3d11TextureContainer->activeTexture->shaderView);
@@ -3221,11 +3797,31 @@ static void D3D11_INTERNAL_AllocateCommandBuffers(
         commandBuffer->usedTextureSubresources = SDL_malloc(
             commandBuffer->usedTextureSubresourceCapacity * sizeof(D3D11TextureSubresource *));
 
+        commandBuffer->usedQueryPoolCapacity = 4;
+        commandBuffer->usedQueryPoolCount = 0;
+        commandBuffer->usedQueryPools = SDL_malloc(
+            commandBuffer->usedQueryPoolCapacity * sizeof(D3D11QueryPool *));
+
         commandBuffer->usedUniformBufferCapacity = 4;
         commandBuffer->usedUniformBufferCount = 0;
         commandBuffer->usedUniformBuffers = SDL_malloc(
             commandBuffer->usedUniformBufferCapacity * sizeof(D3D11UniformBuffer *));
 
+        commandBuffer->usedStagingBlockCapacity = 4;
+        commandBuffer->usedStagingBlockCount = 0;
+        commandBuffer->usedStagingBlocks = SDL_malloc(
+            commandBuffer->usedStagingBlockCapacity * sizeof(D3D11TransferBufferContainer *));
+
+        commandBuffer->activeQueryPoolCapacity = 1;
+        commandBuffer->activeQueryPoolCount = 0;
+        commandBuffer->activeQueryPools = SDL_malloc(
+            commandBuffer->activeQueryPoolCapacity * sizeof(D3D11QueryPool *));
+
+        commandBuffer->renderPassChunkCapacity = 4;
+        commandBuffer->renderPassChunkCount = 0;
+        commandBuffer->renderPassChunks = SDL_malloc(
+            commandBuffer->renderPassChunkCapacity * sizeof(D3D11CommandBuffer *));
+
         renderer->availableCommandBuffers[renderer->availableCommandBufferCount] = commandBuffer;
         renderer->availableCommandBufferCount += 1;
     }
@@ -3312,16 +3908,11 @@ static SDL_bool D3D11_INTERNAL_AcquireFence(
     return SDL_TRUE;
 }
 
-static Refresh_CommandBuffer *D3D11_AcquireCommandBuffer(
-    Refresh_Renderer *driverData)
+static void D3D11_INTERNAL_ResetCommandBufferState(
+    D3D11CommandBuffer *commandBuffer)
 {
-    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
-    D3D11CommandBuffer *commandBuffer;
     Uint32 i;
 
-    SDL_LockMutex(renderer->acquireCommandBufferLock);
-
-    commandBuffer = D3D11_INTERNAL_GetInactiveCommandBufferFromPool(renderer);
     commandBuffer->graphicsPipeline = NULL;
     commandBuffer->computePipeline = NULL;
     for (i = 0; i < MAX_COLOR_TARGET_BINDINGS; i += 1) {
@@ -3330,12 +3921,23 @@ static Refresh_CommandBuffer *D3D11_AcquireCommandBuffer(
         commandBuffer->colorTargetMsaaHandle[i] = NULL;
     }
 
+    commandBuffer->currentUniformBuffer = NULL;
+    commandBuffer->currentStagingBlock = NULL;
+    commandBuffer->stagingBlockOffset = 0;
+
     for (i = 0; i < MAX_UNIFORM_BUFFERS_PER_STAGE; i += 1) {
         commandBuffer->vertexUniformBuffers[i] = NULL;
         commandBuffer->fragmentUniformBuffers[i] = NULL;
         commandBuffer->computeUniformBuffers[i] = NULL;
     }
 
+    SDL_zeroa(commandBuffer->vertexUniformDrawOffsets);
+    SDL_zeroa(commandBuffer->vertexUniformBlockSizes);
+    SDL_zeroa(commandBuffer->fragmentUniformDrawOffsets);
+    SDL_zeroa(commandBuffer->fragmentUniformBlockSizes);
+    SDL_zeroa(commandBuffer->computeUniformDrawOffsets);
+    SDL_zeroa(commandBuffer->computeUniformBlockSizes);
+
     commandBuffer->needVertexSamplerBind = SDL_TRUE;
     commandBuffer->needVertexResourceBind = SDL_TRUE;
     commandBuffer->needVertexUniformBufferBind = SDL_TRUE;
@@ -3353,6 +3955,25 @@ static Refresh_CommandBuffer *D3D11_AcquireCommandBuffer(
     SDL_zeroa(commandBuffer->computeShaderResourceViews);
     SDL_zeroa(commandBuffer->computeUnorderedAccessViews);
 
+    commandBuffer->parallelRenderPass = SDL_FALSE;
+    commandBuffer->chunkCommandList = NULL;
+}
+
+static Refresh_CommandBuffer *D3D11_AcquireCommandBuffer(
+    Refresh_Renderer *driverData,
+    Refresh_QueueType queueType)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+    D3D11CommandBuffer *commandBuffer;
+
+    /* D3D11 executes everything on the immediate context */
+    (void)queueType;
+
+    SDL_LockMutex(renderer->acquireCommandBufferLock);
+
+    commandBuffer = D3D11_INTERNAL_GetInactiveCommandBufferFromPool(renderer);
+    D3D11_INTERNAL_ResetCommandBufferState(commandBuffer);
+
     D3D11_INTERNAL_AcquireFence(commandBuffer);
     commandBuffer->autoReleaseFence = 1;
 
@@ -3400,105 +4021,108 @@ static void D3D11_INTERNAL_ReturnUniformBufferToPool(
     renderer->uniformBufferPoolCount += 1;
 
     uniformBuffer->writeOffset = 0;
-    uniformBuffer->drawOffset = 0;
     uniformBuffer->mappedData = NULL;
 }
 
-static void D3D11_INTERNAL_PushUniformData(
-    D3D11CommandBuffer *d3d11CommandBuffer,
-    Refresh_ShaderStage shaderStage,
-    Uint32 slotIndex,
-    const void *data,
-    Uint32 dataLengthInBytes)
+/* Uniform data is linearly allocated from one buffer shared by every stage and slot,
+ * so pushes only move the constant buffer window. The buffer stays mapped until it is
+ * full or the command buffer is submitted.
+ */
+static D3D11UniformBuffer *D3D11_INTERNAL_FetchCurrentUniformBuffer(
+    D3D11CommandBuffer *commandBuffer,
+    Uint32 blockSize)
 {
-    D3D11Renderer *renderer = d3d11CommandBuffer->renderer;
-    D3D11UniformBuffer *d3d11UniformBuffer;
+    D3D11Renderer *renderer = commandBuffer->renderer;
+    D3D11UniformBuffer *uniformBuffer = commandBuffer->currentUniformBuffer;
     D3D11_MAPPED_SUBRESOURCE subres;
     HRESULT res;
 
-    if (shaderStage == REFRESH_SHADERSTAGE_VERTEX) {
-        if (d3d11CommandBuffer->vertexUniformBuffers[slotIndex] == NULL) {
-            d3d11CommandBuffer->vertexUniformBuffers[slotIndex] = D3D11_INTERNAL_AcquireUniformBufferFromPool(
-                d3d11CommandBuffer);
-        }
-        d3d11UniformBuffer = d3d11CommandBuffer->vertexUniformBuffers[slotIndex];
-    } else if (shaderStage == REFRESH_SHADERSTAGE_FRAGMENT) {
-        if (d3d11CommandBuffer->fragmentUniformBuffers[slotIndex] == NULL) {
-            d3d11CommandBuffer->fragmentUniformBuffers[slotIndex] = D3D11_INTERNAL_AcquireUniformBufferFromPool(
-                d3d11CommandBuffer);
-        }
-        d3d11UniformBuffer = d3d11CommandBuffer->fragmentUniformBuffers[slotIndex];
-    } else if (shaderStage == REFRESH_SHADERSTAGE_COMPUTE) {
-        if (d3d11CommandBuffer->computeUniformBuffers[slotIndex] == NULL) {
-            d3d11CommandBuffer->computeUniformBuffers[slotIndex] = D3D11_INTERNAL_AcquireUniformBufferFromPool(
-                d3d11CommandBuffer);
-        }
-        d3d11UniformBuffer = d3d11CommandBuffer->computeUniformBuffers[slotIndex];
-    } else {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized shader stage!");
-        return;
+    if (uniformBuffer != NULL && uniformBuffer->writeOffset + blockSize <= UNIFORM_BUFFER_SIZE) {
+        return uniformBuffer;
     }
 
-    d3d11UniformBuffer->currentBlockSize =
-        D3D11_INTERNAL_NextHighestAlignment(
-            dataLengthInBytes,
-            256);
-
     /* If there is no more room, acquire a new uniform buffer */
-    if (d3d11UniformBuffer->writeOffset + d3d11UniformBuffer->currentBlockSize >= UNIFORM_BUFFER_SIZE) {
+    if (uniformBuffer != NULL) {
         ID3D11DeviceContext_Unmap(
-            d3d11CommandBuffer->context,
-            (ID3D11Resource *)d3d11UniformBuffer->buffer,
+            commandBuffer->context,
+            (ID3D11Resource *)uniformBuffer->buffer,
             0);
-        d3d11UniformBuffer->mappedData = NULL;
+        uniformBuffer->mappedData = NULL;
+        commandBuffer->currentUniformBuffer = NULL;
+    }
+
+    uniformBuffer = D3D11_INTERNAL_AcquireUniformBufferFromPool(commandBuffer);
+
+    res = ID3D11DeviceContext_Map(
+        commandBuffer->context,
+        (ID3D11Resource *)uniformBuffer->buffer,
+        0,
+        D3D11_MAP_WRITE_DISCARD,
+        0,
+        &subres);
+    ERROR_CHECK_RETURN("Failed to map uniform buffer", NULL)
 
-        d3d11UniformBuffer = D3D11_INTERNAL_AcquireUniformBufferFromPool(d3d11CommandBuffer);
+    uniformBuffer->mappedData = subres.pData;
+    commandBuffer->currentUniformBuffer = uniformBuffer;
 
-        d3d11UniformBuffer->drawOffset = 0;
-        d3d11UniformBuffer->writeOffset = 0;
+    return uniformBuffer;
+}
 
-        if (shaderStage == REFRESH_SHADERSTAGE_VERTEX) {
-            d3d11CommandBuffer->vertexUniformBuffers[slotIndex] = d3d11UniformBuffer;
-        } else if (shaderStage == REFRESH_SHADERSTAGE_FRAGMENT) {
-            d3d11CommandBuffer->fragmentUniformBuffers[slotIndex] = d3d11UniformBuffer;
-        } else if (shaderStage == REFRESH_SHADERSTAGE_COMPUTE) {
-            d3d11CommandBuffer->computeUniformBuffers[slotIndex] = d3d11UniformBuffer;
-        } else {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized shader stage!");
-        }
+static void D3D11_INTERNAL_PushUniformData(
+    D3D11CommandBuffer *d3d11CommandBuffer,
+    Refresh_ShaderStage shaderStage,
+    Uint32 slotIndex,
+    const void *data,
+    Uint32 dataLengthInBytes)
+{
+    D3D11UniformBuffer *d3d11UniformBuffer;
+    Uint32 blockSize;
+    Uint32 drawOffset;
+
+    if (shaderStage != REFRESH_SHADERSTAGE_VERTEX &&
+        shaderStage != REFRESH_SHADERSTAGE_FRAGMENT &&
+        shaderStage != REFRESH_SHADERSTAGE_COMPUTE) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized shader stage!");
+        return;
     }
 
-    /* Map the uniform data on first push */
-    if (d3d11UniformBuffer->writeOffset == 0) {
-        res = ID3D11DeviceContext_Map(
-            d3d11CommandBuffer->context,
-            (ID3D11Resource *)d3d11UniformBuffer->buffer,
-            0,
-            D3D11_MAP_WRITE_DISCARD,
-            0,
-            &subres);
-        ERROR_CHECK_RETURN("Failed to map uniform buffer", )
+    /* Constant buffer windows are specified in multiples of 16 constants */
+    blockSize = D3D11_INTERNAL_NextHighestAlignment(
+        dataLengthInBytes,
+        256);
 
-        d3d11UniformBuffer->mappedData = subres.pData;
+    d3d11UniformBuffer = D3D11_INTERNAL_FetchCurrentUniformBuffer(
+        d3d11CommandBuffer,
+        blockSize);
+
+    if (d3d11UniformBuffer == NULL) {
+        return;
     }
 
-    d3d11UniformBuffer->drawOffset = d3d11UniformBuffer->writeOffset;
+    drawOffset = d3d11UniformBuffer->writeOffset;
 
     SDL_memcpy(
-        (Uint8 *)d3d11UniformBuffer->mappedData + d3d11UniformBuffer->writeOffset,
+        (Uint8 *)d3d11UniformBuffer->mappedData + drawOffset,
         data,
         dataLengthInBytes);
 
-    d3d11UniformBuffer->writeOffset += d3d11UniformBuffer->currentBlockSize;
+    d3d11UniformBuffer->writeOffset += blockSize;
 
     if (shaderStage == REFRESH_SHADERSTAGE_VERTEX) {
+        d3d11CommandBuffer->vertexUniformBuffers[slotIndex] = d3d11UniformBuffer;
+        d3d11CommandBuffer->vertexUniformDrawOffsets[slotIndex] = drawOffset;
+        d3d11CommandBuffer->vertexUniformBlockSizes[slotIndex] = blockSize;
         d3d11CommandBuffer->needVertexUniformBufferBind = SDL_TRUE;
     } else if (shaderStage == REFRESH_SHADERSTAGE_FRAGMENT) {
+        d3d11CommandBuffer->fragmentUniformBuffers[slotIndex] = d3d11UniformBuffer;
+        d3d11CommandBuffer->fragmentUniformDrawOffsets[slotIndex] = drawOffset;
+        d3d11CommandBuffer->fragmentUniformBlockSizes[slotIndex] = blockSize;
         d3d11CommandBuffer->needFragmentUniformBufferBind = SDL_TRUE;
-    } else if (shaderStage == REFRESH_SHADERSTAGE_COMPUTE) {
-        d3d11CommandBuffer->needComputeUniformBufferBind = SDL_TRUE;
     } else {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized shader stage!");
+        d3d11CommandBuffer->computeUniformBuffers[slotIndex] = d3d11UniformBuffer;
+        d3d11CommandBuffer->computeUniformDrawOffsets[slotIndex] = drawOffset;
+        d3d11CommandBuffer->computeUniformBlockSizes[slotIndex] = blockSize;
+        d3d11CommandBuffer->needComputeUniformBufferBind = SDL_TRUE;
     }
 }
 
@@ -3664,6 +4288,34 @@ static void D3D11_BeginRenderPass(
         d3d11CommandBuffer->context,
         1,
         &scissorRect);
+
+    /* Remember the targets in case this is a parallel render pass */
+    for (Uint32 i = 0; i < colorAttachmentCount; i += 1) {
+        d3d11CommandBuffer->renderPassColorTargetViews[i] = rtvs[i];
+    }
+    d3d11CommandBuffer->renderPassColorTargetCount = colorAttachmentCount;
+    d3d11CommandBuffer->renderPassDepthStencilView = dsv;
+    d3d11CommandBuffer->renderPassViewport = viewport;
+    d3d11CommandBuffer->renderPassScissorRect = scissorRect;
+}
+
+static void D3D11_BeginParallelRenderPass(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_ColorAttachmentInfo *colorAttachmentInfos,
+    Uint32 colorAttachmentCount,
+    Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo)
+{
+    D3D11CommandBuffer *d3d11CommandBuffer = (D3D11CommandBuffer *)commandBuffer;
+
+    /* Load ops and resolves stay on this command buffer, the chunks only draw */
+    D3D11_BeginRenderPass(
+        commandBuffer,
+        colorAttachmentInfos,
+        colorAttachmentCount,
+        depthStencilAttachmentInfo);
+
+    d3d11CommandBuffer->parallelRenderPass = SDL_TRUE;
+    d3d11CommandBuffer->firstRenderPassChunk = d3d11CommandBuffer->renderPassChunkCount;
 }
 
 static void D3D11_BindGraphicsPipeline(
@@ -3713,15 +4365,21 @@ static void D3D11_BindGraphicsPipeline(
     /* Acquire uniform buffers if necessary */
     for (Uint32 i = 0; i < pipeline->vertexUniformBufferCount; i += 1) {
         if (d3d11CommandBuffer->vertexUniformBuffers[i] == NULL) {
-            d3d11CommandBuffer->vertexUniformBuffers[i] = D3D11_INTERNAL_AcquireUniformBufferFromPool(
-                d3d11CommandBuffer);
+            d3d11CommandBuffer->vertexUniformBuffers[i] = D3D11_INTERNAL_FetchCurrentUniformBuffer(
+                d3d11CommandBuffer,
+                0);
+            d3d11CommandBuffer->vertexUniformDrawOffsets[i] = 0;
+            d3d11CommandBuffer->vertexUniformBlockSizes[i] = 256;
         }
     }
 
     for (Uint32 i = 0; i < pipeline->fragmentUniformBufferCount; i += 1) {
         if (d3d11CommandBuffer->fragmentUniformBuffers[i] == NULL) {
-            d3d11CommandBuffer->fragmentUniformBuffers[i] = D3D11_INTERNAL_AcquireUniformBufferFromPool(
-                d3d11CommandBuffer);
+            d3d11CommandBuffer->fragmentUniformBuffers[i] = D3D11_INTERNAL_FetchCurrentUniformBuffer(
+                d3d11CommandBuffer,
+                0);
+            d3d11CommandBuffer->fragmentUniformDrawOffsets[i] = 0;
+            d3d11CommandBuffer->fragmentUniformBlockSizes[i] = 256;
         }
     }
 
@@ -4032,8 +4690,8 @@ static void D3D11_INTERNAL_BindGraphicsResources(
                 1,
                 &nullBuf);
 
-            offsetInConstants = commandBuffer->vertexUniformBuffers[i]->drawOffset / 16;
-            blockSizeInConstants = commandBuffer->vertexUniformBuffers[i]->currentBlockSize / 16;
+            offsetInConstants = commandBuffer->vertexUniformDrawOffsets[i] / 16;
+            blockSizeInConstants = commandBuffer->vertexUniformBlockSizes[i] / 16;
 
             ID3D11DeviceContext1_VSSetConstantBuffers1(
                 commandBuffer->context,
@@ -4082,8 +4740,8 @@ static void D3D11_INTERNAL_BindGraphicsResources(
                 1,
                 &nullBuf);
 
-            offsetInConstants = commandBuffer->fragmentUniformBuffers[i]->drawOffset / 16;
-            blockSizeInConstants = commandBuffer->fragmentUniformBuffers[i]->currentBlockSize / 16;
+            offsetInConstants = commandBuffer->fragmentUniformDrawOffsets[i] / 16;
+            blockSizeInConstants = commandBuffer->fragmentUniformBlockSizes[i] / 16;
 
             ID3D11DeviceContext1_PSSetConstantBuffers1(
                 commandBuffer->context,
@@ -4181,12 +4839,154 @@ static void D3D11_DrawIndexedPrimitivesIndirect(
     D3D11_INTERNAL_TrackBuffer(d3d11CommandBuffer, d3d11Buffer);
 }
 
+/* D3D11 cannot read the draw count on the GPU, so we draw maxDrawCount times
+ * and rely on the app to zero out the instance count of unused draws.
+ */
+
+static SDL_bool D3D11_SupportsIndirectCount(
+    Refresh_Renderer *driverData)
+{
+    (void)driverData;
+    return SDL_FALSE;
+}
+
+static void D3D11_DrawPrimitivesIndirectCount(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_Buffer *buffer,
+    Uint32 offsetInBytes,
+    Refresh_Buffer *countBuffer,
+    Uint32 countOffsetInBytes,
+    Uint32 maxDrawCount,
+    Uint32 stride)
+{
+    (void)countBuffer;
+    (void)countOffsetInBytes;
+
+    D3D11_DrawPrimitivesIndirect(
+        commandBuffer,
+        buffer,
+        offsetInBytes,
+        maxDrawCount,
+        stride);
+}
+
+static void D3D11_DrawIndexedPrimitivesIndirectCount(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_Buffer *buffer,
+    Uint32 offsetInBytes,
+    Refresh_Buffer *countBuffer,
+    Uint32 countOffsetInBytes,
+    Uint32 maxDrawCount,
+    Uint32 stride)
+{
+    (void)countBuffer;
+    (void)countOffsetInBytes;
+
+    D3D11_DrawIndexedPrimitivesIndirect(
+        commandBuffer,
+        buffer,
+        offsetInBytes,
+        maxDrawCount,
+        stride);
+}
+
+static void D3D11_ExecuteCommandBundle(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_CommandBundle *commandBundle)
+{
+    CommandBundle *bundle = (CommandBundle *)commandBundle;
+    CommandBundleCommand *command;
+
+    for (Uint32 i = 0; i < bundle->commandCount; i += 1) {
+        command = &bundle->commands[i];
+
+        switch (command->type) {
+        case COMMAND_BUNDLE_BIND_GRAPHICS_PIPELINE:
+            D3D11_BindGraphicsPipeline(
+                commandBuffer,
+                command->data.graphicsPipeline);
+            break;
+
+        case COMMAND_BUNDLE_BIND_VERTEX_BUFFERS:
+            D3D11_BindVertexBuffers(
+                commandBuffer,
+                command->data.bindings.firstSlot,
+                &bundle->bufferBindings[command->data.bindings.bindingOffset],
+                command->data.bindings.bindingCount);
+            break;
+
+        case COMMAND_BUNDLE_BIND_INDEX_BUFFER:
+            D3D11_BindIndexBuffer(
+                commandBuffer,
+                &command->data.indexBuffer.binding,
+                command->data.indexBuffer.indexElementSize);
+            break;
+
+        case COMMAND_BUNDLE_BIND_FRAGMENT_SAMPLERS:
+            D3D11_BindFragmentSamplers(
+                commandBuffer,
+                command->data.bindings.firstSlot,
+                &bundle->samplerBindings[command->data.bindings.bindingOffset],
+                command->data.bindings.bindingCount);
+            break;
+
+        case COMMAND_BUNDLE_DRAW_INDEXED_PRIMITIVES:
+            D3D11_DrawIndexedPrimitives(
+                commandBuffer,
+                command->data.drawIndexed.baseVertex,
+                command->data.drawIndexed.startIndex,
+                command->data.drawIndexed.primitiveCount,
+                command->data.drawIndexed.instanceCount);
+            break;
+
+        case COMMAND_BUNDLE_DRAW_PRIMITIVES:
+            D3D11_DrawPrimitives(
+                commandBuffer,
+                command->data.draw.vertexStart,
+                command->data.draw.primitiveCount);
+            break;
+        }
+    }
+}
+
 static void D3D11_EndRenderPass(
     Refresh_CommandBuffer *commandBuffer)
 {
     D3D11CommandBuffer *d3d11CommandBuffer = (D3D11CommandBuffer *)commandBuffer;
+    D3D11CommandBuffer *chunk;
     Uint32 i;
 
+    /* Replay the chunks in the order they were acquired */
+    if (d3d11CommandBuffer->parallelRenderPass) {
+        for (i = d3d11CommandBuffer->firstRenderPassChunk; i < d3d11CommandBuffer->renderPassChunkCount; i += 1) {
+            chunk = d3d11CommandBuffer->renderPassChunks[i];
+
+            if (chunk->chunkCommandList != NULL) {
+                ID3D11DeviceContext_ExecuteCommandList(
+                    d3d11CommandBuffer->context,
+                    chunk->chunkCommandList,
+                    0);
+                ID3D11CommandList_Release(chunk->chunkCommandList);
+                chunk->chunkCommandList = NULL;
+            }
+        }
+
+        /* Executing a command list clears the context state */
+        d3d11CommandBuffer->graphicsPipeline = NULL;
+        d3d11CommandBuffer->computePipeline = NULL;
+        d3d11CommandBuffer->needVertexSamplerBind = SDL_TRUE;
+        d3d11CommandBuffer->needVertexResourceBind = SDL_TRUE;
+        d3d11CommandBuffer->needVertexUniformBufferBind = SDL_TRUE;
+        d3d11CommandBuffer->needFragmentSamplerBind = SDL_TRUE;
+        d3d11CommandBuffer->needFragmentResourceBind = SDL_TRUE;
+        d3d11CommandBuffer->needFragmentUniformBufferBind = SDL_TRUE;
+        d3d11CommandBuffer->needComputeUAVBind = SDL_TRUE;
+        d3d11CommandBuffer->needComputeSRVBind = SDL_TRUE;
+        d3d11CommandBuffer->needComputeUniformBufferBind = SDL_TRUE;
+
+        d3d11CommandBuffer->parallelRenderPass = SDL_FALSE;
+    }
+
     /* Set render target slots to NULL to avoid NULL set behavior */
     /* https://learn.microsoft.com/en-us/windows/win32/api/d3d11/nf-d3d11-id3d11devicecontext-pssetshaderresources */
     ID3D11DeviceContext_OMSetRenderTargets(
@@ -4209,6 +5009,79 @@ static void D3D11_EndRenderPass(
     }
 }
 
+/* Parallel Render Pass */
+
+static Refresh_CommandBuffer *D3D11_AcquireRenderPassChunk(
+    Refresh_CommandBuffer *commandBuffer)
+{
+    D3D11CommandBuffer *d3d11CommandBuffer = (D3D11CommandBuffer *)commandBuffer;
+    D3D11Renderer *renderer = d3d11CommandBuffer->renderer;
+    D3D11CommandBuffer *chunk;
+
+    SDL_LockMutex(renderer->acquireCommandBufferLock);
+
+    chunk = D3D11_INTERNAL_GetInactiveCommandBufferFromPool(renderer);
+
+    EXPAND_ARRAY_IF_NEEDED(
+        d3d11CommandBuffer->renderPassChunks,
+        D3D11CommandBuffer *,
+        d3d11CommandBuffer->renderPassChunkCount + 1,
+        d3d11CommandBuffer->renderPassChunkCapacity,
+        d3d11CommandBuffer->renderPassChunkCapacity * 2);
+
+    d3d11CommandBuffer->renderPassChunks[d3d11CommandBuffer->renderPassChunkCount] = chunk;
+    d3d11CommandBuffer->renderPassChunkCount += 1;
+
+    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+
+    D3D11_INTERNAL_ResetCommandBufferState(chunk);
+
+    /* Chunks are never submitted on their own */
+    chunk->fence = NULL;
+    chunk->autoReleaseFence = 0;
+
+    ID3D11DeviceContext_OMSetRenderTargets(
+        chunk->context,
+        d3d11CommandBuffer->renderPassColorTargetCount,
+        d3d11CommandBuffer->renderPassColorTargetCount > 0 ? d3d11CommandBuffer->renderPassColorTargetViews : NULL,
+        d3d11CommandBuffer->renderPassDepthStencilView);
+
+    ID3D11DeviceContext_RSSetViewports(
+        chunk->context,
+        1,
+        &d3d11CommandBuffer->renderPassViewport);
+
+    ID3D11DeviceContext_RSSetScissorRects(
+        chunk->context,
+        1,
+        &d3d11CommandBuffer->renderPassScissorRect);
+
+    return (Refresh_CommandBuffer *)chunk;
+}
+
+static void D3D11_EndRenderPassChunk(
+    Refresh_CommandBuffer *chunk)
+{
+    D3D11CommandBuffer *d3d11Chunk = (D3D11CommandBuffer *)chunk;
+    D3D11Renderer *renderer = d3d11Chunk->renderer;
+    HRESULT res;
+
+    if (d3d11Chunk->currentUniformBuffer != NULL) {
+        ID3D11DeviceContext_Unmap(
+            d3d11Chunk->context,
+            (ID3D11Resource *)d3d11Chunk->currentUniformBuffer->buffer,
+            0);
+        d3d11Chunk->currentUniformBuffer->mappedData = NULL;
+        d3d11Chunk->currentUniformBuffer = NULL;
+    }
+
+    res = ID3D11DeviceContext_FinishCommandList(
+        d3d11Chunk->context,
+        0,
+        &d3d11Chunk->chunkCommandList);
+    ERROR_CHECK("Could not finish render pass chunk!");
+}
+
 static void D3D11_PushVertexUniformData(
     Refresh_CommandBuffer *commandBuffer,
     Uint32 slotIndex,
@@ -4415,8 +5288,11 @@ static void D3D11_BindComputePipeline(
     /* Acquire uniform buffers if necessary */
     for (Uint32 i = 0; i < pipeline->uniformBufferCount; i += 1) {
         if (d3d11CommandBuffer->computeUniformBuffers[i] == NULL) {
-            d3d11CommandBuffer->computeUniformBuffers[i] = D3D11_INTERNAL_AcquireUniformBufferFromPool(
-                d3d11CommandBuffer);
+            d3d11CommandBuffer->computeUniformBuffers[i] = D3D11_INTERNAL_FetchCurrentUniformBuffer(
+                d3d11CommandBuffer,
+                0);
+            d3d11CommandBuffer->computeUniformDrawOffsets[i] = 0;
+            d3d11CommandBuffer->computeUniformBlockSizes[i] = 256;
         }
     }
 
@@ -4538,8 +5414,8 @@ static void D3D11_INTERNAL_BindComputeResources(
                 1,
                 &nullBuf);
 
-            offsetInConstants = commandBuffer->computeUniformBuffers[i]->drawOffset / 16;
-            blockSizeInConstants = commandBuffer->computeUniformBuffers[i]->currentBlockSize / 16;
+            offsetInConstants = commandBuffer->computeUniformDrawOffsets[i] / 16;
+            blockSizeInConstants = commandBuffer->computeUniformBlockSizes[i] / 16;
 
             ID3D11DeviceContext1_CSSetConstantBuffers1(
                 commandBuffer->context,
@@ -4644,6 +5520,9 @@ static void D3D11_INTERNAL_MapAndCopyBufferDownload(
         D3D11_MAP_READ,
         0,
         &subres);
+    if (FAILED(res)) {
+        SDL_UnlockMutex(renderer->contextLock);
+    }
     ERROR_CHECK_RETURN("Failed to map staging buffer", )
 
     SDL_memcpy(
@@ -4678,6 +5557,9 @@ static void D3D11_INTERNAL_MapAndCopyTextureDownload(
         D3D11_MAP_READ,
         0,
         &subres);
+    if (FAILED(res)) {
+        SDL_UnlockMutex(renderer->contextLock);
+    }
     ERROR_CHECK_RETURN("Could not map staging textre", )
 
     for (depth = 0; depth < textureDownload->depth; depth += 1) {
@@ -4744,6 +5626,19 @@ static void D3D11_INTERNAL_CleanCommandBuffer(
 
     SDL_UnlockMutex(renderer->acquireUniformBufferLock);
 
+    /* Staging blocks are now available */
+
+    SDL_LockMutex(renderer->acquireStagingBlockLock);
+
+    for (i = 0; i < commandBuffer->usedStagingBlockCount; i += 1) {
+        D3D11_INTERNAL_ReturnStagingBlockToPool(
+            renderer,
+            commandBuffer->usedStagingBlocks[i]);
+    }
+    commandBuffer->usedStagingBlockCount = 0;
+
+    SDL_UnlockMutex(renderer->acquireStagingBlockLock);
+
     /* Reference Counting */
 
     for (i = 0; i < commandBuffer->usedBufferCount; i += 1) {
@@ -4761,6 +5656,11 @@ static void D3D11_INTERNAL_CleanCommandBuffer(
     }
     commandBuffer->usedTextureSubresourceCount = 0;
 
+    for (i = 0; i < commandBuffer->usedQueryPoolCount; i += 1) {
+        (void)SDL_AtomicDecRef(&commandBuffer->usedQueryPools[i]->referenceCount);
+    }
+    commandBuffer->usedQueryPoolCount = 0;
+
     /* Reset presentation */
     commandBuffer->windowDataCount = 0;
 
@@ -4771,6 +5671,14 @@ static void D3D11_INTERNAL_CleanCommandBuffer(
             (Refresh_Fence *)commandBuffer->fence);
     }
 
+    /* Render pass chunks executed by this command buffer are done too */
+    for (i = 0; i < commandBuffer->renderPassChunkCount; i += 1) {
+        D3D11_INTERNAL_CleanCommandBuffer(
+            renderer,
+            commandBuffer->renderPassChunks[i]);
+    }
+    commandBuffer->renderPassChunkCount = 0;
+
     /* Return command buffer to pool */
     SDL_LockMutex(renderer->acquireCommandBufferLock);
     if (renderer->availableCommandBufferCount == renderer->availableCommandBufferCapacity) {
@@ -4845,79 +5753,198 @@ static void D3D11_INTERNAL_PerformPendingDestroys(
             renderer->textureContainersToDestroyCount -= 1;
         }
     }
-}
 
-/* Fences */
+    for (i = renderer->queryPoolsToDestroyCount - 1; i >= 0; i -= 1) {
+        if (SDL_AtomicGet(&renderer->queryPoolsToDestroy[i]->referenceCount) == 0) {
+            D3D11_INTERNAL_DestroyQueryPool(
+                renderer->queryPoolsToDestroy[i]);
 
-static void D3D11_INTERNAL_WaitForFence(
-    D3D11Renderer *renderer,
-    D3D11Fence *fence)
-{
-    BOOL queryData;
-    HRESULT res;
+            renderer->queryPoolsToDestroy[i] = renderer->queryPoolsToDestroy[renderer->queryPoolsToDestroyCount - 1];
+            renderer->queryPoolsToDestroyCount -= 1;
+        }
+    }
+}
 
-    SDL_LockMutex(renderer->contextLock);
+static void D3D11_INTERNAL_TrimCycledContainers(
+    D3D11Renderer *renderer)
+{
+    SDL_LockMutex(renderer->cycleLock);
 
-    do {
-        res = ID3D11DeviceContext_GetData(
-            renderer->immediateContext,
-            (ID3D11Asynchronous *)fence->handle,
-            &queryData,
-            sizeof(queryData),
-            0);
-    } while (res != S_OK); /* Spin until we get a result back... */
+    renderer->presentedFrameCount += 1;
 
-    SDL_UnlockMutex(renderer->contextLock);
-}
+    if (renderer->cycleTrimFrames == 0) {
+        SDL_UnlockMutex(renderer->cycleLock);
+        return;
+    }
 
-static void D3D11_WaitForFences(
-    Refresh_Renderer *driverData,
-    SDL_bool waitAll,
-    Refresh_Fence **pFences,
-    Uint32 fenceCount)
-{
-    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
-    D3D11Fence *fence;
-    BOOL queryData;
-    HRESULT res = S_FALSE;
+    for (Sint32 i = renderer->cycledTransferBufferContainerCount - 1; i >= 0; i -= 1) {
+        D3D11TransferBufferContainer *container = renderer->cycledTransferBufferContainers[i];
 
-    if (waitAll) {
-        for (Uint32 i = 0; i < fenceCount; i += 1) {
-            fence = (D3D11Fence *)pFences[i];
-            D3D11_INTERNAL_WaitForFence(renderer, fence);
+        if (renderer->presentedFrameCount - container->lastCycleFrame < renderer->cycleTrimFrames) {
+            continue;
         }
-    } else {
-        SDL_LockMutex(renderer->contextLock);
-
-        while (res != S_OK) {
-            for (Uint32 i = 0; i < fenceCount; i += 1) {
-                fence = (D3D11Fence *)pFences[i];
-                res = ID3D11DeviceContext_GetData(
-                    renderer->immediateContext,
-                    (ID3D11Asynchronous *)fence->handle,
-                    &queryData,
-                    sizeof(queryData),
-                    0);
-                if (res == S_OK) {
-                    break;
-                }
+
+        for (Sint32 j = container->bufferCount - 1; j >= 0; j -= 1) {
+            D3D11TransferBuffer *transferBuffer = container->buffers[j];
+
+            if (
+                transferBuffer != container->activeBuffer &&
+                SDL_AtomicGet(&transferBuffer->referenceCount) == 0) {
+                D3D11_INTERNAL_DestroyTransferBuffer(transferBuffer);
+
+                container->buffers[j] = container->buffers[container->bufferCount - 1];
+                container->bufferCount -= 1;
+
+                renderer->cycleHandlesTrimmed += 1;
             }
         }
 
-        SDL_UnlockMutex(renderer->contextLock);
+        if (container->bufferCount == 1) {
+            renderer->cycledTransferBufferContainers[i] = renderer->cycledTransferBufferContainers[renderer->cycledTransferBufferContainerCount - 1];
+            renderer->cycledTransferBufferContainerCount -= 1;
+        }
     }
 
-    SDL_LockMutex(renderer->contextLock);
+    for (Sint32 i = renderer->cycledBufferContainerCount - 1; i >= 0; i -= 1) {
+        D3D11BufferContainer *container = renderer->cycledBufferContainers[i];
 
-    /* Check if we can perform any cleanups */
-    for (Sint32 i = renderer->submittedCommandBufferCount - 1; i >= 0; i -= 1) {
-        res = ID3D11DeviceContext_GetData(
-            renderer->immediateContext,
-            (ID3D11Asynchronous *)renderer->submittedCommandBuffers[i]->fence->handle,
-            &queryData,
-            sizeof(queryData),
-            0);
-        if (res == S_OK) {
+        if (renderer->presentedFrameCount - container->lastCycleFrame < renderer->cycleTrimFrames) {
+            continue;
+        }
+
+        for (Sint32 j = container->bufferCount - 1; j >= 0; j -= 1) {
+            D3D11Buffer *buffer = container->buffers[j];
+
+            if (
+                buffer != container->activeBuffer &&
+                SDL_AtomicGet(&buffer->referenceCount) == 0) {
+                D3D11_INTERNAL_DestroyBuffer(buffer);
+
+                container->buffers[j] = container->buffers[container->bufferCount - 1];
+                container->bufferCount -= 1;
+
+                renderer->cycleHandlesTrimmed += 1;
+            }
+        }
+
+        if (container->bufferCount == 1) {
+            renderer->cycledBufferContainers[i] = renderer->cycledBufferContainers[renderer->cycledBufferContainerCount - 1];
+            renderer->cycledBufferContainerCount -= 1;
+        }
+    }
+
+    for (Sint32 i = renderer->cycledTextureContainerCount - 1; i >= 0; i -= 1) {
+        D3D11TextureContainer *container = renderer->cycledTextureContainers[i];
+
+        if (renderer->presentedFrameCount - container->lastCycleFrame < renderer->cycleTrimFrames) {
+            continue;
+        }
+
+        for (Sint32 j = container->textureCount - 1; j >= 0; j -= 1) {
+            D3D11Texture *texture = container->textures[j];
+            Uint32 refCountTotal = 0;
+
+            for (Uint32 k = 0; k < texture->subresourceCount; k += 1) {
+                refCountTotal += SDL_AtomicGet(&texture->subresources[k].referenceCount);
+            }
+
+            if (texture != container->activeTexture && refCountTotal == 0) {
+                D3D11_INTERNAL_DestroyTexture(texture);
+                SDL_free(texture);
+
+                container->textures[j] = container->textures[container->textureCount - 1];
+                container->textureCount -= 1;
+
+                renderer->cycleHandlesTrimmed += 1;
+            }
+        }
+
+        if (container->textureCount == 1) {
+            renderer->cycledTextureContainers[i] = renderer->cycledTextureContainers[renderer->cycledTextureContainerCount - 1];
+            renderer->cycledTextureContainerCount -= 1;
+        }
+    }
+
+    SDL_UnlockMutex(renderer->cycleLock);
+}
+
+/* Fences */
+
+static void D3D11_INTERNAL_FenceWaitBackoff(
+    Uint32 *pollCount)
+{
+    /* D3D11 queries can't block, so yield for short waits and sleep for long ones */
+    if (*pollCount < FENCE_POLL_YIELD_COUNT) {
+        *pollCount += 1;
+        SDL_Delay(0);
+    } else {
+        SDL_Delay(1);
+    }
+}
+
+static SDL_bool D3D11_INTERNAL_PollFences(
+    D3D11Renderer *renderer,
+    Refresh_Fence **pFences,
+    Uint32 fenceCount,
+    UINT getDataFlags)
+{
+    BOOL queryData;
+    HRESULT res = S_FALSE;
+
+    /* Submits can get in between polls */
+    SDL_LockMutex(renderer->contextLock);
+
+    for (Uint32 i = 0; i < fenceCount; i += 1) {
+        res = ID3D11DeviceContext_GetData(
+            renderer->immediateContext,
+            (ID3D11Asynchronous *)((D3D11Fence *)pFences[i])->handle,
+            &queryData,
+            sizeof(queryData),
+            getDataFlags);
+        if (res == S_OK) {
+            break;
+        }
+    }
+
+    SDL_UnlockMutex(renderer->contextLock);
+
+    return res == S_OK;
+}
+
+static void D3D11_INTERNAL_WaitForFence(
+    D3D11Renderer *renderer,
+    D3D11Fence *fence)
+{
+    Refresh_Fence *pFence = (Refresh_Fence *)fence;
+    Uint32 pollCount = 0;
+
+    /* The first poll flushes, so the fence is guaranteed to be reached */
+    if (D3D11_INTERNAL_PollFences(renderer, &pFence, 1, 0)) {
+        return;
+    }
+
+    do {
+        D3D11_INTERNAL_FenceWaitBackoff(&pollCount);
+    } while (!D3D11_INTERNAL_PollFences(renderer, &pFence, 1, D3D11_ASYNC_GETDATA_DONOTFLUSH));
+}
+
+static void D3D11_INTERNAL_CleanCompletedCommandBuffers(
+    D3D11Renderer *renderer)
+{
+    BOOL queryData;
+    HRESULT res;
+
+    SDL_LockMutex(renderer->contextLock);
+
+    /* Check if we can perform any cleanups */
+    for (Sint32 i = renderer->submittedCommandBufferCount - 1; i >= 0; i -= 1) {
+        res = ID3D11DeviceContext_GetData(
+            renderer->immediateContext,
+            (ID3D11Asynchronous *)renderer->submittedCommandBuffers[i]->fence->handle,
+            &queryData,
+            sizeof(queryData),
+            D3D11_ASYNC_GETDATA_DONOTFLUSH);
+        if (res == S_OK) {
             D3D11_INTERNAL_CleanCommandBuffer(
                 renderer,
                 renderer->submittedCommandBuffers[i]);
@@ -4929,6 +5956,59 @@ static void D3D11_WaitForFences(
     SDL_UnlockMutex(renderer->contextLock);
 }
 
+static void D3D11_WaitForFences(
+    Refresh_Renderer *driverData,
+    SDL_bool waitAll,
+    Refresh_Fence **pFences,
+    Uint32 fenceCount)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+    Uint32 pollCount = 0;
+
+    if (waitAll) {
+        for (Uint32 i = 0; i < fenceCount; i += 1) {
+            D3D11_INTERNAL_WaitForFence(renderer, (D3D11Fence *)pFences[i]);
+        }
+    } else if (!D3D11_INTERNAL_PollFences(renderer, pFences, fenceCount, 0)) {
+        do {
+            D3D11_INTERNAL_FenceWaitBackoff(&pollCount);
+        } while (!D3D11_INTERNAL_PollFences(renderer, pFences, fenceCount, D3D11_ASYNC_GETDATA_DONOTFLUSH));
+    }
+
+    D3D11_INTERNAL_CleanCompletedCommandBuffers(renderer);
+}
+
+static void D3D11_WaitForAnyFenceOrWake(
+    Refresh_Renderer *driverData,
+    Refresh_Fence **pFences,
+    Uint32 fenceCount)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+    UINT getDataFlags = 0;
+    Uint32 pollCount = 0;
+
+    while (!D3D11_INTERNAL_PollFences(renderer, pFences, fenceCount, getDataFlags)) {
+        if (SDL_AtomicGet(&renderer->fenceWakeCount) != renderer->fenceWakeConsumed) {
+            break;
+        }
+
+        getDataFlags = D3D11_ASYNC_GETDATA_DONOTFLUSH;
+        D3D11_INTERNAL_FenceWaitBackoff(&pollCount);
+    }
+
+    /* Wakes arriving after this point stay pending for the next wait */
+    renderer->fenceWakeConsumed = SDL_AtomicGet(&renderer->fenceWakeCount);
+
+    D3D11_INTERNAL_CleanCompletedCommandBuffers(renderer);
+}
+
+static void D3D11_WakeFenceWait(
+    Refresh_Renderer *driverData)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+    SDL_AtomicIncRef(&renderer->fenceWakeCount);
+}
+
 static SDL_bool D3D11_QueryFence(
     Refresh_Renderer *driverData,
     Refresh_Fence *fence)
@@ -4952,6 +6032,13 @@ static SDL_bool D3D11_QueryFence(
     return res == S_OK;
 }
 
+static Uint64 D3D11_GetFenceSubmissionValue(
+    Refresh_Renderer *driverData,
+    Refresh_Fence *fence)
+{
+    return ((D3D11Fence *)fence)->submissionSerial;
+}
+
 /* Window and Swapchain Management */
 
 static D3D11WindowData *D3D11_INTERNAL_FetchWindowData(
@@ -5083,6 +6170,7 @@ static SDL_bool D3D11_INTERNAL_CreateSwapchain(
     DXGI_FORMAT swapchainFormat;
     IDXGIFactory1 *pParent;
     IDXGISwapChain *swapchain;
+    IDXGISwapChain2 *swapchain2;
     IDXGISwapChain3 *swapchain3;
     Uint32 colorSpaceSupport;
     HRESULT res;
@@ -5129,6 +6217,11 @@ static SDL_bool D3D11_INTERNAL_CreateSwapchain(
         swapchainDesc.SwapEffect = (renderer->supportsFlipDiscard ? DXGI_SWAP_EFFECT_FLIP_DISCARD : DXGI_SWAP_EFFECT_DISCARD);
     }
 
+    /* The frame latency waitable object requires the flip model */
+    if (swapchainDesc.SwapEffect == DXGI_SWAP_EFFECT_FLIP_DISCARD) {
+        swapchainDesc.Flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+    }
+
     /* Create the swapchain! */
     res = IDXGIFactory1_CreateSwapChain(
         (IDXGIFactory1 *)renderer->factory,
@@ -5175,12 +6268,29 @@ static SDL_bool D3D11_INTERNAL_CreateSwapchain(
     windowData->swapchainComposition = swapchainComposition;
     windowData->swapchainFormat = swapchainFormat;
     windowData->swapchainColorSpace = SwapchainCompositionToColorSpace[swapchainComposition];
+    windowData->swapchainFlags = swapchainDesc.Flags;
+    windowData->frameLatencyWaitableObject = NULL;
     windowData->frameCounter = 0;
 
     for (i = 0; i < MAX_FRAMES_IN_FLIGHT; i += 1) {
         windowData->inFlightFences[i] = NULL;
     }
 
+    if (
+        (swapchainDesc.Flags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) &&
+        SUCCEEDED(IDXGISwapChain_QueryInterface(
+            swapchain,
+            &D3D_IID_IDXGISwapChain2,
+            (void **)&swapchain2))) {
+        IDXGISwapChain2_SetMaximumFrameLatency(
+            swapchain2,
+            windowData->allowedFramesInFlight);
+
+        windowData->frameLatencyWaitableObject = IDXGISwapChain2_GetFrameLatencyWaitableObject(swapchain2);
+
+        IDXGISwapChain2_Release(swapchain2);
+    }
+
     if (SUCCEEDED(IDXGISwapChain3_QueryInterface(
             swapchain,
             &D3D_IID_IDXGISwapChain3,
@@ -5245,7 +6355,7 @@ static SDL_bool D3D11_INTERNAL_ResizeSwapchain(
         width,
         height,
         DXGI_FORMAT_UNKNOWN, /* Keep the old format */
-        renderer->supportsTearing ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0);
+        windowData->swapchainFlags);
     ERROR_CHECK_RETURN("Could not resize swapchain buffers", 0);
 
     /* Create the texture object for the swapchain */
@@ -5311,6 +6421,7 @@ static SDL_bool D3D11_ClaimWindow(
     if (windowData == NULL) {
         windowData = (D3D11WindowData *)SDL_malloc(sizeof(D3D11WindowData));
         windowData->window = window;
+        windowData->allowedFramesInFlight = MAX_FRAMES_IN_FLIGHT;
 
         if (D3D11_INTERNAL_CreateSwapchain(renderer, windowData, swapchainComposition, presentMode)) {
             SDL_SetWindowData(window, WINDOW_PROPERTY_DATA, windowData);
@@ -5354,6 +6465,10 @@ static void D3D11_INTERNAL_DestroySwapchain(
     ID3D11UnorderedAccessView_Release(windowData->texture.subresources[0].uav);
     SDL_free(windowData->texture.subresources);
     SDL_free(windowData->textureContainer.textures);
+    if (windowData->frameLatencyWaitableObject != NULL) {
+        CloseHandle(windowData->frameLatencyWaitableObject);
+        windowData->frameLatencyWaitableObject = NULL;
+    }
     IDXGISwapChain_Release(windowData->swapchain);
 
     /* DXGI will crash if we don't flush deferred swapchain destruction */
@@ -5568,6 +6683,91 @@ static SDL_bool D3D11_SetSwapchainParameters(
     return SDL_TRUE;
 }
 
+static SDL_bool D3D11_SetAllowedFramesInFlight(
+    Refresh_Renderer *driverData,
+    SDL_Window *window,
+    Uint32 allowedFramesInFlight)
+{
+    D3D11WindowData *windowData = D3D11_INTERNAL_FetchWindowData(window);
+    IDXGISwapChain2 *swapchain2;
+
+    if (windowData == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot set allowed frames in flight, window has not been claimed!");
+        return SDL_FALSE;
+    }
+
+    if (allowedFramesInFlight == windowData->allowedFramesInFlight) {
+        return SDL_TRUE;
+    }
+
+    /* The frame slots are reassigned, so every frame has to be retired first */
+    D3D11_Wait(driverData);
+
+    for (Uint32 i = 0; i < MAX_FRAMES_IN_FLIGHT; i += 1) {
+        if (windowData->inFlightFences[i] != NULL) {
+            D3D11_ReleaseFence(
+                driverData,
+                (Refresh_Fence *)windowData->inFlightFences[i]);
+
+            windowData->inFlightFences[i] = NULL;
+        }
+    }
+
+    windowData->frameCounter = 0;
+    windowData->allowedFramesInFlight = allowedFramesInFlight;
+
+    if (
+        windowData->frameLatencyWaitableObject != NULL &&
+        SUCCEEDED(IDXGISwapChain_QueryInterface(
+            windowData->swapchain,
+            &D3D_IID_IDXGISwapChain2,
+            (void **)&swapchain2))) {
+        IDXGISwapChain2_SetMaximumFrameLatency(
+            swapchain2,
+            allowedFramesInFlight);
+
+        IDXGISwapChain2_Release(swapchain2);
+    }
+
+    return SDL_TRUE;
+}
+
+static SDL_bool D3D11_WaitForSwapchain(
+    Refresh_Renderer *driverData,
+    SDL_Window *window)
+{
+    D3D11WindowData *windowData = D3D11_INTERNAL_FetchWindowData(window);
+
+    if (windowData == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot wait for swapchain, window has not been claimed!");
+        return SDL_FALSE;
+    }
+
+    /* Signaled when DXGI can queue another present without exceeding the frame latency */
+    if (windowData->frameLatencyWaitableObject != NULL) {
+        WaitForSingleObjectEx(
+            windowData->frameLatencyWaitableObject,
+            1000,
+            TRUE);
+    }
+
+    if (windowData->inFlightFences[windowData->frameCounter] != NULL) {
+        D3D11_WaitForFences(
+            driverData,
+            SDL_TRUE,
+            (Refresh_Fence **)&windowData->inFlightFences[windowData->frameCounter],
+            1);
+
+        D3D11_ReleaseFence(
+            driverData,
+            (Refresh_Fence *)windowData->inFlightFences[windowData->frameCounter]);
+
+        windowData->inFlightFences[windowData->frameCounter] = NULL;
+    }
+
+    return SDL_TRUE;
+}
+
 /* Submission */
 
 static void D3D11_Submit(
@@ -5575,48 +6775,41 @@ static void D3D11_Submit(
 {
     D3D11CommandBuffer *d3d11CommandBuffer = (D3D11CommandBuffer *)commandBuffer;
     D3D11Renderer *renderer = (D3D11Renderer *)d3d11CommandBuffer->renderer;
+    SDL_bool presenting = d3d11CommandBuffer->windowDataCount > 0;
     ID3D11CommandList *commandList;
     HRESULT res;
 
-    /* Unmap uniform buffers */
-
-    for (Uint32 i = 0; i < MAX_UNIFORM_BUFFERS_PER_STAGE; i += 1) {
-        if (d3d11CommandBuffer->vertexUniformBuffers[i] != NULL) {
-            ID3D11DeviceContext_Unmap(
-                d3d11CommandBuffer->context,
-                (ID3D11Resource *)d3d11CommandBuffer->vertexUniformBuffers[i]->buffer,
-                0);
-        }
+    /* Unmap the current uniform buffer, full ones were unmapped when they were replaced */
 
-        if (d3d11CommandBuffer->fragmentUniformBuffers[i] != NULL) {
-            ID3D11DeviceContext_Unmap(
-                d3d11CommandBuffer->context,
-                (ID3D11Resource *)d3d11CommandBuffer->fragmentUniformBuffers[i]->buffer,
-                0);
-        }
-
-        if (d3d11CommandBuffer->computeUniformBuffers[i] != NULL) {
-            ID3D11DeviceContext_Unmap(
-                d3d11CommandBuffer->context,
-                (ID3D11Resource *)d3d11CommandBuffer->computeUniformBuffers[i]->buffer,
-                0);
-        }
+    if (d3d11CommandBuffer->currentUniformBuffer != NULL) {
+        ID3D11DeviceContext_Unmap(
+            d3d11CommandBuffer->context,
+            (ID3D11Resource *)d3d11CommandBuffer->currentUniformBuffer->buffer,
+            0);
+        d3d11CommandBuffer->currentUniformBuffer->mappedData = NULL;
+        d3d11CommandBuffer->currentUniformBuffer = NULL;
     }
 
-    SDL_LockMutex(renderer->contextLock);
+    /* Close any timestamp disjoint queries opened by this command buffer */
 
-    /* Notify the command buffer completion query that we have completed recording */
-    ID3D11DeviceContext_End(
-        renderer->immediateContext,
-        (ID3D11Asynchronous *)d3d11CommandBuffer->fence->handle);
+    for (Uint32 i = 0; i < d3d11CommandBuffer->activeQueryPoolCount; i += 1) {
+        ID3D11DeviceContext_End(
+            d3d11CommandBuffer->context,
+            (ID3D11Asynchronous *)d3d11CommandBuffer->activeQueryPools[i]->disjointQuery);
+    }
+    d3d11CommandBuffer->activeQueryPoolCount = 0;
 
-    /* Serialize the commands into the command list */
+    /* Serialize the commands into the command list.
+     * The deferred context belongs to this command buffer, so this doesn't need the context lock.
+     */
     res = ID3D11DeviceContext_FinishCommandList(
         d3d11CommandBuffer->context,
         0,
         &commandList);
     ERROR_CHECK("Could not finish command list recording!");
 
+    SDL_LockMutex(renderer->contextLock);
+
     /* Submit the command list to the immediate context */
     ID3D11DeviceContext_ExecuteCommandList(
         renderer->immediateContext,
@@ -5624,6 +6817,14 @@ static void D3D11_Submit(
         0);
     ID3D11CommandList_Release(commandList);
 
+    /* Notify the command buffer completion query once the command list has executed */
+    ID3D11DeviceContext_End(
+        renderer->immediateContext,
+        (ID3D11Asynchronous *)d3d11CommandBuffer->fence->handle);
+
+    renderer->submissionSerial += 1;
+    d3d11CommandBuffer->fence->submissionSerial = renderer->submissionSerial;
+
     /* Mark the command buffer as submitted */
     if (renderer->submittedCommandBufferCount >= renderer->submittedCommandBufferCapacity) {
         renderer->submittedCommandBufferCapacity = renderer->submittedCommandBufferCount + 1;
@@ -5663,7 +6864,12 @@ static void D3D11_Submit(
 
         (void)SDL_AtomicIncRef(&d3d11CommandBuffer->fence->referenceCount);
 
-        windowData->frameCounter = (windowData->frameCounter + 1) % MAX_FRAMES_IN_FLIGHT;
+        windowData->frameCounter = (windowData->frameCounter + 1) % windowData->allowedFramesInFlight;
+    }
+
+    /* Present already flushed, otherwise flush once instead of on every completion poll */
+    if (!presenting) {
+        ID3D11DeviceContext_Flush(renderer->immediateContext);
     }
 
     /* Check if we can perform any cleanups */
@@ -5674,7 +6880,7 @@ static void D3D11_Submit(
             (ID3D11Asynchronous *)renderer->submittedCommandBuffers[i]->fence->handle,
             &queryData,
             sizeof(queryData),
-            0);
+            D3D11_ASYNC_GETDATA_DONOTFLUSH);
         if (res == S_OK) {
             D3D11_INTERNAL_CleanCommandBuffer(
                 renderer,
@@ -5684,6 +6890,11 @@ static void D3D11_Submit(
 
     D3D11_INTERNAL_PerformPendingDestroys(renderer);
 
+    /* Release cycled resources that have been idle for a while */
+    if (presenting) {
+        D3D11_INTERNAL_TrimCycledContainers(renderer);
+    }
+
     SDL_UnlockMutex(renderer->contextLock);
 }
 
@@ -5791,6 +7002,483 @@ static SDL_bool D3D11_IsTextureFormatSupported(
     return SDL_TRUE;
 }
 
+/* Pipeline Cache */
+
+/* D3D11 has no application-visible pipeline cache.
+ * The driver caches compiled shaders on its own.
+ */
+
+static SDL_bool D3D11_LoadPipelineCacheData(
+    Refresh_Renderer *driverData,
+    const void *data,
+    size_t dataSize)
+{
+    (void)driverData;
+    (void)data;
+    (void)dataSize;
+    return SDL_FALSE;
+}
+
+static SDL_bool D3D11_GetPipelineCacheData(
+    Refresh_Renderer *driverData,
+    void *data,
+    size_t *pDataSize)
+{
+    (void)driverData;
+    (void)data;
+    *pDataSize = 0;
+    return SDL_FALSE;
+}
+
+/* Shader Cache */
+
+static SDL_bool D3D11_CompileShaderBinary(
+    Refresh_Renderer *driverData,
+    Refresh_ShaderStage stage,
+    SDL_bool isCompute,
+    Refresh_ShaderFormat format,
+    const Uint8 *code,
+    size_t codeSize,
+    const char *entryPointName,
+    Refresh_ShaderFormat *pBinaryFormat,
+    void **pBinary,
+    size_t *pBinarySize)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+    ID3DBlob *blob;
+    (void)entryPointName;
+
+    if (format != REFRESH_SHADERFORMAT_HLSL) {
+        return SDL_FALSE;
+    }
+
+    blob = D3D11_INTERNAL_CompileHLSL(
+        renderer,
+        isCompute ? REFRESH_SHADERSTAGE_COMPUTE : stage,
+        code,
+        codeSize);
+    if (blob == NULL) {
+        return SDL_FALSE;
+    }
+
+    *pBinarySize = ID3D10Blob_GetBufferSize(blob);
+    *pBinary = SDL_malloc(*pBinarySize);
+    SDL_memcpy(*pBinary, ID3D10Blob_GetBufferPointer(blob), *pBinarySize);
+    *pBinaryFormat = REFRESH_SHADERFORMAT_DXBC;
+
+    ID3D10Blob_Release(blob);
+    return SDL_TRUE;
+}
+
+/* Timestamp Queries */
+
+static void D3D11_INTERNAL_DestroyQueryPool(
+    D3D11QueryPool *queryPool)
+{
+    for (Uint32 i = 0; i < queryPool->queryCount; i += 1) {
+        if (queryPool->timestampQueries[i] != NULL) {
+            ID3D11Query_Release(queryPool->timestampQueries[i]);
+        }
+    }
+    if (queryPool->disjointQuery != NULL) {
+        ID3D11Query_Release(queryPool->disjointQuery);
+    }
+    SDL_free(queryPool->timestampQueries);
+    SDL_free(queryPool);
+}
+
+static Refresh_QueryPool *D3D11_CreateTimestampQueryPool(
+    Refresh_Renderer *driverData,
+    Uint32 queryCount)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+    D3D11_QUERY_DESC queryDesc;
+    D3D11QueryPool *queryPool;
+    HRESULT res;
+
+    queryPool = SDL_malloc(sizeof(D3D11QueryPool));
+    queryPool->queryCount = queryCount;
+    queryPool->timestampQueries = SDL_calloc(queryCount, sizeof(ID3D11Query *));
+    SDL_AtomicSet(&queryPool->referenceCount, 0);
+
+    queryDesc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+    queryDesc.MiscFlags = 0;
+    res = ID3D11Device_CreateQuery(
+        renderer->device,
+        &queryDesc,
+        &queryPool->disjointQuery);
+    if (FAILED(res)) {
+        queryPool->disjointQuery = NULL;
+        D3D11_INTERNAL_DestroyQueryPool(queryPool);
+        D3D11_INTERNAL_LogError(renderer->device, "Could not create disjoint query", res);
+        return NULL;
+    }
+
+    queryDesc.Query = D3D11_QUERY_TIMESTAMP;
+    for (Uint32 i = 0; i < queryCount; i += 1) {
+        res = ID3D11Device_CreateQuery(
+            renderer->device,
+            &queryDesc,
+            &queryPool->timestampQueries[i]);
+        if (FAILED(res)) {
+            queryPool->timestampQueries[i] = NULL;
+            D3D11_INTERNAL_DestroyQueryPool(queryPool);
+            D3D11_INTERNAL_LogError(renderer->device, "Could not create timestamp query", res);
+            return NULL;
+        }
+    }
+
+    return (Refresh_QueryPool *)queryPool;
+}
+
+static void D3D11_ReleaseQueryPool(
+    Refresh_Renderer *driverData,
+    Refresh_QueryPool *queryPool)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+
+    /* Destroyed once no submitted command buffer uses it */
+    SDL_LockMutex(renderer->contextLock);
+
+    EXPAND_ARRAY_IF_NEEDED(
+        renderer->queryPoolsToDestroy,
+        D3D11QueryPool *,
+        renderer->queryPoolsToDestroyCount + 1,
+        renderer->queryPoolsToDestroyCapacity,
+        renderer->queryPoolsToDestroyCapacity + 1);
+
+    renderer->queryPoolsToDestroy[renderer->queryPoolsToDestroyCount] = (D3D11QueryPool *)queryPool;
+    renderer->queryPoolsToDestroyCount += 1;
+
+    SDL_UnlockMutex(renderer->contextLock);
+}
+
+static void D3D11_ResetQueryPool(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_QueryPool *queryPool)
+{
+    D3D11CommandBuffer *d3d11CommandBuffer = (D3D11CommandBuffer *)commandBuffer;
+    D3D11QueryPool *d3d11QueryPool = (D3D11QueryPool *)queryPool;
+
+    D3D11_INTERNAL_TrackQueryPool(d3d11CommandBuffer, d3d11QueryPool);
+
+    /* Timestamp queries are overwritten on End, only the disjoint query needs restarting */
+    for (Uint32 i = 0; i < d3d11CommandBuffer->activeQueryPoolCount; i += 1) {
+        if (d3d11CommandBuffer->activeQueryPools[i] == d3d11QueryPool) {
+            return;
+        }
+    }
+
+    ID3D11DeviceContext_Begin(
+        d3d11CommandBuffer->context,
+        (ID3D11Asynchronous *)d3d11QueryPool->disjointQuery);
+
+    EXPAND_ARRAY_IF_NEEDED(
+        d3d11CommandBuffer->activeQueryPools,
+        D3D11QueryPool *,
+        d3d11CommandBuffer->activeQueryPoolCount + 1,
+        d3d11CommandBuffer->activeQueryPoolCapacity,
+        d3d11CommandBuffer->activeQueryPoolCapacity + 1);
+
+    d3d11CommandBuffer->activeQueryPools[d3d11CommandBuffer->activeQueryPoolCount] = d3d11QueryPool;
+    d3d11CommandBuffer->activeQueryPoolCount += 1;
+}
+
+static void D3D11_WriteTimestamp(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_QueryPool *queryPool,
+    Uint32 queryIndex)
+{
+    D3D11CommandBuffer *d3d11CommandBuffer = (D3D11CommandBuffer *)commandBuffer;
+    D3D11QueryPool *d3d11QueryPool = (D3D11QueryPool *)queryPool;
+
+    if (queryIndex >= d3d11QueryPool->queryCount) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timestamp query index out of range!");
+        return;
+    }
+
+    ID3D11DeviceContext_End(
+        d3d11CommandBuffer->context,
+        (ID3D11Asynchronous *)d3d11QueryPool->timestampQueries[queryIndex]);
+
+    D3D11_INTERNAL_TrackQueryPool(d3d11CommandBuffer, d3d11QueryPool);
+}
+
+static SDL_bool D3D11_GetTimestampResults(
+    Refresh_Renderer *driverData,
+    Refresh_QueryPool *queryPool,
+    Uint32 firstQuery,
+    Uint32 queryCount,
+    Uint64 *results)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+    D3D11QueryPool *d3d11QueryPool = (D3D11QueryPool *)queryPool;
+    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjointData;
+    SDL_bool available = SDL_TRUE;
+    HRESULT res;
+
+    if (firstQuery > d3d11QueryPool->queryCount ||
+        queryCount > d3d11QueryPool->queryCount - firstQuery) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timestamp query range out of bounds!");
+        return SDL_FALSE;
+    }
+
+    SDL_LockMutex(renderer->contextLock);
+
+    res = ID3D11DeviceContext_GetData(
+        renderer->immediateContext,
+        (ID3D11Asynchronous *)d3d11QueryPool->disjointQuery,
+        &disjointData,
+        sizeof(disjointData),
+        D3D11_ASYNC_GETDATA_DONOTFLUSH);
+
+    /* A disjoint interval means the clock changed frequency, so the values are garbage */
+    if (res != S_OK || disjointData.Disjoint || disjointData.Frequency == 0) {
+        available = SDL_FALSE;
+    }
+
+    for (Uint32 i = 0; available && i < queryCount; i += 1) {
+        res = ID3D11DeviceContext_GetData(
+            renderer->immediateContext,
+            (ID3D11Asynchronous *)d3d11QueryPool->timestampQueries[firstQuery + i],
+            &results[i],
+            sizeof(Uint64),
+            D3D11_ASYNC_GETDATA_DONOTFLUSH);
+
+        if (res != S_OK) {
+            available = SDL_FALSE;
+        } else {
+            results[i] = (Uint64)((double)results[i] * (1000000000.0 / (double)disjointData.Frequency));
+        }
+    }
+
+    SDL_UnlockMutex(renderer->contextLock);
+
+    return available;
+}
+
+/* Bindless Resources */
+
+/* Shader model 5.0 has no unbounded descriptor arrays */
+
+static SDL_bool D3D11_SupportsBindless(
+    Refresh_Renderer *driverData)
+{
+    (void)driverData;
+    return SDL_FALSE;
+}
+
+static SDL_bool D3D11_RegisterBindlessTexture(
+    Refresh_Renderer *driverData,
+    Refresh_Texture *texture,
+    Uint32 *pIndex)
+{
+    (void)driverData;
+    (void)texture;
+    (void)pIndex;
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless resources are not supported on this backend!");
+    return SDL_FALSE;
+}
+
+static SDL_bool D3D11_RegisterBindlessSampler(
+    Refresh_Renderer *driverData,
+    Refresh_Sampler *sampler,
+    Uint32 *pIndex)
+{
+    (void)driverData;
+    (void)sampler;
+    (void)pIndex;
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless resources are not supported on this backend!");
+    return SDL_FALSE;
+}
+
+static SDL_bool D3D11_RegisterBindlessStorageBuffer(
+    Refresh_Renderer *driverData,
+    Refresh_Buffer *buffer,
+    Uint32 *pIndex)
+{
+    (void)driverData;
+    (void)buffer;
+    (void)pIndex;
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless resources are not supported on this backend!");
+    return SDL_FALSE;
+}
+
+static void D3D11_UnregisterBindlessResource(
+    Refresh_Renderer *driverData,
+    Refresh_BindlessResourceType resourceType,
+    Uint32 index)
+{
+    (void)driverData;
+    (void)resourceType;
+    (void)index;
+}
+
+/* Resource Cycling */
+
+static void D3D11_SetBufferCycleLimit(
+    Refresh_Renderer *driverData,
+    Refresh_Buffer *buffer,
+    Uint32 maxCycleCount)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+
+    SDL_LockMutex(renderer->cycleLock);
+    ((D3D11BufferContainer *)buffer)->maxCycleCount = maxCycleCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+}
+
+static void D3D11_SetTransferBufferCycleLimit(
+    Refresh_Renderer *driverData,
+    Refresh_TransferBuffer *transferBuffer,
+    Uint32 maxCycleCount)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+
+    SDL_LockMutex(renderer->cycleLock);
+    ((D3D11TransferBufferContainer *)transferBuffer)->maxCycleCount = maxCycleCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+}
+
+static void D3D11_SetTextureCycleLimit(
+    Refresh_Renderer *driverData,
+    Refresh_Texture *texture,
+    Uint32 maxCycleCount)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+
+    SDL_LockMutex(renderer->cycleLock);
+    ((D3D11TextureContainer *)texture)->maxCycleCount = maxCycleCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+}
+
+static Uint32 D3D11_GetBufferCycleCount(
+    Refresh_Renderer *driverData,
+    Refresh_Buffer *buffer)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+    Uint32 count;
+
+    SDL_LockMutex(renderer->cycleLock);
+    count = ((D3D11BufferContainer *)buffer)->bufferCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+
+    return count;
+}
+
+static Uint32 D3D11_GetTransferBufferCycleCount(
+    Refresh_Renderer *driverData,
+    Refresh_TransferBuffer *transferBuffer)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+    Uint32 count;
+
+    SDL_LockMutex(renderer->cycleLock);
+    count = ((D3D11TransferBufferContainer *)transferBuffer)->bufferCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+
+    return count;
+}
+
+static Uint32 D3D11_GetTextureCycleCount(
+    Refresh_Renderer *driverData,
+    Refresh_Texture *texture)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+    Uint32 count;
+
+    SDL_LockMutex(renderer->cycleLock);
+    count = ((D3D11TextureContainer *)texture)->textureCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+
+    return count;
+}
+
+static void D3D11_SetCycleTrimFrames(
+    Refresh_Renderer *driverData,
+    Uint32 frameCount)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+
+    SDL_LockMutex(renderer->cycleLock);
+    renderer->cycleTrimFrames = frameCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+}
+
+/* Defragmentation */
+
+/* Resources are not suballocated on this backend, the driver owns placement */
+
+static void D3D11_SetDefragmentationSettings(
+    Refresh_Renderer *driverData,
+    Refresh_DefragmentationSettings *settings)
+{
+    (void)driverData;
+    (void)settings;
+}
+
+static void D3D11_RequestDefragmentation(
+    Refresh_Renderer *driverData)
+{
+    (void)driverData;
+}
+
+/* Statistics */
+
+static void D3D11_GetDeviceStatistics(
+    Refresh_Renderer *driverData,
+    Refresh_DeviceStatistics *statistics)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+
+    /* No descriptor sets, barriers or defragmentation on this backend */
+    SDL_zerop(statistics);
+
+    SDL_LockMutex(renderer->cycleLock);
+    statistics->cycleHandlesCreated = renderer->cycleHandlesCreated;
+    statistics->cycleHandlesTrimmed = renderer->cycleHandlesTrimmed;
+    statistics->cycleLimitHits = renderer->cycleLimitHits;
+    SDL_UnlockMutex(renderer->cycleLock);
+}
+
+static void D3D11_GetMemoryStatistics(
+    Refresh_Renderer *driverData,
+    Refresh_MemoryStatistics *statistics)
+{
+    D3D11Renderer *renderer = (D3D11Renderer *)driverData;
+    IDXGIAdapter3 *adapter3;
+    DXGI_QUERY_VIDEO_MEMORY_INFO memoryInfo;
+    DXGI_ADAPTER_DESC1 adapterDesc;
+    HRESULT res;
+
+    SDL_zerop(statistics);
+
+    /* QueryVideoMemoryInfo needs Windows 10, otherwise report the dedicated memory size */
+    res = IDXGIAdapter1_QueryInterface(
+        renderer->adapter,
+        &D3D_IID_IDXGIAdapter3,
+        (void **)&adapter3);
+    if (SUCCEEDED(res)) {
+        res = IDXGIAdapter3_QueryVideoMemoryInfo(
+            adapter3,
+            0,
+            DXGI_MEMORY_SEGMENT_GROUP_LOCAL,
+            &memoryInfo);
+        IDXGIAdapter3_Release(adapter3);
+
+        if (SUCCEEDED(res)) {
+            statistics->budgetBytes = memoryInfo.Budget;
+            statistics->usageBytes = memoryInfo.CurrentUsage;
+            statistics->allocatedBytes = memoryInfo.CurrentUsage;
+            statistics->usedBytes = memoryInfo.CurrentUsage;
+            return;
+        }
+    }
+
+    IDXGIAdapter1_GetDesc1(renderer->adapter, &adapterDesc);
+    statistics->budgetBytes = adapterDesc.DedicatedVideoMemory;
+}
+
 /* Device Creation */
 
 static SDL_bool D3D11_PrepareDriver()
@@ -6263,8 +7951,10 @@ tryCreateDevice:
     renderer->contextLock = SDL_CreateMutex();
     renderer->acquireCommandBufferLock = SDL_CreateMutex();
     renderer->acquireUniformBufferLock = SDL_CreateMutex();
+    renderer->acquireStagingBlockLock = SDL_CreateMutex();
     renderer->fenceLock = SDL_CreateMutex();
     renderer->windowLock = SDL_CreateMutex();
+    renderer->cycleLock = SDL_CreateMutex();
 
     /* Initialize miscellaneous renderer members */
     renderer->debugMode = (flags & D3D11_CREATE_DEVICE_DEBUG);
@@ -6279,8 +7969,8 @@ tryCreateDevice:
 
     /* Create uniform buffer pool */
 
-    renderer->uniformBufferPoolCapacity = 32;
-    renderer->uniformBufferPoolCount = 32;
+    renderer->uniformBufferPoolCapacity = 8;
+    renderer->uniformBufferPoolCount = 8;
     renderer->uniformBufferPool = SDL_malloc(
         renderer->uniformBufferPoolCapacity * sizeof(D3D11UniformBuffer *));
 
@@ -6290,6 +7980,13 @@ tryCreateDevice:
             UNIFORM_BUFFER_SIZE);
     }
 
+    /* Staging blocks are created on demand */
+
+    renderer->stagingBlockPoolCapacity = 4;
+    renderer->stagingBlockPoolCount = 0;
+    renderer->stagingBlockPool = SDL_malloc(
+        renderer->stagingBlockPoolCapacity * sizeof(D3D11TransferBufferContainer *));
+
     /* Create deferred destroy arrays */
     renderer->transferBufferContainersToDestroyCapacity = 2;
     renderer->transferBufferContainersToDestroyCount = 0;
@@ -6306,6 +8003,27 @@ tryCreateDevice:
     renderer->textureContainersToDestroy = SDL_malloc(
         renderer->textureContainersToDestroyCapacity * sizeof(D3D11TextureContainer *));
 
+    renderer->queryPoolsToDestroyCapacity = 2;
+    renderer->queryPoolsToDestroyCount = 0;
+    renderer->queryPoolsToDestroy = SDL_malloc(
+        renderer->queryPoolsToDestroyCapacity * sizeof(D3D11QueryPool *));
+
+    /* Create cycled container lists */
+    renderer->cycledTransferBufferContainerCapacity = 2;
+    renderer->cycledTransferBufferContainerCount = 0;
+    renderer->cycledTransferBufferContainers = SDL_malloc(
+        renderer->cycledTransferBufferContainerCapacity * sizeof(D3D11TransferBufferContainer *));
+
+    renderer->cycledBufferContainerCapacity = 2;
+    renderer->cycledBufferContainerCount = 0;
+    renderer->cycledBufferContainers = SDL_malloc(
+        renderer->cycledBufferContainerCapacity * sizeof(D3D11BufferContainer *));
+
+    renderer->cycledTextureContainerCapacity = 2;
+    renderer->cycledTextureContainerCount = 0;
+    renderer->cycledTextureContainers = SDL_malloc(
+        renderer->cycledTextureContainerCapacity * sizeof(D3D11TextureContainer *));
+
     /* Create claimed window list */
     renderer->claimedWindowCapacity = 1;
     renderer->claimedWindows = SDL_malloc(
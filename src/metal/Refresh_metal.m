@@ -39,6 +39,9 @@
 #define WINDOW_PROPERTY_DATA        "Refresh_MetalWindowPropertyData"
 #define REFRESH_SHADERSTAGE_COMPUTE 2
 
+#define METAL_HEAP_SIZE                 16777216 /* 16 MiB */
+#define METAL_HEAP_ALLOCATION_THRESHOLD 2097152  /* 2  MiB, larger resources get their own allocation */
+
 #define EXPAND_ARRAY_IF_NEEDED(arr, elementType, newCount, capacity, newCapacity) \
     if (newCount >= capacity) {                                                   \
         capacity = newCapacity;                                                   \
@@ -350,12 +353,17 @@ typedef struct MetalTextureContainer
     Uint32 textureCount;
     MetalTexture **textures;
 
+    /* 0 means no limit. Cycling state is protected by the renderer's cycleLock. */
+    Uint32 maxCycleCount;
+    Uint64 lastCycleFrame;
+
     char *debugName;
 } MetalTextureContainer;
 
 typedef struct MetalFence
 {
     SDL_atomic_t complete;
+    Uint64 submissionSerial;
 } MetalFence;
 
 typedef struct MetalWindowData
@@ -366,6 +374,9 @@ typedef struct MetalWindowData
     id<CAMetalDrawable> drawable;
     MetalTexture texture;
     MetalTextureContainer textureContainer;
+    SDL_sem *frameSemaphore; /* One count per frame slot, survives swapchain changes */
+    SDL_bool frameSlotAcquired;
+    Uint32 allowedFramesInFlight;
 } MetalWindowData;
 
 typedef struct MetalShader
@@ -416,6 +427,27 @@ typedef struct MetalComputePipeline
     Uint32 threadCountZ;
 } MetalComputePipeline;
 
+/* Heaps are sub-allocated by storage and CPU cache mode */
+typedef enum MetalHeapType
+{
+    METAL_HEAP_TYPE_PRIVATE,
+    METAL_HEAP_TYPE_SHARED,
+    METAL_HEAP_TYPE_SHARED_WRITE_COMBINED,
+    METAL_HEAP_TYPE_COUNT
+} MetalHeapType;
+
+typedef struct MetalHeap
+{
+    id<MTLHeap> handle;
+} MetalHeap;
+
+typedef struct MetalHeapPool
+{
+    MetalHeap **heaps;
+    Uint32 heapCount;
+    Uint32 heapCapacity;
+} MetalHeapPool;
+
 typedef struct MetalBuffer
 {
     id<MTLBuffer> handle;
@@ -433,6 +465,11 @@ typedef struct MetalBufferContainer
 
     SDL_bool isPrivate;
     SDL_bool isWriteOnly;
+
+    /* 0 means no limit. Cycling state is protected by the renderer's cycleLock. */
+    Uint32 maxCycleCount;
+    Uint64 lastCycleFrame;
+
     char *debugName;
 } MetalBufferContainer;
 
@@ -440,9 +477,16 @@ typedef struct MetalUniformBuffer
 {
     id<MTLBuffer> handle;
     Uint32 writeOffset;
-    Uint32 drawOffset;
 } MetalUniformBuffer;
 
+/* A released container, queued against the submission count at release time */
+typedef struct MetalDeferredDestroy
+{
+    SDL_bool isTexture;
+    Uint64 submissionSerial;
+    void *container;
+} MetalDeferredDestroy;
+
 typedef struct MetalRenderer MetalRenderer;
 
 typedef struct MetalCommandBuffer
@@ -465,6 +509,15 @@ typedef struct MetalCommandBuffer
     Uint32 indexBufferOffset;
     Refresh_IndexElementSize indexElementSize;
 
+    /* Parallel Render Pass, each chunk encodes with its own render encoder */
+    id<MTLParallelRenderCommandEncoder> parallelRenderEncoder;
+    MTLViewport renderPassViewport;
+    MTLScissorRect renderPassScissorRect;
+
+    struct MetalCommandBuffer **renderPassChunks; /* Cleaned along with this command buffer */
+    Uint32 renderPassChunkCount;
+    Uint32 renderPassChunkCapacity;
+
     /* Copy Pass */
     id<MTLBlitCommandEncoder> blitEncoder;
 
@@ -477,15 +530,18 @@ typedef struct MetalCommandBuffer
     SDL_bool needVertexStorageTextureBind;
     SDL_bool needVertexStorageBufferBind;
     SDL_bool needVertexUniformBind;
+    SDL_bool needVertexUniformOffsetBind;
 
     SDL_bool needFragmentSamplerBind;
     SDL_bool needFragmentStorageTextureBind;
     SDL_bool needFragmentStorageBufferBind;
     SDL_bool needFragmentUniformBind;
+    SDL_bool needFragmentUniformOffsetBind;
 
     SDL_bool needComputeTextureBind;
     SDL_bool needComputeBufferBind;
     SDL_bool needComputeUniformBind;
+    SDL_bool needComputeUniformOffsetBind;
 
     id<MTLSamplerState> vertexSamplers[MAX_TEXTURE_SAMPLERS_PER_STAGE];
     id<MTLTexture> vertexTextures[MAX_TEXTURE_SAMPLERS_PER_STAGE];
@@ -502,18 +558,33 @@ typedef struct MetalCommandBuffer
     id<MTLTexture> computeReadWriteTextures[MAX_STORAGE_TEXTURES_PER_STAGE];
     id<MTLBuffer> computeReadWriteBuffers[MAX_STORAGE_BUFFERS_PER_STAGE];
 
-    /* Uniform buffers */
+    /* Uniform buffers, every stage and slot sub-allocates from the current one */
+    MetalUniformBuffer *currentUniformBuffer;
+
     MetalUniformBuffer *vertexUniformBuffers[MAX_UNIFORM_BUFFERS_PER_STAGE];
     MetalUniformBuffer *fragmentUniformBuffers[MAX_UNIFORM_BUFFERS_PER_STAGE];
     MetalUniformBuffer *computeUniformBuffers[MAX_UNIFORM_BUFFERS_PER_STAGE];
 
+    Uint32 vertexUniformDrawOffsets[MAX_UNIFORM_BUFFERS_PER_STAGE];
+    Uint32 fragmentUniformDrawOffsets[MAX_UNIFORM_BUFFERS_PER_STAGE];
+    Uint32 computeUniformDrawOffsets[MAX_UNIFORM_BUFFERS_PER_STAGE];
+
     MetalUniformBuffer **usedUniformBuffers;
     Uint32 usedUniformBufferCount;
     Uint32 usedUniformBufferCapacity;
 
+    /* Staging memory is linearly allocated from the current block */
+    MetalBufferContainer *currentStagingBlock;
+    Uint32 stagingBlockOffset;
+
+    MetalBufferContainer **usedStagingBlocks;
+    Uint32 usedStagingBlockCount;
+    Uint32 usedStagingBlockCapacity;
+
     /* Fences */
     MetalFence *fence;
     Uint8 autoReleaseFence;
+    Uint64 submissionSerial; /* Assigned under disposeLock on submit */
 
     /* Reference Counting */
     MetalBuffer **usedBuffers;
@@ -530,6 +601,16 @@ typedef struct MetalSampler
     id<MTLSamplerState> handle;
 } MetalSampler;
 
+typedef struct MetalQueryPool
+{
+    id<MTLCounterSampleBuffer> sampleBuffer;
+    Uint32 queryCount;
+
+    /* Reference point used to convert GPU ticks to nanoseconds */
+    MTLTimestamp cpuTimestamp;
+    MTLTimestamp gpuTimestamp;
+} MetalQueryPool;
+
 typedef struct BlitPipeline
 {
     Refresh_GraphicsPipeline *pipeline;
@@ -541,6 +622,9 @@ struct MetalRenderer
     id<MTLDevice> device;
     id<MTLCommandQueue> queue;
 
+    /* nil when binary archives are unavailable (macOS < 11) */
+    id<MTLBinaryArchive> pipelineArchive;
+
     SDL_bool debugMode;
 
     MetalWindowData **claimedWindows;
@@ -563,13 +647,41 @@ struct MetalRenderer
     Uint32 uniformBufferPoolCount;
     Uint32 uniformBufferPoolCapacity;
 
-    MetalBufferContainer **bufferContainersToDestroy;
-    Uint32 bufferContainersToDestroyCount;
-    Uint32 bufferContainersToDestroyCapacity;
+    /* Shared STAGING_BLOCK_SIZE transfer buffers */
+    MetalBufferContainer **stagingBlockPool;
+    Uint32 stagingBlockPoolCount;
+    Uint32 stagingBlockPoolCapacity;
+
+    /* Released containers in release order, so submission serials never decrease.
+     * Protected by disposeLock.
+     */
+    MetalDeferredDestroy *deferredDestroys;
+    Uint32 deferredDestroyCount;
+    Uint32 deferredDestroyCapacity;
+
+    Uint64 submissionSerial;
+
+    /* Containers holding more than one resource, trimmed under cycleLock */
+    MetalBufferContainer **cycledBufferContainers;
+    Uint32 cycledBufferContainerCount;
+    Uint32 cycledBufferContainerCapacity;
+
+    MetalTextureContainer **cycledTextureContainers;
+    Uint32 cycledTextureContainerCount;
+    Uint32 cycledTextureContainerCapacity;
 
-    MetalTextureContainer **textureContainersToDestroy;
-    Uint32 textureContainersToDestroyCount;
-    Uint32 textureContainersToDestroyCapacity;
+    Uint64 presentedFrameCount;
+    Uint32 cycleTrimFrames;
+
+    Uint64 cycleHandlesCreated;
+    Uint64 cycleHandlesTrimmed;
+    Uint64 cycleLimitHits;
+
+    /* Small resources are placed in heaps, protected by heapLock.
+     * A heap type that isn't supported never gets any heaps.
+     */
+    MetalHeapPool heapPools[METAL_HEAP_TYPE_COUNT];
+    SDL_bool supportsHeapType[METAL_HEAP_TYPE_COUNT];
 
     /* Blit */
     Refresh_Shader *fullscreenVertexShader;
@@ -586,9 +698,18 @@ struct MetalRenderer
     SDL_mutex *submitLock;
     SDL_mutex *acquireCommandBufferLock;
     SDL_mutex *acquireUniformBufferLock;
+    SDL_mutex *acquireStagingBlockLock;
     SDL_mutex *disposeLock;
     SDL_mutex *fenceLock;
     SDL_mutex *windowLock;
+    SDL_mutex *cycleLock;
+    SDL_mutex *heapLock;
+
+    /* Broadcast when a fence completes or the fence callback waiter is woken */
+    SDL_mutex *fenceCompleteLock;
+    SDL_cond *fenceCompleteCond;
+    Uint32 fenceWakeCount;    /* Guarded by fenceCompleteLock */
+    Uint32 fenceWakeConsumed; /* Guarded by fenceCompleteLock, only advanced by the waiter */
 };
 
 /* Helper Functions */
@@ -608,6 +729,9 @@ static inline Uint32 METAL_INTERNAL_NextHighestAlignment(
 
 /* Quit */
 
+static void METAL_INTERNAL_DestroyBufferContainer(
+    MetalBufferContainer *container);
+
 static void METAL_DestroyDevice(Refresh_Device *device)
 {
     MetalRenderer *renderer = (MetalRenderer *)device->driverData;
@@ -630,11 +754,19 @@ static void METAL_DestroyDevice(Refresh_Device *device)
     }
     SDL_free(renderer->uniformBufferPool);
 
+    /* Release staging blocks */
+    for (Uint32 i = 0; i < renderer->stagingBlockPoolCount; i += 1) {
+        METAL_INTERNAL_DestroyBufferContainer(renderer->stagingBlockPool[i]);
+    }
+    SDL_free(renderer->stagingBlockPool);
+
     /* Release command buffer infrastructure */
     for (Uint32 i = 0; i < renderer->availableCommandBufferCount; i += 1) {
         MetalCommandBuffer *commandBuffer = renderer->availableCommandBuffers[i];
         SDL_free(commandBuffer->usedBuffers);
         SDL_free(commandBuffer->usedTextures);
+        SDL_free(commandBuffer->usedStagingBlocks);
+        SDL_free(commandBuffer->renderPassChunks);
         SDL_free(commandBuffer);
     }
     SDL_free(renderer->availableCommandBuffers);
@@ -647,13 +779,37 @@ static void METAL_DestroyDevice(Refresh_Device *device)
     }
     SDL_free(renderer->availableFences);
 
+    /* Release the deferred destroy queue */
+    SDL_free(renderer->deferredDestroys);
+
+    /* Release the heaps, every resource placed in them is gone by now */
+    for (Uint32 i = 0; i < METAL_HEAP_TYPE_COUNT; i += 1) {
+        for (Uint32 j = 0; j < renderer->heapPools[i].heapCount; j += 1) {
+            renderer->heapPools[i].heaps[j]->handle = nil;
+            SDL_free(renderer->heapPools[i].heaps[j]);
+        }
+        SDL_free(renderer->heapPools[i].heaps);
+    }
+
+    /* Release the cycled container lists, the containers are owned by the client */
+    SDL_free(renderer->cycledBufferContainers);
+    SDL_free(renderer->cycledTextureContainers);
+
+    /* Release the pipeline archive */
+    renderer->pipelineArchive = nil;
+
     /* Release the mutexes */
     SDL_DestroyMutex(renderer->submitLock);
     SDL_DestroyMutex(renderer->acquireCommandBufferLock);
     SDL_DestroyMutex(renderer->acquireUniformBufferLock);
+    SDL_DestroyMutex(renderer->acquireStagingBlockLock);
     SDL_DestroyMutex(renderer->disposeLock);
     SDL_DestroyMutex(renderer->fenceLock);
     SDL_DestroyMutex(renderer->windowLock);
+    SDL_DestroyMutex(renderer->cycleLock);
+    SDL_DestroyMutex(renderer->heapLock);
+    SDL_DestroyMutex(renderer->fenceCompleteLock);
+    SDL_DestroyCond(renderer->fenceCompleteCond);
 
     /* Free the primary structures */
     SDL_free(renderer);
@@ -774,6 +930,25 @@ static MetalLibraryFunction METAL_INTERNAL_CompileShader(
 
 /* Disposal */
 
+/* Must be called with the dispose lock held */
+static void METAL_INTERNAL_QueueDeferredDestroy(
+    MetalRenderer *renderer,
+    SDL_bool isTexture,
+    void *container)
+{
+    EXPAND_ARRAY_IF_NEEDED(
+        renderer->deferredDestroys,
+        MetalDeferredDestroy,
+        renderer->deferredDestroyCount + 1,
+        renderer->deferredDestroyCapacity,
+        renderer->deferredDestroyCapacity * 2);
+
+    renderer->deferredDestroys[renderer->deferredDestroyCount].isTexture = isTexture;
+    renderer->deferredDestroys[renderer->deferredDestroyCount].submissionSerial = renderer->submissionSerial;
+    renderer->deferredDestroys[renderer->deferredDestroyCount].container = container;
+    renderer->deferredDestroyCount += 1;
+}
+
 static void METAL_INTERNAL_DestroyTextureContainer(
     MetalTextureContainer *container)
 {
@@ -794,17 +969,19 @@ static void METAL_ReleaseTexture(
     MetalRenderer *renderer = (MetalRenderer *)driverData;
     MetalTextureContainer *container = (MetalTextureContainer *)texture;
 
-    SDL_LockMutex(renderer->disposeLock);
+    SDL_LockMutex(renderer->cycleLock);
+    for (Uint32 i = 0; i < renderer->cycledTextureContainerCount; i += 1) {
+        if (renderer->cycledTextureContainers[i] == container) {
+            renderer->cycledTextureContainers[i] = renderer->cycledTextureContainers[renderer->cycledTextureContainerCount - 1];
+            renderer->cycledTextureContainerCount -= 1;
+            break;
+        }
+    }
+    SDL_UnlockMutex(renderer->cycleLock);
 
-    EXPAND_ARRAY_IF_NEEDED(
-        renderer->textureContainersToDestroy,
-        MetalTextureContainer *,
-        renderer->textureContainersToDestroyCount + 1,
-        renderer->textureContainersToDestroyCapacity,
-        renderer->textureContainersToDestroyCapacity + 1);
+    SDL_LockMutex(renderer->disposeLock);
 
-    renderer->textureContainersToDestroy[renderer->textureContainersToDestroyCount] = container;
-    renderer->textureContainersToDestroyCount += 1;
+    METAL_INTERNAL_QueueDeferredDestroy(renderer, SDL_TRUE, container);
 
     SDL_UnlockMutex(renderer->disposeLock);
 }
@@ -838,17 +1015,19 @@ static void METAL_ReleaseBuffer(
     MetalRenderer *renderer = (MetalRenderer *)driverData;
     MetalBufferContainer *container = (MetalBufferContainer *)buffer;
 
-    SDL_LockMutex(renderer->disposeLock);
+    SDL_LockMutex(renderer->cycleLock);
+    for (Uint32 i = 0; i < renderer->cycledBufferContainerCount; i += 1) {
+        if (renderer->cycledBufferContainers[i] == container) {
+            renderer->cycledBufferContainers[i] = renderer->cycledBufferContainers[renderer->cycledBufferContainerCount - 1];
+            renderer->cycledBufferContainerCount -= 1;
+            break;
+        }
+    }
+    SDL_UnlockMutex(renderer->cycleLock);
 
-    EXPAND_ARRAY_IF_NEEDED(
-        renderer->bufferContainersToDestroy,
-        MetalBufferContainer *,
-        renderer->bufferContainersToDestroyCount + 1,
-        renderer->bufferContainersToDestroyCapacity,
-        renderer->bufferContainersToDestroyCapacity + 1);
+    SDL_LockMutex(renderer->disposeLock);
 
-    renderer->bufferContainersToDestroy[renderer->bufferContainersToDestroyCount] = container;
-    renderer->bufferContainersToDestroyCount += 1;
+    METAL_INTERNAL_QueueDeferredDestroy(renderer, SDL_FALSE, container);
 
     SDL_UnlockMutex(renderer->disposeLock);
 }
@@ -914,7 +1093,25 @@ static Refresh_ComputePipeline *METAL_CreateComputePipeline(
         return NULL;
     }
 
-    handle = [renderer->device newComputePipelineStateWithFunction:libraryFunction.function error:&error];
+    if (renderer->pipelineArchive != nil) {
+        if (@available(macOS 11.0, *)) {
+            MTLComputePipelineDescriptor *descriptor = [MTLComputePipelineDescriptor new];
+            descriptor.computeFunction = libraryFunction.function;
+            descriptor.binaryArchives = @[ renderer->pipelineArchive ];
+
+            handle = [renderer->device newComputePipelineStateWithDescriptor:descriptor
+                                                                     options:MTLPipelineOptionNone
+                                                                  reflection:nil
+                                                                       error:&error];
+
+            /* Record the pipeline so that it can be serialized */
+            if (error == NULL) {
+                [renderer->pipelineArchive addComputePipelineFunctionsWithDescriptor:descriptor error:nil];
+            }
+        }
+    } else {
+        handle = [renderer->device newComputePipelineStateWithFunction:libraryFunction.function error:&error];
+    }
     if (error != NULL) {
         SDL_LogError(
             SDL_LOG_CATEGORY_APPLICATION,
@@ -1039,6 +1236,12 @@ static Refresh_GraphicsPipeline *METAL_CreateGraphicsPipeline(
 
     /* Create the graphics pipeline */
 
+    if (renderer->pipelineArchive != nil) {
+        if (@available(macOS 11.0, *)) {
+            pipelineDescriptor.binaryArchives = @[ renderer->pipelineArchive ];
+        }
+    }
+
     pipelineState = [renderer->device newRenderPipelineStateWithDescriptor:pipelineDescriptor error:&error];
     if (error != NULL) {
         SDL_LogError(
@@ -1047,6 +1250,13 @@ static Refresh_GraphicsPipeline *METAL_CreateGraphicsPipeline(
         return NULL;
     }
 
+    /* Record the pipeline so that it can be serialized */
+    if (renderer->pipelineArchive != nil) {
+        if (@available(macOS 11.0, *)) {
+            [renderer->pipelineArchive addRenderPipelineFunctionsWithDescriptor:pipelineDescriptor error:nil];
+        }
+    }
+
     result = SDL_malloc(sizeof(MetalGraphicsPipeline));
     result->handle = pipelineState;
     result->blendConstants[0] = pipelineCreateInfo->blendConstants[0];
@@ -1255,6 +1465,152 @@ static Refresh_Shader *METAL_CreateShader(
     return (Refresh_Shader *)result;
 }
 
+/* Heaps */
+
+static MetalHeapType METAL_INTERNAL_GetHeapType(
+    MTLResourceOptions resourceOptions)
+{
+    if ((resourceOptions & MTLResourceStorageModePrivate) == MTLResourceStorageModePrivate) {
+        return METAL_HEAP_TYPE_PRIVATE;
+    } else if (resourceOptions & MTLResourceCPUCacheModeWriteCombined) {
+        return METAL_HEAP_TYPE_SHARED_WRITE_COMBINED;
+    } else {
+        return METAL_HEAP_TYPE_SHARED;
+    }
+}
+
+/* Must be called with the heap lock held. Returns nil if no heap can fit the allocation. */
+static id<MTLHeap> METAL_INTERNAL_FindHeap(
+    MetalRenderer *renderer,
+    MetalHeapType heapType,
+    MTLSizeAndAlign sizeAndAlign)
+{
+    MetalHeapPool *pool = &renderer->heapPools[heapType];
+    MTLHeapDescriptor *heapDescriptor;
+    id<MTLHeap> heap;
+
+    if (!renderer->supportsHeapType[heapType] || sizeAndAlign.size > METAL_HEAP_ALLOCATION_THRESHOLD) {
+        return nil;
+    }
+
+    for (Uint32 i = 0; i < pool->heapCount; i += 1) {
+        if ([pool->heaps[i]->handle maxAvailableSizeWithAlignment:sizeAndAlign.align] >= sizeAndAlign.size) {
+            return pool->heaps[i]->handle;
+        }
+    }
+
+    heapDescriptor = [MTLHeapDescriptor new];
+    heapDescriptor.size = METAL_HEAP_SIZE;
+    heapDescriptor.storageMode = (heapType == METAL_HEAP_TYPE_PRIVATE) ? MTLStorageModePrivate : MTLStorageModeShared;
+    heapDescriptor.cpuCacheMode = (heapType == METAL_HEAP_TYPE_SHARED_WRITE_COMBINED) ? MTLCPUCacheModeWriteCombined : MTLCPUCacheModeDefaultCache;
+    if (@available(macOS 10.15, iOS 13.0, tvOS 13.0, *)) {
+        /* The rest of the backend relies on Metal's automatic hazard tracking */
+        heapDescriptor.hazardTrackingMode = MTLHazardTrackingModeTracked;
+    }
+
+    heap = [renderer->device newHeapWithDescriptor:heapDescriptor];
+    if (heap == nil) {
+        return nil;
+    }
+
+    EXPAND_ARRAY_IF_NEEDED(
+        pool->heaps,
+        MetalHeap *,
+        pool->heapCount + 1,
+        pool->heapCapacity,
+        pool->heapCapacity + 1);
+
+    pool->heaps[pool->heapCount] = SDL_malloc(sizeof(MetalHeap));
+    pool->heaps[pool->heapCount]->handle = heap;
+    pool->heapCount += 1;
+
+    return heap;
+}
+
+static id<MTLBuffer> METAL_INTERNAL_NewBuffer(
+    MetalRenderer *renderer,
+    Uint32 sizeInBytes,
+    MTLResourceOptions resourceOptions)
+{
+    MetalHeapType heapType = METAL_INTERNAL_GetHeapType(resourceOptions);
+    id<MTLBuffer> buffer = nil;
+    id<MTLHeap> heap;
+
+    if (renderer->supportsHeapType[heapType]) {
+        SDL_LockMutex(renderer->heapLock);
+
+        heap = METAL_INTERNAL_FindHeap(
+            renderer,
+            heapType,
+            [renderer->device heapBufferSizeAndAlignWithLength:sizeInBytes options:resourceOptions]);
+
+        if (heap != nil) {
+            buffer = [heap newBufferWithLength:sizeInBytes options:resourceOptions];
+        }
+
+        SDL_UnlockMutex(renderer->heapLock);
+    }
+
+    if (buffer == nil) {
+        buffer = [renderer->device newBufferWithLength:sizeInBytes options:resourceOptions];
+    }
+
+    return buffer;
+}
+
+static id<MTLTexture> METAL_INTERNAL_NewTexture(
+    MetalRenderer *renderer,
+    MTLTextureDescriptor *textureDescriptor)
+{
+    id<MTLTexture> texture = nil;
+    id<MTLHeap> heap;
+
+    /* Textures are always private */
+    if (renderer->supportsHeapType[METAL_HEAP_TYPE_PRIVATE]) {
+        SDL_LockMutex(renderer->heapLock);
+
+        heap = METAL_INTERNAL_FindHeap(
+            renderer,
+            METAL_HEAP_TYPE_PRIVATE,
+            [renderer->device heapTextureSizeAndAlignWithDescriptor:textureDescriptor]);
+
+        if (heap != nil) {
+            texture = [heap newTextureWithDescriptor:textureDescriptor];
+        }
+
+        SDL_UnlockMutex(renderer->heapLock);
+    }
+
+    if (texture == nil) {
+        texture = [renderer->device newTextureWithDescriptor:textureDescriptor];
+    }
+
+    return texture;
+}
+
+/* Releases empty heaps, keeping one of each type around for reuse */
+static void METAL_INTERNAL_TrimHeaps(
+    MetalRenderer *renderer)
+{
+    SDL_LockMutex(renderer->heapLock);
+
+    for (Uint32 i = 0; i < METAL_HEAP_TYPE_COUNT; i += 1) {
+        MetalHeapPool *pool = &renderer->heapPools[i];
+
+        for (Sint32 j = pool->heapCount - 1; j >= 1; j -= 1) {
+            if (pool->heaps[j]->handle.usedSize == 0) {
+                pool->heaps[j]->handle = nil;
+                SDL_free(pool->heaps[j]);
+
+                pool->heaps[j] = pool->heaps[pool->heapCount - 1];
+                pool->heapCount -= 1;
+            }
+        }
+    }
+
+    SDL_UnlockMutex(renderer->heapLock);
+}
+
 static MetalTexture *METAL_INTERNAL_CreateTexture(
     MetalRenderer *renderer,
     Refresh_TextureCreateInfo *textureCreateInfo)
@@ -1308,7 +1664,7 @@ static MetalTexture *METAL_INTERNAL_CreateTexture(
         textureDescriptor.usage |= MTLTextureUsageShaderWrite;
     }
 
-    texture = [renderer->device newTextureWithDescriptor:textureDescriptor];
+    texture = METAL_INTERNAL_NewTexture(renderer, textureDescriptor);
     if (texture == NULL) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create MTLTexture!");
         return NULL;
@@ -1320,7 +1676,7 @@ static MetalTexture *METAL_INTERNAL_CreateTexture(
         textureDescriptor.sampleCount = RefreshToMetal_SampleCount[textureCreateInfo->sampleCount];
         textureDescriptor.usage = MTLTextureUsageRenderTarget;
 
-        msaaTexture = [renderer->device newTextureWithDescriptor:textureDescriptor];
+        msaaTexture = METAL_INTERNAL_NewTexture(renderer, textureDescriptor);
         if (msaaTexture == NULL) {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create MSAA MTLTexture!");
             return NULL;
@@ -1396,6 +1752,8 @@ static Refresh_Texture *METAL_CreateTexture(
     container->textures = SDL_malloc(
         container->textureCapacity * sizeof(MetalTexture *));
     container->textures[0] = texture;
+    container->maxCycleCount = 0;
+    container->lastCycleFrame = 0;
     container->debugName = NULL;
 
     return (Refresh_Texture *)container;
@@ -1405,8 +1763,22 @@ static void METAL_INTERNAL_CycleActiveTexture(
     MetalRenderer *renderer,
     MetalTextureContainer *container)
 {
+    SDL_LockMutex(renderer->cycleLock);
+
+    container->lastCycleFrame = renderer->presentedFrameCount;
+
     for (Uint32 i = 0; i < container->textureCount; i += 1) {
-        container->activeTexture = container->textures[i];
+        if (SDL_AtomicGet(&container->textures[i]->referenceCount) == 0) {
+            container->activeTexture = container->textures[i];
+            SDL_UnlockMutex(renderer->cycleLock);
+            return;
+        }
+    }
+
+    /* At the limit the active texture is kept, as if cycle were false. */
+    if (container->maxCycleCount > 0 && container->textureCount >= container->maxCycleCount) {
+        renderer->cycleLimitHits += 1;
+        SDL_UnlockMutex(renderer->cycleLock);
         return;
     }
 
@@ -1424,6 +1796,22 @@ static void METAL_INTERNAL_CycleActiveTexture(
 
     container->activeTexture = container->textures[container->textureCount - 1];
 
+    renderer->cycleHandlesCreated += 1;
+
+    if (container->textureCount == 2) {
+        EXPAND_ARRAY_IF_NEEDED(
+            renderer->cycledTextureContainers,
+            MetalTextureContainer *,
+            renderer->cycledTextureContainerCount + 1,
+            renderer->cycledTextureContainerCapacity,
+            renderer->cycledTextureContainerCapacity + 1);
+
+        renderer->cycledTextureContainers[renderer->cycledTextureContainerCount] = container;
+        renderer->cycledTextureContainerCount += 1;
+    }
+
+    SDL_UnlockMutex(renderer->cycleLock);
+
     if (renderer->debugMode && container->debugName != NULL) {
         METAL_INTERNAL_SetTextureName(
             container->activeTexture,
@@ -1436,7 +1824,10 @@ static MetalTexture *METAL_INTERNAL_PrepareTextureForWrite(
     MetalTextureContainer *container,
     SDL_bool cycle)
 {
-    if (cycle && container->canBeCycled) {
+    if (
+        cycle &&
+        container->canBeCycled &&
+        SDL_AtomicGet(&container->activeTexture->referenceCount) > 0) {
         METAL_INTERNAL_CycleActiveTexture(renderer, container);
     }
     return container->activeTexture;
@@ -1453,7 +1844,7 @@ static MetalBuffer *METAL_INTERNAL_CreateBuffer(
     /* Storage buffers have to be 4-aligned, so might as well align them all */
     sizeInBytes = METAL_INTERNAL_NextHighestAlignment(sizeInBytes, 4);
 
-    bufferHandle = [renderer->device newBufferWithLength:sizeInBytes options:resourceOptions];
+    bufferHandle = METAL_INTERNAL_NewBuffer(renderer, sizeInBytes, resourceOptions);
     if (bufferHandle == NULL) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not create buffer");
         return NULL;
@@ -1482,6 +1873,8 @@ static MetalBufferContainer *METAL_INTERNAL_CreateBufferContainer(
         container->bufferCapacity * sizeof(MetalBuffer *));
     container->isPrivate = isPrivate;
     container->isWriteOnly = isWriteOnly;
+    container->maxCycleCount = 0;
+    container->lastCycleFrame = 0;
     container->debugName = NULL;
 
     if (isPrivate) {
@@ -1535,7 +1928,7 @@ static MetalUniformBuffer *METAL_INTERNAL_CreateUniformBuffer(
     MetalUniformBuffer *uniformBuffer;
     id<MTLBuffer> bufferHandle;
 
-    bufferHandle = [renderer->device newBufferWithLength:sizeInBytes options:MTLResourceCPUCacheModeWriteCombined];
+    bufferHandle = METAL_INTERNAL_NewBuffer(renderer, sizeInBytes, MTLResourceCPUCacheModeWriteCombined);
     if (bufferHandle == nil) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not create uniform buffer");
         return NULL;
@@ -1544,7 +1937,6 @@ static MetalUniformBuffer *METAL_INTERNAL_CreateUniformBuffer(
     uniformBuffer = SDL_malloc(sizeof(MetalUniformBuffer));
     uniformBuffer->handle = bufferHandle;
     uniformBuffer->writeOffset = 0;
-    uniformBuffer->drawOffset = 0;
 
     return uniformBuffer;
 }
@@ -1555,13 +1947,26 @@ static void METAL_INTERNAL_CycleActiveBuffer(
 {
     MTLResourceOptions resourceOptions;
 
+    SDL_LockMutex(renderer->cycleLock);
+
+    container->lastCycleFrame = renderer->presentedFrameCount;
+
     for (Uint32 i = 0; i < container->bufferCount; i += 1) {
         if (SDL_AtomicGet(&container->buffers[i]->referenceCount) == 0) {
             container->activeBuffer = container->buffers[i];
+            SDL_UnlockMutex(renderer->cycleLock);
             return;
         }
     }
 
+    /* At the limit the active buffer is kept, as if cycle were false.
+     * For transfer buffers this may overwrite data that is still in flight. */
+    if (container->maxCycleCount > 0 && container->bufferCount >= container->maxCycleCount) {
+        renderer->cycleLimitHits += 1;
+        SDL_UnlockMutex(renderer->cycleLock);
+        return;
+    }
+
     EXPAND_ARRAY_IF_NEEDED(
         container->buffers,
         MetalBuffer *,
@@ -1587,6 +1992,22 @@ static void METAL_INTERNAL_CycleActiveBuffer(
 
     container->activeBuffer = container->buffers[container->bufferCount - 1];
 
+    renderer->cycleHandlesCreated += 1;
+
+    if (container->bufferCount == 2) {
+        EXPAND_ARRAY_IF_NEEDED(
+            renderer->cycledBufferContainers,
+            MetalBufferContainer *,
+            renderer->cycledBufferContainerCount + 1,
+            renderer->cycledBufferContainerCapacity,
+            renderer->cycledBufferContainerCapacity + 1);
+
+        renderer->cycledBufferContainers[renderer->cycledBufferContainerCount] = container;
+        renderer->cycledBufferContainerCount += 1;
+    }
+
+    SDL_UnlockMutex(renderer->cycleLock);
+
     if (renderer->debugMode && container->debugName != NULL) {
         METAL_INTERNAL_SetBufferName(
             container->activeBuffer,
@@ -1754,6 +2175,124 @@ static void METAL_UploadToBuffer(
     METAL_INTERNAL_TrackBuffer(metalCommandBuffer, transferContainer->activeBuffer);
 }
 
+static MetalBufferContainer *METAL_INTERNAL_AcquireStagingBlock(
+    MetalCommandBuffer *commandBuffer,
+    Uint32 sizeInBytes)
+{
+    MetalRenderer *renderer = commandBuffer->renderer;
+    MetalBufferContainer *stagingBlock = NULL;
+
+    if (sizeInBytes <= STAGING_BLOCK_SIZE) {
+        SDL_LockMutex(renderer->acquireStagingBlockLock);
+
+        if (renderer->stagingBlockPoolCount > 0) {
+            stagingBlock = renderer->stagingBlockPool[renderer->stagingBlockPoolCount - 1];
+            renderer->stagingBlockPoolCount -= 1;
+        }
+
+        SDL_UnlockMutex(renderer->acquireStagingBlockLock);
+
+        sizeInBytes = STAGING_BLOCK_SIZE;
+    }
+
+    if (stagingBlock == NULL) {
+        stagingBlock = METAL_INTERNAL_CreateBufferContainer(
+            renderer,
+            sizeInBytes,
+            SDL_FALSE,
+            SDL_TRUE);
+
+        if (stagingBlock->activeBuffer == NULL) {
+            SDL_free(stagingBlock->buffers);
+            SDL_free(stagingBlock);
+            return NULL;
+        }
+    }
+
+    EXPAND_ARRAY_IF_NEEDED(
+        commandBuffer->usedStagingBlocks,
+        MetalBufferContainer *,
+        commandBuffer->usedStagingBlockCount + 1,
+        commandBuffer->usedStagingBlockCapacity,
+        commandBuffer->usedStagingBlockCapacity + 4);
+
+    commandBuffer->usedStagingBlocks[commandBuffer->usedStagingBlockCount] = stagingBlock;
+    commandBuffer->usedStagingBlockCount += 1;
+
+    METAL_INTERNAL_TrackBuffer(commandBuffer, stagingBlock->activeBuffer);
+
+    return stagingBlock;
+}
+
+/* Dedicated blocks for oversized requests are released instead of pooled */
+static void METAL_INTERNAL_ReturnStagingBlockToPool(
+    MetalRenderer *renderer,
+    MetalBufferContainer *stagingBlock)
+{
+    if (stagingBlock->size != STAGING_BLOCK_SIZE) {
+        METAL_ReleaseBuffer(
+            (Refresh_Renderer *)renderer,
+            (Refresh_Buffer *)stagingBlock);
+        return;
+    }
+
+    EXPAND_ARRAY_IF_NEEDED(
+        renderer->stagingBlockPool,
+        MetalBufferContainer *,
+        renderer->stagingBlockPoolCount + 1,
+        renderer->stagingBlockPoolCapacity,
+        renderer->stagingBlockPoolCapacity * 2);
+
+    renderer->stagingBlockPool[renderer->stagingBlockPoolCount] = stagingBlock;
+    renderer->stagingBlockPoolCount += 1;
+}
+
+/* Staging blocks use shared storage, so the contents pointer stays valid for
+ * the lifetime of the block and no explicit map is needed.
+ */
+static void *METAL_AcquireStagingMemory(
+    Refresh_CommandBuffer *commandBuffer,
+    Uint32 sizeInBytes,
+    Refresh_TransferBufferLocation *location)
+{
+    MetalCommandBuffer *metalCommandBuffer = (MetalCommandBuffer *)commandBuffer;
+    MetalBufferContainer *stagingBlock;
+    Uint32 offset = 0;
+
+    if (sizeInBytes > STAGING_BLOCK_SIZE) {
+        /* The current block keeps serving smaller requests */
+        stagingBlock = METAL_INTERNAL_AcquireStagingBlock(
+            metalCommandBuffer,
+            sizeInBytes);
+    } else {
+        offset = METAL_INTERNAL_NextHighestAlignment(
+            metalCommandBuffer->stagingBlockOffset,
+            STAGING_BLOCK_ALIGNMENT);
+
+        if (
+            metalCommandBuffer->currentStagingBlock == NULL ||
+            offset + sizeInBytes > STAGING_BLOCK_SIZE) {
+            metalCommandBuffer->currentStagingBlock = METAL_INTERNAL_AcquireStagingBlock(
+                metalCommandBuffer,
+                sizeInBytes);
+            offset = 0;
+        }
+
+        stagingBlock = metalCommandBuffer->currentStagingBlock;
+        metalCommandBuffer->stagingBlockOffset = offset + sizeInBytes;
+    }
+
+    if (stagingBlock == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire staging memory!");
+        return NULL;
+    }
+
+    location->transferBuffer = (Refresh_TransferBuffer *)stagingBlock;
+    location->offset = offset;
+
+    return (Uint8 *)[stagingBlock->activeBuffer->handle contents] + offset;
+}
+
 static void METAL_CopyTextureToTexture(
     Refresh_CommandBuffer *commandBuffer,
     Refresh_TextureLocation *source,
@@ -1818,14 +2357,119 @@ static void METAL_CopyBufferToBuffer(
     METAL_INTERNAL_TrackBuffer(metalCommandBuffer, dstBuffer);
 }
 
+/* Blit encoders have no multi-region copies and need no barriers,
+ * so batches only have to make sure each container is cycled at most once.
+ */
+static SDL_bool METAL_INTERNAL_ShouldCycleInBatch(
+    void **preparedContainers,
+    Uint32 *preparedContainerCount,
+    void *container,
+    SDL_bool cycle)
+{
+    for (Uint32 i = 0; i < *preparedContainerCount; i += 1) {
+        if (preparedContainers[i] == container) {
+            return SDL_FALSE;
+        }
+    }
+
+    preparedContainers[*preparedContainerCount] = container;
+    *preparedContainerCount += 1;
+
+    return cycle;
+}
+
+static void METAL_UploadToTextureRegions(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_TextureTransferInfo *sources,
+    Refresh_TextureRegion *destinations,
+    Uint32 regionCount,
+    SDL_bool cycle)
+{
+    void **preparedContainers = SDL_malloc(regionCount * sizeof(void *));
+    Uint32 preparedContainerCount = 0;
+
+    for (Uint32 i = 0; i < regionCount; i += 1) {
+        METAL_UploadToTexture(
+            commandBuffer,
+            &sources[i],
+            &destinations[i],
+            METAL_INTERNAL_ShouldCycleInBatch(
+                preparedContainers,
+                &preparedContainerCount,
+                destinations[i].textureSlice.texture,
+                cycle));
+    }
+
+    SDL_free(preparedContainers);
+}
+
+static void METAL_UploadToBufferRegions(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_TransferBufferLocation *sources,
+    Refresh_BufferRegion *destinations,
+    Uint32 regionCount,
+    SDL_bool cycle)
+{
+    void **preparedContainers = SDL_malloc(regionCount * sizeof(void *));
+    Uint32 preparedContainerCount = 0;
+
+    for (Uint32 i = 0; i < regionCount; i += 1) {
+        METAL_UploadToBuffer(
+            commandBuffer,
+            &sources[i],
+            &destinations[i],
+            METAL_INTERNAL_ShouldCycleInBatch(
+                preparedContainers,
+                &preparedContainerCount,
+                destinations[i].buffer,
+                cycle));
+    }
+
+    SDL_free(preparedContainers);
+}
+
+static void METAL_CopyBufferToBufferRegions(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_BufferLocation *sources,
+    Refresh_BufferRegion *destinations,
+    Uint32 regionCount,
+    SDL_bool cycle)
+{
+    void **preparedContainers = SDL_malloc(regionCount * sizeof(void *));
+    Uint32 preparedContainerCount = 0;
+    Refresh_BufferLocation destination;
+
+    for (Uint32 i = 0; i < regionCount; i += 1) {
+        destination.buffer = destinations[i].buffer;
+        destination.offset = destinations[i].offset;
+
+        METAL_CopyBufferToBuffer(
+            commandBuffer,
+            &sources[i],
+            &destination,
+            destinations[i].size,
+            METAL_INTERNAL_ShouldCycleInBatch(
+                preparedContainers,
+                &preparedContainerCount,
+                destinations[i].buffer,
+                cycle));
+    }
+
+    SDL_free(preparedContainers);
+}
+
 static void METAL_GenerateMipmaps(
     Refresh_CommandBuffer *commandBuffer,
-    Refresh_Texture *texture)
+    Refresh_Texture *texture,
+    Refresh_Filter filterMode)
 {
     MetalCommandBuffer *metalCommandBuffer = (MetalCommandBuffer *)commandBuffer;
     MetalTextureContainer *container = (MetalTextureContainer *)texture;
     MetalTexture *metalTexture = container->activeTexture;
 
+    /* generateMipmapsForTexture always uses the driver's own filter */
+    (void)filterMode;
+
     if (container->createInfo.levelCount <= 1) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot generate mipmaps for texture with levelCount <= 1!");
         return;
@@ -1951,6 +2595,11 @@ static void METAL_INTERNAL_AllocateCommandBuffers(
         commandBuffer->usedTextures = SDL_malloc(
             commandBuffer->usedTextureCapacity * sizeof(MetalTexture *));
 
+        commandBuffer->renderPassChunkCapacity = 4;
+        commandBuffer->renderPassChunkCount = 0;
+        commandBuffer->renderPassChunks = SDL_malloc(
+            commandBuffer->renderPassChunkCapacity * sizeof(MetalCommandBuffer *));
+
         renderer->availableCommandBuffers[renderer->availableCommandBufferCount] = commandBuffer;
         renderer->availableCommandBufferCount += 1;
     }
@@ -2026,23 +2675,21 @@ static Uint8 METAL_INTERNAL_AcquireFence(
     return 1;
 }
 
-static Refresh_CommandBuffer *METAL_AcquireCommandBuffer(
-    Refresh_Renderer *driverData)
+static void METAL_INTERNAL_ResetCommandBufferState(
+    MetalCommandBuffer *commandBuffer)
 {
-    MetalRenderer *renderer = (MetalRenderer *)driverData;
-    MetalCommandBuffer *commandBuffer;
-
-    SDL_LockMutex(renderer->acquireCommandBufferLock);
-
-    commandBuffer = METAL_INTERNAL_GetInactiveCommandBufferFromPool(renderer);
-    commandBuffer->handle = [renderer->queue commandBuffer];
-
     commandBuffer->graphicsPipeline = NULL;
     commandBuffer->computePipeline = NULL;
+    commandBuffer->currentUniformBuffer = NULL;
+    commandBuffer->currentStagingBlock = NULL;
+    commandBuffer->stagingBlockOffset = 0;
     for (Uint32 i = 0; i < MAX_UNIFORM_BUFFERS_PER_STAGE; i += 1) {
         commandBuffer->vertexUniformBuffers[i] = NULL;
         commandBuffer->fragmentUniformBuffers[i] = NULL;
         commandBuffer->computeUniformBuffers[i] = NULL;
+        commandBuffer->vertexUniformDrawOffsets[i] = 0;
+        commandBuffer->fragmentUniformDrawOffsets[i] = 0;
+        commandBuffer->computeUniformDrawOffsets[i] = 0;
     }
 
     /* FIXME: Do we actually need to set this? */
@@ -2050,13 +2697,34 @@ static Refresh_CommandBuffer *METAL_AcquireCommandBuffer(
     commandBuffer->needVertexStorageTextureBind = SDL_TRUE;
     commandBuffer->needVertexStorageBufferBind = SDL_TRUE;
     commandBuffer->needVertexUniformBind = SDL_TRUE;
+    commandBuffer->needVertexUniformOffsetBind = SDL_FALSE;
     commandBuffer->needFragmentSamplerBind = SDL_TRUE;
     commandBuffer->needFragmentStorageTextureBind = SDL_TRUE;
     commandBuffer->needFragmentStorageBufferBind = SDL_TRUE;
     commandBuffer->needFragmentUniformBind = SDL_TRUE;
+    commandBuffer->needFragmentUniformOffsetBind = SDL_FALSE;
     commandBuffer->needComputeBufferBind = SDL_TRUE;
     commandBuffer->needComputeTextureBind = SDL_TRUE;
     commandBuffer->needComputeUniformBind = SDL_TRUE;
+    commandBuffer->needComputeUniformOffsetBind = SDL_FALSE;
+}
+
+static Refresh_CommandBuffer *METAL_AcquireCommandBuffer(
+    Refresh_Renderer *driverData,
+    Refresh_QueueType queueType)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+    MetalCommandBuffer *commandBuffer;
+
+    /* All queue types share one MTLCommandQueue */
+    (void)queueType;
+
+    SDL_LockMutex(renderer->acquireCommandBufferLock);
+
+    commandBuffer = METAL_INTERNAL_GetInactiveCommandBufferFromPool(renderer);
+    commandBuffer->handle = [renderer->queue commandBuffer];
+
+    METAL_INTERNAL_ResetCommandBufferState(commandBuffer);
 
     METAL_INTERNAL_AcquireFence(renderer, commandBuffer);
     commandBuffer->autoReleaseFence = 1;
@@ -2105,16 +2773,32 @@ static void METAL_INTERNAL_ReturnUniformBufferToPool(
     renderer->uniformBufferPoolCount += 1;
 
     uniformBuffer->writeOffset = 0;
-    uniformBuffer->drawOffset = 0;
 }
 
-static void METAL_BeginRenderPass(
-    Refresh_CommandBuffer *commandBuffer,
+/* Uniform data is linearly allocated from one buffer shared by every stage and slot,
+ * so consecutive pushes only change buffer offsets. A new buffer is taken from the
+ * pool once the current one is full.
+ */
+static MetalUniformBuffer *METAL_INTERNAL_FetchCurrentUniformBuffer(
+    MetalCommandBuffer *commandBuffer,
+    Uint32 blockSize)
+{
+    if (commandBuffer->currentUniformBuffer == NULL ||
+        commandBuffer->currentUniformBuffer->writeOffset + blockSize > UNIFORM_BUFFER_SIZE) {
+        commandBuffer->currentUniformBuffer = METAL_INTERNAL_AcquireUniformBufferFromPool(
+            commandBuffer);
+    }
+
+    return commandBuffer->currentUniformBuffer;
+}
+
+static void METAL_INTERNAL_BeginRenderPass(
+    MetalCommandBuffer *metalCommandBuffer,
     Refresh_ColorAttachmentInfo *colorAttachmentInfos,
     Uint32 colorAttachmentCount,
-    Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo)
+    Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo,
+    SDL_bool parallel)
 {
-    MetalCommandBuffer *metalCommandBuffer = (MetalCommandBuffer *)commandBuffer;
     MetalRenderer *renderer = metalCommandBuffer->renderer;
     MTLRenderPassDescriptor *passDescriptor = [MTLRenderPassDescriptor renderPassDescriptor];
     Uint32 vpWidth = UINT_MAX;
@@ -2190,7 +2874,11 @@ static void METAL_BeginRenderPass(
         METAL_INTERNAL_TrackTexture(metalCommandBuffer, texture);
     }
 
-    metalCommandBuffer->renderEncoder = [metalCommandBuffer->handle renderCommandEncoderWithDescriptor:passDescriptor];
+    if (parallel) {
+        metalCommandBuffer->parallelRenderEncoder = [metalCommandBuffer->handle parallelRenderCommandEncoderWithDescriptor:passDescriptor];
+    } else {
+        metalCommandBuffer->renderEncoder = [metalCommandBuffer->handle renderCommandEncoderWithDescriptor:passDescriptor];
+    }
 
     /* The viewport cannot be larger than the smallest attachment. */
     for (Uint32 i = 0; i < colorAttachmentCount; i += 1) {
@@ -2235,6 +2923,38 @@ static void METAL_BeginRenderPass(
     scissorRect.width = vpWidth;
     scissorRect.height = vpHeight;
     [metalCommandBuffer->renderEncoder setScissorRect:scissorRect];
+
+    /* The render encoder is nil in a parallel render pass, the chunks apply this state instead */
+    metalCommandBuffer->renderPassViewport = viewport;
+    metalCommandBuffer->renderPassScissorRect = scissorRect;
+}
+
+static void METAL_BeginRenderPass(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_ColorAttachmentInfo *colorAttachmentInfos,
+    Uint32 colorAttachmentCount,
+    Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo)
+{
+    METAL_INTERNAL_BeginRenderPass(
+        (MetalCommandBuffer *)commandBuffer,
+        colorAttachmentInfos,
+        colorAttachmentCount,
+        depthStencilAttachmentInfo,
+        SDL_FALSE);
+}
+
+static void METAL_BeginParallelRenderPass(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_ColorAttachmentInfo *colorAttachmentInfos,
+    Uint32 colorAttachmentCount,
+    Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo)
+{
+    METAL_INTERNAL_BeginRenderPass(
+        (MetalCommandBuffer *)commandBuffer,
+        colorAttachmentInfos,
+        colorAttachmentCount,
+        depthStencilAttachmentInfo,
+        SDL_TRUE);
 }
 
 static void METAL_BindGraphicsPipeline(
@@ -2275,15 +2995,19 @@ static void METAL_BindGraphicsPipeline(
 
     for (Uint32 i = 0; i < metalGraphicsPipeline->vertexUniformBufferCount; i += 1) {
         if (metalCommandBuffer->vertexUniformBuffers[i] == NULL) {
-            metalCommandBuffer->vertexUniformBuffers[i] = METAL_INTERNAL_AcquireUniformBufferFromPool(
-                metalCommandBuffer);
+            metalCommandBuffer->vertexUniformBuffers[i] = METAL_INTERNAL_FetchCurrentUniformBuffer(
+                metalCommandBuffer,
+                0);
+            metalCommandBuffer->vertexUniformDrawOffsets[i] = 0;
         }
     }
 
     for (Uint32 i = 0; i < metalGraphicsPipeline->fragmentUniformBufferCount; i += 1) {
         if (metalCommandBuffer->fragmentUniformBuffers[i] == NULL) {
-            metalCommandBuffer->fragmentUniformBuffers[i] = METAL_INTERNAL_AcquireUniformBufferFromPool(
-                metalCommandBuffer);
+            metalCommandBuffer->fragmentUniformBuffers[i] = METAL_INTERNAL_FetchCurrentUniformBuffer(
+                metalCommandBuffer,
+                0);
+            metalCommandBuffer->fragmentUniformDrawOffsets[i] = 0;
         }
     }
 
@@ -2547,11 +3271,20 @@ static void METAL_INTERNAL_BindGraphicsResources(
         for (Uint32 i = 0; i < graphicsPipeline->vertexUniformBufferCount; i += 1) {
             [commandBuffer->renderEncoder
                 setVertexBuffer:commandBuffer->vertexUniformBuffers[i]->handle
-                         offset:commandBuffer->vertexUniformBuffers[i]->drawOffset
+                         offset:commandBuffer->vertexUniformDrawOffsets[i]
                         atIndex:i];
         }
 
         commandBuffer->needVertexUniformBind = SDL_FALSE;
+        commandBuffer->needVertexUniformOffsetBind = SDL_FALSE;
+    } else if (graphicsPipeline->vertexUniformBufferCount > 0 && commandBuffer->needVertexUniformOffsetBind) {
+        for (Uint32 i = 0; i < graphicsPipeline->vertexUniformBufferCount; i += 1) {
+            [commandBuffer->renderEncoder
+                setVertexBufferOffset:commandBuffer->vertexUniformDrawOffsets[i]
+                              atIndex:i];
+        }
+
+        commandBuffer->needVertexUniformOffsetBind = SDL_FALSE;
     }
 
     /* Fragment Samplers+Textures */
@@ -2588,11 +3321,20 @@ static void METAL_INTERNAL_BindGraphicsResources(
         for (Uint32 i = 0; i < graphicsPipeline->fragmentUniformBufferCount; i += 1) {
             [commandBuffer->renderEncoder
                 setFragmentBuffer:commandBuffer->fragmentUniformBuffers[i]->handle
-                           offset:commandBuffer->fragmentUniformBuffers[i]->drawOffset
+                           offset:commandBuffer->fragmentUniformDrawOffsets[i]
                           atIndex:i];
         }
 
         commandBuffer->needFragmentUniformBind = SDL_FALSE;
+        commandBuffer->needFragmentUniformOffsetBind = SDL_FALSE;
+    } else if (graphicsPipeline->fragmentUniformBufferCount > 0 && commandBuffer->needFragmentUniformOffsetBind) {
+        for (Uint32 i = 0; i < graphicsPipeline->fragmentUniformBufferCount; i += 1) {
+            [commandBuffer->renderEncoder
+                setFragmentBufferOffset:commandBuffer->fragmentUniformDrawOffsets[i]
+                                atIndex:i];
+        }
+
+        commandBuffer->needFragmentUniformOffsetBind = SDL_FALSE;
     }
 }
 
@@ -2644,11 +3386,20 @@ static void METAL_INTERNAL_BindComputeResources(
         for (Uint32 i = 0; i < computePipeline->uniformBufferCount; i += 1) {
             [commandBuffer->computeEncoder
                 setBuffer:commandBuffer->computeUniformBuffers[i]->handle
-                   offset:commandBuffer->computeUniformBuffers[i]->drawOffset
+                   offset:commandBuffer->computeUniformDrawOffsets[i]
                   atIndex:i];
         }
 
         commandBuffer->needComputeUniformBind = SDL_FALSE;
+        commandBuffer->needComputeUniformOffsetBind = SDL_FALSE;
+    } else if (commandBuffer->needComputeUniformOffsetBind) {
+        for (Uint32 i = 0; i < computePipeline->uniformBufferCount; i += 1) {
+            [commandBuffer->computeEncoder
+                setBufferOffset:commandBuffer->computeUniformDrawOffsets[i]
+                        atIndex:i];
+        }
+
+        commandBuffer->needComputeUniformOffsetBind = SDL_FALSE;
     }
 }
 
@@ -2744,14 +3495,181 @@ static void METAL_DrawIndexedPrimitivesIndirect(
     METAL_INTERNAL_TrackBuffer(metalCommandBuffer, metalBuffer);
 }
 
+/* The count buffer is not read on this backend.
+ * The IndirectCount draws issue maxDrawCount draws,
+ * so the app must zero out the instance count of unused draws.
+ */
+
+static SDL_bool METAL_SupportsIndirectCount(
+    Refresh_Renderer *driverData)
+{
+    (void)driverData;
+    return SDL_FALSE;
+}
+
+static void METAL_DrawPrimitivesIndirectCount(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_Buffer *buffer,
+    Uint32 offsetInBytes,
+    Refresh_Buffer *countBuffer,
+    Uint32 countOffsetInBytes,
+    Uint32 maxDrawCount,
+    Uint32 stride)
+{
+    (void)countBuffer;
+    (void)countOffsetInBytes;
+
+    METAL_DrawPrimitivesIndirect(
+        commandBuffer,
+        buffer,
+        offsetInBytes,
+        maxDrawCount,
+        stride);
+}
+
+static void METAL_DrawIndexedPrimitivesIndirectCount(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_Buffer *buffer,
+    Uint32 offsetInBytes,
+    Refresh_Buffer *countBuffer,
+    Uint32 countOffsetInBytes,
+    Uint32 maxDrawCount,
+    Uint32 stride)
+{
+    (void)countBuffer;
+    (void)countOffsetInBytes;
+
+    METAL_DrawIndexedPrimitivesIndirect(
+        commandBuffer,
+        buffer,
+        offsetInBytes,
+        maxDrawCount,
+        stride);
+}
+
+static void METAL_ExecuteCommandBundle(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_CommandBundle *commandBundle)
+{
+    CommandBundle *bundle = (CommandBundle *)commandBundle;
+    CommandBundleCommand *command;
+
+    for (Uint32 i = 0; i < bundle->commandCount; i += 1) {
+        command = &bundle->commands[i];
+
+        switch (command->type) {
+        case COMMAND_BUNDLE_BIND_GRAPHICS_PIPELINE:
+            METAL_BindGraphicsPipeline(
+                commandBuffer,
+                command->data.graphicsPipeline);
+            break;
+
+        case COMMAND_BUNDLE_BIND_VERTEX_BUFFERS:
+            METAL_BindVertexBuffers(
+                commandBuffer,
+                command->data.bindings.firstSlot,
+                &bundle->bufferBindings[command->data.bindings.bindingOffset],
+                command->data.bindings.bindingCount);
+            break;
+
+        case COMMAND_BUNDLE_BIND_INDEX_BUFFER:
+            METAL_BindIndexBuffer(
+                commandBuffer,
+                &command->data.indexBuffer.binding,
+                command->data.indexBuffer.indexElementSize);
+            break;
+
+        case COMMAND_BUNDLE_BIND_FRAGMENT_SAMPLERS:
+            METAL_BindFragmentSamplers(
+                commandBuffer,
+                command->data.bindings.firstSlot,
+                &bundle->samplerBindings[command->data.bindings.bindingOffset],
+                command->data.bindings.bindingCount);
+            break;
+
+        case COMMAND_BUNDLE_DRAW_INDEXED_PRIMITIVES:
+            METAL_DrawIndexedPrimitives(
+                commandBuffer,
+                command->data.drawIndexed.baseVertex,
+                command->data.drawIndexed.startIndex,
+                command->data.drawIndexed.primitiveCount,
+                command->data.drawIndexed.instanceCount);
+            break;
+
+        case COMMAND_BUNDLE_DRAW_PRIMITIVES:
+            METAL_DrawPrimitives(
+                commandBuffer,
+                command->data.draw.vertexStart,
+                command->data.draw.primitiveCount);
+            break;
+        }
+    }
+}
+
 static void METAL_EndRenderPass(
     Refresh_CommandBuffer *commandBuffer)
 {
     MetalCommandBuffer *metalCommandBuffer = (MetalCommandBuffer *)commandBuffer;
+
+    if (metalCommandBuffer->parallelRenderEncoder != nil) {
+        [metalCommandBuffer->parallelRenderEncoder endEncoding];
+        metalCommandBuffer->parallelRenderEncoder = nil;
+        return;
+    }
+
     [metalCommandBuffer->renderEncoder endEncoding];
     metalCommandBuffer->renderEncoder = nil;
 }
 
+/* Parallel Render Pass */
+
+static Refresh_CommandBuffer *METAL_AcquireRenderPassChunk(
+    Refresh_CommandBuffer *commandBuffer)
+{
+    MetalCommandBuffer *metalCommandBuffer = (MetalCommandBuffer *)commandBuffer;
+    MetalRenderer *renderer = metalCommandBuffer->renderer;
+    MetalCommandBuffer *chunk;
+
+    SDL_LockMutex(renderer->acquireCommandBufferLock);
+
+    chunk = METAL_INTERNAL_GetInactiveCommandBufferFromPool(renderer);
+
+    /* Chunks execute in the order their encoders were created */
+    chunk->renderEncoder = [metalCommandBuffer->parallelRenderEncoder renderCommandEncoder];
+
+    EXPAND_ARRAY_IF_NEEDED(
+        metalCommandBuffer->renderPassChunks,
+        MetalCommandBuffer *,
+        metalCommandBuffer->renderPassChunkCount + 1,
+        metalCommandBuffer->renderPassChunkCapacity,
+        metalCommandBuffer->renderPassChunkCapacity * 2);
+
+    metalCommandBuffer->renderPassChunks[metalCommandBuffer->renderPassChunkCount] = chunk;
+    metalCommandBuffer->renderPassChunkCount += 1;
+
+    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+
+    METAL_INTERNAL_ResetCommandBufferState(chunk);
+
+    /* Chunks are never committed on their own */
+    chunk->handle = nil;
+    chunk->fence = NULL;
+    chunk->autoReleaseFence = 0;
+
+    [chunk->renderEncoder setViewport:metalCommandBuffer->renderPassViewport];
+    [chunk->renderEncoder setScissorRect:metalCommandBuffer->renderPassScissorRect];
+
+    return (Refresh_CommandBuffer *)chunk;
+}
+
+static void METAL_EndRenderPassChunk(
+    Refresh_CommandBuffer *chunk)
+{
+    MetalCommandBuffer *metalChunk = (MetalCommandBuffer *)chunk;
+    [metalChunk->renderEncoder endEncoding];
+    metalChunk->renderEncoder = nil;
+}
+
 static void METAL_INTERNAL_PushUniformData(
     MetalCommandBuffer *metalCommandBuffer,
     Refresh_ShaderStage shaderStage,
@@ -2761,26 +3679,11 @@ static void METAL_INTERNAL_PushUniformData(
 {
     MetalUniformBuffer *metalUniformBuffer;
     Uint32 alignedDataLength;
+    Uint32 drawOffset;
 
-    if (shaderStage == REFRESH_SHADERSTAGE_VERTEX) {
-        if (metalCommandBuffer->vertexUniformBuffers[slotIndex] == NULL) {
-            metalCommandBuffer->vertexUniformBuffers[slotIndex] = METAL_INTERNAL_AcquireUniformBufferFromPool(
-                metalCommandBuffer);
-        }
-        metalUniformBuffer = metalCommandBuffer->vertexUniformBuffers[slotIndex];
-    } else if (shaderStage == REFRESH_SHADERSTAGE_FRAGMENT) {
-        if (metalCommandBuffer->fragmentUniformBuffers[slotIndex] == NULL) {
-            metalCommandBuffer->fragmentUniformBuffers[slotIndex] = METAL_INTERNAL_AcquireUniformBufferFromPool(
-                metalCommandBuffer);
-        }
-        metalUniformBuffer = metalCommandBuffer->fragmentUniformBuffers[slotIndex];
-    } else if (shaderStage == REFRESH_SHADERSTAGE_COMPUTE) {
-        if (metalCommandBuffer->computeUniformBuffers[slotIndex] == NULL) {
-            metalCommandBuffer->computeUniformBuffers[slotIndex] = METAL_INTERNAL_AcquireUniformBufferFromPool(
-                metalCommandBuffer);
-        }
-        metalUniformBuffer = metalCommandBuffer->computeUniformBuffers[slotIndex];
-    } else {
+    if (shaderStage != REFRESH_SHADERSTAGE_VERTEX &&
+        shaderStage != REFRESH_SHADERSTAGE_FRAGMENT &&
+        shaderStage != REFRESH_SHADERSTAGE_COMPUTE) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized shader stage!");
         return;
     }
@@ -2789,42 +3692,41 @@ static void METAL_INTERNAL_PushUniformData(
         dataLengthInBytes,
         256);
 
-    if (metalUniformBuffer->writeOffset + alignedDataLength >= UNIFORM_BUFFER_SIZE) {
-        metalUniformBuffer = METAL_INTERNAL_AcquireUniformBufferFromPool(
-            metalCommandBuffer);
-
-        metalUniformBuffer->writeOffset = 0;
-        metalUniformBuffer->drawOffset = 0;
-
-        if (shaderStage == REFRESH_SHADERSTAGE_VERTEX) {
-            metalCommandBuffer->vertexUniformBuffers[slotIndex] = metalUniformBuffer;
-        } else if (shaderStage == REFRESH_SHADERSTAGE_FRAGMENT) {
-            metalCommandBuffer->fragmentUniformBuffers[slotIndex] = metalUniformBuffer;
-        } else if (shaderStage == REFRESH_SHADERSTAGE_COMPUTE) {
-            metalCommandBuffer->computeUniformBuffers[slotIndex] = metalUniformBuffer;
-        } else {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized shader stage!");
-            return;
-        }
-    }
+    metalUniformBuffer = METAL_INTERNAL_FetchCurrentUniformBuffer(
+        metalCommandBuffer,
+        alignedDataLength);
 
-    metalUniformBuffer->drawOffset = metalUniformBuffer->writeOffset;
+    drawOffset = metalUniformBuffer->writeOffset;
 
     SDL_memcpy(
-        (metalUniformBuffer->handle).contents + metalUniformBuffer->writeOffset,
+        (metalUniformBuffer->handle).contents + drawOffset,
         data,
         dataLengthInBytes);
 
     metalUniformBuffer->writeOffset += alignedDataLength;
 
+    /* Only the offset has to be rebound while the slot stays in the same buffer */
     if (shaderStage == REFRESH_SHADERSTAGE_VERTEX) {
-        metalCommandBuffer->needVertexUniformBind = SDL_TRUE;
+        if (metalCommandBuffer->vertexUniformBuffers[slotIndex] != metalUniformBuffer) {
+            metalCommandBuffer->vertexUniformBuffers[slotIndex] = metalUniformBuffer;
+            metalCommandBuffer->needVertexUniformBind = SDL_TRUE;
+        }
+        metalCommandBuffer->vertexUniformDrawOffsets[slotIndex] = drawOffset;
+        metalCommandBuffer->needVertexUniformOffsetBind = SDL_TRUE;
     } else if (shaderStage == REFRESH_SHADERSTAGE_FRAGMENT) {
-        metalCommandBuffer->needFragmentUniformBind = SDL_TRUE;
-    } else if (shaderStage == REFRESH_SHADERSTAGE_COMPUTE) {
-        metalCommandBuffer->needComputeUniformBind = SDL_TRUE;
+        if (metalCommandBuffer->fragmentUniformBuffers[slotIndex] != metalUniformBuffer) {
+            metalCommandBuffer->fragmentUniformBuffers[slotIndex] = metalUniformBuffer;
+            metalCommandBuffer->needFragmentUniformBind = SDL_TRUE;
+        }
+        metalCommandBuffer->fragmentUniformDrawOffsets[slotIndex] = drawOffset;
+        metalCommandBuffer->needFragmentUniformOffsetBind = SDL_TRUE;
     } else {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized shader stage!");
+        if (metalCommandBuffer->computeUniformBuffers[slotIndex] != metalUniformBuffer) {
+            metalCommandBuffer->computeUniformBuffers[slotIndex] = metalUniformBuffer;
+            metalCommandBuffer->needComputeUniformBind = SDL_TRUE;
+        }
+        metalCommandBuffer->computeUniformDrawOffsets[slotIndex] = drawOffset;
+        metalCommandBuffer->needComputeUniformOffsetBind = SDL_TRUE;
     }
 }
 
@@ -3078,8 +3980,10 @@ static void METAL_BindComputePipeline(
 
     for (Uint32 i = 0; i < pipeline->uniformBufferCount; i += 1) {
         if (metalCommandBuffer->computeUniformBuffers[i] == NULL) {
-            metalCommandBuffer->computeUniformBuffers[i] = METAL_INTERNAL_AcquireUniformBufferFromPool(
-                metalCommandBuffer);
+            metalCommandBuffer->computeUniformBuffers[i] = METAL_INTERNAL_FetchCurrentUniformBuffer(
+                metalCommandBuffer,
+                0);
+            metalCommandBuffer->computeUniformDrawOffsets[i] = 0;
         }
     }
 
@@ -3234,6 +4138,19 @@ static void METAL_INTERNAL_CleanCommandBuffer(
 
     SDL_UnlockMutex(renderer->acquireUniformBufferLock);
 
+    /* Staging blocks are now available */
+
+    SDL_LockMutex(renderer->acquireStagingBlockLock);
+
+    for (Uint32 i = 0; i < commandBuffer->usedStagingBlockCount; i += 1) {
+        METAL_INTERNAL_ReturnStagingBlockToPool(
+            renderer,
+            commandBuffer->usedStagingBlocks[i]);
+    }
+    commandBuffer->usedStagingBlockCount = 0;
+
+    SDL_UnlockMutex(renderer->acquireStagingBlockLock);
+
     /* Reset presentation */
     commandBuffer->windowDataCount = 0;
 
@@ -3246,6 +4163,14 @@ static void METAL_INTERNAL_CleanCommandBuffer(
     SDL_zeroa(commandBuffer->computeReadWriteBuffers);
     SDL_zeroa(commandBuffer->computeReadWriteTextures);
 
+    /* Render pass chunks executed by this command buffer are done too */
+    for (Uint32 i = 0; i < commandBuffer->renderPassChunkCount; i += 1) {
+        METAL_INTERNAL_CleanCommandBuffer(
+            renderer,
+            commandBuffer->renderPassChunks[i]);
+    }
+    commandBuffer->renderPassChunkCount = 0;
+
     /* The fence is now available (unless SubmitAndAcquireFence was called) */
     if (commandBuffer->autoReleaseFence) {
         METAL_ReleaseFence(
@@ -3275,46 +4200,178 @@ static void METAL_INTERNAL_CleanCommandBuffer(
     }
 }
 
+/* Must be called with the submit lock held, after completed command buffers have been cleaned */
 static void METAL_INTERNAL_PerformPendingDestroys(
     MetalRenderer *renderer)
 {
-    Sint32 referenceCount = 0;
-    Sint32 i;
-    Uint32 j;
+    Uint64 oldestInFlightSerial;
+    Uint32 retiredCount = 0;
+
+    SDL_LockMutex(renderer->disposeLock);
+
+    oldestInFlightSerial = renderer->submissionSerial + 1;
+    for (Uint32 i = 0; i < renderer->submittedCommandBufferCount; i += 1) {
+        oldestInFlightSerial = SDL_min(
+            oldestInFlightSerial,
+            renderer->submittedCommandBuffers[i]->submissionSerial);
+    }
 
-    for (i = renderer->bufferContainersToDestroyCount - 1; i >= 0; i -= 1) {
-        referenceCount = 0;
-        for (j = 0; j < renderer->bufferContainersToDestroy[i]->bufferCount; j += 1) {
-            referenceCount += SDL_AtomicGet(&renderer->bufferContainersToDestroy[i]->buffers[j]->referenceCount);
+    /* Anything released before the oldest in-flight submission can only be
+     * referenced by command buffers that have not been submitted yet.
+     */
+    while (
+        retiredCount < renderer->deferredDestroyCount &&
+        renderer->deferredDestroys[retiredCount].submissionSerial < oldestInFlightSerial) {
+        retiredCount += 1;
+    }
+
+    if (retiredCount == 0) {
+        SDL_UnlockMutex(renderer->disposeLock);
+        return;
+    }
+
+    for (Uint32 i = 0; i < retiredCount; i += 1) {
+        /* Copied out, requeueing may reallocate the queue */
+        MetalDeferredDestroy deferredDestroy = renderer->deferredDestroys[i];
+        Sint32 referenceCount = 0;
+
+        if (deferredDestroy.isTexture) {
+            MetalTextureContainer *container = (MetalTextureContainer *)deferredDestroy.container;
+            for (Uint32 j = 0; j < container->textureCount; j += 1) {
+                referenceCount += SDL_AtomicGet(&container->textures[j]->referenceCount);
+            }
+        } else {
+            MetalBufferContainer *container = (MetalBufferContainer *)deferredDestroy.container;
+            for (Uint32 j = 0; j < container->bufferCount; j += 1) {
+                referenceCount += SDL_AtomicGet(&container->buffers[j]->referenceCount);
+            }
         }
 
-        if (referenceCount == 0) {
+        if (referenceCount > 0) {
+            /* Still held by a command buffer in recording, check again after its submission */
+            METAL_INTERNAL_QueueDeferredDestroy(
+                renderer,
+                deferredDestroy.isTexture,
+                deferredDestroy.container);
+        } else if (deferredDestroy.isTexture) {
+            METAL_INTERNAL_DestroyTextureContainer(
+                (MetalTextureContainer *)deferredDestroy.container);
+        } else {
             METAL_INTERNAL_DestroyBufferContainer(
-                renderer->bufferContainersToDestroy[i]);
+                (MetalBufferContainer *)deferredDestroy.container);
+        }
+    }
+
+    SDL_memmove(
+        renderer->deferredDestroys,
+        renderer->deferredDestroys + retiredCount,
+        (renderer->deferredDestroyCount - retiredCount) * sizeof(MetalDeferredDestroy));
+    renderer->deferredDestroyCount -= retiredCount;
 
-            renderer->bufferContainersToDestroy[i] = renderer->bufferContainersToDestroy[renderer->bufferContainersToDestroyCount - 1];
-            renderer->bufferContainersToDestroyCount -= 1;
+    SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void METAL_INTERNAL_TrimCycledContainers(
+    MetalRenderer *renderer)
+{
+    SDL_LockMutex(renderer->cycleLock);
+
+    renderer->presentedFrameCount += 1;
+
+    if (renderer->cycleTrimFrames == 0) {
+        SDL_UnlockMutex(renderer->cycleLock);
+        return;
+    }
+
+    for (Sint32 i = renderer->cycledBufferContainerCount - 1; i >= 0; i -= 1) {
+        MetalBufferContainer *container = renderer->cycledBufferContainers[i];
+
+        if (renderer->presentedFrameCount - container->lastCycleFrame < renderer->cycleTrimFrames) {
+            continue;
+        }
+
+        for (Sint32 j = container->bufferCount - 1; j >= 0; j -= 1) {
+            MetalBuffer *buffer = container->buffers[j];
+
+            if (
+                buffer != container->activeBuffer &&
+                SDL_AtomicGet(&buffer->referenceCount) == 0) {
+                buffer->handle = nil;
+                SDL_free(buffer);
+
+                container->buffers[j] = container->buffers[container->bufferCount - 1];
+                container->bufferCount -= 1;
+
+                renderer->cycleHandlesTrimmed += 1;
+            }
+        }
+
+        if (container->bufferCount == 1) {
+            renderer->cycledBufferContainers[i] = renderer->cycledBufferContainers[renderer->cycledBufferContainerCount - 1];
+            renderer->cycledBufferContainerCount -= 1;
         }
     }
 
-    for (i = renderer->textureContainersToDestroyCount - 1; i >= 0; i -= 1) {
-        referenceCount = 0;
-        for (j = 0; j < renderer->textureContainersToDestroy[i]->textureCount; j += 1) {
-            referenceCount += SDL_AtomicGet(&renderer->textureContainersToDestroy[i]->textures[j]->referenceCount);
+    for (Sint32 i = renderer->cycledTextureContainerCount - 1; i >= 0; i -= 1) {
+        MetalTextureContainer *container = renderer->cycledTextureContainers[i];
+
+        if (renderer->presentedFrameCount - container->lastCycleFrame < renderer->cycleTrimFrames) {
+            continue;
         }
 
-        if (referenceCount == 0) {
-            METAL_INTERNAL_DestroyTextureContainer(
-                renderer->textureContainersToDestroy[i]);
+        for (Sint32 j = container->textureCount - 1; j >= 0; j -= 1) {
+            MetalTexture *texture = container->textures[j];
+
+            if (
+                texture != container->activeTexture &&
+                SDL_AtomicGet(&texture->referenceCount) == 0) {
+                texture->handle = nil;
+                texture->msaaHandle = nil;
+                SDL_free(texture);
+
+                container->textures[j] = container->textures[container->textureCount - 1];
+                container->textureCount -= 1;
+
+                renderer->cycleHandlesTrimmed += 1;
+            }
+        }
 
-            renderer->textureContainersToDestroy[i] = renderer->textureContainersToDestroy[renderer->textureContainersToDestroyCount - 1];
-            renderer->textureContainersToDestroyCount -= 1;
+        if (container->textureCount == 1) {
+            renderer->cycledTextureContainers[i] = renderer->cycledTextureContainers[renderer->cycledTextureContainerCount - 1];
+            renderer->cycledTextureContainerCount -= 1;
         }
     }
+
+    SDL_UnlockMutex(renderer->cycleLock);
 }
 
 /* Fences */
 
+static SDL_bool METAL_INTERNAL_AnyFenceComplete(
+    Refresh_Fence **pFences,
+    Uint32 fenceCount)
+{
+    for (Uint32 i = 0; i < fenceCount; i += 1) {
+        if (SDL_AtomicGet(&((MetalFence *)pFences[i])->complete) > 0) {
+            return SDL_TRUE;
+        }
+    }
+
+    return SDL_FALSE;
+}
+
+static void METAL_INTERNAL_WaitForFence(
+    MetalRenderer *renderer,
+    MetalFence *fence)
+{
+    /* Completion handlers set the fence under the lock, so a wakeup can't slip in between the check and the wait */
+    SDL_LockMutex(renderer->fenceCompleteLock);
+    while (!SDL_AtomicGet(&fence->complete)) {
+        SDL_CondWait(renderer->fenceCompleteCond, renderer->fenceCompleteLock);
+    }
+    SDL_UnlockMutex(renderer->fenceCompleteLock);
+}
+
 static void METAL_WaitForFences(
     Refresh_Renderer *driverData,
     SDL_bool waitAll,
@@ -3322,45 +4379,81 @@ static void METAL_WaitForFences(
     Uint32 fenceCount)
 {
     MetalRenderer *renderer = (MetalRenderer *)driverData;
-    SDL_bool waiting;
 
     if (waitAll) {
         for (Uint32 i = 0; i < fenceCount; i += 1) {
-            while (!SDL_AtomicGet(&((MetalFence *)pFences[i])->complete)) {
-                /* Spin! */
-            }
+            METAL_INTERNAL_WaitForFence(renderer, (MetalFence *)pFences[i]);
         }
     } else {
-        waiting = 1;
-        while (waiting) {
-            for (Uint32 i = 0; i < fenceCount; i += 1) {
-                if (SDL_AtomicGet(&((MetalFence *)pFences[i])->complete) > 0) {
-                    waiting = 0;
-                    break;
-                }
-            }
+        SDL_LockMutex(renderer->fenceCompleteLock);
+        while (!METAL_INTERNAL_AnyFenceComplete(pFences, fenceCount)) {
+            SDL_CondWait(renderer->fenceCompleteCond, renderer->fenceCompleteLock);
         }
+        SDL_UnlockMutex(renderer->fenceCompleteLock);
     }
 
+    SDL_LockMutex(renderer->submitLock);
     METAL_INTERNAL_PerformPendingDestroys(renderer);
+    SDL_UnlockMutex(renderer->submitLock);
 }
 
-static SDL_bool METAL_QueryFence(
+static void METAL_WaitForAnyFenceOrWake(
     Refresh_Renderer *driverData,
-    Refresh_Fence *fence)
+    Refresh_Fence **pFences,
+    Uint32 fenceCount)
 {
-    MetalFence *metalFence = (MetalFence *)fence;
-    return SDL_AtomicGet(&metalFence->complete) == 1;
-}
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
 
-/* Window and Swapchain Management */
+    SDL_LockMutex(renderer->fenceCompleteLock);
+    while (
+        !METAL_INTERNAL_AnyFenceComplete(pFences, fenceCount) &&
+        renderer->fenceWakeCount == renderer->fenceWakeConsumed) {
+        SDL_CondWait(renderer->fenceCompleteCond, renderer->fenceCompleteLock);
+    }
 
-static MetalWindowData *METAL_INTERNAL_FetchWindowData(SDL_Window *window)
-{
-	return (MetalWindowData*) SDL_GetWindowData(window, WINDOW_PROPERTY_DATA);
+    /* Wakes arriving after this point stay pending for the next wait */
+    renderer->fenceWakeConsumed = renderer->fenceWakeCount;
+    SDL_UnlockMutex(renderer->fenceCompleteLock);
+
+    SDL_LockMutex(renderer->submitLock);
+    METAL_INTERNAL_PerformPendingDestroys(renderer);
+    SDL_UnlockMutex(renderer->submitLock);
 }
 
-static SDL_bool METAL_SupportsSwapchainComposition(
+static void METAL_WakeFenceWait(
+    Refresh_Renderer *driverData)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+
+    SDL_LockMutex(renderer->fenceCompleteLock);
+    renderer->fenceWakeCount += 1;
+    SDL_CondBroadcast(renderer->fenceCompleteCond);
+    SDL_UnlockMutex(renderer->fenceCompleteLock);
+}
+
+static SDL_bool METAL_QueryFence(
+    Refresh_Renderer *driverData,
+    Refresh_Fence *fence)
+{
+    MetalFence *metalFence = (MetalFence *)fence;
+    return SDL_AtomicGet(&metalFence->complete) == 1;
+}
+
+static Uint64 METAL_GetFenceSubmissionValue(
+    Refresh_Renderer *driverData,
+    Refresh_Fence *fence)
+{
+    return ((MetalFence *)fence)->submissionSerial;
+}
+
+/* Window and Swapchain Management */
+
+static MetalWindowData *METAL_INTERNAL_FetchWindowData(SDL_Window *window)
+{
+	return (MetalWindowData*) SDL_GetWindowData(window, WINDOW_PROPERTY_DATA);
+}
+
+static SDL_bool METAL_SupportsSwapchainComposition(
     Refresh_Renderer *driverData,
     SDL_Window *window,
     Refresh_SwapchainComposition swapchainComposition)
@@ -3456,6 +4549,10 @@ static SDL_bool METAL_ClaimWindow(
         windowData->window = window;
 
         if (METAL_INTERNAL_CreateSwapchain(renderer, windowData, swapchainComposition, presentMode)) {
+            windowData->allowedFramesInFlight = MAX_FRAMES_IN_FLIGHT;
+            windowData->frameSemaphore = SDL_CreateSemaphore(MAX_FRAMES_IN_FLIGHT);
+            windowData->frameSlotAcquired = SDL_FALSE;
+
             SDL_SetWindowData(window, WINDOW_PROPERTY_DATA, windowData);
 
             SDL_LockMutex(renderer->windowLock);
@@ -3506,6 +4603,8 @@ static void METAL_UnclaimWindow(
         renderer,
         windowData);
 
+    SDL_DestroySemaphore(windowData->frameSemaphore);
+
     SDL_LockMutex(renderer->windowLock);
     for (Uint32 i = 0; i < renderer->claimedWindowCount; i += 1) {
         if (renderer->claimedWindows[i]->window == window) {
@@ -3536,6 +4635,12 @@ static Refresh_Texture *METAL_AcquireSwapchainTexture(
         return NULL;
     }
 
+    /* Block until a frame slot is free, unless WaitForSwapchain already claimed one */
+    if (!windowData->frameSlotAcquired) {
+        SDL_SemWait(windowData->frameSemaphore);
+        windowData->frameSlotAcquired = SDL_TRUE;
+    }
+
     /* Get the drawable and its underlying texture */
     windowData->drawable = [windowData->layer nextDrawable];
     windowData->texture.handle = [windowData->drawable texture];
@@ -3620,6 +4725,53 @@ static SDL_bool METAL_SetSwapchainParameters(
     return SDL_TRUE;
 }
 
+static SDL_bool METAL_SetAllowedFramesInFlight(
+    Refresh_Renderer *driverData,
+    SDL_Window *window,
+    Uint32 allowedFramesInFlight)
+{
+    MetalWindowData *windowData = METAL_INTERNAL_FetchWindowData(window);
+
+    if (windowData == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot set allowed frames in flight, window has not been claimed!");
+        return SDL_FALSE;
+    }
+
+    if (allowedFramesInFlight == windowData->allowedFramesInFlight) {
+        return SDL_TRUE;
+    }
+
+    /* Every submitted frame returns its slot once the GPU goes idle */
+    METAL_Wait(driverData);
+
+    /* A slot claimed by a pending acquire is still returned on submit */
+    SDL_DestroySemaphore(windowData->frameSemaphore);
+    windowData->frameSemaphore = SDL_CreateSemaphore(
+        allowedFramesInFlight - (windowData->frameSlotAcquired ? 1 : 0));
+    windowData->allowedFramesInFlight = allowedFramesInFlight;
+
+    return SDL_TRUE;
+}
+
+static SDL_bool METAL_WaitForSwapchain(
+    Refresh_Renderer *driverData,
+    SDL_Window *window)
+{
+    MetalWindowData *windowData = METAL_INTERNAL_FetchWindowData(window);
+
+    if (windowData == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot wait for swapchain, window has not been claimed!");
+        return SDL_FALSE;
+    }
+
+    if (!windowData->frameSlotAcquired) {
+        SDL_SemWait(windowData->frameSemaphore);
+        windowData->frameSlotAcquired = SDL_TRUE;
+    }
+
+    return SDL_TRUE;
+}
+
 /* Submission */
 
 static void METAL_Submit(
@@ -3627,17 +4779,31 @@ static void METAL_Submit(
 {
     MetalCommandBuffer *metalCommandBuffer = (MetalCommandBuffer *)commandBuffer;
     MetalRenderer *renderer = metalCommandBuffer->renderer;
+    SDL_bool presenting = metalCommandBuffer->windowDataCount > 0;
 
     SDL_LockMutex(renderer->submitLock);
 
     /* Enqueue present requests, if applicable */
     for (Uint32 i = 0; i < metalCommandBuffer->windowDataCount; i += 1) {
-        [metalCommandBuffer->handle presentDrawable:metalCommandBuffer->windowDatas[i]->drawable];
+        MetalWindowData *windowData = metalCommandBuffer->windowDatas[i];
+        SDL_sem *frameSemaphore = windowData->frameSemaphore;
+
+        [metalCommandBuffer->handle presentDrawable:windowData->drawable];
+
+        /* Registered before the fence handler, so a signaled fence implies the slot was returned */
+        [metalCommandBuffer->handle addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+          SDL_SemPost(frameSemaphore);
+        }];
+
+        windowData->frameSlotAcquired = SDL_FALSE;
     }
 
     /* Notify the fence when the command buffer has completed */
     [metalCommandBuffer->handle addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+      SDL_LockMutex(renderer->fenceCompleteLock);
       SDL_AtomicIncRef(&metalCommandBuffer->fence->complete);
+      SDL_CondBroadcast(renderer->fenceCompleteCond);
+      SDL_UnlockMutex(renderer->fenceCompleteLock);
     }];
 
     /* Submit the command buffer */
@@ -3645,6 +4811,12 @@ static void METAL_Submit(
     metalCommandBuffer->handle = nil;
 
     /* Mark the command buffer as submitted */
+    SDL_LockMutex(renderer->disposeLock);
+    renderer->submissionSerial += 1;
+    metalCommandBuffer->submissionSerial = renderer->submissionSerial;
+    metalCommandBuffer->fence->submissionSerial = renderer->submissionSerial;
+    SDL_UnlockMutex(renderer->disposeLock);
+
     if (renderer->submittedCommandBufferCount >= renderer->submittedCommandBufferCapacity) {
         renderer->submittedCommandBufferCapacity = renderer->submittedCommandBufferCount + 1;
 
@@ -3666,6 +4838,12 @@ static void METAL_Submit(
 
     METAL_INTERNAL_PerformPendingDestroys(renderer);
 
+    /* Release cycled resources that have been idle for a while, then any heaps they emptied */
+    if (presenting) {
+        METAL_INTERNAL_TrimCycledContainers(renderer);
+        METAL_INTERNAL_TrimHeaps(renderer);
+    }
+
     SDL_UnlockMutex(renderer->submitLock);
 }
 
@@ -3692,9 +4870,7 @@ static void METAL_Wait(
      * Sort of equivalent to vkDeviceWaitIdle.
      */
     for (Uint32 i = 0; i < renderer->submittedCommandBufferCount; i += 1) {
-        while (!SDL_AtomicGet(&renderer->submittedCommandBuffers[i]->fence->complete)) {
-            /* Spin! */
-        }
+        METAL_INTERNAL_WaitForFence(renderer, renderer->submittedCommandBuffers[i]->fence);
     }
 
     SDL_LockMutex(renderer->submitLock);
@@ -3767,6 +4943,515 @@ static SDL_bool METAL_IsTextureFormatSupported(
     }
 }
 
+/* Pipeline Cache */
+
+static NSURL *METAL_INTERNAL_GetPipelineArchiveURL(void)
+{
+    NSString *fileName = [NSString stringWithFormat:@"Refresh_%@.metallib", [[NSUUID UUID] UUIDString]];
+    return [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:fileName]];
+}
+
+static SDL_bool METAL_LoadPipelineCacheData(
+    Refresh_Renderer *driverData,
+    const void *data,
+    size_t dataSize)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+
+    if (renderer->pipelineArchive == nil) {
+        return SDL_FALSE;
+    }
+
+    if (@available(macOS 11.0, *)) {
+        /* Binary archives can only be loaded from a file */
+        NSURL *url = METAL_INTERNAL_GetPipelineArchiveURL();
+        NSData *archiveData = [NSData dataWithBytesNoCopy:(void *)data length:dataSize freeWhenDone:NO];
+        MTLBinaryArchiveDescriptor *descriptor;
+        id<MTLBinaryArchive> archive;
+        NSError *error = NULL;
+
+        if (![archiveData writeToURL:url atomically:NO]) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to write pipeline archive to temporary file!");
+            return SDL_FALSE;
+        }
+
+        descriptor = [MTLBinaryArchiveDescriptor new];
+        descriptor.url = url;
+        archive = [renderer->device newBinaryArchiveWithDescriptor:descriptor error:&error];
+
+        [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+
+        if (error != NULL) {
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_APPLICATION,
+                "Pipeline archive does not match this device, ignoring: %s", [[error description] UTF8String]);
+            return SDL_FALSE;
+        }
+
+        renderer->pipelineArchive = archive;
+        return SDL_TRUE;
+    }
+
+    return SDL_FALSE;
+}
+
+static SDL_bool METAL_GetPipelineCacheData(
+    Refresh_Renderer *driverData,
+    void *data,
+    size_t *pDataSize)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+
+    if (renderer->pipelineArchive == nil) {
+        *pDataSize = 0;
+        return SDL_FALSE;
+    }
+
+    if (@available(macOS 11.0, *)) {
+        NSURL *url = METAL_INTERNAL_GetPipelineArchiveURL();
+        NSData *archiveData;
+        NSError *error = NULL;
+
+        [renderer->pipelineArchive serializeToURL:url error:&error];
+        if (error != NULL) {
+            SDL_LogError(
+                SDL_LOG_CATEGORY_APPLICATION,
+                "Serializing pipeline archive failed: %s", [[error description] UTF8String]);
+            *pDataSize = 0;
+            return SDL_FALSE;
+        }
+
+        archiveData = [NSData dataWithContentsOfURL:url];
+        [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+
+        if (archiveData == nil) {
+            *pDataSize = 0;
+            return SDL_FALSE;
+        }
+
+        if (data == NULL) {
+            *pDataSize = archiveData.length;
+            return SDL_TRUE;
+        }
+
+        if (*pDataSize < archiveData.length) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache data buffer is too small!");
+            return SDL_FALSE;
+        }
+
+        SDL_memcpy(data, archiveData.bytes, archiveData.length);
+        *pDataSize = archiveData.length;
+        return SDL_TRUE;
+    }
+
+    *pDataSize = 0;
+    return SDL_FALSE;
+}
+
+/* Shader Cache */
+
+/* Metal cannot serialize a library compiled from source at runtime,
+ * so the translated MSL is cached instead. The resulting pipelines are
+ * still covered by the pipeline archive.
+ */
+
+static SDL_bool METAL_CompileShaderBinary(
+    Refresh_Renderer *driverData,
+    Refresh_ShaderStage stage,
+    SDL_bool isCompute,
+    Refresh_ShaderFormat format,
+    const Uint8 *code,
+    size_t codeSize,
+    const char *entryPointName,
+    Refresh_ShaderFormat *pBinaryFormat,
+    void **pBinary,
+    size_t *pBinarySize)
+{
+    (void)driverData;
+    (void)stage;
+    (void)isCompute;
+    (void)format;
+    (void)code;
+    (void)codeSize;
+    (void)entryPointName;
+    (void)pBinaryFormat;
+    (void)pBinary;
+    (void)pBinarySize;
+    return SDL_FALSE;
+}
+
+/* Timestamp Queries */
+
+static Refresh_QueryPool *METAL_CreateTimestampQueryPool(
+    Refresh_Renderer *driverData,
+    Uint32 queryCount)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+
+    if (@available(macOS 10.15, iOS 14.0, tvOS 14.0, *)) {
+        id<MTLCounterSet> timestampCounterSet = nil;
+        MTLCounterSampleBufferDescriptor *descriptor;
+        id<MTLCounterSampleBuffer> sampleBuffer;
+        MetalQueryPool *queryPool;
+        NSError *error = nil;
+
+        for (id<MTLCounterSet> counterSet in renderer->device.counterSets) {
+            if ([counterSet.name isEqualToString:MTLCommonCounterSetTimestamp]) {
+                timestampCounterSet = counterSet;
+                break;
+            }
+        }
+
+        if (timestampCounterSet == nil) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timestamp counters are not supported on this device!");
+            return NULL;
+        }
+
+        descriptor = [MTLCounterSampleBufferDescriptor new];
+        descriptor.counterSet = timestampCounterSet;
+        descriptor.storageMode = MTLStorageModeShared;
+        descriptor.sampleCount = queryCount;
+
+        sampleBuffer = [renderer->device newCounterSampleBufferWithDescriptor:descriptor error:&error];
+        if (sampleBuffer == nil) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create counter sample buffer: %s", [[error description] UTF8String]);
+            return NULL;
+        }
+
+        queryPool = SDL_calloc(1, sizeof(MetalQueryPool));
+        queryPool->sampleBuffer = sampleBuffer;
+        queryPool->queryCount = queryCount;
+        [renderer->device sampleTimestamps:&queryPool->cpuTimestamp gpuTimestamp:&queryPool->gpuTimestamp];
+
+        return (Refresh_QueryPool *)queryPool;
+    }
+
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timestamp counters require macOS 10.15 or iOS 14!");
+    return NULL;
+}
+
+static void METAL_ReleaseQueryPool(
+    Refresh_Renderer *driverData,
+    Refresh_QueryPool *queryPool)
+{
+    (void)driverData; /* used by other backends */
+    MetalQueryPool *metalQueryPool = (MetalQueryPool *)queryPool;
+    metalQueryPool->sampleBuffer = nil;
+    SDL_free(metalQueryPool);
+}
+
+static void METAL_ResetQueryPool(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_QueryPool *queryPool)
+{
+    /* Samples are overwritten in place, there is nothing to reset */
+    (void)commandBuffer;
+    (void)queryPool;
+}
+
+static void METAL_WriteTimestamp(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_QueryPool *queryPool,
+    Uint32 queryIndex)
+{
+    MetalCommandBuffer *metalCommandBuffer = (MetalCommandBuffer *)commandBuffer;
+    MetalQueryPool *metalQueryPool = (MetalQueryPool *)queryPool;
+    id<MTLDevice> device = metalCommandBuffer->renderer->device;
+
+    if (queryIndex >= metalQueryPool->queryCount) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timestamp query index out of range!");
+        return;
+    }
+
+    if (@available(macOS 11.0, iOS 14.0, tvOS 14.0, *)) {
+        /* Apple GPUs only sample at encoder boundaries, so mid-pass samples can't be taken there */
+        if (metalCommandBuffer->renderEncoder) {
+            if ([device supportsCounterSampling:MTLCounterSamplingPointAtDrawBoundary]) {
+                [metalCommandBuffer->renderEncoder sampleCountersInBuffer:metalQueryPool->sampleBuffer atSampleIndex:queryIndex withBarrier:YES];
+            } else {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "This device cannot write timestamps inside a render pass!");
+            }
+        } else if (metalCommandBuffer->computeEncoder) {
+            if ([device supportsCounterSampling:MTLCounterSamplingPointAtDispatchBoundary]) {
+                [metalCommandBuffer->computeEncoder sampleCountersInBuffer:metalQueryPool->sampleBuffer atSampleIndex:queryIndex withBarrier:YES];
+            } else {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "This device cannot write timestamps inside a compute pass!");
+            }
+        } else if (metalCommandBuffer->blitEncoder) {
+            if ([device supportsCounterSampling:MTLCounterSamplingPointAtBlitBoundary]) {
+                [metalCommandBuffer->blitEncoder sampleCountersInBuffer:metalQueryPool->sampleBuffer atSampleIndex:queryIndex withBarrier:YES];
+            } else {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "This device cannot write timestamps inside a copy pass!");
+            }
+        } else if ([device supportsCounterSampling:MTLCounterSamplingPointAtBlitBoundary]) {
+            id<MTLBlitCommandEncoder> blitEncoder = [metalCommandBuffer->handle blitCommandEncoder];
+            [blitEncoder sampleCountersInBuffer:metalQueryPool->sampleBuffer atSampleIndex:queryIndex withBarrier:YES];
+            [blitEncoder endEncoding];
+        } else if ([device supportsCounterSampling:MTLCounterSamplingPointAtStageBoundary]) {
+            /* An empty compute pass gives us a stage boundary to sample at */
+            MTLComputePassDescriptor *passDescriptor = [MTLComputePassDescriptor computePassDescriptor];
+            passDescriptor.sampleBufferAttachments[0].sampleBuffer = metalQueryPool->sampleBuffer;
+            passDescriptor.sampleBufferAttachments[0].startOfEncoderSampleIndex = queryIndex;
+            passDescriptor.sampleBufferAttachments[0].endOfEncoderSampleIndex = MTLCounterDontSample;
+
+            id<MTLComputeCommandEncoder> computeEncoder = [metalCommandBuffer->handle computeCommandEncoderWithDescriptor:passDescriptor];
+            [computeEncoder endEncoding];
+        } else {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "This device cannot write timestamps outside of a pass!");
+        }
+    } else {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Writing timestamps requires macOS 11 or iOS 14!");
+    }
+}
+
+static SDL_bool METAL_GetTimestampResults(
+    Refresh_Renderer *driverData,
+    Refresh_QueryPool *queryPool,
+    Uint32 firstQuery,
+    Uint32 queryCount,
+    Uint64 *results)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+    MetalQueryPool *metalQueryPool = (MetalQueryPool *)queryPool;
+
+    if (firstQuery > metalQueryPool->queryCount ||
+        queryCount > metalQueryPool->queryCount - firstQuery) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timestamp query range out of bounds!");
+        return SDL_FALSE;
+    }
+
+    if (queryCount == 0) {
+        return SDL_TRUE;
+    }
+
+    if (@available(macOS 10.15, iOS 14.0, tvOS 14.0, *)) {
+        MTLTimestamp cpuTimestamp, gpuTimestamp;
+        const MTLCounterResultTimestamp *timestamps;
+        double scale = 1.0;
+        NSData *data;
+
+        data = [metalQueryPool->sampleBuffer resolveCounterRange:NSMakeRange(firstQuery, queryCount)];
+        if (data == nil || data.length < sizeof(MTLCounterResultTimestamp) * queryCount) {
+            return SDL_FALSE;
+        }
+
+        /* GPU ticks aren't nanoseconds on every device, so calibrate against the CPU clock.
+         * The pair sampled at creation is the origin, so the scale only applies to the ticks since then.
+         */
+        [renderer->device sampleTimestamps:&cpuTimestamp gpuTimestamp:&gpuTimestamp];
+        if (gpuTimestamp > metalQueryPool->gpuTimestamp) {
+            scale = (double)(cpuTimestamp - metalQueryPool->cpuTimestamp) /
+                    (double)(gpuTimestamp - metalQueryPool->gpuTimestamp);
+        }
+
+        timestamps = (const MTLCounterResultTimestamp *)data.bytes;
+        for (Uint32 i = 0; i < queryCount; i += 1) {
+            if (timestamps[i].timestamp == MTLCounterErrorValue) {
+                return SDL_FALSE;
+            }
+            results[i] = (Uint64)(
+                (double)metalQueryPool->cpuTimestamp +
+                ((double)timestamps[i].timestamp - (double)metalQueryPool->gpuTimestamp) * scale);
+        }
+
+        return SDL_TRUE;
+    }
+
+    return SDL_FALSE;
+}
+
+/* Bindless Resources */
+
+/* Bindless resources are not supported on this backend */
+
+static SDL_bool METAL_SupportsBindless(
+    Refresh_Renderer *driverData)
+{
+    (void)driverData;
+    return SDL_FALSE;
+}
+
+static SDL_bool METAL_RegisterBindlessTexture(
+    Refresh_Renderer *driverData,
+    Refresh_Texture *texture,
+    Uint32 *pIndex)
+{
+    (void)driverData;
+    (void)texture;
+    (void)pIndex;
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless resources are not supported on this backend!");
+    return SDL_FALSE;
+}
+
+static SDL_bool METAL_RegisterBindlessSampler(
+    Refresh_Renderer *driverData,
+    Refresh_Sampler *sampler,
+    Uint32 *pIndex)
+{
+    (void)driverData;
+    (void)sampler;
+    (void)pIndex;
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless resources are not supported on this backend!");
+    return SDL_FALSE;
+}
+
+static SDL_bool METAL_RegisterBindlessStorageBuffer(
+    Refresh_Renderer *driverData,
+    Refresh_Buffer *buffer,
+    Uint32 *pIndex)
+{
+    (void)driverData;
+    (void)buffer;
+    (void)pIndex;
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless resources are not supported on this backend!");
+    return SDL_FALSE;
+}
+
+static void METAL_UnregisterBindlessResource(
+    Refresh_Renderer *driverData,
+    Refresh_BindlessResourceType resourceType,
+    Uint32 index)
+{
+    (void)driverData;
+    (void)resourceType;
+    (void)index;
+}
+
+/* Resource Cycling */
+
+static void METAL_SetBufferCycleLimit(
+    Refresh_Renderer *driverData,
+    Refresh_Buffer *buffer,
+    Uint32 maxCycleCount)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+
+    SDL_LockMutex(renderer->cycleLock);
+    ((MetalBufferContainer *)buffer)->maxCycleCount = maxCycleCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+}
+
+static void METAL_SetTransferBufferCycleLimit(
+    Refresh_Renderer *driverData,
+    Refresh_TransferBuffer *transferBuffer,
+    Uint32 maxCycleCount)
+{
+    METAL_SetBufferCycleLimit(
+        driverData,
+        (Refresh_Buffer *)transferBuffer,
+        maxCycleCount);
+}
+
+static void METAL_SetTextureCycleLimit(
+    Refresh_Renderer *driverData,
+    Refresh_Texture *texture,
+    Uint32 maxCycleCount)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+
+    SDL_LockMutex(renderer->cycleLock);
+    ((MetalTextureContainer *)texture)->maxCycleCount = maxCycleCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+}
+
+static Uint32 METAL_GetBufferCycleCount(
+    Refresh_Renderer *driverData,
+    Refresh_Buffer *buffer)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+    Uint32 count;
+
+    SDL_LockMutex(renderer->cycleLock);
+    count = ((MetalBufferContainer *)buffer)->bufferCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+
+    return count;
+}
+
+static Uint32 METAL_GetTransferBufferCycleCount(
+    Refresh_Renderer *driverData,
+    Refresh_TransferBuffer *transferBuffer)
+{
+    return METAL_GetBufferCycleCount(
+        driverData,
+        (Refresh_Buffer *)transferBuffer);
+}
+
+static Uint32 METAL_GetTextureCycleCount(
+    Refresh_Renderer *driverData,
+    Refresh_Texture *texture)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+    Uint32 count;
+
+    SDL_LockMutex(renderer->cycleLock);
+    count = ((MetalTextureContainer *)texture)->textureCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+
+    return count;
+}
+
+static void METAL_SetCycleTrimFrames(
+    Refresh_Renderer *driverData,
+    Uint32 frameCount)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+
+    SDL_LockMutex(renderer->cycleLock);
+    renderer->cycleTrimFrames = frameCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+}
+
+/* Defragmentation */
+
+/* Resources are not suballocated on this backend, the driver owns placement */
+
+static void METAL_SetDefragmentationSettings(
+    Refresh_Renderer *driverData,
+    Refresh_DefragmentationSettings *settings)
+{
+    (void)driverData;
+    (void)settings;
+}
+
+static void METAL_RequestDefragmentation(
+    Refresh_Renderer *driverData)
+{
+    (void)driverData;
+}
+
+/* Statistics */
+
+static void METAL_GetDeviceStatistics(
+    Refresh_Renderer *driverData,
+    Refresh_DeviceStatistics *statistics)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+
+    /* No descriptor sets, barriers or defragmentation on this backend */
+    SDL_zerop(statistics);
+
+    SDL_LockMutex(renderer->cycleLock);
+    statistics->cycleHandlesCreated = renderer->cycleHandlesCreated;
+    statistics->cycleHandlesTrimmed = renderer->cycleHandlesTrimmed;
+    statistics->cycleLimitHits = renderer->cycleLimitHits;
+    SDL_UnlockMutex(renderer->cycleLock);
+}
+
+static void METAL_GetMemoryStatistics(
+    Refresh_Renderer *driverData,
+    Refresh_MemoryStatistics *statistics)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+
+    SDL_zerop(statistics);
+
+    statistics->allocatedBytes = renderer->device.currentAllocatedSize;
+    statistics->usedBytes = statistics->allocatedBytes;
+    statistics->usageBytes = statistics->allocatedBytes;
+    statistics->budgetBytes = renderer->device.recommendedMaxWorkingSetSize;
+}
+
 /* Device Creation */
 
 static SDL_bool METAL_PrepareDriver()
@@ -3915,13 +5600,32 @@ static Refresh_Device *METAL_CreateDevice(SDL_bool debugMode, SDL_bool preferLow
         SwapchainCompositionToColorSpace[3] = NULL;
     }
 
+    /* Create an empty pipeline archive, seeded via Refresh_LoadPipelineCacheData */
+    if (@available(macOS 11.0, *)) {
+        renderer->pipelineArchive = [renderer->device newBinaryArchiveWithDescriptor:[MTLBinaryArchiveDescriptor new] error:nil];
+    }
+
     /* Create mutexes */
     renderer->submitLock = SDL_CreateMutex();
     renderer->acquireCommandBufferLock = SDL_CreateMutex();
     renderer->acquireUniformBufferLock = SDL_CreateMutex();
+    renderer->acquireStagingBlockLock = SDL_CreateMutex();
     renderer->disposeLock = SDL_CreateMutex();
     renderer->fenceLock = SDL_CreateMutex();
     renderer->windowLock = SDL_CreateMutex();
+    renderer->cycleLock = SDL_CreateMutex();
+    renderer->heapLock = SDL_CreateMutex();
+    renderer->fenceCompleteLock = SDL_CreateMutex();
+    renderer->fenceCompleteCond = SDL_CreateCond();
+
+    /* Resources only inherit automatic hazard tracking from heaps on macOS 10.15+.
+     * Shared storage heaps need unified memory.
+     */
+    if (@available(macOS 10.15, iOS 13.0, tvOS 13.0, *)) {
+        renderer->supportsHeapType[METAL_HEAP_TYPE_PRIVATE] = SDL_TRUE;
+        renderer->supportsHeapType[METAL_HEAP_TYPE_SHARED] = renderer->device.hasUnifiedMemory;
+        renderer->supportsHeapType[METAL_HEAP_TYPE_SHARED_WRITE_COMBINED] = renderer->device.hasUnifiedMemory;
+    }
 
     /* Create command buffer pool */
     METAL_INTERNAL_AllocateCommandBuffers(renderer, 2);
@@ -3932,8 +5636,8 @@ static Refresh_Device *METAL_CreateDevice(SDL_bool debugMode, SDL_bool preferLow
         sizeof(MetalFence *) * renderer->availableFenceCapacity);
 
     /* Create uniform buffer pool */
-    renderer->uniformBufferPoolCapacity = 32;
-    renderer->uniformBufferPoolCount = 32;
+    renderer->uniformBufferPoolCapacity = 8;
+    renderer->uniformBufferPoolCount = 8;
     renderer->uniformBufferPool = SDL_malloc(
         renderer->uniformBufferPoolCapacity * sizeof(MetalUniformBuffer *));
 
@@ -3943,16 +5647,29 @@ static Refresh_Device *METAL_CreateDevice(SDL_bool debugMode, SDL_bool preferLow
             UNIFORM_BUFFER_SIZE);
     }
 
-    /* Create deferred destroy arrays */
-    renderer->bufferContainersToDestroyCapacity = 2;
-    renderer->bufferContainersToDestroyCount = 0;
-    renderer->bufferContainersToDestroy = SDL_malloc(
-        renderer->bufferContainersToDestroyCapacity * sizeof(MetalBufferContainer *));
-
-    renderer->textureContainersToDestroyCapacity = 2;
-    renderer->textureContainersToDestroyCount = 0;
-    renderer->textureContainersToDestroy = SDL_malloc(
-        renderer->textureContainersToDestroyCapacity * sizeof(MetalTextureContainer *));
+    /* Staging blocks are created on demand */
+    renderer->stagingBlockPoolCapacity = 4;
+    renderer->stagingBlockPoolCount = 0;
+    renderer->stagingBlockPool = SDL_malloc(
+        renderer->stagingBlockPoolCapacity * sizeof(MetalBufferContainer *));
+
+    /* Create deferred destroy queue */
+    renderer->deferredDestroyCapacity = 16;
+    renderer->deferredDestroyCount = 0;
+    renderer->deferredDestroys = SDL_malloc(
+        renderer->deferredDestroyCapacity * sizeof(MetalDeferredDestroy));
+    renderer->submissionSerial = 0;
+
+    /* Create cycled container lists */
+    renderer->cycledBufferContainerCapacity = 2;
+    renderer->cycledBufferContainerCount = 0;
+    renderer->cycledBufferContainers = SDL_malloc(
+        renderer->cycledBufferContainerCapacity * sizeof(MetalBufferContainer *));
+
+    renderer->cycledTextureContainerCapacity = 2;
+    renderer->cycledTextureContainerCount = 0;
+    renderer->cycledTextureContainers = SDL_malloc(
+        renderer->cycledTextureContainerCapacity * sizeof(MetalTextureContainer *));
 
     /* Create claimed window list */
     renderer->claimedWindowCapacity = 1;
@@ -65,11 +65,16 @@ typedef struct VulkanExtensions
     /* Core since 1.1 */
     Uint8 KHR_maintenance1;
     Uint8 KHR_get_memory_requirements2;
+    Uint8 KHR_maintenance3;
 
     /* Core since 1.2 */
     Uint8 KHR_driver_properties;
+    Uint8 EXT_descriptor_indexing;
+    Uint8 KHR_draw_indirect_count;
+    Uint8 KHR_timeline_semaphore;
     /* EXT, probably not going to be Core */
     Uint8 EXT_vertex_attribute_divisor;
+    Uint8 EXT_memory_budget;
     /* Only required for special implementations (i.e. MoltenVK) */
     Uint8 KHR_portability_subset;
 } VulkanExtensions;
@@ -79,8 +84,25 @@ typedef struct VulkanExtensions
 #define SMALL_ALLOCATION_THRESHOLD    2097152  /* 2   MiB */
 #define SMALL_ALLOCATION_SIZE         16777216 /* 16  MiB */
 #define LARGE_ALLOCATION_INCREMENT    67108864 /* 64  MiB */
+#define FREE_REGION_FIRST_LEVEL_COUNT  64
+#define FREE_REGION_SECOND_LEVEL_LOG2  2
+#define FREE_REGION_SECOND_LEVEL_COUNT (1 << FREE_REGION_SECOND_LEVEL_LOG2)
 #define MAX_UBO_SECTION_SIZE          4096     /* 4   KiB */
 #define DESCRIPTOR_POOL_STARTING_SIZE 128
+#define DESCRIPTOR_SET_BATCH_SIZE     16
+#define MAX_PENDING_ASYNC_SEMAPHORES  16
+#define FENCE_WAKE_POLL_TIMEOUT       1000000  /* 1 ms, for fence waits that can't include the wake semaphore */
+#define MAX_BINDLESS_TEXTURES         16384
+#define MAX_BINDLESS_SAMPLERS         2048
+#define MAX_BINDLESS_STORAGE_BUFFERS  16384
+#define BINDLESS_INVALID_INDEX        0xFFFFFFFF
+#define MIPMAP_LEVELS_PER_DISPATCH    4
+#define MIPMAP_FORMAT_COUNT           5
+
+/* The downsample shaders are hand-assembled and have never been validated or run.
+ * Leave this off until the headers are regenerated with compile_shaders.bat and pass spirv-val.
+ */
+#define VULKAN_COMPUTE_MIPMAPS        0
 #define WINDOW_PROPERTY_DATA          "Refresh_VulkanWindowPropertyData"
 
 #define IDENTITY_SWIZZLE               \
@@ -250,6 +272,48 @@ static VkComponentMapping RefreshToVK_SurfaceSwizzle[] = {
     IDENTITY_SWIZZLE, /* D32_SFLOAT_S8_UINT */
 };
 
+/* Built-in shaders, see VULKAN_COMPUTE_MIPMAPS */
+
+#include "VULKAN_MipmapDownsample1.h"
+#include "VULKAN_MipmapDownsample2.h"
+#include "VULKAN_MipmapDownsample3.h"
+#include "VULKAN_MipmapDownsample4.h"
+
+/* Indexed by the number of levels written per dispatch, minus one */
+static const uint32_t *MipmapDownsampleCode[] = {
+    VULKAN_MipmapDownsample1,
+    VULKAN_MipmapDownsample2,
+    VULKAN_MipmapDownsample3,
+    VULKAN_MipmapDownsample4
+};
+
+static size_t MipmapDownsampleCodeSize[] = {
+    sizeof(VULKAN_MipmapDownsample1),
+    sizeof(VULKAN_MipmapDownsample2),
+    sizeof(VULKAN_MipmapDownsample3),
+    sizeof(VULKAN_MipmapDownsample4)
+};
+
+/* Formats the compute downsampler can write, limited to the storage image
+ * formats that don't need the StorageImageExtendedFormats capability.
+ * The matching SPIR-V ImageFormat is patched into the shader at pipeline creation.
+ */
+static VkFormat MipmapDownsampleFormats[] = {
+    VK_FORMAT_R8G8B8A8_UNORM,
+    VK_FORMAT_R8G8B8A8_SNORM,
+    VK_FORMAT_R16G16B16A16_SFLOAT,
+    VK_FORMAT_R32_SFLOAT,
+    VK_FORMAT_R32G32B32A32_SFLOAT
+};
+
+static Uint32 MipmapDownsampleSpvFormats[] = {
+    4, /* Rgba8 */
+    5, /* Rgba8Snorm */
+    2, /* Rgba16f */
+    3, /* R32f */
+    1  /* Rgba32f */
+};
+
 /* from SWAPCHAINCOMPOSITION */
 static VkFormat SwapchainCompositionToFormat[] = {
     VK_FORMAT_B8G8R8A8_UNORM,          /* SDR */
@@ -420,20 +484,27 @@ typedef struct VulkanTextureContainer VulkanTextureContainer;
 
 typedef struct VulkanFenceHandle
 {
-    VkFence fence;
+    VkFence fence;                 /* VK_NULL_HANDLE when the fence is backed by a queue timeline */
+    VkSemaphore timelineSemaphore; /* Reaches submissionValue once the submission completes */
+    Uint64 submissionValue;
     SDL_atomic_t referenceCount;
 } VulkanFenceHandle;
 
 /* Memory Allocation */
 
-typedef struct VulkanMemoryFreeRegion
+typedef struct VulkanMemoryFreeRegion VulkanMemoryFreeRegion;
+
+struct VulkanMemoryFreeRegion
 {
     VulkanMemoryAllocation *allocation;
     VkDeviceSize offset;
     VkDeviceSize size;
     Uint32 allocationIndex;
-    Uint32 sortedIndex;
-} VulkanMemoryFreeRegion;
+
+    /* Size class list links, only valid while the allocation is available */
+    VulkanMemoryFreeRegion *prevInSizeClass;
+    VulkanMemoryFreeRegion *nextInSizeClass;
+};
 
 typedef struct VulkanMemoryUsedRegion
 {
@@ -451,14 +522,29 @@ typedef struct VulkanMemoryUsedRegion
     };
 } VulkanMemoryUsedRegion;
 
+/* Free regions are bucketed TLSF-style: the first level is the
+ * power of two of the region size and the second level splits that
+ * range linearly. Bitmaps let a search skip straight to a non-empty
+ * bucket that can hold the request.
+ */
+typedef struct VulkanMemorySizeClassIndex
+{
+    Uint64 firstLevelBitmap;
+    Uint8 secondLevelBitmaps[FREE_REGION_FIRST_LEVEL_COUNT];
+    VulkanMemoryFreeRegion *heads[FREE_REGION_FIRST_LEVEL_COUNT][FREE_REGION_SECOND_LEVEL_COUNT];
+} VulkanMemorySizeClassIndex;
+
 typedef struct VulkanMemorySubAllocator
 {
     Uint32 memoryTypeIndex;
     VulkanMemoryAllocation **allocations;
     Uint32 allocationCount;
-    VulkanMemoryFreeRegion **sortedFreeRegions;
-    Uint32 sortedFreeRegionCount;
-    Uint32 sortedFreeRegionCapacity;
+
+    /* Indexed by whether the allocation is SMALL_ALLOCATION_SIZE */
+    VulkanMemorySizeClassIndex freeRegionIndices[2];
+
+    /* Guards the allocations and regions of this memory type */
+    SDL_mutex *lock;
 } VulkanMemorySubAllocator;
 
 struct VulkanMemoryAllocation
@@ -473,6 +559,7 @@ struct VulkanMemoryAllocation
     Uint32 freeRegionCount;
     Uint32 freeRegionCapacity;
     Uint8 availableForAllocation;
+    Uint8 markedForDefrag;
     VkDeviceSize freeSpace;
     VkDeviceSize usedSpace;
     Uint8 *mapPointer;
@@ -517,6 +604,10 @@ struct VulkanBuffer
 
     SDL_bool transitioned;
     Uint8 markedForDestroy; /* so that defrag doesn't double-free */
+
+    Uint32 bindlessIndex; /* BINDLESS_INVALID_INDEX if not registered */
+
+    Uint64 lastUseValues[3]; /* Timeline value of the latest submission using this buffer, per queue */
 };
 
 /* Buffer resources consist of multiple backing buffer handles so that data transfers
@@ -537,6 +628,10 @@ struct VulkanBufferContainer
     Uint32 bufferCount;
     VulkanBufferHandle **bufferHandles;
 
+    /* 0 means no limit. Cycling state is protected by the renderer's cycleLock. */
+    Uint32 maxCycleCount;
+    Uint64 lastCycleFrame;
+
     char *debugName;
 };
 
@@ -554,8 +649,37 @@ typedef struct VulkanSampler
 {
     VkSampler sampler;
     SDL_atomic_t referenceCount;
+    Uint32 bindlessIndex; /* BINDLESS_INVALID_INDEX if not registered */
 } VulkanSampler;
 
+typedef struct VulkanQueryPool
+{
+    VkQueryPool queryPool;
+    Uint32 queryCount;
+    Uint8 *validBits; /* Per query, from the queue that last wrote it */
+    SDL_atomic_t referenceCount;
+} VulkanQueryPool;
+
+typedef enum VulkanDeferredDestroyType
+{
+    VULKAN_DEFERRED_DESTROY_TEXTURE,
+    VULKAN_DEFERRED_DESTROY_BUFFER,
+    VULKAN_DEFERRED_DESTROY_SAMPLER,
+    VULKAN_DEFERRED_DESTROY_GRAPHICS_PIPELINE,
+    VULKAN_DEFERRED_DESTROY_COMPUTE_PIPELINE,
+    VULKAN_DEFERRED_DESTROY_SHADER,
+    VULKAN_DEFERRED_DESTROY_FRAMEBUFFER,
+    VULKAN_DEFERRED_DESTROY_QUERY_POOL
+} VulkanDeferredDestroyType;
+
+/* A released resource, queued against the submission count at release time */
+typedef struct VulkanDeferredDestroy
+{
+    VulkanDeferredDestroyType type;
+    Uint64 submissionSerial;
+    void *resource;
+} VulkanDeferredDestroy;
+
 typedef struct VulkanShader
 {
     VkShaderModule shaderModule;
@@ -588,6 +712,8 @@ typedef struct VulkanTextureSlice
     VulkanTextureHandle *msaaTexHandle; /* NULL if parent sample count is 1 or is depth target */
 
     SDL_bool transitioned; /* used for layout tracking */
+
+    Uint64 lastUseValues[3]; /* Timeline value of the latest submission using this slice, per queue */
 } VulkanTextureSlice;
 
 struct VulkanTexture
@@ -618,6 +744,8 @@ struct VulkanTexture
     VulkanTextureHandle *handle;
 
     Uint8 markedForDestroy; /* so that defrag doesn't double-free */
+
+    Uint32 bindlessIndex; /* BINDLESS_INVALID_INDEX if not registered */
 };
 
 /* Texture resources consist of multiple backing texture handles so that data transfers
@@ -641,6 +769,10 @@ struct VulkanTextureContainer
     /* Swapchain images cannot be cycled */
     Uint8 canBeCycled;
 
+    /* 0 means no limit. Cycling state is protected by the renderer's cycleLock. */
+    Uint32 maxCycleCount;
+    Uint64 lastCycleFrame;
+
     char *debugName;
 };
 
@@ -712,6 +844,7 @@ typedef struct WindowData
     SDL_Window *window;
     Refresh_SwapchainComposition swapchainComposition;
     Refresh_PresentMode presentMode;
+    Uint32 allowedFramesInFlight; /* Survives swapchain recreation */
     VulkanSwapchainData *swapchainData;
 } WindowData;
 
@@ -733,7 +866,6 @@ typedef struct VulkanPresentData
 typedef struct VulkanUniformBuffer
 {
     VulkanBufferHandle *bufferHandle;
-    Uint32 drawOffset;
     Uint32 writeOffset;
 } VulkanUniformBuffer;
 
@@ -763,6 +895,21 @@ typedef struct DescriptorSetPool
     Uint32 inactiveDescriptorSetCapacity;
 } DescriptorSetPool;
 
+/* One per binding of the bindless descriptor set */
+typedef struct VulkanBindlessTable
+{
+    Uint32 maxCount; /* descriptor count of the binding */
+
+    /* VulkanTexture, VulkanSampler or VulkanBuffer, NULL if the slot is free */
+    void **resources;
+    Uint32 resourceCount;
+    Uint32 resourceCapacity;
+
+    Uint32 *freeIndices;
+    Uint32 freeIndexCount;
+    Uint32 freeIndexCapacity;
+} VulkanBindlessTable;
+
 typedef struct VulkanGraphicsPipelineResourceLayout
 {
     VkPipelineLayout pipelineLayout;
@@ -855,6 +1002,7 @@ typedef struct RenderPassHash
 typedef struct RenderPassHashMap
 {
     RenderPassHash key;
+    uint64_t hashcode;
     VkRenderPass value;
 } RenderPassHashMap;
 
@@ -865,6 +1013,13 @@ typedef struct RenderPassHashArray
     Sint32 capacity;
 } RenderPassHashArray;
 
+#define NUM_RENDER_PASS_BUCKETS 1031
+
+typedef struct RenderPassHashTable
+{
+    RenderPassHashArray buckets[NUM_RENDER_PASS_BUCKETS];
+} RenderPassHashTable;
+
 static inline Uint8 RenderPassHash_Compare(
     RenderPassHash *a,
     RenderPassHash *b)
@@ -923,31 +1078,66 @@ static inline Uint8 RenderPassHash_Compare(
     return 1;
 }
 
-static inline VkRenderPass RenderPassHashArray_Fetch(
-    RenderPassHashArray *arr,
-    RenderPassHash *key)
+static inline uint64_t RenderPassHashTable_GetHashCode(RenderPassHash *key)
+{
+    const uint64_t HASH_FACTOR = 97;
+    uint64_t result = 1;
+    Uint32 clearColorBits[4];
+    Uint32 i, j;
+
+    result = result * HASH_FACTOR + key->colorAttachmentCount;
+    result = result * HASH_FACTOR + key->colorAttachmentSampleCount;
+
+    for (i = 0; i < key->colorAttachmentCount; i += 1) {
+        SDL_memcpy(clearColorBits, &key->colorTargetDescriptions[i].clearColor, sizeof(clearColorBits));
+
+        result = result * HASH_FACTOR + key->colorTargetDescriptions[i].format;
+        result = result * HASH_FACTOR + key->colorTargetDescriptions[i].loadOp;
+        result = result * HASH_FACTOR + key->colorTargetDescriptions[i].storeOp;
+        for (j = 0; j < 4; j += 1) {
+            result = result * HASH_FACTOR + clearColorBits[j];
+        }
+    }
+
+    result = result * HASH_FACTOR + key->depthStencilTargetDescription.format;
+    result = result * HASH_FACTOR + key->depthStencilTargetDescription.loadOp;
+    result = result * HASH_FACTOR + key->depthStencilTargetDescription.storeOp;
+    result = result * HASH_FACTOR + key->depthStencilTargetDescription.stencilLoadOp;
+    result = result * HASH_FACTOR + key->depthStencilTargetDescription.stencilStoreOp;
+
+    return result;
+}
+
+static inline VkRenderPass RenderPassHashTable_Fetch(
+    RenderPassHashTable *table,
+    RenderPassHash *key,
+    uint64_t hashcode)
 {
     Sint32 i;
+    RenderPassHashArray *arr = &table->buckets[hashcode % NUM_RENDER_PASS_BUCKETS];
 
     for (i = 0; i < arr->count; i += 1) {
-        RenderPassHash *e = &arr->elements[i].key;
+        RenderPassHashMap *e = &arr->elements[i];
 
-        if (RenderPassHash_Compare(e, key)) {
-            return arr->elements[i].value;
+        if (e->hashcode == hashcode && RenderPassHash_Compare(&e->key, key)) {
+            return e->value;
         }
     }
 
     return VK_NULL_HANDLE;
 }
 
-static inline void RenderPassHashArray_Insert(
-    RenderPassHashArray *arr,
+static inline void RenderPassHashTable_Insert(
+    RenderPassHashTable *table,
     RenderPassHash key,
+    uint64_t hashcode,
     VkRenderPass value)
 {
+    RenderPassHashArray *arr = &table->buckets[hashcode % NUM_RENDER_PASS_BUCKETS];
     RenderPassHashMap map;
 
     map.key = key;
+    map.hashcode = hashcode;
     map.value = value;
 
     EXPAND_ELEMENTS_IF_NEEDED(arr, 4, RenderPassHashMap)
@@ -969,6 +1159,7 @@ typedef struct FramebufferHash
 typedef struct FramebufferHashMap
 {
     FramebufferHash key;
+    uint64_t hashcode;
     VulkanFramebuffer *value;
 } FramebufferHashMap;
 
@@ -979,6 +1170,13 @@ typedef struct FramebufferHashArray
     Sint32 capacity;
 } FramebufferHashArray;
 
+#define NUM_FRAMEBUFFER_BUCKETS 1031
+
+typedef struct FramebufferHashTable
+{
+    FramebufferHashArray buckets[NUM_FRAMEBUFFER_BUCKETS];
+} FramebufferHashTable;
+
 static inline Uint8 FramebufferHash_Compare(
     FramebufferHash *a,
     FramebufferHash *b)
@@ -1014,29 +1212,55 @@ static inline Uint8 FramebufferHash_Compare(
     return 1;
 }
 
-static inline VulkanFramebuffer *FramebufferHashArray_Fetch(
-    FramebufferHashArray *arr,
-    FramebufferHash *key)
+static inline uint64_t FramebufferHashTable_GetHashCode(FramebufferHash *key)
+{
+    const uint64_t HASH_FACTOR = 97;
+    uint64_t result = 1;
+    Uint32 i;
+
+    result = result * HASH_FACTOR + key->colorAttachmentCount;
+
+    for (i = 0; i < key->colorAttachmentCount; i += 1) {
+        result = result * HASH_FACTOR + (uint64_t)key->colorAttachmentViews[i];
+        result = result * HASH_FACTOR + (uint64_t)key->colorMultiSampleAttachmentViews[i];
+    }
+
+    result = result * HASH_FACTOR + (uint64_t)key->depthStencilAttachmentView;
+    result = result * HASH_FACTOR + key->width;
+    result = result * HASH_FACTOR + key->height;
+
+    return result;
+}
+
+static inline VulkanFramebuffer *FramebufferHashTable_Fetch(
+    FramebufferHashTable *table,
+    FramebufferHash *key,
+    uint64_t hashcode)
 {
     Sint32 i;
+    FramebufferHashArray *arr = &table->buckets[hashcode % NUM_FRAMEBUFFER_BUCKETS];
 
     for (i = 0; i < arr->count; i += 1) {
-        FramebufferHash *e = &arr->elements[i].key;
-        if (FramebufferHash_Compare(e, key)) {
-            return arr->elements[i].value;
+        FramebufferHashMap *e = &arr->elements[i];
+
+        if (e->hashcode == hashcode && FramebufferHash_Compare(&e->key, key)) {
+            return e->value;
         }
     }
 
-    return VK_NULL_HANDLE;
+    return NULL;
 }
 
-static inline void FramebufferHashArray_Insert(
-    FramebufferHashArray *arr,
+static inline void FramebufferHashTable_Insert(
+    FramebufferHashTable *table,
     FramebufferHash key,
+    uint64_t hashcode,
     VulkanFramebuffer *value)
 {
+    FramebufferHashArray *arr = &table->buckets[hashcode % NUM_FRAMEBUFFER_BUCKETS];
     FramebufferHashMap map;
     map.key = key;
+    map.hashcode = hashcode;
     map.value = value;
 
     EXPAND_ELEMENTS_IF_NEEDED(arr, 4, FramebufferHashMap)
@@ -1064,6 +1288,140 @@ typedef struct DescriptorSetData
     VkDescriptorSet descriptorSet;
 } DescriptorSetData;
 
+/* Descriptor sets written by a command buffer can be rebound for free
+ * until the command buffer is cleaned, so identical binding states
+ * within one command buffer share a single set.
+ */
+
+#define MAX_DESCRIPTOR_SET_CACHE_DESCRIPTORS \
+    (MAX_TEXTURE_SAMPLERS_PER_STAGE + MAX_STORAGE_TEXTURES_PER_STAGE + MAX_STORAGE_BUFFERS_PER_STAGE)
+
+typedef struct DescriptorSetCacheHash
+{
+    DescriptorSetPool *descriptorSetPool;
+    Uint32 descriptorCount;
+    VkSampler samplers[MAX_DESCRIPTOR_SET_CACHE_DESCRIPTORS];
+    VkImageView imageViews[MAX_DESCRIPTOR_SET_CACHE_DESCRIPTORS];
+    VkBuffer buffers[MAX_DESCRIPTOR_SET_CACHE_DESCRIPTORS];
+} DescriptorSetCacheHash;
+
+typedef struct DescriptorSetCacheHashMap
+{
+    DescriptorSetCacheHash key;
+    uint64_t hashcode;
+    VkDescriptorSet value;
+} DescriptorSetCacheHashMap;
+
+typedef struct DescriptorSetCacheHashArray
+{
+    DescriptorSetCacheHashMap *elements;
+    Sint32 count;
+    Sint32 capacity;
+} DescriptorSetCacheHashArray;
+
+#define NUM_DESCRIPTOR_SET_CACHE_BUCKETS 61
+
+typedef struct DescriptorSetCacheHashTable
+{
+    DescriptorSetCacheHashArray buckets[NUM_DESCRIPTOR_SET_CACHE_BUCKETS];
+} DescriptorSetCacheHashTable;
+
+static inline Uint8 DescriptorSetCacheHash_Compare(
+    DescriptorSetCacheHash *a,
+    DescriptorSetCacheHash *b)
+{
+    Uint32 i;
+
+    if (a->descriptorSetPool != b->descriptorSetPool) {
+        return 0;
+    }
+
+    if (a->descriptorCount != b->descriptorCount) {
+        return 0;
+    }
+
+    for (i = 0; i < a->descriptorCount; i += 1) {
+        if (a->samplers[i] != b->samplers[i]) {
+            return 0;
+        }
+
+        if (a->imageViews[i] != b->imageViews[i]) {
+            return 0;
+        }
+
+        if (a->buffers[i] != b->buffers[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static inline uint64_t DescriptorSetCacheHashTable_GetHashCode(DescriptorSetCacheHash *key)
+{
+    const uint64_t HASH_FACTOR = 97;
+    uint64_t result = 1;
+    Uint32 i;
+
+    result = result * HASH_FACTOR + (uint64_t)(size_t)key->descriptorSetPool;
+    result = result * HASH_FACTOR + key->descriptorCount;
+
+    for (i = 0; i < key->descriptorCount; i += 1) {
+        result = result * HASH_FACTOR + (uint64_t)key->samplers[i];
+        result = result * HASH_FACTOR + (uint64_t)key->imageViews[i];
+        result = result * HASH_FACTOR + (uint64_t)key->buffers[i];
+    }
+
+    return result;
+}
+
+static inline VkDescriptorSet DescriptorSetCacheHashTable_Fetch(
+    DescriptorSetCacheHashTable *table,
+    DescriptorSetCacheHash *key,
+    uint64_t hashcode)
+{
+    Sint32 i;
+    DescriptorSetCacheHashArray *arr = &table->buckets[hashcode % NUM_DESCRIPTOR_SET_CACHE_BUCKETS];
+
+    for (i = 0; i < arr->count; i += 1) {
+        DescriptorSetCacheHashMap *e = &arr->elements[i];
+
+        if (e->hashcode == hashcode && DescriptorSetCacheHash_Compare(&e->key, key)) {
+            return e->value;
+        }
+    }
+
+    return VK_NULL_HANDLE;
+}
+
+static inline void DescriptorSetCacheHashTable_Insert(
+    DescriptorSetCacheHashTable *table,
+    DescriptorSetCacheHash *key,
+    uint64_t hashcode,
+    VkDescriptorSet value)
+{
+    DescriptorSetCacheHashArray *arr = &table->buckets[hashcode % NUM_DESCRIPTOR_SET_CACHE_BUCKETS];
+    DescriptorSetCacheHashMap *map;
+
+    EXPAND_ELEMENTS_IF_NEEDED(arr, 4, DescriptorSetCacheHashMap)
+
+    map = &arr->elements[arr->count];
+    SDL_memcpy(&map->key, key, sizeof(DescriptorSetCacheHash));
+    map->hashcode = hashcode;
+    map->value = value;
+    arr->count += 1;
+}
+
+static inline void DescriptorSetCacheHashTable_Clear(
+    DescriptorSetCacheHashTable *table)
+{
+    Uint32 i;
+
+    for (i = 0; i < NUM_DESCRIPTOR_SET_CACHE_BUCKETS; i += 1) {
+        table->buckets[i].count = 0;
+    }
+}
+
 typedef struct VulkanFencePool
 {
     SDL_mutex *lock;
@@ -1073,16 +1431,42 @@ typedef struct VulkanFencePool
     Uint32 availableFenceCapacity;
 } VulkanFencePool;
 
+typedef struct VulkanQueue
+{
+    VkQueue queue;
+    Uint32 queueFamilyIndex;
+    VkQueueFlags queueFlags;
+    Uint32 timestampValidBits;
+    VkSemaphore timelineSemaphore; /* Signaled with each submission's serial, VK_NULL_HANDLE without timeline semaphores */
+
+    /* Cross-queue ordering, every submission waits on the work previously submitted to the other queues */
+    Uint64 lastSubmissionValue; /* Timeline value signaled by the most recent submission */
+    Uint64 lastBindlessValue;   /* Most recent submission that bound the bindless set, whose accesses aren't tracked */
+    Uint64 waitedValues[3];     /* Latest value of each queue's timeline this queue has waited on */
+
+    /* Without timeline semaphores, binary semaphores signaled by the other queues for this one to wait on */
+    VkSemaphore *pendingWaitSemaphores;
+    Uint32 pendingWaitSemaphoreCount;
+    Uint32 pendingWaitSemaphoreCapacity;
+} VulkanQueue;
+
 typedef struct VulkanCommandPool VulkanCommandPool;
 
 typedef struct VulkanRenderer VulkanRenderer;
 
+typedef struct VulkanBarrierStages
+{
+    VkPipelineStageFlags srcStages;
+    VkPipelineStageFlags dstStages;
+} VulkanBarrierStages;
+
 typedef struct VulkanCommandBuffer
 {
     CommandBufferCommonHeader common;
     VulkanRenderer *renderer;
 
     VkCommandBuffer commandBuffer;
+    VkCommandBufferLevel level;
     VulkanCommandPool *commandPool;
 
     VulkanPresentData *presentDatas;
@@ -1097,9 +1481,30 @@ typedef struct VulkanCommandBuffer
     Uint32 signalSemaphoreCount;
     Uint32 signalSemaphoreCapacity;
 
+    /* Async queue semaphores waited on by this submission, recycled on cleanup */
+    VkSemaphore *asyncWaitSemaphores;
+    Uint32 asyncWaitSemaphoreCount;
+    Uint32 asyncWaitSemaphoreCapacity;
+
     VulkanComputePipeline *currentComputePipeline;
     VulkanGraphicsPipeline *currentGraphicsPipeline;
 
+    /* Barriers queued until the next command, see VULKAN_INTERNAL_FlushBarriers */
+
+    VkBufferMemoryBarrier *pendingBufferBarriers;
+    VulkanBarrierStages *pendingBufferBarrierStages;
+    Uint32 pendingBufferBarrierCount;
+    Uint32 pendingBufferBarrierCapacity;
+
+    VkImageMemoryBarrier *pendingImageBarriers;
+    VulkanBarrierStages *pendingImageBarrierStages;
+    Uint32 pendingImageBarrierCount;
+    Uint32 pendingImageBarrierCapacity;
+
+    Uint32 barrierCount;
+    Uint32 barrierBatchCount;
+    Uint32 eliminatedBarrierCount;
+
     /* Keep track of resources transitioned away from their default state to barrier them on pass end */
 
     VulkanTextureSlice *colorAttachmentSlices[MAX_COLOR_TARGET_BINDINGS];
@@ -1107,6 +1512,17 @@ typedef struct VulkanCommandBuffer
 
     VulkanTextureSlice *depthStencilAttachmentSlice; /* may be NULL */
 
+    /* Parallel render passes record into secondary command buffers */
+
+    VkRenderPass currentRenderPass;
+    VkFramebuffer currentFramebuffer;
+    SDL_bool parallelRenderPass;
+
+    struct VulkanCommandBuffer **renderPassChunks; /* Cleaned along with this command buffer */
+    Uint32 renderPassChunkCount;
+    Uint32 renderPassChunkCapacity;
+    Uint32 firstRenderPassChunk; /* The first chunk of the current render pass */
+
     /* Viewport/scissor state */
 
     VkViewport currentViewport;
@@ -1139,6 +1555,10 @@ typedef struct VulkanCommandBuffer
     Uint32 boundDescriptorSetDataCount;
     Uint32 boundDescriptorSetDataCapacity;
 
+    DescriptorSetCacheHashTable descriptorSetCache;
+    Uint32 descriptorSetWriteCount;
+    Uint32 descriptorSetReuseCount;
+
     VulkanTexture *vertexSamplerTextures[MAX_TEXTURE_SAMPLERS_PER_STAGE];
     VulkanSampler *vertexSamplers[MAX_TEXTURE_SAMPLERS_PER_STAGE];
     VulkanTextureSlice *vertexStorageTextureSlices[MAX_STORAGE_TEXTURES_PER_STAGE];
@@ -1157,10 +1577,17 @@ typedef struct VulkanCommandBuffer
 
     /* Uniform buffers */
 
+    /* Every stage and slot sub-allocates from the current uniform buffer */
+    VulkanUniformBuffer *currentUniformBuffer;
+
     VulkanUniformBuffer *vertexUniformBuffers[MAX_UNIFORM_BUFFERS_PER_STAGE];
     VulkanUniformBuffer *fragmentUniformBuffers[MAX_UNIFORM_BUFFERS_PER_STAGE];
     VulkanUniformBuffer *computeUniformBuffers[MAX_UNIFORM_BUFFERS_PER_STAGE];
 
+    Uint32 vertexUniformDrawOffsets[MAX_UNIFORM_BUFFERS_PER_STAGE];
+    Uint32 fragmentUniformDrawOffsets[MAX_UNIFORM_BUFFERS_PER_STAGE];
+    Uint32 computeUniformDrawOffsets[MAX_UNIFORM_BUFFERS_PER_STAGE];
+
     /* Track used resources */
 
     VulkanBuffer **usedBuffers;
@@ -1191,20 +1618,139 @@ typedef struct VulkanCommandBuffer
     Uint32 usedUniformBufferCount;
     Uint32 usedUniformBufferCapacity;
 
+    /* Staging memory is linearly allocated from the current block */
+    VulkanBufferContainer *currentStagingBlock;
+    Uint32 stagingBlockOffset;
+
+    VulkanBufferContainer **usedStagingBlocks;
+    Uint32 usedStagingBlockCount;
+    Uint32 usedStagingBlockCapacity;
+
+    VulkanQueryPool **usedQueryPools;
+    Uint32 usedQueryPoolCount;
+    Uint32 usedQueryPoolCapacity;
+
     VulkanFenceHandle *inFlightFence;
     Uint8 autoReleaseFence;
+    Uint64 submissionSerial; /* Assigned under disposeLock on submit */
 
     Uint8 isDefrag; /* Whether this CB was created for defragging */
+    Uint8 boundBindlessSet; /* Bindless accesses aren't tracked per resource */
 } VulkanCommandBuffer;
 
+/* Descriptor sets a command pool has taken from a pipeline's descriptor set pool.
+ * Only the command pool's own thread fetches from these, so the lock guarding them
+ * is only ever contended by the cleanup of that pool's command buffers.
+ */
+typedef struct CommandPoolDescriptorSets
+{
+    DescriptorSetPool *descriptorSetPool;
+
+    VkDescriptorSet *inactiveDescriptorSets;
+    Uint32 inactiveDescriptorSetCount;
+    Uint32 inactiveDescriptorSetCapacity;
+} CommandPoolDescriptorSets;
+
+typedef struct CommandPoolDescriptorSetsArray
+{
+    CommandPoolDescriptorSets *elements;
+    Sint32 count;
+    Sint32 capacity;
+} CommandPoolDescriptorSetsArray;
+
+#define NUM_COMMAND_POOL_DESCRIPTOR_SET_BUCKETS 61
+
+typedef struct CommandPoolDescriptorSetsTable
+{
+    CommandPoolDescriptorSetsArray buckets[NUM_COMMAND_POOL_DESCRIPTOR_SET_BUCKETS];
+} CommandPoolDescriptorSetsTable;
+
+static inline CommandPoolDescriptorSetsArray *CommandPoolDescriptorSetsTable_GetBucket(
+    CommandPoolDescriptorSetsTable *table,
+    DescriptorSetPool *descriptorSetPool)
+{
+    const uint64_t HASH_FACTOR = 97;
+    uint64_t hashcode = 1;
+
+    hashcode = hashcode * HASH_FACTOR + (uint64_t)(size_t)descriptorSetPool;
+
+    return &table->buckets[hashcode % NUM_COMMAND_POOL_DESCRIPTOR_SET_BUCKETS];
+}
+
+static inline CommandPoolDescriptorSets *CommandPoolDescriptorSetsTable_Fetch(
+    CommandPoolDescriptorSetsTable *table,
+    DescriptorSetPool *descriptorSetPool)
+{
+    Sint32 i;
+    CommandPoolDescriptorSetsArray *arr = CommandPoolDescriptorSetsTable_GetBucket(table, descriptorSetPool);
+
+    for (i = 0; i < arr->count; i += 1) {
+        if (arr->elements[i].descriptorSetPool == descriptorSetPool) {
+            return &arr->elements[i];
+        }
+    }
+
+    return NULL;
+}
+
+static inline CommandPoolDescriptorSets *CommandPoolDescriptorSetsTable_Insert(
+    CommandPoolDescriptorSetsTable *table,
+    DescriptorSetPool *descriptorSetPool)
+{
+    CommandPoolDescriptorSetsArray *arr = CommandPoolDescriptorSetsTable_GetBucket(table, descriptorSetPool);
+    CommandPoolDescriptorSets *descriptorSets;
+
+    EXPAND_ELEMENTS_IF_NEEDED(arr, 4, CommandPoolDescriptorSets)
+
+    descriptorSets = &arr->elements[arr->count];
+    descriptorSets->descriptorSetPool = descriptorSetPool;
+    descriptorSets->inactiveDescriptorSetCapacity = DESCRIPTOR_SET_BATCH_SIZE;
+    descriptorSets->inactiveDescriptorSetCount = 0;
+    descriptorSets->inactiveDescriptorSets = SDL_malloc(
+        descriptorSets->inactiveDescriptorSetCapacity * sizeof(VkDescriptorSet));
+    arr->count += 1;
+
+    return descriptorSets;
+}
+
+/* The sets themselves are freed along with the descriptor set pool */
+static inline void CommandPoolDescriptorSetsTable_Remove(
+    CommandPoolDescriptorSetsTable *table,
+    DescriptorSetPool *descriptorSetPool)
+{
+    Sint32 i;
+    CommandPoolDescriptorSetsArray *arr = CommandPoolDescriptorSetsTable_GetBucket(table, descriptorSetPool);
+
+    for (i = 0; i < arr->count; i += 1) {
+        if (arr->elements[i].descriptorSetPool == descriptorSetPool) {
+            SDL_free(arr->elements[i].inactiveDescriptorSets);
+
+            if (i != arr->count - 1) {
+                arr->elements[i] = arr->elements[arr->count - 1];
+            }
+
+            arr->count -= 1;
+            return;
+        }
+    }
+}
+
 struct VulkanCommandPool
 {
     SDL_threadID threadID;
+    VulkanQueue *queue;
     VkCommandPool commandPool;
 
     VulkanCommandBuffer **inactiveCommandBuffers;
     Uint32 inactiveCommandBufferCapacity;
     Uint32 inactiveCommandBufferCount;
+
+    VulkanCommandBuffer **inactiveSecondaryCommandBuffers;
+    Uint32 inactiveSecondaryCommandBufferCapacity;
+    Uint32 inactiveSecondaryCommandBufferCount;
+
+    SDL_mutex *descriptorSetLock;
+    CommandPoolDescriptorSetsTable descriptorSetTable;
 };
 
 #define NUM_COMMAND_POOL_BUCKETS 1031
@@ -1212,6 +1758,7 @@ struct VulkanCommandPool
 typedef struct CommandPoolHash
 {
     SDL_threadID threadID;
+    Refresh_QueueType queueType;
 } CommandPoolHash;
 
 typedef struct CommandPoolHashMap
@@ -1237,6 +1784,7 @@ static inline uint64_t CommandPoolHashTable_GetHashCode(CommandPoolHash key)
     const uint64_t HASH_FACTOR = 97;
     uint64_t result = 1;
     result = result * HASH_FACTOR + (uint64_t)key.threadID;
+    result = result * HASH_FACTOR + (uint64_t)key.queueType;
     return result;
 }
 
@@ -1250,7 +1798,7 @@ static inline VulkanCommandPool *CommandPoolHashTable_Fetch(
 
     for (i = 0; i < arr->count; i += 1) {
         const CommandPoolHash *e = &arr->elements[i].key;
-        if (key.threadID == e->threadID) {
+        if (key.threadID == e->threadID && key.queueType == e->queueType) {
             return arr->elements[i].value;
         }
     }
@@ -1284,6 +1832,7 @@ struct VulkanRenderer
     VkPhysicalDevice physicalDevice;
     VkPhysicalDeviceProperties2 physicalDeviceProperties;
     VkPhysicalDeviceDriverPropertiesKHR physicalDeviceDriverProperties;
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT physicalDeviceDescriptorIndexingProperties;
     VkDevice logicalDevice;
     Uint8 integratedMemoryNotification;
     Uint8 outOfDeviceLocalMemoryWarning;
@@ -1297,6 +1846,9 @@ struct VulkanRenderer
     SDL_bool supportsColorspace;
     SDL_bool supportsFillModeNonSolid;
     SDL_bool supportsMultiDrawIndirect;
+    SDL_bool supportsIndirectCount;
+    SDL_bool supportsBindless;
+    SDL_bool supportsTimelineSemaphore;
 
     VulkanMemoryAllocator *memoryAllocator;
     VkPhysicalDeviceMemoryProperties memoryProperties;
@@ -1308,6 +1860,15 @@ struct VulkanRenderer
     Uint32 queueFamilyIndex;
     VkQueue unifiedQueue;
 
+    /* Indexed by Refresh_QueueType. Async queues alias the unified queue when the device has no dedicated family. */
+    VulkanQueue queues[3];
+    Uint32 uniqueQueueFamilyIndices[3];
+    Uint32 uniqueQueueFamilyCount;
+
+    VkSemaphore *availableSemaphores;
+    Uint32 availableSemaphoreCount;
+    Uint32 availableSemaphoreCapacity;
+
     VulkanCommandBuffer **submittedCommandBuffers;
     Uint32 submittedCommandBufferCount;
     Uint32 submittedCommandBufferCapacity;
@@ -1315,58 +1876,104 @@ struct VulkanRenderer
     VulkanFencePool fencePool;
 
     CommandPoolHashTable commandPoolHashTable;
-    RenderPassHashArray renderPassHashArray;
-    FramebufferHashArray framebufferHashArray;
+    RenderPassHashTable renderPassHashTable;
+    FramebufferHashTable framebufferHashTable;
+
+    VkPipelineCache pipelineCache;
+
+    /* Bound after the regular resource sets, indexed by Refresh_BindlessResourceType */
+    VkDescriptorSetLayout bindlessDescriptorSetLayout;
+    VkDescriptorPool bindlessDescriptorPool;
+    VkDescriptorSet bindlessDescriptorSet;
+    VulkanBindlessTable bindlessTables[3];
 
     VulkanUniformBuffer **uniformBufferPool;
     Uint32 uniformBufferPoolCount;
     Uint32 uniformBufferPoolCapacity;
 
+    /* Compute downsampling pipelines, created on first use under mipmapPipelineLock.
+     * Indexed by MipmapDownsampleFormats and the number of levels written per dispatch.
+     */
+    VulkanComputePipeline *mipmapPipelines[MIPMAP_FORMAT_COUNT][MIPMAP_LEVELS_PER_DISPATCH];
+    Uint8 mipmapPipelineFailed[MIPMAP_FORMAT_COUNT][MIPMAP_LEVELS_PER_DISPATCH];
+
+    /* Persistently mapped STAGING_BLOCK_SIZE transfer buffers */
+    VulkanBufferContainer **stagingBlockPool;
+    Uint32 stagingBlockPoolCount;
+    Uint32 stagingBlockPoolCapacity;
+
     Uint32 minUBOAlignment;
 
     /* Some drivers don't support D16 for some reason. Fun! */
     VkFormat D16Format;
     VkFormat D16S8Format;
 
-    /* Deferred resource destruction */
+    /* Deferred resource destruction.
+     * Entries are appended in release order, so their submission serials never decrease.
+     * Cleanup only has to look at the front of the queue, up to the first entry that
+     * a still-executing command buffer may reference.
+     */
+
+    VulkanDeferredDestroy *deferredDestroys;
+    Uint32 deferredDestroyCount;
+    Uint32 deferredDestroyCapacity;
+
+    Uint64 submissionSerial;
+
+    /* Statistics, accumulated from cleaned command buffers under submitLock */
 
-    VulkanTexture **texturesToDestroy;
-    Uint32 texturesToDestroyCount;
-    Uint32 texturesToDestroyCapacity;
+    Uint64 descriptorSetsWritten;
+    Uint64 descriptorSetsReused;
+    Uint64 barriersRecorded;
+    Uint64 barrierBatchesRecorded;
+    Uint64 barriersEliminated;
 
-    VulkanBuffer **buffersToDestroy;
-    Uint32 buffersToDestroyCount;
-    Uint32 buffersToDestroyCapacity;
+    /* Defrag statistics, accumulated under allocatorLock */
 
-    VulkanSampler **samplersToDestroy;
-    Uint32 samplersToDestroyCount;
-    Uint32 samplersToDestroyCapacity;
+    Uint64 defragBytesFragmented;
+    Uint64 defragBytesMoved;
+    Uint64 defragBytesReclaimed;
 
-    VulkanGraphicsPipeline **graphicsPipelinesToDestroy;
-    Uint32 graphicsPipelinesToDestroyCount;
-    Uint32 graphicsPipelinesToDestroyCapacity;
+    /* Containers holding more than one handle, trimmed under cycleLock */
 
-    VulkanComputePipeline **computePipelinesToDestroy;
-    Uint32 computePipelinesToDestroyCount;
-    Uint32 computePipelinesToDestroyCapacity;
+    VulkanBufferContainer **cycledBufferContainers;
+    Uint32 cycledBufferContainerCount;
+    Uint32 cycledBufferContainerCapacity;
 
-    VulkanShader **shadersToDestroy;
-    Uint32 shadersToDestroyCount;
-    Uint32 shadersToDestroyCapacity;
+    VulkanTextureContainer **cycledTextureContainers;
+    Uint32 cycledTextureContainerCount;
+    Uint32 cycledTextureContainerCapacity;
 
-    VulkanFramebuffer **framebuffersToDestroy;
-    Uint32 framebuffersToDestroyCount;
-    Uint32 framebuffersToDestroyCapacity;
+    Uint64 presentedFrameCount;
+    Uint32 cycleTrimFrames;
+
+    Uint64 cycleHandlesCreated;
+    Uint64 cycleHandlesTrimmed;
+    Uint64 cycleLimitHits;
 
     SDL_mutex *allocatorLock;
     SDL_mutex *disposeLock;
     SDL_mutex *submitLock;
     SDL_mutex *acquireCommandBufferLock;
     SDL_mutex *acquireUniformBufferLock;
+    SDL_mutex *acquireStagingBlockLock;
     SDL_mutex *renderPassFetchLock;
     SDL_mutex *framebufferFetchLock;
+    SDL_mutex *bindlessLock;
+    SDL_mutex *cycleLock;
+    SDL_mutex *mipmapPipelineLock;
+    SDL_mutex *fenceWakeLock;
+
+    /* Fence callback waiter wakes. The semaphore is host-signaled with fenceWakeValue, VK_NULL_HANDLE without timeline semaphores. */
+    VkSemaphore fenceWakeSemaphore;
+    Uint64 fenceWakeValue;    /* Guarded by fenceWakeLock */
+    Uint64 fenceWakeConsumed; /* Only touched by the waiter */
 
     Uint8 defragInProgress;
+    Uint8 defragRequested;
+    Uint8 defragAutomatic;
+    VkDeviceSize defragMaxBytesPerFrame;
+    Uint32 defragMaxMicrosecondsPerFrame;
 
     VulkanMemoryAllocation **allocationsToDefrag;
     Uint32 allocationsToDefragCount;
@@ -1388,6 +1995,7 @@ static void VULKAN_Wait(Refresh_Renderer *driverData);
 static void VULKAN_WaitForFences(Refresh_Renderer *driverData, SDL_bool waitAll, Refresh_Fence **pFences, Uint32 fenceCount);
 static void VULKAN_Submit(Refresh_CommandBuffer *commandBuffer);
 static VulkanTextureSlice *VULKAN_INTERNAL_FetchTextureSlice(VulkanTexture *texture, Uint32 layer, Uint32 level);
+static void VULKAN_INTERNAL_FreeBindlessIndex(VulkanRenderer *renderer, Refresh_BindlessResourceType resourceType, Uint32 index);
 static VulkanTexture *VULKAN_INTERNAL_CreateTexture(
     VulkanRenderer *renderer,
     Uint32 width,
@@ -1519,34 +2127,188 @@ static inline Uint32 VULKAN_INTERNAL_NextHighestAlignment32(
     return align * ((n + align - 1) / align);
 }
 
-static void VULKAN_INTERNAL_MakeMemoryUnavailable(
-    VulkanRenderer *renderer,
-    VulkanMemoryAllocation *allocation)
+static inline Uint32 VULKAN_INTERNAL_HighestBitIndex(Uint64 n)
 {
-    Uint32 i, j;
-    VulkanMemoryFreeRegion *freeRegion;
-
-    allocation->availableForAllocation = 0;
+    Uint32 result = 0;
 
-    for (i = 0; i < allocation->freeRegionCount; i += 1) {
-        freeRegion = allocation->freeRegions[i];
+    while (n >>= 1) {
+        result += 1;
+    }
 
-        /* close the gap in the sorted list */
-        if (allocation->allocator->sortedFreeRegionCount > 1) {
-            for (j = freeRegion->sortedIndex; j < allocation->allocator->sortedFreeRegionCount - 1; j += 1) {
-                allocation->allocator->sortedFreeRegions[j] =
-                    allocation->allocator->sortedFreeRegions[j + 1];
+    return result;
+}
 
-                allocation->allocator->sortedFreeRegions[j]->sortedIndex = j;
-            }
-        }
+static inline Uint32 VULKAN_INTERNAL_LowestBitIndex(Uint64 n)
+{
+    Uint32 result = 0;
 
-        allocation->allocator->sortedFreeRegionCount -= 1;
+    while ((n & 1) == 0) {
+        n >>= 1;
+        result += 1;
     }
+
+    return result;
 }
 
-static void VULKAN_INTERNAL_MarkAllocationsForDefrag(
-    VulkanRenderer *renderer)
+static inline void VULKAN_INTERNAL_GetSizeClass(
+    VkDeviceSize size,
+    Uint32 *firstLevel,
+    Uint32 *secondLevel)
+{
+    *firstLevel = VULKAN_INTERNAL_HighestBitIndex(size);
+
+    if (*firstLevel < FREE_REGION_SECOND_LEVEL_LOG2) {
+        *secondLevel = 0;
+    } else {
+        *secondLevel =
+            (Uint32)(size >> (*firstLevel - FREE_REGION_SECOND_LEVEL_LOG2)) &
+            (FREE_REGION_SECOND_LEVEL_COUNT - 1);
+    }
+}
+
+static inline VulkanMemorySizeClassIndex *VULKAN_INTERNAL_GetSizeClassIndex(
+    VulkanMemoryAllocation *allocation)
+{
+    return &allocation->allocator->freeRegionIndices[allocation->size == SMALL_ALLOCATION_SIZE];
+}
+
+static void VULKAN_INTERNAL_InsertFreeRegionSizeClass(
+    VulkanMemoryFreeRegion *freeRegion)
+{
+    VulkanMemorySizeClassIndex *index = VULKAN_INTERNAL_GetSizeClassIndex(freeRegion->allocation);
+    Uint32 firstLevel, secondLevel;
+
+    VULKAN_INTERNAL_GetSizeClass(freeRegion->size, &firstLevel, &secondLevel);
+
+    freeRegion->prevInSizeClass = NULL;
+    freeRegion->nextInSizeClass = index->heads[firstLevel][secondLevel];
+
+    if (freeRegion->nextInSizeClass != NULL) {
+        freeRegion->nextInSizeClass->prevInSizeClass = freeRegion;
+    }
+
+    index->heads[firstLevel][secondLevel] = freeRegion;
+    index->firstLevelBitmap |= (Uint64)1 << firstLevel;
+    index->secondLevelBitmaps[firstLevel] |= 1 << secondLevel;
+}
+
+static void VULKAN_INTERNAL_RemoveFreeRegionSizeClass(
+    VulkanMemoryFreeRegion *freeRegion)
+{
+    VulkanMemorySizeClassIndex *index = VULKAN_INTERNAL_GetSizeClassIndex(freeRegion->allocation);
+    Uint32 firstLevel, secondLevel;
+
+    VULKAN_INTERNAL_GetSizeClass(freeRegion->size, &firstLevel, &secondLevel);
+
+    if (freeRegion->prevInSizeClass != NULL) {
+        freeRegion->prevInSizeClass->nextInSizeClass = freeRegion->nextInSizeClass;
+    } else {
+        index->heads[firstLevel][secondLevel] = freeRegion->nextInSizeClass;
+    }
+
+    if (freeRegion->nextInSizeClass != NULL) {
+        freeRegion->nextInSizeClass->prevInSizeClass = freeRegion->prevInSizeClass;
+    }
+
+    if (index->heads[firstLevel][secondLevel] == NULL) {
+        index->secondLevelBitmaps[firstLevel] &= ~(1 << secondLevel);
+
+        if (index->secondLevelBitmaps[firstLevel] == 0) {
+            index->firstLevelBitmap &= ~((Uint64)1 << firstLevel);
+        }
+    }
+
+    freeRegion->prevInSizeClass = NULL;
+    freeRegion->nextInSizeClass = NULL;
+}
+
+/* Returns the first region that fits, starting from the request's size class.
+ * Regions in the starting bucket may still be too small, so every candidate is checked.
+ */
+static VulkanMemoryFreeRegion *VULKAN_INTERNAL_FindFreeRegion(
+    VulkanMemorySizeClassIndex *index,
+    VkDeviceSize requiredSize,
+    VkDeviceSize alignment,
+    VkDeviceSize *pAlignedOffset)
+{
+    VulkanMemoryFreeRegion *region;
+    VkDeviceSize alignedOffset;
+    Uint64 firstLevelMask;
+    Uint32 secondLevelMask;
+    Uint32 firstLevel, secondLevel;
+
+    VULKAN_INTERNAL_GetSizeClass(requiredSize, &firstLevel, &secondLevel);
+
+    secondLevelMask = index->secondLevelBitmaps[firstLevel] & (0xFF << secondLevel);
+    firstLevelMask = index->firstLevelBitmap & ~(((Uint64)2 << firstLevel) - 1);
+
+    for (;;) {
+        while (secondLevelMask != 0) {
+            secondLevel = VULKAN_INTERNAL_LowestBitIndex(secondLevelMask);
+
+            for (region = index->heads[firstLevel][secondLevel]; region != NULL; region = region->nextInSizeClass) {
+                alignedOffset = VULKAN_INTERNAL_NextHighestAlignment(
+                    region->offset,
+                    alignment);
+
+                if (alignedOffset + requiredSize <= region->offset + region->size) {
+                    *pAlignedOffset = alignedOffset;
+                    return region;
+                }
+            }
+
+            secondLevelMask &= ~(1 << secondLevel);
+        }
+
+        if (firstLevelMask == 0) {
+            return NULL;
+        }
+
+        firstLevel = VULKAN_INTERNAL_LowestBitIndex(firstLevelMask);
+        firstLevelMask &= ~((Uint64)1 << firstLevel);
+        secondLevelMask = index->secondLevelBitmaps[firstLevel];
+    }
+}
+
+static void VULKAN_INTERNAL_MakeMemoryUnavailable(
+    VulkanRenderer *renderer,
+    VulkanMemoryAllocation *allocation)
+{
+    Uint32 i;
+
+    allocation->availableForAllocation = 0;
+
+    for (i = 0; i < allocation->freeRegionCount; i += 1) {
+        VULKAN_INTERNAL_RemoveFreeRegionSizeClass(allocation->freeRegions[i]);
+    }
+}
+
+/* Bindless descriptors cannot be safely rewritten while in flight,
+ * so memory backing registered resources is never moved.
+ */
+static SDL_bool VULKAN_INTERNAL_AllocationHasBindlessResource(
+    VulkanMemoryAllocation *allocation)
+{
+    VulkanMemoryUsedRegion *usedRegion;
+    Uint32 i;
+
+    for (i = 0; i < allocation->usedRegionCount; i += 1) {
+        usedRegion = allocation->usedRegions[i];
+
+        if (usedRegion->isBuffer) {
+            if (usedRegion->vulkanBuffer->bindlessIndex != BINDLESS_INVALID_INDEX) {
+                return SDL_TRUE;
+            }
+        } else if (usedRegion->vulkanTexture->bindlessIndex != BINDLESS_INVALID_INDEX) {
+            return SDL_TRUE;
+        }
+    }
+
+    return SDL_FALSE;
+}
+
+static void VULKAN_INTERNAL_MarkAllocationsForDefrag(
+    VulkanRenderer *renderer)
 {
     Uint32 memoryType, allocationIndex;
     VulkanMemorySubAllocator *currentAllocator;
@@ -1554,9 +2316,13 @@ static void VULKAN_INTERNAL_MarkAllocationsForDefrag(
     for (memoryType = 0; memoryType < VK_MAX_MEMORY_TYPES; memoryType += 1) {
         currentAllocator = &renderer->memoryAllocator->subAllocators[memoryType];
 
+        SDL_LockMutex(currentAllocator->lock);
+
         for (allocationIndex = 0; allocationIndex < currentAllocator->allocationCount; allocationIndex += 1) {
             if (currentAllocator->allocations[allocationIndex]->availableForAllocation == 1) {
-                if (currentAllocator->allocations[allocationIndex]->freeRegionCount > 1) {
+                if (
+                    currentAllocator->allocations[allocationIndex]->freeRegionCount > 1 &&
+                    !VULKAN_INTERNAL_AllocationHasBindlessResource(currentAllocator->allocations[allocationIndex])) {
                     EXPAND_ARRAY_IF_NEEDED(
                         renderer->allocationsToDefrag,
                         VulkanMemoryAllocation *,
@@ -1569,12 +2335,17 @@ static void VULKAN_INTERNAL_MarkAllocationsForDefrag(
 
                     renderer->allocationsToDefragCount += 1;
 
+                    currentAllocator->allocations[allocationIndex]->markedForDefrag = 1;
+                    renderer->defragBytesFragmented += currentAllocator->allocations[allocationIndex]->freeSpace;
+
                     VULKAN_INTERNAL_MakeMemoryUnavailable(
                         renderer,
                         currentAllocator->allocations[allocationIndex]);
                 }
             }
         }
+
+        SDL_UnlockMutex(currentAllocator->lock);
     }
 }
 
@@ -1582,22 +2353,12 @@ static void VULKAN_INTERNAL_RemoveMemoryFreeRegion(
     VulkanRenderer *renderer,
     VulkanMemoryFreeRegion *freeRegion)
 {
-    Uint32 i;
+    VulkanMemorySubAllocator *allocator = freeRegion->allocation->allocator;
 
-    SDL_LockMutex(renderer->allocatorLock);
+    SDL_LockMutex(allocator->lock);
 
     if (freeRegion->allocation->availableForAllocation) {
-        /* close the gap in the sorted list */
-        if (freeRegion->allocation->allocator->sortedFreeRegionCount > 1) {
-            for (i = freeRegion->sortedIndex; i < freeRegion->allocation->allocator->sortedFreeRegionCount - 1; i += 1) {
-                freeRegion->allocation->allocator->sortedFreeRegions[i] =
-                    freeRegion->allocation->allocator->sortedFreeRegions[i + 1];
-
-                freeRegion->allocation->allocator->sortedFreeRegions[i]->sortedIndex = i;
-            }
-        }
-
-        freeRegion->allocation->allocator->sortedFreeRegionCount -= 1;
+        VULKAN_INTERNAL_RemoveFreeRegionSizeClass(freeRegion);
     }
 
     /* close the gap in the buffer list */
@@ -1615,7 +2376,7 @@ static void VULKAN_INTERNAL_RemoveMemoryFreeRegion(
 
     SDL_free(freeRegion);
 
-    SDL_UnlockMutex(renderer->allocatorLock);
+    SDL_UnlockMutex(allocator->lock);
 }
 
 static void VULKAN_INTERNAL_NewMemoryFreeRegion(
@@ -1626,10 +2387,9 @@ static void VULKAN_INTERNAL_NewMemoryFreeRegion(
 {
     VulkanMemoryFreeRegion *newFreeRegion;
     VkDeviceSize newOffset, newSize;
-    Sint32 insertionIndex = 0;
     Sint32 i;
 
-    SDL_LockMutex(renderer->allocatorLock);
+    SDL_LockMutex(allocation->allocator->lock);
 
     /* look for an adjacent region to merge */
     for (i = allocation->freeRegionCount - 1; i >= 0; i -= 1) {
@@ -1641,7 +2401,7 @@ static void VULKAN_INTERNAL_NewMemoryFreeRegion(
             VULKAN_INTERNAL_RemoveMemoryFreeRegion(renderer, allocation->freeRegions[i]);
             VULKAN_INTERNAL_NewMemoryFreeRegion(renderer, allocation, newOffset, newSize);
 
-            SDL_UnlockMutex(renderer->allocatorLock);
+            SDL_UnlockMutex(allocation->allocator->lock);
             return;
         }
 
@@ -1653,7 +2413,7 @@ static void VULKAN_INTERNAL_NewMemoryFreeRegion(
             VULKAN_INTERNAL_RemoveMemoryFreeRegion(renderer, allocation->freeRegions[i]);
             VULKAN_INTERNAL_NewMemoryFreeRegion(renderer, allocation, newOffset, newSize);
 
-            SDL_UnlockMutex(renderer->allocatorLock);
+            SDL_UnlockMutex(allocation->allocator->lock);
             return;
         }
     }
@@ -1677,37 +2437,14 @@ static void VULKAN_INTERNAL_NewMemoryFreeRegion(
     allocation->freeRegions[allocation->freeRegionCount - 1] = newFreeRegion;
     newFreeRegion->allocationIndex = allocation->freeRegionCount - 1;
 
-    if (allocation->availableForAllocation) {
-        for (i = 0; i < allocation->allocator->sortedFreeRegionCount; i += 1) {
-            if (allocation->allocator->sortedFreeRegions[i]->size < size) {
-                /* this is where the new region should go */
-                break;
-            }
-
-            insertionIndex += 1;
-        }
-
-        if (allocation->allocator->sortedFreeRegionCount + 1 > allocation->allocator->sortedFreeRegionCapacity) {
-            allocation->allocator->sortedFreeRegionCapacity *= 2;
-            allocation->allocator->sortedFreeRegions = SDL_realloc(
-                allocation->allocator->sortedFreeRegions,
-                sizeof(VulkanMemoryFreeRegion *) * allocation->allocator->sortedFreeRegionCapacity);
-        }
-
-        /* perform insertion sort */
-        if (allocation->allocator->sortedFreeRegionCount > 0 && insertionIndex != allocation->allocator->sortedFreeRegionCount) {
-            for (i = allocation->allocator->sortedFreeRegionCount; i > insertionIndex && i > 0; i -= 1) {
-                allocation->allocator->sortedFreeRegions[i] = allocation->allocator->sortedFreeRegions[i - 1];
-                allocation->allocator->sortedFreeRegions[i]->sortedIndex = i;
-            }
-        }
+    newFreeRegion->prevInSizeClass = NULL;
+    newFreeRegion->nextInSizeClass = NULL;
 
-        allocation->allocator->sortedFreeRegionCount += 1;
-        allocation->allocator->sortedFreeRegions[insertionIndex] = newFreeRegion;
-        newFreeRegion->sortedIndex = insertionIndex;
+    if (allocation->availableForAllocation) {
+        VULKAN_INTERNAL_InsertFreeRegionSizeClass(newFreeRegion);
     }
 
-    SDL_UnlockMutex(renderer->allocatorLock);
+    SDL_UnlockMutex(allocation->allocator->lock);
 }
 
 static VulkanMemoryUsedRegion *VULKAN_INTERNAL_NewMemoryUsedRegion(
@@ -1721,7 +2458,7 @@ static VulkanMemoryUsedRegion *VULKAN_INTERNAL_NewMemoryUsedRegion(
 {
     VulkanMemoryUsedRegion *memoryUsedRegion;
 
-    SDL_LockMutex(renderer->allocatorLock);
+    SDL_LockMutex(allocation->allocator->lock);
 
     if (allocation->usedRegionCount == allocation->usedRegionCapacity) {
         allocation->usedRegionCapacity *= 2;
@@ -1743,7 +2480,7 @@ static VulkanMemoryUsedRegion *VULKAN_INTERNAL_NewMemoryUsedRegion(
     allocation->usedRegions[allocation->usedRegionCount] = memoryUsedRegion;
     allocation->usedRegionCount += 1;
 
-    SDL_UnlockMutex(renderer->allocatorLock);
+    SDL_UnlockMutex(allocation->allocator->lock);
 
     return memoryUsedRegion;
 }
@@ -1752,9 +2489,10 @@ static void VULKAN_INTERNAL_RemoveMemoryUsedRegion(
     VulkanRenderer *renderer,
     VulkanMemoryUsedRegion *usedRegion)
 {
+    VulkanMemorySubAllocator *allocator = usedRegion->allocation->allocator;
     Uint32 i;
 
-    SDL_LockMutex(renderer->allocatorLock);
+    SDL_LockMutex(allocator->lock);
 
     for (i = 0; i < usedRegion->allocation->usedRegionCount; i += 1) {
         if (usedRegion->allocation->usedRegions[i] == usedRegion) {
@@ -1779,7 +2517,7 @@ static void VULKAN_INTERNAL_RemoveMemoryUsedRegion(
 
     SDL_free(usedRegion);
 
-    SDL_UnlockMutex(renderer->allocatorLock);
+    SDL_UnlockMutex(allocator->lock);
 }
 
 static SDL_bool VULKAN_INTERNAL_CheckMemoryTypeArrayUnique(
@@ -1961,6 +2699,7 @@ static void VULKAN_INTERNAL_DeallocateMemory(
     VulkanMemoryAllocation *allocation = allocator->allocations[allocationIndex];
 
     SDL_LockMutex(renderer->allocatorLock);
+    SDL_LockMutex(allocator->lock);
 
     /* If this allocation was marked for defrag, cancel that */
     for (i = 0; i < renderer->allocationsToDefragCount; i += 1) {
@@ -1972,6 +2711,10 @@ static void VULKAN_INTERNAL_DeallocateMemory(
         }
     }
 
+    if (allocation->markedForDefrag) {
+        renderer->defragBytesReclaimed += allocation->size;
+    }
+
     for (i = 0; i < allocation->freeRegionCount; i += 1) {
         VULKAN_INTERNAL_RemoveMemoryFreeRegion(
             renderer,
@@ -1998,6 +2741,7 @@ static void VULKAN_INTERNAL_DeallocateMemory(
 
     allocator->allocationCount -= 1;
 
+    SDL_UnlockMutex(allocator->lock);
     SDL_UnlockMutex(renderer->allocatorLock);
 }
 
@@ -2035,6 +2779,7 @@ static Uint8 VULKAN_INTERNAL_AllocateMemory(
 
     allocInfo.pNext = NULL;
     allocation->availableForAllocation = 1;
+    allocation->markedForDefrag = 0;
 
     allocation->usedRegions = SDL_malloc(sizeof(VulkanMemoryUsedRegion *));
     allocation->usedRegionCount = 0;
@@ -2152,10 +2897,9 @@ static Uint8 VULKAN_INTERNAL_BindResourceMemory(
     VulkanMemoryUsedRegion *usedRegion;
 
     VkDeviceSize requiredSize, allocationSize;
-    VkDeviceSize alignedOffset;
+    VkDeviceSize alignedOffset = 0;
     Uint32 newRegionSize, newRegionOffset;
     Uint8 isHostVisible, smallAllocation, allocationResult;
-    Sint32 i;
 
     isHostVisible =
         (renderer->memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags &
@@ -2171,32 +2915,14 @@ static Uint8 VULKAN_INTERNAL_BindResourceMemory(
         return 0;
     }
 
-    SDL_LockMutex(renderer->allocatorLock);
-
-    selectedRegion = NULL;
-
-    for (i = allocator->sortedFreeRegionCount - 1; i >= 0; i -= 1) {
-        region = allocator->sortedFreeRegions[i];
-
-        if (smallAllocation && region->allocation->size != SMALL_ALLOCATION_SIZE) {
-            /* region is not in a small allocation */
-            continue;
-        }
-
-        if (!smallAllocation && region->allocation->size == SMALL_ALLOCATION_SIZE) {
-            /* allocation is not small and current region is in a small allocation */
-            continue;
-        }
-
-        alignedOffset = VULKAN_INTERNAL_NextHighestAlignment(
-            region->offset,
-            memoryRequirements->memoryRequirements.alignment);
+    SDL_LockMutex(allocator->lock);
 
-        if (alignedOffset + requiredSize <= region->offset + region->size) {
-            selectedRegion = region;
-            break;
-        }
-    }
+    /* Small resources only go in small allocations and vice versa */
+    selectedRegion = VULKAN_INTERNAL_FindFreeRegion(
+        &allocator->freeRegionIndices[smallAllocation],
+        requiredSize,
+        memoryRequirements->memoryRequirements.alignment,
+        &alignedOffset);
 
     if (selectedRegion != NULL) {
         region = selectedRegion;
@@ -2228,7 +2954,7 @@ static Uint8 VULKAN_INTERNAL_BindResourceMemory(
                 newRegionSize);
         }
 
-        SDL_UnlockMutex(renderer->allocatorLock);
+        SDL_UnlockMutex(allocator->lock);
 
         if (buffer != VK_NULL_HANDLE) {
             if (!VULKAN_INTERNAL_BindBufferMemory(
@@ -2260,14 +2986,24 @@ static Uint8 VULKAN_INTERNAL_BindResourceMemory(
         return 1;
     }
 
-    /* No suitable free regions exist, allocate a new memory region */
+    /* No suitable free regions exist, allocate a new memory region.
+     * Marking visits every memory type, so drop our lock to keep the
+     * allocatorLock -> memory type lock order.
+     */
+    SDL_UnlockMutex(allocator->lock);
+    SDL_LockMutex(renderer->allocatorLock);
+
     if (
+        renderer->defragAutomatic &&
         renderer->allocationsToDefragCount == 0 &&
         !renderer->defragInProgress) {
         /* Mark currently fragmented allocations for defrag */
         VULKAN_INTERNAL_MarkAllocationsForDefrag(renderer);
     }
 
+    SDL_UnlockMutex(renderer->allocatorLock);
+    SDL_LockMutex(allocator->lock);
+
     if (requiredSize > SMALL_ALLOCATION_THRESHOLD) {
         /* allocate a page of required size aligned to LARGE_ALLOCATION_INCREMENT increments */
         allocationSize =
@@ -2287,7 +3023,7 @@ static Uint8 VULKAN_INTERNAL_BindResourceMemory(
 
     /* Uh oh, we're out of memory */
     if (allocationResult == 0) {
-        SDL_UnlockMutex(renderer->allocatorLock);
+        SDL_UnlockMutex(allocator->lock);
 
         /* Responsibility of the caller to handle being out of memory */
         return 2;
@@ -2319,7 +3055,7 @@ static Uint8 VULKAN_INTERNAL_BindResourceMemory(
             newRegionSize);
     }
 
-    SDL_UnlockMutex(renderer->allocatorLock);
+    SDL_UnlockMutex(allocator->lock);
 
     if (buffer != VK_NULL_HANDLE) {
         if (!VULKAN_INTERNAL_BindBufferMemory(
@@ -2659,6 +3395,18 @@ static void VULKAN_INTERNAL_TrackSampler(
         usedSamplerCapacity)
 }
 
+static void VULKAN_INTERNAL_TrackQueryPool(
+    VulkanCommandBuffer *commandBuffer,
+    VulkanQueryPool *queryPool)
+{
+    TRACK_RESOURCE(
+        queryPool,
+        VulkanQueryPool *,
+        usedQueryPools,
+        usedQueryPoolCount,
+        usedQueryPoolCapacity)
+}
+
 static void VULKAN_INTERNAL_TrackGraphicsPipeline(
     VulkanCommandBuffer *commandBuffer,
     VulkanGraphicsPipeline *graphicsPipeline)
@@ -2757,9 +3505,243 @@ static void VULKAN_INTERNAL_TrackUniformBuffer(
  * For example, a texture cannot have both the SAMPLER and GRAPHICS_STORAGE usage flags,
  * because then it is imposible for the backend to infer which default usage mode the texture should use.
  *
+ * Barriers are not recorded right away. They are queued on the command buffer and flushed as one
+ * vkCmdPipelineBarrier immediately before the next command that can access a resource.
+ * Nothing can use a resource while its barrier is queued, so a second transition of the same resource
+ * collapses into the queued one, and a round trip back to the same read-only state is dropped entirely.
+ * This removes the bounce through the default usage mode between consecutive passes.
+ *
  * Sync hazards can be detected by setting VK_KHRONOS_VALIDATION_VALIDATE_SYNC=1 when using validation layers.
  */
 
+/* Dedicated compute and transfer families only support a subset of pipeline stages.
+ * No graphics work can be in flight on those queues, so the graphics stages are simply dropped.
+ * Hazards against the unified queue are covered by the async submission semaphores instead.
+ */
+static void VULKAN_INTERNAL_RestrictBarrierToQueue(
+    VulkanCommandBuffer *commandBuffer,
+    VkPipelineStageFlags *srcStages,
+    VkAccessFlags *srcAccessMask,
+    VkPipelineStageFlags *dstStages,
+    VkAccessFlags *dstAccessMask)
+{
+    VkQueueFlags queueFlags = commandBuffer->commandPool->queue->queueFlags;
+    VkPipelineStageFlags supportedStages;
+    VkAccessFlags supportedAccess;
+
+    if (queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+        return;
+    }
+
+    supportedStages =
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT |
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT |
+        VK_PIPELINE_STAGE_TRANSFER_BIT |
+        VK_PIPELINE_STAGE_HOST_BIT |
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    supportedAccess =
+        VK_ACCESS_TRANSFER_READ_BIT |
+        VK_ACCESS_TRANSFER_WRITE_BIT |
+        VK_ACCESS_HOST_READ_BIT |
+        VK_ACCESS_HOST_WRITE_BIT |
+        VK_ACCESS_MEMORY_READ_BIT |
+        VK_ACCESS_MEMORY_WRITE_BIT;
+
+    if (queueFlags & VK_QUEUE_COMPUTE_BIT) {
+        supportedStages |=
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+
+        supportedAccess |=
+            VK_ACCESS_SHADER_READ_BIT |
+            VK_ACCESS_SHADER_WRITE_BIT |
+            VK_ACCESS_UNIFORM_READ_BIT |
+            VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    }
+
+    *srcStages &= supportedStages;
+    *dstStages &= supportedStages;
+
+    if (*srcStages == 0) {
+        *srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        *srcAccessMask = 0;
+    } else {
+        *srcAccessMask &= supportedAccess;
+    }
+
+    if (*dstStages == 0) {
+        *dstStages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        *dstAccessMask = 0;
+    } else {
+        *dstAccessMask &= supportedAccess;
+    }
+}
+
+static inline SDL_bool VULKAN_INTERNAL_AccessMaskHasWrites(
+    VkAccessFlags accessMask)
+{
+    return (accessMask & (VK_ACCESS_SHADER_WRITE_BIT |
+                          VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                          VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                          VK_ACCESS_TRANSFER_WRITE_BIT |
+                          VK_ACCESS_HOST_WRITE_BIT |
+                          VK_ACCESS_MEMORY_WRITE_BIT)) != 0;
+}
+
+static void VULKAN_INTERNAL_QueueBufferBarrier(
+    VulkanCommandBuffer *commandBuffer,
+    VkBufferMemoryBarrier *memoryBarrier,
+    VkPipelineStageFlags srcStages,
+    VkPipelineStageFlags dstStages)
+{
+    VkBufferMemoryBarrier *pendingBarrier;
+    VulkanBarrierStages *pendingStages;
+    Uint32 i;
+
+    for (i = 0; i < commandBuffer->pendingBufferBarrierCount; i += 1) {
+        pendingBarrier = &commandBuffer->pendingBufferBarriers[i];
+        pendingStages = &commandBuffer->pendingBufferBarrierStages[i];
+
+        if (pendingBarrier->buffer != memoryBarrier->buffer) {
+            continue;
+        }
+
+        /* The buffer was not used since the queued barrier, so skip the intermediate state */
+        pendingBarrier->dstAccessMask = memoryBarrier->dstAccessMask;
+        pendingStages->dstStages = dstStages;
+        commandBuffer->eliminatedBarrierCount += 1;
+
+        if (
+            pendingStages->srcStages == pendingStages->dstStages &&
+            pendingBarrier->srcAccessMask == pendingBarrier->dstAccessMask &&
+            !VULKAN_INTERNAL_AccessMaskHasWrites(pendingBarrier->srcAccessMask)) {
+            /* Back where it started, order within a batch does not matter */
+            commandBuffer->pendingBufferBarrierCount -= 1;
+            commandBuffer->pendingBufferBarriers[i] = commandBuffer->pendingBufferBarriers[commandBuffer->pendingBufferBarrierCount];
+            commandBuffer->pendingBufferBarrierStages[i] = commandBuffer->pendingBufferBarrierStages[commandBuffer->pendingBufferBarrierCount];
+            commandBuffer->eliminatedBarrierCount += 1;
+        }
+
+        return;
+    }
+
+    if (commandBuffer->pendingBufferBarrierCount == commandBuffer->pendingBufferBarrierCapacity) {
+        commandBuffer->pendingBufferBarrierCapacity *= 2;
+        commandBuffer->pendingBufferBarriers = SDL_realloc(
+            commandBuffer->pendingBufferBarriers,
+            commandBuffer->pendingBufferBarrierCapacity * sizeof(VkBufferMemoryBarrier));
+        commandBuffer->pendingBufferBarrierStages = SDL_realloc(
+            commandBuffer->pendingBufferBarrierStages,
+            commandBuffer->pendingBufferBarrierCapacity * sizeof(VulkanBarrierStages));
+    }
+
+    commandBuffer->pendingBufferBarriers[commandBuffer->pendingBufferBarrierCount] = *memoryBarrier;
+    commandBuffer->pendingBufferBarrierStages[commandBuffer->pendingBufferBarrierCount].srcStages = srcStages;
+    commandBuffer->pendingBufferBarrierStages[commandBuffer->pendingBufferBarrierCount].dstStages = dstStages;
+    commandBuffer->pendingBufferBarrierCount += 1;
+}
+
+static void VULKAN_INTERNAL_QueueImageBarrier(
+    VulkanCommandBuffer *commandBuffer,
+    VkImageMemoryBarrier *memoryBarrier,
+    VkPipelineStageFlags srcStages,
+    VkPipelineStageFlags dstStages)
+{
+    VkImageMemoryBarrier *pendingBarrier;
+    VulkanBarrierStages *pendingStages;
+    Uint32 i;
+
+    for (i = 0; i < commandBuffer->pendingImageBarrierCount; i += 1) {
+        pendingBarrier = &commandBuffer->pendingImageBarriers[i];
+        pendingStages = &commandBuffer->pendingImageBarrierStages[i];
+
+        if (
+            pendingBarrier->image != memoryBarrier->image ||
+            pendingBarrier->subresourceRange.baseArrayLayer != memoryBarrier->subresourceRange.baseArrayLayer ||
+            pendingBarrier->subresourceRange.baseMipLevel != memoryBarrier->subresourceRange.baseMipLevel) {
+            continue;
+        }
+
+        /* The slice was not used since the queued barrier, so skip the intermediate layout */
+        pendingBarrier->dstAccessMask = memoryBarrier->dstAccessMask;
+        pendingBarrier->newLayout = memoryBarrier->newLayout;
+        pendingStages->dstStages = dstStages;
+        commandBuffer->eliminatedBarrierCount += 1;
+
+        if (
+            pendingBarrier->oldLayout == pendingBarrier->newLayout &&
+            pendingStages->srcStages == pendingStages->dstStages &&
+            pendingBarrier->srcAccessMask == pendingBarrier->dstAccessMask &&
+            !VULKAN_INTERNAL_AccessMaskHasWrites(pendingBarrier->srcAccessMask)) {
+            /* Back where it started, order within a batch does not matter */
+            commandBuffer->pendingImageBarrierCount -= 1;
+            commandBuffer->pendingImageBarriers[i] = commandBuffer->pendingImageBarriers[commandBuffer->pendingImageBarrierCount];
+            commandBuffer->pendingImageBarrierStages[i] = commandBuffer->pendingImageBarrierStages[commandBuffer->pendingImageBarrierCount];
+            commandBuffer->eliminatedBarrierCount += 1;
+        }
+
+        return;
+    }
+
+    if (commandBuffer->pendingImageBarrierCount == commandBuffer->pendingImageBarrierCapacity) {
+        commandBuffer->pendingImageBarrierCapacity *= 2;
+        commandBuffer->pendingImageBarriers = SDL_realloc(
+            commandBuffer->pendingImageBarriers,
+            commandBuffer->pendingImageBarrierCapacity * sizeof(VkImageMemoryBarrier));
+        commandBuffer->pendingImageBarrierStages = SDL_realloc(
+            commandBuffer->pendingImageBarrierStages,
+            commandBuffer->pendingImageBarrierCapacity * sizeof(VulkanBarrierStages));
+    }
+
+    commandBuffer->pendingImageBarriers[commandBuffer->pendingImageBarrierCount] = *memoryBarrier;
+    commandBuffer->pendingImageBarrierStages[commandBuffer->pendingImageBarrierCount].srcStages = srcStages;
+    commandBuffer->pendingImageBarrierStages[commandBuffer->pendingImageBarrierCount].dstStages = dstStages;
+    commandBuffer->pendingImageBarrierCount += 1;
+}
+
+/* Must be called before recording any command that can access a resource */
+static void VULKAN_INTERNAL_FlushBarriers(
+    VulkanRenderer *renderer,
+    VulkanCommandBuffer *commandBuffer)
+{
+    VkPipelineStageFlags srcStages = 0;
+    VkPipelineStageFlags dstStages = 0;
+    Uint32 i;
+
+    if (commandBuffer->pendingBufferBarrierCount == 0 && commandBuffer->pendingImageBarrierCount == 0) {
+        return;
+    }
+
+    for (i = 0; i < commandBuffer->pendingBufferBarrierCount; i += 1) {
+        srcStages |= commandBuffer->pendingBufferBarrierStages[i].srcStages;
+        dstStages |= commandBuffer->pendingBufferBarrierStages[i].dstStages;
+    }
+
+    for (i = 0; i < commandBuffer->pendingImageBarrierCount; i += 1) {
+        srcStages |= commandBuffer->pendingImageBarrierStages[i].srcStages;
+        dstStages |= commandBuffer->pendingImageBarrierStages[i].dstStages;
+    }
+
+    renderer->vkCmdPipelineBarrier(
+        commandBuffer->commandBuffer,
+        srcStages,
+        dstStages,
+        0,
+        0,
+        NULL,
+        commandBuffer->pendingBufferBarrierCount,
+        commandBuffer->pendingBufferBarriers,
+        commandBuffer->pendingImageBarrierCount,
+        commandBuffer->pendingImageBarriers);
+
+    commandBuffer->barrierCount += commandBuffer->pendingBufferBarrierCount + commandBuffer->pendingImageBarrierCount;
+    commandBuffer->barrierBatchCount += 1;
+
+    commandBuffer->pendingBufferBarrierCount = 0;
+    commandBuffer->pendingImageBarrierCount = 0;
+}
+
 static void VULKAN_INTERNAL_BufferMemoryBarrier(
     VulkanRenderer *renderer,
     VulkanCommandBuffer *commandBuffer,
@@ -2839,17 +3821,18 @@ static void VULKAN_INTERNAL_BufferMemoryBarrier(
         return;
     }
 
-    renderer->vkCmdPipelineBarrier(
-        commandBuffer->commandBuffer,
-        srcStages,
-        dstStages,
-        0,
-        0,
-        NULL,
-        1,
+    VULKAN_INTERNAL_RestrictBarrierToQueue(
+        commandBuffer,
+        &srcStages,
+        &memoryBarrier.srcAccessMask,
+        &dstStages,
+        &memoryBarrier.dstAccessMask);
+
+    VULKAN_INTERNAL_QueueBufferBarrier(
+        commandBuffer,
         &memoryBarrier,
-        0,
-        NULL);
+        srcStages,
+        dstStages);
 
     buffer->transitioned = SDL_TRUE;
 }
@@ -2962,17 +3945,18 @@ static void VULKAN_INTERNAL_ImageMemoryBarrier(
         return;
     }
 
-    renderer->vkCmdPipelineBarrier(
-        commandBuffer->commandBuffer,
+    VULKAN_INTERNAL_RestrictBarrierToQueue(
+        commandBuffer,
+        &srcStages,
+        &memoryBarrier.srcAccessMask,
+        &dstStages,
+        &memoryBarrier.dstAccessMask);
+
+    VULKAN_INTERNAL_QueueImageBarrier(
+        commandBuffer,
+        &memoryBarrier,
         srcStages,
-        dstStages,
-        0,
-        0,
-        NULL,
-        0,
-        NULL,
-        1,
-        &memoryBarrier);
+        dstStages);
 
     textureSlice->transitioned = SDL_TRUE;
 }
@@ -3082,21 +4066,35 @@ static void VULKAN_INTERNAL_TextureTransitionToDefaultUsage(
 
 /* Resource Disposal */
 
+/* Must be called with the dispose lock held */
+static void VULKAN_INTERNAL_QueueDeferredDestroy(
+    VulkanRenderer *renderer,
+    VulkanDeferredDestroyType type,
+    void *resource)
+{
+    EXPAND_ARRAY_IF_NEEDED(
+        renderer->deferredDestroys,
+        VulkanDeferredDestroy,
+        renderer->deferredDestroyCount + 1,
+        renderer->deferredDestroyCapacity,
+        renderer->deferredDestroyCapacity * 2)
+
+    renderer->deferredDestroys[renderer->deferredDestroyCount].type = type;
+    renderer->deferredDestroys[renderer->deferredDestroyCount].submissionSerial = renderer->submissionSerial;
+    renderer->deferredDestroys[renderer->deferredDestroyCount].resource = resource;
+    renderer->deferredDestroyCount += 1;
+}
+
 static void VULKAN_INTERNAL_ReleaseFramebuffer(
     VulkanRenderer *renderer,
     VulkanFramebuffer *framebuffer)
 {
     SDL_LockMutex(renderer->disposeLock);
 
-    EXPAND_ARRAY_IF_NEEDED(
-        renderer->framebuffersToDestroy,
-        VulkanFramebuffer *,
-        renderer->framebuffersToDestroyCount + 1,
-        renderer->framebuffersToDestroyCapacity,
-        renderer->framebuffersToDestroyCapacity * 2)
-
-    renderer->framebuffersToDestroy[renderer->framebuffersToDestroyCount] = framebuffer;
-    renderer->framebuffersToDestroyCount += 1;
+    VULKAN_INTERNAL_QueueDeferredDestroy(
+        renderer,
+        VULKAN_DEFERRED_DESTROY_FRAMEBUFFER,
+        framebuffer);
 
     SDL_UnlockMutex(renderer->disposeLock);
 }
@@ -3117,28 +4115,33 @@ static void VULKAN_INTERNAL_RemoveFramebuffersContainingView(
     VulkanRenderer *renderer,
     VkImageView view)
 {
+    FramebufferHashArray *arr;
     FramebufferHash *hash;
-    Sint32 i, j;
+    Sint32 bucket, i, j;
 
     SDL_LockMutex(renderer->framebufferFetchLock);
 
-    for (i = renderer->framebufferHashArray.count - 1; i >= 0; i -= 1) {
-        hash = &renderer->framebufferHashArray.elements[i].key;
+    for (bucket = 0; bucket < NUM_FRAMEBUFFER_BUCKETS; bucket += 1) {
+        arr = &renderer->framebufferHashTable.buckets[bucket];
 
-        for (j = 0; j < hash->colorAttachmentCount; j += 1) {
-            if (hash->colorAttachmentViews[j] == view) {
-                /* FIXME: do we actually need to queue this?
-                 * The framebuffer should not be in use once the associated texture is being destroyed
-                 */
-                VULKAN_INTERNAL_ReleaseFramebuffer(
-                    renderer,
-                    renderer->framebufferHashArray.elements[i].value);
+        for (i = arr->count - 1; i >= 0; i -= 1) {
+            hash = &arr->elements[i].key;
 
-                FramebufferHashArray_Remove(
-                    &renderer->framebufferHashArray,
-                    i);
+            for (j = 0; j < hash->colorAttachmentCount; j += 1) {
+                if (hash->colorAttachmentViews[j] == view) {
+                    /* FIXME: do we actually need to queue this?
+                     * The framebuffer should not be in use once the associated texture is being destroyed
+                     */
+                    VULKAN_INTERNAL_ReleaseFramebuffer(
+                        renderer,
+                        arr->elements[i].value);
 
-                break;
+                    FramebufferHashArray_Remove(
+                        arr,
+                        i);
+
+                    break;
+                }
             }
         }
     }
@@ -3152,6 +4155,13 @@ static void VULKAN_INTERNAL_DestroyTexture(
 {
     Uint32 sliceIndex;
 
+    if (texture->bindlessIndex != BINDLESS_INVALID_INDEX) {
+        VULKAN_INTERNAL_FreeBindlessIndex(
+            renderer,
+            REFRESH_BINDLESSRESOURCETYPE_TEXTURE,
+            texture->bindlessIndex);
+    }
+
     /* Clean up slices */
     for (sliceIndex = 0; sliceIndex < texture->sliceCount; sliceIndex += 1) {
         if (texture->isRenderTarget) {
@@ -3196,6 +4206,13 @@ static void VULKAN_INTERNAL_DestroyBuffer(
     VulkanRenderer *renderer,
     VulkanBuffer *buffer)
 {
+    if (buffer->bindlessIndex != BINDLESS_INVALID_INDEX) {
+        VULKAN_INTERNAL_FreeBindlessIndex(
+            renderer,
+            REFRESH_BINDLESSRESOURCETYPE_STORAGEBUFFER,
+            buffer->bindlessIndex);
+    }
+
     renderer->vkDestroyBuffer(
         renderer->logicalDevice,
         buffer->buffer,
@@ -3208,12 +4225,43 @@ static void VULKAN_INTERNAL_DestroyBuffer(
     SDL_free(buffer);
 }
 
+static void VULKAN_INTERNAL_FreeCommandBuffer(
+    VulkanCommandBuffer *commandBuffer)
+{
+    Uint32 i;
+
+    for (i = 0; i < NUM_DESCRIPTOR_SET_CACHE_BUCKETS; i += 1) {
+        SDL_free(commandBuffer->descriptorSetCache.buckets[i].elements);
+    }
+
+    SDL_free(commandBuffer->presentDatas);
+    SDL_free(commandBuffer->waitSemaphores);
+    SDL_free(commandBuffer->signalSemaphores);
+    SDL_free(commandBuffer->asyncWaitSemaphores);
+    SDL_free(commandBuffer->boundDescriptorSetDatas);
+    SDL_free(commandBuffer->usedBuffers);
+    SDL_free(commandBuffer->usedTextureSlices);
+    SDL_free(commandBuffer->usedSamplers);
+    SDL_free(commandBuffer->usedGraphicsPipelines);
+    SDL_free(commandBuffer->usedComputePipelines);
+    SDL_free(commandBuffer->usedFramebuffers);
+    SDL_free(commandBuffer->usedUniformBuffers);
+    SDL_free(commandBuffer->usedStagingBlocks);
+    SDL_free(commandBuffer->pendingBufferBarriers);
+    SDL_free(commandBuffer->pendingBufferBarrierStages);
+    SDL_free(commandBuffer->pendingImageBarriers);
+    SDL_free(commandBuffer->pendingImageBarrierStages);
+    SDL_free(commandBuffer->usedQueryPools);
+    SDL_free(commandBuffer->renderPassChunks);
+
+    SDL_free(commandBuffer);
+}
+
 static void VULKAN_INTERNAL_DestroyCommandPool(
     VulkanRenderer *renderer,
     VulkanCommandPool *commandPool)
 {
-    Uint32 i;
-    VulkanCommandBuffer *commandBuffer;
+    Uint32 i, j;
 
     renderer->vkDestroyCommandPool(
         renderer->logicalDevice,
@@ -3221,24 +4269,24 @@ static void VULKAN_INTERNAL_DestroyCommandPool(
         NULL);
 
     for (i = 0; i < commandPool->inactiveCommandBufferCount; i += 1) {
-        commandBuffer = commandPool->inactiveCommandBuffers[i];
+        VULKAN_INTERNAL_FreeCommandBuffer(commandPool->inactiveCommandBuffers[i]);
+    }
 
-        SDL_free(commandBuffer->presentDatas);
-        SDL_free(commandBuffer->waitSemaphores);
-        SDL_free(commandBuffer->signalSemaphores);
-        SDL_free(commandBuffer->boundDescriptorSetDatas);
-        SDL_free(commandBuffer->usedBuffers);
-        SDL_free(commandBuffer->usedTextureSlices);
-        SDL_free(commandBuffer->usedSamplers);
-        SDL_free(commandBuffer->usedGraphicsPipelines);
-        SDL_free(commandBuffer->usedComputePipelines);
-        SDL_free(commandBuffer->usedFramebuffers);
-        SDL_free(commandBuffer->usedUniformBuffers);
+    for (i = 0; i < commandPool->inactiveSecondaryCommandBufferCount; i += 1) {
+        VULKAN_INTERNAL_FreeCommandBuffer(commandPool->inactiveSecondaryCommandBuffers[i]);
+    }
+
+    for (i = 0; i < NUM_COMMAND_POOL_DESCRIPTOR_SET_BUCKETS; i += 1) {
+        for (j = 0; j < (Uint32)commandPool->descriptorSetTable.buckets[i].count; j += 1) {
+            SDL_free(commandPool->descriptorSetTable.buckets[i].elements[j].inactiveDescriptorSets);
+        }
 
-        SDL_free(commandBuffer);
+        SDL_free(commandPool->descriptorSetTable.buckets[i].elements);
     }
 
+    SDL_DestroyMutex(commandPool->descriptorSetLock);
     SDL_free(commandPool->inactiveCommandBuffers);
+    SDL_free(commandPool->inactiveSecondaryCommandBuffers);
     SDL_free(commandPool);
 }
 
@@ -3246,12 +4294,29 @@ static void VULKAN_INTERNAL_DestroyDescriptorSetPool(
     VulkanRenderer *renderer,
     DescriptorSetPool *pool)
 {
-    Uint32 i;
+    VulkanCommandPool *commandPool;
+    Uint32 i, j;
 
     if (pool == NULL) {
         return;
     }
 
+    /* Command pools may still hold inactive sets from this pool */
+
+    SDL_LockMutex(renderer->acquireCommandBufferLock);
+
+    for (i = 0; i < NUM_COMMAND_POOL_BUCKETS; i += 1) {
+        for (j = 0; j < renderer->commandPoolHashTable.buckets[i].count; j += 1) {
+            commandPool = renderer->commandPoolHashTable.buckets[i].elements[j].value;
+
+            SDL_LockMutex(commandPool->descriptorSetLock);
+            CommandPoolDescriptorSetsTable_Remove(&commandPool->descriptorSetTable, pool);
+            SDL_UnlockMutex(commandPool->descriptorSetLock);
+        }
+    }
+
+    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+
     for (i = 0; i < pool->descriptorPoolCount; i += 1) {
         renderer->vkDestroyDescriptorPool(
             renderer->logicalDevice,
@@ -3345,6 +4410,13 @@ static void VULKAN_INTERNAL_DestroySampler(
     VulkanRenderer *renderer,
     VulkanSampler *vulkanSampler)
 {
+    if (vulkanSampler->bindlessIndex != BINDLESS_INVALID_INDEX) {
+        VULKAN_INTERNAL_FreeBindlessIndex(
+            renderer,
+            REFRESH_BINDLESSRESOURCETYPE_SAMPLER,
+            vulkanSampler->bindlessIndex);
+    }
+
     renderer->vkDestroySampler(
         renderer->logicalDevice,
         vulkanSampler->sampler,
@@ -3353,6 +4425,19 @@ static void VULKAN_INTERNAL_DestroySampler(
     SDL_free(vulkanSampler);
 }
 
+static void VULKAN_INTERNAL_DestroyQueryPool(
+    VulkanRenderer *renderer,
+    VulkanQueryPool *vulkanQueryPool)
+{
+    renderer->vkDestroyQueryPool(
+        renderer->logicalDevice,
+        vulkanQueryPool->queryPool,
+        NULL);
+
+    SDL_free(vulkanQueryPool->validBits);
+    SDL_free(vulkanQueryPool);
+}
+
 static void VULKAN_INTERNAL_DestroySwapchain(
     VulkanRenderer *renderer,
     WindowData *windowData)
@@ -3540,7 +4625,7 @@ static SDL_bool VULKAN_INTERNAL_InitializeGraphicsPipelineResourceLayout(
 {
     VkDescriptorSetLayoutBinding descriptorSetLayoutBindings[MAX_TEXTURE_SAMPLERS_PER_STAGE + MAX_STORAGE_TEXTURES_PER_STAGE + MAX_STORAGE_BUFFERS_PER_STAGE];
     VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo;
-    VkDescriptorSetLayout descriptorSetLayouts[4];
+    VkDescriptorSetLayout descriptorSetLayouts[5];
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
     DescriptorSetPool *descriptorSetPool;
     VkResult vulkanResult;
@@ -3786,6 +4871,11 @@ static SDL_bool VULKAN_INTERNAL_InitializeGraphicsPipelineResourceLayout(
     pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
     pipelineLayoutCreateInfo.pPushConstantRanges = NULL;
 
+    if (renderer->supportsBindless) {
+        descriptorSetLayouts[4] = renderer->bindlessDescriptorSetLayout;
+        pipelineLayoutCreateInfo.setLayoutCount = 5;
+    }
+
     vulkanResult = renderer->vkCreatePipelineLayout(
         renderer->logicalDevice,
         &pipelineLayoutCreateInfo,
@@ -3813,7 +4903,7 @@ static SDL_bool VULKAN_INTERNAL_InitializeComputePipelineResourceLayout(
 {
     VkDescriptorSetLayoutBinding descriptorSetLayoutBindings[MAX_UNIFORM_BUFFERS_PER_STAGE];
     VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo;
-    VkDescriptorSetLayout descriptorSetLayouts[3];
+    VkDescriptorSetLayout descriptorSetLayouts[4];
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
     DescriptorSetPool *descriptorSetPool;
     VkResult vulkanResult;
@@ -3988,6 +5078,11 @@ static SDL_bool VULKAN_INTERNAL_InitializeComputePipelineResourceLayout(
     pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
     pipelineLayoutCreateInfo.pPushConstantRanges = NULL;
 
+    if (renderer->supportsBindless) {
+        descriptorSetLayouts[3] = renderer->bindlessDescriptorSetLayout;
+        pipelineLayoutCreateInfo.setLayoutCount = 4;
+    }
+
     vulkanResult = renderer->vkCreatePipelineLayout(
         renderer->logicalDevice,
         &pipelineLayoutCreateInfo,
@@ -4054,15 +5149,24 @@ static VulkanBuffer *VULKAN_INTERNAL_CreateBuffer(
     buffer->type = type;
     buffer->markedForDestroy = 0;
     buffer->transitioned = SDL_FALSE;
+    buffer->bindlessIndex = BINDLESS_INVALID_INDEX;
+    SDL_zeroa(buffer->lastUseValues);
 
     bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     bufferCreateInfo.pNext = NULL;
     bufferCreateInfo.flags = 0;
     bufferCreateInfo.size = size;
     bufferCreateInfo.usage = vulkanUsageFlags;
-    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    bufferCreateInfo.queueFamilyIndexCount = 1;
-    bufferCreateInfo.pQueueFamilyIndices = &renderer->queueFamilyIndex;
+    /* Concurrent sharing avoids queue family ownership transfers when async queues are enabled */
+    if (renderer->uniqueQueueFamilyCount > 1) {
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferCreateInfo.queueFamilyIndexCount = renderer->uniqueQueueFamilyCount;
+        bufferCreateInfo.pQueueFamilyIndices = renderer->uniqueQueueFamilyIndices;
+    } else {
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        bufferCreateInfo.queueFamilyIndexCount = 1;
+        bufferCreateInfo.pQueueFamilyIndices = &renderer->queueFamilyIndex;
+    }
 
     /* Set transfer bits so we can defrag */
     bufferCreateInfo.usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
@@ -4158,6 +5262,8 @@ static VulkanBufferContainer *VULKAN_INTERNAL_CreateBufferContainer(
     bufferContainer->bufferHandles = SDL_malloc(
         bufferContainer->bufferCapacity * sizeof(VulkanBufferHandle *));
     bufferContainer->bufferHandles[0] = bufferContainer->activeBufferHandle;
+    bufferContainer->maxCycleCount = 0;
+    bufferContainer->lastCycleFrame = 0;
     bufferContainer->debugName = NULL;
 
     return bufferContainer;
@@ -4689,6 +5795,7 @@ static SDL_bool VULKAN_INTERNAL_CreateSwapchain(
 
         /* Swapchain memory is managed by the driver */
         swapchainData->textureContainers[i].activeTextureHandle->vulkanTexture->usedRegion = NULL;
+        swapchainData->textureContainers[i].activeTextureHandle->vulkanTexture->bindlessIndex = BINDLESS_INVALID_INDEX;
 
         swapchainData->textureContainers[i].activeTextureHandle->vulkanTexture->dimensions = swapchainData->extent;
         swapchainData->textureContainers[i].activeTextureHandle->vulkanTexture->format = swapchainData->format;
@@ -4714,6 +5821,7 @@ static SDL_bool VULKAN_INTERNAL_CreateSwapchain(
         swapchainData->textureContainers[i].activeTextureHandle->vulkanTexture->slices[0].level = 0;
         swapchainData->textureContainers[i].activeTextureHandle->vulkanTexture->slices[0].transitioned = SDL_TRUE;
         swapchainData->textureContainers[i].activeTextureHandle->vulkanTexture->slices[0].msaaTexHandle = NULL;
+        SDL_zeroa(swapchainData->textureContainers[i].activeTextureHandle->vulkanTexture->slices[0].lastUseValues);
 
         VULKAN_INTERNAL_CreateSliceView(
             renderer,
@@ -4781,6 +5889,8 @@ static void VULKAN_INTERNAL_EndCommandBuffer(
 {
     VkResult result;
 
+    VULKAN_INTERNAL_FlushBarriers(renderer, commandBuffer);
+
     result = renderer->vkEndCommandBuffer(
         commandBuffer->commandBuffer);
 
@@ -4809,6 +5919,50 @@ static void VULKAN_DestroyDevice(
 
     SDL_free(renderer->submittedCommandBuffers);
 
+    for (i = 0; i < MIPMAP_FORMAT_COUNT; i += 1) {
+        for (j = 0; j < MIPMAP_LEVELS_PER_DISPATCH; j += 1) {
+            if (renderer->mipmapPipelines[i][j] != NULL) {
+                VULKAN_INTERNAL_DestroyComputePipeline(
+                    renderer,
+                    renderer->mipmapPipelines[i][j]);
+            }
+        }
+    }
+
+    for (i = 0; i < (Sint32)SDL_arraysize(renderer->queues); i += 1) {
+        for (j = 0; j < (Sint32)renderer->queues[i].pendingWaitSemaphoreCount; j += 1) {
+            renderer->vkDestroySemaphore(
+                renderer->logicalDevice,
+                renderer->queues[i].pendingWaitSemaphores[j],
+                NULL);
+        }
+        SDL_free(renderer->queues[i].pendingWaitSemaphores);
+    }
+
+    for (i = 0; i < renderer->availableSemaphoreCount; i += 1) {
+        renderer->vkDestroySemaphore(
+            renderer->logicalDevice,
+            renderer->availableSemaphores[i],
+            NULL);
+    }
+    SDL_free(renderer->availableSemaphores);
+
+    for (i = 0; i < (Sint32)SDL_arraysize(renderer->queues); i += 1) {
+        if (renderer->queues[i].timelineSemaphore != VK_NULL_HANDLE) {
+            renderer->vkDestroySemaphore(
+                renderer->logicalDevice,
+                renderer->queues[i].timelineSemaphore,
+                NULL);
+        }
+    }
+
+    if (renderer->fenceWakeSemaphore != VK_NULL_HANDLE) {
+        renderer->vkDestroySemaphore(
+            renderer->logicalDevice,
+            renderer->fenceWakeSemaphore,
+            NULL);
+    }
+
     for (i = 0; i < renderer->uniformBufferPoolCount; i += 1) {
         VULKAN_INTERNAL_DestroyBuffer(
             renderer,
@@ -4818,6 +5972,16 @@ static void VULKAN_DestroyDevice(
     }
     SDL_free(renderer->uniformBufferPool);
 
+    for (i = 0; i < renderer->stagingBlockPoolCount; i += 1) {
+        VULKAN_INTERNAL_DestroyBuffer(
+            renderer,
+            renderer->stagingBlockPool[i]->activeBufferHandle->vulkanBuffer);
+        SDL_free(renderer->stagingBlockPool[i]->activeBufferHandle);
+        SDL_free(renderer->stagingBlockPool[i]->bufferHandles);
+        SDL_free(renderer->stagingBlockPool[i]);
+    }
+    SDL_free(renderer->stagingBlockPool);
+
     for (i = 0; i < renderer->fencePool.availableFenceCount; i += 1) {
         renderer->vkDestroyFence(
             renderer->logicalDevice,
@@ -4843,22 +6007,48 @@ static void VULKAN_DestroyDevice(
         }
     }
 
-    for (i = 0; i < renderer->framebufferHashArray.count; i += 1) {
-        VULKAN_INTERNAL_DestroyFramebuffer(
-            renderer,
-            renderer->framebufferHashArray.elements[i].value);
+    for (i = 0; i < NUM_FRAMEBUFFER_BUCKETS; i += 1) {
+        for (j = 0; j < renderer->framebufferHashTable.buckets[i].count; j += 1) {
+            VULKAN_INTERNAL_DestroyFramebuffer(
+                renderer,
+                renderer->framebufferHashTable.buckets[i].elements[j].value);
+        }
+
+        SDL_free(renderer->framebufferHashTable.buckets[i].elements);
+    }
+
+    for (i = 0; i < NUM_RENDER_PASS_BUCKETS; i += 1) {
+        for (j = 0; j < renderer->renderPassHashTable.buckets[i].count; j += 1) {
+            renderer->vkDestroyRenderPass(
+                renderer->logicalDevice,
+                renderer->renderPassHashTable.buckets[i].elements[j].value,
+                NULL);
+        }
+
+        SDL_free(renderer->renderPassHashTable.buckets[i].elements);
     }
 
-    SDL_free(renderer->framebufferHashArray.elements);
+    renderer->vkDestroyPipelineCache(
+        renderer->logicalDevice,
+        renderer->pipelineCache,
+        NULL);
 
-    for (i = 0; i < renderer->renderPassHashArray.count; i += 1) {
-        renderer->vkDestroyRenderPass(
+    if (renderer->supportsBindless) {
+        renderer->vkDestroyDescriptorPool(
             renderer->logicalDevice,
-            renderer->renderPassHashArray.elements[i].value,
+            renderer->bindlessDescriptorPool,
             NULL);
-    }
 
-    SDL_free(renderer->renderPassHashArray.elements);
+        renderer->vkDestroyDescriptorSetLayout(
+            renderer->logicalDevice,
+            renderer->bindlessDescriptorSetLayout,
+            NULL);
+
+        for (i = 0; i < (Sint32)SDL_arraysize(renderer->bindlessTables); i += 1) {
+            SDL_free(renderer->bindlessTables[i].resources);
+            SDL_free(renderer->bindlessTables[i].freeIndices);
+        }
+    }
 
     for (i = 0; i < VK_MAX_MEMORY_TYPES; i += 1) {
         allocator = &renderer->memoryAllocator->subAllocators[i];
@@ -4880,26 +6070,27 @@ static void VULKAN_DestroyDevice(
             SDL_free(renderer->memoryAllocator->subAllocators[i].allocations);
         }
 
-        SDL_free(renderer->memoryAllocator->subAllocators[i].sortedFreeRegions);
+        SDL_DestroyMutex(renderer->memoryAllocator->subAllocators[i].lock);
     }
 
     SDL_free(renderer->memoryAllocator);
 
-    SDL_free(renderer->texturesToDestroy);
-    SDL_free(renderer->buffersToDestroy);
-    SDL_free(renderer->graphicsPipelinesToDestroy);
-    SDL_free(renderer->computePipelinesToDestroy);
-    SDL_free(renderer->shadersToDestroy);
-    SDL_free(renderer->samplersToDestroy);
-    SDL_free(renderer->framebuffersToDestroy);
+    SDL_free(renderer->deferredDestroys);
+    SDL_free(renderer->cycledBufferContainers);
+    SDL_free(renderer->cycledTextureContainers);
 
     SDL_DestroyMutex(renderer->allocatorLock);
     SDL_DestroyMutex(renderer->disposeLock);
     SDL_DestroyMutex(renderer->submitLock);
     SDL_DestroyMutex(renderer->acquireCommandBufferLock);
     SDL_DestroyMutex(renderer->acquireUniformBufferLock);
+    SDL_DestroyMutex(renderer->acquireStagingBlockLock);
     SDL_DestroyMutex(renderer->renderPassFetchLock);
     SDL_DestroyMutex(renderer->framebufferFetchLock);
+    SDL_DestroyMutex(renderer->bindlessLock);
+    SDL_DestroyMutex(renderer->cycleLock);
+    SDL_DestroyMutex(renderer->mipmapPipelineLock);
+    SDL_DestroyMutex(renderer->fenceWakeLock);
 
     renderer->vkDestroyDevice(renderer->logicalDevice, NULL);
     renderer->vkDestroyInstance(renderer->instance, NULL);
@@ -4909,12 +6100,13 @@ static void VULKAN_DestroyDevice(
     SDL_Vulkan_UnloadLibrary();
 }
 
-static VkDescriptorSet VULKAN_INTERNAL_FetchDescriptorSet(
+/* Moves a batch of inactive sets from the shared pool to a command pool, growing the shared pool if needed */
+static SDL_bool VULKAN_INTERNAL_RefillCommandPoolDescriptorSets(
     VulkanRenderer *renderer,
-    VulkanCommandBuffer *vulkanCommandBuffer,
-    DescriptorSetPool *descriptorSetPool)
+    DescriptorSetPool *descriptorSetPool,
+    CommandPoolDescriptorSets *commandPoolDescriptorSets)
 {
-    VkDescriptorSet descriptorSet;
+    Uint32 batchSize;
 
     SDL_LockMutex(descriptorSetPool->lock);
 
@@ -4934,7 +6126,7 @@ static VkDescriptorSet VULKAN_INTERNAL_FetchDescriptorSet(
                 &descriptorSetPool->descriptorPools[descriptorSetPool->descriptorPoolCount - 1])) {
             SDL_UnlockMutex(descriptorSetPool->lock);
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create descriptor pool!");
-            return VK_NULL_HANDLE;
+            return SDL_FALSE;
         }
 
         descriptorSetPool->inactiveDescriptorSetCapacity += descriptorSetPool->nextPoolSize;
@@ -4951,7 +6143,7 @@ static VkDescriptorSet VULKAN_INTERNAL_FetchDescriptorSet(
                 descriptorSetPool->inactiveDescriptorSets)) {
             SDL_UnlockMutex(descriptorSetPool->lock);
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate descriptor sets!");
-            return VK_NULL_HANDLE;
+            return SDL_FALSE;
         }
 
         descriptorSetPool->inactiveDescriptorSetCount = descriptorSetPool->nextPoolSize;
@@ -4959,11 +6151,68 @@ static VkDescriptorSet VULKAN_INTERNAL_FetchDescriptorSet(
         descriptorSetPool->nextPoolSize *= 2;
     }
 
-    descriptorSet = descriptorSetPool->inactiveDescriptorSets[descriptorSetPool->inactiveDescriptorSetCount - 1];
-    descriptorSetPool->inactiveDescriptorSetCount -= 1;
+    batchSize = SDL_min(descriptorSetPool->inactiveDescriptorSetCount, DESCRIPTOR_SET_BATCH_SIZE);
+
+    EXPAND_ARRAY_IF_NEEDED(
+        commandPoolDescriptorSets->inactiveDescriptorSets,
+        VkDescriptorSet,
+        commandPoolDescriptorSets->inactiveDescriptorSetCount + batchSize,
+        commandPoolDescriptorSets->inactiveDescriptorSetCapacity,
+        (commandPoolDescriptorSets->inactiveDescriptorSetCount + batchSize) * 2);
+
+    descriptorSetPool->inactiveDescriptorSetCount -= batchSize;
+
+    SDL_memcpy(
+        &commandPoolDescriptorSets->inactiveDescriptorSets[commandPoolDescriptorSets->inactiveDescriptorSetCount],
+        &descriptorSetPool->inactiveDescriptorSets[descriptorSetPool->inactiveDescriptorSetCount],
+        batchSize * sizeof(VkDescriptorSet));
+
+    commandPoolDescriptorSets->inactiveDescriptorSetCount += batchSize;
 
     SDL_UnlockMutex(descriptorSetPool->lock);
 
+    return SDL_TRUE;
+}
+
+/* Sets are taken from the command pool of the calling thread, so the shared pool lock
+ * is only taken once per batch instead of once per fetch.
+ */
+static VkDescriptorSet VULKAN_INTERNAL_FetchDescriptorSet(
+    VulkanRenderer *renderer,
+    VulkanCommandBuffer *vulkanCommandBuffer,
+    DescriptorSetPool *descriptorSetPool)
+{
+    VulkanCommandPool *commandPool = vulkanCommandBuffer->commandPool;
+    CommandPoolDescriptorSets *commandPoolDescriptorSets;
+    VkDescriptorSet descriptorSet;
+
+    SDL_LockMutex(commandPool->descriptorSetLock);
+
+    commandPoolDescriptorSets = CommandPoolDescriptorSetsTable_Fetch(
+        &commandPool->descriptorSetTable,
+        descriptorSetPool);
+
+    if (commandPoolDescriptorSets == NULL) {
+        commandPoolDescriptorSets = CommandPoolDescriptorSetsTable_Insert(
+            &commandPool->descriptorSetTable,
+            descriptorSetPool);
+    }
+
+    if (commandPoolDescriptorSets->inactiveDescriptorSetCount == 0) {
+        if (!VULKAN_INTERNAL_RefillCommandPoolDescriptorSets(
+                renderer,
+                descriptorSetPool,
+                commandPoolDescriptorSets)) {
+            SDL_UnlockMutex(commandPool->descriptorSetLock);
+            return VK_NULL_HANDLE;
+        }
+    }
+
+    descriptorSet = commandPoolDescriptorSets->inactiveDescriptorSets[commandPoolDescriptorSets->inactiveDescriptorSetCount - 1];
+    commandPoolDescriptorSets->inactiveDescriptorSetCount -= 1;
+
+    SDL_UnlockMutex(commandPool->descriptorSetLock);
+
     if (vulkanCommandBuffer->boundDescriptorSetDataCount == vulkanCommandBuffer->boundDescriptorSetDataCapacity) {
         vulkanCommandBuffer->boundDescriptorSetDataCapacity *= 2;
         vulkanCommandBuffer->boundDescriptorSetDatas = SDL_realloc(
@@ -4978,6 +6227,80 @@ static VkDescriptorSet VULKAN_INTERNAL_FetchDescriptorSet(
     return descriptorSet;
 }
 
+/* Returns a set matching the given writes, only fetching and writing a new
+ * set if this command buffer has not already written an identical one.
+ * The dstSet of each write is filled in here.
+ */
+static VkDescriptorSet VULKAN_INTERNAL_FetchCachedDescriptorSet(
+    VulkanRenderer *renderer,
+    VulkanCommandBuffer *vulkanCommandBuffer,
+    DescriptorSetPool *descriptorSetPool,
+    VkWriteDescriptorSet *writeDescriptorSets,
+    Uint32 writeDescriptorSetCount)
+{
+    DescriptorSetCacheHash key;
+    uint64_t hashcode;
+    VkDescriptorSet descriptorSet;
+    Uint32 i;
+
+    key.descriptorSetPool = descriptorSetPool;
+    key.descriptorCount = writeDescriptorSetCount;
+
+    for (i = 0; i < writeDescriptorSetCount; i += 1) {
+        if (writeDescriptorSets[i].pImageInfo != NULL) {
+            key.samplers[i] = writeDescriptorSets[i].pImageInfo->sampler;
+            key.imageViews[i] = writeDescriptorSets[i].pImageInfo->imageView;
+            key.buffers[i] = VK_NULL_HANDLE;
+        } else {
+            key.samplers[i] = VK_NULL_HANDLE;
+            key.imageViews[i] = VK_NULL_HANDLE;
+            key.buffers[i] = writeDescriptorSets[i].pBufferInfo->buffer;
+        }
+    }
+
+    hashcode = DescriptorSetCacheHashTable_GetHashCode(&key);
+
+    descriptorSet = DescriptorSetCacheHashTable_Fetch(
+        &vulkanCommandBuffer->descriptorSetCache,
+        &key,
+        hashcode);
+
+    if (descriptorSet != VK_NULL_HANDLE) {
+        vulkanCommandBuffer->descriptorSetReuseCount += 1;
+        return descriptorSet;
+    }
+
+    descriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
+        renderer,
+        vulkanCommandBuffer,
+        descriptorSetPool);
+
+    if (descriptorSet == VK_NULL_HANDLE) {
+        return VK_NULL_HANDLE;
+    }
+
+    for (i = 0; i < writeDescriptorSetCount; i += 1) {
+        writeDescriptorSets[i].dstSet = descriptorSet;
+    }
+
+    renderer->vkUpdateDescriptorSets(
+        renderer->logicalDevice,
+        writeDescriptorSetCount,
+        writeDescriptorSets,
+        0,
+        NULL);
+
+    DescriptorSetCacheHashTable_Insert(
+        &vulkanCommandBuffer->descriptorSetCache,
+        &key,
+        hashcode,
+        descriptorSet);
+
+    vulkanCommandBuffer->descriptorSetWriteCount += 1;
+
+    return descriptorSet;
+}
+
 static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
     VulkanRenderer *renderer,
     VulkanCommandBuffer *commandBuffer)
@@ -4995,14 +6318,30 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
 
     resourceLayout = &commandBuffer->currentGraphicsPipeline->resourceLayout;
 
+    /* Empty sets are never statically used, so there is nothing to fetch, write or bind.
+     * This is the common case for shaders that only read from the bindless tables.
+     */
+    if (resourceLayout->descriptorSetPools[0].descriptorInfoCount == 0) {
+        commandBuffer->needNewVertexResourceDescriptorSet = SDL_FALSE;
+    }
+
+    if (resourceLayout->descriptorSetPools[1].descriptorInfoCount == 0) {
+        commandBuffer->needNewVertexUniformDescriptorSet = SDL_FALSE;
+        commandBuffer->needNewVertexUniformOffsets = SDL_FALSE;
+    }
+
+    if (resourceLayout->descriptorSetPools[2].descriptorInfoCount == 0) {
+        commandBuffer->needNewFragmentResourceDescriptorSet = SDL_FALSE;
+    }
+
+    if (resourceLayout->descriptorSetPools[3].descriptorInfoCount == 0) {
+        commandBuffer->needNewFragmentUniformDescriptorSet = SDL_FALSE;
+        commandBuffer->needNewFragmentUniformOffsets = SDL_FALSE;
+    }
+
     if (commandBuffer->needNewVertexResourceDescriptorSet) {
         descriptorSetPool = &resourceLayout->descriptorSetPools[0];
 
-        commandBuffer->vertexResourceDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
-            renderer,
-            commandBuffer,
-            descriptorSetPool);
-
         writeDescriptorSets = SDL_stack_alloc(
             VkWriteDescriptorSet,
             resourceLayout->vertexSamplerCount +
@@ -5017,7 +6356,6 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->vertexResourceDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pBufferInfo = NULL;
 
@@ -5039,7 +6377,6 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = resourceLayout->vertexSamplerCount + i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->vertexResourceDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pBufferInfo = NULL;
 
@@ -5061,7 +6398,6 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = resourceLayout->vertexSamplerCount + resourceLayout->vertexStorageTextureCount + i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->vertexResourceDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pImageInfo = NULL;
 
@@ -5074,12 +6410,12 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
             bufferInfoCount += 1;
         }
 
-        renderer->vkUpdateDescriptorSets(
-            renderer->logicalDevice,
-            resourceLayout->vertexSamplerCount + resourceLayout->vertexStorageTextureCount + resourceLayout->vertexStorageBufferCount,
+        commandBuffer->vertexResourceDescriptorSet = VULKAN_INTERNAL_FetchCachedDescriptorSet(
+            renderer,
+            commandBuffer,
+            descriptorSetPool,
             writeDescriptorSets,
-            0,
-            NULL);
+            resourceLayout->vertexSamplerCount + resourceLayout->vertexStorageTextureCount + resourceLayout->vertexStorageBufferCount);
 
         renderer->vkCmdBindDescriptorSets(
             commandBuffer->commandBuffer,
@@ -5101,11 +6437,6 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
     if (commandBuffer->needNewVertexUniformDescriptorSet) {
         descriptorSetPool = &resourceLayout->descriptorSetPools[1];
 
-        commandBuffer->vertexUniformDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
-            renderer,
-            commandBuffer,
-            descriptorSetPool);
-
         writeDescriptorSets = SDL_stack_alloc(
             VkWriteDescriptorSet,
             resourceLayout->vertexUniformBufferCount);
@@ -5119,7 +6450,6 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->vertexUniformDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pImageInfo = NULL;
 
@@ -5132,12 +6462,12 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
             bufferInfoCount += 1;
         }
 
-        renderer->vkUpdateDescriptorSets(
-            renderer->logicalDevice,
-            resourceLayout->vertexUniformBufferCount,
+        commandBuffer->vertexUniformDescriptorSet = VULKAN_INTERNAL_FetchCachedDescriptorSet(
+            renderer,
+            commandBuffer,
+            descriptorSetPool,
             writeDescriptorSets,
-            0,
-            NULL);
+            resourceLayout->vertexUniformBufferCount);
 
         SDL_stack_free(writeDescriptorSets);
         bufferInfoCount = 0;
@@ -5149,7 +6479,7 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
 
     if (commandBuffer->needNewVertexUniformOffsets) {
         for (i = 0; i < resourceLayout->vertexUniformBufferCount; i += 1) {
-            dynamicOffsets[i] = commandBuffer->vertexUniformBuffers[i]->drawOffset;
+            dynamicOffsets[i] = commandBuffer->vertexUniformDrawOffsets[i];
         }
 
         renderer->vkCmdBindDescriptorSets(
@@ -5168,11 +6498,6 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
     if (commandBuffer->needNewFragmentResourceDescriptorSet) {
         descriptorSetPool = &resourceLayout->descriptorSetPools[2];
 
-        commandBuffer->fragmentResourceDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
-            renderer,
-            commandBuffer,
-            descriptorSetPool);
-
         writeDescriptorSets = SDL_stack_alloc(
             VkWriteDescriptorSet,
             resourceLayout->fragmentSamplerCount +
@@ -5187,7 +6512,6 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->fragmentResourceDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pBufferInfo = NULL;
 
@@ -5209,7 +6533,6 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = resourceLayout->fragmentSamplerCount + i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->fragmentResourceDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pBufferInfo = NULL;
 
@@ -5231,7 +6554,6 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = resourceLayout->fragmentSamplerCount + resourceLayout->fragmentStorageTextureCount + i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->fragmentResourceDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pImageInfo = NULL;
 
@@ -5244,12 +6566,12 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
             bufferInfoCount += 1;
         }
 
-        renderer->vkUpdateDescriptorSets(
-            renderer->logicalDevice,
-            resourceLayout->fragmentSamplerCount + resourceLayout->fragmentStorageTextureCount + resourceLayout->fragmentStorageBufferCount,
+        commandBuffer->fragmentResourceDescriptorSet = VULKAN_INTERNAL_FetchCachedDescriptorSet(
+            renderer,
+            commandBuffer,
+            descriptorSetPool,
             writeDescriptorSets,
-            0,
-            NULL);
+            resourceLayout->fragmentSamplerCount + resourceLayout->fragmentStorageTextureCount + resourceLayout->fragmentStorageBufferCount);
 
         renderer->vkCmdBindDescriptorSets(
             commandBuffer->commandBuffer,
@@ -5271,11 +6593,6 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
     if (commandBuffer->needNewFragmentUniformDescriptorSet) {
         descriptorSetPool = &resourceLayout->descriptorSetPools[3];
 
-        commandBuffer->fragmentUniformDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
-            renderer,
-            commandBuffer,
-            descriptorSetPool);
-
         writeDescriptorSets = SDL_stack_alloc(
             VkWriteDescriptorSet,
             resourceLayout->fragmentUniformBufferCount);
@@ -5289,7 +6606,6 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->fragmentUniformDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pImageInfo = NULL;
 
@@ -5302,12 +6618,12 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
             bufferInfoCount += 1;
         }
 
-        renderer->vkUpdateDescriptorSets(
-            renderer->logicalDevice,
-            resourceLayout->fragmentUniformBufferCount,
+        commandBuffer->fragmentUniformDescriptorSet = VULKAN_INTERNAL_FetchCachedDescriptorSet(
+            renderer,
+            commandBuffer,
+            descriptorSetPool,
             writeDescriptorSets,
-            0,
-            NULL);
+            resourceLayout->fragmentUniformBufferCount);
 
         SDL_stack_free(writeDescriptorSets);
         bufferInfoCount = 0;
@@ -5319,7 +6635,7 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
 
     if (commandBuffer->needNewFragmentUniformOffsets) {
         for (i = 0; i < resourceLayout->fragmentUniformBufferCount; i += 1) {
-            dynamicOffsets[i] = commandBuffer->fragmentUniformBuffers[i]->drawOffset;
+            dynamicOffsets[i] = commandBuffer->fragmentUniformDrawOffsets[i];
         }
 
         renderer->vkCmdBindDescriptorSets(
@@ -5453,20 +6769,107 @@ static void VULKAN_DrawIndexedPrimitivesIndirect(
     VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, vulkanBuffer);
 }
 
-/* Debug Naming */
-
-static void VULKAN_INTERNAL_SetBufferName(
-    VulkanRenderer *renderer,
-    VulkanBuffer *buffer,
-    const char *text)
+static SDL_bool VULKAN_SupportsIndirectCount(
+    Refresh_Renderer *driverData)
 {
-    VkDebugUtilsObjectNameInfoEXT nameInfo;
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    return renderer->supportsIndirectCount;
+}
 
-    if (renderer->debugMode && renderer->supportsDebugUtils) {
-        nameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
-        nameInfo.pNext = NULL;
-        nameInfo.pObjectName = text;
-        nameInfo.objectType = VK_OBJECT_TYPE_BUFFER;
+static void VULKAN_DrawPrimitivesIndirectCount(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_Buffer *buffer,
+    Uint32 offsetInBytes,
+    Refresh_Buffer *countBuffer,
+    Uint32 countOffsetInBytes,
+    Uint32 maxDrawCount,
+    Uint32 stride)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
+    VulkanBuffer *vulkanBuffer = ((VulkanBufferContainer *)buffer)->activeBufferHandle->vulkanBuffer;
+    VulkanBuffer *vulkanCountBuffer = ((VulkanBufferContainer *)countBuffer)->activeBufferHandle->vulkanBuffer;
+
+    if (!renderer->supportsIndirectCount) {
+        /* Fallback: the app zeroes out the unused draws */
+        VULKAN_DrawPrimitivesIndirect(
+            commandBuffer,
+            buffer,
+            offsetInBytes,
+            maxDrawCount,
+            stride);
+        return;
+    }
+
+    VULKAN_INTERNAL_BindGraphicsDescriptorSets(renderer, vulkanCommandBuffer);
+
+    renderer->vkCmdDrawIndirectCountKHR(
+        vulkanCommandBuffer->commandBuffer,
+        vulkanBuffer->buffer,
+        offsetInBytes,
+        vulkanCountBuffer->buffer,
+        countOffsetInBytes,
+        maxDrawCount,
+        stride);
+
+    VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, vulkanBuffer);
+    VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, vulkanCountBuffer);
+}
+
+static void VULKAN_DrawIndexedPrimitivesIndirectCount(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_Buffer *buffer,
+    Uint32 offsetInBytes,
+    Refresh_Buffer *countBuffer,
+    Uint32 countOffsetInBytes,
+    Uint32 maxDrawCount,
+    Uint32 stride)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
+    VulkanBuffer *vulkanBuffer = ((VulkanBufferContainer *)buffer)->activeBufferHandle->vulkanBuffer;
+    VulkanBuffer *vulkanCountBuffer = ((VulkanBufferContainer *)countBuffer)->activeBufferHandle->vulkanBuffer;
+
+    if (!renderer->supportsIndirectCount) {
+        /* Fallback: the app zeroes out the unused draws */
+        VULKAN_DrawIndexedPrimitivesIndirect(
+            commandBuffer,
+            buffer,
+            offsetInBytes,
+            maxDrawCount,
+            stride);
+        return;
+    }
+
+    VULKAN_INTERNAL_BindGraphicsDescriptorSets(renderer, vulkanCommandBuffer);
+
+    renderer->vkCmdDrawIndexedIndirectCountKHR(
+        vulkanCommandBuffer->commandBuffer,
+        vulkanBuffer->buffer,
+        offsetInBytes,
+        vulkanCountBuffer->buffer,
+        countOffsetInBytes,
+        maxDrawCount,
+        stride);
+
+    VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, vulkanBuffer);
+    VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, vulkanCountBuffer);
+}
+
+/* Debug Naming */
+
+static void VULKAN_INTERNAL_SetBufferName(
+    VulkanRenderer *renderer,
+    VulkanBuffer *buffer,
+    const char *text)
+{
+    VkDebugUtilsObjectNameInfoEXT nameInfo;
+
+    if (renderer->debugMode && renderer->supportsDebugUtils) {
+        nameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+        nameInfo.pNext = NULL;
+        nameInfo.pObjectName = text;
+        nameInfo.objectType = VK_OBJECT_TYPE_BUFFER;
         nameInfo.objectHandle = (uint64_t)buffer->buffer;
 
         renderer->vkSetDebugUtilsObjectNameEXT(
@@ -5680,6 +7083,7 @@ static VulkanTexture *VULKAN_INTERNAL_CreateTexture(
     texture->isRenderTarget = isRenderTarget;
     texture->isMSAAColorTarget = isMSAAColorTarget;
     texture->markedForDestroy = 0;
+    texture->bindlessIndex = BINDLESS_INVALID_INDEX;
 
     if (isCube) {
         imageCreateFlags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
@@ -5717,9 +7121,16 @@ static VulkanTexture *VULKAN_INTERNAL_CreateTexture(
     imageCreateInfo.samples = isMSAAColorTarget || VULKAN_INTERNAL_IsVulkanDepthFormat(format) ? sampleCount : VK_SAMPLE_COUNT_1_BIT;
     imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
     imageCreateInfo.usage = vkUsageFlags;
-    imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    imageCreateInfo.queueFamilyIndexCount = 0;
-    imageCreateInfo.pQueueFamilyIndices = NULL;
+    /* See VULKAN_INTERNAL_CreateBuffer */
+    if (renderer->uniqueQueueFamilyCount > 1) {
+        imageCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        imageCreateInfo.queueFamilyIndexCount = renderer->uniqueQueueFamilyCount;
+        imageCreateInfo.pQueueFamilyIndices = renderer->uniqueQueueFamilyIndices;
+    } else {
+        imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageCreateInfo.queueFamilyIndexCount = 0;
+        imageCreateInfo.pQueueFamilyIndices = NULL;
+    }
     imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
     vulkanResult = renderer->vkCreateImage(
@@ -5819,6 +7230,7 @@ static VulkanTexture *VULKAN_INTERNAL_CreateTexture(
             texture->slices[sliceIndex].level = j;
             texture->slices[sliceIndex].msaaTexHandle = NULL;
             texture->slices[sliceIndex].transitioned = SDL_FALSE;
+            SDL_zeroa(texture->slices[sliceIndex].lastUseValues);
             SDL_AtomicSet(&texture->slices[sliceIndex].referenceCount, 0);
 
             if (
@@ -5854,15 +7266,29 @@ static void VULKAN_INTERNAL_CycleActiveBuffer(
     VulkanBufferHandle *bufferHandle;
     Uint32 i;
 
+    SDL_LockMutex(renderer->cycleLock);
+
+    bufferContainer->lastCycleFrame = renderer->presentedFrameCount;
+
     /* If a previously-cycled buffer is available, we can use that. */
     for (i = 0; i < bufferContainer->bufferCount; i += 1) {
         bufferHandle = bufferContainer->bufferHandles[i];
         if (SDL_AtomicGet(&bufferHandle->vulkanBuffer->referenceCount) == 0) {
             bufferContainer->activeBufferHandle = bufferHandle;
+            SDL_UnlockMutex(renderer->cycleLock);
             return;
         }
     }
 
+    /* At the limit the active handle is kept, as if cycle were false. */
+    if (
+        bufferContainer->maxCycleCount > 0 &&
+        bufferContainer->bufferCount >= bufferContainer->maxCycleCount) {
+        renderer->cycleLimitHits += 1;
+        SDL_UnlockMutex(renderer->cycleLock);
+        return;
+    }
+
     /* No buffer handle is available, generate a new one. */
     bufferContainer->activeBufferHandle = VULKAN_INTERNAL_CreateBufferHandle(
         renderer,
@@ -5882,6 +7308,22 @@ static void VULKAN_INTERNAL_CycleActiveBuffer(
     bufferContainer->bufferHandles[bufferContainer->bufferCount] = bufferContainer->activeBufferHandle;
     bufferContainer->bufferCount += 1;
 
+    renderer->cycleHandlesCreated += 1;
+
+    if (bufferContainer->bufferCount == 2) {
+        EXPAND_ARRAY_IF_NEEDED(
+            renderer->cycledBufferContainers,
+            VulkanBufferContainer *,
+            renderer->cycledBufferContainerCount + 1,
+            renderer->cycledBufferContainerCapacity,
+            renderer->cycledBufferContainerCapacity * 2);
+
+        renderer->cycledBufferContainers[renderer->cycledBufferContainerCount] = bufferContainer;
+        renderer->cycledBufferContainerCount += 1;
+    }
+
+    SDL_UnlockMutex(renderer->cycleLock);
+
     if (
         renderer->debugMode &&
         renderer->supportsDebugUtils &&
@@ -5901,6 +7343,10 @@ static void VULKAN_INTERNAL_CycleActiveTexture(
     Uint32 i, j;
     Sint32 refCountTotal;
 
+    SDL_LockMutex(renderer->cycleLock);
+
+    textureContainer->lastCycleFrame = renderer->presentedFrameCount;
+
     /* If a previously-cycled texture is available, we can use that. */
     for (i = 0; i < textureContainer->textureCount; i += 1) {
         textureHandle = textureContainer->textureHandles[i];
@@ -5912,10 +7358,20 @@ static void VULKAN_INTERNAL_CycleActiveTexture(
 
         if (refCountTotal == 0) {
             textureContainer->activeTextureHandle = textureHandle;
+            SDL_UnlockMutex(renderer->cycleLock);
             return;
         }
     }
 
+    /* At the limit the active handle is kept, as if cycle were false. */
+    if (
+        textureContainer->maxCycleCount > 0 &&
+        textureContainer->textureCount >= textureContainer->maxCycleCount) {
+        renderer->cycleLimitHits += 1;
+        SDL_UnlockMutex(renderer->cycleLock);
+        return;
+    }
+
     /* No texture handle is available, generate a new one. */
     textureContainer->activeTextureHandle = VULKAN_INTERNAL_CreateTextureHandle(
         renderer,
@@ -5944,6 +7400,22 @@ static void VULKAN_INTERNAL_CycleActiveTexture(
     textureContainer->textureHandles[textureContainer->textureCount] = textureContainer->activeTextureHandle;
     textureContainer->textureCount += 1;
 
+    renderer->cycleHandlesCreated += 1;
+
+    if (textureContainer->textureCount == 2) {
+        EXPAND_ARRAY_IF_NEEDED(
+            renderer->cycledTextureContainers,
+            VulkanTextureContainer *,
+            renderer->cycledTextureContainerCount + 1,
+            renderer->cycledTextureContainerCapacity,
+            renderer->cycledTextureContainerCapacity * 2);
+
+        renderer->cycledTextureContainers[renderer->cycledTextureContainerCount] = textureContainer;
+        renderer->cycledTextureContainerCount += 1;
+    }
+
+    SDL_UnlockMutex(renderer->cycleLock);
+
     if (
         renderer->debugMode &&
         renderer->supportsDebugUtils &&
@@ -5962,8 +7434,10 @@ static VulkanBuffer *VULKAN_INTERNAL_PrepareBufferForWrite(
     SDL_bool cycle,
     VulkanBufferUsageMode destinationUsageMode)
 {
+    /* Registered bindless buffers keep their descriptor, so they are never cycled */
     if (
         cycle &&
+        bufferContainer->activeBufferHandle->vulkanBuffer->bindlessIndex == BINDLESS_INVALID_INDEX &&
         SDL_AtomicGet(&bufferContainer->activeBufferHandle->vulkanBuffer->referenceCount) > 0) {
         VULKAN_INTERNAL_CycleActiveBuffer(
             renderer,
@@ -5993,9 +7467,11 @@ static VulkanTextureSlice *VULKAN_INTERNAL_PrepareTextureSliceForWrite(
         layer,
         level);
 
+    /* Registered bindless textures keep their descriptor, so they are never cycled */
     if (
         cycle &&
         textureContainer->canBeCycled &&
+        textureSlice->parent->bindlessIndex == BINDLESS_INVALID_INDEX &&
         SDL_AtomicGet(&textureSlice->referenceCount) > 0) {
         VULKAN_INTERNAL_CycleActiveTexture(
             renderer,
@@ -6651,10 +8127,9 @@ static Refresh_GraphicsPipeline *VULKAN_CreateGraphicsPipeline(
     vkPipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
     vkPipelineCreateInfo.basePipelineIndex = 0;
 
-    /* TODO: enable pipeline caching */
     vulkanResult = renderer->vkCreateGraphicsPipelines(
         renderer->logicalDevice,
-        VK_NULL_HANDLE,
+        renderer->pipelineCache,
         1,
         &vkPipelineCreateInfo,
         NULL,
@@ -6750,7 +8225,7 @@ static Refresh_ComputePipeline *VULKAN_CreateComputePipeline(
 
     vulkanResult = renderer->vkCreateComputePipelines(
         renderer->logicalDevice,
-        (VkPipelineCache)VK_NULL_HANDLE,
+        renderer->pipelineCache,
         1,
         &computePipelineCreateInfo,
         NULL,
@@ -6773,6 +8248,7 @@ static Refresh_ComputePipeline *VULKAN_CreateComputePipeline(
             vulkanComputePipeline->shaderModule,
             NULL);
 
+        SDL_free(vulkanComputePipeline);
         LogVulkanResultAsError("vkCreateComputePipeline", vulkanResult);
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create compute pipeline!");
         return NULL;
@@ -6824,6 +8300,7 @@ static Refresh_Sampler *VULKAN_CreateSampler(
     }
 
     SDL_AtomicSet(&vulkanSampler->referenceCount, 0);
+    vulkanSampler->bindlessIndex = BINDLESS_INVALID_INDEX;
 
     return (Refresh_Sampler *)vulkanSampler;
 }
@@ -6956,6 +8433,8 @@ static Refresh_Texture *VULKAN_CreateTexture(
     container->textureHandles = SDL_malloc(
         container->textureCapacity * sizeof(VulkanTextureHandle *));
     container->textureHandles[0] = container->activeTextureHandle;
+    container->maxCycleCount = 0;
+    container->lastCycleFrame = 0;
     container->debugName = NULL;
 
     textureHandle->container = container;
@@ -6987,7 +8466,6 @@ static VulkanUniformBuffer *VULKAN_INTERNAL_CreateUniformBuffer(
         0,
         VULKAN_BUFFER_TYPE_UNIFORM);
 
-    uniformBuffer->drawOffset = 0;
     uniformBuffer->writeOffset = 0;
 
     return uniformBuffer;
@@ -7015,15 +8493,10 @@ static void VULKAN_INTERNAL_ReleaseTexture(
 
     SDL_LockMutex(renderer->disposeLock);
 
-    EXPAND_ARRAY_IF_NEEDED(
-        renderer->texturesToDestroy,
-        VulkanTexture *,
-        renderer->texturesToDestroyCount + 1,
-        renderer->texturesToDestroyCapacity,
-        renderer->texturesToDestroyCapacity * 2)
-
-    renderer->texturesToDestroy[renderer->texturesToDestroyCount] = vulkanTexture;
-    renderer->texturesToDestroyCount += 1;
+    VULKAN_INTERNAL_QueueDeferredDestroy(
+        renderer,
+        VULKAN_DEFERRED_DESTROY_TEXTURE,
+        vulkanTexture);
 
     vulkanTexture->markedForDestroy = 1;
 
@@ -7038,6 +8511,18 @@ static void VULKAN_ReleaseTexture(
     VulkanTextureContainer *vulkanTextureContainer = (VulkanTextureContainer *)texture;
     Uint32 i;
 
+    SDL_LockMutex(renderer->cycleLock);
+
+    for (i = 0; i < renderer->cycledTextureContainerCount; i += 1) {
+        if (renderer->cycledTextureContainers[i] == vulkanTextureContainer) {
+            renderer->cycledTextureContainers[i] = renderer->cycledTextureContainers[renderer->cycledTextureContainerCount - 1];
+            renderer->cycledTextureContainerCount -= 1;
+            break;
+        }
+    }
+
+    SDL_UnlockMutex(renderer->cycleLock);
+
     SDL_LockMutex(renderer->disposeLock);
 
     for (i = 0; i < vulkanTextureContainer->textureCount; i += 1) {
@@ -7064,15 +8549,10 @@ static void VULKAN_ReleaseSampler(
 
     SDL_LockMutex(renderer->disposeLock);
 
-    EXPAND_ARRAY_IF_NEEDED(
-        renderer->samplersToDestroy,
-        VulkanSampler *,
-        renderer->samplersToDestroyCount + 1,
-        renderer->samplersToDestroyCapacity,
-        renderer->samplersToDestroyCapacity * 2)
-
-    renderer->samplersToDestroy[renderer->samplersToDestroyCount] = vulkanSampler;
-    renderer->samplersToDestroyCount += 1;
+    VULKAN_INTERNAL_QueueDeferredDestroy(
+        renderer,
+        VULKAN_DEFERRED_DESTROY_SAMPLER,
+        vulkanSampler);
 
     SDL_UnlockMutex(renderer->disposeLock);
 }
@@ -7087,15 +8567,10 @@ static void VULKAN_INTERNAL_ReleaseBuffer(
 
     SDL_LockMutex(renderer->disposeLock);
 
-    EXPAND_ARRAY_IF_NEEDED(
-        renderer->buffersToDestroy,
-        VulkanBuffer *,
-        renderer->buffersToDestroyCount + 1,
-        renderer->buffersToDestroyCapacity,
-        renderer->buffersToDestroyCapacity * 2)
-
-    renderer->buffersToDestroy[renderer->buffersToDestroyCount] = vulkanBuffer;
-    renderer->buffersToDestroyCount += 1;
+    VULKAN_INTERNAL_QueueDeferredDestroy(
+        renderer,
+        VULKAN_DEFERRED_DESTROY_BUFFER,
+        vulkanBuffer);
 
     vulkanBuffer->markedForDestroy = 1;
 
@@ -7108,6 +8583,18 @@ static void VULKAN_INTERNAL_ReleaseBufferContainer(
 {
     Uint32 i;
 
+    SDL_LockMutex(renderer->cycleLock);
+
+    for (i = 0; i < renderer->cycledBufferContainerCount; i += 1) {
+        if (renderer->cycledBufferContainers[i] == bufferContainer) {
+            renderer->cycledBufferContainers[i] = renderer->cycledBufferContainers[renderer->cycledBufferContainerCount - 1];
+            renderer->cycledBufferContainerCount -= 1;
+            break;
+        }
+    }
+
+    SDL_UnlockMutex(renderer->cycleLock);
+
     SDL_LockMutex(renderer->disposeLock);
 
     for (i = 0; i < bufferContainer->bufferCount; i += 1) {
@@ -7158,15 +8645,10 @@ static void VULKAN_ReleaseShader(
 
     SDL_LockMutex(renderer->disposeLock);
 
-    EXPAND_ARRAY_IF_NEEDED(
-        renderer->shadersToDestroy,
-        VulkanShader *,
-        renderer->shadersToDestroyCount + 1,
-        renderer->shadersToDestroyCapacity,
-        renderer->shadersToDestroyCapacity * 2)
-
-    renderer->shadersToDestroy[renderer->shadersToDestroyCount] = vulkanShader;
-    renderer->shadersToDestroyCount += 1;
+    VULKAN_INTERNAL_QueueDeferredDestroy(
+        renderer,
+        VULKAN_DEFERRED_DESTROY_SHADER,
+        vulkanShader);
 
     SDL_UnlockMutex(renderer->disposeLock);
 }
@@ -7180,15 +8662,10 @@ static void VULKAN_ReleaseComputePipeline(
 
     SDL_LockMutex(renderer->disposeLock);
 
-    EXPAND_ARRAY_IF_NEEDED(
-        renderer->computePipelinesToDestroy,
-        VulkanComputePipeline *,
-        renderer->computePipelinesToDestroyCount + 1,
-        renderer->computePipelinesToDestroyCapacity,
-        renderer->computePipelinesToDestroyCapacity * 2)
-
-    renderer->computePipelinesToDestroy[renderer->computePipelinesToDestroyCount] = vulkanComputePipeline;
-    renderer->computePipelinesToDestroyCount += 1;
+    VULKAN_INTERNAL_QueueDeferredDestroy(
+        renderer,
+        VULKAN_DEFERRED_DESTROY_COMPUTE_PIPELINE,
+        vulkanComputePipeline);
 
     SDL_UnlockMutex(renderer->disposeLock);
 }
@@ -7202,15 +8679,10 @@ static void VULKAN_ReleaseGraphicsPipeline(
 
     SDL_LockMutex(renderer->disposeLock);
 
-    EXPAND_ARRAY_IF_NEEDED(
-        renderer->graphicsPipelinesToDestroy,
-        VulkanGraphicsPipeline *,
-        renderer->graphicsPipelinesToDestroyCount + 1,
-        renderer->graphicsPipelinesToDestroyCapacity,
-        renderer->graphicsPipelinesToDestroyCapacity * 2)
-
-    renderer->graphicsPipelinesToDestroy[renderer->graphicsPipelinesToDestroyCount] = vulkanGraphicsPipeline;
-    renderer->graphicsPipelinesToDestroyCount += 1;
+    VULKAN_INTERNAL_QueueDeferredDestroy(
+        renderer,
+        VULKAN_DEFERRED_DESTROY_GRAPHICS_PIPELINE,
+        vulkanGraphicsPipeline);
 
     SDL_UnlockMutex(renderer->disposeLock);
 }
@@ -7226,10 +8698,9 @@ static VkRenderPass VULKAN_INTERNAL_FetchRenderPass(
 {
     VkRenderPass renderPass;
     RenderPassHash hash;
+    uint64_t hashcode;
     Uint32 i;
 
-    SDL_LockMutex(renderer->renderPassFetchLock);
-
     for (i = 0; i < colorAttachmentCount; i += 1) {
         hash.colorTargetDescriptions[i].format = ((VulkanTextureContainer *)colorAttachmentInfos[i].textureSlice.texture)->activeTextureHandle->vulkanTexture->format;
         hash.colorTargetDescriptions[i].clearColor = colorAttachmentInfos[i].clearColor;
@@ -7258,9 +8729,14 @@ static VkRenderPass VULKAN_INTERNAL_FetchRenderPass(
         hash.depthStencilTargetDescription.stencilStoreOp = depthStencilAttachmentInfo->stencilStoreOp;
     }
 
-    renderPass = RenderPassHashArray_Fetch(
-        &renderer->renderPassHashArray,
-        &hash);
+    hashcode = RenderPassHashTable_GetHashCode(&hash);
+
+    SDL_LockMutex(renderer->renderPassFetchLock);
+
+    renderPass = RenderPassHashTable_Fetch(
+        &renderer->renderPassHashTable,
+        &hash,
+        hashcode);
 
     if (renderPass != VK_NULL_HANDLE) {
         SDL_UnlockMutex(renderer->renderPassFetchLock);
@@ -7275,9 +8751,10 @@ static VkRenderPass VULKAN_INTERNAL_FetchRenderPass(
         depthStencilAttachmentInfo);
 
     if (renderPass != VK_NULL_HANDLE) {
-        RenderPassHashArray_Insert(
-            &renderer->renderPassHashArray,
+        RenderPassHashTable_Insert(
+            &renderer->renderPassHashTable,
             hash,
+            hashcode,
             renderPass);
     }
 
@@ -7299,6 +8776,7 @@ static VulkanFramebuffer *VULKAN_INTERNAL_FetchFramebuffer(
     VkResult result;
     VkImageView imageViewAttachments[2 * MAX_COLOR_TARGET_BINDINGS + 1];
     FramebufferHash hash;
+    uint64_t hashcode;
     VulkanTextureSlice *textureSlice;
     Uint32 attachmentCount = 0;
     Uint32 i;
@@ -7330,11 +8808,14 @@ static VulkanFramebuffer *VULKAN_INTERNAL_FetchFramebuffer(
     hash.width = width;
     hash.height = height;
 
+    hashcode = FramebufferHashTable_GetHashCode(&hash);
+
     SDL_LockMutex(renderer->framebufferFetchLock);
 
-    vulkanFramebuffer = FramebufferHashArray_Fetch(
-        &renderer->framebufferHashArray,
-        &hash);
+    vulkanFramebuffer = FramebufferHashTable_Fetch(
+        &renderer->framebufferHashTable,
+        &hash,
+        hashcode);
 
     SDL_UnlockMutex(renderer->framebufferFetchLock);
 
@@ -7392,9 +8873,10 @@ static VulkanFramebuffer *VULKAN_INTERNAL_FetchFramebuffer(
     if (result == VK_SUCCESS) {
         SDL_LockMutex(renderer->framebufferFetchLock);
 
-        FramebufferHashArray_Insert(
-            &renderer->framebufferHashArray,
+        FramebufferHashTable_Insert(
+            &renderer->framebufferHashTable,
             hash,
+            hashcode,
             vulkanFramebuffer);
 
         SDL_UnlockMutex(renderer->framebufferFetchLock);
@@ -7669,7 +9151,22 @@ static void VULKAN_INTERNAL_ReturnUniformBufferToPool(
     renderer->uniformBufferPoolCount += 1;
 
     uniformBuffer->writeOffset = 0;
-    uniformBuffer->drawOffset = 0;
+}
+
+/* Uniform data is linearly allocated from one buffer shared by every stage and slot,
+ * so pushes only change dynamic offsets. A new buffer is taken from the pool once the
+ * current one is full, and all of them are returned when the command buffer completes.
+ */
+static VulkanUniformBuffer *VULKAN_INTERNAL_FetchCurrentUniformBuffer(
+    VulkanCommandBuffer *commandBuffer)
+{
+    /* Every binding reads MAX_UBO_SECTION_SIZE bytes from its dynamic offset */
+    if (commandBuffer->currentUniformBuffer == NULL ||
+        commandBuffer->currentUniformBuffer->writeOffset + MAX_UBO_SECTION_SIZE > commandBuffer->currentUniformBuffer->bufferHandle->vulkanBuffer->size) {
+        commandBuffer->currentUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(commandBuffer);
+    }
+
+    return commandBuffer->currentUniformBuffer;
 }
 
 static void VULKAN_INTERNAL_PushUniformData(
@@ -7685,58 +9182,27 @@ static void VULKAN_INTERNAL_PushUniformData(
             commandBuffer->renderer->minUBOAlignment);
 
     VulkanUniformBuffer *uniformBuffer;
+    Uint32 drawOffset;
 
-    if (uniformBufferStage == VULKAN_UNIFORM_BUFFER_STAGE_VERTEX) {
-        if (commandBuffer->vertexUniformBuffers[slotIndex] == NULL) {
-            commandBuffer->vertexUniformBuffers[slotIndex] = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
-                commandBuffer);
-        }
-        uniformBuffer = commandBuffer->vertexUniformBuffers[slotIndex];
-    } else if (uniformBufferStage == VULKAN_UNIFORM_BUFFER_STAGE_FRAGMENT) {
-        if (commandBuffer->fragmentUniformBuffers[slotIndex] == NULL) {
-            commandBuffer->fragmentUniformBuffers[slotIndex] = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
-                commandBuffer);
-        }
-        uniformBuffer = commandBuffer->fragmentUniformBuffers[slotIndex];
-    } else if (uniformBufferStage == VULKAN_UNIFORM_BUFFER_STAGE_COMPUTE) {
-        if (commandBuffer->computeUniformBuffers[slotIndex] == NULL) {
-            commandBuffer->computeUniformBuffers[slotIndex] = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
-                commandBuffer);
-        }
-        uniformBuffer = commandBuffer->computeUniformBuffers[slotIndex];
-    } else {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized shader stage!");
+    if (blockSize > MAX_UBO_SECTION_SIZE) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Uniform data exceeds MAX_UBO_SECTION_SIZE!");
         return;
     }
 
-    /* If there is no more room, acquire a new uniform buffer */
-    if (uniformBuffer->writeOffset + blockSize + MAX_UBO_SECTION_SIZE >= uniformBuffer->bufferHandle->vulkanBuffer->size) {
-        uniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(commandBuffer);
-
-        uniformBuffer->drawOffset = 0;
-        uniformBuffer->writeOffset = 0;
-
-        if (uniformBufferStage == VULKAN_UNIFORM_BUFFER_STAGE_VERTEX) {
-            commandBuffer->vertexUniformBuffers[slotIndex] = uniformBuffer;
-            commandBuffer->needNewVertexUniformDescriptorSet = SDL_TRUE;
-        } else if (uniformBufferStage == VULKAN_UNIFORM_BUFFER_STAGE_FRAGMENT) {
-            commandBuffer->fragmentUniformBuffers[slotIndex] = uniformBuffer;
-            commandBuffer->needNewFragmentUniformDescriptorSet = SDL_TRUE;
-        } else if (uniformBufferStage == VULKAN_UNIFORM_BUFFER_STAGE_COMPUTE) {
-            commandBuffer->computeUniformBuffers[slotIndex] = uniformBuffer;
-            commandBuffer->needNewComputeUniformDescriptorSet = SDL_TRUE;
-        } else {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized shader stage!");
-            return;
-        }
+    if (uniformBufferStage != VULKAN_UNIFORM_BUFFER_STAGE_VERTEX &&
+        uniformBufferStage != VULKAN_UNIFORM_BUFFER_STAGE_FRAGMENT &&
+        uniformBufferStage != VULKAN_UNIFORM_BUFFER_STAGE_COMPUTE) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized shader stage!");
+        return;
     }
 
-    uniformBuffer->drawOffset = uniformBuffer->writeOffset;
+    uniformBuffer = VULKAN_INTERNAL_FetchCurrentUniformBuffer(commandBuffer);
+    drawOffset = uniformBuffer->writeOffset;
 
     Uint8 *dst =
         uniformBuffer->bufferHandle->vulkanBuffer->usedRegion->allocation->mapPointer +
         uniformBuffer->bufferHandle->vulkanBuffer->usedRegion->resourceOffset +
-        uniformBuffer->writeOffset;
+        drawOffset;
 
     SDL_memcpy(
         dst,
@@ -7745,25 +9211,38 @@ static void VULKAN_INTERNAL_PushUniformData(
 
     uniformBuffer->writeOffset += blockSize;
 
+    /* The descriptor set only has to be rewritten when the slot moves to a new buffer */
     if (uniformBufferStage == VULKAN_UNIFORM_BUFFER_STAGE_VERTEX) {
+        if (commandBuffer->vertexUniformBuffers[slotIndex] != uniformBuffer) {
+            commandBuffer->vertexUniformBuffers[slotIndex] = uniformBuffer;
+            commandBuffer->needNewVertexUniformDescriptorSet = SDL_TRUE;
+        }
+        commandBuffer->vertexUniformDrawOffsets[slotIndex] = drawOffset;
         commandBuffer->needNewVertexUniformOffsets = SDL_TRUE;
     } else if (uniformBufferStage == VULKAN_UNIFORM_BUFFER_STAGE_FRAGMENT) {
+        if (commandBuffer->fragmentUniformBuffers[slotIndex] != uniformBuffer) {
+            commandBuffer->fragmentUniformBuffers[slotIndex] = uniformBuffer;
+            commandBuffer->needNewFragmentUniformDescriptorSet = SDL_TRUE;
+        }
+        commandBuffer->fragmentUniformDrawOffsets[slotIndex] = drawOffset;
         commandBuffer->needNewFragmentUniformOffsets = SDL_TRUE;
-    } else if (uniformBufferStage == VULKAN_UNIFORM_BUFFER_STAGE_COMPUTE) {
-        commandBuffer->needNewComputeUniformOffsets = SDL_TRUE;
     } else {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized shader stage!");
-        return;
+        if (commandBuffer->computeUniformBuffers[slotIndex] != uniformBuffer) {
+            commandBuffer->computeUniformBuffers[slotIndex] = uniformBuffer;
+            commandBuffer->needNewComputeUniformDescriptorSet = SDL_TRUE;
+        }
+        commandBuffer->computeUniformDrawOffsets[slotIndex] = drawOffset;
+        commandBuffer->needNewComputeUniformOffsets = SDL_TRUE;
     }
 }
 
-static void VULKAN_BeginRenderPass(
-    Refresh_CommandBuffer *commandBuffer,
+static void VULKAN_INTERNAL_BeginRenderPass(
+    VulkanCommandBuffer *vulkanCommandBuffer,
     Refresh_ColorAttachmentInfo *colorAttachmentInfos,
     Uint32 colorAttachmentCount,
-    Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo)
+    Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo,
+    VkSubpassContents contents)
 {
-    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
     VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
     VkRenderPass renderPass;
     VulkanFramebuffer *framebuffer;
@@ -7913,6 +9392,9 @@ static void VULKAN_BeginRenderPass(
 
     VULKAN_INTERNAL_TrackFramebuffer(renderer, vulkanCommandBuffer, framebuffer);
 
+    vulkanCommandBuffer->currentRenderPass = renderPass;
+    vulkanCommandBuffer->currentFramebuffer = framebuffer->framebuffer;
+
     /* Set clear values */
 
     clearValues = SDL_stack_alloc(VkClearValue, clearCount);
@@ -7955,10 +9437,12 @@ static void VULKAN_BeginRenderPass(
     renderPassBeginInfo.renderArea.offset.x = 0;
     renderPassBeginInfo.renderArea.offset.y = 0;
 
+    VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
+
     renderer->vkCmdBeginRenderPass(
         vulkanCommandBuffer->commandBuffer,
         &renderPassBeginInfo,
-        VK_SUBPASS_CONTENTS_INLINE);
+        contents);
 
     SDL_stack_free(clearValues);
 
@@ -7985,6 +9469,39 @@ static void VULKAN_BeginRenderPass(
         &defaultScissor);
 }
 
+static void VULKAN_BeginRenderPass(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_ColorAttachmentInfo *colorAttachmentInfos,
+    Uint32 colorAttachmentCount,
+    Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo)
+{
+    VULKAN_INTERNAL_BeginRenderPass(
+        (VulkanCommandBuffer *)commandBuffer,
+        colorAttachmentInfos,
+        colorAttachmentCount,
+        depthStencilAttachmentInfo,
+        VK_SUBPASS_CONTENTS_INLINE);
+}
+
+static void VULKAN_BeginParallelRenderPass(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_ColorAttachmentInfo *colorAttachmentInfos,
+    Uint32 colorAttachmentCount,
+    Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+
+    VULKAN_INTERNAL_BeginRenderPass(
+        vulkanCommandBuffer,
+        colorAttachmentInfos,
+        colorAttachmentCount,
+        depthStencilAttachmentInfo,
+        VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+    vulkanCommandBuffer->parallelRenderPass = SDL_TRUE;
+    vulkanCommandBuffer->firstRenderPassChunk = vulkanCommandBuffer->renderPassChunkCount;
+}
+
 static void VULKAN_BindGraphicsPipeline(
     Refresh_CommandBuffer *commandBuffer,
     Refresh_GraphicsPipeline *graphicsPipeline)
@@ -8002,6 +9519,20 @@ static void VULKAN_BindGraphicsPipeline(
 
     VULKAN_INTERNAL_TrackGraphicsPipeline(vulkanCommandBuffer, pipeline);
 
+    if (renderer->supportsBindless) {
+        vulkanCommandBuffer->boundBindlessSet = 1;
+
+        renderer->vkCmdBindDescriptorSets(
+            vulkanCommandBuffer->commandBuffer,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            pipeline->resourceLayout.pipelineLayout,
+            4,
+            1,
+            &renderer->bindlessDescriptorSet,
+            0,
+            NULL);
+    }
+
     renderer->vkCmdSetViewport(
         vulkanCommandBuffer->commandBuffer,
         0,
@@ -8017,15 +9548,17 @@ static void VULKAN_BindGraphicsPipeline(
     /* Acquire uniform buffers if necessary */
     for (Uint32 i = 0; i < pipeline->resourceLayout.vertexUniformBufferCount; i += 1) {
         if (vulkanCommandBuffer->vertexUniformBuffers[i] == NULL) {
-            vulkanCommandBuffer->vertexUniformBuffers[i] = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
+            vulkanCommandBuffer->vertexUniformBuffers[i] = VULKAN_INTERNAL_FetchCurrentUniformBuffer(
                 vulkanCommandBuffer);
+            vulkanCommandBuffer->vertexUniformDrawOffsets[i] = 0;
         }
     }
 
     for (Uint32 i = 0; i < pipeline->resourceLayout.fragmentUniformBufferCount; i += 1) {
         if (vulkanCommandBuffer->fragmentUniformBuffers[i] == NULL) {
-            vulkanCommandBuffer->fragmentUniformBuffers[i] = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
+            vulkanCommandBuffer->fragmentUniformBuffers[i] = VULKAN_INTERNAL_FetchCurrentUniformBuffer(
                 vulkanCommandBuffer);
+            vulkanCommandBuffer->fragmentUniformDrawOffsets[i] = 0;
         }
     }
 
@@ -8119,13 +9652,96 @@ static void VULKAN_PushFragmentUniformData(
         dataLengthInBytes);
 }
 
+static void VULKAN_ExecuteCommandBundle(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_CommandBundle *commandBundle)
+{
+    CommandBundle *bundle = (CommandBundle *)commandBundle;
+    CommandBundleCommand *command;
+    Uint32 i;
+
+    for (i = 0; i < bundle->commandCount; i += 1) {
+        command = &bundle->commands[i];
+
+        switch (command->type) {
+        case COMMAND_BUNDLE_BIND_GRAPHICS_PIPELINE:
+            VULKAN_BindGraphicsPipeline(
+                commandBuffer,
+                command->data.graphicsPipeline);
+            break;
+
+        case COMMAND_BUNDLE_BIND_VERTEX_BUFFERS:
+            VULKAN_BindVertexBuffers(
+                commandBuffer,
+                command->data.bindings.firstSlot,
+                &bundle->bufferBindings[command->data.bindings.bindingOffset],
+                command->data.bindings.bindingCount);
+            break;
+
+        case COMMAND_BUNDLE_BIND_INDEX_BUFFER:
+            VULKAN_BindIndexBuffer(
+                commandBuffer,
+                &command->data.indexBuffer.binding,
+                command->data.indexBuffer.indexElementSize);
+            break;
+
+        case COMMAND_BUNDLE_BIND_FRAGMENT_SAMPLERS:
+            VULKAN_BindFragmentSamplers(
+                commandBuffer,
+                command->data.bindings.firstSlot,
+                &bundle->samplerBindings[command->data.bindings.bindingOffset],
+                command->data.bindings.bindingCount);
+            break;
+
+        case COMMAND_BUNDLE_DRAW_INDEXED_PRIMITIVES:
+            VULKAN_DrawIndexedPrimitives(
+                commandBuffer,
+                command->data.drawIndexed.baseVertex,
+                command->data.drawIndexed.startIndex,
+                command->data.drawIndexed.primitiveCount,
+                command->data.drawIndexed.instanceCount);
+            break;
+
+        case COMMAND_BUNDLE_DRAW_PRIMITIVES:
+            VULKAN_DrawPrimitives(
+                commandBuffer,
+                command->data.draw.vertexStart,
+                command->data.draw.primitiveCount);
+            break;
+        }
+    }
+}
+
 static void VULKAN_EndRenderPass(
     Refresh_CommandBuffer *commandBuffer)
 {
     VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
     VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
+    VkCommandBuffer *chunkHandles;
+    Uint32 chunkCount;
     Uint32 i;
 
+    if (vulkanCommandBuffer->parallelRenderPass) {
+        chunkCount = vulkanCommandBuffer->renderPassChunkCount - vulkanCommandBuffer->firstRenderPassChunk;
+
+        if (chunkCount > 0) {
+            chunkHandles = SDL_stack_alloc(VkCommandBuffer, chunkCount);
+
+            for (i = 0; i < chunkCount; i += 1) {
+                chunkHandles[i] = vulkanCommandBuffer->renderPassChunks[vulkanCommandBuffer->firstRenderPassChunk + i]->commandBuffer;
+            }
+
+            renderer->vkCmdExecuteCommands(
+                vulkanCommandBuffer->commandBuffer,
+                chunkCount,
+                chunkHandles);
+
+            SDL_stack_free(chunkHandles);
+        }
+
+        vulkanCommandBuffer->parallelRenderPass = SDL_FALSE;
+    }
+
     renderer->vkCmdEndRenderPass(
         vulkanCommandBuffer->commandBuffer);
 
@@ -8222,11 +9838,26 @@ static void VULKAN_BindComputePipeline(
 
     VULKAN_INTERNAL_TrackComputePipeline(vulkanCommandBuffer, vulkanComputePipeline);
 
+    if (renderer->supportsBindless) {
+        vulkanCommandBuffer->boundBindlessSet = 1;
+
+        renderer->vkCmdBindDescriptorSets(
+            vulkanCommandBuffer->commandBuffer,
+            VK_PIPELINE_BIND_POINT_COMPUTE,
+            vulkanComputePipeline->resourceLayout.pipelineLayout,
+            3,
+            1,
+            &renderer->bindlessDescriptorSet,
+            0,
+            NULL);
+    }
+
     /* Acquire uniform buffers if necessary */
     for (Uint32 i = 0; i < vulkanComputePipeline->resourceLayout.uniformBufferCount; i += 1) {
         if (vulkanCommandBuffer->computeUniformBuffers[i] == NULL) {
-            vulkanCommandBuffer->computeUniformBuffers[i] = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
+            vulkanCommandBuffer->computeUniformBuffers[i] = VULKAN_INTERNAL_FetchCurrentUniformBuffer(
                 vulkanCommandBuffer);
+            vulkanCommandBuffer->computeUniformDrawOffsets[i] = 0;
         }
     }
 
@@ -8351,13 +9982,22 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
 
     resourceLayout = &commandBuffer->currentComputePipeline->resourceLayout;
 
-    if (commandBuffer->needNewComputeReadOnlyDescriptorSet) {
-        descriptorSetPool = &resourceLayout->descriptorSetPools[0];
+    /* Empty sets are never statically used, so there is nothing to fetch, write or bind */
+    if (resourceLayout->descriptorSetPools[0].descriptorInfoCount == 0) {
+        commandBuffer->needNewComputeReadOnlyDescriptorSet = SDL_FALSE;
+    }
 
-        commandBuffer->computeReadOnlyDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
-            renderer,
-            commandBuffer,
-            descriptorSetPool);
+    if (resourceLayout->descriptorSetPools[1].descriptorInfoCount == 0) {
+        commandBuffer->needNewComputeReadWriteDescriptorSet = SDL_FALSE;
+    }
+
+    if (resourceLayout->descriptorSetPools[2].descriptorInfoCount == 0) {
+        commandBuffer->needNewComputeUniformDescriptorSet = SDL_FALSE;
+        commandBuffer->needNewComputeUniformOffsets = SDL_FALSE;
+    }
+
+    if (commandBuffer->needNewComputeReadOnlyDescriptorSet) {
+        descriptorSetPool = &resourceLayout->descriptorSetPools[0];
 
         writeDescriptorSets = SDL_stack_alloc(
             VkWriteDescriptorSet,
@@ -8372,7 +10012,6 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->computeReadOnlyDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pBufferInfo = NULL;
 
@@ -8394,7 +10033,6 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = resourceLayout->readOnlyStorageTextureCount + i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->computeReadOnlyDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pImageInfo = NULL;
 
@@ -8407,12 +10045,12 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
             bufferInfoCount += 1;
         }
 
-        renderer->vkUpdateDescriptorSets(
-            renderer->logicalDevice,
-            resourceLayout->readOnlyStorageTextureCount + resourceLayout->readOnlyStorageBufferCount,
+        commandBuffer->computeReadOnlyDescriptorSet = VULKAN_INTERNAL_FetchCachedDescriptorSet(
+            renderer,
+            commandBuffer,
+            descriptorSetPool,
             writeDescriptorSets,
-            0,
-            NULL);
+            resourceLayout->readOnlyStorageTextureCount + resourceLayout->readOnlyStorageBufferCount);
 
         renderer->vkCmdBindDescriptorSets(
             commandBuffer->commandBuffer,
@@ -8434,11 +10072,6 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
     if (commandBuffer->needNewComputeReadWriteDescriptorSet) {
         descriptorSetPool = &resourceLayout->descriptorSetPools[1];
 
-        commandBuffer->computeReadWriteDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
-            renderer,
-            commandBuffer,
-            descriptorSetPool);
-
         writeDescriptorSets = SDL_stack_alloc(
             VkWriteDescriptorSet,
             resourceLayout->readWriteStorageTextureCount +
@@ -8453,7 +10086,6 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->computeReadWriteDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pBufferInfo = NULL;
 
@@ -8475,7 +10107,6 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = resourceLayout->readWriteStorageTextureCount + i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->computeReadWriteDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pImageInfo = NULL;
 
@@ -8488,12 +10119,12 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
             bufferInfoCount += 1;
         }
 
-        renderer->vkUpdateDescriptorSets(
-            renderer->logicalDevice,
-            resourceLayout->readWriteStorageTextureCount + resourceLayout->readWriteStorageBufferCount,
+        commandBuffer->computeReadWriteDescriptorSet = VULKAN_INTERNAL_FetchCachedDescriptorSet(
+            renderer,
+            commandBuffer,
+            descriptorSetPool,
             writeDescriptorSets,
-            0,
-            NULL);
+            resourceLayout->readWriteStorageTextureCount + resourceLayout->readWriteStorageBufferCount);
 
         renderer->vkCmdBindDescriptorSets(
             commandBuffer->commandBuffer,
@@ -8515,11 +10146,6 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
     if (commandBuffer->needNewComputeUniformDescriptorSet) {
         descriptorSetPool = &resourceLayout->descriptorSetPools[2];
 
-        commandBuffer->computeUniformDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
-            renderer,
-            commandBuffer,
-            descriptorSetPool);
-
         writeDescriptorSets = SDL_stack_alloc(
             VkWriteDescriptorSet,
             resourceLayout->uniformBufferCount);
@@ -8533,7 +10159,6 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
             currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             currentWriteDescriptorSet->dstArrayElement = 0;
             currentWriteDescriptorSet->dstBinding = i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->computeUniformDescriptorSet;
             currentWriteDescriptorSet->pTexelBufferView = NULL;
             currentWriteDescriptorSet->pImageInfo = NULL;
 
@@ -8546,12 +10171,12 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
             bufferInfoCount += 1;
         }
 
-        renderer->vkUpdateDescriptorSets(
-            renderer->logicalDevice,
-            resourceLayout->uniformBufferCount,
+        commandBuffer->computeUniformDescriptorSet = VULKAN_INTERNAL_FetchCachedDescriptorSet(
+            renderer,
+            commandBuffer,
+            descriptorSetPool,
             writeDescriptorSets,
-            0,
-            NULL);
+            resourceLayout->uniformBufferCount);
 
         SDL_stack_free(writeDescriptorSets);
         bufferInfoCount = 0;
@@ -8563,7 +10188,7 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
 
     if (commandBuffer->needNewComputeUniformOffsets) {
         for (i = 0; i < resourceLayout->uniformBufferCount; i += 1) {
-            dynamicOffsets[i] = commandBuffer->computeUniformBuffers[i]->drawOffset;
+            dynamicOffsets[i] = commandBuffer->computeUniformDrawOffsets[i];
         }
 
         renderer->vkCmdBindDescriptorSets(
@@ -8591,6 +10216,8 @@ static void VULKAN_DispatchCompute(
 
     VULKAN_INTERNAL_BindComputeDescriptorSets(renderer, vulkanCommandBuffer);
 
+    VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
+
     renderer->vkCmdDispatch(
         vulkanCommandBuffer->commandBuffer,
         groupCountX,
@@ -8779,6 +10406,8 @@ static void VULKAN_UploadToTexture(
     imageCopy.bufferRowLength = source->imagePitch;
     imageCopy.bufferImageHeight = source->imageHeight;
 
+    VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
+
     renderer->vkCmdCopyBufferToImage(
         vulkanCommandBuffer->commandBuffer,
         transferBufferContainer->activeBufferHandle->vulkanBuffer->buffer,
@@ -8822,6 +10451,8 @@ static void VULKAN_UploadToBuffer(
     bufferCopy.dstOffset = destination->offset;
     bufferCopy.size = destination->size;
 
+    VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
+
     renderer->vkCmdCopyBuffer(
         vulkanCommandBuffer->commandBuffer,
         transferBufferContainer->activeBufferHandle->vulkanBuffer->buffer,
@@ -8839,6 +10470,130 @@ static void VULKAN_UploadToBuffer(
     VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, vulkanBuffer);
 }
 
+static VulkanBufferContainer *VULKAN_INTERNAL_AcquireStagingBlock(
+    VulkanCommandBuffer *commandBuffer,
+    Uint32 sizeInBytes)
+{
+    VulkanRenderer *renderer = commandBuffer->renderer;
+    VulkanBufferContainer *stagingBlock = NULL;
+
+    if (sizeInBytes <= STAGING_BLOCK_SIZE) {
+        SDL_LockMutex(renderer->acquireStagingBlockLock);
+
+        if (renderer->stagingBlockPoolCount > 0) {
+            stagingBlock = renderer->stagingBlockPool[renderer->stagingBlockPoolCount - 1];
+            renderer->stagingBlockPoolCount -= 1;
+        }
+
+        SDL_UnlockMutex(renderer->acquireStagingBlockLock);
+
+        sizeInBytes = STAGING_BLOCK_SIZE;
+    }
+
+    if (stagingBlock == NULL) {
+        stagingBlock = VULKAN_INTERNAL_CreateBufferContainer(
+            renderer,
+            sizeInBytes,
+            0,
+            VULKAN_BUFFER_TYPE_TRANSFER);
+
+        if (stagingBlock == NULL) {
+            return NULL;
+        }
+    }
+
+    EXPAND_ARRAY_IF_NEEDED(
+        commandBuffer->usedStagingBlocks,
+        VulkanBufferContainer *,
+        commandBuffer->usedStagingBlockCount + 1,
+        commandBuffer->usedStagingBlockCapacity,
+        commandBuffer->usedStagingBlockCapacity * 2);
+
+    commandBuffer->usedStagingBlocks[commandBuffer->usedStagingBlockCount] = stagingBlock;
+    commandBuffer->usedStagingBlockCount += 1;
+
+    VULKAN_INTERNAL_TrackBuffer(
+        commandBuffer,
+        stagingBlock->activeBufferHandle->vulkanBuffer);
+
+    return stagingBlock;
+}
+
+/* Dedicated blocks for oversized requests are released instead of pooled */
+static void VULKAN_INTERNAL_ReturnStagingBlockToPool(
+    VulkanRenderer *renderer,
+    VulkanBufferContainer *stagingBlock)
+{
+    if (stagingBlock->activeBufferHandle->vulkanBuffer->size != STAGING_BLOCK_SIZE) {
+        VULKAN_INTERNAL_ReleaseBufferContainer(
+            renderer,
+            stagingBlock);
+        return;
+    }
+
+    if (renderer->stagingBlockPoolCount >= renderer->stagingBlockPoolCapacity) {
+        renderer->stagingBlockPoolCapacity *= 2;
+        renderer->stagingBlockPool = SDL_realloc(
+            renderer->stagingBlockPool,
+            renderer->stagingBlockPoolCapacity * sizeof(VulkanBufferContainer *));
+    }
+
+    renderer->stagingBlockPool[renderer->stagingBlockPoolCount] = stagingBlock;
+    renderer->stagingBlockPoolCount += 1;
+}
+
+/* Staging memory is linearly allocated from a block owned by the command buffer.
+ * A new block is taken from the pool once the current one is full, and all of them
+ * are returned when the command buffer completes, which gives ring behaviour.
+ */
+static void *VULKAN_AcquireStagingMemory(
+    Refresh_CommandBuffer *commandBuffer,
+    Uint32 sizeInBytes,
+    Refresh_TransferBufferLocation *location)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanBufferContainer *stagingBlock;
+    VulkanBuffer *vulkanBuffer;
+    Uint32 offset = 0;
+
+    if (sizeInBytes > STAGING_BLOCK_SIZE) {
+        /* The current block keeps serving smaller requests */
+        stagingBlock = VULKAN_INTERNAL_AcquireStagingBlock(
+            vulkanCommandBuffer,
+            sizeInBytes);
+    } else {
+        offset = VULKAN_INTERNAL_NextHighestAlignment32(
+            vulkanCommandBuffer->stagingBlockOffset,
+            STAGING_BLOCK_ALIGNMENT);
+
+        if (
+            vulkanCommandBuffer->currentStagingBlock == NULL ||
+            offset + sizeInBytes > STAGING_BLOCK_SIZE) {
+            vulkanCommandBuffer->currentStagingBlock = VULKAN_INTERNAL_AcquireStagingBlock(
+                vulkanCommandBuffer,
+                sizeInBytes);
+            offset = 0;
+        }
+
+        stagingBlock = vulkanCommandBuffer->currentStagingBlock;
+        vulkanCommandBuffer->stagingBlockOffset = offset + sizeInBytes;
+    }
+
+    if (stagingBlock == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire staging memory!");
+        return NULL;
+    }
+
+    vulkanBuffer = stagingBlock->activeBufferHandle->vulkanBuffer;
+
+    location->transferBuffer = (Refresh_TransferBuffer *)stagingBlock;
+    location->offset = offset;
+
+    return vulkanBuffer->usedRegion->allocation->mapPointer +
+           vulkanBuffer->usedRegion->resourceOffset +
+           offset;
+}
+
 /* Readback */
 
 static void VULKAN_DownloadFromTexture(
@@ -8875,6 +10630,8 @@ static void VULKAN_DownloadFromTexture(
     imageCopy.bufferRowLength = destination->imagePitch;
     imageCopy.bufferImageHeight = destination->imageHeight;
 
+    VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
+
     renderer->vkCmdCopyImageToBuffer(
         vulkanCommandBuffer->commandBuffer,
         vulkanTextureSlice->parent->image,
@@ -8916,6 +10673,8 @@ static void VULKAN_DownloadFromBuffer(
     bufferCopy.dstOffset = destination->offset;
     bufferCopy.size = source->size;
 
+    VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
+
     renderer->vkCmdCopyBuffer(
         vulkanCommandBuffer->commandBuffer,
         bufferContainer->activeBufferHandle->vulkanBuffer->buffer,
@@ -8984,6 +10743,8 @@ static void VULKAN_CopyTextureToTexture(
     imageCopy.extent.height = h;
     imageCopy.extent.depth = d;
 
+    VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
+
     renderer->vkCmdCopyImage(
         vulkanCommandBuffer->commandBuffer,
         srcSlice->parent->image,
@@ -9039,6 +10800,8 @@ static void VULKAN_CopyBufferToBuffer(
     bufferCopy.dstOffset = destination->offset;
     bufferCopy.size = size;
 
+    VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
+
     renderer->vkCmdCopyBuffer(
         vulkanCommandBuffer->commandBuffer,
         srcContainer->activeBufferHandle->vulkanBuffer->buffer,
@@ -9062,1789 +10825,4428 @@ static void VULKAN_CopyBufferToBuffer(
     VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, dstBuffer);
 }
 
-static void VULKAN_GenerateMipmaps(
+/* Batched copies transition each destination once, record one copy command per
+ * run of regions that share a source and destination, then transition back.
+ * Cycling is only considered the first time a container appears in the batch,
+ * so later regions cannot discard the writes of earlier ones.
+ */
+
+static VulkanBuffer *VULKAN_INTERNAL_PrepareBatchBufferForWrite(
+    VulkanRenderer *renderer,
+    VulkanCommandBuffer *commandBuffer,
+    VulkanBufferContainer *bufferContainer,
+    SDL_bool cycle,
+    VulkanBuffer **preparedBuffers,
+    Uint32 *preparedBufferCount)
+{
+    VulkanBuffer *vulkanBuffer = bufferContainer->activeBufferHandle->vulkanBuffer;
+    Uint32 i;
+
+    for (i = 0; i < *preparedBufferCount; i += 1) {
+        if (preparedBuffers[i]->handle->container == bufferContainer) {
+            return vulkanBuffer;
+        }
+    }
+
+    vulkanBuffer = VULKAN_INTERNAL_PrepareBufferForWrite(
+        renderer,
+        commandBuffer,
+        bufferContainer,
+        cycle,
+        VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION);
+
+    preparedBuffers[*preparedBufferCount] = vulkanBuffer;
+    *preparedBufferCount += 1;
+
+    return vulkanBuffer;
+}
+
+static void VULKAN_UploadToTextureRegions(
     Refresh_CommandBuffer *commandBuffer,
-    Refresh_Texture *texture)
+    Refresh_TextureTransferInfo *sources,
+    Refresh_TextureRegion *destinations,
+    Uint32 regionCount,
+    SDL_bool cycle)
 {
     VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
     VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
-    VulkanTexture *vulkanTexture = ((VulkanTextureContainer *)texture)->activeTextureHandle->vulkanTexture;
-    VulkanTextureSlice *srcTextureSlice;
-    VulkanTextureSlice *dstTextureSlice;
-    VkImageBlit blit;
-    Uint32 layer, level;
+    VulkanTextureContainer **preparedContainers = SDL_malloc(regionCount * sizeof(VulkanTextureContainer *));
+    VulkanTextureSlice **preparedSlices = SDL_malloc(regionCount * sizeof(VulkanTextureSlice *));
+    VulkanTextureSlice **regionSlices = SDL_malloc(regionCount * sizeof(VulkanTextureSlice *));
+    VkBufferImageCopy *imageCopies = SDL_malloc(regionCount * sizeof(VkBufferImageCopy));
+    Uint32 preparedContainerCount = 0;
+    Uint32 preparedSliceCount = 0;
+    VulkanTextureContainer *textureContainer;
+    VulkanTextureSlice *textureSlice;
+    VulkanBuffer *transferBuffer;
+    VulkanBuffer *nextTransferBuffer;
+    Uint32 runStart = 0;
+    SDL_bool cycleContainer;
+    Uint32 i, j;
 
-    if (vulkanTexture->levelCount <= 1) {
-        return;
-    }
+    /* Note that the transfer buffers do not need a barrier, as they are synced by the client */
 
-    /* Blit each slice sequentially. Barriers, barriers everywhere! */
-    for (layer = 0; layer < vulkanTexture->layerCount; layer += 1)
-        for (level = 1; level < vulkanTexture->levelCount; level += 1) {
-            srcTextureSlice = VULKAN_INTERNAL_FetchTextureSlice(
-                vulkanTexture,
-                layer,
-                level - 1);
+    for (i = 0; i < regionCount; i += 1) {
+        textureContainer = (VulkanTextureContainer *)destinations[i].textureSlice.texture;
 
-            dstTextureSlice = VULKAN_INTERNAL_FetchTextureSlice(
-                vulkanTexture,
-                layer,
-                level);
+        cycleContainer = cycle;
+        for (j = 0; j < preparedContainerCount; j += 1) {
+            if (preparedContainers[j] == textureContainer) {
+                cycleContainer = SDL_FALSE;
+                break;
+            }
+        }
+        if (j == preparedContainerCount) {
+            preparedContainers[preparedContainerCount] = textureContainer;
+            preparedContainerCount += 1;
+        }
 
-            VULKAN_INTERNAL_TextureTransitionFromDefaultUsage(
-                renderer,
-                vulkanCommandBuffer,
-                VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
-                srcTextureSlice);
+        textureSlice = VULKAN_INTERNAL_FetchTextureSlice(
+            textureContainer->activeTextureHandle->vulkanTexture,
+            destinations[i].textureSlice.layer,
+            destinations[i].textureSlice.mipLevel);
 
-            VULKAN_INTERNAL_TextureTransitionFromDefaultUsage(
+        for (j = 0; j < preparedSliceCount; j += 1) {
+            if (preparedSlices[j] == textureSlice) {
+                break;
+            }
+        }
+
+        if (j == preparedSliceCount) {
+            textureSlice = VULKAN_INTERNAL_PrepareTextureSliceForWrite(
                 renderer,
                 vulkanCommandBuffer,
-                VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
-                dstTextureSlice);
+                textureContainer,
+                destinations[i].textureSlice.layer,
+                destinations[i].textureSlice.mipLevel,
+                cycleContainer,
+                VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION);
+
+            preparedSlices[preparedSliceCount] = textureSlice;
+            preparedSliceCount += 1;
+        }
 
-            blit.srcOffsets[0].x = 0;
-            blit.srcOffsets[0].y = 0;
-            blit.srcOffsets[0].z = 0;
+        regionSlices[i] = textureSlice;
 
-            blit.srcOffsets[1].x = vulkanTexture->dimensions.width >> (level - 1);
-            blit.srcOffsets[1].y = vulkanTexture->dimensions.height >> (level - 1);
-            blit.srcOffsets[1].z = 1;
+        imageCopies[i].imageExtent.width = destinations[i].w;
+        imageCopies[i].imageExtent.height = destinations[i].h;
+        imageCopies[i].imageExtent.depth = destinations[i].d;
+        imageCopies[i].imageOffset.x = destinations[i].x;
+        imageCopies[i].imageOffset.y = destinations[i].y;
+        imageCopies[i].imageOffset.z = destinations[i].z;
+        imageCopies[i].imageSubresource.aspectMask = textureSlice->parent->aspectFlags;
+        imageCopies[i].imageSubresource.baseArrayLayer = destinations[i].textureSlice.layer;
+        imageCopies[i].imageSubresource.layerCount = 1;
+        imageCopies[i].imageSubresource.mipLevel = destinations[i].textureSlice.mipLevel;
+        imageCopies[i].bufferOffset = sources[i].offset;
+        imageCopies[i].bufferRowLength = sources[i].imagePitch;
+        imageCopies[i].bufferImageHeight = sources[i].imageHeight;
+    }
+
+    for (i = 1; i <= regionCount; i += 1) {
+        transferBuffer = ((VulkanBufferContainer *)sources[runStart].transferBuffer)->activeBufferHandle->vulkanBuffer;
 
-            blit.dstOffsets[0].x = 0;
-            blit.dstOffsets[0].y = 0;
-            blit.dstOffsets[0].z = 0;
+        if (i < regionCount) {
+            nextTransferBuffer = ((VulkanBufferContainer *)sources[i].transferBuffer)->activeBufferHandle->vulkanBuffer;
 
-            blit.dstOffsets[1].x = vulkanTexture->dimensions.width >> level;
-            blit.dstOffsets[1].y = vulkanTexture->dimensions.height >> level;
-            blit.dstOffsets[1].z = 1;
+            if (
+                nextTransferBuffer == transferBuffer &&
+                regionSlices[i]->parent == regionSlices[runStart]->parent) {
+                continue;
+            }
+        }
 
-            blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            blit.srcSubresource.baseArrayLayer = layer;
-            blit.srcSubresource.layerCount = 1;
-            blit.srcSubresource.mipLevel = level - 1;
+        VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
 
-            blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            blit.dstSubresource.baseArrayLayer = layer;
-            blit.dstSubresource.layerCount = 1;
-            blit.dstSubresource.mipLevel = level;
+        renderer->vkCmdCopyBufferToImage(
+            vulkanCommandBuffer->commandBuffer,
+            transferBuffer->buffer,
+            regionSlices[runStart]->parent->image,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            i - runStart,
+            &imageCopies[runStart]);
 
-            renderer->vkCmdBlitImage(
-                vulkanCommandBuffer->commandBuffer,
-                vulkanTexture->image,
-                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                vulkanTexture->image,
-                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                1,
-                &blit,
-                VK_FILTER_LINEAR);
+        VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, transferBuffer);
 
-            VULKAN_INTERNAL_TextureTransitionToDefaultUsage(
-                renderer,
-                vulkanCommandBuffer,
-                VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
-                srcTextureSlice);
+        runStart = i;
+    }
 
-            VULKAN_INTERNAL_TextureTransitionToDefaultUsage(
-                renderer,
-                vulkanCommandBuffer,
-                VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
-                dstTextureSlice);
+    for (i = 0; i < preparedSliceCount; i += 1) {
+        VULKAN_INTERNAL_TextureTransitionToDefaultUsage(
+            renderer,
+            vulkanCommandBuffer,
+            VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
+            preparedSlices[i]);
 
-            VULKAN_INTERNAL_TrackTextureSlice(vulkanCommandBuffer, srcTextureSlice);
-            VULKAN_INTERNAL_TrackTextureSlice(vulkanCommandBuffer, dstTextureSlice);
-        }
-}
+        VULKAN_INTERNAL_TrackTextureSlice(vulkanCommandBuffer, preparedSlices[i]);
+    }
 
-static void VULKAN_EndCopyPass(
-    Refresh_CommandBuffer *commandBuffer)
-{
-    /* no-op */
-    (void)commandBuffer;
+    SDL_free(preparedContainers);
+    SDL_free(preparedSlices);
+    SDL_free(regionSlices);
+    SDL_free(imageCopies);
 }
 
-static void VULKAN_Blit(
+static void VULKAN_UploadToBufferRegions(
     Refresh_CommandBuffer *commandBuffer,
-    Refresh_TextureRegion *source,
-    Refresh_TextureRegion *destination,
-    Refresh_Filter filterMode,
+    Refresh_TransferBufferLocation *sources,
+    Refresh_BufferRegion *destinations,
+    Uint32 regionCount,
     SDL_bool cycle)
 {
     VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
     VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
-    VulkanTextureContainer *sourceTextureContainer = (VulkanTextureContainer *)source->textureSlice.texture;
-    VkImageBlit region;
+    VulkanBuffer **preparedBuffers = SDL_malloc(regionCount * sizeof(VulkanBuffer *));
+    VulkanBuffer **regionBuffers = SDL_malloc(regionCount * sizeof(VulkanBuffer *));
+    VkBufferCopy *bufferCopies = SDL_malloc(regionCount * sizeof(VkBufferCopy));
+    Uint32 preparedBufferCount = 0;
+    VulkanBuffer *transferBuffer;
+    VulkanBuffer *nextTransferBuffer;
+    Uint32 runStart = 0;
+    Uint32 i;
 
-    if ((sourceTextureContainer->activeTextureHandle->vulkanTexture->usageFlags & REFRESH_TEXTUREUSAGE_SAMPLER_BIT) == 0) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Blit source texture must be created with SAMPLER bit!");
-        return;
+    /* Note that the transfer buffers do not need a barrier, as they are synced by the client */
+
+    for (i = 0; i < regionCount; i += 1) {
+        regionBuffers[i] = VULKAN_INTERNAL_PrepareBatchBufferForWrite(
+            renderer,
+            vulkanCommandBuffer,
+            (VulkanBufferContainer *)destinations[i].buffer,
+            cycle,
+            preparedBuffers,
+            &preparedBufferCount);
+
+        bufferCopies[i].srcOffset = sources[i].offset;
+        bufferCopies[i].dstOffset = destinations[i].offset;
+        bufferCopies[i].size = destinations[i].size;
     }
 
-    VulkanTextureSlice *srcTextureSlice = VULKAN_INTERNAL_FetchTextureSlice(
-        sourceTextureContainer->activeTextureHandle->vulkanTexture,
-        source->textureSlice.layer,
-        source->textureSlice.mipLevel);
+    for (i = 1; i <= regionCount; i += 1) {
+        transferBuffer = ((VulkanBufferContainer *)sources[runStart].transferBuffer)->activeBufferHandle->vulkanBuffer;
 
-    VulkanTextureSlice *dstTextureSlice = VULKAN_INTERNAL_PrepareTextureSliceForWrite(
-        renderer,
-        vulkanCommandBuffer,
-        (VulkanTextureContainer *)destination->textureSlice.texture,
-        destination->textureSlice.layer,
-        destination->textureSlice.mipLevel,
-        cycle,
-        VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION);
+        if (i < regionCount) {
+            nextTransferBuffer = ((VulkanBufferContainer *)sources[i].transferBuffer)->activeBufferHandle->vulkanBuffer;
 
-    VULKAN_INTERNAL_TextureTransitionFromDefaultUsage(
-        renderer,
-        vulkanCommandBuffer,
-        VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
-        srcTextureSlice);
+            if (
+                nextTransferBuffer == transferBuffer &&
+                regionBuffers[i] == regionBuffers[runStart]) {
+                continue;
+            }
+        }
 
-    region.srcSubresource.aspectMask = srcTextureSlice->parent->aspectFlags;
-    region.srcSubresource.baseArrayLayer = srcTextureSlice->layer;
-    region.srcSubresource.layerCount = 1;
-    region.srcSubresource.mipLevel = srcTextureSlice->level;
-    region.srcOffsets[0].x = source->x;
-    region.srcOffsets[0].y = source->y;
-    region.srcOffsets[0].z = source->z;
-    region.srcOffsets[1].x = source->x + source->w;
-    region.srcOffsets[1].y = source->y + source->h;
-    region.srcOffsets[1].z = source->z + source->d;
+        VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
 
-    region.dstSubresource.aspectMask = dstTextureSlice->parent->aspectFlags;
-    region.dstSubresource.baseArrayLayer = dstTextureSlice->layer;
-    region.dstSubresource.layerCount = 1;
-    region.dstSubresource.mipLevel = dstTextureSlice->level;
-    region.dstOffsets[0].x = destination->x;
-    region.dstOffsets[0].y = destination->y;
-    region.dstOffsets[0].z = destination->z;
-    region.dstOffsets[1].x = destination->x + destination->w;
-    region.dstOffsets[1].y = destination->y + destination->h;
-    region.dstOffsets[1].z = destination->z + destination->d;
+        renderer->vkCmdCopyBuffer(
+            vulkanCommandBuffer->commandBuffer,
+            transferBuffer->buffer,
+            regionBuffers[runStart]->buffer,
+            i - runStart,
+            &bufferCopies[runStart]);
 
-    renderer->vkCmdBlitImage(
-        vulkanCommandBuffer->commandBuffer,
-        srcTextureSlice->parent->image,
-        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-        dstTextureSlice->parent->image,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        1,
-        &region,
-        RefreshToVK_Filter[filterMode]);
+        VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, transferBuffer);
 
-    VULKAN_INTERNAL_TextureTransitionToDefaultUsage(
-        renderer,
-        vulkanCommandBuffer,
-        VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
-        srcTextureSlice);
+        runStart = i;
+    }
 
-    VULKAN_INTERNAL_TextureTransitionToDefaultUsage(
-        renderer,
-        vulkanCommandBuffer,
-        VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
-        dstTextureSlice);
+    for (i = 0; i < preparedBufferCount; i += 1) {
+        VULKAN_INTERNAL_BufferTransitionToDefaultUsage(
+            renderer,
+            vulkanCommandBuffer,
+            VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
+            preparedBuffers[i]);
 
-    VULKAN_INTERNAL_TrackTextureSlice(vulkanCommandBuffer, srcTextureSlice);
-    VULKAN_INTERNAL_TrackTextureSlice(vulkanCommandBuffer, dstTextureSlice);
+        VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, preparedBuffers[i]);
+    }
+
+    SDL_free(preparedBuffers);
+    SDL_free(regionBuffers);
+    SDL_free(bufferCopies);
 }
 
-static void VULKAN_INTERNAL_AllocateCommandBuffers(
-    VulkanRenderer *renderer,
-    VulkanCommandPool *vulkanCommandPool,
-    Uint32 allocateCount)
+static void VULKAN_CopyBufferToBufferRegions(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_BufferLocation *sources,
+    Refresh_BufferRegion *destinations,
+    Uint32 regionCount,
+    SDL_bool cycle)
 {
-    VkCommandBufferAllocateInfo allocateInfo;
-    VkResult vulkanResult;
-    Uint32 i;
-    VkCommandBuffer *commandBuffers = SDL_stack_alloc(VkCommandBuffer, allocateCount);
-    VulkanCommandBuffer *commandBuffer;
-
-    vulkanCommandPool->inactiveCommandBufferCapacity += allocateCount;
-
-    vulkanCommandPool->inactiveCommandBuffers = SDL_realloc(
-        vulkanCommandPool->inactiveCommandBuffers,
-        sizeof(VulkanCommandBuffer *) *
-            vulkanCommandPool->inactiveCommandBufferCapacity);
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
+    VulkanBuffer **preparedBuffers = SDL_malloc(regionCount * sizeof(VulkanBuffer *));
+    VulkanBuffer **sourceBuffers = SDL_malloc(regionCount * sizeof(VulkanBuffer *));
+    VulkanBuffer **regionBuffers = SDL_malloc(regionCount * sizeof(VulkanBuffer *));
+    VkBufferCopy *bufferCopies = SDL_malloc(regionCount * sizeof(VkBufferCopy));
+    Uint32 preparedBufferCount = 0;
+    Uint32 sourceBufferCount = 0;
+    VulkanBuffer *srcBuffer;
+    Uint32 runStart = 0;
+    Uint32 i, j;
 
-    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocateInfo.pNext = NULL;
-    allocateInfo.commandPool = vulkanCommandPool->commandPool;
-    allocateInfo.commandBufferCount = allocateCount;
-    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    for (i = 0; i < regionCount; i += 1) {
+        srcBuffer = ((VulkanBufferContainer *)sources[i].buffer)->activeBufferHandle->vulkanBuffer;
 
-    vulkanResult = renderer->vkAllocateCommandBuffers(
-        renderer->logicalDevice,
-        &allocateInfo,
-        commandBuffers);
+        for (j = 0; j < sourceBufferCount; j += 1) {
+            if (sourceBuffers[j] == srcBuffer) {
+                break;
+            }
+        }
 
-    if (vulkanResult != VK_SUCCESS) {
-        LogVulkanResultAsError("vkAllocateCommandBuffers", vulkanResult);
-        SDL_stack_free(commandBuffers);
-        return;
-    }
+        if (j == sourceBufferCount) {
+            VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
+                renderer,
+                vulkanCommandBuffer,
+                VULKAN_BUFFER_USAGE_MODE_COPY_SOURCE,
+                srcBuffer);
 
-    for (i = 0; i < allocateCount; i += 1) {
-        commandBuffer = SDL_malloc(sizeof(VulkanCommandBuffer));
-        commandBuffer->renderer = renderer;
-        commandBuffer->commandPool = vulkanCommandPool;
-        commandBuffer->commandBuffer = commandBuffers[i];
+            sourceBuffers[sourceBufferCount] = srcBuffer;
+            sourceBufferCount += 1;
+        }
 
-        commandBuffer->inFlightFence = VK_NULL_HANDLE;
+        regionBuffers[i] = VULKAN_INTERNAL_PrepareBatchBufferForWrite(
+            renderer,
+            vulkanCommandBuffer,
+            (VulkanBufferContainer *)destinations[i].buffer,
+            cycle,
+            preparedBuffers,
+            &preparedBufferCount);
 
-        /* Presentation tracking */
+        bufferCopies[i].srcOffset = sources[i].offset;
+        bufferCopies[i].dstOffset = destinations[i].offset;
+        bufferCopies[i].size = destinations[i].size;
+    }
 
-        commandBuffer->presentDataCapacity = 1;
-        commandBuffer->presentDataCount = 0;
-        commandBuffer->presentDatas = SDL_malloc(
-            commandBuffer->presentDataCapacity * sizeof(VulkanPresentData));
+    for (i = 1; i <= regionCount; i += 1) {
+        srcBuffer = ((VulkanBufferContainer *)sources[runStart].buffer)->activeBufferHandle->vulkanBuffer;
 
-        commandBuffer->waitSemaphoreCapacity = 1;
-        commandBuffer->waitSemaphoreCount = 0;
-        commandBuffer->waitSemaphores = SDL_malloc(
-            commandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore));
+        if (
+            i < regionCount &&
+            ((VulkanBufferContainer *)sources[i].buffer)->activeBufferHandle->vulkanBuffer == srcBuffer &&
+            regionBuffers[i] == regionBuffers[runStart]) {
+            continue;
+        }
 
-        commandBuffer->signalSemaphoreCapacity = 1;
-        commandBuffer->signalSemaphoreCount = 0;
-        commandBuffer->signalSemaphores = SDL_malloc(
-            commandBuffer->signalSemaphoreCapacity * sizeof(VkSemaphore));
+        VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
 
-        /* Descriptor set tracking */
+        renderer->vkCmdCopyBuffer(
+            vulkanCommandBuffer->commandBuffer,
+            srcBuffer->buffer,
+            regionBuffers[runStart]->buffer,
+            i - runStart,
+            &bufferCopies[runStart]);
 
-        commandBuffer->boundDescriptorSetDataCapacity = 16;
-        commandBuffer->boundDescriptorSetDataCount = 0;
-        commandBuffer->boundDescriptorSetDatas = SDL_malloc(
-            commandBuffer->boundDescriptorSetDataCapacity * sizeof(DescriptorSetData));
+        runStart = i;
+    }
 
-        /* Resource bind tracking */
+    for (i = 0; i < sourceBufferCount; i += 1) {
+        VULKAN_INTERNAL_BufferTransitionToDefaultUsage(
+            renderer,
+            vulkanCommandBuffer,
+            VULKAN_BUFFER_USAGE_MODE_COPY_SOURCE,
+            sourceBuffers[i]);
 
-        commandBuffer->needNewVertexResourceDescriptorSet = SDL_TRUE;
-        commandBuffer->needNewVertexUniformDescriptorSet = SDL_TRUE;
-        commandBuffer->needNewVertexUniformOffsets = SDL_TRUE;
-        commandBuffer->needNewFragmentResourceDescriptorSet = SDL_TRUE;
-        commandBuffer->needNewFragmentUniformDescriptorSet = SDL_TRUE;
-        commandBuffer->needNewFragmentUniformOffsets = SDL_TRUE;
+        VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, sourceBuffers[i]);
+    }
 
-        commandBuffer->needNewComputeReadWriteDescriptorSet = SDL_TRUE;
-        commandBuffer->needNewComputeReadOnlyDescriptorSet = SDL_TRUE;
-        commandBuffer->needNewComputeUniformDescriptorSet = SDL_TRUE;
-        commandBuffer->needNewComputeUniformOffsets = SDL_TRUE;
+    for (i = 0; i < preparedBufferCount; i += 1) {
+        VULKAN_INTERNAL_BufferTransitionToDefaultUsage(
+            renderer,
+            vulkanCommandBuffer,
+            VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
+            preparedBuffers[i]);
 
-        commandBuffer->vertexResourceDescriptorSet = VK_NULL_HANDLE;
-        commandBuffer->vertexUniformDescriptorSet = VK_NULL_HANDLE;
-        commandBuffer->fragmentResourceDescriptorSet = VK_NULL_HANDLE;
-        commandBuffer->fragmentUniformDescriptorSet = VK_NULL_HANDLE;
+        VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, preparedBuffers[i]);
+    }
 
-        commandBuffer->computeReadOnlyDescriptorSet = VK_NULL_HANDLE;
-        commandBuffer->computeReadWriteDescriptorSet = VK_NULL_HANDLE;
-        commandBuffer->computeUniformDescriptorSet = VK_NULL_HANDLE;
+    SDL_free(preparedBuffers);
+    SDL_free(sourceBuffers);
+    SDL_free(regionBuffers);
+    SDL_free(bufferCopies);
+}
 
-        /* Resource tracking */
+static VulkanComputePipeline *VULKAN_INTERNAL_FetchMipmapPipeline(
+    VulkanRenderer *renderer,
+    Uint32 formatIndex,
+    Uint32 outputCount)
+{
+    Refresh_ComputePipelineCreateInfo pipelineCreateInfo;
+    VulkanComputePipeline *pipeline;
+    size_t codeSize = MipmapDownsampleCodeSize[outputCount - 1];
+    Uint32 *code;
+    Uint32 i;
 
-        commandBuffer->usedBufferCapacity = 4;
-        commandBuffer->usedBufferCount = 0;
-        commandBuffer->usedBuffers = SDL_malloc(
-            commandBuffer->usedBufferCapacity * sizeof(VulkanBuffer *));
+    SDL_LockMutex(renderer->mipmapPipelineLock);
 
-        commandBuffer->usedTextureSliceCapacity = 4;
-        commandBuffer->usedTextureSliceCount = 0;
-        commandBuffer->usedTextureSlices = SDL_malloc(
-            commandBuffer->usedTextureSliceCapacity * sizeof(VulkanTextureSlice *));
+    pipeline = renderer->mipmapPipelines[formatIndex][outputCount - 1];
 
-        commandBuffer->usedSamplerCapacity = 4;
-        commandBuffer->usedSamplerCount = 0;
-        commandBuffer->usedSamplers = SDL_malloc(
-            commandBuffer->usedSamplerCapacity * sizeof(VulkanSampler *));
+    if (pipeline == NULL && !renderer->mipmapPipelineFailed[formatIndex][outputCount - 1]) {
+        code = SDL_malloc(codeSize);
 
-        commandBuffer->usedGraphicsPipelineCapacity = 4;
-        commandBuffer->usedGraphicsPipelineCount = 0;
-        commandBuffer->usedGraphicsPipelines = SDL_malloc(
-            commandBuffer->usedGraphicsPipelineCapacity * sizeof(VulkanGraphicsPipeline *));
+        if (code != NULL) {
+            SDL_memcpy(code, MipmapDownsampleCode[outputCount - 1], codeSize);
 
-        commandBuffer->usedComputePipelineCapacity = 4;
-        commandBuffer->usedComputePipelineCount = 0;
-        commandBuffer->usedComputePipelines = SDL_malloc(
-            commandBuffer->usedComputePipelineCapacity * sizeof(VulkanComputePipeline *));
+            /* Patch the format, the last word, of every OpTypeImage in the shader */
+            for (i = 5; i < codeSize / sizeof(Uint32) && (code[i] >> 16) > 0; i += code[i] >> 16) {
+                if ((code[i] & 0xFFFF) == 25 && (code[i] >> 16) >= 9) {
+                    code[i + 8] = MipmapDownsampleSpvFormats[formatIndex];
+                }
+            }
 
-        commandBuffer->usedFramebufferCapacity = 4;
-        commandBuffer->usedFramebufferCount = 0;
-        commandBuffer->usedFramebuffers = SDL_malloc(
-            commandBuffer->usedFramebufferCapacity * sizeof(VulkanFramebuffer *));
+            pipelineCreateInfo.codeSize = codeSize;
+            pipelineCreateInfo.code = (Uint8 *)code;
+            pipelineCreateInfo.entryPointName = "main";
+            pipelineCreateInfo.format = REFRESH_SHADERFORMAT_SPIRV;
+            pipelineCreateInfo.readOnlyStorageTextureCount = 1;
+            pipelineCreateInfo.readOnlyStorageBufferCount = 0;
+            pipelineCreateInfo.readWriteStorageTextureCount = outputCount;
+            pipelineCreateInfo.readWriteStorageBufferCount = 0;
+            pipelineCreateInfo.uniformBufferCount = 1;
+            pipelineCreateInfo.threadCountX = 8;
+            pipelineCreateInfo.threadCountY = 8;
+            pipelineCreateInfo.threadCountZ = 1;
+
+            pipeline = (VulkanComputePipeline *)VULKAN_CreateComputePipeline(
+                (Refresh_Renderer *)renderer,
+                &pipelineCreateInfo);
 
-        commandBuffer->usedUniformBufferCapacity = 4;
-        commandBuffer->usedUniformBufferCount = 0;
-        commandBuffer->usedUniformBuffers = SDL_malloc(
-            commandBuffer->usedUniformBufferCapacity * sizeof(VulkanUniformBuffer *));
+            SDL_free(code);
+        }
 
-        /* Pool it! */
+        /* Don't retry every frame, the blit path covers this format from now on */
+        if (pipeline == NULL) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to create mipmap pipeline, falling back to blits");
+            renderer->mipmapPipelineFailed[formatIndex][outputCount - 1] = 1;
+        }
 
-        vulkanCommandPool->inactiveCommandBuffers[vulkanCommandPool->inactiveCommandBufferCount] = commandBuffer;
-        vulkanCommandPool->inactiveCommandBufferCount += 1;
+        renderer->mipmapPipelines[formatIndex][outputCount - 1] = pipeline;
     }
 
-    SDL_stack_free(commandBuffers);
+    SDL_UnlockMutex(renderer->mipmapPipelineLock);
+
+    return pipeline;
 }
 
-static VulkanCommandPool *VULKAN_INTERNAL_FetchCommandPool(
+/* Downsamples up to MIPMAP_LEVELS_PER_DISPATCH levels of a layer per dispatch,
+ * so the intermediate levels stay in shared memory instead of round-tripping through the image.
+ * Returns 0 without recording anything if the texture can't be written by compute.
+ */
+static Uint8 VULKAN_INTERNAL_GenerateMipmapsWithCompute(
     VulkanRenderer *renderer,
-    SDL_threadID threadID)
+    VulkanCommandBuffer *vulkanCommandBuffer,
+    VulkanTextureContainer *textureContainer,
+    VkFormatFeatureFlags formatFeatures,
+    Refresh_Filter filterMode)
 {
-    VulkanCommandPool *vulkanCommandPool;
-    VkCommandPoolCreateInfo commandPoolCreateInfo;
-    VkResult vulkanResult;
-    CommandPoolHash commandPoolHash;
+    VulkanTexture *vulkanTexture = textureContainer->activeTextureHandle->vulkanTexture;
+    VulkanComputePipeline *pipelines[MIPMAP_LEVELS_PER_DISPATCH];
+    Refresh_StorageTextureReadWriteBinding destinationBindings[MIPMAP_LEVELS_PER_DISPATCH];
+    Refresh_TextureSlice sourceSlice;
+    Uint32 uniforms[4];
+    Uint32 formatIndex, layer, level, outputCount, width, height, i;
 
-    commandPoolHash.threadID = threadID;
+    if (
+        vulkanTexture->is3D ||
+        vulkanTexture->sampleCount > VK_SAMPLE_COUNT_1_BIT ||
+        !(vulkanTexture->usageFlags & REFRESH_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE_BIT) ||
+        !(formatFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT)) {
+        return 0;
+    }
 
-    vulkanCommandPool = CommandPoolHashTable_Fetch(
-        &renderer->commandPoolHashTable,
-        commandPoolHash);
+    for (formatIndex = 0; formatIndex < MIPMAP_FORMAT_COUNT; formatIndex += 1) {
+        if (MipmapDownsampleFormats[formatIndex] == vulkanTexture->format) {
+            break;
+        }
+    }
 
-    if (vulkanCommandPool != NULL) {
-        return vulkanCommandPool;
+    if (formatIndex == MIPMAP_FORMAT_COUNT) {
+        return 0;
     }
 
-    vulkanCommandPool = (VulkanCommandPool *)SDL_malloc(sizeof(VulkanCommandPool));
+    /* Every dispatch writes a full batch except for a possible remainder at the tail */
+    for (level = 1; level < vulkanTexture->levelCount; level += outputCount) {
+        outputCount = SDL_min(vulkanTexture->levelCount - level, MIPMAP_LEVELS_PER_DISPATCH);
+        pipelines[outputCount - 1] = VULKAN_INTERNAL_FetchMipmapPipeline(renderer, formatIndex, outputCount);
 
-    commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    commandPoolCreateInfo.pNext = NULL;
-    commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    commandPoolCreateInfo.queueFamilyIndex = renderer->queueFamilyIndex;
+        if (pipelines[outputCount - 1] == NULL) {
+            return 0;
+        }
+    }
 
-    vulkanResult = renderer->vkCreateCommandPool(
-        renderer->logicalDevice,
-        &commandPoolCreateInfo,
-        NULL,
-        &vulkanCommandPool->commandPool);
+    for (layer = 0; layer < vulkanTexture->layerCount; layer += 1) {
+        for (level = 1; level < vulkanTexture->levelCount; level += outputCount) {
+            outputCount = SDL_min(vulkanTexture->levelCount - level, MIPMAP_LEVELS_PER_DISPATCH);
 
-    if (vulkanResult != VK_SUCCESS) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create command pool!");
-        LogVulkanResultAsError("vkCreateCommandPool", vulkanResult);
-        return NULL;
-    }
+            for (i = 0; i < outputCount; i += 1) {
+                destinationBindings[i].textureSlice.texture = (Refresh_Texture *)textureContainer;
+                destinationBindings[i].textureSlice.mipLevel = level + i;
+                destinationBindings[i].textureSlice.layer = layer;
+                destinationBindings[i].cycle = SDL_FALSE;
+            }
 
-    vulkanCommandPool->threadID = threadID;
+            sourceSlice.texture = (Refresh_Texture *)textureContainer;
+            sourceSlice.mipLevel = level - 1;
+            sourceSlice.layer = layer;
 
-    vulkanCommandPool->inactiveCommandBufferCapacity = 0;
-    vulkanCommandPool->inactiveCommandBufferCount = 0;
-    vulkanCommandPool->inactiveCommandBuffers = NULL;
+            width = SDL_max(vulkanTexture->dimensions.width >> (level - 1), 1);
+            height = SDL_max(vulkanTexture->dimensions.height >> (level - 1), 1);
 
-    VULKAN_INTERNAL_AllocateCommandBuffers(
-        renderer,
-        vulkanCommandPool,
-        2);
+            uniforms[0] = width;
+            uniforms[1] = height;
+            uniforms[2] = filterMode == REFRESH_FILTER_NEAREST;
+            uniforms[3] = 0;
 
-    CommandPoolHashTable_Insert(
-        &renderer->commandPoolHashTable,
-        commandPoolHash,
-        vulkanCommandPool);
+            VULKAN_BeginComputePass(
+                (Refresh_CommandBuffer *)vulkanCommandBuffer,
+                destinationBindings,
+                outputCount,
+                NULL,
+                0);
 
-    return vulkanCommandPool;
-}
+            VULKAN_BindComputePipeline(
+                (Refresh_CommandBuffer *)vulkanCommandBuffer,
+                (Refresh_ComputePipeline *)pipelines[outputCount - 1]);
 
-static VulkanCommandBuffer *VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(
-    VulkanRenderer *renderer,
-    SDL_threadID threadID)
-{
-    VulkanCommandPool *commandPool =
-        VULKAN_INTERNAL_FetchCommandPool(renderer, threadID);
-    VulkanCommandBuffer *commandBuffer;
+            VULKAN_BindComputeStorageTextures(
+                (Refresh_CommandBuffer *)vulkanCommandBuffer,
+                0,
+                &sourceSlice,
+                1);
 
-    if (commandPool == NULL) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to fetch command pool!");
-        return NULL;
-    }
+            VULKAN_PushComputeUniformData(
+                (Refresh_CommandBuffer *)vulkanCommandBuffer,
+                0,
+                uniforms,
+                sizeof(uniforms));
+
+            /* One 8x8 workgroup per 8x8 block of the first level written */
+            VULKAN_DispatchCompute(
+                (Refresh_CommandBuffer *)vulkanCommandBuffer,
+                (SDL_max(width >> 1, 1) + 7) / 8,
+                (SDL_max(height >> 1, 1) + 7) / 8,
+                1);
 
-    if (commandPool->inactiveCommandBufferCount == 0) {
-        VULKAN_INTERNAL_AllocateCommandBuffers(
-            renderer,
-            commandPool,
-            commandPool->inactiveCommandBufferCapacity);
+            VULKAN_EndComputePass((Refresh_CommandBuffer *)vulkanCommandBuffer);
+        }
     }
 
-    commandBuffer = commandPool->inactiveCommandBuffers[commandPool->inactiveCommandBufferCount - 1];
-    commandPool->inactiveCommandBufferCount -= 1;
-
-    return commandBuffer;
+    return 1;
 }
 
-static Refresh_CommandBuffer *VULKAN_AcquireCommandBuffer(
-    Refresh_Renderer *driverData)
+static void VULKAN_GenerateMipmaps(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_Texture *texture,
+    Refresh_Filter filterMode)
 {
-    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
-    VkResult result;
-    Uint32 i;
-
-    SDL_threadID threadID = SDL_ThreadID();
-
-    SDL_LockMutex(renderer->acquireCommandBufferLock);
-
-    VulkanCommandBuffer *commandBuffer =
-        VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(renderer, threadID);
-
-    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
+    VulkanTexture *vulkanTexture = ((VulkanTextureContainer *)texture)->activeTextureHandle->vulkanTexture;
+    VulkanTextureSlice *textureSlice;
+    VkFormatProperties formatProperties;
+    VkFilter filter;
+    VkImageBlit blit;
+    Uint32 layer, level;
 
-    if (commandBuffer == NULL) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire command buffer!");
-        return NULL;
+    if (vulkanTexture->levelCount <= 1) {
+        return;
     }
 
-    /* Reset state */
-
-    commandBuffer->currentComputePipeline = NULL;
-    commandBuffer->currentGraphicsPipeline = NULL;
+    renderer->vkGetPhysicalDeviceFormatProperties(
+        renderer->physicalDevice,
+        vulkanTexture->format,
+        &formatProperties);
 
-    for (i = 0; i < MAX_COLOR_TARGET_BINDINGS; i += 1) {
-        commandBuffer->colorAttachmentSlices[i] = NULL;
+    if (VULKAN_COMPUTE_MIPMAPS &&
+        VULKAN_INTERNAL_GenerateMipmapsWithCompute(
+            renderer,
+            vulkanCommandBuffer,
+            (VulkanTextureContainer *)texture,
+            formatProperties.optimalTilingFeatures,
+            filterMode)) {
+        return;
     }
 
-    for (i = 0; i < MAX_UNIFORM_BUFFERS_PER_STAGE; i += 1) {
-        commandBuffer->vertexUniformBuffers[i] = NULL;
-        commandBuffer->fragmentUniformBuffers[i] = NULL;
-        commandBuffer->computeUniformBuffers[i] = NULL;
+    /* Linear blits are only valid on formats that support linear filtering (not integer formats, for instance) */
+    if (
+        filterMode == REFRESH_FILTER_LINEAR &&
+        (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT)) {
+        filter = VK_FILTER_LINEAR;
+    } else {
+        filter = VK_FILTER_NEAREST;
     }
 
-    commandBuffer->depthStencilAttachmentSlice = NULL;
+    /* Each level depends on the previous one, but every layer of a level can be
+     * transitioned in a single barrier batch and downsampled with a single blit.
+     */
+    for (level = 1; level < vulkanTexture->levelCount; level += 1) {
+        for (layer = 0; layer < vulkanTexture->layerCount; layer += 1) {
+            VULKAN_INTERNAL_TextureTransitionFromDefaultUsage(
+                renderer,
+                vulkanCommandBuffer,
+                VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
+                VULKAN_INTERNAL_FetchTextureSlice(vulkanTexture, layer, level - 1));
 
-    commandBuffer->needNewVertexResourceDescriptorSet = SDL_TRUE;
-    commandBuffer->needNewVertexUniformDescriptorSet = SDL_TRUE;
-    commandBuffer->needNewVertexUniformOffsets = SDL_TRUE;
-    commandBuffer->needNewFragmentResourceDescriptorSet = SDL_TRUE;
-    commandBuffer->needNewFragmentUniformDescriptorSet = SDL_TRUE;
-    commandBuffer->needNewFragmentUniformOffsets = SDL_TRUE;
+            VULKAN_INTERNAL_TextureTransitionFromDefaultUsage(
+                renderer,
+                vulkanCommandBuffer,
+                VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
+                VULKAN_INTERNAL_FetchTextureSlice(vulkanTexture, layer, level));
+        }
 
-    commandBuffer->needNewComputeReadOnlyDescriptorSet = SDL_TRUE;
-    commandBuffer->needNewComputeUniformDescriptorSet = SDL_TRUE;
-    commandBuffer->needNewComputeUniformOffsets = SDL_TRUE;
+        blit.srcOffsets[0].x = 0;
+        blit.srcOffsets[0].y = 0;
+        blit.srcOffsets[0].z = 0;
 
-    commandBuffer->vertexResourceDescriptorSet = VK_NULL_HANDLE;
-    commandBuffer->vertexUniformDescriptorSet = VK_NULL_HANDLE;
-    commandBuffer->fragmentResourceDescriptorSet = VK_NULL_HANDLE;
-    commandBuffer->fragmentUniformDescriptorSet = VK_NULL_HANDLE;
+        blit.srcOffsets[1].x = SDL_max(vulkanTexture->dimensions.width >> (level - 1), 1);
+        blit.srcOffsets[1].y = SDL_max(vulkanTexture->dimensions.height >> (level - 1), 1);
+        blit.srcOffsets[1].z = vulkanTexture->is3D ? SDL_max(vulkanTexture->depth >> (level - 1), 1) : 1;
 
-    commandBuffer->computeReadOnlyDescriptorSet = VK_NULL_HANDLE;
-    commandBuffer->computeReadWriteDescriptorSet = VK_NULL_HANDLE;
-    commandBuffer->computeUniformDescriptorSet = VK_NULL_HANDLE;
+        blit.dstOffsets[0].x = 0;
+        blit.dstOffsets[0].y = 0;
+        blit.dstOffsets[0].z = 0;
 
-    SDL_zeroa(commandBuffer->vertexSamplerTextures);
-    SDL_zeroa(commandBuffer->vertexSamplers);
-    SDL_zeroa(commandBuffer->vertexStorageTextureSlices);
-    SDL_zeroa(commandBuffer->vertexStorageBuffers);
+        blit.dstOffsets[1].x = SDL_max(vulkanTexture->dimensions.width >> level, 1);
+        blit.dstOffsets[1].y = SDL_max(vulkanTexture->dimensions.height >> level, 1);
+        blit.dstOffsets[1].z = vulkanTexture->is3D ? SDL_max(vulkanTexture->depth >> level, 1) : 1;
 
-    SDL_zeroa(commandBuffer->fragmentSamplerTextures);
-    SDL_zeroa(commandBuffer->fragmentSamplers);
-    SDL_zeroa(commandBuffer->fragmentStorageTextureSlices);
-    SDL_zeroa(commandBuffer->fragmentStorageBuffers);
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.baseArrayLayer = 0;
+        blit.srcSubresource.layerCount = vulkanTexture->layerCount;
+        blit.srcSubresource.mipLevel = level - 1;
 
-    SDL_zeroa(commandBuffer->readWriteComputeStorageTextureSlices);
-    SDL_zeroa(commandBuffer->readWriteComputeStorageBuffers);
-    SDL_zeroa(commandBuffer->readOnlyComputeStorageTextureSlices);
-    SDL_zeroa(commandBuffer->readOnlyComputeStorageBuffers);
+        blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.dstSubresource.baseArrayLayer = 0;
+        blit.dstSubresource.layerCount = vulkanTexture->layerCount;
+        blit.dstSubresource.mipLevel = level;
 
-    commandBuffer->autoReleaseFence = 1;
+        VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
 
-    commandBuffer->isDefrag = 0;
+        renderer->vkCmdBlitImage(
+            vulkanCommandBuffer->commandBuffer,
+            vulkanTexture->image,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            vulkanTexture->image,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1,
+            &blit,
+            filter);
 
-    /* Reset the command buffer here to avoid resets being called
-     * from a separate thread than where the command buffer was acquired
-     */
-    result = renderer->vkResetCommandBuffer(
-        commandBuffer->commandBuffer,
-        VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
+        /* The queued transitions back to default usage fold into the next level's batch */
+        for (layer = 0; layer < vulkanTexture->layerCount; layer += 1) {
+            textureSlice = VULKAN_INTERNAL_FetchTextureSlice(vulkanTexture, layer, level - 1);
 
-    if (result != VK_SUCCESS) {
-        LogVulkanResultAsError("vkResetCommandBuffer", result);
-    }
+            VULKAN_INTERNAL_TextureTransitionToDefaultUsage(
+                renderer,
+                vulkanCommandBuffer,
+                VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
+                textureSlice);
 
-    VULKAN_INTERNAL_BeginCommandBuffer(renderer, commandBuffer);
+            VULKAN_INTERNAL_TrackTextureSlice(vulkanCommandBuffer, textureSlice);
 
-    return (Refresh_CommandBuffer *)commandBuffer;
+            textureSlice = VULKAN_INTERNAL_FetchTextureSlice(vulkanTexture, layer, level);
+
+            VULKAN_INTERNAL_TextureTransitionToDefaultUsage(
+                renderer,
+                vulkanCommandBuffer,
+                VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
+                textureSlice);
+
+            VULKAN_INTERNAL_TrackTextureSlice(vulkanCommandBuffer, textureSlice);
+        }
+    }
 }
 
-static SDL_bool VULKAN_QueryFence(
-    Refresh_Renderer *driverData,
-    Refresh_Fence *fence)
+static void VULKAN_EndCopyPass(
+    Refresh_CommandBuffer *commandBuffer)
 {
-    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
-    VkResult result;
+    /* no-op */
+    (void)commandBuffer;
+}
 
-    result = renderer->vkGetFenceStatus(
-        renderer->logicalDevice,
-        ((VulkanFenceHandle *)fence)->fence);
+static void VULKAN_Blit(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_TextureRegion *source,
+    Refresh_TextureRegion *destination,
+    Refresh_Filter filterMode,
+    SDL_bool cycle)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
+    VulkanTextureContainer *sourceTextureContainer = (VulkanTextureContainer *)source->textureSlice.texture;
+    VkImageBlit region;
 
-    if (result == VK_SUCCESS) {
-        return 1;
-    } else if (result == VK_NOT_READY) {
-        return 0;
-    } else {
-        LogVulkanResultAsError("vkGetFenceStatus", result);
-        return 0;
+    if ((sourceTextureContainer->activeTextureHandle->vulkanTexture->usageFlags & REFRESH_TEXTUREUSAGE_SAMPLER_BIT) == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Blit source texture must be created with SAMPLER bit!");
+        return;
     }
-}
 
-static void VULKAN_INTERNAL_ReturnFenceToPool(
-    VulkanRenderer *renderer,
-    VulkanFenceHandle *fenceHandle)
-{
-    SDL_LockMutex(renderer->fencePool.lock);
+    VulkanTextureSlice *srcTextureSlice = VULKAN_INTERNAL_FetchTextureSlice(
+        sourceTextureContainer->activeTextureHandle->vulkanTexture,
+        source->textureSlice.layer,
+        source->textureSlice.mipLevel);
 
-    EXPAND_ARRAY_IF_NEEDED(
-        renderer->fencePool.availableFences,
-        VulkanFenceHandle *,
-        renderer->fencePool.availableFenceCount + 1,
-        renderer->fencePool.availableFenceCapacity,
-        renderer->fencePool.availableFenceCapacity * 2);
+    VulkanTextureSlice *dstTextureSlice = VULKAN_INTERNAL_PrepareTextureSliceForWrite(
+        renderer,
+        vulkanCommandBuffer,
+        (VulkanTextureContainer *)destination->textureSlice.texture,
+        destination->textureSlice.layer,
+        destination->textureSlice.mipLevel,
+        cycle,
+        VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION);
 
-    renderer->fencePool.availableFences[renderer->fencePool.availableFenceCount] = fenceHandle;
-    renderer->fencePool.availableFenceCount += 1;
+    VULKAN_INTERNAL_TextureTransitionFromDefaultUsage(
+        renderer,
+        vulkanCommandBuffer,
+        VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
+        srcTextureSlice);
 
-    SDL_UnlockMutex(renderer->fencePool.lock);
-}
+    region.srcSubresource.aspectMask = srcTextureSlice->parent->aspectFlags;
+    region.srcSubresource.baseArrayLayer = srcTextureSlice->layer;
+    region.srcSubresource.layerCount = 1;
+    region.srcSubresource.mipLevel = srcTextureSlice->level;
+    region.srcOffsets[0].x = source->x;
+    region.srcOffsets[0].y = source->y;
+    region.srcOffsets[0].z = source->z;
+    region.srcOffsets[1].x = source->x + source->w;
+    region.srcOffsets[1].y = source->y + source->h;
+    region.srcOffsets[1].z = source->z + source->d;
 
-static void VULKAN_ReleaseFence(
-    Refresh_Renderer *driverData,
-    Refresh_Fence *fence)
-{
-    VulkanFenceHandle *handle = (VulkanFenceHandle *)fence;
+    region.dstSubresource.aspectMask = dstTextureSlice->parent->aspectFlags;
+    region.dstSubresource.baseArrayLayer = dstTextureSlice->layer;
+    region.dstSubresource.layerCount = 1;
+    region.dstSubresource.mipLevel = dstTextureSlice->level;
+    region.dstOffsets[0].x = destination->x;
+    region.dstOffsets[0].y = destination->y;
+    region.dstOffsets[0].z = destination->z;
+    region.dstOffsets[1].x = destination->x + destination->w;
+    region.dstOffsets[1].y = destination->y + destination->h;
+    region.dstOffsets[1].z = destination->z + destination->d;
 
-    if (SDL_AtomicDecRef(&handle->referenceCount)) {
-        VULKAN_INTERNAL_ReturnFenceToPool((VulkanRenderer *)driverData, handle);
-    }
-}
+    VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
 
-static WindowData *VULKAN_INTERNAL_FetchWindowData(
-    SDL_Window *window)
-{
-    return (WindowData *)SDL_GetWindowData(window, WINDOW_PROPERTY_DATA);
+    renderer->vkCmdBlitImage(
+        vulkanCommandBuffer->commandBuffer,
+        srcTextureSlice->parent->image,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        dstTextureSlice->parent->image,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        1,
+        &region,
+        RefreshToVK_Filter[filterMode]);
+
+    VULKAN_INTERNAL_TextureTransitionToDefaultUsage(
+        renderer,
+        vulkanCommandBuffer,
+        VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
+        srcTextureSlice);
+
+    VULKAN_INTERNAL_TextureTransitionToDefaultUsage(
+        renderer,
+        vulkanCommandBuffer,
+        VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
+        dstTextureSlice);
+
+    VULKAN_INTERNAL_TrackTextureSlice(vulkanCommandBuffer, srcTextureSlice);
+    VULKAN_INTERNAL_TrackTextureSlice(vulkanCommandBuffer, dstTextureSlice);
 }
 
-static SDL_bool VULKAN_SupportsSwapchainComposition(
-    Refresh_Renderer *driverData,
-    SDL_Window *window,
-    Refresh_SwapchainComposition swapchainComposition)
+static void VULKAN_INTERNAL_AllocateCommandBuffers(
+    VulkanRenderer *renderer,
+    VulkanCommandPool *vulkanCommandPool,
+    Uint32 allocateCount,
+    VkCommandBufferLevel level)
 {
-    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
-    
-    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
-    VkSurfaceKHR surface;
-    SwapchainSupportDetails supportDetails;
-    SDL_bool destroySurface = SDL_FALSE;
-    SDL_bool result = SDL_FALSE;
+    VkCommandBufferAllocateInfo allocateInfo;
+    VkResult vulkanResult;
     Uint32 i;
+    VkCommandBuffer *commandBuffers = SDL_stack_alloc(VkCommandBuffer, allocateCount);
+    VulkanCommandBuffer *commandBuffer;
 
-    if (windowData == NULL || windowData->swapchainData == NULL) {
-        /* Create a dummy surface is the window is not claimed */
-        destroySurface = SDL_TRUE;
-        
-        if (!SDL_Vulkan_CreateSurface(
-                window,
-                renderer->instance,
-                &surface)) {
-            return SDL_FALSE;
-        }
+    if (level == VK_COMMAND_BUFFER_LEVEL_PRIMARY) {
+        vulkanCommandPool->inactiveCommandBufferCapacity += allocateCount;
+
+        vulkanCommandPool->inactiveCommandBuffers = SDL_realloc(
+            vulkanCommandPool->inactiveCommandBuffers,
+            sizeof(VulkanCommandBuffer *) *
+                vulkanCommandPool->inactiveCommandBufferCapacity);
     } else {
-        surface = windowData->swapchainData->surface;
+        vulkanCommandPool->inactiveSecondaryCommandBufferCapacity += allocateCount;
+
+        vulkanCommandPool->inactiveSecondaryCommandBuffers = SDL_realloc(
+            vulkanCommandPool->inactiveSecondaryCommandBuffers,
+            sizeof(VulkanCommandBuffer *) *
+                vulkanCommandPool->inactiveSecondaryCommandBufferCapacity);
     }
 
-    if (VULKAN_INTERNAL_QuerySwapchainSupport(
-            renderer,
-            renderer->physicalDevice,
-            surface,
-            &supportDetails)) {
-        for (i = 0; i < supportDetails.formatsLength; i += 1) {
-            if (supportDetails.formats[i].format == SwapchainCompositionToFormat[swapchainComposition] &&
-                supportDetails.formats[i].colorSpace == SwapchainCompositionToColorSpace[swapchainComposition]) {
-                result = SDL_TRUE;
-                break;
-            }
-        }
+    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocateInfo.pNext = NULL;
+    allocateInfo.commandPool = vulkanCommandPool->commandPool;
+    allocateInfo.commandBufferCount = allocateCount;
+    allocateInfo.level = level;
 
-        SDL_free(supportDetails.formats);
-        SDL_free(supportDetails.presentModes);
+    vulkanResult = renderer->vkAllocateCommandBuffers(
+        renderer->logicalDevice,
+        &allocateInfo,
+        commandBuffers);
+
+    if (vulkanResult != VK_SUCCESS) {
+        LogVulkanResultAsError("vkAllocateCommandBuffers", vulkanResult);
+        SDL_stack_free(commandBuffers);
+        return;
     }
 
-    if (destroySurface) {
-        renderer->vkDestroySurfaceKHR(
-            renderer->instance,
-            surface,
-            NULL);
-    }
+    for (i = 0; i < allocateCount; i += 1) {
+        commandBuffer = SDL_malloc(sizeof(VulkanCommandBuffer));
+        commandBuffer->renderer = renderer;
+        commandBuffer->commandPool = vulkanCommandPool;
+        commandBuffer->commandBuffer = commandBuffers[i];
+        commandBuffer->level = level;
 
-    return result;
-}
+        commandBuffer->inFlightFence = VK_NULL_HANDLE;
 
-static SDL_bool VULKAN_SupportsPresentMode(
-    Refresh_Renderer *driverData,
-    SDL_Window *window,
-    Refresh_PresentMode presentMode)
-{
-    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
-    
-    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
-    VkSurfaceKHR surface;
-    SwapchainSupportDetails supportDetails;
-    SDL_bool destroySurface = SDL_FALSE;
-    SDL_bool result = SDL_FALSE;
-    Uint32 i;
+        /* Presentation tracking */
 
-    if (windowData == NULL || windowData->swapchainData == NULL) {
-        /* Create a dummy surface is the window is not claimed */
-        destroySurface = SDL_TRUE;
-        
-        if (!SDL_Vulkan_CreateSurface(
-                window,
-                renderer->instance,
-                &surface)) {
-            return SDL_FALSE;
-        }
-    } else {
-        surface = windowData->swapchainData->surface;
-    }
+        commandBuffer->presentDataCapacity = 1;
+        commandBuffer->presentDataCount = 0;
+        commandBuffer->presentDatas = SDL_malloc(
+            commandBuffer->presentDataCapacity * sizeof(VulkanPresentData));
 
-    if (VULKAN_INTERNAL_QuerySwapchainSupport(
-            renderer,
-            renderer->physicalDevice,
-            surface,
-            &supportDetails)) {
+        commandBuffer->waitSemaphoreCapacity = 1;
+        commandBuffer->waitSemaphoreCount = 0;
+        commandBuffer->waitSemaphores = SDL_malloc(
+            commandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore));
 
-        for (i = 0; i < supportDetails.presentModesLength; i += 1) {
-            if (supportDetails.presentModes[i] == RefreshToVK_PresentMode[presentMode]) {
-                result = SDL_TRUE;
-                break;
-            }
-        }
+        commandBuffer->signalSemaphoreCapacity = 1;
+        commandBuffer->signalSemaphoreCount = 0;
+        commandBuffer->signalSemaphores = SDL_malloc(
+            commandBuffer->signalSemaphoreCapacity * sizeof(VkSemaphore));
 
-        SDL_free(supportDetails.formats);
-        SDL_free(supportDetails.presentModes);
-    }
+        commandBuffer->asyncWaitSemaphoreCapacity = 1;
+        commandBuffer->asyncWaitSemaphoreCount = 0;
+        commandBuffer->asyncWaitSemaphores = SDL_malloc(
+            commandBuffer->asyncWaitSemaphoreCapacity * sizeof(VkSemaphore));
 
-    if (destroySurface) {
-        renderer->vkDestroySurfaceKHR(
-            renderer->instance,
-            surface,
-            NULL);
-    }
+        /* Descriptor set tracking */
 
-    return result;
-}
+        commandBuffer->boundDescriptorSetDataCapacity = 16;
+        commandBuffer->boundDescriptorSetDataCount = 0;
+        commandBuffer->boundDescriptorSetDatas = SDL_malloc(
+            commandBuffer->boundDescriptorSetDataCapacity * sizeof(DescriptorSetData));
 
-static SDL_bool VULKAN_ClaimWindow(
-    Refresh_Renderer *driverData,
-    SDL_Window *window,
-    Refresh_SwapchainComposition swapchainComposition,
-    Refresh_PresentMode presentMode)
-{
-    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
-    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
+        SDL_zero(commandBuffer->descriptorSetCache);
+        commandBuffer->descriptorSetWriteCount = 0;
+        commandBuffer->descriptorSetReuseCount = 0;
 
-    if (windowData == NULL) {
-        windowData = SDL_malloc(sizeof(WindowData));
-        windowData->window = window;
-        windowData->presentMode = presentMode;
-        windowData->swapchainComposition = swapchainComposition;
+        /* Resource bind tracking */
 
-        if (VULKAN_INTERNAL_CreateSwapchain(renderer, windowData)) {
-            SDL_SetWindowData(window, WINDOW_PROPERTY_DATA, windowData);
+        commandBuffer->needNewVertexResourceDescriptorSet = SDL_TRUE;
+        commandBuffer->needNewVertexUniformDescriptorSet = SDL_TRUE;
+        commandBuffer->needNewVertexUniformOffsets = SDL_TRUE;
+        commandBuffer->needNewFragmentResourceDescriptorSet = SDL_TRUE;
+        commandBuffer->needNewFragmentUniformDescriptorSet = SDL_TRUE;
+        commandBuffer->needNewFragmentUniformOffsets = SDL_TRUE;
 
-            if (renderer->claimedWindowCount >= renderer->claimedWindowCapacity) {
-                renderer->claimedWindowCapacity *= 2;
-                renderer->claimedWindows = SDL_realloc(
-                    renderer->claimedWindows,
-                    renderer->claimedWindowCapacity * sizeof(WindowData *));
-            }
+        commandBuffer->needNewComputeReadWriteDescriptorSet = SDL_TRUE;
+        commandBuffer->needNewComputeReadOnlyDescriptorSet = SDL_TRUE;
+        commandBuffer->needNewComputeUniformDescriptorSet = SDL_TRUE;
+        commandBuffer->needNewComputeUniformOffsets = SDL_TRUE;
 
-            renderer->claimedWindows[renderer->claimedWindowCount] = windowData;
-            renderer->claimedWindowCount += 1;
+        commandBuffer->vertexResourceDescriptorSet = VK_NULL_HANDLE;
+        commandBuffer->vertexUniformDescriptorSet = VK_NULL_HANDLE;
+        commandBuffer->fragmentResourceDescriptorSet = VK_NULL_HANDLE;
+        commandBuffer->fragmentUniformDescriptorSet = VK_NULL_HANDLE;
 
-            return 1;
-        } else {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not create swapchain, failed to claim window!");
-            SDL_free(windowData);
-            return 0;
-        }
-    } else {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Window already claimed!");
-        return 0;
-    }
-}
+        commandBuffer->computeReadOnlyDescriptorSet = VK_NULL_HANDLE;
+        commandBuffer->computeReadWriteDescriptorSet = VK_NULL_HANDLE;
+        commandBuffer->computeUniformDescriptorSet = VK_NULL_HANDLE;
 
-static void VULKAN_UnclaimWindow(
-    Refresh_Renderer *driverData,
-    SDL_Window *window)
-{
-    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
-    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
-    Uint32 i;
+        /* Resource tracking */
 
-    if (windowData == NULL) {
-        return;
-    }
+        commandBuffer->usedBufferCapacity = 4;
+        commandBuffer->usedBufferCount = 0;
+        commandBuffer->usedBuffers = SDL_malloc(
+            commandBuffer->usedBufferCapacity * sizeof(VulkanBuffer *));
 
-    if (windowData->swapchainData != NULL) {
-        VULKAN_Wait(driverData);
+        commandBuffer->usedTextureSliceCapacity = 4;
+        commandBuffer->usedTextureSliceCount = 0;
+        commandBuffer->usedTextureSlices = SDL_malloc(
+            commandBuffer->usedTextureSliceCapacity * sizeof(VulkanTextureSlice *));
 
-        for (i = 0; i < MAX_FRAMES_IN_FLIGHT; i += 1) {
-            if (windowData->swapchainData->inFlightFences[i] != NULL) {
-                VULKAN_ReleaseFence(
-                    driverData,
-                    (Refresh_Fence *)windowData->swapchainData->inFlightFences[i]);
-            }
-        }
+        commandBuffer->usedSamplerCapacity = 4;
+        commandBuffer->usedSamplerCount = 0;
+        commandBuffer->usedSamplers = SDL_malloc(
+            commandBuffer->usedSamplerCapacity * sizeof(VulkanSampler *));
 
-        VULKAN_INTERNAL_DestroySwapchain(
-            (VulkanRenderer *)driverData,
-            windowData);
-    }
+        commandBuffer->usedGraphicsPipelineCapacity = 4;
+        commandBuffer->usedGraphicsPipelineCount = 0;
+        commandBuffer->usedGraphicsPipelines = SDL_malloc(
+            commandBuffer->usedGraphicsPipelineCapacity * sizeof(VulkanGraphicsPipeline *));
 
-    for (i = 0; i < renderer->claimedWindowCount; i += 1) {
-        if (renderer->claimedWindows[i]->window == window) {
-            renderer->claimedWindows[i] = renderer->claimedWindows[renderer->claimedWindowCount - 1];
-            renderer->claimedWindowCount -= 1;
-            break;
-        }
-    }
+        commandBuffer->usedComputePipelineCapacity = 4;
+        commandBuffer->usedComputePipelineCount = 0;
+        commandBuffer->usedComputePipelines = SDL_malloc(
+            commandBuffer->usedComputePipelineCapacity * sizeof(VulkanComputePipeline *));
 
-    SDL_free(windowData);
+        commandBuffer->usedFramebufferCapacity = 4;
+        commandBuffer->usedFramebufferCount = 0;
+        commandBuffer->usedFramebuffers = SDL_malloc(
+            commandBuffer->usedFramebufferCapacity * sizeof(VulkanFramebuffer *));
 
-    SDL_SetWindowData(window, WINDOW_PROPERTY_DATA, NULL);
-}
+        commandBuffer->usedUniformBufferCapacity = 4;
+        commandBuffer->usedUniformBufferCount = 0;
+        commandBuffer->usedUniformBuffers = SDL_malloc(
+            commandBuffer->usedUniformBufferCapacity * sizeof(VulkanUniformBuffer *));
 
-static SDL_bool VULKAN_INTERNAL_RecreateSwapchain(
-    VulkanRenderer *renderer,
-    WindowData *windowData)
-{
-    Uint32 i;
+        commandBuffer->usedStagingBlockCapacity = 4;
+        commandBuffer->usedStagingBlockCount = 0;
+        commandBuffer->usedStagingBlocks = SDL_malloc(
+            commandBuffer->usedStagingBlockCapacity * sizeof(VulkanBufferContainer *));
 
-    if (windowData->swapchainData != NULL) {
-        VULKAN_Wait((Refresh_Renderer *)renderer);
+        /* Barrier batching */
 
-        for (i = 0; i < MAX_FRAMES_IN_FLIGHT; i += 1) {
-            if (windowData->swapchainData->inFlightFences[i] != NULL) {
-                VULKAN_ReleaseFence(
-                    (Refresh_Renderer *)renderer,
-                    (Refresh_Fence *)windowData->swapchainData->inFlightFences[i]);
-            }
-        }
-    }
+        commandBuffer->pendingBufferBarrierCapacity = 16;
+        commandBuffer->pendingBufferBarrierCount = 0;
+        commandBuffer->pendingBufferBarriers = SDL_malloc(
+            commandBuffer->pendingBufferBarrierCapacity * sizeof(VkBufferMemoryBarrier));
+        commandBuffer->pendingBufferBarrierStages = SDL_malloc(
+            commandBuffer->pendingBufferBarrierCapacity * sizeof(VulkanBarrierStages));
 
-    VULKAN_INTERNAL_DestroySwapchain(renderer, windowData);
-    return VULKAN_INTERNAL_CreateSwapchain(renderer, windowData);
-}
+        commandBuffer->pendingImageBarrierCapacity = 16;
+        commandBuffer->pendingImageBarrierCount = 0;
+        commandBuffer->pendingImageBarriers = SDL_malloc(
+            commandBuffer->pendingImageBarrierCapacity * sizeof(VkImageMemoryBarrier));
+        commandBuffer->pendingImageBarrierStages = SDL_malloc(
+            commandBuffer->pendingImageBarrierCapacity * sizeof(VulkanBarrierStages));
 
-static Refresh_Texture *VULKAN_AcquireSwapchainTexture(
-    Refresh_CommandBuffer *commandBuffer,
-    SDL_Window *window,
-    Uint32 *pWidth,
-    Uint32 *pHeight)
-{
-    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
-    VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
-    Uint32 swapchainImageIndex;
-    WindowData *windowData;
-    VulkanSwapchainData *swapchainData;
-    VkResult acquireResult = VK_SUCCESS;
-    VulkanTextureContainer *swapchainTextureContainer = NULL;
-    VulkanPresentData *presentData;
+        commandBuffer->barrierCount = 0;
+        commandBuffer->barrierBatchCount = 0;
+        commandBuffer->eliminatedBarrierCount = 0;
 
-    windowData = VULKAN_INTERNAL_FetchWindowData(window);
-    if (windowData == NULL) {
-        return NULL;
-    }
+        commandBuffer->usedQueryPoolCapacity = 4;
+        commandBuffer->usedQueryPoolCount = 0;
+        commandBuffer->usedQueryPools = SDL_malloc(
+            commandBuffer->usedQueryPoolCapacity * sizeof(VulkanQueryPool *));
 
-    swapchainData = windowData->swapchainData;
+        /* Parallel render pass tracking */
 
-    /* Window is claimed but swapchain is invalid! */
-    if (swapchainData == NULL) {
-        if (SDL_GetWindowFlags(window) & SDL_WINDOW_MINIMIZED) {
-            /* Window is minimized, don't bother */
-            return NULL;
-        }
+        commandBuffer->currentRenderPass = VK_NULL_HANDLE;
+        commandBuffer->currentFramebuffer = VK_NULL_HANDLE;
+        commandBuffer->parallelRenderPass = SDL_FALSE;
 
-        /* Let's try to recreate */
-        VULKAN_INTERNAL_RecreateSwapchain(renderer, windowData);
-        swapchainData = windowData->swapchainData;
+        commandBuffer->renderPassChunkCapacity = 4;
+        commandBuffer->renderPassChunkCount = 0;
+        commandBuffer->renderPassChunks = SDL_malloc(
+            commandBuffer->renderPassChunkCapacity * sizeof(VulkanCommandBuffer *));
+        commandBuffer->firstRenderPassChunk = 0;
 
-        if (swapchainData == NULL) {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to recreate swapchain!");
-            return NULL;
+        /* Pool it! */
+
+        if (level == VK_COMMAND_BUFFER_LEVEL_PRIMARY) {
+            vulkanCommandPool->inactiveCommandBuffers[vulkanCommandPool->inactiveCommandBufferCount] = commandBuffer;
+            vulkanCommandPool->inactiveCommandBufferCount += 1;
+        } else {
+            vulkanCommandPool->inactiveSecondaryCommandBuffers[vulkanCommandPool->inactiveSecondaryCommandBufferCount] = commandBuffer;
+            vulkanCommandPool->inactiveSecondaryCommandBufferCount += 1;
         }
     }
 
-    if (swapchainData->inFlightFences[swapchainData->frameCounter] != NULL) {
-        if (swapchainData->presentMode == VK_PRESENT_MODE_FIFO_KHR) {
-            /* In VSYNC mode, block until the least recent presented frame is done */
-            VULKAN_WaitForFences(
-                (Refresh_Renderer *)renderer,
-                SDL_TRUE,
-                (Refresh_Fence **)&swapchainData->inFlightFences[swapchainData->frameCounter],
-                1);
-        } else {
-            if (!VULKAN_QueryFence(
-                    (Refresh_Renderer *)renderer,
-                    (Refresh_Fence *)swapchainData->inFlightFences[swapchainData->frameCounter])) {
-                /*
-                 * In MAILBOX or IMMEDIATE mode, if the least recent fence is not signaled,
-                 * return NULL to indicate that rendering should be skipped
-                 */
-                return NULL;
-            }
-        }
+    SDL_stack_free(commandBuffers);
+}
 
-        VULKAN_ReleaseFence(
-            (Refresh_Renderer *)renderer,
-            (Refresh_Fence *)swapchainData->inFlightFences[swapchainData->frameCounter]);
+static VulkanCommandPool *VULKAN_INTERNAL_FetchCommandPool(
+    VulkanRenderer *renderer,
+    SDL_threadID threadID,
+    Refresh_QueueType queueType)
+{
+    VulkanCommandPool *vulkanCommandPool;
+    VkCommandPoolCreateInfo commandPoolCreateInfo;
+    VkResult vulkanResult;
+    CommandPoolHash commandPoolHash;
 
-        swapchainData->inFlightFences[swapchainData->frameCounter] = NULL;
+    commandPoolHash.threadID = threadID;
+    commandPoolHash.queueType = queueType;
+
+    vulkanCommandPool = CommandPoolHashTable_Fetch(
+        &renderer->commandPoolHashTable,
+        commandPoolHash);
+
+    if (vulkanCommandPool != NULL) {
+        return vulkanCommandPool;
     }
 
-    acquireResult = renderer->vkAcquireNextImageKHR(
+    vulkanCommandPool = (VulkanCommandPool *)SDL_malloc(sizeof(VulkanCommandPool));
+
+    commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolCreateInfo.pNext = NULL;
+    commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    commandPoolCreateInfo.queueFamilyIndex = renderer->queues[queueType].queueFamilyIndex;
+
+    vulkanResult = renderer->vkCreateCommandPool(
         renderer->logicalDevice,
-        swapchainData->swapchain,
-        UINT64_MAX,
-        swapchainData->imageAvailableSemaphore[swapchainData->frameCounter],
-        VK_NULL_HANDLE,
-        &swapchainImageIndex);
+        &commandPoolCreateInfo,
+        NULL,
+        &vulkanCommandPool->commandPool);
 
-    /* Acquisition is invalid, let's try to recreate */
-    if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR) {
-        VULKAN_INTERNAL_RecreateSwapchain(renderer, windowData);
-        swapchainData = windowData->swapchainData;
+    if (vulkanResult != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create command pool!");
+        LogVulkanResultAsError("vkCreateCommandPool", vulkanResult);
+        return NULL;
+    }
 
-        if (swapchainData == NULL) {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to recreate swapchain!");
-            return NULL;
-        }
+    vulkanCommandPool->threadID = threadID;
+    vulkanCommandPool->queue = &renderer->queues[queueType];
 
-        acquireResult = renderer->vkAcquireNextImageKHR(
-            renderer->logicalDevice,
-            swapchainData->swapchain,
-            UINT64_MAX,
-            swapchainData->imageAvailableSemaphore[swapchainData->frameCounter],
-            VK_NULL_HANDLE,
-            &swapchainImageIndex);
+    vulkanCommandPool->inactiveCommandBufferCapacity = 0;
+    vulkanCommandPool->inactiveCommandBufferCount = 0;
+    vulkanCommandPool->inactiveCommandBuffers = NULL;
 
-        if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR) {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire swapchain texture!");
-            return NULL;
-        }
+    /* Secondary command buffers are only allocated once a thread records a render pass chunk */
+    vulkanCommandPool->inactiveSecondaryCommandBufferCapacity = 0;
+    vulkanCommandPool->inactiveSecondaryCommandBufferCount = 0;
+    vulkanCommandPool->inactiveSecondaryCommandBuffers = NULL;
+
+    vulkanCommandPool->descriptorSetLock = SDL_CreateMutex();
+    SDL_zero(vulkanCommandPool->descriptorSetTable);
+
+    VULKAN_INTERNAL_AllocateCommandBuffers(
+        renderer,
+        vulkanCommandPool,
+        2,
+        VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+    CommandPoolHashTable_Insert(
+        &renderer->commandPoolHashTable,
+        commandPoolHash,
+        vulkanCommandPool);
+
+    return vulkanCommandPool;
+}
+
+static VulkanCommandBuffer *VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(
+    VulkanRenderer *renderer,
+    SDL_threadID threadID,
+    Refresh_QueueType queueType)
+{
+    VulkanCommandPool *commandPool =
+        VULKAN_INTERNAL_FetchCommandPool(renderer, threadID, queueType);
+    VulkanCommandBuffer *commandBuffer;
+
+    if (commandPool == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to fetch command pool!");
+        return NULL;
     }
 
-    swapchainTextureContainer = &swapchainData->textureContainers[swapchainImageIndex];
+    if (commandPool->inactiveCommandBufferCount == 0) {
+        VULKAN_INTERNAL_AllocateCommandBuffers(
+            renderer,
+            commandPool,
+            commandPool->inactiveCommandBufferCapacity,
+            VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+    }
 
-    /* We need a special execution dependency with pWaitDstStageMask or image transition can start before acquire finishes */
+    commandBuffer = commandPool->inactiveCommandBuffers[commandPool->inactiveCommandBufferCount - 1];
+    commandPool->inactiveCommandBufferCount -= 1;
 
-    VkImageMemoryBarrier imageBarrier;
-    imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    imageBarrier.pNext = NULL;
-    imageBarrier.srcAccessMask = 0;
-    imageBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageBarrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    imageBarrier.image = swapchainTextureContainer->activeTextureHandle->vulkanTexture->image;
-    imageBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    imageBarrier.subresourceRange.baseMipLevel = 0;
-    imageBarrier.subresourceRange.levelCount = 1;
-    imageBarrier.subresourceRange.baseArrayLayer = 0;
-    imageBarrier.subresourceRange.layerCount = 1;
+    return commandBuffer;
+}
 
-    renderer->vkCmdPipelineBarrier(
-        vulkanCommandBuffer->commandBuffer,
-        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        0,
-        0,
-        NULL,
-        0,
-        NULL,
-        1,
-        &imageBarrier);
+static VulkanCommandBuffer *VULKAN_INTERNAL_GetInactiveSecondaryCommandBufferFromPool(
+    VulkanRenderer *renderer,
+    SDL_threadID threadID)
+{
+    VulkanCommandPool *commandPool =
+        VULKAN_INTERNAL_FetchCommandPool(renderer, threadID, REFRESH_QUEUETYPE_GRAPHICS);
+    VulkanCommandBuffer *commandBuffer;
 
-    /* Set up present struct */
+    if (commandPool == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to fetch command pool!");
+        return NULL;
+    }
 
-    if (vulkanCommandBuffer->presentDataCount == vulkanCommandBuffer->presentDataCapacity) {
-        vulkanCommandBuffer->presentDataCapacity += 1;
-        vulkanCommandBuffer->presentDatas = SDL_realloc(
-            vulkanCommandBuffer->presentDatas,
-            vulkanCommandBuffer->presentDataCapacity * sizeof(VulkanPresentData));
+    if (commandPool->inactiveSecondaryCommandBufferCount == 0) {
+        VULKAN_INTERNAL_AllocateCommandBuffers(
+            renderer,
+            commandPool,
+            SDL_max(commandPool->inactiveSecondaryCommandBufferCapacity, 2),
+            VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+    }
+
+    commandBuffer = commandPool->inactiveSecondaryCommandBuffers[commandPool->inactiveSecondaryCommandBufferCount - 1];
+    commandPool->inactiveSecondaryCommandBufferCount -= 1;
+
+    return commandBuffer;
+}
+
+static void VULKAN_INTERNAL_ResetCommandBufferState(
+    VulkanRenderer *renderer,
+    VulkanCommandBuffer *commandBuffer)
+{
+    VkResult result;
+    Uint32 i;
+
+    commandBuffer->currentComputePipeline = NULL;
+    commandBuffer->currentGraphicsPipeline = NULL;
+
+    for (i = 0; i < MAX_COLOR_TARGET_BINDINGS; i += 1) {
+        commandBuffer->colorAttachmentSlices[i] = NULL;
+    }
+
+    commandBuffer->currentUniformBuffer = NULL;
+    commandBuffer->currentStagingBlock = NULL;
+    commandBuffer->stagingBlockOffset = 0;
+
+    for (i = 0; i < MAX_UNIFORM_BUFFERS_PER_STAGE; i += 1) {
+        commandBuffer->vertexUniformBuffers[i] = NULL;
+        commandBuffer->fragmentUniformBuffers[i] = NULL;
+        commandBuffer->computeUniformBuffers[i] = NULL;
+        commandBuffer->vertexUniformDrawOffsets[i] = 0;
+        commandBuffer->fragmentUniformDrawOffsets[i] = 0;
+        commandBuffer->computeUniformDrawOffsets[i] = 0;
+    }
+
+    commandBuffer->depthStencilAttachmentSlice = NULL;
+
+    commandBuffer->needNewVertexResourceDescriptorSet = SDL_TRUE;
+    commandBuffer->needNewVertexUniformDescriptorSet = SDL_TRUE;
+    commandBuffer->needNewVertexUniformOffsets = SDL_TRUE;
+    commandBuffer->needNewFragmentResourceDescriptorSet = SDL_TRUE;
+    commandBuffer->needNewFragmentUniformDescriptorSet = SDL_TRUE;
+    commandBuffer->needNewFragmentUniformOffsets = SDL_TRUE;
+
+    commandBuffer->needNewComputeReadOnlyDescriptorSet = SDL_TRUE;
+    commandBuffer->needNewComputeUniformDescriptorSet = SDL_TRUE;
+    commandBuffer->needNewComputeUniformOffsets = SDL_TRUE;
+
+    commandBuffer->vertexResourceDescriptorSet = VK_NULL_HANDLE;
+    commandBuffer->vertexUniformDescriptorSet = VK_NULL_HANDLE;
+    commandBuffer->fragmentResourceDescriptorSet = VK_NULL_HANDLE;
+    commandBuffer->fragmentUniformDescriptorSet = VK_NULL_HANDLE;
+
+    commandBuffer->computeReadOnlyDescriptorSet = VK_NULL_HANDLE;
+    commandBuffer->computeReadWriteDescriptorSet = VK_NULL_HANDLE;
+    commandBuffer->computeUniformDescriptorSet = VK_NULL_HANDLE;
+
+    SDL_zeroa(commandBuffer->vertexSamplerTextures);
+    SDL_zeroa(commandBuffer->vertexSamplers);
+    SDL_zeroa(commandBuffer->vertexStorageTextureSlices);
+    SDL_zeroa(commandBuffer->vertexStorageBuffers);
+
+    SDL_zeroa(commandBuffer->fragmentSamplerTextures);
+    SDL_zeroa(commandBuffer->fragmentSamplers);
+    SDL_zeroa(commandBuffer->fragmentStorageTextureSlices);
+    SDL_zeroa(commandBuffer->fragmentStorageBuffers);
+
+    SDL_zeroa(commandBuffer->readWriteComputeStorageTextureSlices);
+    SDL_zeroa(commandBuffer->readWriteComputeStorageBuffers);
+    SDL_zeroa(commandBuffer->readOnlyComputeStorageTextureSlices);
+    SDL_zeroa(commandBuffer->readOnlyComputeStorageBuffers);
+
+    commandBuffer->autoReleaseFence = 1;
+
+    commandBuffer->isDefrag = 0;
+    commandBuffer->boundBindlessSet = 0;
+
+    /* Reset the command buffer here to avoid resets being called
+     * from a separate thread than where the command buffer was acquired
+     */
+    result = renderer->vkResetCommandBuffer(
+        commandBuffer->commandBuffer,
+        VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
+
+    if (result != VK_SUCCESS) {
+        LogVulkanResultAsError("vkResetCommandBuffer", result);
+    }
+}
+
+static Refresh_CommandBuffer *VULKAN_AcquireCommandBuffer(
+    Refresh_Renderer *driverData,
+    Refresh_QueueType queueType)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+
+    SDL_threadID threadID = SDL_ThreadID();
+
+    SDL_LockMutex(renderer->acquireCommandBufferLock);
+
+    VulkanCommandBuffer *commandBuffer =
+        VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(renderer, threadID, queueType);
+
+    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+
+    if (commandBuffer == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire command buffer!");
+        return NULL;
     }
 
-    presentData = &vulkanCommandBuffer->presentDatas[vulkanCommandBuffer->presentDataCount];
-    vulkanCommandBuffer->presentDataCount += 1;
+    /* Reset state */
+
+    VULKAN_INTERNAL_ResetCommandBufferState(renderer, commandBuffer);
+
+    VULKAN_INTERNAL_BeginCommandBuffer(renderer, commandBuffer);
+
+    return (Refresh_CommandBuffer *)commandBuffer;
+}
+
+/* Each render pass chunk is a secondary command buffer from the recording thread's pool.
+ * The chunks are executed by the primary command buffer when the render pass ends
+ * and are cleaned along with it.
+ */
+static Refresh_CommandBuffer *VULKAN_AcquireRenderPassChunk(
+    Refresh_CommandBuffer *commandBuffer)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
+    VulkanCommandBuffer *chunk;
+    VkCommandBufferInheritanceInfo inheritanceInfo;
+    VkCommandBufferBeginInfo beginInfo;
+    VkResult result;
+
+    SDL_LockMutex(renderer->acquireCommandBufferLock);
+
+    chunk = VULKAN_INTERNAL_GetInactiveSecondaryCommandBufferFromPool(
+        renderer,
+        SDL_ThreadID());
+
+    if (chunk == NULL) {
+        SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire render pass chunk!");
+        return NULL;
+    }
+
+    EXPAND_ARRAY_IF_NEEDED(
+        vulkanCommandBuffer->renderPassChunks,
+        VulkanCommandBuffer *,
+        vulkanCommandBuffer->renderPassChunkCount + 1,
+        vulkanCommandBuffer->renderPassChunkCapacity,
+        vulkanCommandBuffer->renderPassChunkCapacity * 2);
+
+    vulkanCommandBuffer->renderPassChunks[vulkanCommandBuffer->renderPassChunkCount] = chunk;
+    vulkanCommandBuffer->renderPassChunkCount += 1;
+
+    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+
+    VULKAN_INTERNAL_ResetCommandBufferState(renderer, chunk);
+
+    /* Secondary command buffers are never submitted on their own */
+    chunk->autoReleaseFence = 0;
+
+    chunk->currentViewport = vulkanCommandBuffer->currentViewport;
+    chunk->currentScissor = vulkanCommandBuffer->currentScissor;
+
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext = NULL;
+    inheritanceInfo.renderPass = vulkanCommandBuffer->currentRenderPass;
+    inheritanceInfo.subpass = 0;
+    inheritanceInfo.framebuffer = vulkanCommandBuffer->currentFramebuffer;
+    inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+    inheritanceInfo.queryFlags = 0;
+    inheritanceInfo.pipelineStatistics = 0;
+
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = NULL;
+    beginInfo.flags =
+        VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+        VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    result = renderer->vkBeginCommandBuffer(
+        chunk->commandBuffer,
+        &beginInfo);
+
+    if (result != VK_SUCCESS) {
+        LogVulkanResultAsError("vkBeginCommandBuffer", result);
+    }
+
+    return (Refresh_CommandBuffer *)chunk;
+}
+
+static void VULKAN_EndRenderPassChunk(
+    Refresh_CommandBuffer *chunk)
+{
+    VulkanCommandBuffer *vulkanChunk = (VulkanCommandBuffer *)chunk;
+
+    VULKAN_INTERNAL_EndCommandBuffer(
+        vulkanChunk->renderer,
+        vulkanChunk);
+}
+
+static SDL_bool VULKAN_INTERNAL_IsFenceSignaled(
+    VulkanRenderer *renderer,
+    VulkanFenceHandle *handle)
+{
+    Uint64 completedValue;
+    VkResult result;
+
+    if (handle->timelineSemaphore != VK_NULL_HANDLE) {
+        result = renderer->vkGetSemaphoreCounterValueKHR(
+            renderer->logicalDevice,
+            handle->timelineSemaphore,
+            &completedValue);
+
+        if (result != VK_SUCCESS) {
+            LogVulkanResultAsError("vkGetSemaphoreCounterValueKHR", result);
+            return 0;
+        }
+
+        return completedValue >= handle->submissionValue;
+    }
+
+    result = renderer->vkGetFenceStatus(
+        renderer->logicalDevice,
+        handle->fence);
+
+    if (result == VK_SUCCESS) {
+        return 1;
+    } else if (result == VK_NOT_READY) {
+        return 0;
+    } else {
+        LogVulkanResultAsError("vkGetFenceStatus", result);
+        return 0;
+    }
+}
+
+static SDL_bool VULKAN_QueryFence(
+    Refresh_Renderer *driverData,
+    Refresh_Fence *fence)
+{
+    return VULKAN_INTERNAL_IsFenceSignaled(
+        (VulkanRenderer *)driverData,
+        (VulkanFenceHandle *)fence);
+}
+
+static Uint64 VULKAN_GetFenceSubmissionValue(
+    Refresh_Renderer *driverData,
+    Refresh_Fence *fence)
+{
+    return ((VulkanFenceHandle *)fence)->submissionValue;
+}
+
+static void VULKAN_INTERNAL_ReturnFenceToPool(
+    VulkanRenderer *renderer,
+    VulkanFenceHandle *fenceHandle)
+{
+    SDL_LockMutex(renderer->fencePool.lock);
+
+    EXPAND_ARRAY_IF_NEEDED(
+        renderer->fencePool.availableFences,
+        VulkanFenceHandle *,
+        renderer->fencePool.availableFenceCount + 1,
+        renderer->fencePool.availableFenceCapacity,
+        renderer->fencePool.availableFenceCapacity * 2);
+
+    renderer->fencePool.availableFences[renderer->fencePool.availableFenceCount] = fenceHandle;
+    renderer->fencePool.availableFenceCount += 1;
+
+    SDL_UnlockMutex(renderer->fencePool.lock);
+}
+
+static void VULKAN_ReleaseFence(
+    Refresh_Renderer *driverData,
+    Refresh_Fence *fence)
+{
+    VulkanFenceHandle *handle = (VulkanFenceHandle *)fence;
+
+    if (SDL_AtomicDecRef(&handle->referenceCount)) {
+        VULKAN_INTERNAL_ReturnFenceToPool((VulkanRenderer *)driverData, handle);
+    }
+}
+
+static WindowData *VULKAN_INTERNAL_FetchWindowData(
+    SDL_Window *window)
+{
+    return (WindowData *)SDL_GetWindowData(window, WINDOW_PROPERTY_DATA);
+}
+
+static SDL_bool VULKAN_SupportsSwapchainComposition(
+    Refresh_Renderer *driverData,
+    SDL_Window *window,
+    Refresh_SwapchainComposition swapchainComposition)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    
+    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
+    VkSurfaceKHR surface;
+    SwapchainSupportDetails supportDetails;
+    SDL_bool destroySurface = SDL_FALSE;
+    SDL_bool result = SDL_FALSE;
+    Uint32 i;
+
+    if (windowData == NULL || windowData->swapchainData == NULL) {
+        /* Create a dummy surface is the window is not claimed */
+        destroySurface = SDL_TRUE;
+        
+        if (!SDL_Vulkan_CreateSurface(
+                window,
+                renderer->instance,
+                &surface)) {
+            return SDL_FALSE;
+        }
+    } else {
+        surface = windowData->swapchainData->surface;
+    }
+
+    if (VULKAN_INTERNAL_QuerySwapchainSupport(
+            renderer,
+            renderer->physicalDevice,
+            surface,
+            &supportDetails)) {
+        for (i = 0; i < supportDetails.formatsLength; i += 1) {
+            if (supportDetails.formats[i].format == SwapchainCompositionToFormat[swapchainComposition] &&
+                supportDetails.formats[i].colorSpace == SwapchainCompositionToColorSpace[swapchainComposition]) {
+                result = SDL_TRUE;
+                break;
+            }
+        }
+
+        SDL_free(supportDetails.formats);
+        SDL_free(supportDetails.presentModes);
+    }
+
+    if (destroySurface) {
+        renderer->vkDestroySurfaceKHR(
+            renderer->instance,
+            surface,
+            NULL);
+    }
+
+    return result;
+}
+
+static SDL_bool VULKAN_SupportsPresentMode(
+    Refresh_Renderer *driverData,
+    SDL_Window *window,
+    Refresh_PresentMode presentMode)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    
+    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
+    VkSurfaceKHR surface;
+    SwapchainSupportDetails supportDetails;
+    SDL_bool destroySurface = SDL_FALSE;
+    SDL_bool result = SDL_FALSE;
+    Uint32 i;
+
+    if (windowData == NULL || windowData->swapchainData == NULL) {
+        /* Create a dummy surface is the window is not claimed */
+        destroySurface = SDL_TRUE;
+        
+        if (!SDL_Vulkan_CreateSurface(
+                window,
+                renderer->instance,
+                &surface)) {
+            return SDL_FALSE;
+        }
+    } else {
+        surface = windowData->swapchainData->surface;
+    }
+
+    if (VULKAN_INTERNAL_QuerySwapchainSupport(
+            renderer,
+            renderer->physicalDevice,
+            surface,
+            &supportDetails)) {
+
+        for (i = 0; i < supportDetails.presentModesLength; i += 1) {
+            if (supportDetails.presentModes[i] == RefreshToVK_PresentMode[presentMode]) {
+                result = SDL_TRUE;
+                break;
+            }
+        }
+
+        SDL_free(supportDetails.formats);
+        SDL_free(supportDetails.presentModes);
+    }
+
+    if (destroySurface) {
+        renderer->vkDestroySurfaceKHR(
+            renderer->instance,
+            surface,
+            NULL);
+    }
+
+    return result;
+}
+
+static SDL_bool VULKAN_ClaimWindow(
+    Refresh_Renderer *driverData,
+    SDL_Window *window,
+    Refresh_SwapchainComposition swapchainComposition,
+    Refresh_PresentMode presentMode)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
+
+    if (windowData == NULL) {
+        windowData = SDL_malloc(sizeof(WindowData));
+        windowData->window = window;
+        windowData->presentMode = presentMode;
+        windowData->swapchainComposition = swapchainComposition;
+        windowData->allowedFramesInFlight = MAX_FRAMES_IN_FLIGHT;
+
+        if (VULKAN_INTERNAL_CreateSwapchain(renderer, windowData)) {
+            SDL_SetWindowData(window, WINDOW_PROPERTY_DATA, windowData);
+
+            if (renderer->claimedWindowCount >= renderer->claimedWindowCapacity) {
+                renderer->claimedWindowCapacity *= 2;
+                renderer->claimedWindows = SDL_realloc(
+                    renderer->claimedWindows,
+                    renderer->claimedWindowCapacity * sizeof(WindowData *));
+            }
+
+            renderer->claimedWindows[renderer->claimedWindowCount] = windowData;
+            renderer->claimedWindowCount += 1;
+
+            return 1;
+        } else {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not create swapchain, failed to claim window!");
+            SDL_free(windowData);
+            return 0;
+        }
+    } else {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Window already claimed!");
+        return 0;
+    }
+}
+
+static void VULKAN_UnclaimWindow(
+    Refresh_Renderer *driverData,
+    SDL_Window *window)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
+    Uint32 i;
+
+    if (windowData == NULL) {
+        return;
+    }
+
+    if (windowData->swapchainData != NULL) {
+        VULKAN_Wait(driverData);
+
+        for (i = 0; i < MAX_FRAMES_IN_FLIGHT; i += 1) {
+            if (windowData->swapchainData->inFlightFences[i] != NULL) {
+                VULKAN_ReleaseFence(
+                    driverData,
+                    (Refresh_Fence *)windowData->swapchainData->inFlightFences[i]);
+            }
+        }
+
+        VULKAN_INTERNAL_DestroySwapchain(
+            (VulkanRenderer *)driverData,
+            windowData);
+    }
+
+    for (i = 0; i < renderer->claimedWindowCount; i += 1) {
+        if (renderer->claimedWindows[i]->window == window) {
+            renderer->claimedWindows[i] = renderer->claimedWindows[renderer->claimedWindowCount - 1];
+            renderer->claimedWindowCount -= 1;
+            break;
+        }
+    }
+
+    SDL_free(windowData);
+
+    SDL_SetWindowData(window, WINDOW_PROPERTY_DATA, NULL);
+}
+
+static SDL_bool VULKAN_INTERNAL_RecreateSwapchain(
+    VulkanRenderer *renderer,
+    WindowData *windowData)
+{
+    Uint32 i;
+
+    if (windowData->swapchainData != NULL) {
+        VULKAN_Wait((Refresh_Renderer *)renderer);
+
+        for (i = 0; i < MAX_FRAMES_IN_FLIGHT; i += 1) {
+            if (windowData->swapchainData->inFlightFences[i] != NULL) {
+                VULKAN_ReleaseFence(
+                    (Refresh_Renderer *)renderer,
+                    (Refresh_Fence *)windowData->swapchainData->inFlightFences[i]);
+            }
+        }
+    }
+
+    VULKAN_INTERNAL_DestroySwapchain(renderer, windowData);
+    return VULKAN_INTERNAL_CreateSwapchain(renderer, windowData);
+}
+
+static Refresh_Texture *VULKAN_AcquireSwapchainTexture(
+    Refresh_CommandBuffer *commandBuffer,
+    SDL_Window *window,
+    Uint32 *pWidth,
+    Uint32 *pHeight)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
+    Uint32 swapchainImageIndex;
+    WindowData *windowData;
+    VulkanSwapchainData *swapchainData;
+    VkResult acquireResult = VK_SUCCESS;
+    VulkanTextureContainer *swapchainTextureContainer = NULL;
+    VulkanPresentData *presentData;
+
+    windowData = VULKAN_INTERNAL_FetchWindowData(window);
+    if (windowData == NULL) {
+        return NULL;
+    }
+
+    swapchainData = windowData->swapchainData;
+
+    /* Window is claimed but swapchain is invalid! */
+    if (swapchainData == NULL) {
+        if (SDL_GetWindowFlags(window) & SDL_WINDOW_MINIMIZED) {
+            /* Window is minimized, don't bother */
+            return NULL;
+        }
+
+        /* Let's try to recreate */
+        VULKAN_INTERNAL_RecreateSwapchain(renderer, windowData);
+        swapchainData = windowData->swapchainData;
+
+        if (swapchainData == NULL) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to recreate swapchain!");
+            return NULL;
+        }
+    }
+
+    if (swapchainData->inFlightFences[swapchainData->frameCounter] != NULL) {
+        if (swapchainData->presentMode == VK_PRESENT_MODE_FIFO_KHR) {
+            /* In VSYNC mode, block until the least recent presented frame is done */
+            VULKAN_WaitForFences(
+                (Refresh_Renderer *)renderer,
+                SDL_TRUE,
+                (Refresh_Fence **)&swapchainData->inFlightFences[swapchainData->frameCounter],
+                1);
+        } else {
+            if (!VULKAN_QueryFence(
+                    (Refresh_Renderer *)renderer,
+                    (Refresh_Fence *)swapchainData->inFlightFences[swapchainData->frameCounter])) {
+                /*
+                 * In MAILBOX or IMMEDIATE mode, if the least recent fence is not signaled,
+                 * return NULL to indicate that rendering should be skipped
+                 */
+                return NULL;
+            }
+        }
+
+        VULKAN_ReleaseFence(
+            (Refresh_Renderer *)renderer,
+            (Refresh_Fence *)swapchainData->inFlightFences[swapchainData->frameCounter]);
+
+        swapchainData->inFlightFences[swapchainData->frameCounter] = NULL;
+    }
+
+    acquireResult = renderer->vkAcquireNextImageKHR(
+        renderer->logicalDevice,
+        swapchainData->swapchain,
+        UINT64_MAX,
+        swapchainData->imageAvailableSemaphore[swapchainData->frameCounter],
+        VK_NULL_HANDLE,
+        &swapchainImageIndex);
+
+    /* Acquisition is invalid, let's try to recreate */
+    if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR) {
+        VULKAN_INTERNAL_RecreateSwapchain(renderer, windowData);
+        swapchainData = windowData->swapchainData;
+
+        if (swapchainData == NULL) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to recreate swapchain!");
+            return NULL;
+        }
+
+        acquireResult = renderer->vkAcquireNextImageKHR(
+            renderer->logicalDevice,
+            swapchainData->swapchain,
+            UINT64_MAX,
+            swapchainData->imageAvailableSemaphore[swapchainData->frameCounter],
+            VK_NULL_HANDLE,
+            &swapchainImageIndex);
+
+        if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire swapchain texture!");
+            return NULL;
+        }
+    }
+
+    swapchainTextureContainer = &swapchainData->textureContainers[swapchainImageIndex];
+
+    /* We need a special execution dependency with pWaitDstStageMask or image transition can start before acquire finishes */
+
+    VkImageMemoryBarrier imageBarrier;
+    imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    imageBarrier.pNext = NULL;
+    imageBarrier.srcAccessMask = 0;
+    imageBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageBarrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.image = swapchainTextureContainer->activeTextureHandle->vulkanTexture->image;
+    imageBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    imageBarrier.subresourceRange.baseMipLevel = 0;
+    imageBarrier.subresourceRange.levelCount = 1;
+    imageBarrier.subresourceRange.baseArrayLayer = 0;
+    imageBarrier.subresourceRange.layerCount = 1;
+
+    renderer->vkCmdPipelineBarrier(
+        vulkanCommandBuffer->commandBuffer,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        0,
+        0,
+        NULL,
+        0,
+        NULL,
+        1,
+        &imageBarrier);
+
+    /* Set up present struct */
+
+    if (vulkanCommandBuffer->presentDataCount == vulkanCommandBuffer->presentDataCapacity) {
+        vulkanCommandBuffer->presentDataCapacity += 1;
+        vulkanCommandBuffer->presentDatas = SDL_realloc(
+            vulkanCommandBuffer->presentDatas,
+            vulkanCommandBuffer->presentDataCapacity * sizeof(VulkanPresentData));
+    }
+
+    presentData = &vulkanCommandBuffer->presentDatas[vulkanCommandBuffer->presentDataCount];
+    vulkanCommandBuffer->presentDataCount += 1;
+
+    presentData->windowData = windowData;
+    presentData->swapchainImageIndex = swapchainImageIndex;
+
+    /* Set up present semaphores */
+
+    if (vulkanCommandBuffer->waitSemaphoreCount == vulkanCommandBuffer->waitSemaphoreCapacity) {
+        vulkanCommandBuffer->waitSemaphoreCapacity += 1;
+        vulkanCommandBuffer->waitSemaphores = SDL_realloc(
+            vulkanCommandBuffer->waitSemaphores,
+            vulkanCommandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore));
+    }
+
+    vulkanCommandBuffer->waitSemaphores[vulkanCommandBuffer->waitSemaphoreCount] =
+        swapchainData->imageAvailableSemaphore[swapchainData->frameCounter];
+    vulkanCommandBuffer->waitSemaphoreCount += 1;
+
+    if (vulkanCommandBuffer->signalSemaphoreCount == vulkanCommandBuffer->signalSemaphoreCapacity) {
+        vulkanCommandBuffer->signalSemaphoreCapacity += 1;
+        vulkanCommandBuffer->signalSemaphores = SDL_realloc(
+            vulkanCommandBuffer->signalSemaphores,
+            vulkanCommandBuffer->signalSemaphoreCapacity * sizeof(VkSemaphore));
+    }
+
+    vulkanCommandBuffer->signalSemaphores[vulkanCommandBuffer->signalSemaphoreCount] =
+        swapchainData->renderFinishedSemaphore[swapchainData->frameCounter];
+    vulkanCommandBuffer->signalSemaphoreCount += 1;
+
+    *pWidth = swapchainData->extent.width;
+    *pHeight = swapchainData->extent.height;
+
+    return (Refresh_Texture *)swapchainTextureContainer;
+}
+
+static Refresh_TextureFormat VULKAN_GetSwapchainTextureFormat(
+    Refresh_Renderer *driverData,
+    SDL_Window *window)
+{
+    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
+
+    if (windowData == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot get swapchain format, window has not been claimed!");
+        return 0;
+    }
+
+    if (windowData->swapchainData == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot get swapchain format, swapchain is currently invalid!");
+        return 0;
+    }
+
+    switch (windowData->swapchainData->format) {
+    case VK_FORMAT_R8G8B8A8_UNORM:
+        return REFRESH_TEXTUREFORMAT_R8G8B8A8;
+
+    case VK_FORMAT_B8G8R8A8_UNORM:
+        return REFRESH_TEXTUREFORMAT_B8G8R8A8;
+
+    case VK_FORMAT_B8G8R8A8_SRGB:
+        return REFRESH_TEXTUREFORMAT_B8G8R8A8_SRGB;
+
+    case VK_FORMAT_R8G8B8A8_SRGB:
+        return REFRESH_TEXTUREFORMAT_R8G8B8A8_SRGB;
+
+    case VK_FORMAT_R16G16B16A16_SFLOAT:
+        return REFRESH_TEXTUREFORMAT_R16G16B16A16_SFLOAT;
+
+    case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+        return REFRESH_TEXTUREFORMAT_R10G10B10A2;
+
+    default:
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized swapchain format!");
+        return 0;
+    }
+}
+
+static SDL_bool VULKAN_SetSwapchainParameters(
+    Refresh_Renderer *driverData,
+    SDL_Window *window,
+    Refresh_SwapchainComposition swapchainComposition,
+    Refresh_PresentMode presentMode)
+{
+    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
+
+    if (windowData == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot set swapchain parameters on unclaimed window!");
+        return SDL_FALSE;
+    }
+
+    if (!VULKAN_SupportsSwapchainComposition(driverData, window, swapchainComposition)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Swapchain composition not supported!");
+        return SDL_FALSE;
+    }
+
+    if (!VULKAN_SupportsPresentMode(driverData, window, presentMode)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Present mode not supported!");
+        return SDL_FALSE;
+    }
+
+    return VULKAN_INTERNAL_RecreateSwapchain(
+        (VulkanRenderer *)driverData,
+        windowData);
+}
+
+static SDL_bool VULKAN_SetAllowedFramesInFlight(
+    Refresh_Renderer *driverData,
+    SDL_Window *window,
+    Uint32 allowedFramesInFlight)
+{
+    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
+    Uint32 i;
+
+    if (windowData == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot set allowed frames in flight on unclaimed window!");
+        return SDL_FALSE;
+    }
+
+    if (allowedFramesInFlight == windowData->allowedFramesInFlight) {
+        return SDL_TRUE;
+    }
+
+    /* The frame slots are reassigned, so every frame has to be retired first */
+    if (windowData->swapchainData != NULL) {
+        VULKAN_Wait(driverData);
+
+        for (i = 0; i < MAX_FRAMES_IN_FLIGHT; i += 1) {
+            if (windowData->swapchainData->inFlightFences[i] != NULL) {
+                VULKAN_ReleaseFence(
+                    driverData,
+                    (Refresh_Fence *)windowData->swapchainData->inFlightFences[i]);
+
+                windowData->swapchainData->inFlightFences[i] = NULL;
+            }
+        }
+
+        windowData->swapchainData->frameCounter = 0;
+    }
+
+    windowData->allowedFramesInFlight = allowedFramesInFlight;
+    return SDL_TRUE;
+}
+
+static SDL_bool VULKAN_WaitForSwapchain(
+    Refresh_Renderer *driverData,
+    SDL_Window *window)
+{
+    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
+    VulkanSwapchainData *swapchainData;
+
+    if (windowData == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot wait for the swapchain of an unclaimed window!");
+        return SDL_FALSE;
+    }
+
+    /* Nothing to wait on, acquiring will try to recreate the swapchain */
+    swapchainData = windowData->swapchainData;
+    if (swapchainData == NULL) {
+        return SDL_TRUE;
+    }
+
+    if (swapchainData->inFlightFences[swapchainData->frameCounter] != NULL) {
+        VULKAN_WaitForFences(
+            driverData,
+            SDL_TRUE,
+            (Refresh_Fence **)&swapchainData->inFlightFences[swapchainData->frameCounter],
+            1);
+
+        VULKAN_ReleaseFence(
+            driverData,
+            (Refresh_Fence *)swapchainData->inFlightFences[swapchainData->frameCounter]);
+
+        swapchainData->inFlightFences[swapchainData->frameCounter] = NULL;
+    }
+
+    return SDL_TRUE;
+}
+
+/* Submission structure */
+
+static VulkanFenceHandle *VULKAN_INTERNAL_AcquireFenceFromPool(
+    VulkanRenderer *renderer)
+{
+    VulkanFenceHandle *handle;
+    VkFenceCreateInfo fenceCreateInfo;
+    VkFence fence = VK_NULL_HANDLE;
+    VkResult vulkanResult;
+
+    if (renderer->fencePool.availableFenceCount == 0) {
+        /* Timeline backed fences only need the handle */
+        if (!renderer->supportsTimelineSemaphore) {
+            fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            fenceCreateInfo.pNext = NULL;
+            fenceCreateInfo.flags = 0;
+
+            vulkanResult = renderer->vkCreateFence(
+                renderer->logicalDevice,
+                &fenceCreateInfo,
+                NULL,
+                &fence);
+
+            if (vulkanResult != VK_SUCCESS) {
+                LogVulkanResultAsError("vkCreateFence", vulkanResult);
+                return NULL;
+            }
+        }
+
+        handle = SDL_malloc(sizeof(VulkanFenceHandle));
+        handle->fence = fence;
+        handle->timelineSemaphore = VK_NULL_HANDLE;
+        handle->submissionValue = 0;
+        SDL_AtomicSet(&handle->referenceCount, 0);
+        return handle;
+    }
+
+    SDL_LockMutex(renderer->fencePool.lock);
+
+    handle = renderer->fencePool.availableFences[renderer->fencePool.availableFenceCount - 1];
+    renderer->fencePool.availableFenceCount -= 1;
+
+    if (handle->fence != VK_NULL_HANDLE) {
+        vulkanResult = renderer->vkResetFences(
+            renderer->logicalDevice,
+            1,
+            &handle->fence);
+
+        if (vulkanResult != VK_SUCCESS) {
+            LogVulkanResultAsError("vkResetFences", vulkanResult);
+        }
+    }
+
+    SDL_UnlockMutex(renderer->fencePool.lock);
+
+    return handle;
+}
+
+static Sint32 VULKAN_INTERNAL_DeferredDestroyReferenceCount(
+    VulkanDeferredDestroy *deferredDestroy)
+{
+    VulkanTexture *texture;
+    Sint32 refCountTotal = 0;
+    Uint32 sliceIndex;
+
+    switch (deferredDestroy->type) {
+    case VULKAN_DEFERRED_DESTROY_TEXTURE:
+        texture = (VulkanTexture *)deferredDestroy->resource;
+        for (sliceIndex = 0; sliceIndex < texture->sliceCount; sliceIndex += 1) {
+            refCountTotal += SDL_AtomicGet(&texture->slices[sliceIndex].referenceCount);
+        }
+        return refCountTotal;
+
+    case VULKAN_DEFERRED_DESTROY_BUFFER:
+        return SDL_AtomicGet(&((VulkanBuffer *)deferredDestroy->resource)->referenceCount);
+
+    case VULKAN_DEFERRED_DESTROY_SAMPLER:
+        return SDL_AtomicGet(&((VulkanSampler *)deferredDestroy->resource)->referenceCount);
+
+    case VULKAN_DEFERRED_DESTROY_GRAPHICS_PIPELINE:
+        return SDL_AtomicGet(&((VulkanGraphicsPipeline *)deferredDestroy->resource)->referenceCount);
+
+    case VULKAN_DEFERRED_DESTROY_COMPUTE_PIPELINE:
+        return SDL_AtomicGet(&((VulkanComputePipeline *)deferredDestroy->resource)->referenceCount);
+
+    case VULKAN_DEFERRED_DESTROY_SHADER:
+        return SDL_AtomicGet(&((VulkanShader *)deferredDestroy->resource)->referenceCount);
+
+    case VULKAN_DEFERRED_DESTROY_FRAMEBUFFER:
+        return SDL_AtomicGet(&((VulkanFramebuffer *)deferredDestroy->resource)->referenceCount);
+
+    case VULKAN_DEFERRED_DESTROY_QUERY_POOL:
+        return SDL_AtomicGet(&((VulkanQueryPool *)deferredDestroy->resource)->referenceCount);
+    }
+
+    return 0;
+}
+
+static void VULKAN_INTERNAL_PerformDeferredDestroy(
+    VulkanRenderer *renderer,
+    VulkanDeferredDestroy *deferredDestroy)
+{
+    switch (deferredDestroy->type) {
+    case VULKAN_DEFERRED_DESTROY_TEXTURE:
+        VULKAN_INTERNAL_DestroyTexture(renderer, (VulkanTexture *)deferredDestroy->resource);
+        break;
+
+    case VULKAN_DEFERRED_DESTROY_BUFFER:
+        VULKAN_INTERNAL_DestroyBuffer(renderer, (VulkanBuffer *)deferredDestroy->resource);
+        break;
+
+    case VULKAN_DEFERRED_DESTROY_SAMPLER:
+        VULKAN_INTERNAL_DestroySampler(renderer, (VulkanSampler *)deferredDestroy->resource);
+        break;
+
+    case VULKAN_DEFERRED_DESTROY_GRAPHICS_PIPELINE:
+        VULKAN_INTERNAL_DestroyGraphicsPipeline(renderer, (VulkanGraphicsPipeline *)deferredDestroy->resource);
+        break;
+
+    case VULKAN_DEFERRED_DESTROY_COMPUTE_PIPELINE:
+        VULKAN_INTERNAL_DestroyComputePipeline(renderer, (VulkanComputePipeline *)deferredDestroy->resource);
+        break;
+
+    case VULKAN_DEFERRED_DESTROY_SHADER:
+        VULKAN_INTERNAL_DestroyShader(renderer, (VulkanShader *)deferredDestroy->resource);
+        break;
+
+    case VULKAN_DEFERRED_DESTROY_FRAMEBUFFER:
+        VULKAN_INTERNAL_DestroyFramebuffer(renderer, (VulkanFramebuffer *)deferredDestroy->resource);
+        break;
+
+    case VULKAN_DEFERRED_DESTROY_QUERY_POOL:
+        VULKAN_INTERNAL_DestroyQueryPool(renderer, (VulkanQueryPool *)deferredDestroy->resource);
+        break;
+    }
+}
+
+/* Must be called with the submit lock held, after completed command buffers have been cleaned */
+static void VULKAN_INTERNAL_PerformPendingDestroys(
+    VulkanRenderer *renderer)
+{
+    VulkanDeferredDestroy deferredDestroy;
+    Uint64 oldestInFlightSerial;
+    Uint32 retiredCount;
+    Uint32 i;
+
+    SDL_LockMutex(renderer->disposeLock);
+
+    oldestInFlightSerial = renderer->submissionSerial + 1;
+    for (i = 0; i < renderer->submittedCommandBufferCount; i += 1) {
+        oldestInFlightSerial = SDL_min(
+            oldestInFlightSerial,
+            renderer->submittedCommandBuffers[i]->submissionSerial);
+    }
+
+    /* Anything released before the oldest in-flight submission can only be
+     * referenced by command buffers that have not been submitted yet.
+     */
+    retiredCount = 0;
+    while (
+        retiredCount < renderer->deferredDestroyCount &&
+        renderer->deferredDestroys[retiredCount].submissionSerial < oldestInFlightSerial) {
+        retiredCount += 1;
+    }
+
+    if (retiredCount == 0) {
+        SDL_UnlockMutex(renderer->disposeLock);
+        return;
+    }
+
+    for (i = 0; i < retiredCount; i += 1) {
+        /* Copied out, requeueing may reallocate the queue */
+        deferredDestroy = renderer->deferredDestroys[i];
+
+        if (VULKAN_INTERNAL_DeferredDestroyReferenceCount(&deferredDestroy) == 0) {
+            VULKAN_INTERNAL_PerformDeferredDestroy(renderer, &deferredDestroy);
+        } else {
+            /* Still held by a command buffer in recording, check again after its submission */
+            VULKAN_INTERNAL_QueueDeferredDestroy(
+                renderer,
+                deferredDestroy.type,
+                deferredDestroy.resource);
+        }
+    }
+
+    SDL_memmove(
+        renderer->deferredDestroys,
+        renderer->deferredDestroys + retiredCount,
+        sizeof(VulkanDeferredDestroy) * (renderer->deferredDestroyCount - retiredCount));
+    renderer->deferredDestroyCount -= retiredCount;
+
+    SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_INTERNAL_CleanCommandBuffer(
+    VulkanRenderer *renderer,
+    VulkanCommandBuffer *commandBuffer)
+{
+    Uint32 i;
+    DescriptorSetData *descriptorSetData;
+    CommandPoolDescriptorSets *commandPoolDescriptorSets;
+
+    if (commandBuffer->autoReleaseFence) {
+        VULKAN_ReleaseFence(
+            (Refresh_Renderer *)renderer,
+            (Refresh_Fence *)commandBuffer->inFlightFence);
+
+        commandBuffer->inFlightFence = NULL;
+    }
+
+    /* Bound descriptor sets are now available to the command pool they came from */
+
+    SDL_LockMutex(commandBuffer->commandPool->descriptorSetLock);
+
+    for (i = 0; i < commandBuffer->boundDescriptorSetDataCount; i += 1) {
+        descriptorSetData = &commandBuffer->boundDescriptorSetDatas[i];
+
+        commandPoolDescriptorSets = CommandPoolDescriptorSetsTable_Fetch(
+            &commandBuffer->commandPool->descriptorSetTable,
+            descriptorSetData->descriptorSetPool);
+
+        EXPAND_ARRAY_IF_NEEDED(
+            commandPoolDescriptorSets->inactiveDescriptorSets,
+            VkDescriptorSet,
+            commandPoolDescriptorSets->inactiveDescriptorSetCount + 1,
+            commandPoolDescriptorSets->inactiveDescriptorSetCapacity,
+            commandPoolDescriptorSets->inactiveDescriptorSetCapacity * 2);
+
+        commandPoolDescriptorSets->inactiveDescriptorSets[commandPoolDescriptorSets->inactiveDescriptorSetCount] = descriptorSetData->descriptorSet;
+        commandPoolDescriptorSets->inactiveDescriptorSetCount += 1;
+    }
+
+    SDL_UnlockMutex(commandBuffer->commandPool->descriptorSetLock);
+
+    commandBuffer->boundDescriptorSetDataCount = 0;
+
+    /* Cached sets were just returned to their pools */
+
+    DescriptorSetCacheHashTable_Clear(&commandBuffer->descriptorSetCache);
+
+    renderer->descriptorSetsWritten += commandBuffer->descriptorSetWriteCount;
+    renderer->descriptorSetsReused += commandBuffer->descriptorSetReuseCount;
+    commandBuffer->descriptorSetWriteCount = 0;
+    commandBuffer->descriptorSetReuseCount = 0;
+
+    renderer->barriersRecorded += commandBuffer->barrierCount;
+    renderer->barrierBatchesRecorded += commandBuffer->barrierBatchCount;
+    renderer->barriersEliminated += commandBuffer->eliminatedBarrierCount;
+    commandBuffer->barrierCount = 0;
+    commandBuffer->barrierBatchCount = 0;
+    commandBuffer->eliminatedBarrierCount = 0;
+
+    /* Uniform buffers are now available */
+
+    SDL_LockMutex(renderer->acquireUniformBufferLock);
+
+    for (i = 0; i < commandBuffer->usedUniformBufferCount; i += 1) {
+        VULKAN_INTERNAL_ReturnUniformBufferToPool(
+            renderer,
+            commandBuffer->usedUniformBuffers[i]);
+    }
+    commandBuffer->usedUniformBufferCount = 0;
+
+    SDL_UnlockMutex(renderer->acquireUniformBufferLock);
+
+    /* Staging blocks are now available */
+
+    SDL_LockMutex(renderer->acquireStagingBlockLock);
+
+    for (i = 0; i < commandBuffer->usedStagingBlockCount; i += 1) {
+        VULKAN_INTERNAL_ReturnStagingBlockToPool(
+            renderer,
+            commandBuffer->usedStagingBlocks[i]);
+    }
+    commandBuffer->usedStagingBlockCount = 0;
+
+    SDL_UnlockMutex(renderer->acquireStagingBlockLock);
+
+    /* Decrement reference counts */
+
+    for (i = 0; i < commandBuffer->usedBufferCount; i += 1) {
+        (void)SDL_AtomicDecRef(&commandBuffer->usedBuffers[i]->referenceCount);
+    }
+    commandBuffer->usedBufferCount = 0;
+
+    for (i = 0; i < commandBuffer->usedTextureSliceCount; i += 1) {
+        (void)SDL_AtomicDecRef(&commandBuffer->usedTextureSlices[i]->referenceCount);
+    }
+    commandBuffer->usedTextureSliceCount = 0;
+
+    for (i = 0; i < commandBuffer->usedSamplerCount; i += 1) {
+        (void)SDL_AtomicDecRef(&commandBuffer->usedSamplers[i]->referenceCount);
+    }
+    commandBuffer->usedSamplerCount = 0;
+
+    for (i = 0; i < commandBuffer->usedGraphicsPipelineCount; i += 1) {
+        (void)SDL_AtomicDecRef(&commandBuffer->usedGraphicsPipelines[i]->referenceCount);
+    }
+    commandBuffer->usedGraphicsPipelineCount = 0;
+
+    for (i = 0; i < commandBuffer->usedComputePipelineCount; i += 1) {
+        (void)SDL_AtomicDecRef(&commandBuffer->usedComputePipelines[i]->referenceCount);
+    }
+    commandBuffer->usedComputePipelineCount = 0;
+
+    for (i = 0; i < commandBuffer->usedFramebufferCount; i += 1) {
+        (void)SDL_AtomicDecRef(&commandBuffer->usedFramebuffers[i]->referenceCount);
+    }
+    commandBuffer->usedFramebufferCount = 0;
+
+    for (i = 0; i < commandBuffer->usedQueryPoolCount; i += 1) {
+        (void)SDL_AtomicDecRef(&commandBuffer->usedQueryPools[i]->referenceCount);
+    }
+    commandBuffer->usedQueryPoolCount = 0;
+
+    /* Reset presentation data */
+
+    commandBuffer->presentDataCount = 0;
+    commandBuffer->waitSemaphoreCount = 0;
+    commandBuffer->signalSemaphoreCount = 0;
+
+    /* Async queue semaphores have been waited on and can be reused */
+
+    for (i = 0; i < commandBuffer->asyncWaitSemaphoreCount; i += 1) {
+        EXPAND_ARRAY_IF_NEEDED(
+            renderer->availableSemaphores,
+            VkSemaphore,
+            renderer->availableSemaphoreCount + 1,
+            renderer->availableSemaphoreCapacity,
+            renderer->availableSemaphoreCapacity * 2);
+
+        renderer->availableSemaphores[renderer->availableSemaphoreCount] = commandBuffer->asyncWaitSemaphores[i];
+        renderer->availableSemaphoreCount += 1;
+    }
+    commandBuffer->asyncWaitSemaphoreCount = 0;
+
+    /* Reset defrag state */
+
+    if (commandBuffer->isDefrag) {
+        renderer->defragInProgress = 0;
+    }
+
+    /* Render pass chunks executed by this command buffer are done too */
+
+    for (i = 0; i < commandBuffer->renderPassChunkCount; i += 1) {
+        VULKAN_INTERNAL_CleanCommandBuffer(
+            renderer,
+            commandBuffer->renderPassChunks[i]);
+    }
+    commandBuffer->renderPassChunkCount = 0;
+
+    /* Return command buffer to pool */
+
+    SDL_LockMutex(renderer->acquireCommandBufferLock);
+
+    if (commandBuffer->level == VK_COMMAND_BUFFER_LEVEL_SECONDARY) {
+        EXPAND_ARRAY_IF_NEEDED(
+            commandBuffer->commandPool->inactiveSecondaryCommandBuffers,
+            VulkanCommandBuffer *,
+            commandBuffer->commandPool->inactiveSecondaryCommandBufferCount + 1,
+            commandBuffer->commandPool->inactiveSecondaryCommandBufferCapacity,
+            commandBuffer->commandPool->inactiveSecondaryCommandBufferCapacity + 1);
+
+        commandBuffer->commandPool->inactiveSecondaryCommandBuffers[commandBuffer->commandPool->inactiveSecondaryCommandBufferCount] = commandBuffer;
+        commandBuffer->commandPool->inactiveSecondaryCommandBufferCount += 1;
+
+        SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+        return;
+    }
+
+    if (commandBuffer->commandPool->inactiveCommandBufferCount == commandBuffer->commandPool->inactiveCommandBufferCapacity) {
+        commandBuffer->commandPool->inactiveCommandBufferCapacity += 1;
+        commandBuffer->commandPool->inactiveCommandBuffers = SDL_realloc(
+            commandBuffer->commandPool->inactiveCommandBuffers,
+            commandBuffer->commandPool->inactiveCommandBufferCapacity * sizeof(VulkanCommandBuffer *));
+    }
+
+    commandBuffer->commandPool->inactiveCommandBuffers[commandBuffer->commandPool->inactiveCommandBufferCount] = commandBuffer;
+    commandBuffer->commandPool->inactiveCommandBufferCount += 1;
+
+    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+
+    /* Remove this command buffer from the submitted list */
+    for (i = 0; i < renderer->submittedCommandBufferCount; i += 1) {
+        if (renderer->submittedCommandBuffers[i] == commandBuffer) {
+            renderer->submittedCommandBuffers[i] = renderer->submittedCommandBuffers[renderer->submittedCommandBufferCount - 1];
+            renderer->submittedCommandBufferCount -= 1;
+        }
+    }
+}
+
+static void VULKAN_INTERNAL_CleanCompletedCommandBuffers(
+    VulkanRenderer *renderer)
+{
+    Sint32 i;
+
+    SDL_LockMutex(renderer->submitLock);
+
+    for (i = renderer->submittedCommandBufferCount - 1; i >= 0; i -= 1) {
+        if (VULKAN_INTERNAL_IsFenceSignaled(
+                renderer,
+                renderer->submittedCommandBuffers[i]->inFlightFence)) {
+            VULKAN_INTERNAL_CleanCommandBuffer(
+                renderer,
+                renderer->submittedCommandBuffers[i]);
+        }
+    }
+
+    VULKAN_INTERNAL_PerformPendingDestroys(renderer);
+
+    SDL_UnlockMutex(renderer->submitLock);
+}
+
+static void VULKAN_WaitForFences(
+    Refresh_Renderer *driverData,
+    SDL_bool waitAll,
+    Refresh_Fence **pFences,
+    Uint32 fenceCount)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanFenceHandle *handle;
+    VkFence *fences;
+    VkSemaphore timelineSemaphores[SDL_arraysize(renderer->queues)];
+    Uint64 timelineValues[SDL_arraysize(renderer->queues)];
+    Uint32 timelineCount = 0;
+    VkSemaphoreWaitInfoKHR waitInfo;
+    VkResult result;
+    Sint32 i, j;
+
+    if (renderer->supportsTimelineSemaphore) {
+        /* Every fence shares one wait, only the deciding value of each queue timeline matters */
+        for (i = 0; i < fenceCount; i += 1) {
+            handle = (VulkanFenceHandle *)pFences[i];
+
+            for (j = 0; j < timelineCount; j += 1) {
+                if (timelineSemaphores[j] == handle->timelineSemaphore) {
+                    break;
+                }
+            }
+
+            if (j == timelineCount) {
+                timelineSemaphores[j] = handle->timelineSemaphore;
+                timelineValues[j] = handle->submissionValue;
+                timelineCount += 1;
+            } else if (waitAll) {
+                timelineValues[j] = SDL_max(timelineValues[j], handle->submissionValue);
+            } else {
+                timelineValues[j] = SDL_min(timelineValues[j], handle->submissionValue);
+            }
+        }
+
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+        waitInfo.pNext = NULL;
+        waitInfo.flags = waitAll ? 0 : VK_SEMAPHORE_WAIT_ANY_BIT_KHR;
+        waitInfo.semaphoreCount = timelineCount;
+        waitInfo.pSemaphores = timelineSemaphores;
+        waitInfo.pValues = timelineValues;
+
+        result = renderer->vkWaitSemaphoresKHR(
+            renderer->logicalDevice,
+            &waitInfo,
+            UINT64_MAX);
+
+        if (result != VK_SUCCESS) {
+            LogVulkanResultAsError("vkWaitSemaphoresKHR", result);
+        }
+    } else {
+        fences = SDL_stack_alloc(VkFence, fenceCount);
+
+        for (i = 0; i < fenceCount; i += 1) {
+            fences[i] = ((VulkanFenceHandle *)pFences[i])->fence;
+        }
+
+        result = renderer->vkWaitForFences(
+            renderer->logicalDevice,
+            fenceCount,
+            fences,
+            waitAll,
+            UINT64_MAX);
+
+        if (result != VK_SUCCESS) {
+            LogVulkanResultAsError("vkWaitForFences", result);
+        }
+
+        SDL_stack_free(fences);
+    }
+
+    VULKAN_INTERNAL_CleanCompletedCommandBuffers(renderer);
+}
+
+static SDL_bool VULKAN_INTERNAL_IsFenceWakePending(
+    VulkanRenderer *renderer)
+{
+    SDL_bool pending;
+
+    SDL_LockMutex(renderer->fenceWakeLock);
+    pending = renderer->fenceWakeValue != renderer->fenceWakeConsumed;
+    SDL_UnlockMutex(renderer->fenceWakeLock);
+
+    return pending;
+}
+
+static void VULKAN_WaitForAnyFenceOrWake(
+    Refresh_Renderer *driverData,
+    Refresh_Fence **pFences,
+    Uint32 fenceCount)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanFenceHandle *handle;
+    VkFence *fences;
+    VkSemaphore timelineSemaphores[SDL_arraysize(renderer->queues) + 1];
+    Uint64 timelineValues[SDL_arraysize(renderer->queues) + 1];
+    Uint32 timelineCount = 0;
+    VkSemaphoreWaitInfoKHR waitInfo;
+    Uint64 timeout;
+    VkResult result;
+    Uint32 i, j;
+
+    if (renderer->supportsTimelineSemaphore) {
+        for (i = 0; i < fenceCount; i += 1) {
+            handle = (VulkanFenceHandle *)pFences[i];
+
+            for (j = 0; j < timelineCount; j += 1) {
+                if (timelineSemaphores[j] == handle->timelineSemaphore) {
+                    break;
+                }
+            }
+
+            if (j == timelineCount) {
+                timelineSemaphores[j] = handle->timelineSemaphore;
+                timelineValues[j] = handle->submissionValue;
+                timelineCount += 1;
+            } else {
+                timelineValues[j] = SDL_min(timelineValues[j], handle->submissionValue);
+            }
+        }
+
+        /* Any wake after the last one this waiter saw ends the wait */
+        if (renderer->fenceWakeSemaphore != VK_NULL_HANDLE) {
+            timelineSemaphores[timelineCount] = renderer->fenceWakeSemaphore;
+            timelineValues[timelineCount] = renderer->fenceWakeConsumed + 1;
+            timelineCount += 1;
+            timeout = UINT64_MAX;
+        } else {
+            timeout = FENCE_WAKE_POLL_TIMEOUT;
+        }
+
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+        waitInfo.pNext = NULL;
+        waitInfo.flags = VK_SEMAPHORE_WAIT_ANY_BIT_KHR;
+        waitInfo.semaphoreCount = timelineCount;
+        waitInfo.pSemaphores = timelineSemaphores;
+        waitInfo.pValues = timelineValues;
+
+        do {
+            result = renderer->vkWaitSemaphoresKHR(
+                renderer->logicalDevice,
+                &waitInfo,
+                timeout);
+        } while (result == VK_TIMEOUT && !VULKAN_INTERNAL_IsFenceWakePending(renderer));
+
+        if (result != VK_SUCCESS && result != VK_TIMEOUT) {
+            LogVulkanResultAsError("vkWaitSemaphoresKHR", result);
+        }
+    } else if (fenceCount > 0) {
+        /* VkFences can't be signaled from the host, so wakes are checked between bounded waits */
+        fences = SDL_stack_alloc(VkFence, fenceCount);
+
+        for (i = 0; i < fenceCount; i += 1) {
+            fences[i] = ((VulkanFenceHandle *)pFences[i])->fence;
+        }
+
+        do {
+            result = renderer->vkWaitForFences(
+                renderer->logicalDevice,
+                fenceCount,
+                fences,
+                VK_FALSE,
+                FENCE_WAKE_POLL_TIMEOUT);
+        } while (result == VK_TIMEOUT && !VULKAN_INTERNAL_IsFenceWakePending(renderer));
+
+        if (result != VK_SUCCESS && result != VK_TIMEOUT) {
+            LogVulkanResultAsError("vkWaitForFences", result);
+        }
+
+        SDL_stack_free(fences);
+    } else {
+        while (!VULKAN_INTERNAL_IsFenceWakePending(renderer)) {
+            SDL_Delay(1);
+        }
+    }
+
+    /* Wakes arriving after this point stay pending for the next wait */
+    SDL_LockMutex(renderer->fenceWakeLock);
+    renderer->fenceWakeConsumed = renderer->fenceWakeValue;
+    SDL_UnlockMutex(renderer->fenceWakeLock);
+
+    VULKAN_INTERNAL_CleanCompletedCommandBuffers(renderer);
+}
+
+static void VULKAN_WakeFenceWait(
+    Refresh_Renderer *driverData)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VkSemaphoreSignalInfoKHR signalInfo;
+    VkResult result;
+
+    /* Signals happen under the lock so the wake timeline only moves forward */
+    SDL_LockMutex(renderer->fenceWakeLock);
+
+    renderer->fenceWakeValue += 1;
+
+    if (renderer->fenceWakeSemaphore != VK_NULL_HANDLE) {
+        signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR;
+        signalInfo.pNext = NULL;
+        signalInfo.semaphore = renderer->fenceWakeSemaphore;
+        signalInfo.value = renderer->fenceWakeValue;
+
+        result = renderer->vkSignalSemaphoreKHR(
+            renderer->logicalDevice,
+            &signalInfo);
+
+        if (result != VK_SUCCESS) {
+            LogVulkanResultAsError("vkSignalSemaphoreKHR", result);
+        }
+    }
+
+    SDL_UnlockMutex(renderer->fenceWakeLock);
+}
+
+static void VULKAN_Wait(
+    Refresh_Renderer *driverData)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanCommandBuffer *commandBuffer;
+    VkResult result;
+    Sint32 i;
+
+    result = renderer->vkDeviceWaitIdle(renderer->logicalDevice);
+
+    if (result != VK_SUCCESS) {
+        LogVulkanResultAsError("vkDeviceWaitIdle", result);
+        return;
+    }
+
+    SDL_LockMutex(renderer->submitLock);
+
+    for (i = renderer->submittedCommandBufferCount - 1; i >= 0; i -= 1) {
+        commandBuffer = renderer->submittedCommandBuffers[i];
+        VULKAN_INTERNAL_CleanCommandBuffer(renderer, commandBuffer);
+    }
+
+    VULKAN_INTERNAL_PerformPendingDestroys(renderer);
+
+    SDL_UnlockMutex(renderer->submitLock);
+}
+
+static VkSemaphore VULKAN_INTERNAL_CreateTimelineSemaphore(
+    VulkanRenderer *renderer)
+{
+    VkSemaphoreTypeCreateInfoKHR semaphoreTypeCreateInfo;
+    VkSemaphoreCreateInfo semaphoreCreateInfo;
+    VkSemaphore semaphore;
+    VkResult vulkanResult;
+
+    semaphoreTypeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+    semaphoreTypeCreateInfo.pNext = NULL;
+    semaphoreTypeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+    semaphoreTypeCreateInfo.initialValue = 0;
+
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+    semaphoreCreateInfo.flags = 0;
+
+    vulkanResult = renderer->vkCreateSemaphore(
+        renderer->logicalDevice,
+        &semaphoreCreateInfo,
+        NULL,
+        &semaphore);
+
+    if (vulkanResult != VK_SUCCESS) {
+        LogVulkanResultAsError("vkCreateSemaphore", vulkanResult);
+        return VK_NULL_HANDLE;
+    }
+
+    return semaphore;
+}
+
+static VkSemaphore VULKAN_INTERNAL_AcquireSemaphore(
+    VulkanRenderer *renderer)
+{
+    VkSemaphoreCreateInfo semaphoreCreateInfo;
+    VkSemaphore semaphore;
+    VkResult vulkanResult;
+
+    if (renderer->availableSemaphoreCount > 0) {
+        renderer->availableSemaphoreCount -= 1;
+        return renderer->availableSemaphores[renderer->availableSemaphoreCount];
+    }
+
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCreateInfo.pNext = NULL;
+    semaphoreCreateInfo.flags = 0;
+
+    vulkanResult = renderer->vkCreateSemaphore(
+        renderer->logicalDevice,
+        &semaphoreCreateInfo,
+        NULL,
+        &semaphore);
+
+    if (vulkanResult != VK_SUCCESS) {
+        LogVulkanResultAsError("vkCreateSemaphore", vulkanResult);
+        return VK_NULL_HANDLE;
+    }
+
+    return semaphore;
+}
+
+static Refresh_Fence *VULKAN_SubmitAndAcquireFence(
+    Refresh_CommandBuffer *commandBuffer)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer;
+
+    vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    vulkanCommandBuffer->autoReleaseFence = 0;
+
+    VULKAN_Submit(commandBuffer);
+
+    return (Refresh_Fence *)vulkanCommandBuffer->inFlightFence;
+}
+
+static void VULKAN_INTERNAL_TrimCycledContainers(
+    VulkanRenderer *renderer)
+{
+    VulkanBufferContainer *bufferContainer;
+    VulkanBufferHandle *bufferHandle;
+    VulkanTextureContainer *textureContainer;
+    VulkanTextureHandle *textureHandle;
+    Sint32 i, j;
+    Uint32 k;
+    Sint32 refCountTotal;
+
+    SDL_LockMutex(renderer->cycleLock);
+
+    renderer->presentedFrameCount += 1;
+
+    if (renderer->cycleTrimFrames == 0) {
+        SDL_UnlockMutex(renderer->cycleLock);
+        return;
+    }
+
+    for (i = renderer->cycledBufferContainerCount - 1; i >= 0; i -= 1) {
+        bufferContainer = renderer->cycledBufferContainers[i];
+
+        if (renderer->presentedFrameCount - bufferContainer->lastCycleFrame < renderer->cycleTrimFrames) {
+            continue;
+        }
+
+        for (j = bufferContainer->bufferCount - 1; j >= 0; j -= 1) {
+            bufferHandle = bufferContainer->bufferHandles[j];
+
+            if (
+                bufferHandle != bufferContainer->activeBufferHandle &&
+                bufferHandle->vulkanBuffer->bindlessIndex == BINDLESS_INVALID_INDEX &&
+                SDL_AtomicGet(&bufferHandle->vulkanBuffer->referenceCount) == 0) {
+                VULKAN_INTERNAL_ReleaseBuffer(renderer, bufferHandle->vulkanBuffer);
+                SDL_free(bufferHandle);
+
+                bufferContainer->bufferHandles[j] = bufferContainer->bufferHandles[bufferContainer->bufferCount - 1];
+                bufferContainer->bufferCount -= 1;
+
+                renderer->cycleHandlesTrimmed += 1;
+            }
+        }
+
+        if (bufferContainer->bufferCount == 1) {
+            renderer->cycledBufferContainers[i] = renderer->cycledBufferContainers[renderer->cycledBufferContainerCount - 1];
+            renderer->cycledBufferContainerCount -= 1;
+        }
+    }
+
+    for (i = renderer->cycledTextureContainerCount - 1; i >= 0; i -= 1) {
+        textureContainer = renderer->cycledTextureContainers[i];
+
+        if (renderer->presentedFrameCount - textureContainer->lastCycleFrame < renderer->cycleTrimFrames) {
+            continue;
+        }
+
+        for (j = textureContainer->textureCount - 1; j >= 0; j -= 1) {
+            textureHandle = textureContainer->textureHandles[j];
+
+            refCountTotal = 0;
+            for (k = 0; k < textureHandle->vulkanTexture->sliceCount; k += 1) {
+                refCountTotal += SDL_AtomicGet(&textureHandle->vulkanTexture->slices[k].referenceCount);
+            }
+
+            if (
+                textureHandle != textureContainer->activeTextureHandle &&
+                textureHandle->vulkanTexture->bindlessIndex == BINDLESS_INVALID_INDEX &&
+                refCountTotal == 0) {
+                VULKAN_INTERNAL_ReleaseTexture(renderer, textureHandle->vulkanTexture);
+                SDL_free(textureHandle);
+
+                textureContainer->textureHandles[j] = textureContainer->textureHandles[textureContainer->textureCount - 1];
+                textureContainer->textureCount -= 1;
+
+                renderer->cycleHandlesTrimmed += 1;
+            }
+        }
+
+        if (textureContainer->textureCount == 1) {
+            renderer->cycledTextureContainers[i] = renderer->cycledTextureContainers[renderer->cycledTextureContainerCount - 1];
+            renderer->cycledTextureContainerCount -= 1;
+        }
+    }
+
+    SDL_UnlockMutex(renderer->cycleLock);
+}
+
+/* Samplers don't need ordering, so only registered textures and storage buffers count */
+static SDL_bool VULKAN_INTERNAL_HasBindlessResources(
+    VulkanRenderer *renderer)
+{
+    VulkanBindlessTable *textureTable = &renderer->bindlessTables[REFRESH_BINDLESSRESOURCETYPE_TEXTURE];
+    VulkanBindlessTable *bufferTable = &renderer->bindlessTables[REFRESH_BINDLESSRESOURCETYPE_STORAGEBUFFER];
+    SDL_bool result;
+
+    SDL_LockMutex(renderer->bindlessLock);
+
+    result =
+        textureTable->resourceCount > textureTable->freeIndexCount ||
+        bufferTable->resourceCount > bufferTable->freeIndexCount;
+
+    SDL_UnlockMutex(renderer->bindlessLock);
+
+    return result;
+}
+
+/* Must be called with the submit lock held.
+ * Returns SDL_TRUE if the command buffer presented to a swapchain.
+ */
+static SDL_bool VULKAN_INTERNAL_SubmitCommandBuffer(
+    VulkanRenderer *renderer,
+    VulkanCommandBuffer *vulkanCommandBuffer,
+    Uint8 signalOtherQueues)
+{
+    VulkanQueue *queue = vulkanCommandBuffer->commandPool->queue;
+    Uint32 queueIndex = (Uint32)(queue - renderer->queues);
+    VulkanQueue *otherQueue;
+    VulkanQueue *signaledQueues[3];
+    VkSemaphore queueSemaphores[3];
+    Uint64 queueWaitValues[3];
+    Uint64 submissionValue;
+    SDL_bool usesBindless = vulkanCommandBuffer->boundBindlessSet && VULKAN_INTERNAL_HasBindlessResources(renderer);
+    VkSubmitInfo submitInfo;
+    VkPresentInfoKHR presentInfo;
+    VulkanPresentData *presentData;
+    VkResult vulkanResult, presentResult = VK_SUCCESS;
+    VkSemaphore *waitSemaphores;
+    VkPipelineStageFlags *waitStages;
+    Uint64 *waitValues;
+    VkSemaphore *signalSemaphores;
+    Uint64 *signalValues;
+    VkTimelineSemaphoreSubmitInfoKHR timelineSubmitInfo;
+    Uint32 waitSemaphoreCount, signalSemaphoreCount, signaledQueueCount = 0;
+    Uint32 swapchainImageIndex;
+    VulkanTextureSlice *swapchainTextureSlice;
+    SDL_bool presenting = SDL_FALSE;
+    Sint32 i, j;
+
+    /* Queue types may share a VkQueue, in which case submission order already orders them */
+    if (!renderer->supportsTimelineSemaphore) {
+        for (i = 0; i < (Sint32)SDL_arraysize(renderer->queues); i += 1) {
+            otherQueue = &renderer->queues[i];
+
+            if (otherQueue->queue != queue->queue) {
+                continue;
+            }
+
+            for (j = 0; j < (Sint32)otherQueue->pendingWaitSemaphoreCount; j += 1) {
+                EXPAND_ARRAY_IF_NEEDED(
+                    vulkanCommandBuffer->asyncWaitSemaphores,
+                    VkSemaphore,
+                    vulkanCommandBuffer->asyncWaitSemaphoreCount + 1,
+                    vulkanCommandBuffer->asyncWaitSemaphoreCapacity,
+                    vulkanCommandBuffer->asyncWaitSemaphoreCapacity * 2);
+
+                vulkanCommandBuffer->asyncWaitSemaphores[vulkanCommandBuffer->asyncWaitSemaphoreCount] = otherQueue->pendingWaitSemaphores[j];
+                vulkanCommandBuffer->asyncWaitSemaphoreCount += 1;
+            }
+            otherQueue->pendingWaitSemaphoreCount = 0;
+        }
+
+        /* One semaphore per distinct VkQueue, queued on the first queue type that uses it */
+        for (i = 0; signalOtherQueues && i < (Sint32)SDL_arraysize(renderer->queues); i += 1) {
+            otherQueue = &renderer->queues[i];
+
+            if (otherQueue->queue == queue->queue) {
+                continue;
+            }
+
+            for (j = 0; j < i; j += 1) {
+                if (renderer->queues[j].queue == otherQueue->queue) {
+                    break;
+                }
+            }
+
+            if (j < i) {
+                continue;
+            }
+
+            queueSemaphores[signaledQueueCount] = VULKAN_INTERNAL_AcquireSemaphore(renderer);
+
+            if (queueSemaphores[signaledQueueCount] != VK_NULL_HANDLE) {
+                signaledQueues[signaledQueueCount] = otherQueue;
+                signaledQueueCount += 1;
+            }
+        }
+    }
+
+    waitSemaphoreCount = vulkanCommandBuffer->waitSemaphoreCount + vulkanCommandBuffer->asyncWaitSemaphoreCount;
+    signalSemaphoreCount = vulkanCommandBuffer->signalSemaphoreCount + signaledQueueCount;
+
+    /* Room for a timeline wait per queue and this queue's own timeline signal */
+    waitSemaphores = SDL_stack_alloc(VkSemaphore, waitSemaphoreCount + SDL_arraysize(renderer->queues));
+    waitStages = SDL_stack_alloc(VkPipelineStageFlags, waitSemaphoreCount + SDL_arraysize(renderer->queues));
+    waitValues = SDL_stack_alloc(Uint64, waitSemaphoreCount + SDL_arraysize(renderer->queues));
+    signalSemaphores = SDL_stack_alloc(VkSemaphore, signalSemaphoreCount + 1);
+    signalValues = SDL_stack_alloc(Uint64, signalSemaphoreCount + 1);
+    SDL_memset(waitValues, 0, sizeof(Uint64) * (waitSemaphoreCount + SDL_arraysize(renderer->queues)));
+    SDL_memset(signalValues, 0, sizeof(Uint64) * (signalSemaphoreCount + 1));
+
+    for (i = 0; i < (Sint32)vulkanCommandBuffer->waitSemaphoreCount; i += 1) {
+        waitSemaphores[i] = vulkanCommandBuffer->waitSemaphores[i];
+        waitStages[i] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    }
+
+    for (j = 0; j < (Sint32)vulkanCommandBuffer->asyncWaitSemaphoreCount; j += 1) {
+        waitSemaphores[i + j] = vulkanCommandBuffer->asyncWaitSemaphores[j];
+        waitStages[i + j] = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
+
+    /* Wait on the latest submission to each other queue that used one of this command buffer's resources,
+     * unless an earlier submission to this queue already waited on it.
+     */
+    if (renderer->supportsTimelineSemaphore) {
+        for (i = 0; i < (Sint32)SDL_arraysize(renderer->queues); i += 1) {
+            queueWaitValues[i] = usesBindless ? renderer->queues[i].lastSubmissionValue : renderer->queues[i].lastBindlessValue;
+        }
+
+        for (j = 0; j < (Sint32)vulkanCommandBuffer->usedBufferCount; j += 1) {
+            for (i = 0; i < (Sint32)SDL_arraysize(renderer->queues); i += 1) {
+                queueWaitValues[i] = SDL_max(queueWaitValues[i], vulkanCommandBuffer->usedBuffers[j]->lastUseValues[i]);
+            }
+        }
+
+        for (j = 0; j < (Sint32)vulkanCommandBuffer->usedTextureSliceCount; j += 1) {
+            for (i = 0; i < (Sint32)SDL_arraysize(renderer->queues); i += 1) {
+                queueWaitValues[i] = SDL_max(queueWaitValues[i], vulkanCommandBuffer->usedTextureSlices[j]->lastUseValues[i]);
+            }
+        }
+
+        for (i = 0; i < (Sint32)SDL_arraysize(renderer->queues); i += 1) {
+            otherQueue = &renderer->queues[i];
+
+            if (
+                otherQueue->queue != queue->queue &&
+                queueWaitValues[i] > queue->waitedValues[i]) {
+                waitSemaphores[waitSemaphoreCount] = otherQueue->timelineSemaphore;
+                waitStages[waitSemaphoreCount] = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+                waitValues[waitSemaphoreCount] = queueWaitValues[i];
+                waitSemaphoreCount += 1;
+
+                queue->waitedValues[i] = queueWaitValues[i];
+            }
+        }
+    }
+
+    for (i = 0; i < (Sint32)vulkanCommandBuffer->signalSemaphoreCount; i += 1) {
+        signalSemaphores[i] = vulkanCommandBuffer->signalSemaphores[i];
+    }
+
+    for (j = 0; j < (Sint32)signaledQueueCount; j += 1) {
+        signalSemaphores[i + j] = queueSemaphores[j];
+    }
+
+    for (j = 0; j < vulkanCommandBuffer->presentDataCount; j += 1) {
+        swapchainImageIndex = vulkanCommandBuffer->presentDatas[j].swapchainImageIndex;
+        swapchainTextureSlice = VULKAN_INTERNAL_FetchTextureSlice(
+            vulkanCommandBuffer->presentDatas[j].windowData->swapchainData->textureContainers[swapchainImageIndex].activeTextureHandle->vulkanTexture,
+            0,
+            0);
+
+        VULKAN_INTERNAL_TextureTransitionFromDefaultUsage(
+            renderer,
+            vulkanCommandBuffer,
+            VULKAN_TEXTURE_USAGE_MODE_PRESENT,
+            swapchainTextureSlice);
+    }
+
+    VULKAN_INTERNAL_EndCommandBuffer(renderer, vulkanCommandBuffer);
+
+    vulkanCommandBuffer->inFlightFence = VULKAN_INTERNAL_AcquireFenceFromPool(renderer);
+
+    /* Command buffer has a reference to the in-flight fence */
+    (void)SDL_AtomicIncRef(&vulkanCommandBuffer->inFlightFence->referenceCount);
+
+    /* Serials only advance under the submit lock, so each queue timeline is signaled in increasing order */
+    vulkanCommandBuffer->inFlightFence->submissionValue = renderer->submissionSerial + 1;
+
+    if (renderer->supportsTimelineSemaphore) {
+        vulkanCommandBuffer->inFlightFence->timelineSemaphore = queue->timelineSemaphore;
+
+        signalSemaphores[signalSemaphoreCount] = queue->timelineSemaphore;
+        signalValues[signalSemaphoreCount] = vulkanCommandBuffer->inFlightFence->submissionValue;
+        signalSemaphoreCount += 1;
+
+        /* Binary semaphore values are ignored */
+        timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        timelineSubmitInfo.pNext = NULL;
+        timelineSubmitInfo.waitSemaphoreValueCount = waitSemaphoreCount;
+        timelineSubmitInfo.pWaitSemaphoreValues = waitValues;
+        timelineSubmitInfo.signalSemaphoreValueCount = signalSemaphoreCount;
+        timelineSubmitInfo.pSignalSemaphoreValues = signalValues;
+    }
+
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = renderer->supportsTimelineSemaphore ? &timelineSubmitInfo : NULL;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &vulkanCommandBuffer->commandBuffer;
+
+    submitInfo.pWaitDstStageMask = waitStages;
+    submitInfo.pWaitSemaphores = waitSemaphores;
+    submitInfo.waitSemaphoreCount = waitSemaphoreCount;
+    submitInfo.pSignalSemaphores = signalSemaphores;
+    submitInfo.signalSemaphoreCount = signalSemaphoreCount;
+
+    vulkanResult = renderer->vkQueueSubmit(
+        queue->queue,
+        1,
+        &submitInfo,
+        vulkanCommandBuffer->inFlightFence->fence);
+
+    SDL_stack_free(waitSemaphores);
+    SDL_stack_free(waitStages);
+    SDL_stack_free(waitValues);
+    SDL_stack_free(signalSemaphores);
+    SDL_stack_free(signalValues);
+
+    if (vulkanResult != VK_SUCCESS) {
+        LogVulkanResultAsError("vkQueueSubmit", vulkanResult);
+    } else if (renderer->supportsTimelineSemaphore) {
+        submissionValue = vulkanCommandBuffer->inFlightFence->submissionValue;
+
+        queue->lastSubmissionValue = submissionValue;
+
+        if (usesBindless) {
+            queue->lastBindlessValue = submissionValue;
+        }
+
+        for (i = 0; i < (Sint32)vulkanCommandBuffer->usedBufferCount; i += 1) {
+            vulkanCommandBuffer->usedBuffers[i]->lastUseValues[queueIndex] = submissionValue;
+        }
+
+        for (i = 0; i < (Sint32)vulkanCommandBuffer->usedTextureSliceCount; i += 1) {
+            vulkanCommandBuffer->usedTextureSlices[i]->lastUseValues[queueIndex] = submissionValue;
+        }
+    }
+
+    /* The next submission to each signaled queue will wait on this work.
+     * If the submission failed nothing will be signaled, so the semaphores go back to the pool.
+     */
+    for (i = 0; i < (Sint32)signaledQueueCount; i += 1) {
+        if (vulkanResult == VK_SUCCESS) {
+            EXPAND_ARRAY_IF_NEEDED(
+                signaledQueues[i]->pendingWaitSemaphores,
+                VkSemaphore,
+                signaledQueues[i]->pendingWaitSemaphoreCount + 1,
+                signaledQueues[i]->pendingWaitSemaphoreCapacity,
+                signaledQueues[i]->pendingWaitSemaphoreCapacity * 2);
+
+            signaledQueues[i]->pendingWaitSemaphores[signaledQueues[i]->pendingWaitSemaphoreCount] = queueSemaphores[i];
+            signaledQueues[i]->pendingWaitSemaphoreCount += 1;
+        } else {
+            EXPAND_ARRAY_IF_NEEDED(
+                renderer->availableSemaphores,
+                VkSemaphore,
+                renderer->availableSemaphoreCount + 1,
+                renderer->availableSemaphoreCapacity,
+                renderer->availableSemaphoreCapacity * 2);
+
+            renderer->availableSemaphores[renderer->availableSemaphoreCount] = queueSemaphores[i];
+            renderer->availableSemaphoreCount += 1;
+        }
+    }
+
+    /* Mark command buffers as submitted */
+
+    SDL_LockMutex(renderer->disposeLock);
+    renderer->submissionSerial += 1;
+    vulkanCommandBuffer->submissionSerial = renderer->submissionSerial;
+    SDL_UnlockMutex(renderer->disposeLock);
+
+    if (renderer->submittedCommandBufferCount + 1 >= renderer->submittedCommandBufferCapacity) {
+        renderer->submittedCommandBufferCapacity = renderer->submittedCommandBufferCount + 1;
+
+        renderer->submittedCommandBuffers = SDL_realloc(
+            renderer->submittedCommandBuffers,
+            sizeof(VulkanCommandBuffer *) * renderer->submittedCommandBufferCapacity);
+    }
+
+    renderer->submittedCommandBuffers[renderer->submittedCommandBufferCount] = vulkanCommandBuffer;
+    renderer->submittedCommandBufferCount += 1;
+
+    /* Present, if applicable */
+
+    for (j = 0; j < vulkanCommandBuffer->presentDataCount; j += 1) {
+        presenting = SDL_TRUE;
+
+        presentData = &vulkanCommandBuffer->presentDatas[j];
+
+        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.pNext = NULL;
+        presentInfo.pWaitSemaphores =
+            &presentData->windowData->swapchainData->renderFinishedSemaphore[presentData->windowData->swapchainData->frameCounter];
+        presentInfo.waitSemaphoreCount = 1;
+        presentInfo.pSwapchains = &presentData->windowData->swapchainData->swapchain;
+        presentInfo.swapchainCount = 1;
+        presentInfo.pImageIndices = &presentData->swapchainImageIndex;
+        presentInfo.pResults = NULL;
+
+        presentResult = renderer->vkQueuePresentKHR(
+            renderer->unifiedQueue,
+            &presentInfo);
+
+        if (presentResult != VK_SUCCESS) {
+            VULKAN_INTERNAL_RecreateSwapchain(
+                renderer,
+                presentData->windowData);
+        } else {
+            /* If presenting, the swapchain is using the in-flight fence.
+             * It goes in this frame's slot, which gets waited on once the window wraps around to it.
+             */
+            presentData->windowData->swapchainData->inFlightFences[presentData->windowData->swapchainData->frameCounter] = vulkanCommandBuffer->inFlightFence;
+
+            (void)SDL_AtomicIncRef(&vulkanCommandBuffer->inFlightFence->referenceCount);
+
+            presentData->windowData->swapchainData->frameCounter =
+                (presentData->windowData->swapchainData->frameCounter + 1) % presentData->windowData->allowedFramesInFlight;
+        }
+    }
+
+    return presenting;
+}
+
+static void VULKAN_Submit(
+    Refresh_CommandBuffer *commandBuffer)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
+    VulkanCommandBuffer *flushCommandBuffer;
+    VkMemoryBarrier memoryBarrier;
+    Uint8 commandBufferCleaned = 0;
+    VulkanMemorySubAllocator *allocator;
+    SDL_bool presenting;
+    Sint32 i, j;
+
+    SDL_LockMutex(renderer->submitLock);
+
+    presenting = VULKAN_INTERNAL_SubmitCommandBuffer(renderer, vulkanCommandBuffer, 1);
+
+    /* Check if we can perform any cleanups */
+
+    for (i = renderer->submittedCommandBufferCount - 1; i >= 0; i -= 1) {
+        if (VULKAN_INTERNAL_IsFenceSignaled(
+                renderer,
+                renderer->submittedCommandBuffers[i]->inFlightFence)) {
+            VULKAN_INTERNAL_CleanCommandBuffer(
+                renderer,
+                renderer->submittedCommandBuffers[i]);
+
+            commandBufferCleaned = 1;
+        }
+    }
+
+    if (commandBufferCleaned) {
+        SDL_LockMutex(renderer->allocatorLock);
+
+        for (i = 0; i < VK_MAX_MEMORY_TYPES; i += 1) {
+            allocator = &renderer->memoryAllocator->subAllocators[i];
+
+            SDL_LockMutex(allocator->lock);
+
+            for (j = allocator->allocationCount - 1; j >= 0; j -= 1) {
+                if (allocator->allocations[j]->usedRegionCount == 0) {
+                    VULKAN_INTERNAL_DeallocateMemory(
+                        renderer,
+                        allocator,
+                        j);
+                }
+            }
+
+            SDL_UnlockMutex(allocator->lock);
+        }
+
+        SDL_UnlockMutex(renderer->allocatorLock);
+    }
+
+    /* Check pending destroys */
+    VULKAN_INTERNAL_PerformPendingDestroys(renderer);
+
+    /* Release cycled handles that have been idle for a while */
+    if (presenting) {
+        VULKAN_INTERNAL_TrimCycledContainers(renderer);
+    }
+
+    /* Defrag! */
+    if (
+        presenting &&
+        renderer->defragRequested &&
+        renderer->allocationsToDefragCount == 0 &&
+        !renderer->defragInProgress) {
+        SDL_LockMutex(renderer->allocatorLock);
+        VULKAN_INTERNAL_MarkAllocationsForDefrag(renderer);
+        renderer->defragRequested = 0;
+        SDL_UnlockMutex(renderer->allocatorLock);
+    }
+
+    if (
+        presenting &&
+        renderer->allocationsToDefragCount > 0 &&
+        !renderer->defragInProgress) {
+        VULKAN_INTERNAL_DefragmentMemory(renderer);
+    }
+
+    /* Don't let binary semaphores pile up on a queue the client isn't submitting to.
+     * The flush goes through the internal path so it doesn't repeat the cleanups above,
+     * and it signals nothing since it carries no work of its own.
+     */
+    for (i = 0; i < (Sint32)SDL_arraysize(renderer->queues); i += 1) {
+        if (renderer->queues[i].pendingWaitSemaphoreCount < MAX_PENDING_ASYNC_SEMAPHORES) {
+            continue;
+        }
+
+        flushCommandBuffer = (VulkanCommandBuffer *)VULKAN_AcquireCommandBuffer(
+            (Refresh_Renderer *)renderer,
+            (Refresh_QueueType)i);
+
+        if (flushCommandBuffer == NULL) {
+            continue;
+        }
+
+        /* Semaphore waits only cover their own batch, the barrier extends them to later submissions */
+        memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.pNext = NULL;
+        memoryBarrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+        renderer->vkCmdPipelineBarrier(
+            flushCommandBuffer->commandBuffer,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            0,
+            1,
+            &memoryBarrier,
+            0,
+            NULL,
+            0,
+            NULL);
+
+        (void)VULKAN_INTERNAL_SubmitCommandBuffer(renderer, flushCommandBuffer, 0);
+    }
+
+    SDL_UnlockMutex(renderer->submitLock);
+}
+
+static Uint8 VULKAN_INTERNAL_DefragmentMemory(
+    VulkanRenderer *renderer)
+{
+    VulkanMemoryAllocation *allocation;
+    VulkanMemoryUsedRegion *currentRegion;
+    VulkanBuffer *newBuffer;
+    VulkanTexture *newTexture;
+    VkBufferCopy bufferCopy;
+    VkImageCopy imageCopy;
+    VulkanCommandBuffer *commandBuffer;
+    VulkanTextureSlice *srcSlice;
+    VulkanTextureSlice *dstSlice;
+    Uint32 i, sliceIndex;
+    VkDeviceSize bytesMoved = 0;
+    Uint64 startTime = SDL_GetPerformanceCounter();
+    Uint64 maxTime = (Uint64)renderer->defragMaxMicrosecondsPerFrame * SDL_GetPerformanceFrequency() / 1000000;
+    Uint8 budgetExhausted = 0;
+    Uint8 failed = 0;
+
+    SDL_LockMutex(renderer->allocatorLock);
+
+    commandBuffer = (VulkanCommandBuffer *)VULKAN_AcquireCommandBuffer(
+        (Refresh_Renderer *)renderer,
+        REFRESH_QUEUETYPE_GRAPHICS);
+    if (commandBuffer == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create defrag command buffer!");
+        SDL_UnlockMutex(renderer->allocatorLock);
+        return 0;
+    }
+
+    /* Cleared when the command buffer is cleaned up */
+    renderer->defragInProgress = 1;
+    commandBuffer->isDefrag = 1;
+
+    allocation = renderer->allocationsToDefrag[renderer->allocationsToDefragCount - 1];
+
+    /* Keep loader threads from releasing regions while we walk them */
+    SDL_LockMutex(allocation->allocator->lock);
+
+    /* For each used region in the allocation
+     * create a new resource, copy the data
+     * and re-point the resource containers.
+     * Moved resources are marked for destroy, so a partially
+     * defragged allocation is resumed by skipping over them.
+     */
+    for (i = 0; i < allocation->usedRegionCount && !budgetExhausted && !failed; i += 1) {
+        currentRegion = allocation->usedRegions[i];
+
+        if (
+            currentRegion->isBuffer &&
+            !currentRegion->vulkanBuffer->markedForDestroy &&
+            currentRegion->vulkanBuffer->bindlessIndex == BINDLESS_INVALID_INDEX) {
+            currentRegion->vulkanBuffer->usageFlags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+            newBuffer = VULKAN_INTERNAL_CreateBuffer(
+                renderer,
+                currentRegion->vulkanBuffer->size,
+                currentRegion->vulkanBuffer->usageFlags,
+                currentRegion->vulkanBuffer->type);
+
+            if (newBuffer == NULL) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create defrag buffer!");
+                failed = 1;
+                break;
+            }
+
+            if (
+                renderer->debugMode &&
+                renderer->supportsDebugUtils &&
+                currentRegion->vulkanBuffer->handle != NULL &&
+                currentRegion->vulkanBuffer->handle->container != NULL &&
+                currentRegion->vulkanBuffer->handle->container->debugName != NULL) {
+                VULKAN_INTERNAL_SetBufferName(
+                    renderer,
+                    newBuffer,
+                    currentRegion->vulkanBuffer->handle->container->debugName);
+            }
+
+            /* Copy buffer contents if necessary */
+            if (
+                currentRegion->vulkanBuffer->type == VULKAN_BUFFER_TYPE_GPU && currentRegion->vulkanBuffer->transitioned) {
+                VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
+                    renderer,
+                    commandBuffer,
+                    VULKAN_BUFFER_USAGE_MODE_COPY_SOURCE,
+                    currentRegion->vulkanBuffer);
+
+                VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
+                    renderer,
+                    commandBuffer,
+                    VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
+                    newBuffer);
+
+                bufferCopy.srcOffset = 0;
+                bufferCopy.dstOffset = 0;
+                bufferCopy.size = currentRegion->resourceSize;
+
+                VULKAN_INTERNAL_FlushBarriers(renderer, commandBuffer);
+
+                renderer->vkCmdCopyBuffer(
+                    commandBuffer->commandBuffer,
+                    currentRegion->vulkanBuffer->buffer,
+                    newBuffer->buffer,
+                    1,
+                    &bufferCopy);
+
+                VULKAN_INTERNAL_BufferTransitionToDefaultUsage(
+                    renderer,
+                    commandBuffer,
+                    VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
+                    newBuffer);
+
+                VULKAN_INTERNAL_TrackBuffer(commandBuffer, currentRegion->vulkanBuffer);
+                VULKAN_INTERNAL_TrackBuffer(commandBuffer, newBuffer);
+            }
+
+            /* re-point original container to new buffer */
+            if (currentRegion->vulkanBuffer->handle != NULL) {
+                newBuffer->handle = currentRegion->vulkanBuffer->handle;
+                newBuffer->handle->vulkanBuffer = newBuffer;
+                currentRegion->vulkanBuffer->handle = NULL;
+            }
+
+            VULKAN_INTERNAL_ReleaseBuffer(renderer, currentRegion->vulkanBuffer);
+        } else if (
+            !currentRegion->isBuffer &&
+            !currentRegion->vulkanTexture->markedForDestroy &&
+            currentRegion->vulkanTexture->bindlessIndex == BINDLESS_INVALID_INDEX) {
+            newTexture = VULKAN_INTERNAL_CreateTexture(
+                renderer,
+                currentRegion->vulkanTexture->dimensions.width,
+                currentRegion->vulkanTexture->dimensions.height,
+                currentRegion->vulkanTexture->depth,
+                currentRegion->vulkanTexture->isCube,
+                currentRegion->vulkanTexture->layerCount,
+                currentRegion->vulkanTexture->levelCount,
+                currentRegion->vulkanTexture->sampleCount,
+                currentRegion->vulkanTexture->format,
+                currentRegion->vulkanTexture->swizzle,
+                currentRegion->vulkanTexture->aspectFlags,
+                currentRegion->vulkanTexture->usageFlags,
+                currentRegion->vulkanTexture->isMSAAColorTarget);
+
+            if (newTexture == NULL) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create defrag texture!");
+                failed = 1;
+                break;
+            }
+
+            for (sliceIndex = 0; sliceIndex < currentRegion->vulkanTexture->sliceCount; sliceIndex += 1) {
+                /* copy slice if necessary */
+                srcSlice = &currentRegion->vulkanTexture->slices[sliceIndex];
+                dstSlice = &newTexture->slices[sliceIndex];
+
+                /* Set debug name if it exists */
+                if (
+                    renderer->debugMode &&
+                    renderer->supportsDebugUtils &&
+                    srcSlice->parent->handle != NULL &&
+                    srcSlice->parent->handle->container != NULL &&
+                    srcSlice->parent->handle->container->debugName != NULL) {
+                    VULKAN_INTERNAL_SetTextureName(
+                        renderer,
+                        currentRegion->vulkanTexture,
+                        srcSlice->parent->handle->container->debugName);
+                }
+
+                if (srcSlice->transitioned) {
+                    VULKAN_INTERNAL_TextureTransitionFromDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
+                        srcSlice);
+
+                    VULKAN_INTERNAL_TextureTransitionFromDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
+                        dstSlice);
+
+                    imageCopy.srcOffset.x = 0;
+                    imageCopy.srcOffset.y = 0;
+                    imageCopy.srcOffset.z = 0;
+                    imageCopy.srcSubresource.aspectMask = srcSlice->parent->aspectFlags;
+                    imageCopy.srcSubresource.baseArrayLayer = srcSlice->layer;
+                    imageCopy.srcSubresource.layerCount = 1;
+                    imageCopy.srcSubresource.mipLevel = srcSlice->level;
+                    imageCopy.extent.width = SDL_max(1, srcSlice->parent->dimensions.width >> srcSlice->level);
+                    imageCopy.extent.height = SDL_max(1, srcSlice->parent->dimensions.height >> srcSlice->level);
+                    imageCopy.extent.depth = srcSlice->parent->depth;
+                    imageCopy.dstOffset.x = 0;
+                    imageCopy.dstOffset.y = 0;
+                    imageCopy.dstOffset.z = 0;
+                    imageCopy.dstSubresource.aspectMask = dstSlice->parent->aspectFlags;
+                    imageCopy.dstSubresource.baseArrayLayer = dstSlice->layer;
+                    imageCopy.dstSubresource.layerCount = 1;
+                    imageCopy.dstSubresource.mipLevel = dstSlice->level;
+
+                    VULKAN_INTERNAL_FlushBarriers(renderer, commandBuffer);
+
+                    renderer->vkCmdCopyImage(
+                        commandBuffer->commandBuffer,
+                        currentRegion->vulkanTexture->image,
+                        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                        newTexture->image,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                        1,
+                        &imageCopy);
+
+                    VULKAN_INTERNAL_TextureTransitionToDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
+                        dstSlice);
+
+                    VULKAN_INTERNAL_TrackTextureSlice(commandBuffer, srcSlice);
+                    VULKAN_INTERNAL_TrackTextureSlice(commandBuffer, dstSlice);
+                }
+            }
+
+            /* re-point original container to new texture */
+            newTexture->handle = currentRegion->vulkanTexture->handle;
+            newTexture->handle->vulkanTexture = newTexture;
+            currentRegion->vulkanTexture->handle = NULL;
 
-    presentData->windowData = windowData;
-    presentData->swapchainImageIndex = swapchainImageIndex;
+            VULKAN_INTERNAL_ReleaseTexture(renderer, currentRegion->vulkanTexture);
+        } else {
+            continue;
+        }
 
-    /* Set up present semaphores */
+        bytesMoved += currentRegion->resourceSize;
 
-    if (vulkanCommandBuffer->waitSemaphoreCount == vulkanCommandBuffer->waitSemaphoreCapacity) {
-        vulkanCommandBuffer->waitSemaphoreCapacity += 1;
-        vulkanCommandBuffer->waitSemaphores = SDL_realloc(
-            vulkanCommandBuffer->waitSemaphores,
-            vulkanCommandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore));
+        budgetExhausted =
+            (renderer->defragMaxBytesPerFrame > 0 && bytesMoved >= renderer->defragMaxBytesPerFrame) ||
+            (maxTime > 0 && SDL_GetPerformanceCounter() - startTime >= maxTime);
     }
 
-    vulkanCommandBuffer->waitSemaphores[vulkanCommandBuffer->waitSemaphoreCount] =
-        swapchainData->imageAvailableSemaphore[swapchainData->frameCounter];
-    vulkanCommandBuffer->waitSemaphoreCount += 1;
-
-    if (vulkanCommandBuffer->signalSemaphoreCount == vulkanCommandBuffer->signalSemaphoreCapacity) {
-        vulkanCommandBuffer->signalSemaphoreCapacity += 1;
-        vulkanCommandBuffer->signalSemaphores = SDL_realloc(
-            vulkanCommandBuffer->signalSemaphores,
-            vulkanCommandBuffer->signalSemaphoreCapacity * sizeof(VkSemaphore));
+    /* Keep the allocation queued until every region has been visited.
+     * A failed region is retried on a later defrag.
+     */
+    if (!failed && i == allocation->usedRegionCount) {
+        renderer->allocationsToDefragCount -= 1;
     }
 
-    vulkanCommandBuffer->signalSemaphores[vulkanCommandBuffer->signalSemaphoreCount] =
-        swapchainData->renderFinishedSemaphore[swapchainData->frameCounter];
-    vulkanCommandBuffer->signalSemaphoreCount += 1;
+    renderer->defragBytesMoved += bytesMoved;
 
-    *pWidth = swapchainData->extent.width;
-    *pHeight = swapchainData->extent.height;
+    SDL_UnlockMutex(allocation->allocator->lock);
+    SDL_UnlockMutex(renderer->allocatorLock);
 
-    return (Refresh_Texture *)swapchainTextureContainer;
+    /* Defrag runs from VULKAN_Submit with the submit lock held.
+     * Submit even on failure: regions moved so far have already been re-pointed,
+     * and cleaning up the command buffer clears defragInProgress.
+     */
+    (void)VULKAN_INTERNAL_SubmitCommandBuffer(renderer, commandBuffer, 1);
+
+    return !failed;
 }
 
-static Refresh_TextureFormat VULKAN_GetSwapchainTextureFormat(
+/* Format Info */
+
+static SDL_bool VULKAN_IsTextureFormatSupported(
     Refresh_Renderer *driverData,
-    SDL_Window *window)
+    Refresh_TextureFormat format,
+    Refresh_TextureType type,
+    Refresh_TextureUsageFlags usage)
 {
-    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VkFormat vulkanFormat = RefreshToVK_SurfaceFormat[format];
+    VkImageUsageFlags vulkanUsage = 0;
+    VkImageCreateFlags createFlags = 0;
+    VkImageFormatProperties properties;
+    VkResult vulkanResult;
 
-    if (windowData == NULL) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot get swapchain format, window has not been claimed!");
-        return 0;
+    if (usage & REFRESH_TEXTUREUSAGE_SAMPLER_BIT) {
+        vulkanUsage |= VK_IMAGE_USAGE_SAMPLED_BIT;
     }
-
-    if (windowData->swapchainData == NULL) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot get swapchain format, swapchain is currently invalid!");
-        return 0;
+    if (usage & REFRESH_TEXTUREUSAGE_COLOR_TARGET_BIT) {
+        vulkanUsage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    }
+    if (usage & REFRESH_TEXTUREUSAGE_DEPTH_STENCIL_TARGET_BIT) {
+        vulkanUsage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    }
+    if (usage & (REFRESH_TEXTUREUSAGE_GRAPHICS_STORAGE_READ_BIT |
+                 REFRESH_TEXTUREUSAGE_COMPUTE_STORAGE_READ_BIT |
+                 REFRESH_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE_BIT)) {
+        vulkanUsage |= VK_IMAGE_USAGE_STORAGE_BIT;
     }
 
-    switch (windowData->swapchainData->format) {
-    case VK_FORMAT_R8G8B8A8_UNORM:
-        return REFRESH_TEXTUREFORMAT_R8G8B8A8;
-
-    case VK_FORMAT_B8G8R8A8_UNORM:
-        return REFRESH_TEXTUREFORMAT_B8G8R8A8;
-
-    case VK_FORMAT_B8G8R8A8_SRGB:
-        return REFRESH_TEXTUREFORMAT_B8G8R8A8_SRGB;
-
-    case VK_FORMAT_R8G8B8A8_SRGB:
-        return REFRESH_TEXTUREFORMAT_R8G8B8A8_SRGB;
-
-    case VK_FORMAT_R16G16B16A16_SFLOAT:
-        return REFRESH_TEXTUREFORMAT_R16G16B16A16_SFLOAT;
+    if (type == REFRESH_TEXTURETYPE_CUBE) {
+        createFlags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+    }
 
-    case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
-        return REFRESH_TEXTUREFORMAT_R10G10B10A2;
+    vulkanResult = renderer->vkGetPhysicalDeviceImageFormatProperties(
+        renderer->physicalDevice,
+        vulkanFormat,
+        (type == REFRESH_TEXTURETYPE_3D) ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D,
+        VK_IMAGE_TILING_OPTIMAL,
+        vulkanUsage,
+        createFlags,
+        &properties);
 
-    default:
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognized swapchain format!");
-        return 0;
-    }
+    return vulkanResult == VK_SUCCESS;
 }
 
-static SDL_bool VULKAN_SetSwapchainParameters(
-    Refresh_Renderer *driverData,
-    SDL_Window *window,
-    Refresh_SwapchainComposition swapchainComposition,
-    Refresh_PresentMode presentMode)
-{
-    WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(window);
-
-    if (windowData == NULL) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot set swapchain parameters on unclaimed window!");
-        return SDL_FALSE;
-    }
+/* Bindless Resources */
 
-    if (!VULKAN_SupportsSwapchainComposition(driverData, window, swapchainComposition)) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Swapchain composition not supported!");
-        return SDL_FALSE;
-    }
+/* The regular per-stage bindings count against the same limits, so leave room for them */
+static Uint32 VULKAN_INTERNAL_GetBindlessCapacity(
+    Uint32 desiredCount,
+    Uint32 maxPerStage,
+    Uint32 maxPerSet,
+    Uint32 reservedPerStage)
+{
+    Uint32 capacity = desiredCount;
 
-    if (!VULKAN_SupportsPresentMode(driverData, window, presentMode)) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Present mode not supported!");
-        return SDL_FALSE;
-    }
+    capacity = SDL_min(capacity, maxPerStage > reservedPerStage ? maxPerStage - reservedPerStage : 0);
+    capacity = SDL_min(capacity, maxPerSet > reservedPerStage * 2 ? maxPerSet - reservedPerStage * 2 : 0);
 
-    return VULKAN_INTERNAL_RecreateSwapchain(
-        (VulkanRenderer *)driverData,
-        windowData);
+    return capacity;
 }
 
-/* Submission structure */
-
-static VulkanFenceHandle *VULKAN_INTERNAL_AcquireFenceFromPool(
+static SDL_bool VULKAN_INTERNAL_InitializeBindlessDescriptorSet(
     VulkanRenderer *renderer)
 {
-    VulkanFenceHandle *handle;
-    VkFenceCreateInfo fenceCreateInfo;
-    VkFence fence;
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT *limits = &renderer->physicalDeviceDescriptorIndexingProperties;
+    VkDescriptorSetLayoutBinding descriptorSetLayoutBindings[3];
+    VkDescriptorBindingFlagsEXT descriptorBindingFlags[3];
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCreateInfo;
+    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo;
+    VkDescriptorPoolSize descriptorPoolSizes[3];
+    VkDescriptorPoolCreateInfo descriptorPoolInfo;
+    VkDescriptorSetAllocateInfo descriptorSetAllocateInfo;
+    VulkanBindlessTable *table;
     VkResult vulkanResult;
+    Uint32 i;
 
-    if (renderer->fencePool.availableFenceCount == 0) {
-        /* Create fence */
-        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        fenceCreateInfo.pNext = NULL;
-        fenceCreateInfo.flags = 0;
+    renderer->bindlessTables[REFRESH_BINDLESSRESOURCETYPE_TEXTURE].maxCount = VULKAN_INTERNAL_GetBindlessCapacity(
+        MAX_BINDLESS_TEXTURES,
+        limits->maxPerStageDescriptorUpdateAfterBindSampledImages,
+        limits->maxDescriptorSetUpdateAfterBindSampledImages,
+        MAX_TEXTURE_SAMPLERS_PER_STAGE);
 
-        vulkanResult = renderer->vkCreateFence(
-            renderer->logicalDevice,
-            &fenceCreateInfo,
-            NULL,
-            &fence);
+    renderer->bindlessTables[REFRESH_BINDLESSRESOURCETYPE_SAMPLER].maxCount = VULKAN_INTERNAL_GetBindlessCapacity(
+        MAX_BINDLESS_SAMPLERS,
+        limits->maxPerStageDescriptorUpdateAfterBindSamplers,
+        limits->maxDescriptorSetUpdateAfterBindSamplers,
+        MAX_TEXTURE_SAMPLERS_PER_STAGE);
 
-        if (vulkanResult != VK_SUCCESS) {
-            LogVulkanResultAsError("vkCreateFence", vulkanResult);
-            return NULL;
+    renderer->bindlessTables[REFRESH_BINDLESSRESOURCETYPE_STORAGEBUFFER].maxCount = VULKAN_INTERNAL_GetBindlessCapacity(
+        MAX_BINDLESS_STORAGE_BUFFERS,
+        limits->maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+        limits->maxDescriptorSetUpdateAfterBindStorageBuffers,
+        MAX_STORAGE_BUFFERS_PER_STAGE);
+
+    descriptorSetLayoutBindings[REFRESH_BINDLESSRESOURCETYPE_TEXTURE].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    descriptorSetLayoutBindings[REFRESH_BINDLESSRESOURCETYPE_SAMPLER].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+    descriptorSetLayoutBindings[REFRESH_BINDLESSRESOURCETYPE_STORAGEBUFFER].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+
+    for (i = 0; i < 3; i += 1) {
+        if (renderer->bindlessTables[i].maxCount == 0) {
+            return SDL_FALSE;
         }
 
-        handle = SDL_malloc(sizeof(VulkanFenceHandle));
-        handle->fence = fence;
-        SDL_AtomicSet(&handle->referenceCount, 0);
-        return handle;
+        descriptorSetLayoutBindings[i].binding = i;
+        descriptorSetLayoutBindings[i].descriptorCount = renderer->bindlessTables[i].maxCount;
+        descriptorSetLayoutBindings[i].stageFlags =
+            VK_SHADER_STAGE_VERTEX_BIT |
+            VK_SHADER_STAGE_FRAGMENT_BIT |
+            VK_SHADER_STAGE_COMPUTE_BIT;
+        descriptorSetLayoutBindings[i].pImmutableSamplers = NULL;
+
+        /* Slots are written while command buffers using other slots are in flight */
+        descriptorBindingFlags[i] =
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+
+        descriptorPoolSizes[i].type = descriptorSetLayoutBindings[i].descriptorType;
+        descriptorPoolSizes[i].descriptorCount = renderer->bindlessTables[i].maxCount;
     }
 
-    SDL_LockMutex(renderer->fencePool.lock);
+    bindingFlagsCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    bindingFlagsCreateInfo.pNext = NULL;
+    bindingFlagsCreateInfo.bindingCount = 3;
+    bindingFlagsCreateInfo.pBindingFlags = descriptorBindingFlags;
 
-    handle = renderer->fencePool.availableFences[renderer->fencePool.availableFenceCount - 1];
-    renderer->fencePool.availableFenceCount -= 1;
+    descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    descriptorSetLayoutCreateInfo.pNext = &bindingFlagsCreateInfo;
+    descriptorSetLayoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    descriptorSetLayoutCreateInfo.bindingCount = 3;
+    descriptorSetLayoutCreateInfo.pBindings = descriptorSetLayoutBindings;
 
-    vulkanResult = renderer->vkResetFences(
+    vulkanResult = renderer->vkCreateDescriptorSetLayout(
         renderer->logicalDevice,
-        1,
-        &handle->fence);
+        &descriptorSetLayoutCreateInfo,
+        NULL,
+        &renderer->bindlessDescriptorSetLayout);
 
     if (vulkanResult != VK_SUCCESS) {
-        LogVulkanResultAsError("vkResetFences", vulkanResult);
+        LogVulkanResultAsError("vkCreateDescriptorSetLayout", vulkanResult);
+        return SDL_FALSE;
     }
 
-    SDL_UnlockMutex(renderer->fencePool.lock);
-
-    return handle;
-}
+    descriptorPoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolInfo.pNext = NULL;
+    descriptorPoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    descriptorPoolInfo.maxSets = 1;
+    descriptorPoolInfo.poolSizeCount = 3;
+    descriptorPoolInfo.pPoolSizes = descriptorPoolSizes;
 
-static void VULKAN_INTERNAL_PerformPendingDestroys(
-    VulkanRenderer *renderer)
-{
-    Sint32 i, sliceIndex;
-    Sint32 refCountTotal;
+    vulkanResult = renderer->vkCreateDescriptorPool(
+        renderer->logicalDevice,
+        &descriptorPoolInfo,
+        NULL,
+        &renderer->bindlessDescriptorPool);
 
-    SDL_LockMutex(renderer->disposeLock);
+    if (vulkanResult != VK_SUCCESS) {
+        renderer->vkDestroyDescriptorSetLayout(
+            renderer->logicalDevice,
+            renderer->bindlessDescriptorSetLayout,
+            NULL);
+        LogVulkanResultAsError("vkCreateDescriptorPool", vulkanResult);
+        return SDL_FALSE;
+    }
 
-    for (i = renderer->texturesToDestroyCount - 1; i >= 0; i -= 1) {
-        refCountTotal = 0;
-        for (sliceIndex = 0; sliceIndex < renderer->texturesToDestroy[i]->sliceCount; sliceIndex += 1) {
-            refCountTotal += SDL_AtomicGet(&renderer->texturesToDestroy[i]->slices[sliceIndex].referenceCount);
-        }
+    descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    descriptorSetAllocateInfo.pNext = NULL;
+    descriptorSetAllocateInfo.descriptorPool = renderer->bindlessDescriptorPool;
+    descriptorSetAllocateInfo.descriptorSetCount = 1;
+    descriptorSetAllocateInfo.pSetLayouts = &renderer->bindlessDescriptorSetLayout;
 
-        if (refCountTotal == 0) {
-            VULKAN_INTERNAL_DestroyTexture(
-                renderer,
-                renderer->texturesToDestroy[i]);
+    vulkanResult = renderer->vkAllocateDescriptorSets(
+        renderer->logicalDevice,
+        &descriptorSetAllocateInfo,
+        &renderer->bindlessDescriptorSet);
 
-            renderer->texturesToDestroy[i] = renderer->texturesToDestroy[renderer->texturesToDestroyCount - 1];
-            renderer->texturesToDestroyCount -= 1;
-        }
+    if (vulkanResult != VK_SUCCESS) {
+        renderer->vkDestroyDescriptorPool(
+            renderer->logicalDevice,
+            renderer->bindlessDescriptorPool,
+            NULL);
+        renderer->vkDestroyDescriptorSetLayout(
+            renderer->logicalDevice,
+            renderer->bindlessDescriptorSetLayout,
+            NULL);
+        LogVulkanResultAsError("vkAllocateDescriptorSets", vulkanResult);
+        return SDL_FALSE;
     }
 
-    for (i = renderer->buffersToDestroyCount - 1; i >= 0; i -= 1) {
-        if (SDL_AtomicGet(&renderer->buffersToDestroy[i]->referenceCount) == 0) {
-            VULKAN_INTERNAL_DestroyBuffer(
-                renderer,
-                renderer->buffersToDestroy[i]);
+    for (i = 0; i < 3; i += 1) {
+        table = &renderer->bindlessTables[i];
 
-            renderer->buffersToDestroy[i] = renderer->buffersToDestroy[renderer->buffersToDestroyCount - 1];
-            renderer->buffersToDestroyCount -= 1;
-        }
+        table->resourceCapacity = 16;
+        table->resourceCount = 0;
+        table->resources = SDL_malloc(
+            table->resourceCapacity * sizeof(void *));
+
+        table->freeIndexCapacity = 16;
+        table->freeIndexCount = 0;
+        table->freeIndices = SDL_malloc(
+            table->freeIndexCapacity * sizeof(Uint32));
     }
 
-    for (i = renderer->graphicsPipelinesToDestroyCount - 1; i >= 0; i -= 1) {
-        if (SDL_AtomicGet(&renderer->graphicsPipelinesToDestroy[i]->referenceCount) == 0) {
-            VULKAN_INTERNAL_DestroyGraphicsPipeline(
-                renderer,
-                renderer->graphicsPipelinesToDestroy[i]);
+    return SDL_TRUE;
+}
 
-            renderer->graphicsPipelinesToDestroy[i] = renderer->graphicsPipelinesToDestroy[renderer->graphicsPipelinesToDestroyCount - 1];
-            renderer->graphicsPipelinesToDestroyCount -= 1;
-        }
+/* Must be called with the bindless lock held */
+static SDL_bool VULKAN_INTERNAL_AcquireBindlessIndex(
+    VulkanRenderer *renderer,
+    Refresh_BindlessResourceType resourceType,
+    void *resource,
+    Uint32 *pIndex)
+{
+    VulkanBindlessTable *table = &renderer->bindlessTables[resourceType];
+
+    if (table->freeIndexCount > 0) {
+        *pIndex = table->freeIndices[table->freeIndexCount - 1];
+        table->freeIndexCount -= 1;
+    } else if (table->resourceCount < table->maxCount) {
+        EXPAND_ARRAY_IF_NEEDED(
+            table->resources,
+            void *,
+            table->resourceCount + 1,
+            table->resourceCapacity,
+            table->resourceCapacity * 2);
+
+        *pIndex = table->resourceCount;
+        table->resourceCount += 1;
+    } else {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless table is full!");
+        return SDL_FALSE;
     }
 
-    for (i = renderer->computePipelinesToDestroyCount - 1; i >= 0; i -= 1) {
-        if (SDL_AtomicGet(&renderer->computePipelinesToDestroy[i]->referenceCount) == 0) {
-            VULKAN_INTERNAL_DestroyComputePipeline(
-                renderer,
-                renderer->computePipelinesToDestroy[i]);
+    table->resources[*pIndex] = resource;
+    return SDL_TRUE;
+}
 
-            renderer->computePipelinesToDestroy[i] = renderer->computePipelinesToDestroy[renderer->computePipelinesToDestroyCount - 1];
-            renderer->computePipelinesToDestroyCount -= 1;
-        }
-    }
+static void VULKAN_INTERNAL_FreeBindlessIndex(
+    VulkanRenderer *renderer,
+    Refresh_BindlessResourceType resourceType,
+    Uint32 index)
+{
+    VulkanBindlessTable *table = &renderer->bindlessTables[resourceType];
 
-    for (i = renderer->shadersToDestroyCount - 1; i >= 0; i -= 1) {
-        if (SDL_AtomicGet(&renderer->shadersToDestroy[i]->referenceCount) == 0) {
-            VULKAN_INTERNAL_DestroyShader(
-                renderer,
-                renderer->shadersToDestroy[i]);
+    SDL_LockMutex(renderer->bindlessLock);
 
-            renderer->shadersToDestroy[i] = renderer->shadersToDestroy[renderer->shadersToDestroyCount - 1];
-            renderer->shadersToDestroyCount -= 1;
+    /* The stale descriptor is left in place, partially bound arrays allow that */
+    if (index < table->resourceCount && table->resources[index] != NULL) {
+        switch (resourceType) {
+        case REFRESH_BINDLESSRESOURCETYPE_TEXTURE:
+            ((VulkanTexture *)table->resources[index])->bindlessIndex = BINDLESS_INVALID_INDEX;
+            break;
+        case REFRESH_BINDLESSRESOURCETYPE_SAMPLER:
+            ((VulkanSampler *)table->resources[index])->bindlessIndex = BINDLESS_INVALID_INDEX;
+            break;
+        case REFRESH_BINDLESSRESOURCETYPE_STORAGEBUFFER:
+            ((VulkanBuffer *)table->resources[index])->bindlessIndex = BINDLESS_INVALID_INDEX;
+            break;
         }
-    }
 
-    for (i = renderer->samplersToDestroyCount - 1; i >= 0; i -= 1) {
-        if (SDL_AtomicGet(&renderer->samplersToDestroy[i]->referenceCount) == 0) {
-            VULKAN_INTERNAL_DestroySampler(
-                renderer,
-                renderer->samplersToDestroy[i]);
+        table->resources[index] = NULL;
 
-            renderer->samplersToDestroy[i] = renderer->samplersToDestroy[renderer->samplersToDestroyCount - 1];
-            renderer->samplersToDestroyCount -= 1;
-        }
+        EXPAND_ARRAY_IF_NEEDED(
+            table->freeIndices,
+            Uint32,
+            table->freeIndexCount + 1,
+            table->freeIndexCapacity,
+            table->freeIndexCapacity * 2);
+
+        table->freeIndices[table->freeIndexCount] = index;
+        table->freeIndexCount += 1;
     }
 
-    for (i = renderer->framebuffersToDestroyCount - 1; i >= 0; i -= 1) {
-        if (SDL_AtomicGet(&renderer->framebuffersToDestroy[i]->referenceCount) == 0) {
-            VULKAN_INTERNAL_DestroyFramebuffer(
-                renderer,
-                renderer->framebuffersToDestroy[i]);
+    SDL_UnlockMutex(renderer->bindlessLock);
+}
 
-            renderer->framebuffersToDestroy[i] = renderer->framebuffersToDestroy[renderer->framebuffersToDestroyCount - 1];
-            renderer->framebuffersToDestroyCount -= 1;
-        }
+/* Must be called with the bindless lock held */
+static void VULKAN_INTERNAL_WriteBindlessDescriptor(
+    VulkanRenderer *renderer,
+    Refresh_BindlessResourceType resourceType,
+    Uint32 index,
+    VkDescriptorImageInfo *imageInfo,
+    VkDescriptorBufferInfo *bufferInfo)
+{
+    VkWriteDescriptorSet writeDescriptorSet;
+
+    writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeDescriptorSet.pNext = NULL;
+    writeDescriptorSet.dstSet = renderer->bindlessDescriptorSet;
+    writeDescriptorSet.dstBinding = resourceType;
+    writeDescriptorSet.dstArrayElement = index;
+    writeDescriptorSet.descriptorCount = 1;
+    writeDescriptorSet.pImageInfo = imageInfo;
+    writeDescriptorSet.pBufferInfo = bufferInfo;
+    writeDescriptorSet.pTexelBufferView = NULL;
+
+    switch (resourceType) {
+    case REFRESH_BINDLESSRESOURCETYPE_TEXTURE:
+        writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        break;
+    case REFRESH_BINDLESSRESOURCETYPE_SAMPLER:
+        writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+        break;
+    case REFRESH_BINDLESSRESOURCETYPE_STORAGEBUFFER:
+        writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        break;
+    }
+
+    renderer->vkUpdateDescriptorSets(
+        renderer->logicalDevice,
+        1,
+        &writeDescriptorSet,
+        0,
+        NULL);
+}
+
+static SDL_bool VULKAN_SupportsBindless(
+    Refresh_Renderer *driverData)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    return renderer->supportsBindless;
+}
+
+static SDL_bool VULKAN_RegisterBindlessTexture(
+    Refresh_Renderer *driverData,
+    Refresh_Texture *texture,
+    Uint32 *pIndex)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    /* The descriptor only stays valid because PrepareTextureSliceForWrite
+     * refuses to cycle a registered texture, so this one stays active.
+     */
+    VulkanTexture *vulkanTexture = ((VulkanTextureContainer *)texture)->activeTextureHandle->vulkanTexture;
+    VkDescriptorImageInfo imageInfo;
+
+    if (!renderer->supportsBindless) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless resources are not supported on this device!");
+        return SDL_FALSE;
     }
 
-    SDL_UnlockMutex(renderer->disposeLock);
-}
+    if (!(vulkanTexture->usageFlags & REFRESH_TEXTUREUSAGE_SAMPLER_BIT)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless textures must have the sampler usage bit!");
+        return SDL_FALSE;
+    }
 
-static void VULKAN_INTERNAL_CleanCommandBuffer(
-    VulkanRenderer *renderer,
-    VulkanCommandBuffer *commandBuffer)
-{
-    Uint32 i;
-    DescriptorSetData *descriptorSetData;
+    SDL_LockMutex(renderer->bindlessLock);
 
-    if (commandBuffer->autoReleaseFence) {
-        VULKAN_ReleaseFence(
-            (Refresh_Renderer *)renderer,
-            (Refresh_Fence *)commandBuffer->inFlightFence);
+    if (vulkanTexture->bindlessIndex != BINDLESS_INVALID_INDEX) {
+        *pIndex = vulkanTexture->bindlessIndex;
+        SDL_UnlockMutex(renderer->bindlessLock);
+        return SDL_TRUE;
+    }
 
-        commandBuffer->inFlightFence = NULL;
+    if (!VULKAN_INTERNAL_AcquireBindlessIndex(
+            renderer,
+            REFRESH_BINDLESSRESOURCETYPE_TEXTURE,
+            vulkanTexture,
+            pIndex)) {
+        SDL_UnlockMutex(renderer->bindlessLock);
+        return SDL_FALSE;
     }
 
-    /* Bound descriptor sets are now available */
+    imageInfo.sampler = VK_NULL_HANDLE;
+    imageInfo.imageView = vulkanTexture->view;
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-    for (i = 0; i < commandBuffer->boundDescriptorSetDataCount; i += 1) {
-        descriptorSetData = &commandBuffer->boundDescriptorSetDatas[i];
+    VULKAN_INTERNAL_WriteBindlessDescriptor(
+        renderer,
+        REFRESH_BINDLESSRESOURCETYPE_TEXTURE,
+        *pIndex,
+        &imageInfo,
+        NULL);
 
-        SDL_LockMutex(descriptorSetData->descriptorSetPool->lock);
+    vulkanTexture->bindlessIndex = *pIndex;
 
-        if (descriptorSetData->descriptorSetPool->inactiveDescriptorSetCount == descriptorSetData->descriptorSetPool->inactiveDescriptorSetCapacity) {
-            descriptorSetData->descriptorSetPool->inactiveDescriptorSetCapacity *= 2;
-            descriptorSetData->descriptorSetPool->inactiveDescriptorSets = SDL_realloc(
-                descriptorSetData->descriptorSetPool->inactiveDescriptorSets,
-                descriptorSetData->descriptorSetPool->inactiveDescriptorSetCapacity * sizeof(VkDescriptorSet));
-        }
+    SDL_UnlockMutex(renderer->bindlessLock);
 
-        descriptorSetData->descriptorSetPool->inactiveDescriptorSets[descriptorSetData->descriptorSetPool->inactiveDescriptorSetCount] = descriptorSetData->descriptorSet;
-        descriptorSetData->descriptorSetPool->inactiveDescriptorSetCount += 1;
+    return SDL_TRUE;
+}
 
-        SDL_UnlockMutex(descriptorSetData->descriptorSetPool->lock);
-    }
+static SDL_bool VULKAN_RegisterBindlessSampler(
+    Refresh_Renderer *driverData,
+    Refresh_Sampler *sampler,
+    Uint32 *pIndex)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanSampler *vulkanSampler = (VulkanSampler *)sampler;
+    VkDescriptorImageInfo imageInfo;
 
-    commandBuffer->boundDescriptorSetDataCount = 0;
+    if (!renderer->supportsBindless) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless resources are not supported on this device!");
+        return SDL_FALSE;
+    }
 
-    /* Uniform buffers are now available */
+    SDL_LockMutex(renderer->bindlessLock);
 
-    SDL_LockMutex(renderer->acquireUniformBufferLock);
+    if (vulkanSampler->bindlessIndex != BINDLESS_INVALID_INDEX) {
+        *pIndex = vulkanSampler->bindlessIndex;
+        SDL_UnlockMutex(renderer->bindlessLock);
+        return SDL_TRUE;
+    }
 
-    for (i = 0; i < commandBuffer->usedUniformBufferCount; i += 1) {
-        VULKAN_INTERNAL_ReturnUniformBufferToPool(
+    if (!VULKAN_INTERNAL_AcquireBindlessIndex(
             renderer,
-            commandBuffer->usedUniformBuffers[i]);
+            REFRESH_BINDLESSRESOURCETYPE_SAMPLER,
+            vulkanSampler,
+            pIndex)) {
+        SDL_UnlockMutex(renderer->bindlessLock);
+        return SDL_FALSE;
     }
-    commandBuffer->usedUniformBufferCount = 0;
 
-    SDL_UnlockMutex(renderer->acquireUniformBufferLock);
+    imageInfo.sampler = vulkanSampler->sampler;
+    imageInfo.imageView = VK_NULL_HANDLE;
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
-    /* Decrement reference counts */
+    VULKAN_INTERNAL_WriteBindlessDescriptor(
+        renderer,
+        REFRESH_BINDLESSRESOURCETYPE_SAMPLER,
+        *pIndex,
+        &imageInfo,
+        NULL);
 
-    for (i = 0; i < commandBuffer->usedBufferCount; i += 1) {
-        (void)SDL_AtomicDecRef(&commandBuffer->usedBuffers[i]->referenceCount);
-    }
-    commandBuffer->usedBufferCount = 0;
+    vulkanSampler->bindlessIndex = *pIndex;
 
-    for (i = 0; i < commandBuffer->usedTextureSliceCount; i += 1) {
-        (void)SDL_AtomicDecRef(&commandBuffer->usedTextureSlices[i]->referenceCount);
-    }
-    commandBuffer->usedTextureSliceCount = 0;
+    SDL_UnlockMutex(renderer->bindlessLock);
 
-    for (i = 0; i < commandBuffer->usedSamplerCount; i += 1) {
-        (void)SDL_AtomicDecRef(&commandBuffer->usedSamplers[i]->referenceCount);
-    }
-    commandBuffer->usedSamplerCount = 0;
+    return SDL_TRUE;
+}
 
-    for (i = 0; i < commandBuffer->usedGraphicsPipelineCount; i += 1) {
-        (void)SDL_AtomicDecRef(&commandBuffer->usedGraphicsPipelines[i]->referenceCount);
-    }
-    commandBuffer->usedGraphicsPipelineCount = 0;
+static SDL_bool VULKAN_RegisterBindlessStorageBuffer(
+    Refresh_Renderer *driverData,
+    Refresh_Buffer *buffer,
+    Uint32 *pIndex)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    /* As with textures, PrepareBufferForWrite refuses to cycle a registered buffer */
+    VulkanBuffer *vulkanBuffer = ((VulkanBufferContainer *)buffer)->activeBufferHandle->vulkanBuffer;
+    VkDescriptorBufferInfo bufferInfo;
 
-    for (i = 0; i < commandBuffer->usedComputePipelineCount; i += 1) {
-        (void)SDL_AtomicDecRef(&commandBuffer->usedComputePipelines[i]->referenceCount);
+    if (!renderer->supportsBindless) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless resources are not supported on this device!");
+        return SDL_FALSE;
     }
-    commandBuffer->usedComputePipelineCount = 0;
 
-    for (i = 0; i < commandBuffer->usedFramebufferCount; i += 1) {
-        (void)SDL_AtomicDecRef(&commandBuffer->usedFramebuffers[i]->referenceCount);
+    if (!(vulkanBuffer->usageFlags & (REFRESH_BUFFERUSAGE_GRAPHICS_STORAGE_READ_BIT |
+                                      REFRESH_BUFFERUSAGE_COMPUTE_STORAGE_READ_BIT |
+                                      REFRESH_BUFFERUSAGE_COMPUTE_STORAGE_WRITE_BIT))) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless storage buffers must have a storage usage bit!");
+        return SDL_FALSE;
     }
-    commandBuffer->usedFramebufferCount = 0;
-
-    /* Reset presentation data */
-
-    commandBuffer->presentDataCount = 0;
-    commandBuffer->waitSemaphoreCount = 0;
-    commandBuffer->signalSemaphoreCount = 0;
 
-    /* Reset defrag state */
+    SDL_LockMutex(renderer->bindlessLock);
 
-    if (commandBuffer->isDefrag) {
-        renderer->defragInProgress = 0;
+    if (vulkanBuffer->bindlessIndex != BINDLESS_INVALID_INDEX) {
+        *pIndex = vulkanBuffer->bindlessIndex;
+        SDL_UnlockMutex(renderer->bindlessLock);
+        return SDL_TRUE;
     }
 
-    /* Return command buffer to pool */
+    if (!VULKAN_INTERNAL_AcquireBindlessIndex(
+            renderer,
+            REFRESH_BINDLESSRESOURCETYPE_STORAGEBUFFER,
+            vulkanBuffer,
+            pIndex)) {
+        SDL_UnlockMutex(renderer->bindlessLock);
+        return SDL_FALSE;
+    }
 
-    SDL_LockMutex(renderer->acquireCommandBufferLock);
+    bufferInfo.buffer = vulkanBuffer->buffer;
+    bufferInfo.offset = 0;
+    bufferInfo.range = VK_WHOLE_SIZE;
 
-    if (commandBuffer->commandPool->inactiveCommandBufferCount == commandBuffer->commandPool->inactiveCommandBufferCapacity) {
-        commandBuffer->commandPool->inactiveCommandBufferCapacity += 1;
-        commandBuffer->commandPool->inactiveCommandBuffers = SDL_realloc(
-            commandBuffer->commandPool->inactiveCommandBuffers,
-            commandBuffer->commandPool->inactiveCommandBufferCapacity * sizeof(VulkanCommandBuffer *));
-    }
+    VULKAN_INTERNAL_WriteBindlessDescriptor(
+        renderer,
+        REFRESH_BINDLESSRESOURCETYPE_STORAGEBUFFER,
+        *pIndex,
+        NULL,
+        &bufferInfo);
 
-    commandBuffer->commandPool->inactiveCommandBuffers[commandBuffer->commandPool->inactiveCommandBufferCount] = commandBuffer;
-    commandBuffer->commandPool->inactiveCommandBufferCount += 1;
+    vulkanBuffer->bindlessIndex = *pIndex;
 
-    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+    SDL_UnlockMutex(renderer->bindlessLock);
 
-    /* Remove this command buffer from the submitted list */
-    for (i = 0; i < renderer->submittedCommandBufferCount; i += 1) {
-        if (renderer->submittedCommandBuffers[i] == commandBuffer) {
-            renderer->submittedCommandBuffers[i] = renderer->submittedCommandBuffers[renderer->submittedCommandBufferCount - 1];
-            renderer->submittedCommandBufferCount -= 1;
-        }
-    }
+    return SDL_TRUE;
 }
 
-static void VULKAN_WaitForFences(
+static void VULKAN_UnregisterBindlessResource(
     Refresh_Renderer *driverData,
-    SDL_bool waitAll,
-    Refresh_Fence **pFences,
-    Uint32 fenceCount)
+    Refresh_BindlessResourceType resourceType,
+    Uint32 index)
 {
     VulkanRenderer *renderer = (VulkanRenderer *)driverData;
-    VkFence *fences = SDL_stack_alloc(VkFence, fenceCount);
-    VkResult result;
-    Sint32 i;
 
-    for (i = 0; i < fenceCount; i += 1) {
-        fences[i] = ((VulkanFenceHandle *)pFences[i])->fence;
+    if (!renderer->supportsBindless) {
+        return;
     }
 
-    result = renderer->vkWaitForFences(
-        renderer->logicalDevice,
-        fenceCount,
-        fences,
-        waitAll,
-        UINT64_MAX);
+    VULKAN_INTERNAL_FreeBindlessIndex(
+        renderer,
+        resourceType,
+        index);
+}
 
-    if (result != VK_SUCCESS) {
-        LogVulkanResultAsError("vkWaitForFences", result);
+/* Timestamp Queries */
+
+static Refresh_QueryPool *VULKAN_CreateTimestampQueryPool(
+    Refresh_Renderer *driverData,
+    Uint32 queryCount)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VkQueryPoolCreateInfo queryPoolCreateInfo;
+    VulkanQueryPool *vulkanQueryPool;
+    VkResult vulkanResult;
+
+    if (renderer->queues[REFRESH_QUEUETYPE_GRAPHICS].timestampValidBits == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timestamp queries are not supported on this device!");
+        return NULL;
     }
 
-    SDL_stack_free(fences);
+    queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolCreateInfo.pNext = NULL;
+    queryPoolCreateInfo.flags = 0;
+    queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolCreateInfo.queryCount = queryCount;
+    queryPoolCreateInfo.pipelineStatistics = 0;
 
-    SDL_LockMutex(renderer->submitLock);
+    vulkanQueryPool = SDL_malloc(sizeof(VulkanQueryPool));
 
-    for (i = renderer->submittedCommandBufferCount - 1; i >= 0; i -= 1) {
-        result = renderer->vkGetFenceStatus(
-            renderer->logicalDevice,
-            renderer->submittedCommandBuffers[i]->inFlightFence->fence);
+    vulkanResult = renderer->vkCreateQueryPool(
+        renderer->logicalDevice,
+        &queryPoolCreateInfo,
+        NULL,
+        &vulkanQueryPool->queryPool);
 
-        if (result == VK_SUCCESS) {
-            VULKAN_INTERNAL_CleanCommandBuffer(
-                renderer,
-                renderer->submittedCommandBuffers[i]);
-        }
+    if (vulkanResult != VK_SUCCESS) {
+        SDL_free(vulkanQueryPool);
+        LogVulkanResultAsError("vkCreateQueryPool", vulkanResult);
+        return NULL;
     }
 
-    VULKAN_INTERNAL_PerformPendingDestroys(renderer);
+    vulkanQueryPool->queryCount = queryCount;
+    vulkanQueryPool->validBits = SDL_malloc(queryCount * sizeof(Uint8));
+    SDL_memset(vulkanQueryPool->validBits, 64, queryCount * sizeof(Uint8));
+    SDL_AtomicSet(&vulkanQueryPool->referenceCount, 0);
 
-    SDL_UnlockMutex(renderer->submitLock);
+    return (Refresh_QueryPool *)vulkanQueryPool;
 }
 
-static void VULKAN_Wait(
-    Refresh_Renderer *driverData)
+static void VULKAN_ReleaseQueryPool(
+    Refresh_Renderer *driverData,
+    Refresh_QueryPool *queryPool)
 {
     VulkanRenderer *renderer = (VulkanRenderer *)driverData;
-    VulkanCommandBuffer *commandBuffer;
-    VkResult result;
-    Sint32 i;
-
-    result = renderer->vkDeviceWaitIdle(renderer->logicalDevice);
-
-    if (result != VK_SUCCESS) {
-        LogVulkanResultAsError("vkDeviceWaitIdle", result);
-        return;
-    }
-
-    SDL_LockMutex(renderer->submitLock);
+    VulkanQueryPool *vulkanQueryPool = (VulkanQueryPool *)queryPool;
 
-    for (i = renderer->submittedCommandBufferCount - 1; i >= 0; i -= 1) {
-        commandBuffer = renderer->submittedCommandBuffers[i];
-        VULKAN_INTERNAL_CleanCommandBuffer(renderer, commandBuffer);
-    }
+    SDL_LockMutex(renderer->disposeLock);
 
-    VULKAN_INTERNAL_PerformPendingDestroys(renderer);
+    VULKAN_INTERNAL_QueueDeferredDestroy(
+        renderer,
+        VULKAN_DEFERRED_DESTROY_QUERY_POOL,
+        vulkanQueryPool);
 
-    SDL_UnlockMutex(renderer->submitLock);
+    SDL_UnlockMutex(renderer->disposeLock);
 }
 
-static Refresh_Fence *VULKAN_SubmitAndAcquireFence(
-    Refresh_CommandBuffer *commandBuffer)
+static void VULKAN_ResetQueryPool(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_QueryPool *queryPool)
 {
-    VulkanCommandBuffer *vulkanCommandBuffer;
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
+    VulkanQueryPool *vulkanQueryPool = (VulkanQueryPool *)queryPool;
 
-    vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
-    vulkanCommandBuffer->autoReleaseFence = 0;
+    VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
 
-    VULKAN_Submit(commandBuffer);
+    renderer->vkCmdResetQueryPool(
+        vulkanCommandBuffer->commandBuffer,
+        vulkanQueryPool->queryPool,
+        0,
+        vulkanQueryPool->queryCount);
 
-    return (Refresh_Fence *)vulkanCommandBuffer->inFlightFence;
+    VULKAN_INTERNAL_TrackQueryPool(vulkanCommandBuffer, vulkanQueryPool);
 }
 
-static void VULKAN_Submit(
-    Refresh_CommandBuffer *commandBuffer)
+static void VULKAN_WriteTimestamp(
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_QueryPool *queryPool,
+    Uint32 queryIndex)
 {
     VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
     VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
-    VkSubmitInfo submitInfo;
-    VkPresentInfoKHR presentInfo;
-    VulkanPresentData *presentData;
-    VkResult vulkanResult, presentResult = VK_SUCCESS;
-    VkPipelineStageFlags waitStages[MAX_PRESENT_COUNT];
-    Uint32 swapchainImageIndex;
-    VulkanTextureSlice *swapchainTextureSlice;
-    Uint8 commandBufferCleaned = 0;
-    VulkanMemorySubAllocator *allocator;
-    SDL_bool presenting = SDL_FALSE;
-    Sint32 i, j;
-
-    SDL_LockMutex(renderer->submitLock);
+    VulkanQueryPool *vulkanQueryPool = (VulkanQueryPool *)queryPool;
 
-    /* FIXME: Can this just be permanent? */
-    for (i = 0; i < MAX_PRESENT_COUNT; i += 1) {
-        waitStages[i] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    }
-
-    for (j = 0; j < vulkanCommandBuffer->presentDataCount; j += 1) {
-        swapchainImageIndex = vulkanCommandBuffer->presentDatas[j].swapchainImageIndex;
-        swapchainTextureSlice = VULKAN_INTERNAL_FetchTextureSlice(
-            vulkanCommandBuffer->presentDatas[j].windowData->swapchainData->textureContainers[swapchainImageIndex].activeTextureHandle->vulkanTexture,
-            0,
-            0);
-
-        VULKAN_INTERNAL_TextureTransitionFromDefaultUsage(
-            renderer,
-            vulkanCommandBuffer,
-            VULKAN_TEXTURE_USAGE_MODE_PRESENT,
-            swapchainTextureSlice);
-    }
-
-    VULKAN_INTERNAL_EndCommandBuffer(renderer, vulkanCommandBuffer);
-
-    vulkanCommandBuffer->inFlightFence = VULKAN_INTERNAL_AcquireFenceFromPool(renderer);
-
-    /* Command buffer has a reference to the in-flight fence */
-    (void)SDL_AtomicIncRef(&vulkanCommandBuffer->inFlightFence->referenceCount);
-
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.pNext = NULL;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &vulkanCommandBuffer->commandBuffer;
-
-    submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.pWaitSemaphores = vulkanCommandBuffer->waitSemaphores;
-    submitInfo.waitSemaphoreCount = vulkanCommandBuffer->waitSemaphoreCount;
-    submitInfo.pSignalSemaphores = vulkanCommandBuffer->signalSemaphores;
-    submitInfo.signalSemaphoreCount = vulkanCommandBuffer->signalSemaphoreCount;
-
-    vulkanResult = renderer->vkQueueSubmit(
-        renderer->unifiedQueue,
-        1,
-        &submitInfo,
-        vulkanCommandBuffer->inFlightFence->fence);
-
-    if (vulkanResult != VK_SUCCESS) {
-        LogVulkanResultAsError("vkQueueSubmit", vulkanResult);
+    if (queryIndex >= vulkanQueryPool->queryCount) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timestamp query index out of range!");
+        return;
     }
 
-    /* Mark command buffers as submitted */
-
-    if (renderer->submittedCommandBufferCount + 1 >= renderer->submittedCommandBufferCapacity) {
-        renderer->submittedCommandBufferCapacity = renderer->submittedCommandBufferCount + 1;
-
-        renderer->submittedCommandBuffers = SDL_realloc(
-            renderer->submittedCommandBuffers,
-            sizeof(VulkanCommandBuffer *) * renderer->submittedCommandBufferCapacity);
+    if (vulkanCommandBuffer->commandPool->queue->timestampValidBits == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timestamp queries are not supported on this queue!");
+        return;
     }
 
-    renderer->submittedCommandBuffers[renderer->submittedCommandBufferCount] = vulkanCommandBuffer;
-    renderer->submittedCommandBufferCount += 1;
-
-    /* Present, if applicable */
+    /* Bottom of pipe means the timestamp is taken once all prior work has drained */
+    VULKAN_INTERNAL_FlushBarriers(renderer, vulkanCommandBuffer);
 
-    for (j = 0; j < vulkanCommandBuffer->presentDataCount; j += 1) {
-        presenting = SDL_TRUE;
+    renderer->vkCmdWriteTimestamp(
+        vulkanCommandBuffer->commandBuffer,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        vulkanQueryPool->queryPool,
+        queryIndex);
 
-        presentData = &vulkanCommandBuffer->presentDatas[j];
+    vulkanQueryPool->validBits[queryIndex] = (Uint8)vulkanCommandBuffer->commandPool->queue->timestampValidBits;
 
-        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        presentInfo.pNext = NULL;
-        presentInfo.pWaitSemaphores =
-            &presentData->windowData->swapchainData->renderFinishedSemaphore[presentData->windowData->swapchainData->frameCounter];
-        presentInfo.waitSemaphoreCount = 1;
-        presentInfo.pSwapchains = &presentData->windowData->swapchainData->swapchain;
-        presentInfo.swapchainCount = 1;
-        presentInfo.pImageIndices = &presentData->swapchainImageIndex;
-        presentInfo.pResults = NULL;
+    VULKAN_INTERNAL_TrackQueryPool(vulkanCommandBuffer, vulkanQueryPool);
+}
 
-        presentResult = renderer->vkQueuePresentKHR(
-            renderer->unifiedQueue,
-            &presentInfo);
+static SDL_bool VULKAN_GetTimestampResults(
+    Refresh_Renderer *driverData,
+    Refresh_QueryPool *queryPool,
+    Uint32 firstQuery,
+    Uint32 queryCount,
+    Uint64 *results)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanQueryPool *vulkanQueryPool = (VulkanQueryPool *)queryPool;
+    double timestampPeriod = renderer->physicalDeviceProperties.properties.limits.timestampPeriod;
+    VkResult vulkanResult;
+    Uint32 validBits;
+    Uint32 i;
 
-        presentData->windowData->swapchainData->frameCounter =
-            (presentData->windowData->swapchainData->frameCounter + 1) % MAX_FRAMES_IN_FLIGHT;
+    if (firstQuery > vulkanQueryPool->queryCount ||
+        queryCount > vulkanQueryPool->queryCount - firstQuery) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timestamp query range out of bounds!");
+        return SDL_FALSE;
+    }
 
-        if (presentResult != VK_SUCCESS) {
-            VULKAN_INTERNAL_RecreateSwapchain(
-                renderer,
-                presentData->windowData);
-        } else {
-            /* If presenting, the swapchain is using the in-flight fence */
-            presentData->windowData->swapchainData->inFlightFences[presentData->windowData->swapchainData->frameCounter] = vulkanCommandBuffer->inFlightFence;
+    if (queryCount == 0) {
+        return SDL_TRUE;
+    }
 
-            (void)SDL_AtomicIncRef(&vulkanCommandBuffer->inFlightFence->referenceCount);
+    /* No wait flag, so this returns VK_NOT_READY instead of stalling */
+    vulkanResult = renderer->vkGetQueryPoolResults(
+        renderer->logicalDevice,
+        vulkanQueryPool->queryPool,
+        firstQuery,
+        queryCount,
+        sizeof(Uint64) * queryCount,
+        results,
+        sizeof(Uint64),
+        VK_QUERY_RESULT_64_BIT);
+
+    if (vulkanResult == VK_NOT_READY) {
+        return SDL_FALSE;
+    } else if (vulkanResult != VK_SUCCESS) {
+        LogVulkanResultAsError("vkGetQueryPoolResults", vulkanResult);
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < queryCount; i += 1) {
+        /* Bits above timestampValidBits are undefined */
+        validBits = vulkanQueryPool->validBits[firstQuery + i];
+        if (validBits < 64) {
+            results[i] &= (1ULL << validBits) - 1;
         }
+        results[i] = (Uint64)((double)results[i] * timestampPeriod);
     }
 
-    /* Check if we can perform any cleanups */
+    return SDL_TRUE;
+}
 
-    for (i = renderer->submittedCommandBufferCount - 1; i >= 0; i -= 1) {
-        vulkanResult = renderer->vkGetFenceStatus(
-            renderer->logicalDevice,
-            renderer->submittedCommandBuffers[i]->inFlightFence->fence);
+/* Pipeline Cache */
 
-        if (vulkanResult == VK_SUCCESS) {
-            VULKAN_INTERNAL_CleanCommandBuffer(
-                renderer,
-                renderer->submittedCommandBuffers[i]);
+static SDL_bool VULKAN_LoadPipelineCacheData(
+    Refresh_Renderer *driverData,
+    const void *data,
+    size_t dataSize)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VkPhysicalDeviceProperties *properties = &renderer->physicalDeviceProperties.properties;
+    VkPipelineCacheHeaderVersionOne header;
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo;
+    VkPipelineCache loadedCache;
+    VkResult vulkanResult;
 
-            commandBufferCleaned = 1;
-        }
+    if (renderer->pipelineCache == VK_NULL_HANDLE) {
+        return SDL_FALSE;
     }
 
-    if (commandBufferCleaned) {
-        SDL_LockMutex(renderer->allocatorLock);
+    if (dataSize < sizeof(VkPipelineCacheHeaderVersionOne)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache data is too small, ignoring!");
+        return SDL_FALSE;
+    }
 
-        for (i = 0; i < VK_MAX_MEMORY_TYPES; i += 1) {
-            allocator = &renderer->memoryAllocator->subAllocators[i];
+    /* The blob may be unaligned, so copy the header out before inspecting it */
+    SDL_memcpy(&header, data, sizeof(header));
 
-            for (j = allocator->allocationCount - 1; j >= 0; j -= 1) {
-                if (allocator->allocations[j]->usedRegionCount == 0) {
-                    VULKAN_INTERNAL_DeallocateMemory(
-                        renderer,
-                        allocator,
-                        j);
-                }
-            }
-        }
+    if (
+        header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+        header.headerSize < sizeof(VkPipelineCacheHeaderVersionOne) ||
+        header.vendorID != properties->vendorID ||
+        header.deviceID != properties->deviceID ||
+        SDL_memcmp(header.pipelineCacheUUID, properties->pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache data does not match this device, ignoring!");
+        return SDL_FALSE;
+    }
 
-        SDL_UnlockMutex(renderer->allocatorLock);
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.pNext = NULL;
+    pipelineCacheCreateInfo.flags = 0;
+    pipelineCacheCreateInfo.initialDataSize = dataSize;
+    pipelineCacheCreateInfo.pInitialData = data;
+
+    vulkanResult = renderer->vkCreatePipelineCache(
+        renderer->logicalDevice,
+        &pipelineCacheCreateInfo,
+        NULL,
+        &loadedCache);
+
+    if (vulkanResult != VK_SUCCESS) {
+        LogVulkanResultAsError("vkCreatePipelineCache", vulkanResult);
+        return SDL_FALSE;
     }
 
-    /* Check pending destroys */
-    VULKAN_INTERNAL_PerformPendingDestroys(renderer);
+    vulkanResult = renderer->vkMergePipelineCaches(
+        renderer->logicalDevice,
+        renderer->pipelineCache,
+        1,
+        &loadedCache);
 
-    /* Defrag! */
-    if (
-        presenting &&
-        renderer->allocationsToDefragCount > 0 &&
-        !renderer->defragInProgress) {
-        VULKAN_INTERNAL_DefragmentMemory(renderer);
+    renderer->vkDestroyPipelineCache(
+        renderer->logicalDevice,
+        loadedCache,
+        NULL);
+
+    if (vulkanResult != VK_SUCCESS) {
+        LogVulkanResultAsError("vkMergePipelineCaches", vulkanResult);
+        return SDL_FALSE;
     }
 
-    SDL_UnlockMutex(renderer->submitLock);
+    return SDL_TRUE;
 }
 
-static Uint8 VULKAN_INTERNAL_DefragmentMemory(
-    VulkanRenderer *renderer)
+static SDL_bool VULKAN_GetPipelineCacheData(
+    Refresh_Renderer *driverData,
+    void *data,
+    size_t *pDataSize)
 {
-    VulkanMemoryAllocation *allocation;
-    VulkanMemoryUsedRegion *currentRegion;
-    VulkanBuffer *newBuffer;
-    VulkanTexture *newTexture;
-    VkBufferCopy bufferCopy;
-    VkImageCopy imageCopy;
-    VulkanCommandBuffer *commandBuffer;
-    VulkanTextureSlice *srcSlice;
-    VulkanTextureSlice *dstSlice;
-    Uint32 i, sliceIndex;
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VkResult vulkanResult;
 
-    SDL_LockMutex(renderer->allocatorLock);
+    if (renderer->pipelineCache == VK_NULL_HANDLE) {
+        *pDataSize = 0;
+        return SDL_FALSE;
+    }
 
-    renderer->defragInProgress = 1;
+    vulkanResult = renderer->vkGetPipelineCacheData(
+        renderer->logicalDevice,
+        renderer->pipelineCache,
+        pDataSize,
+        data);
 
-    commandBuffer = (VulkanCommandBuffer *)VULKAN_AcquireCommandBuffer((Refresh_Renderer *)renderer);
-    if (commandBuffer == NULL) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create defrag command buffer!");
-        return 0;
+    if (vulkanResult == VK_INCOMPLETE) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache data buffer is too small!");
+        return SDL_FALSE;
+    } else if (vulkanResult != VK_SUCCESS) {
+        LogVulkanResultAsError("vkGetPipelineCacheData", vulkanResult);
+        return SDL_FALSE;
     }
-    commandBuffer->isDefrag = 1;
 
-    allocation = renderer->allocationsToDefrag[renderer->allocationsToDefragCount - 1];
-    renderer->allocationsToDefragCount -= 1;
+    return SDL_TRUE;
+}
 
-    /* For each used region in the allocation
-     * create a new resource, copy the data
-     * and re-point the resource containers
-     */
-    for (i = 0; i < allocation->usedRegionCount; i += 1) {
-        currentRegion = allocation->usedRegions[i];
+/* Shader Cache */
 
-        if (currentRegion->isBuffer && !currentRegion->vulkanBuffer->markedForDestroy) {
-            currentRegion->vulkanBuffer->usageFlags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+/* Vulkan consumes SPIR-V directly, so shaders are never translated. */
 
-            newBuffer = VULKAN_INTERNAL_CreateBuffer(
-                renderer,
-                currentRegion->vulkanBuffer->size,
-                currentRegion->vulkanBuffer->usageFlags,
-                currentRegion->vulkanBuffer->type);
+static SDL_bool VULKAN_CompileShaderBinary(
+    Refresh_Renderer *driverData,
+    Refresh_ShaderStage stage,
+    SDL_bool isCompute,
+    Refresh_ShaderFormat format,
+    const Uint8 *code,
+    size_t codeSize,
+    const char *entryPointName,
+    Refresh_ShaderFormat *pBinaryFormat,
+    void **pBinary,
+    size_t *pBinarySize)
+{
+    (void)driverData;
+    (void)stage;
+    (void)isCompute;
+    (void)format;
+    (void)code;
+    (void)codeSize;
+    (void)entryPointName;
+    (void)pBinaryFormat;
+    (void)pBinary;
+    (void)pBinarySize;
+    return SDL_FALSE;
+}
 
-            if (newBuffer == NULL) {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create defrag buffer!");
-                return 0;
-            }
+/* Resource Cycling */
 
-            if (
-                renderer->debugMode &&
-                renderer->supportsDebugUtils &&
-                currentRegion->vulkanBuffer->handle != NULL &&
-                currentRegion->vulkanBuffer->handle->container != NULL &&
-                currentRegion->vulkanBuffer->handle->container->debugName != NULL) {
-                VULKAN_INTERNAL_SetBufferName(
-                    renderer,
-                    newBuffer,
-                    currentRegion->vulkanBuffer->handle->container->debugName);
-            }
+static void VULKAN_SetBufferCycleLimit(
+    Refresh_Renderer *driverData,
+    Refresh_Buffer *buffer,
+    Uint32 maxCycleCount)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanBufferContainer *bufferContainer = (VulkanBufferContainer *)buffer;
 
-            /* Copy buffer contents if necessary */
-            if (
-                currentRegion->vulkanBuffer->type == VULKAN_BUFFER_TYPE_GPU && currentRegion->vulkanBuffer->transitioned) {
-                VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_BUFFER_USAGE_MODE_COPY_SOURCE,
-                    currentRegion->vulkanBuffer);
+    SDL_LockMutex(renderer->cycleLock);
+    bufferContainer->maxCycleCount = maxCycleCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+}
 
-                VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
-                    newBuffer);
+static void VULKAN_SetTransferBufferCycleLimit(
+    Refresh_Renderer *driverData,
+    Refresh_TransferBuffer *transferBuffer,
+    Uint32 maxCycleCount)
+{
+    VULKAN_SetBufferCycleLimit(
+        driverData,
+        (Refresh_Buffer *)transferBuffer,
+        maxCycleCount);
+}
 
-                bufferCopy.srcOffset = 0;
-                bufferCopy.dstOffset = 0;
-                bufferCopy.size = currentRegion->resourceSize;
+static void VULKAN_SetTextureCycleLimit(
+    Refresh_Renderer *driverData,
+    Refresh_Texture *texture,
+    Uint32 maxCycleCount)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanTextureContainer *textureContainer = (VulkanTextureContainer *)texture;
 
-                renderer->vkCmdCopyBuffer(
-                    commandBuffer->commandBuffer,
-                    currentRegion->vulkanBuffer->buffer,
-                    newBuffer->buffer,
-                    1,
-                    &bufferCopy);
+    SDL_LockMutex(renderer->cycleLock);
+    textureContainer->maxCycleCount = maxCycleCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+}
 
-                VULKAN_INTERNAL_BufferTransitionToDefaultUsage(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
-                    newBuffer);
+static Uint32 VULKAN_GetBufferCycleCount(
+    Refresh_Renderer *driverData,
+    Refresh_Buffer *buffer)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanBufferContainer *bufferContainer = (VulkanBufferContainer *)buffer;
+    Uint32 count;
 
-                VULKAN_INTERNAL_TrackBuffer(commandBuffer, currentRegion->vulkanBuffer);
-                VULKAN_INTERNAL_TrackBuffer(commandBuffer, newBuffer);
-            }
+    SDL_LockMutex(renderer->cycleLock);
+    count = bufferContainer->bufferCount;
+    SDL_UnlockMutex(renderer->cycleLock);
 
-            /* re-point original container to new buffer */
-            if (currentRegion->vulkanBuffer->handle != NULL) {
-                newBuffer->handle = currentRegion->vulkanBuffer->handle;
-                newBuffer->handle->vulkanBuffer = newBuffer;
-                currentRegion->vulkanBuffer->handle = NULL;
-            }
+    return count;
+}
 
-            VULKAN_INTERNAL_ReleaseBuffer(renderer, currentRegion->vulkanBuffer);
-        } else if (!currentRegion->isBuffer && !currentRegion->vulkanTexture->markedForDestroy) {
-            newTexture = VULKAN_INTERNAL_CreateTexture(
-                renderer,
-                currentRegion->vulkanTexture->dimensions.width,
-                currentRegion->vulkanTexture->dimensions.height,
-                currentRegion->vulkanTexture->depth,
-                currentRegion->vulkanTexture->isCube,
-                currentRegion->vulkanTexture->layerCount,
-                currentRegion->vulkanTexture->levelCount,
-                currentRegion->vulkanTexture->sampleCount,
-                currentRegion->vulkanTexture->format,
-                currentRegion->vulkanTexture->swizzle,
-                currentRegion->vulkanTexture->aspectFlags,
-                currentRegion->vulkanTexture->usageFlags,
-                currentRegion->vulkanTexture->isMSAAColorTarget);
+static Uint32 VULKAN_GetTransferBufferCycleCount(
+    Refresh_Renderer *driverData,
+    Refresh_TransferBuffer *transferBuffer)
+{
+    return VULKAN_GetBufferCycleCount(
+        driverData,
+        (Refresh_Buffer *)transferBuffer);
+}
 
-            if (newTexture == NULL) {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create defrag texture!");
-                return 0;
-            }
+static Uint32 VULKAN_GetTextureCycleCount(
+    Refresh_Renderer *driverData,
+    Refresh_Texture *texture)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanTextureContainer *textureContainer = (VulkanTextureContainer *)texture;
+    Uint32 count;
 
-            for (sliceIndex = 0; sliceIndex < currentRegion->vulkanTexture->sliceCount; sliceIndex += 1) {
-                /* copy slice if necessary */
-                srcSlice = &currentRegion->vulkanTexture->slices[sliceIndex];
-                dstSlice = &newTexture->slices[sliceIndex];
+    SDL_LockMutex(renderer->cycleLock);
+    count = textureContainer->textureCount;
+    SDL_UnlockMutex(renderer->cycleLock);
 
-                /* Set debug name if it exists */
-                if (
-                    renderer->debugMode &&
-                    renderer->supportsDebugUtils &&
-                    srcSlice->parent->handle != NULL &&
-                    srcSlice->parent->handle->container != NULL &&
-                    srcSlice->parent->handle->container->debugName != NULL) {
-                    VULKAN_INTERNAL_SetTextureName(
-                        renderer,
-                        currentRegion->vulkanTexture,
-                        srcSlice->parent->handle->container->debugName);
-                }
+    return count;
+}
+
+static void VULKAN_SetCycleTrimFrames(
+    Refresh_Renderer *driverData,
+    Uint32 frameCount)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+
+    SDL_LockMutex(renderer->cycleLock);
+    renderer->cycleTrimFrames = frameCount;
+    SDL_UnlockMutex(renderer->cycleLock);
+}
+
+/* Defragmentation */
+
+static void VULKAN_SetDefragmentationSettings(
+    Refresh_Renderer *driverData,
+    Refresh_DefragmentationSettings *settings)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
 
-                if (srcSlice->transitioned) {
-                    VULKAN_INTERNAL_TextureTransitionFromDefaultUsage(
-                        renderer,
-                        commandBuffer,
-                        VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
-                        srcSlice);
+    SDL_LockMutex(renderer->allocatorLock);
 
-                    VULKAN_INTERNAL_TextureTransitionFromDefaultUsage(
-                        renderer,
-                        commandBuffer,
-                        VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
-                        dstSlice);
+    renderer->defragAutomatic = settings->automatic;
+    renderer->defragMaxBytesPerFrame = settings->maxBytesPerFrame;
+    renderer->defragMaxMicrosecondsPerFrame = settings->maxMicrosecondsPerFrame;
 
-                    imageCopy.srcOffset.x = 0;
-                    imageCopy.srcOffset.y = 0;
-                    imageCopy.srcOffset.z = 0;
-                    imageCopy.srcSubresource.aspectMask = srcSlice->parent->aspectFlags;
-                    imageCopy.srcSubresource.baseArrayLayer = srcSlice->layer;
-                    imageCopy.srcSubresource.layerCount = 1;
-                    imageCopy.srcSubresource.mipLevel = srcSlice->level;
-                    imageCopy.extent.width = SDL_max(1, srcSlice->parent->dimensions.width >> srcSlice->level);
-                    imageCopy.extent.height = SDL_max(1, srcSlice->parent->dimensions.height >> srcSlice->level);
-                    imageCopy.extent.depth = srcSlice->parent->depth;
-                    imageCopy.dstOffset.x = 0;
-                    imageCopy.dstOffset.y = 0;
-                    imageCopy.dstOffset.z = 0;
-                    imageCopy.dstSubresource.aspectMask = dstSlice->parent->aspectFlags;
-                    imageCopy.dstSubresource.baseArrayLayer = dstSlice->layer;
-                    imageCopy.dstSubresource.layerCount = 1;
-                    imageCopy.dstSubresource.mipLevel = dstSlice->level;
+    SDL_UnlockMutex(renderer->allocatorLock);
+}
 
-                    renderer->vkCmdCopyImage(
-                        commandBuffer->commandBuffer,
-                        currentRegion->vulkanTexture->image,
-                        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                        newTexture->image,
-                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                        1,
-                        &imageCopy);
+static void VULKAN_RequestDefragmentation(
+    Refresh_Renderer *driverData)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
 
-                    VULKAN_INTERNAL_TextureTransitionToDefaultUsage(
-                        renderer,
-                        commandBuffer,
-                        VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
-                        dstSlice);
+    /* Marking happens on the next presenting submit, once any queued pass is done */
+    SDL_LockMutex(renderer->submitLock);
+    renderer->defragRequested = 1;
+    SDL_UnlockMutex(renderer->submitLock);
+}
 
-                    VULKAN_INTERNAL_TrackTextureSlice(commandBuffer, srcSlice);
-                    VULKAN_INTERNAL_TrackTextureSlice(commandBuffer, dstSlice);
-                }
-            }
+/* Statistics */
 
-            /* re-point original container to new texture */
-            newTexture->handle = currentRegion->vulkanTexture->handle;
-            newTexture->handle->vulkanTexture = newTexture;
-            currentRegion->vulkanTexture->handle = NULL;
+static void VULKAN_GetDeviceStatistics(
+    Refresh_Renderer *driverData,
+    Refresh_DeviceStatistics *statistics)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
 
-            VULKAN_INTERNAL_ReleaseTexture(renderer, currentRegion->vulkanTexture);
-        }
-    }
+    SDL_LockMutex(renderer->submitLock);
+
+    statistics->descriptorSetsWritten = renderer->descriptorSetsWritten;
+    statistics->descriptorSetsReused = renderer->descriptorSetsReused;
+    statistics->barriersRecorded = renderer->barriersRecorded;
+    statistics->barrierBatchesRecorded = renderer->barrierBatchesRecorded;
+    statistics->barriersEliminated = renderer->barriersEliminated;
 
+    SDL_LockMutex(renderer->allocatorLock);
+    statistics->defragBytesFragmented = renderer->defragBytesFragmented;
+    statistics->defragBytesMoved = renderer->defragBytesMoved;
+    statistics->defragBytesReclaimed = renderer->defragBytesReclaimed;
     SDL_UnlockMutex(renderer->allocatorLock);
 
-    VULKAN_Submit(
-        (Refresh_CommandBuffer *)commandBuffer);
+    SDL_LockMutex(renderer->cycleLock);
+    statistics->cycleHandlesCreated = renderer->cycleHandlesCreated;
+    statistics->cycleHandlesTrimmed = renderer->cycleHandlesTrimmed;
+    statistics->cycleLimitHits = renderer->cycleLimitHits;
+    SDL_UnlockMutex(renderer->cycleLock);
 
-    return 1;
+    SDL_UnlockMutex(renderer->submitLock);
 }
 
-/* Format Info */
-
-static SDL_bool VULKAN_IsTextureFormatSupported(
+static void VULKAN_GetMemoryStatistics(
     Refresh_Renderer *driverData,
-    Refresh_TextureFormat format,
-    Refresh_TextureType type,
-    Refresh_TextureUsageFlags usage)
+    Refresh_MemoryStatistics *statistics)
 {
     VulkanRenderer *renderer = (VulkanRenderer *)driverData;
-    VkFormat vulkanFormat = RefreshToVK_SurfaceFormat[format];
-    VkImageUsageFlags vulkanUsage = 0;
-    VkImageCreateFlags createFlags = 0;
-    VkImageFormatProperties properties;
-    VkResult vulkanResult;
+    VulkanMemorySubAllocator *allocator;
+    VulkanMemoryAllocation *allocation;
+    VkPhysicalDeviceMemoryProperties2 memoryProperties2;
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT memoryBudgetProperties;
+    VkMemoryHeap *heap;
+    Uint64 deviceLocalAllocatedBytes = 0;
+    Uint32 i, j, k;
 
-    if (usage & REFRESH_TEXTUREUSAGE_SAMPLER_BIT) {
-        vulkanUsage |= VK_IMAGE_USAGE_SAMPLED_BIT;
-    }
-    if (usage & REFRESH_TEXTUREUSAGE_COLOR_TARGET_BIT) {
-        vulkanUsage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-    }
-    if (usage & REFRESH_TEXTUREUSAGE_DEPTH_STENCIL_TARGET_BIT) {
-        vulkanUsage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-    }
-    if (usage & (REFRESH_TEXTUREUSAGE_GRAPHICS_STORAGE_READ_BIT |
-                 REFRESH_TEXTUREUSAGE_COMPUTE_STORAGE_READ_BIT |
-                 REFRESH_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE_BIT)) {
-        vulkanUsage |= VK_IMAGE_USAGE_STORAGE_BIT;
+    SDL_zerop(statistics);
+
+    SDL_LockMutex(renderer->allocatorLock);
+
+    for (i = 0; i < renderer->memoryProperties.memoryTypeCount; i += 1) {
+        allocator = &renderer->memoryAllocator->subAllocators[i];
+
+        SDL_LockMutex(allocator->lock);
+
+        for (j = 0; j < allocator->allocationCount; j += 1) {
+            allocation = allocator->allocations[j];
+
+            statistics->allocatedBytes += allocation->size;
+            statistics->usedBytes += allocation->usedSpace;
+            statistics->allocationCount += 1;
+            statistics->freeRegionCount += allocation->freeRegionCount;
+
+            for (k = 0; k < allocation->freeRegionCount; k += 1) {
+                statistics->largestFreeRegionBytes = SDL_max(
+                    statistics->largestFreeRegionBytes,
+                    allocation->freeRegions[k]->size);
+            }
+
+            if (renderer->memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
+                deviceLocalAllocatedBytes += allocation->size;
+            }
+        }
+
+        SDL_UnlockMutex(allocator->lock);
     }
 
-    if (type == REFRESH_TEXTURETYPE_CUBE) {
-        createFlags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+    SDL_UnlockMutex(renderer->allocatorLock);
+
+    if (renderer->supports.EXT_memory_budget) {
+        SDL_zero(memoryBudgetProperties);
+        memoryBudgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+        memoryProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        memoryProperties2.pNext = &memoryBudgetProperties;
+
+        renderer->vkGetPhysicalDeviceMemoryProperties2KHR(
+            renderer->physicalDevice,
+            &memoryProperties2);
     }
 
-    vulkanResult = renderer->vkGetPhysicalDeviceImageFormatProperties(
-        renderer->physicalDevice,
-        vulkanFormat,
-        (type == REFRESH_TEXTURETYPE_3D) ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D,
-        VK_IMAGE_TILING_OPTIMAL,
-        vulkanUsage,
-        createFlags,
-        &properties);
+    for (i = 0; i < renderer->memoryProperties.memoryHeapCount; i += 1) {
+        heap = &renderer->memoryProperties.memoryHeaps[i];
 
-    return vulkanResult == VK_SUCCESS;
+        if (heap->flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            if (renderer->supports.EXT_memory_budget) {
+                statistics->budgetBytes += memoryBudgetProperties.heapBudget[i];
+                statistics->usageBytes += memoryBudgetProperties.heapUsage[i];
+            } else {
+                statistics->budgetBytes += heap->size;
+            }
+        }
+    }
+
+    /* Without the budget extension we only know about our own allocations */
+    if (!renderer->supports.EXT_memory_budget) {
+        statistics->usageBytes = deviceLocalAllocatedBytes;
+    }
 }
 
 /* Device instantiation */
@@ -10864,7 +15266,7 @@ static inline Uint8 CheckDeviceExtensions(
         supports->ext = 1;                   \
     }
         CHECK(KHR_swapchain)
-        else CHECK(KHR_maintenance1) else CHECK(KHR_get_memory_requirements2) else CHECK(KHR_driver_properties) else CHECK(EXT_vertex_attribute_divisor) else CHECK(KHR_portability_subset)
+        else CHECK(KHR_maintenance1) else CHECK(KHR_get_memory_requirements2) else CHECK(KHR_maintenance3) else CHECK(KHR_driver_properties) else CHECK(EXT_descriptor_indexing) else CHECK(KHR_draw_indirect_count) else CHECK(KHR_timeline_semaphore) else CHECK(EXT_vertex_attribute_divisor) else CHECK(EXT_memory_budget) else CHECK(KHR_portability_subset)
 #undef CHECK
     }
 
@@ -10879,8 +15281,13 @@ static inline Uint32 GetDeviceExtensionCount(VulkanExtensions *supports)
         supports->KHR_swapchain +
         supports->KHR_maintenance1 +
         supports->KHR_get_memory_requirements2 +
+        supports->KHR_maintenance3 +
         supports->KHR_driver_properties +
+        supports->EXT_descriptor_indexing +
+        supports->KHR_draw_indirect_count +
+        supports->KHR_timeline_semaphore +
         supports->EXT_vertex_attribute_divisor +
+        supports->EXT_memory_budget +
         supports->KHR_portability_subset);
 }
 
@@ -10896,8 +15303,13 @@ static inline void CreateDeviceExtensionArray(
     CHECK(KHR_swapchain)
     CHECK(KHR_maintenance1)
     CHECK(KHR_get_memory_requirements2)
+    CHECK(KHR_maintenance3)
     CHECK(KHR_driver_properties)
+    CHECK(EXT_descriptor_indexing)
+    CHECK(KHR_draw_indirect_count)
+    CHECK(KHR_timeline_semaphore)
     CHECK(EXT_vertex_attribute_divisor)
+    CHECK(EXT_memory_budget)
     CHECK(KHR_portability_subset)
 #undef CHECK
 }
@@ -11297,6 +15709,91 @@ static Uint8 VULKAN_INTERNAL_IsDeviceSuitable(
             swapchainSupportDetails.presentModesLength > 0);
 }
 
+static void VULKAN_INTERNAL_DetermineQueueFamilies(
+    VulkanRenderer *renderer)
+{
+    VkQueueFamilyProperties *queueProps;
+    VkExtent3D granularity;
+    Uint32 queueFamilyCount, i, j;
+    Uint32 computeFamilyIndex, transferFamilyIndex;
+
+    renderer->vkGetPhysicalDeviceQueueFamilyProperties(
+        renderer->physicalDevice,
+        &queueFamilyCount,
+        NULL);
+
+    queueProps = SDL_stack_alloc(
+        VkQueueFamilyProperties,
+        queueFamilyCount);
+    renderer->vkGetPhysicalDeviceQueueFamilyProperties(
+        renderer->physicalDevice,
+        &queueFamilyCount,
+        queueProps);
+
+    /* Prefer families that can't do graphics, those are the ones that actually run in parallel */
+    computeFamilyIndex = renderer->queueFamilyIndex;
+    transferFamilyIndex = UINT32_MAX;
+    for (i = 0; i < queueFamilyCount; i += 1) {
+        if (queueProps[i].queueCount == 0) {
+            continue;
+        }
+
+        if (
+            computeFamilyIndex == renderer->queueFamilyIndex &&
+            (queueProps[i].queueFlags & VK_QUEUE_COMPUTE_BIT) &&
+            !(queueProps[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+            computeFamilyIndex = i;
+        }
+
+        /* Copy passes can touch arbitrary texels, so coarse transfer granularity is useless to us */
+        granularity = queueProps[i].minImageTransferGranularity;
+        if (
+            transferFamilyIndex == UINT32_MAX &&
+            (queueProps[i].queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+            !(queueProps[i].queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) &&
+            granularity.width == 1 &&
+            granularity.height == 1 &&
+            granularity.depth == 1) {
+            transferFamilyIndex = i;
+        }
+    }
+
+    /* Compute queues support transfers too */
+    if (transferFamilyIndex == UINT32_MAX) {
+        transferFamilyIndex = computeFamilyIndex;
+    }
+
+    /* Separate families force concurrent sharing on every resource, which can cost compression, so they are opt-in */
+    if (!SDL_GetHintBoolean("REFRESH_HINT_VULKAN_ASYNC_QUEUES", SDL_FALSE)) {
+        computeFamilyIndex = renderer->queueFamilyIndex;
+        transferFamilyIndex = renderer->queueFamilyIndex;
+    }
+
+    renderer->queues[REFRESH_QUEUETYPE_GRAPHICS].queueFamilyIndex = renderer->queueFamilyIndex;
+    renderer->queues[REFRESH_QUEUETYPE_COMPUTE].queueFamilyIndex = computeFamilyIndex;
+    renderer->queues[REFRESH_QUEUETYPE_TRANSFER].queueFamilyIndex = transferFamilyIndex;
+
+    renderer->uniqueQueueFamilyCount = 0;
+    for (i = 0; i < SDL_arraysize(renderer->queues); i += 1) {
+        renderer->queues[i].queue = VK_NULL_HANDLE;
+        renderer->queues[i].queueFlags = queueProps[renderer->queues[i].queueFamilyIndex].queueFlags;
+        renderer->queues[i].timestampValidBits = queueProps[renderer->queues[i].queueFamilyIndex].timestampValidBits;
+
+        for (j = 0; j < renderer->uniqueQueueFamilyCount; j += 1) {
+            if (renderer->uniqueQueueFamilyIndices[j] == renderer->queues[i].queueFamilyIndex) {
+                break;
+            }
+        }
+
+        if (j == renderer->uniqueQueueFamilyCount) {
+            renderer->uniqueQueueFamilyIndices[j] = renderer->queues[i].queueFamilyIndex;
+            renderer->uniqueQueueFamilyCount += 1;
+        }
+    }
+
+    SDL_stack_free(queueProps);
+}
+
 static Uint8 VULKAN_INTERNAL_DeterminePhysicalDevice(
     VulkanRenderer *renderer,
     VkSurfaceKHR surface)
@@ -11404,6 +15901,16 @@ static Uint8 VULKAN_INTERNAL_DeterminePhysicalDevice(
         renderer->physicalDeviceProperties.pNext = NULL;
     }
 
+    if (renderer->supports.EXT_descriptor_indexing) {
+        renderer->physicalDeviceDescriptorIndexingProperties.sType =
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+        renderer->physicalDeviceDescriptorIndexingProperties.pNext =
+            renderer->physicalDeviceProperties.pNext;
+
+        renderer->physicalDeviceProperties.pNext =
+            &renderer->physicalDeviceDescriptorIndexingProperties;
+    }
+
     renderer->vkGetPhysicalDeviceProperties2KHR(
         renderer->physicalDevice,
         &renderer->physicalDeviceProperties);
@@ -11412,6 +15919,8 @@ static Uint8 VULKAN_INTERNAL_DeterminePhysicalDevice(
         renderer->physicalDevice,
         &renderer->memoryProperties);
 
+    VULKAN_INTERNAL_DetermineQueueFamilies(renderer);
+
     SDL_stack_free(physicalDevices);
     SDL_stack_free(physicalDeviceExtensions);
     return 1;
@@ -11424,19 +15933,28 @@ static Uint8 VULKAN_INTERNAL_CreateLogicalDevice(
     VkDeviceCreateInfo deviceCreateInfo;
     VkPhysicalDeviceFeatures desiredDeviceFeatures;
     VkPhysicalDeviceFeatures haveDeviceFeatures;
+    VkPhysicalDeviceFeatures2KHR haveDeviceFeatures2;
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT haveDescriptorIndexingFeatures;
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures;
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR haveTimelineSemaphoreFeatures;
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures;
     VkPhysicalDevicePortabilitySubsetFeaturesKHR portabilityFeatures;
     const char **deviceExtensions;
+    Uint32 i;
 
-    VkDeviceQueueCreateInfo queueCreateInfo;
+    VkDeviceQueueCreateInfo queueCreateInfos[SDL_arraysize(renderer->uniqueQueueFamilyIndices)];
     float queuePriority = 1.0f;
 
-    queueCreateInfo.sType =
-        VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    queueCreateInfo.pNext = NULL;
-    queueCreateInfo.flags = 0;
-    queueCreateInfo.queueFamilyIndex = renderer->queueFamilyIndex;
-    queueCreateInfo.queueCount = 1;
-    queueCreateInfo.pQueuePriorities = &queuePriority;
+    /* One queue per unique family, the unified family always comes first */
+    for (i = 0; i < renderer->uniqueQueueFamilyCount; i += 1) {
+        queueCreateInfos[i].sType =
+            VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueCreateInfos[i].pNext = NULL;
+        queueCreateInfos[i].flags = 0;
+        queueCreateInfos[i].queueFamilyIndex = renderer->uniqueQueueFamilyIndices[i];
+        queueCreateInfos[i].queueCount = 1;
+        queueCreateInfos[i].pQueuePriorities = &queuePriority;
+    }
 
     /* check feature support */
 
@@ -11460,6 +15978,60 @@ static Uint8 VULKAN_INTERNAL_CreateLogicalDevice(
         renderer->supportsMultiDrawIndirect = SDL_TRUE;
     }
 
+    renderer->supportsIndirectCount = renderer->supports.KHR_draw_indirect_count;
+
+    /* Bindless tables need update-after-bind arrays that may be partially bound */
+
+    renderer->supportsBindless = SDL_FALSE;
+
+    if (renderer->supports.KHR_maintenance3 && renderer->supports.EXT_descriptor_indexing) {
+        SDL_zero(haveDescriptorIndexingFeatures);
+        haveDescriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+        haveDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+        haveDeviceFeatures2.pNext = &haveDescriptorIndexingFeatures;
+
+        renderer->vkGetPhysicalDeviceFeatures2KHR(
+            renderer->physicalDevice,
+            &haveDeviceFeatures2);
+
+        /* The bindless set follows the regular sets, at index 4 for graphics and 3 for compute */
+        renderer->supportsBindless =
+            renderer->physicalDeviceProperties.properties.limits.maxBoundDescriptorSets >= 5 &&
+            haveDescriptorIndexingFeatures.runtimeDescriptorArray &&
+            haveDescriptorIndexingFeatures.descriptorBindingPartiallyBound &&
+            haveDescriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending &&
+            haveDescriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+            haveDescriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind;
+    }
+
+    if (!renderer->supportsBindless) {
+        /* Don't enable an extension we won't use */
+        renderer->supports.EXT_descriptor_indexing = 0;
+    }
+
+    /* Timeline semaphores replace per-submission fences */
+
+    renderer->supportsTimelineSemaphore = SDL_FALSE;
+
+    if (renderer->supports.KHR_timeline_semaphore) {
+        SDL_zero(haveTimelineSemaphoreFeatures);
+        haveTimelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+
+        haveDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+        haveDeviceFeatures2.pNext = &haveTimelineSemaphoreFeatures;
+
+        renderer->vkGetPhysicalDeviceFeatures2KHR(
+            renderer->physicalDevice,
+            &haveDeviceFeatures2);
+
+        renderer->supportsTimelineSemaphore = haveTimelineSemaphoreFeatures.timelineSemaphore;
+    }
+
+    if (!renderer->supportsTimelineSemaphore) {
+        renderer->supports.KHR_timeline_semaphore = 0;
+    }
+
     /* creating the logical device */
 
     deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -11485,9 +16057,31 @@ static Uint8 VULKAN_INTERNAL_CreateLogicalDevice(
     } else {
         deviceCreateInfo.pNext = NULL;
     }
+    if (renderer->supportsBindless) {
+        SDL_zero(descriptorIndexingFeatures);
+        descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        descriptorIndexingFeatures.pNext = (void *)deviceCreateInfo.pNext;
+        descriptorIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+        descriptorIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+        descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+        descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        descriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing =
+            haveDescriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing;
+        descriptorIndexingFeatures.shaderStorageBufferArrayNonUniformIndexing =
+            haveDescriptorIndexingFeatures.shaderStorageBufferArrayNonUniformIndexing;
+        deviceCreateInfo.pNext = &descriptorIndexingFeatures;
+    }
+    if (renderer->supportsTimelineSemaphore) {
+        SDL_zero(timelineSemaphoreFeatures);
+        timelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+        timelineSemaphoreFeatures.pNext = (void *)deviceCreateInfo.pNext;
+        timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+        deviceCreateInfo.pNext = &timelineSemaphoreFeatures;
+    }
     deviceCreateInfo.flags = 0;
-    deviceCreateInfo.queueCreateInfoCount = 1;
-    deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+    deviceCreateInfo.queueCreateInfoCount = renderer->uniqueQueueFamilyCount;
+    deviceCreateInfo.pQueueCreateInfos = queueCreateInfos;
     deviceCreateInfo.enabledLayerCount = 0;
     deviceCreateInfo.ppEnabledLayerNames = NULL;
     deviceCreateInfo.enabledExtensionCount = GetDeviceExtensionCount(
@@ -11522,6 +16116,14 @@ static Uint8 VULKAN_INTERNAL_CreateLogicalDevice(
         0,
         &renderer->unifiedQueue);
 
+    for (i = 0; i < SDL_arraysize(renderer->queues); i += 1) {
+        renderer->vkGetDeviceQueue(
+            renderer->logicalDevice,
+            renderer->queues[i].queueFamilyIndex,
+            0,
+            &renderer->queues[i].queue);
+    }
+
     return 1;
 }
 
@@ -11675,6 +16277,9 @@ static Refresh_Device *VULKAN_CreateDevice(SDL_bool debugMode, SDL_bool preferLo
     /* Variables: Image Format Detection */
     VkImageFormatProperties imageFormatProperties;
 
+    /* Variables: Pipeline Cache */
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo;
+
     if (SDL_Vulkan_LoadLibrary(NULL) < 0) {
         SDL_assert(!"This should have failed in PrepareDevice first!");
         return NULL;
@@ -11739,8 +16344,13 @@ static Refresh_Device *VULKAN_CreateDevice(SDL_bool debugMode, SDL_bool preferLo
     renderer->submitLock = SDL_CreateMutex();
     renderer->acquireCommandBufferLock = SDL_CreateMutex();
     renderer->acquireUniformBufferLock = SDL_CreateMutex();
+    renderer->acquireStagingBlockLock = SDL_CreateMutex();
     renderer->renderPassFetchLock = SDL_CreateMutex();
     renderer->framebufferFetchLock = SDL_CreateMutex();
+    renderer->bindlessLock = SDL_CreateMutex();
+    renderer->cycleLock = SDL_CreateMutex();
+    renderer->mipmapPipelineLock = SDL_CreateMutex();
+    renderer->fenceWakeLock = SDL_CreateMutex();
 
     /*
      * Create submitted command buffer list
@@ -11750,6 +16360,22 @@ static Refresh_Device *VULKAN_CreateDevice(SDL_bool debugMode, SDL_bool preferLo
     renderer->submittedCommandBufferCount = 0;
     renderer->submittedCommandBuffers = SDL_malloc(sizeof(VulkanCommandBuffer *) * renderer->submittedCommandBufferCapacity);
 
+    /* Cross-queue semaphores */
+
+    for (i = 0; i < SDL_arraysize(renderer->queues); i += 1) {
+        renderer->queues[i].lastSubmissionValue = 0;
+        renderer->queues[i].lastBindlessValue = 0;
+        SDL_memset(renderer->queues[i].waitedValues, 0, sizeof(renderer->queues[i].waitedValues));
+
+        renderer->queues[i].pendingWaitSemaphoreCapacity = MAX_PENDING_ASYNC_SEMAPHORES;
+        renderer->queues[i].pendingWaitSemaphoreCount = 0;
+        renderer->queues[i].pendingWaitSemaphores = SDL_malloc(sizeof(VkSemaphore) * renderer->queues[i].pendingWaitSemaphoreCapacity);
+    }
+
+    renderer->availableSemaphoreCapacity = MAX_PENDING_ASYNC_SEMAPHORES;
+    renderer->availableSemaphoreCount = 0;
+    renderer->availableSemaphores = SDL_malloc(sizeof(VkSemaphore) * renderer->availableSemaphoreCapacity);
+
     /* Memory Allocator */
 
     renderer->memoryAllocator = (VulkanMemoryAllocator *)SDL_malloc(
@@ -11759,16 +16385,14 @@ static Refresh_Device *VULKAN_CreateDevice(SDL_bool debugMode, SDL_bool preferLo
         renderer->memoryAllocator->subAllocators[i].memoryTypeIndex = i;
         renderer->memoryAllocator->subAllocators[i].allocations = NULL;
         renderer->memoryAllocator->subAllocators[i].allocationCount = 0;
-        renderer->memoryAllocator->subAllocators[i].sortedFreeRegions = SDL_malloc(
-            sizeof(VulkanMemoryFreeRegion *) * 4);
-        renderer->memoryAllocator->subAllocators[i].sortedFreeRegionCount = 0;
-        renderer->memoryAllocator->subAllocators[i].sortedFreeRegionCapacity = 4;
+        SDL_zero(renderer->memoryAllocator->subAllocators[i].freeRegionIndices);
+        renderer->memoryAllocator->subAllocators[i].lock = SDL_CreateMutex();
     }
 
     /* Create uniform buffer pool */
 
-    renderer->uniformBufferPoolCount = 32;
-    renderer->uniformBufferPoolCapacity = 32;
+    renderer->uniformBufferPoolCount = 8;
+    renderer->uniformBufferPoolCapacity = 8;
     renderer->uniformBufferPool = SDL_malloc(
         renderer->uniformBufferPoolCapacity * sizeof(VulkanUniformBuffer *));
 
@@ -11778,6 +16402,13 @@ static Refresh_Device *VULKAN_CreateDevice(SDL_bool debugMode, SDL_bool preferLo
             UNIFORM_BUFFER_SIZE);
     }
 
+    /* Staging blocks are created on demand */
+
+    renderer->stagingBlockPoolCount = 0;
+    renderer->stagingBlockPoolCapacity = 4;
+    renderer->stagingBlockPool = SDL_malloc(
+        renderer->stagingBlockPoolCapacity * sizeof(VulkanBufferContainer *));
+
     /* Device limits */
 
     renderer->minUBOAlignment = (Uint32)renderer->physicalDeviceProperties.properties.limits.minUniformBufferOffsetAlignment;
@@ -11790,13 +16421,44 @@ static Refresh_Device *VULKAN_CreateDevice(SDL_bool debugMode, SDL_bool preferLo
         renderer->commandPoolHashTable.buckets[i].capacity = 0;
     }
 
-    renderer->renderPassHashArray.elements = NULL;
-    renderer->renderPassHashArray.count = 0;
-    renderer->renderPassHashArray.capacity = 0;
+    for (i = 0; i < NUM_RENDER_PASS_BUCKETS; i += 1) {
+        renderer->renderPassHashTable.buckets[i].elements = NULL;
+        renderer->renderPassHashTable.buckets[i].count = 0;
+        renderer->renderPassHashTable.buckets[i].capacity = 0;
+    }
+
+    for (i = 0; i < NUM_FRAMEBUFFER_BUCKETS; i += 1) {
+        renderer->framebufferHashTable.buckets[i].elements = NULL;
+        renderer->framebufferHashTable.buckets[i].count = 0;
+        renderer->framebufferHashTable.buckets[i].capacity = 0;
+    }
+
+    /* Pipeline cache, seeded later via Refresh_LoadPipelineCacheData */
+
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.pNext = NULL;
+    pipelineCacheCreateInfo.flags = 0;
+    pipelineCacheCreateInfo.initialDataSize = 0;
+    pipelineCacheCreateInfo.pInitialData = NULL;
+
+    vulkanResult = renderer->vkCreatePipelineCache(
+        renderer->logicalDevice,
+        &pipelineCacheCreateInfo,
+        NULL,
+        &renderer->pipelineCache);
+
+    if (vulkanResult != VK_SUCCESS) {
+        /* Not fatal, pipelines will just be compiled without a cache */
+        LogVulkanResultAsError("vkCreatePipelineCache", vulkanResult);
+        renderer->pipelineCache = VK_NULL_HANDLE;
+    }
+
+    /* Bindless tables, must exist before any pipeline layout is created */
 
-    renderer->framebufferHashArray.elements = NULL;
-    renderer->framebufferHashArray.count = 0;
-    renderer->framebufferHashArray.capacity = 0;
+    if (renderer->supportsBindless && !VULKAN_INTERNAL_InitializeBindlessDescriptorSet(renderer)) {
+        /* Not fatal, applications are expected to fall back to regular bindings */
+        renderer->supportsBindless = SDL_FALSE;
+    }
 
     /* Initialize fence pool */
 
@@ -11807,6 +16469,32 @@ static Refresh_Device *VULKAN_CreateDevice(SDL_bool debugMode, SDL_bool preferLo
     renderer->fencePool.availableFences = SDL_malloc(
         renderer->fencePool.availableFenceCapacity * sizeof(VulkanFenceHandle *));
 
+    /* Queue timelines, each one is only signaled by its own queue so values stay in order */
+
+    for (i = 0; i < SDL_arraysize(renderer->queues); i += 1) {
+        renderer->queues[i].timelineSemaphore = VK_NULL_HANDLE;
+    }
+
+    if (renderer->supportsTimelineSemaphore) {
+        for (i = 0; i < SDL_arraysize(renderer->queues); i += 1) {
+            renderer->queues[i].timelineSemaphore = VULKAN_INTERNAL_CreateTimelineSemaphore(renderer);
+
+            if (renderer->queues[i].timelineSemaphore == VK_NULL_HANDLE) {
+                /* Not fatal, fences fall back to VkFence */
+                renderer->supportsTimelineSemaphore = SDL_FALSE;
+            }
+        }
+    }
+
+    /* Not fatal either, the fence callback waiter falls back to bounded waits */
+    renderer->fenceWakeSemaphore = VK_NULL_HANDLE;
+    renderer->fenceWakeValue = 0;
+    renderer->fenceWakeConsumed = 0;
+
+    if (renderer->supportsTimelineSemaphore) {
+        renderer->fenceWakeSemaphore = VULKAN_INTERNAL_CreateTimelineSemaphore(renderer);
+    }
+
     /* Some drivers don't support D16, so we have to fall back to D32. */
 
     vulkanResult = renderer->vkGetPhysicalDeviceImageFormatProperties(
@@ -11841,63 +16529,43 @@ static Refresh_Device *VULKAN_CreateDevice(SDL_bool debugMode, SDL_bool preferLo
 
     /* Deferred destroy storage */
 
-    renderer->texturesToDestroyCapacity = 16;
-    renderer->texturesToDestroyCount = 0;
-
-    renderer->texturesToDestroy = (VulkanTexture **)SDL_malloc(
-        sizeof(VulkanTexture *) *
-        renderer->texturesToDestroyCapacity);
-
-    renderer->buffersToDestroyCapacity = 16;
-    renderer->buffersToDestroyCount = 0;
-
-    renderer->buffersToDestroy = SDL_malloc(
-        sizeof(VulkanBuffer *) *
-        renderer->buffersToDestroyCapacity);
-
-    renderer->samplersToDestroyCapacity = 16;
-    renderer->samplersToDestroyCount = 0;
-
-    renderer->samplersToDestroy = SDL_malloc(
-        sizeof(VulkanSampler *) *
-        renderer->samplersToDestroyCapacity);
-
-    renderer->graphicsPipelinesToDestroyCapacity = 16;
-    renderer->graphicsPipelinesToDestroyCount = 0;
+    renderer->deferredDestroyCapacity = 64;
+    renderer->deferredDestroyCount = 0;
 
-    renderer->graphicsPipelinesToDestroy = SDL_malloc(
-        sizeof(VulkanGraphicsPipeline *) *
-        renderer->graphicsPipelinesToDestroyCapacity);
+    renderer->deferredDestroys = SDL_malloc(
+        sizeof(VulkanDeferredDestroy) *
+        renderer->deferredDestroyCapacity);
 
-    renderer->computePipelinesToDestroyCapacity = 16;
-    renderer->computePipelinesToDestroyCount = 0;
-
-    renderer->computePipelinesToDestroy = SDL_malloc(
-        sizeof(VulkanComputePipeline *) *
-        renderer->computePipelinesToDestroyCapacity);
-
-    renderer->shadersToDestroyCapacity = 16;
-    renderer->shadersToDestroyCount = 0;
-
-    renderer->shadersToDestroy = SDL_malloc(
-        sizeof(VulkanShader *) *
-        renderer->shadersToDestroyCapacity);
-
-    renderer->framebuffersToDestroyCapacity = 16;
-    renderer->framebuffersToDestroyCount = 0;
-    renderer->framebuffersToDestroy = SDL_malloc(
-        sizeof(VulkanFramebuffer *) *
-        renderer->framebuffersToDestroyCapacity);
+    renderer->submissionSerial = 0;
 
     /* Defrag state */
 
     renderer->defragInProgress = 0;
+    renderer->defragRequested = 0;
+    renderer->defragAutomatic = 1;
+    renderer->defragMaxBytesPerFrame = 0;
+    renderer->defragMaxMicrosecondsPerFrame = 0;
 
     renderer->allocationsToDefragCount = 0;
     renderer->allocationsToDefragCapacity = 4;
     renderer->allocationsToDefrag = SDL_malloc(
         renderer->allocationsToDefragCapacity * sizeof(VulkanMemoryAllocation *));
 
+    /* Cycling state */
+
+    renderer->cycledBufferContainerCapacity = 16;
+    renderer->cycledBufferContainerCount = 0;
+    renderer->cycledBufferContainers = SDL_malloc(
+        renderer->cycledBufferContainerCapacity * sizeof(VulkanBufferContainer *));
+
+    renderer->cycledTextureContainerCapacity = 16;
+    renderer->cycledTextureContainerCount = 0;
+    renderer->cycledTextureContainers = SDL_malloc(
+        renderer->cycledTextureContainerCapacity * sizeof(VulkanTextureContainer *));
+
+    renderer->presentedFrameCount = 0;
+    renderer->cycleTrimFrames = 0;
+
     return result;
 }
 
@@ -0,0 +1,9 @@
+glslangValidator -V -S comp -DOUTPUT_LEVELS=1 --vn VULKAN_MipmapDownsample1 -o VULKAN_MipmapDownsample1.h VULKAN_MipmapDownsample.comp
+glslangValidator -V -S comp -DOUTPUT_LEVELS=2 --vn VULKAN_MipmapDownsample2 -o VULKAN_MipmapDownsample2.h VULKAN_MipmapDownsample.comp
+glslangValidator -V -S comp -DOUTPUT_LEVELS=3 --vn VULKAN_MipmapDownsample3 -o VULKAN_MipmapDownsample3.h VULKAN_MipmapDownsample.comp
+glslangValidator -V -S comp -DOUTPUT_LEVELS=4 --vn VULKAN_MipmapDownsample4 -o VULKAN_MipmapDownsample4.h VULKAN_MipmapDownsample.comp
+glslangValidator -V -S comp -DOUTPUT_LEVELS=1 -o VULKAN_MipmapDownsample1.spv VULKAN_MipmapDownsample.comp && spirv-val --target-env vulkan1.0 VULKAN_MipmapDownsample1.spv
+glslangValidator -V -S comp -DOUTPUT_LEVELS=2 -o VULKAN_MipmapDownsample2.spv VULKAN_MipmapDownsample.comp && spirv-val --target-env vulkan1.0 VULKAN_MipmapDownsample2.spv
+glslangValidator -V -S comp -DOUTPUT_LEVELS=3 -o VULKAN_MipmapDownsample3.spv VULKAN_MipmapDownsample.comp && spirv-val --target-env vulkan1.0 VULKAN_MipmapDownsample3.spv
+glslangValidator -V -S comp -DOUTPUT_LEVELS=4 -o VULKAN_MipmapDownsample4.spv VULKAN_MipmapDownsample.comp && spirv-val --target-env vulkan1.0 VULKAN_MipmapDownsample4.spv
+del VULKAN_MipmapDownsample*.spv